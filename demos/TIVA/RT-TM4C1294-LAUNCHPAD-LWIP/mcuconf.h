@@ -113,6 +113,17 @@
 #define TIVA_I2C_I2C8_IRQ_PRIORITY          4
 #define TIVA_I2C_I2C9_IRQ_PRIORITY          4
 
+/*
+ * MAC driver system settings.
+ */
+#define TIVA_MAC_TRANSMIT_BUFFERS           4
+#define TIVA_MAC_RECEIVE_BUFFERS            8
+#define TIVA_MAC_BUFFERS_SIZE               1522
+#define TIVA_MAC_IRQ_PRIORITY               5
+#define TIVA_MAC_IP_CHECKSUM_OFFLOAD        3
+#define TIVA_MAC_RX_COALESCE_FRAMES         4
+#define TIVA_MAC_RX_COALESCE_TIME           100
+
 /*
  * PWM driver system settings.
  */
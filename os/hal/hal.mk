@@ -24,6 +24,10 @@ HALSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/src/hal_crc.c
 endif
 ifneq ($(findstring HAL_USE_RNG TRUE,$(HALCONF)),)
 HALSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/src/hal_rng.c
+ifneq ($(findstring RNG_USE_CSPRNG TRUE,$(HALCONF)),)
+HALSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/various/csprng.c
+HALINC_CSPRNG := ${CHIBIOS_CONTRIB}/os/various
+endif
 endif
 ifneq ($(findstring HAL_USE_USBH TRUE,$(HALCONF)),)
 HALSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/src/hal_usbh.c \
@@ -102,7 +106,7 @@ HALSRC_CONTRIB := ${CHIBIOS_CONTRIB}/os/hal/src/hal_community.c \
                   ${CHIBIOS_CONTRIB}/os/hal/src/hal_opamp.c
 endif
 
-HALINC_CONTRIB := ${CHIBIOS_CONTRIB}/os/hal/include
+HALINC_CONTRIB := ${CHIBIOS_CONTRIB}/os/hal/include $(HALINC_CSPRNG)
 
 # Shared variables
 ALLCSRC += $(HALSRC_CONTRIB)
@@ -35,6 +35,21 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    EICU configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the DMA capture mode.
+ * @details Channels configured with a capture ring have their captured
+ *          counter values stored by DMA, without interrupts, and decoded
+ *          later by @p eicuReadCaptures().
+ */
+#if !defined(EICU_USE_DMA) || defined(__DOXYGEN__)
+#define EICU_USE_DMA                FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -90,8 +105,42 @@ typedef struct EICUDriver EICUDriver;
 typedef void (*eicucallback_t)(EICUDriver *eicup, eicuchannel_t channel,
                                uint32_t width, uint32_t period);
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Captured edges decoder.
+ * @details Turns a stream of captured counter values into widths and
+ *          periods, with the same semantic as the capture callbacks.
+ */
+typedef struct {
+  /**
+   * @brief   Counter mask, the counter values wrap around it.
+   */
+  uint32_t                mask;
+  /**
+   * @brief   Last active edge.
+   */
+  uint32_t                last_active;
+  /**
+   * @brief   Last idle edge.
+   */
+  uint32_t                last_idle;
+  /**
+   * @brief   Capture mode, an @p eicucapturemode_t value.
+   */
+  uint8_t                 mode;
+  /**
+   * @brief   Decoder state flags.
+   */
+  uint8_t                 flags;
+} eicudecoder_t;
+#endif
+
 #include "hal_eicu_lld.h"
 
+#if (EICU_USE_DMA == TRUE) && (EICU_SUPPORTS_DMA != TRUE)
+#error "EICU_USE_DMA not supported by the EICU low level driver"
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -167,6 +216,20 @@ static inline void _eicu_isr_invoke_pwm_period_cb(EICUDriver *eicup,
 } while (0)
 /** @} */
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of captured edges lost on a channel.
+ * @details Edges are lost when the capture ring is overwritten before
+ *          being read by @p eicuReadCaptures().
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] chn       EICU channel
+ *
+ * @xclass
+ */
+#define eicuGetLostEdgesX(eicup, chn) ((eicup)->channel[chn].lost)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -180,6 +243,14 @@ extern "C" {
   void eicuStop(EICUDriver *eicup);
   void eicuEnable(EICUDriver *eicup);
   void eicuDisable(EICUDriver *eicup);
+#if EICU_USE_DMA == TRUE
+  size_t eicuReadCaptures(EICUDriver *eicup, eicuchannel_t channel,
+                          eicuresult_t *rp, size_t n);
+  void eicuDecoderInit(eicudecoder_t *dp, eicucapturemode_t mode,
+                       eicutimerwidth_t width);
+  size_t eicuDecodeEdges(eicudecoder_t *dp, const eicucnt_t *edges, size_t n,
+                         eicuresult_t *rp, size_t *countp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -37,7 +37,10 @@
 #define NAND_CMD_READ0          0x00
 #define NAND_CMD_RNDOUT         0x05
 #define NAND_CMD_PAGEPROG       0x10
+#define NAND_CMD_CACHEPROG      0x15
 #define NAND_CMD_READ0_CONFIRM  0x30
+#define NAND_CMD_READ_CACHE     0x31
+#define NAND_CMD_READ_CACHE_END 0x3F
 #define NAND_CMD_READOOB        0x50
 #define NAND_CMD_ERASE          0x60
 #define NAND_CMD_STATUS         0x70
@@ -48,6 +51,20 @@
 #define NAND_CMD_ERASE_CONFIRM  0xD0
 #define NAND_CMD_RESET          0xFF
 
+/*
+ * Status register bits
+ */
+#define NAND_STATUS_FAIL        0x01    /**< Last operation failed.        */
+#define NAND_STATUS_FAILC       0x02    /**< Previous cache program failed.*/
+#define NAND_STATUS_ARDY        0x20    /**< Array ready.                  */
+#define NAND_STATUS_RDY         0x40    /**< Ready.                        */
+
+/*
+ * Optional device features
+ */
+#define NAND_FEATURE_CACHE_READ     0x01  /**< Read cache sequential.      */
+#define NAND_FEATURE_CACHE_PROGRAM  0x02  /**< Cache program.              */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -58,6 +75,35 @@
 #define NAND_USE_MUTUAL_EXCLUSION     FALSE
 #endif
 
+/**
+ * @brief   Enables the bad block table persistence.
+ * @details The bad block map is stored in the last @p NAND_BBT_BLOCKS
+ *          blocks of the device and loaded by @p nandStart(), the full
+ *          scan only runs when no valid table is found or when the last
+ *          table update has been interrupted.
+ * @note    The reserved blocks are reported as bad in the map.
+ */
+#if !defined(NAND_USE_BBT) || defined(__DOXYGEN__)
+#define NAND_USE_BBT                  FALSE
+#endif
+
+/**
+ * @brief   Number of blocks reserved for the bad block table.
+ * @details Two of them hold the table and its mirror, the others are
+ *          spares for when they go bad.
+ */
+#if !defined(NAND_BBT_BLOCKS) || defined(__DOXYGEN__)
+#define NAND_BBT_BLOCKS               4
+#endif
+
+/**
+ * @brief   Enables the software ECC APIs on the NAND.
+ * @note    Requires @p os/various/nand_ecc.c in the build.
+ */
+#if !defined(NAND_USE_SOFT_ECC) || defined(__DOXYGEN__)
+#define NAND_USE_SOFT_ECC             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -65,6 +111,10 @@
 #error "NAND_USE_MUTUAL_EXCLUSION requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
 
+#if NAND_USE_BBT && ((NAND_BBT_BLOCKS < 2) || (NAND_BBT_BLOCKS > 32))
+#error "invalid NAND_BBT_BLOCKS value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -92,6 +142,10 @@ typedef struct NANDDriver NANDDriver;
 
 #include "hal_nand_lld.h"
 
+#if NAND_USE_SOFT_ECC
+#include "nand_ecc.h"
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -120,6 +174,18 @@ extern "C" {
                             const void *data, size_t datalen, uint32_t *ecc);
   uint8_t nandWritePageSpare(NANDDriver *nandp, uint32_t block, uint32_t page,
                              const void *spare, size_t sparelen);
+  void nandReadPages(NANDDriver *nandp, uint32_t block, uint32_t page,
+                     size_t npages, void *data, size_t datalen,
+                     uint32_t *ecc);
+  uint8_t nandWritePages(NANDDriver *nandp, uint32_t block, uint32_t page,
+                         size_t npages, const void *data, size_t datalen,
+                         uint32_t *ecc);
+#if NAND_USE_SOFT_ECC
+  int nandReadPageEcc(NANDDriver *nandp, uint32_t block, uint32_t page,
+                      const nand_ecc_t *eccp, void *data);
+  uint8_t nandWritePageEcc(NANDDriver *nandp, uint32_t block, uint32_t page,
+                           const nand_ecc_t *eccp, void *data);
+#endif
   uint16_t nandReadBadMark(NANDDriver *nandp, uint32_t block, uint32_t page);
   void nandMarkBad(NANDDriver *nandp, uint32_t block);
   bool nandIsBad(NANDDriver *nandp, uint32_t block);
@@ -45,6 +45,9 @@
 #define ONEWIRE_CMD_SKIP_ROM              0xCC
 #define ONEWIRE_CMD_CONVERT_TEMP          0x44
 #define ONEWIRE_CMD_READ_SCRATCHPAD       0xBE
+#define ONEWIRE_CMD_ALARM_SEARCH          0xEC
+#define ONEWIRE_CMD_OVERDRIVE_SKIP_ROM    0x3C
+#define ONEWIRE_CMD_OVERDRIVE_MATCH_ROM   0x69
 
 /**
  * @brief   How many bits will be used for transaction length storage.
@@ -59,6 +62,32 @@
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
+/**
+ * @brief   Uses a UART as timeslot engine instead of a PWM timer.
+ * @details Every timeslot is a single UART character, reset pulses are sent
+ *          at 9600 baud and data timeslots at 115200 baud, the bus is sampled
+ *          through the echo of the character on the open drain line.
+ *          Characters are moved by the UART driver (DMA on most ports), so a
+ *          whole transfer completes with a single interrupt instead of one or
+ *          two interrupts per bit, and timeslots do not depend on interrupt
+ *          latency.
+ * @note    TX and RX must be connected together to the bus, e.g. with the
+ *          single wire half duplex mode and an open drain TX pad.
+ */
+#if !defined(ONEWIRE_USE_UART) || defined(__DOXYGEN__)
+#define ONEWIRE_USE_UART                  FALSE
+#endif
+
+/**
+ * @brief   UART backend timeslot buffer size.
+ * @details One byte per timeslot, transfers longer than this are split in
+ *          chunks, each one costing one interrupt. The default fits a
+ *          whole DS18B20 scratchpad.
+ */
+#if !defined(ONEWIRE_UART_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define ONEWIRE_UART_BUFFER_SIZE          72U
+#endif
+
 #if ONEWIRE_SYNTH_SEARCH_TEST && !ONEWIRE_USE_SEARCH_ROM
 #error "Synthetic search rom test needs ONEWIRE_USE_SEARCH_ROM"
 #endif
@@ -66,9 +95,24 @@
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
+#if ONEWIRE_USE_UART
+#if !HAL_USE_UART
+#error "1-wire Driver UART backend requires HAL_USE_UART"
+#endif
+
+#if ONEWIRE_SYNTH_SEARCH_TEST
+#error "Synthetic search rom test needs the PWM backend"
+#endif
+
+#if (ONEWIRE_UART_BUFFER_SIZE < 8U) || ((ONEWIRE_UART_BUFFER_SIZE % 8U) != 0)
+#error "ONEWIRE_UART_BUFFER_SIZE must be a non zero multiple of 8"
+#endif
+
+#else /* !ONEWIRE_USE_UART */
 #if !HAL_USE_PWM
 #error "1-wire Driver requires HAL_USE_PWM"
 #endif
+#endif /* !ONEWIRE_USE_UART */
 
 #if !HAL_USE_PAL
 #error "1-wire Driver requires HAL_USE_PAL"
@@ -124,6 +168,18 @@ typedef enum {
  * @brief   Driver configuration structure.
  */
 typedef struct {
+#if ONEWIRE_USE_UART
+  /**
+   * @brief Pointer to @p UART driver used for communication.
+   */
+  UARTDriver                *uartd;
+  /**
+   * @brief Pointer to configuration structure for underlying UART driver.
+   * @note  The driver works on its own copy, the speed and the receive
+   *        end callback of this structure are ignored.
+   */
+  const UARTConfig          *uartcfg;
+#else /* !ONEWIRE_USE_UART */
   /**
    * @brief Pointer to @p PWM driver used for communication.
    */
@@ -150,6 +206,7 @@ typedef struct {
    * @brief Number of PWM channel used as sample interrupt generator.
    */
   size_t                    sample_channel;
+#endif /* !ONEWIRE_USE_UART */
   /**
    * @brief   Port Identifier.
    * @details This type can be a scalar or some kind of pointer, do not make
@@ -283,6 +340,10 @@ typedef struct {
    * @brief   Bool flag for premature timer stop prevention.
    */
   uint32_t      final_timeslot: 1;
+  /**
+   * @brief   Bool flag. If @p true timeslots use overdrive speed.
+   */
+  uint32_t      overdrive: 1;
   /**
    * @brief   Bytes number to be processing in current transaction.
    */
@@ -311,6 +372,19 @@ typedef struct {
    */
   onewire_search_rom_t  search_rom;
 #endif /* ONEWIRE_USE_SEARCH_ROM */
+#if ONEWIRE_USE_UART
+  /**
+   * @brief   UART configuration, a copy of the user one with the current
+   *          speed and the driver receive end callback.
+   */
+  UARTConfig            uartcfg;
+  /**
+   * @brief   Timeslot buffer, one character per timeslot.
+   * @note    Transmitted and received in place, the echo of a character
+   *          always arrives after the character has been sent.
+   */
+  uint8_t               uart_buf[ONEWIRE_UART_BUFFER_SIZE];
+#endif /* ONEWIRE_USE_UART */
   /**
    * @brief   Thread waiting for I/O completion.
    */
@@ -338,9 +412,12 @@ extern "C" {
   uint8_t onewireCRC(const uint8_t *buf, size_t len);
   void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
                     size_t txbytes, systime_t pullup_time);
+  bool onewireSetOverdrive(onewireDriver *owp, bool enable);
 #if ONEWIRE_USE_SEARCH_ROM
   size_t onewireSearchRom(onewireDriver *owp,
                           uint8_t *result, size_t max_rom_cnt);
+  size_t onewireSearchAlarm(onewireDriver *owp,
+                            uint8_t *result, size_t max_rom_cnt);
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 #if ONEWIRE_SYNTH_SEARCH_TEST
   void _synth_ow_write_bit(onewireDriver *owp, ioline_t bit);
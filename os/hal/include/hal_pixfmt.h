@@ -0,0 +1,476 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_pixfmt.h
+ * @brief   Pixel format conversion library.
+ * @details Header-only library shared by the LTDC and DMA2D drivers.
+ *          Every pixel format gets its own inline load, store and
+ *          conversion functions, named after the format, so that a
+ *          conversion between two formats known at compile time has no
+ *          format dispatch at all. Span kernels for every format pair are
+ *          generated by @p PIXFMT_SPAN_KERNEL(), while
+ *          @p PIXFMT_SPAN_TABLE() builds a dispatch table, so that code
+ *          working with run-time formats selects its kernel once per span
+ *          instead of once per pixel; @p pixfmtConvertSpan() is the shared
+ *          instance of that table.
+ * @note    Format identifiers match the LTDC and DMA2D register encodings.
+ *
+ * @addtogroup pixfmt
+ * @{
+ */
+
+#ifndef HAL_PIXFMT_H_
+#define HAL_PIXFMT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Constants.                                                                */
+/*===========================================================================*/
+
+/**
+ * @name    Pixel formats
+ * @{
+ */
+#define PIXFMT_ARGB8888         (0)           /**< ARGB-8888 format.*/
+#define PIXFMT_RGB888           (1)           /**< RGB-888 format.*/
+#define PIXFMT_RGB565           (2)           /**< RGB-565 format.*/
+#define PIXFMT_ARGB1555         (3)           /**< ARGB-1555 format.*/
+#define PIXFMT_ARGB4444         (4)           /**< ARGB-4444 format.*/
+#define PIXFMT_L8               (5)           /**< L-8 format.*/
+#define PIXFMT_AL44             (6)           /**< AL-44 format.*/
+#define PIXFMT_AL88             (7)           /**< AL-88 format.*/
+#define PIXFMT_L4               (8)           /**< L-4 format.*/
+#define PIXFMT_A8               (9)           /**< A-8 format.*/
+#define PIXFMT_A4               (10)          /**< A-4 format.*/
+
+/** Number of pixel formats. */
+#define PIXFMT_COUNT            (11)
+/** @} */
+
+/**
+ * @brief   Bits per pixel of every format, in units of 4 bits.
+ * @details One nibble per format, format 0 in the least significant nibble.
+ */
+#define PIXFMT_BPP_NIBBLES      (0x12142244468ULL)
+
+/*===========================================================================*/
+/* Macros.                                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Bits per pixel of a format.
+ * @note    Constant expression if @p fmt is constant.
+ *
+ * @param[in] fmt       pixel format
+ *
+ * @return              bits per pixel
+ */
+#define PIXFMT_BPP(fmt) \
+  ((unsigned)((PIXFMT_BPP_NIBBLES >> ((unsigned)(fmt) << 2)) & 0xF) << 2)
+
+/**
+ * @brief   Applies @p X to the name of every pixel format.
+ */
+#define PIXFMT_FOR_EACH(X)                                                  \
+  X(ARGB8888) X(RGB888) X(RGB565) X(ARGB1555) X(ARGB4444) X(L8) X(AL44)     \
+  X(AL88) X(L4) X(A8) X(A4)
+
+/**
+ * @brief   Span conversion kernel name.
+ *
+ * @param[in] S         source format name, e.g. @p RGB565
+ * @param[in] D         destination format name, e.g. @p ARGB8888
+ */
+#define PIXFMT_SPAN(S, D)           pixfmt_span_##S##_to_##D
+
+/**
+ * @brief   Defines the span conversion kernel between two formats.
+ * @details The kernel converts @p n pixels, every pixel going through
+ *          ARGB-8888 with the per-format inline functions only. Converting
+ *          a format into itself is a plain copy.
+ *
+ * @param[in] S         source format name, e.g. @p RGB565
+ * @param[in] D         destination format name, e.g. @p ARGB8888
+ */
+#define PIXFMT_SPAN_KERNEL(S, D)                                            \
+  static inline void PIXFMT_SPAN(S, D)(const void *srcp, void *dstp,        \
+                                       size_t n) {                          \
+    size_t i;                                                               \
+    if (PIXFMT_##S == PIXFMT_##D) {                                         \
+      pixfmt_copy(srcp, dstp, n, PIXFMT_BPP(PIXFMT_##S));                   \
+      return;                                                               \
+    }                                                                       \
+    for (i = 0; i < n; i++)                                                 \
+      pixfmt_store_##D(dstp, i, pixfmt_from_argb8888_##D(                   \
+                       pixfmt_to_argb8888_##S(pixfmt_load_##S(srcp, i))));  \
+  }
+
+/**
+ * @brief   Defines the span conversion kernels from one format to all.
+ *
+ * @param[in] S         source format name
+ */
+#define PIXFMT_SPAN_KERNELS_FROM(S)                                         \
+  PIXFMT_SPAN_KERNEL(S, ARGB8888) PIXFMT_SPAN_KERNEL(S, RGB888)             \
+  PIXFMT_SPAN_KERNEL(S, RGB565)   PIXFMT_SPAN_KERNEL(S, ARGB1555)           \
+  PIXFMT_SPAN_KERNEL(S, ARGB4444) PIXFMT_SPAN_KERNEL(S, L8)                 \
+  PIXFMT_SPAN_KERNEL(S, AL44)     PIXFMT_SPAN_KERNEL(S, AL88)               \
+  PIXFMT_SPAN_KERNEL(S, L4)       PIXFMT_SPAN_KERNEL(S, A8)                 \
+  PIXFMT_SPAN_KERNEL(S, A4)
+
+/**
+ * @brief   Dispatch table row of the kernels from one format.
+ *
+ * @param[in] S         source format name
+ */
+#define PIXFMT_SPAN_ROW(S)                                                  \
+  {                                                                         \
+    PIXFMT_SPAN(S, ARGB8888), PIXFMT_SPAN(S, RGB888),                       \
+    PIXFMT_SPAN(S, RGB565),   PIXFMT_SPAN(S, ARGB1555),                     \
+    PIXFMT_SPAN(S, ARGB4444), PIXFMT_SPAN(S, L8),                           \
+    PIXFMT_SPAN(S, AL44),     PIXFMT_SPAN(S, AL88),                         \
+    PIXFMT_SPAN(S, L4),       PIXFMT_SPAN(S, A8),                           \
+    PIXFMT_SPAN(S, A4)                                                      \
+  },
+
+/**
+ * @brief   Defines a span kernel dispatch table.
+ * @details The table is indexed by source then destination format. Only
+ *          the kernels referenced by the table are instantiated, in the
+ *          translation unit using this macro.
+ *
+ * @param[in] name      table name
+ */
+#define PIXFMT_SPAN_TABLE(name)                                             \
+  static const pixfmt_span_t name[PIXFMT_COUNT][PIXFMT_COUNT] = {           \
+    PIXFMT_FOR_EACH(PIXFMT_SPAN_ROW)                                        \
+  }
+
+/*===========================================================================*/
+/* Data types.                                                               */
+/*===========================================================================*/
+
+/**
+ * @brief   Span conversion kernel.
+ */
+typedef void (*pixfmt_span_t)(const void *srcp, void *dstp, size_t n);
+
+/*===========================================================================*/
+/* Inline functions.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Copies a span of pixels.
+ *
+ * @param[in] srcp      source pixels
+ * @param[out] dstp     destination pixels
+ * @param[in] n         number of pixels
+ * @param[in] bpp       bits per pixel
+ *
+ * @notapi
+ */
+static inline void pixfmt_copy(const void *srcp, void *dstp,
+                               size_t n, unsigned bpp) {
+
+  const uint8_t *s = (const uint8_t *)srcp;
+  uint8_t *d = (uint8_t *)dstp;
+  size_t bytes = (n * bpp) >> 3;
+
+  while (bytes--)
+    *d++ = *s++;
+  if ((n * bpp) & 7)
+    *d = (uint8_t)((*d & 0xF0) | (*s & 0x0F));
+}
+
+/**
+ * @name    Raw pixel access
+ * @details Raw values are right aligned and zero padded.
+ * @{
+ */
+
+static inline uint32_t pixfmt_load_32(const void *p, size_t i) {
+  return ((const uint32_t *)p)[i];
+}
+
+static inline void pixfmt_store_32(void *p, size_t i, uint32_t raw) {
+  ((uint32_t *)p)[i] = raw;
+}
+
+static inline uint32_t pixfmt_load_24(const void *p, size_t i) {
+  const uint8_t *b = (const uint8_t *)p + i * 3;
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16);
+}
+
+static inline void pixfmt_store_24(void *p, size_t i, uint32_t raw) {
+  uint8_t *b = (uint8_t *)p + i * 3;
+  b[0] = (uint8_t)raw;
+  b[1] = (uint8_t)(raw >> 8);
+  b[2] = (uint8_t)(raw >> 16);
+}
+
+static inline uint32_t pixfmt_load_16(const void *p, size_t i) {
+  return ((const uint16_t *)p)[i];
+}
+
+static inline void pixfmt_store_16(void *p, size_t i, uint32_t raw) {
+  ((uint16_t *)p)[i] = (uint16_t)raw;
+}
+
+static inline uint32_t pixfmt_load_8(const void *p, size_t i) {
+  return ((const uint8_t *)p)[i];
+}
+
+static inline void pixfmt_store_8(void *p, size_t i, uint32_t raw) {
+  ((uint8_t *)p)[i] = (uint8_t)raw;
+}
+
+/* 4-bit formats: even pixels in the low nibble.*/
+static inline uint32_t pixfmt_load_4(const void *p, size_t i) {
+  return (((const uint8_t *)p)[i >> 1] >> ((i & 1) << 2)) & 0x0F;
+}
+
+static inline void pixfmt_store_4(void *p, size_t i, uint32_t raw) {
+  uint8_t *b = (uint8_t *)p + (i >> 1);
+  unsigned shift = (unsigned)(i & 1) << 2;
+  *b = (uint8_t)((*b & ~(0x0F << shift)) | ((raw & 0x0F) << shift));
+}
+
+#define pixfmt_load_ARGB8888        pixfmt_load_32
+#define pixfmt_store_ARGB8888       pixfmt_store_32
+#define pixfmt_load_RGB888          pixfmt_load_24
+#define pixfmt_store_RGB888         pixfmt_store_24
+#define pixfmt_load_RGB565          pixfmt_load_16
+#define pixfmt_store_RGB565         pixfmt_store_16
+#define pixfmt_load_ARGB1555        pixfmt_load_16
+#define pixfmt_store_ARGB1555       pixfmt_store_16
+#define pixfmt_load_ARGB4444        pixfmt_load_16
+#define pixfmt_store_ARGB4444       pixfmt_store_16
+#define pixfmt_load_L8              pixfmt_load_8
+#define pixfmt_store_L8             pixfmt_store_8
+#define pixfmt_load_AL44            pixfmt_load_8
+#define pixfmt_store_AL44           pixfmt_store_8
+#define pixfmt_load_AL88            pixfmt_load_16
+#define pixfmt_store_AL88           pixfmt_store_16
+#define pixfmt_load_L4              pixfmt_load_4
+#define pixfmt_store_L4             pixfmt_store_4
+#define pixfmt_load_A8              pixfmt_load_8
+#define pixfmt_store_A8             pixfmt_store_8
+#define pixfmt_load_A4              pixfmt_load_4
+#define pixfmt_store_A4             pixfmt_store_4
+/** @} */
+
+/**
+ * @name    Conversions from ARGB-8888
+ * @details Return the raw value of the target format, left padded with
+ *          zeros. Luminance is mapped onto the blue component.
+ * @{
+ */
+
+static inline uint32_t pixfmt_from_argb8888_ARGB8888(uint32_t c) {
+  return c;
+}
+
+static inline uint32_t pixfmt_from_argb8888_RGB888(uint32_t c) {
+  return (c & 0x00FFFFFF);
+}
+
+static inline uint32_t pixfmt_from_argb8888_RGB565(uint32_t c) {
+  return (((c & 0x000000F8) >> ( 8 -  5)) |
+          ((c & 0x0000FC00) >> (16 - 11)) |
+          ((c & 0x00F80000) >> (24 - 16)));
+}
+
+static inline uint32_t pixfmt_from_argb8888_ARGB1555(uint32_t c) {
+  return (((c & 0x000000F8) >> ( 8 -  5)) |
+          ((c & 0x0000F800) >> (16 - 10)) |
+          ((c & 0x00F80000) >> (24 - 15)) |
+          ((c & 0x80000000) >> (32 - 16)));
+}
+
+static inline uint32_t pixfmt_from_argb8888_ARGB4444(uint32_t c) {
+  return (((c & 0x000000F0) >> ( 8 -  4)) |
+          ((c & 0x0000F000) >> (16 -  8)) |
+          ((c & 0x00F00000) >> (24 - 12)) |
+          ((c & 0xF0000000) >> (32 - 16)));
+}
+
+static inline uint32_t pixfmt_from_argb8888_L8(uint32_t c) {
+  return (c & 0x000000FF);
+}
+
+static inline uint32_t pixfmt_from_argb8888_AL44(uint32_t c) {
+  return (((c & 0x000000F0) >> ( 8 - 4)) |
+          ((c & 0xF0000000) >> (32 - 8)));
+}
+
+static inline uint32_t pixfmt_from_argb8888_AL88(uint32_t c) {
+  return (((c & 0x000000FF) >> ( 8 -  8)) |
+          ((c & 0xFF000000) >> (32 - 16)));
+}
+
+static inline uint32_t pixfmt_from_argb8888_L4(uint32_t c) {
+  return (c & 0x0000000F);
+}
+
+static inline uint32_t pixfmt_from_argb8888_A8(uint32_t c) {
+  return ((c & 0xFF000000) >> (32 - 8));
+}
+
+static inline uint32_t pixfmt_from_argb8888_A4(uint32_t c) {
+  return ((c & 0xF0000000) >> (32 - 4));
+}
+/** @} */
+
+/**
+ * @name    Conversions to ARGB-8888
+ * @details Take the raw value of the source format, left padded with zeros.
+ *          Non-zero components are expanded with their low bits set.
+ * @{
+ */
+
+static inline uint32_t pixfmt_to_argb8888_ARGB8888(uint32_t c) {
+  return c;
+}
+
+static inline uint32_t pixfmt_to_argb8888_RGB888(uint32_t c) {
+  return ((c & 0x00FFFFFF) | 0xFF000000);
+}
+
+static inline uint32_t pixfmt_to_argb8888_RGB565(uint32_t c) {
+  uint32_t output = 0xFF000000;
+  if (c & 0x001F) output |= (((c & 0x001F) << ( 8 -  5)) | 0x00000007);
+  if (c & 0x07E0) output |= (((c & 0x07E0) << (16 - 11)) | 0x00000300);
+  if (c & 0xF800) output |= (((c & 0xF800) << (24 - 16)) | 0x00070000);
+  return output;
+}
+
+static inline uint32_t pixfmt_to_argb8888_ARGB1555(uint32_t c) {
+  uint32_t output = 0x00000000;
+  if (c & 0x001F) output |= (((c & 0x001F) << ( 8 -  5)) | 0x00000007);
+  if (c & 0x03E0) output |= (((c & 0x03E0) << (16 - 10)) | 0x00000700);
+  if (c & 0x7C00) output |= (((c & 0x7C00) << (24 - 15)) | 0x00070000);
+  if (c & 0x8000) output |= 0xFF000000;
+  return output;
+}
+
+static inline uint32_t pixfmt_to_argb8888_ARGB4444(uint32_t c) {
+  uint32_t output = 0x00000000;
+  if (c & 0x000F) output |= (((c & 0x000F) << ( 8 -  4)) | 0x0000000F);
+  if (c & 0x00F0) output |= (((c & 0x00F0) << (16 -  8)) | 0x00000F00);
+  if (c & 0x0F00) output |= (((c & 0x0F00) << (24 - 12)) | 0x000F0000);
+  if (c & 0xF000) output |= (((c & 0xF000) << (32 - 16)) | 0x0F000000);
+  return output;
+}
+
+static inline uint32_t pixfmt_to_argb8888_L8(uint32_t c) {
+  return ((c & 0xFF) | 0xFF000000);
+}
+
+static inline uint32_t pixfmt_to_argb8888_AL44(uint32_t c) {
+  uint32_t output = 0x00000000;
+  if (c & 0x0F) output |= (((c & 0x0F) << ( 8 - 4)) | 0x0000000F);
+  if (c & 0xF0) output |= (((c & 0xF0) << (32 - 8)) | 0x0F000000);
+  return output;
+}
+
+static inline uint32_t pixfmt_to_argb8888_AL88(uint32_t c) {
+  return (((c & 0x00FF) << ( 8 -  8)) |
+          ((c & 0xFF00) << (32 - 16)));
+}
+
+static inline uint32_t pixfmt_to_argb8888_L4(uint32_t c) {
+  return ((c & 0x0F) | 0xFF000000);
+}
+
+static inline uint32_t pixfmt_to_argb8888_A8(uint32_t c) {
+  return ((c & 0xFF) << (32 - 8));
+}
+
+static inline uint32_t pixfmt_to_argb8888_A4(uint32_t c) {
+  return ((c & 0x0F) << (32 - 4));
+}
+/** @} */
+
+/**
+ * @name    Span conversion kernels
+ * @{
+ */
+PIXFMT_FOR_EACH(PIXFMT_SPAN_KERNELS_FROM)
+/** @} */
+
+/**
+ * @brief   Converts a color from ARGB-8888.
+ * @note    Folded to a single conversion if @p fmt is constant.
+ *
+ * @param[in] c         color, ARGB-8888
+ * @param[in] fmt       target pixel format
+ *
+ * @return              raw color value for the target pixel format, left
+ *                      padded with zeros, or 0 for invalid formats.
+ */
+static inline uint32_t pixfmtFromARGB8888(uint32_t c, unsigned fmt) {
+
+  switch (fmt) {
+#define PIXFMT_FROM_CASE(F)                                                 \
+  case PIXFMT_##F: return pixfmt_from_argb8888_##F(c);
+  PIXFMT_FOR_EACH(PIXFMT_FROM_CASE)
+#undef PIXFMT_FROM_CASE
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief   Converts a color to ARGB-8888.
+ * @note    Folded to a single conversion if @p fmt is constant.
+ *
+ * @param[in] c         color for the source pixel format, left padded with
+ *                      zeros
+ * @param[in] fmt       source pixel format
+ *
+ * @return              color in ARGB-8888 format, or 0 for invalid formats.
+ */
+static inline uint32_t pixfmtToARGB8888(uint32_t c, unsigned fmt) {
+
+  switch (fmt) {
+#define PIXFMT_TO_CASE(F)                                                   \
+  case PIXFMT_##F: return pixfmt_to_argb8888_##F(c);
+  PIXFMT_FOR_EACH(PIXFMT_TO_CASE)
+#undef PIXFMT_TO_CASE
+  default:
+    return 0;
+  }
+}
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void pixfmtConvertSpan(const void *srcp, unsigned srcfmt,
+                         void *dstp, unsigned dstfmt, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_PIXFMT_H_ */
+
+/** @} */
@@ -40,10 +40,61 @@
 #define RNG_USE_MUTUAL_EXCLUSION        TRUE
 #endif
 
+/**
+ * @brief   Enables the buffered random service APIs.
+ * @details A background thread feeds a ChaCha20 DRBG from the RNG driver,
+ *          random bytes are then served at memory speed through per-thread
+ *          @p RNGStream objects.
+ * @note    Requires @p os/various/csprng.c in the build, hal.mk adds it
+ *          when @p USE_SMART_BUILD is enabled.
+ */
+#if !defined(RNG_USE_CSPRNG) || defined(__DOXYGEN__)
+#define RNG_USE_CSPRNG                  FALSE
+#endif
+
+/**
+ * @brief   Raw entropy bytes collected for each reseed.
+ */
+#if !defined(RNG_CSPRNG_POOL_SIZE) || defined(__DOXYGEN__)
+#define RNG_CSPRNG_POOL_SIZE            64
+#endif
+
+/**
+ * @brief   Interval between reseeds, in milliseconds.
+ */
+#if !defined(RNG_CSPRNG_RESEED_INTERVAL) || defined(__DOXYGEN__)
+#define RNG_CSPRNG_RESEED_INTERVAL      1000
+#endif
+
+/**
+ * @brief   Min-entropy assumed for a raw byte, in bits.
+ * @details Sets the health tests cutoffs.
+ */
+#if !defined(RNG_CSPRNG_MIN_ENTROPY) || defined(__DOXYGEN__)
+#define RNG_CSPRNG_MIN_ENTROPY          4
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if RNG_USE_CSPRNG == TRUE
+#if RNG_CSPRNG_POOL_SIZE < 32
+#error "RNG_CSPRNG_POOL_SIZE must be at least 32"
+#endif
+
+#if (RNG_CSPRNG_MIN_ENTROPY < 1) || (RNG_CSPRNG_MIN_ENTROPY > 8)
+#error "invalid RNG_CSPRNG_MIN_ENTROPY value"
+#endif
+
+#if RNG_CSPRNG_POOL_SIZE * RNG_CSPRNG_MIN_ENTROPY < 256
+#error "RNG_CSPRNG_POOL_SIZE too small for 256 bits of entropy"
+#endif
+
+#include "csprng.h"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -59,6 +110,25 @@ typedef enum {
 
 #include "hal_rng_lld.h"
 
+#if (RNG_USE_CSPRNG == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Random stream structure.
+ * @details A stream belongs to a single thread, reads do not lock. The
+ *          stream reseeds from the service generator each time the
+ *          service reseeds from the hardware.
+ */
+typedef struct {
+  /**
+   * @brief   Stream generator.
+   */
+  csprng_t                  drbg;
+  /**
+   * @brief   Service reseed count the stream was last seeded at.
+   */
+  uint32_t                  epoch;
+} RNGStream;
+#endif
+
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -125,6 +195,13 @@ extern "C" {
   void rngAcquireUnit(RNGDriver *rngp);
   void rngReleaseUnit(RNGDriver *rngp);
 #endif
+#if RNG_USE_CSPRNG == TRUE
+  void rngServiceStart(RNGDriver *rngp);
+  void rngServiceStop(void);
+  uint32_t rngServiceHealthFailures(void);
+  void rngStreamObjectInit(RNGStream *sp);
+  void rngStreamRead(RNGStream *sp, uint8_t *buf, size_t n);
+#endif
 #ifdef __cplusplus
 }
 #endif
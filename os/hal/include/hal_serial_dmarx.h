@@ -0,0 +1,162 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_serial_dmarx.h
+ * @brief   Serial DMA circular receive helpers.
+ * @details Shared by the serial low level drivers receiving through a DMA
+ *          channel running in circular mode. The DMA fills a ring buffer,
+ *          the driver periodically moves the received bytes to the input
+ *          queue of the @p SerialDriver: on half and full ring transfers
+ *          and when the line goes idle.
+ * @note    The ring must be flushed before the DMA wraps over the unread
+ *          bytes, i.e. at least once per ring size bytes received. Sizing
+ *          the ring for the worst case interrupt latency is up to the
+ *          application.
+ *
+ * @addtogroup SERIAL_DMARX
+ * @{
+ */
+
+#ifndef HAL_SERIAL_DMARX_H
+#define HAL_SERIAL_DMARX_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   DMA receive ring.
+ */
+typedef struct {
+  /**
+   * @brief   Ring buffer written by the DMA.
+   */
+  uint8_t                   *buffer;
+  /**
+   * @brief   Ring buffer size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Index of the next byte to move to the input queue.
+   */
+  size_t                    rdidx;
+} sd_dmarx_ring_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a DMA receive ring.
+ *
+ * @param[out] rp       pointer to the @p sd_dmarx_ring_t object
+ * @param[in] buffer    ring buffer written by the DMA
+ * @param[in] size      ring buffer size
+ *
+ * @init
+ */
+static inline void sdDmaRxRingInit(sd_dmarx_ring_t *rp,
+                                   uint8_t *buffer, size_t size) {
+
+  rp->buffer = buffer;
+  rp->size   = size;
+  rp->rdidx  = 0U;
+}
+
+/**
+ * @brief   Number of bytes written by the DMA and not yet moved.
+ * @note    A full wrap since the last flush is indistinguishable from no
+ *          data at all, see the note about the ring sizing.
+ *
+ * @param[in] rp        pointer to the @p sd_dmarx_ring_t object
+ * @param[in] wridx     index of the next byte the DMA will write, @p size
+ *                      is accepted as an alias of zero
+ * @return              The number of pending bytes.
+ *
+ * @xclass
+ */
+static inline size_t sdDmaRxRingPendingX(const sd_dmarx_ring_t *rp,
+                                         size_t wridx) {
+
+  if (wridx >= rp->size) {
+    wridx = 0U;
+  }
+  if (wridx >= rp->rdidx) {
+    return wridx - rp->rdidx;
+  }
+  return (rp->size - rp->rdidx) + wridx;
+}
+
+/**
+ * @brief   Moves the bytes written by the DMA to an input queue.
+ * @details The returned flags are meant to be broadcast by the caller with
+ *          @p chnAddFlagsI(), if not zero.
+ *
+ * @param[in] rp        pointer to the @p sd_dmarx_ring_t object
+ * @param[in] iqp       pointer to the input queue
+ * @param[in] wridx     index of the next byte the DMA will write, @p size
+ *                      is accepted as an alias of zero
+ * @return              The event flags to broadcast.
+ * @retval 0            nothing to report.
+ *
+ * @iclass
+ */
+static inline eventflags_t sdDmaRxRingFlushI(sd_dmarx_ring_t *rp,
+                                             input_queue_t *iqp,
+                                             size_t wridx) {
+  eventflags_t flags = (eventflags_t)0;
+  size_t n = sdDmaRxRingPendingX(rp, wridx);
+
+  osalDbgCheckClassI();
+
+  if (n == 0U) {
+    return flags;
+  }
+  if (iqIsEmptyI(iqp)) {
+    flags |= CHN_INPUT_AVAILABLE;
+  }
+  while (n > 0U) {
+    if (iqPutI(iqp, rp->buffer[rp->rdidx]) < MSG_OK) {
+      flags |= SD_QUEUE_FULL_ERROR;
+    }
+    if (++rp->rdidx >= rp->size) {
+      rp->rdidx = 0U;
+    }
+    n--;
+  }
+  return flags;
+}
+
+#endif /* HAL_SERIAL_DMARX_H */
+
+/** @} */
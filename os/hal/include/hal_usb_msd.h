@@ -39,6 +39,15 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Largest single USB data transfer, in bytes.
+ * @details Longer data phases are split in transfers of this size, it must
+ *          not exceed the transfer size limit of the USB low level driver.
+ */
+#if !defined(USB_MSD_MAX_TRANSFER_SIZE) || defined(__DOXYGEN__)
+#define USB_MSD_MAX_TRANSFER_SIZE       32768
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -51,6 +60,10 @@
 #error "Mass storage Driver requires USB_USE_WAIT"
 #endif
 
+#if USB_MSD_MAX_TRANSFER_SIZE < 512
+#error "invalid USB_MSD_MAX_TRANSFER_SIZE value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -175,6 +188,8 @@ extern "C" {
                 const scsi_inquiry_response_t *scsi_inquiry_response,
                 const scsi_unit_serial_number_inquiry_response_t *serialInquiry);
   void msdStop(USBMassStorageDriver *msdp);
+  void msdSetBufferSize(USBMassStorageDriver *msdp, size_t size);
+  void msdSetBlockMap(USBMassStorageDriver *msdp, scsi_blk_map_t map);
   bool msd_request_hook(USBDriver *usbp);
 #ifdef __cplusplus
 }
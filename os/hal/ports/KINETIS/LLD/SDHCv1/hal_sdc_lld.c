@@ -35,6 +35,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_SDC == TRUE) || defined(__DOXYGEN__)
@@ -101,6 +103,29 @@
 #define MMC_ERR_CSD_OVERWRITE           (1U << 16)
 #define MMC_ERR_AKE_SEQ                 (1U << 3)
 
+/* SD application command SET_WR_BLK_ERASE_COUNT. */
+#define SD_ACMD_SET_WR_BLK_ERASE_COUNT  23U
+
+/* Interrupt status bits ending the command and the data phases. */
+#define SDHC_CMD_END_BITS                                                   \
+  (SDHC_IRQSTAT_CIE | SDHC_IRQSTAT_CEBE | SDHC_IRQSTAT_CCE |                \
+   SDHC_IRQSTAT_CTOE | /* SDHC_IRQSTAT_CRM | */ SDHC_IRQSTAT_CC)
+#define SDHC_XFER_END_BITS                                                  \
+  (SDHC_IRQSTAT_DMAE | SDHC_IRQSTAT_AC12E | SDHC_IRQSTAT_DEBE |             \
+   SDHC_IRQSTAT_DCE | SDHC_IRQSTAT_DTOE | SDHC_IRQSTAT_TC)
+
+/* DMA select field of PROCTL. */
+#define SDHC_PROCTL_DMAS_SDMA           (0U << SDHC_PROCTL_DMAS_SHIFT)
+#define SDHC_PROCTL_DMAS_ADMA2          (2U << SDHC_PROCTL_DMAS_SHIFT)
+
+/* Phases of the running queued request. */
+#define SDC_Q_IDLE                      0U
+#define SDC_Q_APP_CMD                   1U
+#define SDC_Q_PRE_ERASE                 2U
+#define SDC_Q_DATA_CMD                  3U
+#define SDC_Q_DATA                      4U
+#define SDC_Q_DINT                      5U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -125,6 +150,7 @@ SDCDriver SDCD1;
 static void recover_after_botched_transfer(SDCDriver *);
 static msg_t wait_interrupt(SDCDriver *, uint32_t);
 static bool sdc_lld_transfer(SDCDriver *, uint32_t, uintptr_t, uint32_t, uint32_t);
+static void queue_kick_s(SDCDriver *);
 
 /**
  * Compute the SDCLKFS and DVS values for a given SDCLK divisor.
@@ -255,6 +281,41 @@ static sdcflags_t translate_mmcsd_error(uint32_t cardstatus) {
   return errors;
 }
 
+/**
+ * Translate error bits from a data transfer to the HAL's error flag set.
+ */
+static sdcflags_t translate_data_error(uint32_t status) {
+  sdcflags_t errors = 0;
+
+  /* Data phase errors */
+  if (status & (SDHC_IRQSTAT_DCE|SDHC_IRQSTAT_DEBE)) {
+    errors |= SDC_DATA_CRC_ERROR;
+  }
+  if (status & SDHC_IRQSTAT_DTOE) {
+    errors |= SDC_DATA_TIMEOUT;
+  }
+
+  /* Internal DMA error */
+  if (status & SDHC_IRQSTAT_DMAE) {
+    errors |= SDC_UNHANDLED_ERROR;
+  }
+
+  if (status & SDHC_IRQSTAT_AC12E) {
+    uint32_t cmd12error = SDHC->AC12ERR;
+
+    if (cmd12error & SDHC_AC12ERR_AC12NE) {
+      errors |= SDC_UNHANDLED_ERROR;
+    } else {
+      if (cmd12error & SDHC_AC12ERR_AC12TOE)
+        errors |= SDC_COMMAND_TIMEOUT;
+      if (cmd12error & (SDHC_AC12ERR_AC12CE|SDHC_AC12ERR_AC12EBE))
+        errors |= SDC_CMD_CRC_ERROR;
+    }
+  }
+
+  return errors;
+}
+
 /**
  * @brief Perform one CMD transaction on the SD bus.
  */
@@ -306,13 +367,9 @@ static bool send_and_wait_transfer(SDCDriver *sdcp, uint32_t cmd) {
   osalDbgCheck(cmd & SDHC_XFERTYP_DPSEL);
   osalDbgCheck(cmd & SDHC_XFERTYP_DMAEN);
 
-  const uint32_t cmd_end_bits =
-    SDHC_IRQSTAT_CIE | SDHC_IRQSTAT_CEBE | SDHC_IRQSTAT_CCE |
-    SDHC_IRQSTAT_CTOE | /* SDHC_IRQSTAT_CRM | */ SDHC_IRQSTAT_CC;
+  const uint32_t cmd_end_bits = SDHC_CMD_END_BITS;
 
-  const uint32_t transfer_end_bits =
-    SDHC_IRQSTAT_DMAE | SDHC_IRQSTAT_AC12E | SDHC_IRQSTAT_DEBE |
-    SDHC_IRQSTAT_DCE | SDHC_IRQSTAT_DTOE | SDHC_IRQSTAT_TC;
+  const uint32_t transfer_end_bits = SDHC_XFER_END_BITS;
 
   TRACE(3, cmd);
 
@@ -380,42 +437,15 @@ static bool send_and_wait_transfer(SDCDriver *sdcp, uint32_t cmd) {
 
   /* Handle data transfer errors */
   if ((datastat & ~(SDHC_IRQSTAT_DINT)) != SDHC_IRQSTAT_TC) {
-    bool should_cancel = false;
-
-    /* Data phase errors */
-    if (datastat & (SDHC_IRQSTAT_DCE|SDHC_IRQSTAT_DEBE)) {
-      sdcp->errors |= SDC_DATA_CRC_ERROR;
-      should_cancel = true;
-    }
-    if (datastat & SDHC_IRQSTAT_DTOE) {
-      sdcp->errors |= SDC_DATA_TIMEOUT;
-      should_cancel = true;
-    }
-
-    /* Internal DMA error */
-    if (datastat & SDHC_IRQSTAT_DMAE) {
-      sdcp->errors |= SDC_UNHANDLED_ERROR;
-      if (!(datastat & SDHC_IRQSTAT_TC))
-	should_cancel = true;
-    }
-
-    if (datastat & SDHC_IRQSTAT_AC12E) {
-      uint32_t cmd12error = SDHC->AC12ERR;
-
-      /* We don't know if CMD12 was successfully executed */
-      should_cancel = true;
-
-      if (cmd12error & SDHC_AC12ERR_AC12NE) {
-	sdcp->errors |= SDC_UNHANDLED_ERROR;
-      } else {
-	if (cmd12error & SDHC_AC12ERR_AC12TOE)
-	  sdcp->errors |= SDC_COMMAND_TIMEOUT;
-	if (cmd12error & (SDHC_AC12ERR_AC12CE|SDHC_AC12ERR_AC12EBE))
-	  sdcp->errors |= SDC_CMD_CRC_ERROR;
-      }
-    }
-
-    if (should_cancel) {
+    sdcp->errors |= translate_data_error(datastat);
+
+    /* A DMA error after the end of the transfer leaves the card in a
+       sane state, for anything else we don't know if CMD12 was
+       successfully executed. */
+    if ((datastat & (SDHC_IRQSTAT_DCE | SDHC_IRQSTAT_DEBE |
+                     SDHC_IRQSTAT_DTOE | SDHC_IRQSTAT_AC12E)) ||
+        ((datastat & (SDHC_IRQSTAT_DMAE|SDHC_IRQSTAT_TC)) ==
+         SDHC_IRQSTAT_DMAE)) {
       recover_after_botched_transfer(sdcp);
     }
 
@@ -434,7 +464,7 @@ static bool send_and_wait_transfer(SDCDriver *sdcp, uint32_t cmd) {
 	TRACE(7, datastat);
 	break;
       }
-      /* ...?? */
+      wait_interrupt(sdcp, SDHC_IRQSTAT_DINT|SDHC_IRQSTAT_DMAE);
     }
   }
 
@@ -484,6 +514,23 @@ static void recover_after_botched_transfer(SDCDriver *sdcp) {
   SDHC->SYSCTL |= SDHC_SYSCTL_RSTD;
 }
 
+/**
+ * @brief XFERTYP value of a block transfer command.
+ */
+static uint32_t transfer_xfertyp(uint32_t cmdx, uint32_t n) {
+  uint32_t xfer =
+    cmdx |
+    SDHC_XFERTYP_CMDTYP_NORMAL |
+    SDHC_XFERTYP_CICEN | SDHC_XFERTYP_CCCEN |
+    SDHC_XFERTYP_RSPTYP_48b |
+    SDHC_XFERTYP_DPSEL | SDHC_XFERTYP_DMAEN;
+
+  if (n > 1) {
+    xfer |= SDHC_XFERTYP_MSBSEL | SDHC_XFERTYP_BCEN | SDHC_XFERTYP_AC12EN;
+  }
+  return xfer;
+}
+
 /**
  * @brief Perform one data transfer command
  *
@@ -530,24 +577,348 @@ static bool sdc_lld_transfer(SDCDriver *sdcp, uint32_t startblk,
   SDHC->BLKATTR =
     SDHC_BLKATTR_BLKCNT(n) |
     SDHC_BLKATTR_BLKSIZE(MMCSD_BLOCK_SIZE);
-  if (n == 1) {
-    xfer =
-      cmdx |
-      SDHC_XFERTYP_CMDTYP_NORMAL |
-      SDHC_XFERTYP_CICEN | SDHC_XFERTYP_CCCEN |
-      SDHC_XFERTYP_RSPTYP_48b |
-      SDHC_XFERTYP_DPSEL | SDHC_XFERTYP_DMAEN;
+  xfer = transfer_xfertyp(cmdx, n);
+
+  return send_and_wait_transfer(sdcp, xfer);
+}
+
+/**
+ * @brief Whether a write of @p n blocks is preceded by a pre-erase hint.
+ */
+static bool pre_erase_applies(SDCDriver *sdcp, uint32_t n) {
+#if KINETIS_SDC_USE_PRE_ERASE == TRUE
+  uint32_t type = sdcp->cardmode & SDC_MODE_CARDTYPE_MASK;
+
+  return (n > 1) &&
+         ((type == SDC_MODE_CARDTYPE_SDV11) ||
+          (type == SDC_MODE_CARDTYPE_SDV20));
+#else
+  (void)sdcp;
+  (void)n;
+  return false;
+#endif
+}
+
+/**
+ * @brief Send the pre-erase hint for a write of @p n blocks.
+ *
+ * The hint is optional, so its failures are not reported.
+ */
+static void pre_erase(SDCDriver *sdcp, uint32_t n) {
+  sdcflags_t errors = sdcp->errors;
+  uint32_t resp;
+
+  if ((sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_APP_CMD,
+                                  sdcp->rca, &resp) == HAL_SUCCESS) &&
+      ((resp & MMCSD_R1_ERROR_MASK) == 0)) {
+    (void) sdc_lld_send_cmd_short_crc(sdcp, SD_ACMD_SET_WR_BLK_ERASE_COUNT,
+                                      n, &resp);
+  }
+  sdcp->errors = errors;
+}
+
+/**
+ * @brief Start a synchronous operation.
+ *
+ * Waits for the running queued request, if any, and holds the queue
+ * until the matching sync_end(). Performs the card recovery left over
+ * by a failed queued request.
+ *
+ * Calls can be nested.
+ */
+static void sync_begin(SDCDriver *sdcp) {
+  bool recover;
+
+  osalSysLock();
+  while ((sdcp->qhold == 0) && (sdcp->qphase != SDC_Q_IDLE)) {
+    (void) osalThreadEnqueueTimeoutS(&sdcp->qwait, TIME_INFINITE);
+  }
+  sdcp->qhold++;
+  recover = sdcp->qrecover;
+  sdcp->qrecover = false;
+  osalSysUnlock();
+
+  if (recover) {
+    /* The errors were reported by the failed request */
+    sdcflags_t errors = sdcp->errors;
+    recover_after_botched_transfer(sdcp);
+    sdcp->errors = errors;
+  }
+}
+
+/**
+ * @brief End a synchronous operation, restarting the queue.
+ */
+static void sync_end(SDCDriver *sdcp) {
+
+  osalSysLock();
+  osalDbgAssert(sdcp->qhold > 0, "not held");
+  sdcp->qhold--;
+  queue_kick_s(sdcp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief Total size of a scatter-gather list.
+ */
+static uint32_t sg_size(const sdc_kinetis_segment_t *sg, size_t nseg) {
+  uint32_t size = 0;
+
+  while (nseg-- > 0) {
+    size += sg++->size;
+  }
+  return size;
+}
+
+/**
+ * @brief Send a command of a queued request.
+ */
+static void queue_cmd_s(SDCDriver *sdcp, uint8_t phase,
+                        uint32_t cmd, uint32_t arg) {
+
+  SDHC->CMDARG = arg;
+  SDHC->IRQSTAT = SDHC_CMD_END_BITS;
+  SDHC->IRQSTATEN |= SDHC_CMD_END_BITS;
+  sdcp->qphase = phase;
+  SDHC->IRQSIGEN = SDHC_CMD_END_BITS;
+  SDHC->XFERTYP =
+    SDHC_XFERTYP_CMDINX(cmd) |
+    SDHC_XFERTYP_CMDTYP_NORMAL |
+    SDHC_XFERTYP_CICEN | SDHC_XFERTYP_CCCEN |
+    SDHC_XFERTYP_RSPTYP_48;
+}
+
+/**
+ * @brief Start the data transfer of the running queued request.
+ */
+static void queue_data_s(SDCDriver *sdcp) {
+  sdc_kinetis_request_t *rqp = sdcp->qhead;
+  uint32_t cmdx;
+  size_t k;
+
+  /* The list was checked on submission */
+  k = sdcKinetisBuildADMA2(sdcp->adma, KINETIS_SDC_ADMA2_ENTRIES,
+                           rqp->sg, rqp->nseg);
+
+  if (rqp->write) {
+    cmdx = (rqp->n == 1)?
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK) :
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_MULTIPLE_BLOCK);
+  } else {
+    /* DINT signals the last read data reaching memory */
+    sdcp->adma[k - 1].attr |= SDHC_ADMA2_INT;
+    cmdx = (rqp->n == 1)?
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) :
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_MULTIPLE_BLOCK);
+    cmdx |= SDHC_XFERTYP_DTDSEL;
+  }
+
+  if (sdcp->cardmode & SDC_MODE_HIGH_CAPACITY) {
+    SDHC->CMDARG = rqp->startblk;
+  } else {
+    SDHC->CMDARG = rqp->startblk * MMCSD_BLOCK_SIZE;
+  }
+  SDHC->ADSADDR = (uint32_t)(uintptr_t)sdcp->adma;
+  SDHC->PROCTL = (SDHC->PROCTL & ~SDHC_PROCTL_DMAS_MASK) |
+                 SDHC_PROCTL_DMAS_ADMA2;
+  SDHC->BLKATTR =
+    SDHC_BLKATTR_BLKCNT(rqp->n) |
+    SDHC_BLKATTR_BLKSIZE(MMCSD_BLOCK_SIZE);
+
+  SDHC->IRQSTAT = SDHC_CMD_END_BITS | SDHC_XFER_END_BITS | SDHC_IRQSTAT_DINT;
+  SDHC->IRQSTATEN = (SDHC->IRQSTATEN & ~(SDHC_IRQSTAT_BRR|SDHC_IRQSTAT_BWR)) |
+                    (SDHC_CMD_END_BITS | SDHC_XFER_END_BITS | SDHC_IRQSTAT_DINT);
+  sdcp->qphase = SDC_Q_DATA_CMD;
+  SDHC->IRQSIGEN = SDHC_CMD_END_BITS;
+
+  TRACEI(3, cmdx);
+  SDHC->XFERTYP = transfer_xfertyp(cmdx, rqp->n);
+}
+
+/**
+ * @brief Start the first queued request if the queue can run.
+ */
+static void queue_kick_s(SDCDriver *sdcp) {
+  sdc_kinetis_request_t *rqp = sdcp->qhead;
+
+  if ((rqp == NULL) || (sdcp->qphase != SDC_Q_IDLE) ||
+      (sdcp->qhold > 0) || sdcp->qrecover) {
+    return;
+  }
+
+  if (rqp->write && pre_erase_applies(sdcp, rqp->n)) {
+    queue_cmd_s(sdcp, SDC_Q_APP_CMD, MMCSD_CMD_APP_CMD, sdcp->rca);
   } else {
-    xfer =
-      cmdx |
-      SDHC_XFERTYP_CMDTYP_NORMAL |
-      SDHC_XFERTYP_CICEN | SDHC_XFERTYP_CCCEN |
-      SDHC_XFERTYP_RSPTYP_48b |
-      SDHC_XFERTYP_MSBSEL | SDHC_XFERTYP_BCEN | SDHC_XFERTYP_AC12EN |
-      SDHC_XFERTYP_DPSEL | SDHC_XFERTYP_DMAEN;
+    queue_data_s(sdcp);
   }
+}
 
-  return send_and_wait_transfer(sdcp, xfer);
+/**
+ * @brief Complete one queued request.
+ */
+static void queue_complete_s(SDCDriver *sdcp, sdc_kinetis_request_t *rqp,
+                             msg_t msg, sdcflags_t errors) {
+
+  rqp->errors = errors;
+  rqp->status = msg;
+  osalThreadResumeI(&rqp->thread, msg);
+  if (rqp->callback != NULL) {
+    rqp->callback(sdcp, rqp);
+  }
+}
+
+/**
+ * @brief End the running queued request, starting the next one.
+ *
+ * On failure the requests still queued fail too, and the queue stays
+ * stopped until the card is recovered from thread context.
+ */
+static void queue_done_s(SDCDriver *sdcp, msg_t msg, sdcflags_t errors) {
+  sdc_kinetis_request_t *rqp = sdcp->qhead;
+  sdc_kinetis_request_t *rest = NULL;
+
+  sdcp->qhead = rqp->next;
+  if (msg != MSG_OK) {
+    rest = sdcp->qhead;
+    sdcp->qhead = NULL;
+    sdcp->qrecover = true;
+  }
+  if (sdcp->qhead == NULL) {
+    sdcp->qtail = NULL;
+  }
+  sdcp->qphase = SDC_Q_IDLE;
+  SDHC->IRQSIGEN = 0;
+
+  /* The callbacks can queue further requests */
+  queue_complete_s(sdcp, rqp, msg, errors);
+  while (rest != NULL) {
+    rqp = rest;
+    rest = rest->next;
+    queue_complete_s(sdcp, rqp, MSG_RESET, 0);
+  }
+
+  queue_kick_s(sdcp);
+  if (sdcp->qphase == SDC_Q_IDLE) {
+    /* Back to the simple DMA of the synchronous transfers */
+    SDHC->PROCTL = (SDHC->PROCTL & ~SDHC_PROCTL_DMAS_MASK) |
+                   SDHC_PROCTL_DMAS_SDMA;
+    osalThreadDequeueAllI(&sdcp->qwait, MSG_OK);
+  }
+}
+
+/**
+ * @brief Advance the running queued request, from the ISR.
+ */
+static void queue_serve_i(SDCDriver *sdcp) {
+  sdc_kinetis_request_t *rqp = sdcp->qhead;
+  uint32_t status = SDHC->IRQSTAT;
+  uint32_t resp;
+
+  switch (sdcp->qphase) {
+  case SDC_Q_APP_CMD:
+  case SDC_Q_PRE_ERASE:
+    status &= SDHC_CMD_END_BITS;
+    if (status == 0)
+      return;
+    SDHC->IRQSTAT = status;
+    resp = SDHC->CMDRSP[0];
+    if ((status == SDHC_IRQSTAT_CC) && ((resp & MMCSD_R1_ERROR_MASK) == 0)) {
+      if (sdcp->qphase == SDC_Q_APP_CMD) {
+        queue_cmd_s(sdcp, SDC_Q_PRE_ERASE,
+                    SD_ACMD_SET_WR_BLK_ERASE_COUNT, rqp->n);
+        return;
+      }
+    } else if (status != SDHC_IRQSTAT_CC) {
+      /* The hint is optional, just clear the error status */
+      SDHC->SYSCTL |= SDHC_SYSCTL_RSTC;
+      while (SDHC->SYSCTL & SDHC_SYSCTL_RSTC) {
+      }
+    }
+    queue_data_s(sdcp);
+    return;
+
+  case SDC_Q_DATA_CMD:
+    status &= SDHC_CMD_END_BITS;
+    if (status == 0)
+      return;
+    SDHC->IRQSTAT = status;
+    TRACEI(2, status);
+    if (status != SDHC_IRQSTAT_CC) {
+      SDHC->SYSCTL |= SDHC_SYSCTL_RSTC;
+      queue_done_s(sdcp, MSG_RESET, translate_cmd_error(status));
+      return;
+    }
+    resp = SDHC->CMDRSP[0];
+    if (resp & MMCSD_R1_ERROR_MASK) {
+      queue_done_s(sdcp, MSG_RESET, translate_mmcsd_error(resp));
+      return;
+    }
+    /* A transfer already over raises the interrupt again */
+    sdcp->qphase = SDC_Q_DATA;
+    SDHC->IRQSIGEN = SDHC_XFER_END_BITS;
+    return;
+
+  case SDC_Q_DATA:
+    status &= SDHC_XFER_END_BITS | SDHC_IRQSTAT_DINT;
+    if ((status & SDHC_XFER_END_BITS) == 0)
+      return;
+    SDHC->IRQSTAT = status;
+    TRACEI(6, status);
+    if ((status & ~SDHC_IRQSTAT_DINT) != SDHC_IRQSTAT_TC) {
+      queue_done_s(sdcp, MSG_RESET, translate_data_error(status));
+      return;
+    }
+    if (!rqp->write && !(status & SDHC_IRQSTAT_DINT)) {
+      sdcp->qphase = SDC_Q_DINT;
+      SDHC->IRQSIGEN = SDHC_IRQSTAT_DINT | SDHC_IRQSTAT_DMAE;
+      return;
+    }
+    queue_done_s(sdcp, MSG_OK, 0);
+    return;
+
+  case SDC_Q_DINT:
+    status &= SDHC_IRQSTAT_DINT | SDHC_IRQSTAT_DMAE;
+    if (status == 0)
+      return;
+    SDHC->IRQSTAT = status;
+    TRACEI(7, status);
+    if (status & SDHC_IRQSTAT_DMAE) {
+      queue_done_s(sdcp, MSG_RESET, SDC_UNHANDLED_ERROR);
+    } else {
+      queue_done_s(sdcp, MSG_OK, 0);
+    }
+    return;
+
+  default:
+    SDHC->IRQSIGEN = 0;
+    return;
+  }
+}
+
+/**
+ * @brief Queue a synchronous scatter-gather transfer and wait for it.
+ */
+static bool queue_transfer(SDCDriver *sdcp, uint32_t startblk,
+                           const sdc_kinetis_segment_t *sg, size_t nseg,
+                           bool write) {
+  sdc_kinetis_request_t rq;
+
+  osalDbgCheck((sg != NULL) && (nseg > 0));
+  osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
+
+  rq.startblk = startblk;
+  rq.n        = sg_size(sg, nseg) / MMCSD_BLOCK_SIZE;
+  rq.sg       = sg;
+  rq.nseg     = nseg;
+  rq.write    = write;
+  rq.callback = NULL;
+  rq.arg      = NULL;
+  sdcKinetisSubmit(sdcp, &rq);
+  if (sdcKinetisWait(sdcp, &rq) != MSG_OK) {
+    sdcp->errors |= rq.errors;
+    return HAL_FAILED;
+  }
+  return HAL_SUCCESS;
 }
 
 /*===========================================================================*/
@@ -561,12 +932,17 @@ OSAL_IRQ_HANDLER(KINETIS_SDHC_IRQ_VECTOR) {
 
   TRACEI(4, SDHC->IRQSTAT);
 
-  /* We disable the interrupts, and wake up the usermode task to read
-   * the flags from IRQSTAT.
-   */
-  SDHC->IRQSIGEN = 0;
+  if (SDCD1.qphase != SDC_Q_IDLE) {
+    /* Queued requests are handled here */
+    queue_serve_i(&SDCD1);
+  } else {
+    /* We disable the interrupts, and wake up the usermode task to read
+     * the flags from IRQSTAT.
+     */
+    SDHC->IRQSIGEN = 0;
 
-  osalThreadResumeI(&SDCD1.thread, MSG_OK);
+    osalThreadResumeI(&SDCD1.thread, MSG_OK);
+  }
 
   osalSysUnlockFromISR();
   OSAL_IRQ_EPILOGUE();
@@ -585,6 +961,12 @@ OSAL_IRQ_HANDLER(KINETIS_SDHC_IRQ_VECTOR) {
 void sdc_lld_init(void) {
 #if PLATFORM_SDC_USE_SDC1 == TRUE
   sdcObjectInit(&SDCD1);
+  SDCD1.qhead    = NULL;
+  SDCD1.qtail    = NULL;
+  SDCD1.qphase   = SDC_Q_IDLE;
+  SDCD1.qrecover = false;
+  SDCD1.qhold    = 0;
+  osalThreadQueueObjectInit(&SDCD1.qwait);
 #endif
 }
 
@@ -617,6 +999,7 @@ void sdc_lld_start(SDCDriver *sdcp) {
     }
 
     SDHC->IRQSIGEN = 0;
+    sdcp->qrecover = false;
     nvicEnableVector(SDHC_IRQn, KINETIS_SDHC_PRIORITY);
   }
 }
@@ -631,6 +1014,8 @@ void sdc_lld_start(SDCDriver *sdcp) {
 void sdc_lld_stop(SDCDriver *sdcp) {
 
   if (sdcp->state != BLK_STOP) {
+    osalDbgAssert(sdcp->qhead == NULL, "requests pending");
+
     /* TODO: Should we perform a reset (RSTA) before putting the
        peripheral to sleep? */
 
@@ -768,6 +1153,7 @@ void sdc_lld_set_bus_mode(SDCDriver *sdcp, sdcbusmode_t mode) {
  * @notapi
  */
 void sdc_lld_send_cmd_none(SDCDriver *sdcp, uint8_t cmd, uint32_t arg) {
+  sync_begin(sdcp);
   SDHC->CMDARG = arg;
   uint32_t xfer =
     SDHC_XFERTYP_CMDINX(cmd) |
@@ -776,6 +1162,7 @@ void sdc_lld_send_cmd_none(SDCDriver *sdcp, uint8_t cmd, uint32_t arg) {
     SDHC_XFERTYP_RSPTYP_NONE;
 
   send_and_wait_cmd(sdcp, xfer);
+  sync_end(sdcp);
 }
 
 /**
@@ -795,6 +1182,7 @@ void sdc_lld_send_cmd_none(SDCDriver *sdcp, uint8_t cmd, uint32_t arg) {
  */
 bool sdc_lld_send_cmd_short(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
                             uint32_t *resp) {
+  sync_begin(sdcp);
   SDHC->CMDARG = arg;
   uint32_t xfer =
     SDHC_XFERTYP_CMDINX(cmd) |
@@ -805,6 +1193,7 @@ bool sdc_lld_send_cmd_short(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
   bool waited = send_and_wait_cmd(sdcp, xfer);
 
   *resp = SDHC->CMDRSP[0];
+  sync_end(sdcp);
 
   return waited;
 }
@@ -825,6 +1214,7 @@ bool sdc_lld_send_cmd_short(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
  */
 bool sdc_lld_send_cmd_short_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
                                 uint32_t *resp) {
+  sync_begin(sdcp);
   SDHC->CMDARG = arg;
   uint32_t xfer =
     SDHC_XFERTYP_CMDINX(cmd) |
@@ -837,6 +1227,7 @@ bool sdc_lld_send_cmd_short_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
 
   *resp = SDHC->CMDRSP[0];
   TRACE(11, *resp);
+  sync_end(sdcp);
 
   return waited;
 }
@@ -862,6 +1253,7 @@ bool sdc_lld_send_cmd_long_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
      field is valid, but the command index field is set to all 1s, so
      we need to disable the command index check function (CICEN=0). */
   
+  sync_begin(sdcp);
   SDHC->CMDARG = arg;
   uint32_t xfer =
     SDHC_XFERTYP_CMDINX(cmd) |
@@ -876,6 +1268,7 @@ bool sdc_lld_send_cmd_long_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
   resp[1] = SDHC->CMDRSP[1];
   resp[2] = SDHC->CMDRSP[2];
   resp[3] = SDHC->CMDRSP[3];
+  sync_end(sdcp);
 
   return waited;
 }
@@ -897,12 +1290,35 @@ bool sdc_lld_send_cmd_long_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
 
 bool sdc_lld_read(SDCDriver *sdcp, uint32_t startblk,
 		  uint8_t *buf, uint32_t n) {
-  uint32_t cmdx = (n == 1)?
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) :
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_MULTIPLE_BLOCK);
-  cmdx |= SDHC_XFERTYP_DTDSEL;
+  bool result;
+
+  sync_begin(sdcp);
+#if KINETIS_SDC_UNALIGNED_SUPPORT == TRUE
+  if ((uintptr_t)buf & 0x03) {
+    /* One block at a time through the bounce buffer */
+    result = HAL_SUCCESS;
+    while ((n-- > 0) && (result == HAL_SUCCESS)) {
+      result = sdc_lld_transfer(sdcp, startblk++, (uintptr_t)sdcp->bounce, 1,
+                                SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) |
+                                SDHC_XFERTYP_DTDSEL);
+      if (result != HAL_SUCCESS)
+        break;
+      memcpy(buf, sdcp->bounce, MMCSD_BLOCK_SIZE);
+      buf += MMCSD_BLOCK_SIZE;
+    }
+  } else
+#endif
+  {
+    uint32_t cmdx = (n == 1)?
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) :
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_MULTIPLE_BLOCK);
+    cmdx |= SDHC_XFERTYP_DTDSEL;
+
+    result = sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+  }
+  sync_end(sdcp);
 
-  return sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+  return result;
 }
 
 /**
@@ -921,11 +1337,34 @@ bool sdc_lld_read(SDCDriver *sdcp, uint32_t startblk,
  */
 bool sdc_lld_write(SDCDriver *sdcp, uint32_t startblk,
                    const uint8_t *buf, uint32_t n) {
-  uint32_t cmdx = (n == 1)?
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK) :
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_MULTIPLE_BLOCK);
+  bool result;
+
+  sync_begin(sdcp);
+#if KINETIS_SDC_UNALIGNED_SUPPORT == TRUE
+  if ((uintptr_t)buf & 0x03) {
+    /* One block at a time through the bounce buffer */
+    result = HAL_SUCCESS;
+    while ((n-- > 0) && (result == HAL_SUCCESS)) {
+      memcpy(sdcp->bounce, buf, MMCSD_BLOCK_SIZE);
+      result = sdc_lld_transfer(sdcp, startblk++, (uintptr_t)sdcp->bounce, 1,
+                                SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK));
+      buf += MMCSD_BLOCK_SIZE;
+    }
+  } else
+#endif
+  {
+    uint32_t cmdx = (n == 1)?
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK) :
+      SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_MULTIPLE_BLOCK);
 
-  return sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+    if (pre_erase_applies(sdcp, n)) {
+      pre_erase(sdcp, n);
+    }
+    result = sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+  }
+  sync_end(sdcp);
+
+  return result;
 }
 
 /**
@@ -941,7 +1380,20 @@ bool sdc_lld_write(SDCDriver *sdcp, uint32_t startblk,
  */
 bool sdc_lld_sync(SDCDriver *sdcp) {
 
-  (void)sdcp;
+  /* Flushes the queued requests */
+  osalSysLock();
+  while (sdcp->qhead != NULL) {
+    if (sdcp->qphase == SDC_Q_IDLE) {
+      /* Stopped by a failure, recovering restarts it */
+      osalSysUnlock();
+      sync_begin(sdcp);
+      sync_end(sdcp);
+      osalSysLock();
+    } else {
+      (void) osalThreadEnqueueTimeoutS(&sdcp->qwait, TIME_INFINITE);
+    }
+  }
+  osalSysUnlock();
 
   return HAL_SUCCESS;
 }
@@ -949,11 +1401,14 @@ bool sdc_lld_sync(SDCDriver *sdcp) {
 bool sdc_lld_read_special(SDCDriver *sdcp, uint8_t *buf, size_t bytes,
 			  uint8_t cmd, uint32_t argument) {
   uintptr_t bufaddr = (uintptr_t)buf;
+  bool result;
 
   osalDbgCheck((bufaddr & 0x03) == 0);  /* Must be 32-bit aligned */
   osalDbgCheck(bytes > 0);
   osalDbgCheck(bytes < 4096);
 
+  sync_begin(sdcp);
+
   osalDbgAssert((SDHC->PRSSTAT & (SDHC_PRSSTAT_DLA|SDHC_PRSSTAT_CDIHB|SDHC_PRSSTAT_CIHB)) == 0,
 		"SDHC interface not ready");
 
@@ -974,7 +1429,10 @@ bool sdc_lld_read_special(SDCDriver *sdcp, uint8_t *buf, size_t bytes,
     SDHC_XFERTYP_RSPTYP_48 |
     SDHC_XFERTYP_DPSEL | SDHC_XFERTYP_DMAEN;  /* DMA-assisted data transfer */
 
-  return send_and_wait_transfer(sdcp, xfer);
+  result = send_and_wait_transfer(sdcp, xfer);
+  sync_end(sdcp);
+
+  return result;
 }
 
 bool sdc_lld_is_card_inserted(SDCDriver *sdcp) {
@@ -988,6 +1446,195 @@ bool sdc_lld_is_write_protected(SDCDriver *sdcp) {
   return false;
 }
 
+/**
+ * @brief   Builds an ADMA2 descriptor table.
+ * @details Segments larger than @p SDHC_ADMA2_MAX_LENGTH are split, the
+ *          last descriptor is marked as the end of the table.
+ *
+ * @param[out] table    pointer to the descriptors, @p NULL to only
+ *                      count them
+ * @param[in] max       number of descriptors in @p table
+ * @param[in] sg        pointer to the segments
+ * @param[in] nseg      number of segments
+ * @return              The number of descriptors.
+ * @retval 0            a segment is not aligned, has an invalid size or
+ *                      the table is too small.
+ *
+ * @api
+ */
+size_t sdcKinetisBuildADMA2(sdc_kinetis_adma2_t *table, size_t max,
+                            const sdc_kinetis_segment_t *sg, size_t nseg) {
+  size_t k = 0;
+
+  while (nseg-- > 0) {
+    uintptr_t addr = (uintptr_t)sg->buf;
+    uint32_t size = sg->size;
+
+    sg++;
+    if ((addr & 0x03) || (size & 0x03) || (size == 0)) {
+      return 0;
+    }
+    while (size > 0) {
+      uint32_t len = size > SDHC_ADMA2_MAX_LENGTH ?
+                     SDHC_ADMA2_MAX_LENGTH : size;
+
+      if (k >= max) {
+        return 0;
+      }
+      if (table != NULL) {
+        table[k].attr    = SDHC_ADMA2_VALID | SDHC_ADMA2_ACT_TRAN;
+        table[k].length  = (uint16_t)len;
+        table[k].address = (uint32_t)addr;
+      }
+      k++;
+      addr += len;
+      size -= len;
+    }
+  }
+
+  if ((table != NULL) && (k > 0)) {
+    table[k - 1].attr |= SDHC_ADMA2_END;
+  }
+  return k;
+}
+
+/**
+ * @brief   Queues a request.
+ * @details The request starts as soon as the previous ones complete. If
+ *          a failure is pending recovery the queue is restarted by the
+ *          next thread-level driver call.
+ * @note    The request and its segments must stay valid until completion.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] rqp       pointer to the request
+ *
+ * @iclass
+ */
+void sdcKinetisSubmitI(SDCDriver *sdcp, sdc_kinetis_request_t *rqp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sdcp != NULL) && (rqp != NULL));
+  osalDbgCheck((rqp->n > 0) && (rqp->sg != NULL) && (rqp->nseg > 0));
+  osalDbgAssert(sdcp->state >= BLK_READY, "not connected");
+  osalDbgAssert(sdcKinetisBuildADMA2(NULL, KINETIS_SDC_ADMA2_ENTRIES,
+                                     rqp->sg, rqp->nseg) > 0,
+                "invalid segments");
+  osalDbgAssert(sg_size(rqp->sg, rqp->nseg) == rqp->n * MMCSD_BLOCK_SIZE,
+                "size mismatch");
+
+  rqp->next   = NULL;
+  rqp->status = MSG_TIMEOUT;
+  rqp->errors = 0;
+  rqp->thread = NULL;
+  if (sdcp->qtail == NULL) {
+    sdcp->qhead = rqp;
+  } else {
+    sdcp->qtail->next = rqp;
+  }
+  sdcp->qtail = rqp;
+
+  queue_kick_s(sdcp);
+}
+
+/**
+ * @brief   Queues a request.
+ * @details Performs the recovery pending from a failed request, if any.
+ * @note    The request and its segments must stay valid until completion.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] rqp       pointer to the request
+ *
+ * @api
+ */
+void sdcKinetisSubmit(SDCDriver *sdcp, sdc_kinetis_request_t *rqp) {
+  bool stalled;
+
+  osalSysLock();
+  sdcKinetisSubmitI(sdcp, rqp);
+  stalled = sdcp->qrecover && (sdcp->qhold == 0);
+  osalSysUnlock();
+
+  if (stalled) {
+    sync_begin(sdcp);
+    sync_end(sdcp);
+  }
+}
+
+/**
+ * @brief   Waits for the completion of a request.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] rqp       pointer to the request
+ * @return              The completion status.
+ * @retval MSG_OK       the request succeeded.
+ * @retval MSG_RESET    the request failed, see @p errors.
+ *
+ * @api
+ */
+msg_t sdcKinetisWait(SDCDriver *sdcp, sdc_kinetis_request_t *rqp) {
+  msg_t msg;
+
+  osalDbgCheck((sdcp != NULL) && (rqp != NULL));
+
+  osalSysLock();
+  while ((msg = rqp->status) == MSG_TIMEOUT) {
+    if ((sdcp->qphase == SDC_Q_IDLE) && (sdcp->qhold == 0)) {
+      /* Stopped by a failure, recovering restarts it */
+      osalSysUnlock();
+      sync_begin(sdcp);
+      sync_end(sdcp);
+      osalSysLock();
+    } else {
+      osalDbgAssert(rqp->thread == NULL, "already waited");
+      msg = osalThreadSuspendS(&rqp->thread);
+      break;
+    }
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Reads blocks into a scatter-gather list.
+ * @details The transfer is queued after any pending request.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[in] sg        pointer to the segments, a whole number of blocks
+ * @param[in] nseg      number of segments
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool sdcKinetisReadSG(SDCDriver *sdcp, uint32_t startblk,
+                      const sdc_kinetis_segment_t *sg, size_t nseg) {
+
+  return queue_transfer(sdcp, startblk, sg, nseg, false);
+}
+
+/**
+ * @brief   Writes blocks from a scatter-gather list.
+ * @details The transfer is queued after any pending request.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] sg        pointer to the segments, a whole number of blocks
+ * @param[in] nseg      number of segments
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool sdcKinetisWriteSG(SDCDriver *sdcp, uint32_t startblk,
+                       const sdc_kinetis_segment_t *sg, size_t nseg) {
+
+  return queue_transfer(sdcp, startblk, sg, nseg, true);
+}
+
 #endif /* HAL_USE_SDC == TRUE */
 
 /** @} */
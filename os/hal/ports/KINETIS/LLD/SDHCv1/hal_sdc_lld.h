@@ -46,6 +46,22 @@
 #define SDHC_PROCTL_DTW_4BIT            SDHC_PROCTL_DTW(1)
 #define SDHC_PROCTL_DTW_8BIT            SDHC_PROCTL_DTW(2)
 
+/**
+ * @name    ADMA2 descriptor attributes
+ * @{
+ */
+#define SDHC_ADMA2_VALID                0x0001U
+#define SDHC_ADMA2_END                  0x0002U
+#define SDHC_ADMA2_INT                  0x0004U
+#define SDHC_ADMA2_ACT_TRAN             0x0020U
+#define SDHC_ADMA2_ACT_LINK             0x0030U
+/** @} */
+
+/**
+ * @brief   Largest ADMA2 descriptor length, word multiple.
+ */
+#define SDHC_ADMA2_MAX_LENGTH           65532U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -62,12 +78,44 @@
 #if !defined(PLATFORM_SDC_USE_SDC1) || defined(__DOXYGEN__)
 #define PLATFORM_SDC_USE_SDC1                  TRUE
 #endif
+
+/**
+ * @brief   Number of ADMA2 descriptors of a queued request.
+ * @details Limits the number of scatter-gather segments, segments larger
+ *          than @p SDHC_ADMA2_MAX_LENGTH take more than one descriptor.
+ */
+#if !defined(KINETIS_SDC_ADMA2_ENTRIES) || defined(__DOXYGEN__)
+#define KINETIS_SDC_ADMA2_ENTRIES              16
+#endif
+
+/**
+ * @brief   Support for unaligned buffers.
+ * @details Buffers not aligned to 32 bits are transferred one block at a
+ *          time through a bounce buffer in the driver structure.
+ */
+#if !defined(KINETIS_SDC_UNALIGNED_SUPPORT) || defined(__DOXYGEN__)
+#define KINETIS_SDC_UNALIGNED_SUPPORT          TRUE
+#endif
+
+/**
+ * @brief   Pre-erase hint for multiple block writes.
+ * @details Multiple block writes to SD cards are preceded by ACMD23
+ *          (SET_WR_BLK_ERASE_COUNT), letting the card erase the blocks
+ *          in advance. Failures of the hint are ignored.
+ */
+#if !defined(KINETIS_SDC_USE_PRE_ERASE) || defined(__DOXYGEN__)
+#define KINETIS_SDC_USE_PRE_ERASE              TRUE
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if KINETIS_SDC_ADMA2_ENTRIES < 1
+#error "KINETIS_SDC_ADMA2_ENTRIES must be at least 1"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -87,6 +135,92 @@ typedef uint32_t sdcflags_t;
  */
 typedef struct SDCDriver SDCDriver;
 
+/**
+ * @brief   ADMA2 descriptor.
+ */
+typedef struct {
+  uint16_t      attr;
+  uint16_t      length;
+  uint32_t      address;
+} sdc_kinetis_adma2_t;
+
+/**
+ * @brief   Scatter-gather segment.
+ * @note    Segments must be 32 bits aligned, with a size multiple of 4.
+ */
+typedef struct {
+  void          *buf;
+  uint32_t      size;
+} sdc_kinetis_segment_t;
+
+/**
+ * @brief   Type of a queued request.
+ */
+typedef struct sdc_kinetis_request sdc_kinetis_request_t;
+
+/**
+ * @brief   Request completion callback type.
+ * @note    Invoked from the ISR, it can submit further requests with
+ *          @p sdcKinetisSubmitI().
+ */
+typedef void (*sdc_kinetis_callback_t)(SDCDriver *sdcp,
+                                       sdc_kinetis_request_t *rqp);
+
+/**
+ * @brief   Queued request.
+ * @details Requests are executed in submission order, each one starting
+ *          from the ISR as soon as the previous one completes.
+ */
+struct sdc_kinetis_request {
+  /**
+   * @brief   Next queued request, driver use.
+   */
+  sdc_kinetis_request_t     *next;
+  /**
+   * @brief   First block.
+   */
+  uint32_t                  startblk;
+  /**
+   * @brief   Number of blocks.
+   */
+  uint32_t                  n;
+  /**
+   * @brief   Segments, <tt>n * MMCSD_BLOCK_SIZE</tt> bytes in total.
+   */
+  const sdc_kinetis_segment_t *sg;
+  /**
+   * @brief   Number of segments.
+   */
+  size_t                    nseg;
+  /**
+   * @brief   Bool flag. If @p true a write request.
+   */
+  bool                      write;
+  /**
+   * @brief   Completion callback, can be @p NULL.
+   */
+  sdc_kinetis_callback_t    callback;
+  /**
+   * @brief   Application data.
+   */
+  void                      *arg;
+  /**
+   * @brief   Completion status.
+   * @details @p MSG_TIMEOUT while queued or running, @p MSG_OK on
+   *          success, @p MSG_RESET on failure. Requests queued after a
+   *          failed one are failed too, with no error flags.
+   */
+  volatile msg_t            status;
+  /**
+   * @brief   Error flags of a failed request.
+   */
+  sdcflags_t                errors;
+  /**
+   * @brief   Waiting thread, driver use.
+   */
+  thread_reference_t        thread;
+};
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -151,6 +285,41 @@ struct SDCDriver {
 
   /* Platform specific fields */
   thread_reference_t        thread;
+  /**
+   * @brief Queued requests, the first one is running.
+   */
+  sdc_kinetis_request_t     *qhead;
+  /**
+   * @brief Last queued request.
+   */
+  sdc_kinetis_request_t     *qtail;
+  /**
+   * @brief Phase of the running request.
+   */
+  volatile uint8_t          qphase;
+  /**
+   * @brief Bool flag. If @p true a request failed and the card needs a
+   *        recovery before the queue is restarted.
+   */
+  volatile bool             qrecover;
+  /**
+   * @brief Nesting of the synchronous operations holding the queue.
+   */
+  uint8_t                   qhold;
+  /**
+   * @brief Threads waiting for the queue to drain.
+   */
+  threads_queue_t           qwait;
+  /**
+   * @brief ADMA2 descriptors of the running request.
+   */
+  sdc_kinetis_adma2_t       adma[KINETIS_SDC_ADMA2_ENTRIES];
+#if (KINETIS_SDC_UNALIGNED_SUPPORT == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief Bounce buffer for unaligned transfers.
+   */
+  uint32_t                  bounce[MMCSD_BLOCK_SIZE / 4];
+#endif
 };
 
 /*===========================================================================*/
@@ -191,6 +360,15 @@ extern "C" {
   bool sdc_lld_sync(SDCDriver *sdcp);
   bool sdc_lld_is_card_inserted(SDCDriver *sdcp);
   bool sdc_lld_is_write_protected(SDCDriver *sdcp);
+  size_t sdcKinetisBuildADMA2(sdc_kinetis_adma2_t *table, size_t max,
+                              const sdc_kinetis_segment_t *sg, size_t nseg);
+  void sdcKinetisSubmitI(SDCDriver *sdcp, sdc_kinetis_request_t *rqp);
+  void sdcKinetisSubmit(SDCDriver *sdcp, sdc_kinetis_request_t *rqp);
+  msg_t sdcKinetisWait(SDCDriver *sdcp, sdc_kinetis_request_t *rqp);
+  bool sdcKinetisReadSG(SDCDriver *sdcp, uint32_t startblk,
+                        const sdc_kinetis_segment_t *sg, size_t nseg);
+  bool sdcKinetisWriteSG(SDCDriver *sdcp, uint32_t startblk,
+                         const sdc_kinetis_segment_t *sg, size_t nseg);
 #ifdef __cplusplus
 }
 #endif
@@ -32,6 +32,38 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if KINETIS_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   eDMA channel interrupt vector from a literal channel number.
+ */
+#define KINETIS_SERIAL_DMA_VECTOR(ch)       KINETIS_SERIAL_DMA_VECTOR_(ch)
+#define KINETIS_SERIAL_DMA_VECTOR_(ch)      KINETIS_DMA##ch##_IRQ_VECTOR
+#endif
+
+#if !defined(KINETIS_SERIAL_UART0_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART0_RX_DMAMUX_SOURCE      2
+#endif
+
+#if !defined(KINETIS_SERIAL_UART1_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART1_RX_DMAMUX_SOURCE      4
+#endif
+
+#if !defined(KINETIS_SERIAL_UART2_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART2_RX_DMAMUX_SOURCE      6
+#endif
+
+#if !defined(KINETIS_SERIAL_UART3_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART3_RX_DMAMUX_SOURCE      8
+#endif
+
+#if !defined(KINETIS_SERIAL_UART4_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART4_RX_DMAMUX_SOURCE     10
+#endif
+
+#if !defined(KINETIS_SERIAL_UART5_RX_DMAMUX_SOURCE)
+#define KINETIS_SERIAL_UART5_RX_DMAMUX_SOURCE     11
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -74,6 +106,30 @@ static const SerialConfig default_config = {
   38400
 };
 
+#if KINETIS_SERIAL_USE_UART0_RX_DMA
+static uint8_t uart0_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if KINETIS_SERIAL_USE_UART1_RX_DMA
+static uint8_t uart1_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if KINETIS_SERIAL_USE_UART2_RX_DMA
+static uint8_t uart2_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if KINETIS_SERIAL_USE_UART3_RX_DMA
+static uint8_t uart3_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if KINETIS_SERIAL_USE_UART4_RX_DMA
+static uint8_t uart4_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if KINETIS_SERIAL_USE_UART5_RX_DMA
+static uint8_t uart5_rx_dma_buf[KINETIS_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -99,6 +155,32 @@ static void set_error(SerialDriver *sdp, uint8_t s1) {
   osalSysUnlockFromISR();
 }
 
+/**
+ * @brief   Completes the clearing of the S1 flags by reading D.
+ * @note    When receiving through DMA a read of D could consume a byte
+ *          before the DMA does, so the DMA request is masked around the
+ *          read and a pending byte is left to the DMA. Its read of D
+ *          clears the flags as well, S1 having already been read.
+ *
+ * @param[in] sdp       communication channel associated to the UART
+ */
+static void clear_s1(SerialDriver *sdp) {
+  UART_w_TypeDef *u = &(sdp->uart);
+
+#if KINETIS_SERIAL_HAS_RX_DMA
+  if (sdp->rxring.buffer != NULL) {
+    UART_TypeDef *uart = u->uart_p;
+
+    uart->C5 &= ~UARTx_C5_RDMAE;
+    if ((*(u->s1_p) & UARTx_S1_RDRF) == 0)
+      (void)*(u->d_p);
+    uart->C5 |= UARTx_C5_RDMAE;
+    return;
+  }
+#endif
+  (void)*(u->d_p);
+}
+
 /**
  * @brief   Common error IRQ handler.
  *
@@ -111,13 +193,13 @@ static void serve_error_interrupt(SerialDriver *sdp) {
   /* Clearing on K20x, K60x, and KL2x/UART>0 is done by reading S1 and
    * then reading D.*/
 
-  if(s1 & UARTx_S1_IDLE) {
-    (void)*(u->d_p);
-  }
-
   if(s1 & (UARTx_S1_OR | UARTx_S1_NF | UARTx_S1_FE | UARTx_S1_PF)) {
     set_error(sdp, s1);
-    (void)*(u->d_p);
+  }
+
+  if(s1 & (UARTx_S1_IDLE |
+           UARTx_S1_OR | UARTx_S1_NF | UARTx_S1_FE | UARTx_S1_PF)) {
+    clear_s1(sdp);
   }
 }
 
@@ -140,6 +222,99 @@ static void serve_error_interrupt_uart0(void) {
 }
 #endif /* KL2x && KINETIS_SERIAL_USE_UART0 */
 
+#if KINETIS_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Moves the bytes received by the DMA to the input queue.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void rx_dma_flush(SerialDriver *sdp) {
+  eventflags_t flags;
+
+  flags = sdDmaRxRingFlushI(&sdp->rxring, &sdp->iqueue,
+                            sdp->rxring.size -
+                            DMA->TCD[sdp->rxdma].CITER_ELINKNO);
+  if (flags != 0)
+    chnAddFlagsI(sdp, flags);
+}
+
+/**
+ * @brief   Starts receiving through an eDMA channel.
+ * @details The channel loops over the ring buffer, raising an interrupt on
+ *          half and full major loops.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] ch        eDMA channel
+ * @param[in] source    DMAMUX source of the UART receiver
+ * @param[in] buf       ring buffer
+ * @param[in] prio      channel interrupt priority
+ */
+static void rx_dma_start(SerialDriver *sdp, uint8_t ch, uint8_t source,
+                         uint8_t *buf, uint32_t prio) {
+  UART_TypeDef *uart = sdp->uart.uart_p;
+
+  SIM->SCGC6 |= SIM_SCGC6_DMAMUX;
+  SIM->SCGC7 |= SIM_SCGC7_DMA;
+
+  sdDmaRxRingInit(&sdp->rxring, buf, KINETIS_SERIAL_RX_DMA_BUFFER_SIZE);
+  sdp->rxdma = ch;
+
+  DMA->TCD[ch].SADDR = (uint32_t)&uart->D;
+  DMA->TCD[ch].SOFF = 0;
+  DMA->TCD[ch].SLAST = 0;
+  DMA->TCD[ch].DADDR = (uint32_t)buf;
+  DMA->TCD[ch].DOFF = 1;
+  DMA->TCD[ch].DLASTSGA = -(int32_t)KINETIS_SERIAL_RX_DMA_BUFFER_SIZE;
+  DMA->TCD[ch].ATTR = DMA_ATTR_SSIZE(0) | DMA_ATTR_DSIZE(0);
+  DMA->TCD[ch].NBYTES_MLNO = 1;
+  DMA->TCD[ch].BITER_ELINKNO = KINETIS_SERIAL_RX_DMA_BUFFER_SIZE;
+  DMA->TCD[ch].CITER_ELINKNO = KINETIS_SERIAL_RX_DMA_BUFFER_SIZE;
+  DMA->TCD[ch].CSR = DMA_CSR_INTHALF_MASK | DMA_CSR_INTMAJOR_MASK;
+
+  DMAMUX->CHCFG[ch] = DMAMUX_CHCFGn_ENBL | DMAMUX_CHCFGn_SOURCE(source);
+  nvicEnableVector(DMA0_IRQn + ch, prio);
+  DMA->SERQ = ch;
+
+  /* RDRF now raises DMA requests, the idle line interrupt flushes the
+     bytes left below the half ring.*/
+  uart->C5 |= UARTx_C5_RDMAE;
+  uart->C2 |= UARTx_C2_ILIE;
+}
+
+/**
+ * @brief   Stops receiving through DMA, if active.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void rx_dma_stop(SerialDriver *sdp) {
+  UART_TypeDef *uart = sdp->uart.uart_p;
+
+  if (sdp->rxring.buffer == NULL)
+    return;
+
+  uart->C2 &= ~UARTx_C2_ILIE;
+  uart->C5 &= ~UARTx_C5_RDMAE;
+  DMA->CERQ = sdp->rxdma;
+  DMAMUX->CHCFG[sdp->rxdma] = 0;
+  nvicDisableVector(DMA0_IRQn + sdp->rxdma);
+  DMA->CINT = sdp->rxdma;
+  sdp->rxring.buffer = NULL;
+}
+
+/**
+ * @brief   Common receive DMA IRQ handler.
+ *
+ * @param[in] sdp       communication channel associated to the UART
+ */
+static void serve_rx_dma_interrupt(SerialDriver *sdp) {
+
+  DMA->CINT = sdp->rxdma;
+  osalSysLockFromISR();
+  rx_dma_flush(sdp);
+  osalSysUnlockFromISR();
+}
+#endif /* KINETIS_SERIAL_HAS_RX_DMA */
+
 /**
  * @brief   Common IRQ handler.
  * @note    Tries hard to clear all the pending interrupt sources, we don't
@@ -152,6 +327,19 @@ static void serve_interrupt(SerialDriver *sdp) {
   UART_w_TypeDef *u = &(sdp->uart);
   uint8_t s1 = *(u->s1_p);
 
+#if KINETIS_SERIAL_HAS_RX_DMA
+  if (sdp->rxring.buffer != NULL) {
+    /* The received bytes belong to the DMA, RDRF is left to it. IDLE is
+       cleared by serve_error_interrupt() at the end of this handler.*/
+    if (s1 & UARTx_S1_IDLE) {
+      osalSysLockFromISR();
+      rx_dma_flush(sdp);
+      osalSysUnlockFromISR();
+    }
+    s1 &= ~UARTx_S1_RDRF;
+  }
+#endif
+
   if (s1 & UARTx_S1_RDRF) {
     osalSysLockFromISR();
     if (iqIsEmptyI(&sdp->iqueue))
@@ -228,6 +416,9 @@ static void sd_lld_init_driver(SerialDriver *SDn, UART_TypeDef *UARTn) {
   SDn->uart.s2_p =  &(UARTn->S2);
   SDn->uart.d_p =   &(UARTn->D);
   SDn->uart.uart_p = UARTn;
+#if KINETIS_SERIAL_HAS_RX_DMA
+  SDn->rxring.buffer = NULL;
+#endif
 }
 
 /**
@@ -402,6 +593,54 @@ OSAL_IRQ_HANDLER(KINETIS_SERIAL5_ERROR_IRQ_VECTOR) {
 
 #endif /* KINETIS_HAS_SERIAL_ERROR_IRQ */
 
+#if KINETIS_SERIAL_USE_UART0_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART0_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD1);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if KINETIS_SERIAL_USE_UART1_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART1_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD2);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if KINETIS_SERIAL_USE_UART2_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART2_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD3);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if KINETIS_SERIAL_USE_UART3_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART3_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD4);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if KINETIS_SERIAL_USE_UART4_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART4_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD5);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if KINETIS_SERIAL_USE_UART5_RX_DMA || defined(__DOXYGEN__)
+OSAL_IRQ_HANDLER(KINETIS_SERIAL_DMA_VECTOR(KINETIS_SERIAL_UART5_RX_DMA_CHANNEL)) {
+  OSAL_IRQ_PROLOGUE();
+  serve_rx_dma_interrupt(&SD6);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -513,6 +752,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
               SIM_SOPT2_UART0SRC(KINETIS_UART0_CLOCK_SRC);
 #endif /* KINETIS_SERIAL0_IS_UARTLP */
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART0_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART0_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART0_RX_DMAMUX_SOURCE,
+                   uart0_rx_dma_buf, KINETIS_SERIAL_UART0_PRIORITY);
+#endif
 #if KINETIS_HAS_SERIAL_ERROR_IRQ
       nvicEnableVector(UART0Status_IRQn, KINETIS_SERIAL_UART0_PRIORITY);
       nvicEnableVector(UART0Error_IRQn, KINETIS_SERIAL_UART0_PRIORITY);
@@ -537,6 +781,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
       SIM->SCGC4 |= SIM_SCGC4_UART1;
 #endif /* KINETIS_SERIAL1_IS_LPUART */
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART1_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART1_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART1_RX_DMAMUX_SOURCE,
+                   uart1_rx_dma_buf, KINETIS_SERIAL_UART1_PRIORITY);
+#endif
 #if KINETIS_HAS_SERIAL_ERROR_IRQ
       nvicEnableVector(UART1Status_IRQn, KINETIS_SERIAL_UART1_PRIORITY);
       nvicEnableVector(UART1Error_IRQn, KINETIS_SERIAL_UART0_PRIORITY);
@@ -554,6 +803,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
     if (sdp == &SD3) {
       SIM->SCGC4 |= SIM_SCGC4_UART2;
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART2_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART2_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART2_RX_DMAMUX_SOURCE,
+                   uart2_rx_dma_buf, KINETIS_SERIAL_UART2_PRIORITY);
+#endif
 #if KINETIS_HAS_SERIAL_ERROR_IRQ
       nvicEnableVector(UART2Status_IRQn, KINETIS_SERIAL_UART2_PRIORITY);
       nvicEnableVector(UART2Error_IRQn, KINETIS_SERIAL_UART0_PRIORITY);
@@ -567,6 +821,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
     if (sdp == &SD4) {
       SIM->SCGC4 |= SIM_SCGC4_UART3;
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART3_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART3_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART3_RX_DMAMUX_SOURCE,
+                   uart3_rx_dma_buf, KINETIS_SERIAL_UART3_PRIORITY);
+#endif
       nvicEnableVector(UART3Status_IRQn, KINETIS_SERIAL_UART3_PRIORITY);
       nvicEnableVector(UART3Error_IRQn, KINETIS_SERIAL_UART3_PRIORITY);
     }
@@ -576,6 +835,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
     if (sdp == &SD5) {
       SIM->SCGC1 |= SIM_SCGC1_UART4;
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART4_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART4_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART4_RX_DMAMUX_SOURCE,
+                   uart4_rx_dma_buf, KINETIS_SERIAL_UART4_PRIORITY);
+#endif
       nvicEnableVector(UART4Status_IRQn, KINETIS_SERIAL_UART4_PRIORITY);
       nvicEnableVector(UART4Error_IRQn, KINETIS_SERIAL_UART4_PRIORITY);
     }
@@ -585,6 +849,11 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
     if (sdp == &SD6) {
       SIM->SCGC1 |= SIM_SCGC1_UART5;
       configure_uart(sdp, config);
+#if KINETIS_SERIAL_USE_UART5_RX_DMA
+      rx_dma_start(sdp, KINETIS_SERIAL_UART5_RX_DMA_CHANNEL,
+                   KINETIS_SERIAL_UART5_RX_DMAMUX_SOURCE,
+                   uart5_rx_dma_buf, KINETIS_SERIAL_UART5_PRIORITY);
+#endif
       nvicEnableVector(UART5Status_IRQn, KINETIS_SERIAL_UART5_PRIORITY);
       nvicEnableVector(UART5Error_IRQn, KINETIS_SERIAL_UART5_PRIORITY);
     }
@@ -608,6 +877,9 @@ void sd_lld_stop(SerialDriver *sdp) {
 
   if (sdp->state == SD_READY) {
     /* TODO: Resets the peripheral.*/
+#if KINETIS_SERIAL_HAS_RX_DMA
+    rx_dma_stop(sdp);
+#endif
 
 #if KINETIS_SERIAL_USE_UART0
     if (sdp == &SD1) {
@@ -124,6 +124,91 @@
 #define KINETIS_SERIAL_UART5_PRIORITY        12
 #endif
 
+/**
+ * @brief   UART0 DMA receive enable switch.
+ * @details If set to @p TRUE SD1 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART0_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART0_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART0_RX_DMA      FALSE
+#endif
+
+/**
+ * @brief   UART1 DMA receive enable switch.
+ * @details If set to @p TRUE SD2 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART1_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART1_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART1_RX_DMA      FALSE
+#endif
+
+/**
+ * @brief   UART2 DMA receive enable switch.
+ * @details If set to @p TRUE SD3 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART2_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART2_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART2_RX_DMA      FALSE
+#endif
+
+/**
+ * @brief   UART3 DMA receive enable switch.
+ * @details If set to @p TRUE SD4 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART3_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART3_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART3_RX_DMA      FALSE
+#endif
+
+/**
+ * @brief   UART4 DMA receive enable switch.
+ * @details If set to @p TRUE SD5 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART4_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART4_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART4_RX_DMA      FALSE
+#endif
+
+/**
+ * @brief   UART5 DMA receive enable switch.
+ * @details If set to @p TRUE SD6 receives through an eDMA channel running
+ *          in circular mode, the channel is flushed to the input queue on
+ *          half and full transfers and when the line goes idle.
+ * @note    Requires @p KINETIS_SERIAL_UART5_RX_DMA_CHANNEL.
+ */
+#if !defined(KINETIS_SERIAL_USE_UART5_RX_DMA) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_USE_UART5_RX_DMA      FALSE
+#endif
+
+#if defined(__DOXYGEN__)
+/**
+ * @brief   UART0 receive eDMA channel.
+ * @note    No default, it must be a literal channel number, the channel
+ *          interrupt vector is derived from it. The same applies to the
+ *          other UARTs.
+ */
+#define KINETIS_SERIAL_UART0_RX_DMA_CHANNEL  0
+#endif
+
+/**
+ * @brief   Receive DMA ring size, per UART.
+ * @note    The ring is flushed every half size bytes, it must hold the
+ *          bytes received during the worst case interrupt latency.
+ */
+#if !defined(KINETIS_SERIAL_RX_DMA_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define KINETIS_SERIAL_RX_DMA_BUFFER_SIZE    64
+#endif
+
 /**
  * @brief   UART0 clock source.
  */
@@ -175,6 +260,82 @@
 #error "Serial driver activated but no UART peripheral assigned"
 #endif
 
+/**
+ * @brief   At least one UART receives through DMA.
+ */
+#define KINETIS_SERIAL_HAS_RX_DMA                                           \
+  (KINETIS_SERIAL_USE_UART0_RX_DMA || KINETIS_SERIAL_USE_UART1_RX_DMA ||    \
+   KINETIS_SERIAL_USE_UART2_RX_DMA || KINETIS_SERIAL_USE_UART3_RX_DMA ||    \
+   KINETIS_SERIAL_USE_UART4_RX_DMA || KINETIS_SERIAL_USE_UART5_RX_DMA)
+
+#if KINETIS_SERIAL_HAS_RX_DMA && defined(KL2x)
+#error "serial DMA receive requires an eDMA controller"
+#endif
+
+#if KINETIS_SERIAL_USE_UART0_RX_DMA
+#if !KINETIS_SERIAL_USE_UART0
+#error "KINETIS_SERIAL_USE_UART0_RX_DMA requires KINETIS_SERIAL_USE_UART0"
+#endif
+#if !defined(KINETIS_SERIAL_UART0_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART0_RX_DMA_CHANNEL not defined"
+#endif
+#if KINETIS_SERIAL0_IS_LPUART || KINETIS_SERIAL0_IS_UARTLP
+#error "DMA receive not supported on LPUART/UARTLP"
+#endif
+#endif
+
+#if KINETIS_SERIAL_USE_UART1_RX_DMA
+#if !KINETIS_SERIAL_USE_UART1
+#error "KINETIS_SERIAL_USE_UART1_RX_DMA requires KINETIS_SERIAL_USE_UART1"
+#endif
+#if !defined(KINETIS_SERIAL_UART1_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART1_RX_DMA_CHANNEL not defined"
+#endif
+#if KINETIS_SERIAL1_IS_LPUART || KINETIS_SERIAL1_IS_UARTLP
+#error "DMA receive not supported on LPUART/UARTLP"
+#endif
+#endif
+
+#if KINETIS_SERIAL_USE_UART2_RX_DMA
+#if !KINETIS_SERIAL_USE_UART2
+#error "KINETIS_SERIAL_USE_UART2_RX_DMA requires KINETIS_SERIAL_USE_UART2"
+#endif
+#if !defined(KINETIS_SERIAL_UART2_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART2_RX_DMA_CHANNEL not defined"
+#endif
+#endif
+
+#if KINETIS_SERIAL_USE_UART3_RX_DMA
+#if !KINETIS_SERIAL_USE_UART3
+#error "KINETIS_SERIAL_USE_UART3_RX_DMA requires KINETIS_SERIAL_USE_UART3"
+#endif
+#if !defined(KINETIS_SERIAL_UART3_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART3_RX_DMA_CHANNEL not defined"
+#endif
+#endif
+
+#if KINETIS_SERIAL_USE_UART4_RX_DMA
+#if !KINETIS_SERIAL_USE_UART4
+#error "KINETIS_SERIAL_USE_UART4_RX_DMA requires KINETIS_SERIAL_USE_UART4"
+#endif
+#if !defined(KINETIS_SERIAL_UART4_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART4_RX_DMA_CHANNEL not defined"
+#endif
+#endif
+
+#if KINETIS_SERIAL_USE_UART5_RX_DMA
+#if !KINETIS_SERIAL_USE_UART5
+#error "KINETIS_SERIAL_USE_UART5_RX_DMA requires KINETIS_SERIAL_USE_UART5"
+#endif
+#if !defined(KINETIS_SERIAL_UART5_RX_DMA_CHANNEL)
+#error "KINETIS_SERIAL_UART5_RX_DMA_CHANNEL not defined"
+#endif
+#endif
+
+#if KINETIS_SERIAL_HAS_RX_DMA
+#include "hal_serial_dmarx.h"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -219,6 +380,19 @@ typedef struct {
 #endif /* KINETIS_SERIAL_USE_UART0 && KINETIS_SERIAL0_IS_LPUART */
 } UART_w_TypeDef;
 
+#if KINETIS_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief @p SerialDriver DMA receive data.
+ */
+#define _serial_driver_dmarx_data                                           \
+  /* RX DMA ring, NULL buffer if not in use.*/                              \
+  sd_dmarx_ring_t           rxring;                                         \
+  /* RX DMA channel.*/                                                      \
+  uint8_t                   rxdma;
+#else
+#define _serial_driver_dmarx_data
+#endif
+
 /**
  * @brief @p SerialDriver specific data.
  */
@@ -236,7 +410,8 @@ typedef struct {
   uint8_t                   ob[SERIAL_BUFFERS_SIZE];                        \
   /* End of the mandatory fields.*/                                         \
   /* Pointer to the UART registers block.*/                                 \
-  UART_w_TypeDef            uart;
+  UART_w_TypeDef            uart;                                           \
+  _serial_driver_dmarx_data
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
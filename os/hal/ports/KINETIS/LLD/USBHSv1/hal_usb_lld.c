@@ -127,6 +127,18 @@ typedef struct {
  */
 #define BDT_BC(n) (((n)>>16)&0x3FF)
 
+/*
+ * Endpoints transmitting from both BDT halves
+ */
+#if KINETIS_USB_USE_PINGPONG
+#define EP_IS_PINGPONG(ep, epc)                                               \
+  (((ep) != 0) &&                                                             \
+   ((((epc)->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_BULK) ||         \
+    (((epc)->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_INTR)))
+#else
+#define EP_IS_PINGPONG(ep, epc) FALSE
+#endif
+
 /* The USB-FS needs 2 BDT entry per endpoint direction
  *    that adds to: 2*2*16 BDT entries for 16 bi-directional EP
  */
@@ -174,6 +186,34 @@ void usb_packet_transmit(USBDriver *usbp, usbep_t ep, size_t n)
   isp->odd_even ^= ODD;
 }
 
+#if KINETIS_USB_USE_PINGPONG
+/* Called from locked ISR or locked zone.
+ * Hands the next packets of the transfer to the free BDT halves, the
+ * BDs point straight into the transmit buffer. */
+static void usb_packet_transmit_pp(USBDriver *usbp, usbep_t ep)
+{
+  const USBEndpointConfig *epc = usbp->epc[ep];
+  USBInEndpointState *isp = epc->in_state;
+
+  while((isp->txbusy < 2) && (isp->txpkts > 0)) {
+    bd_t *bd = (bd_t *)&_bdt[BDT_INDEX(ep, TX, isp->odd_even)];
+    size_t n = isp->txsize - isp->txarmed;
+
+    if (n > (size_t)epc->in_maxsize)
+      n = (size_t)epc->in_maxsize;
+
+    /* The address must be in place before the SIE owns the BD */
+    bd->addr = (uint8_t *)isp->txbuf + isp->txarmed;
+    bd->desc = BDT_DESC(n, isp->data_bank);
+    isp->data_bank ^= DATA1;
+    isp->odd_even ^= ODD;
+    isp->txarmed += n;
+    isp->txpkts--;
+    isp->txbusy++;
+  }
+}
+#endif /* KINETIS_USB_USE_PINGPONG */
+
 /* Called from locked ISR. */
 void usb_packet_receive(USBDriver *usbp, usbep_t ep, size_t n)
 {
@@ -269,6 +309,26 @@ OSAL_IRQ_HANDLER(KINETIS_USB_IRQ_VECTOR) {
         }
         uint16_t txed = BDT_BC(bd->desc);
         epc->in_state->txcnt += txed;
+#if KINETIS_USB_USE_PINGPONG
+        if(EP_IS_PINGPONG(ep, epc))
+        {
+          /* Refill the half just sent, the transfer ends when both
+           * halves are back */
+          epc->in_state->txbusy--;
+          if(epc->in_state->txpkts > 0)
+          {
+            osalSysLockFromISR();
+            usb_packet_transmit_pp(usbp,ep);
+            osalSysUnlockFromISR();
+          }
+          else if(epc->in_state->txbusy == 0)
+          {
+            if(epc->in_cb != NULL)
+              _usb_isr_invoke_in_cb(usbp,ep);
+          }
+          break;
+        }
+#endif /* KINETIS_USB_USE_PINGPONG */
         if(epc->in_state->txcnt < epc->in_state->txsize)
         {
           epc->in_state->txbuf += txed;
@@ -630,10 +690,23 @@ void usb_lld_init_endpoint(USBDriver *usbp, usbep_t ep) {
     epc->in_state->data_bank = DATA0;
     /* TXe, not used yet */
     _bdt[BDT_INDEX(ep, TX, EVEN)].desc = 0;
-    _bdt[BDT_INDEX(ep, TX, EVEN)].addr = usb_alloc(epc->in_maxsize);
     /* TXo, not used yet */
     _bdt[BDT_INDEX(ep, TX,  ODD)].desc = 0;
-    _bdt[BDT_INDEX(ep, TX,  ODD)].addr = usb_alloc(epc->in_maxsize);
+#if KINETIS_USB_USE_PINGPONG
+    epc->in_state->txbusy = 0;
+    epc->in_state->txpkts = 0;
+    if(EP_IS_PINGPONG(ep, epc))
+    {
+      /* Transmitted straight from the user buffers */
+      _bdt[BDT_INDEX(ep, TX, EVEN)].addr = NULL;
+      _bdt[BDT_INDEX(ep, TX,  ODD)].addr = NULL;
+    }
+    else
+#endif /* KINETIS_USB_USE_PINGPONG */
+    {
+      _bdt[BDT_INDEX(ep, TX, EVEN)].addr = usb_alloc(epc->in_maxsize);
+      _bdt[BDT_INDEX(ep, TX,  ODD)].addr = usb_alloc(epc->in_maxsize);
+    }
     /* Enable IN direction */
     mask |= USBx_ENDPTn_EPTXEN;
   }
@@ -805,6 +878,19 @@ void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
     bd_next->desc = BDT_DESC(usbp->epc[ep]->out_maxsize,DATA0);
     epc->out_state->data_bank = DATA0;
   }
+#if KINETIS_USB_USE_PINGPONG
+  if (EP_IS_PINGPONG(ep, usbp->epc[ep])) {
+    USBInEndpointState *isp = usbp->epc[ep]->in_state;
+    uint16_t maxsize = usbp->epc[ep]->in_maxsize;
+
+    /* A zero sized transfer is one empty packet */
+    isp->txarmed = 0;
+    isp->txpkts = (isp->txsize == 0) ? 1 :
+                  (uint16_t)((isp->txsize + maxsize - 1) / maxsize);
+    usb_packet_transmit_pp(usbp,ep);
+    return;
+  }
+#endif /* KINETIS_USB_USE_PINGPONG */
   usb_packet_transmit(usbp,ep,usbp->epc[ep]->in_state->txsize);
 }
 
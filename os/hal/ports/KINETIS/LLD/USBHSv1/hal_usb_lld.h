@@ -76,6 +76,19 @@
   #define KINETIS_USB_ENDPOINTS USB_MAX_ENDPOINTS+1
 #endif
 
+/**
+ * @brief   Ping-pong IN bulk and interrupt endpoints.
+ * @details If set to @p TRUE both BDT halves of the IN bulk and interrupt
+ *          endpoints are armed, packets are sent straight from the
+ *          transmit buffer without copies. The host then finds the next
+ *          packet ready instead of being NAKed until the ISR re-arms.
+ * @note    OUT endpoints always have both halves armed, with packet
+ *          buffers.
+ */
+#if !defined(KINETIS_USB_USE_PINGPONG) || defined(__DOXYGEN__)
+#define KINETIS_USB_USE_PINGPONG            TRUE
+#endif
+
 /**
  * @brief   Host wake-up procedure duration.
  */
@@ -139,6 +152,20 @@ typedef struct {
   bool                          odd_even;  /* ODD / EVEN */
   /* */
   bool                          data_bank; /* DATA0 / DATA1 */
+#if (KINETIS_USB_USE_PINGPONG == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Bytes handed to the SIE so far.
+   */
+  size_t                        txarmed;
+  /**
+   * @brief   Packets not yet handed to the SIE.
+   */
+  uint16_t                      txpkts;
+  /**
+   * @brief   Number of BDT halves owned by the SIE.
+   */
+  uint8_t                       txbusy;
+#endif
 } USBInEndpointState;
 
 /**
@@ -49,7 +49,44 @@ ADCDriver ADCD1;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if MSP430X_ADC_EXCLUSIVE_DMA == TRUE
+/**
+ * @brief   Queues the DMA transfer of the next sample block.
+ * @details Two blocks are kept queued so that the DMA ISR chains the next
+ *          one before the callback of the previous one runs.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ */
+static void queue_block(ADCDriver * adcp) {
+  msp430x_dma_req_t * req;
+
+  if (adcp->next >= adcp->depth) {
+    if (!adcp->grpp->circular) {
+      return;
+    }
+    adcp->next = 0;
+  }
+
+  req            = &adcp->chain[adcp->slot];
+  *req           = adcp->req;
+  req->dest_addr = adcp->samples + (adcp->req.size * adcp->next);
+  dmaEnqueueI(&(adcp->dma), &(adcp->qreq[adcp->slot]), req, 0);
+
+  adcp->slot ^= 1;
+  adcp->next++;
+}
+#endif
+
 static void restart_dma(ADCDriver * adcp) {
+#if MSP430X_ADC_EXCLUSIVE_DMA == TRUE
+  if (adcp->config->dma_index < MSP430X_DMA_CHANNELS) {
+    /* The next block is already chained, queues the one after it */
+    osalSysLockFromISR();
+    queue_block(adcp);
+    osalSysUnlockFromISR();
+    return;
+  }
+#endif
   /* TODO timeouts? */
   /* Restart DMA transfer */
   if (adcp->dma.registers == NULL) {
@@ -276,7 +313,10 @@ void adc_lld_start_conversion(ADCDriver * adcp) {
     adcp->dma.index = dmaRequestS(&(adcp->req), TIME_INFINITE);
   }
   else {
-    dmaTransfer(&(adcp->dma), &(adcp->req));
+    adcp->next = 0;
+    adcp->slot = 0;
+    queue_block(adcp);
+    queue_block(adcp);
   }
 #else
   adcp->dma.index       = dmaRequestS(&(adcp->req), TIME_INFINITE);
@@ -298,7 +338,13 @@ void adc_lld_stop_conversion(ADCDriver * adcp) {
   adcp->regs->ctl[0] &= ~(ADC12ENC | ADC12SC);
 
 #if MSP430X_ADC_EXCLUSIVE_DMA == TRUE
-  if (adcp->config->dma_index >= MSP430X_DMA_CHANNELS) {
+  if (adcp->config->dma_index < MSP430X_DMA_CHANNELS) {
+    /* Also called by the ISR full code, outside of the critical zone */
+    syssts_t sts = osalSysGetStatusAndLockX();
+    dmaFlushI(&(adcp->dma));
+    osalSysRestoreStatusX(sts);
+  }
+  else {
 #endif
     if (adcp->dma.registers != NULL) {
       dmaRelease(&(adcp->dma));
@@ -480,6 +480,24 @@ struct ADCDriver {
    * @brief DMA stream
    */
   msp430x_dma_ch_t dma;
+#if MSP430X_ADC_EXCLUSIVE_DMA == TRUE || defined(__DOXYGEN__)
+  /**
+   * @brief Chained DMA requests, one per sample block in flight
+   */
+  msp430x_dma_req_t chain[2];
+  /**
+   * @brief Queued DMA request objects
+   */
+  msp430x_dma_qreq_t qreq[2];
+  /**
+   * @brief Next sample block to queue
+   */
+  size_t next;
+  /**
+   * @brief Next chained request slot to use
+   */
+  uint8_t slot;
+#endif
 };
 
 /*===========================================================================*/
@@ -47,6 +47,10 @@ static msp430x_dma_cb_t callbacks[MSP430X_DMA_CHANNELS];
 static threads_queue_t dma_queue;
 static unsigned int queue_length;
 
+/* Per channel request queues, the active request is not in the queue.*/
+static msp430x_dma_qreq_t * queues[MSP430X_DMA_CHANNELS];
+static msp430x_dma_qreq_t * active[MSP430X_DMA_CHANNELS];
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -76,6 +80,62 @@ static void init_request(const msp430x_dma_req_t * request, uint8_t index) {
             request->transfer_mode;
 }
 
+/**
+ * @brief     Programs a transfer on an acquired channel.
+ *
+ * @param[in] index   The index of the DMA channel.
+ * @param[in] request The transfer to program.
+ */
+static void program_channel(uint8_t index, const msp430x_dma_req_t * request) {
+  msp430x_dma_ch_reg_t * ch = &dma_channels[index];
+
+  dma_trigger_set(index, request->trigger);
+  callbacks[index] = request->callback;
+
+  ch->ctl &= (~DMAEN);
+  ch->sa  = (uintptr_t)request->source_addr;
+  ch->da  = (uintptr_t)request->dest_addr;
+  ch->sz  = request->size;
+  ch->ctl = DMAIE | request->data_mode | request->addr_mode |
+            request->transfer_mode | DMADT_4 | DMAEN |
+            DMAREQ; /* repeated transfers */
+}
+
+/**
+ * @brief     Puts an acquired channel back in its idle mode.
+ *
+ * @param[in] index   The index of the DMA channel.
+ */
+static void idle_channel(uint8_t index) {
+
+  dma_channels[index].ctl &= (~DMAEN);
+  dma_trigger_set(index, DMA_TRIGGER_MNEM(DMAREQ));
+  dma_channels[index].sz  = 0;
+  dma_channels[index].ctl = DMAEN | DMAABORT | DMADT_4;
+  callbacks[index].callback = NULL;
+}
+
+/**
+ * @brief     Starts the next queued request of a channel, if any.
+ * @note      A channel left in repeated mode would run its last transfer
+ *            again on the next trigger, so an empty queue idles it.
+ *
+ * @param[in] index   The index of the DMA channel.
+ */
+static void start_next(uint8_t index) {
+  msp430x_dma_qreq_t * qreq = queues[index];
+
+  active[index] = qreq;
+  if (qreq == NULL) {
+    idle_channel(index);
+    return;
+  }
+  queues[index] = qreq->next;
+  qreq->next    = NULL;
+  qreq->state   = MSP430X_DMA_QREQ_ACTIVE;
+  program_channel(index, qreq->request);
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -87,15 +147,22 @@ PORT_IRQ_HANDLER(DMA_VECTOR) {
   index = (DMAIV >> 1) - 1;
 
   if (index < MSP430X_DMA_CHANNELS) {
+    /* Copied because chaining reprograms the channel callback */
+    msp430x_dma_cb_t cb = callbacks[index];
+
     osalSysLockFromISR();
     osalThreadDequeueNextI(&dma_queue, MSG_OK);
-    osalSysUnlockFromISR();
 
-    msp430x_dma_cb_t * cb = &callbacks[index];
+    /* Chains the next queued transfer before running the callback */
+    if (active[index] != NULL) {
+      active[index]->state = MSP430X_DMA_QREQ_DONE;
+      start_next(index);
+    }
+    osalSysUnlockFromISR();
 
     /* WARNING: CALLBACKS ARE CALLED IN AN ISR CONTEXT! */
-    if (cb->callback != NULL) {
-      cb->callback(cb->args);
+    if (cb.callback != NULL) {
+      cb.callback(cb.args);
     }
   }
 
@@ -202,19 +269,9 @@ bool dmaAcquireI(msp430x_dma_ch_t * channel, uint8_t index) {
  */
 void dmaTransfer(msp430x_dma_ch_t * channel, msp430x_dma_req_t * request) {
 
-  dma_trigger_set(channel->index, request->trigger);
-  /**(channel->ctl) = request->trigger;*/
-
-  channel->cb->callback = request->callback.callback;
-  channel->cb->args     = request->callback.args;
+  osalDbgAssert(active[channel->index] == NULL, "channel queue in use");
 
-  channel->registers->ctl &= (~DMAEN);
-  channel->registers->sa  = (uintptr_t)request->source_addr;
-  channel->registers->da  = (uintptr_t)request->dest_addr;
-  channel->registers->sz  = request->size;
-  channel->registers->ctl = DMAIE | request->data_mode | request->addr_mode |
-                            request->transfer_mode | DMADT_4 | DMAEN |
-                            DMAREQ; /* repeated transfers */
+  program_channel(channel->index, request);
 }
 
 /**
@@ -232,6 +289,9 @@ void dmaRelease(msp430x_dma_ch_t * channel) {
   sts = osalSysGetStatusAndLockX();
   osalDbgCheck(channel != NULL);
 
+  /* Drop the queued requests */
+  dmaFlushI(channel);
+
   /* Release the channel in an idle mode */
   channel->registers->ctl = DMAABORT;
 
@@ -241,6 +301,115 @@ void dmaRelease(msp430x_dma_ch_t * channel) {
   osalSysRestoreStatusX(sts);
 }
 
+/**
+ * @brief   Queues a DMA transfer on an acquired channel.
+ * @details The transfer starts immediately if the channel is idle, else it
+ *          is chained from the DMA ISR when the transfers queued before it
+ *          complete, before the completion callback of the previous one is
+ *          invoked. Requests are served by decreasing priority, in order
+ *          among equal priorities. The active transfer is never preempted.
+ * @pre     The channel must have been acquired using @p dmaAcquireI() and
+ *          must not be used with @p dmaTransfer() while requests are queued.
+ * @note    Both @p qreq and @p request must stay valid until the request is
+ *          completed or cancelled.
+ *
+ * @param[in] channel   pointer to a DMA channel from @p dmaAcquireI().
+ * @param[out] qreq     pointer to the queued request object.
+ * @param[in] request   pointer to a DMA request object.
+ * @param[in] priority  the request priority.
+ *
+ * @iclass
+ */
+void dmaEnqueueI(msp430x_dma_ch_t * channel, msp430x_dma_qreq_t * qreq,
+                 msp430x_dma_req_t * request, uint8_t priority) {
+  msp430x_dma_qreq_t ** pp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((channel != NULL) && (qreq != NULL) && (request != NULL));
+  osalDbgAssert((qreq->state != MSP430X_DMA_QREQ_QUEUED) &&
+                    (qreq->state != MSP430X_DMA_QREQ_ACTIVE),
+                "request already queued");
+
+  qreq->request  = request;
+  qreq->priority = priority;
+  qreq->state    = MSP430X_DMA_QREQ_QUEUED;
+
+  pp = &queues[channel->index];
+  while ((*pp != NULL) && ((*pp)->priority >= priority)) {
+    pp = &(*pp)->next;
+  }
+  qreq->next = *pp;
+  *pp        = qreq;
+
+  if (active[channel->index] == NULL) {
+    start_next(channel->index);
+  }
+}
+
+/**
+ * @brief   Cancels a queued DMA transfer.
+ * @details An active transfer is aborted and the next queued one is started.
+ *          The callback of a cancelled request is not invoked.
+ *
+ * @param[in] channel   pointer to a DMA channel from @p dmaAcquireI().
+ * @param[in] qreq      pointer to the queued request object.
+ * @return              The operation status.
+ * @retval false        the request was not pending, e.g. already completed.
+ * @retval true         the request has been cancelled.
+ *
+ * @iclass
+ */
+bool dmaCancelI(msp430x_dma_ch_t * channel, msp430x_dma_qreq_t * qreq) {
+  msp430x_dma_qreq_t ** pp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((channel != NULL) && (qreq != NULL));
+
+  if (active[channel->index] == qreq) {
+    /* A completion not yet served by the ISR would be credited to the next
+       request, the flag is cleared along with the abort */
+    channel->registers->ctl &= ~(DMAEN | DMAIFG);
+    qreq->state = MSP430X_DMA_QREQ_CANCELLED;
+    start_next(channel->index);
+    return true;
+  }
+
+  for (pp = &queues[channel->index]; *pp != NULL; pp = &(*pp)->next) {
+    if (*pp == qreq) {
+      *pp         = qreq->next;
+      qreq->next  = NULL;
+      qreq->state = MSP430X_DMA_QREQ_CANCELLED;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Cancels all the DMA transfers queued on a channel.
+ * @details The channel is left idle.
+ *
+ * @param[in] channel   pointer to a DMA channel from @p dmaAcquireI().
+ *
+ * @iclass
+ */
+void dmaFlushI(msp430x_dma_ch_t * channel) {
+  msp430x_dma_qreq_t * qreq;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(channel != NULL);
+
+  while ((qreq = queues[channel->index]) != NULL) {
+    queues[channel->index] = qreq->next;
+    qreq->next             = NULL;
+    qreq->state            = MSP430X_DMA_QREQ_CANCELLED;
+  }
+  if (active[channel->index] != NULL) {
+    (void)dmaCancelI(channel, active[channel->index]);
+  }
+}
+
 #endif /* HAL_USE_DMA == TRUE */
 
 /** @} */
@@ -47,6 +47,17 @@
 #define MSP430X_DMA_SRCWORD 0
 #define MSP430X_DMA_DSTWORD 0
 
+/**
+ * @name    Queued request states
+ * @{
+ */
+#define MSP430X_DMA_QREQ_IDLE 0      /**< @brief Never queued.               */
+#define MSP430X_DMA_QREQ_QUEUED 1    /**< @brief Waiting for the channel.    */
+#define MSP430X_DMA_QREQ_ACTIVE 2    /**< @brief Being transferred.          */
+#define MSP430X_DMA_QREQ_DONE 3      /**< @brief Transfer completed.         */
+#define MSP430X_DMA_QREQ_CANCELLED 4 /**< @brief Cancelled before completion.*/
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -137,6 +148,18 @@ typedef struct {
   msp430x_dma_cb_t * cb; /**< @brief Pointer to callback function  and args  */
 } msp430x_dma_ch_t;
 
+/**
+ * @brief     MSP430X DMA queued request structure.
+ * @note      The structure and its request belong to the DMA engine from
+ *            @p dmaEnqueueI() until the transfer is completed or cancelled.
+ */
+typedef struct msp430x_dma_qreq {
+  struct msp430x_dma_qreq * next; /**< @brief Next request in the queue      */
+  msp430x_dma_req_t * request;    /**< @brief Transfer to perform            */
+  uint8_t priority;               /**< @brief Priority, higher goes first    */
+  volatile uint8_t state;         /**< @brief Request state                  */
+} msp430x_dma_qreq_t;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -163,6 +186,10 @@ int dmaRequestS(msp430x_dma_req_t * request, systime_t timeout);
 bool dmaAcquireI(msp430x_dma_ch_t * channel, uint8_t index);
 void dmaTransfer(msp430x_dma_ch_t * channel, msp430x_dma_req_t * request);
 void dmaRelease(msp430x_dma_ch_t * channel);
+void dmaEnqueueI(msp430x_dma_ch_t * channel, msp430x_dma_qreq_t * qreq,
+                 msp430x_dma_req_t * request, uint8_t priority);
+bool dmaCancelI(msp430x_dma_ch_t * channel, msp430x_dma_qreq_t * qreq);
+void dmaFlushI(msp430x_dma_ch_t * channel);
 
 #ifdef __cplusplus
 }
@@ -89,7 +89,12 @@ SerialDriver SD3;
 /**
  * @brief   Driver default configuration.
  */
-static const SerialConfig default_config = { SERIAL_DEFAULT_BITRATE };
+static const SerialConfig default_config = {
+  SERIAL_DEFAULT_BITRATE,
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+  MSP430X_DMA_CHANNELS
+#endif
+};
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
@@ -324,6 +329,109 @@ static void set_error(uint16_t sra, SerialDriver * sdp) {
   osalSysUnlockFromISR();
 }
 
+#if (MSP430X_SERIAL_USE_RX_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief     Moves the bytes received by the DMA to the input queue.
+ *
+ * @param[in] sdp     pointer to a @p SerialDriver object
+ */
+static void rx_dma_flush(SerialDriver * sdp) {
+  eventflags_t flags;
+
+  flags = sdDmaRxRingFlushI(&sdp->rxring, &sdp->iqueue,
+                            sdp->rxring.size - sdp->dmarx.registers->sz);
+  if (flags != 0) {
+    chnAddFlagsI(sdp, flags);
+  }
+}
+
+/**
+ * @brief     RX DMA wrap callback.
+ *
+ * @param[in] args    pointer to a @p SerialDriver object
+ */
+static void rx_dma_wrap(void * args) {
+
+  osalSysLockFromISR();
+  rx_dma_flush((SerialDriver *)args);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief     RX DMA poll timer callback.
+ *
+ * @param[in] p       pointer to a @p SerialDriver object
+ */
+static void rx_dma_poll(void * p) {
+  SerialDriver * sdp = (SerialDriver *)p;
+
+  osalSysLockFromISR();
+  rx_dma_flush(sdp);
+  chVTSetI(&sdp->rxvt, OSAL_MS2I(MSP430X_SERIAL_RX_DMA_POLL_INTERVAL),
+           rx_dma_poll, sdp);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief     Starts receiving through the configured DMA channel, if any.
+ * @details   The channel runs in repeated single transfer mode over the
+ *            ring buffer, the buffer is flushed on wrap and by the poll
+ *            timer.
+ *
+ * @param[in] sdp     pointer to a @p SerialDriver object
+ * @param[in] config  the serial driver configuration
+ * @param[in] rxbuf   pointer to the USCI receive buffer register
+ * @param[in] trigger the USCI receive DMA trigger
+ * @return            The DMA receive mode.
+ * @retval true       the DMA channel has been started.
+ * @retval false      the configuration does not use DMA.
+ */
+static bool rx_dma_start(SerialDriver * sdp, const SerialConfig * config,
+                         volatile uint16_t * rxbuf, uint8_t trigger) {
+  bool b;
+
+  if (config->dmarx_index >= MSP430X_DMA_CHANNELS) {
+    return false;
+  }
+  b = dmaAcquireI(&(sdp->dmarx), config->dmarx_index);
+  osalDbgAssert(!b, "stream already allocated");
+
+  sdDmaRxRingInit(&(sdp->rxring), sdp->rxbuf,
+                  MSP430X_SERIAL_RX_DMA_BUFFER_SIZE);
+  sdp->rx_req.source_addr       = (const void *)rxbuf;
+  sdp->rx_req.dest_addr         = sdp->rxbuf;
+  sdp->rx_req.size              = MSP430X_SERIAL_RX_DMA_BUFFER_SIZE;
+  sdp->rx_req.addr_mode         = MSP430X_DMA_DSTINCR;
+  sdp->rx_req.data_mode         = MSP430X_DMA_SRCBYTE | MSP430X_DMA_DSTBYTE;
+  sdp->rx_req.transfer_mode     = MSP430X_DMA_SINGLE;
+  sdp->rx_req.trigger           = trigger;
+  sdp->rx_req.callback.callback = rx_dma_wrap;
+  sdp->rx_req.callback.args     = sdp;
+
+  /* The trigger is edge sensitive, a pending RX flag would stall it.*/
+  (void)*rxbuf;
+  dmaTransfer(&(sdp->dmarx), &(sdp->rx_req));
+  chVTSetI(&sdp->rxvt, OSAL_MS2I(MSP430X_SERIAL_RX_DMA_POLL_INTERVAL),
+           rx_dma_poll, sdp);
+
+  return true;
+}
+
+/**
+ * @brief     Stops receiving through DMA, if active.
+ *
+ * @param[in] sdp     pointer to a @p SerialDriver object
+ */
+static void rx_dma_stop(SerialDriver * sdp) {
+
+  if (sdp->dmarx.registers != NULL) {
+    chVTResetI(&sdp->rxvt);
+    dmaRelease(&(sdp->dmarx));
+    sdp->dmarx.registers = NULL;
+  }
+}
+#endif /* MSP430X_SERIAL_USE_RX_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -573,18 +681,34 @@ void sd_lld_init(void) {
 
 #if MSP430X_SERIAL_USE_USART0 == TRUE
   sdObjectInit(&SD0, NULL, notify0);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+  SD0.dmarx.registers = NULL;
+  chVTObjectInit(&SD0.rxvt);
+#endif
 #endif
 
 #if MSP430X_SERIAL_USE_USART1 == TRUE
   sdObjectInit(&SD1, NULL, notify1);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+  SD1.dmarx.registers = NULL;
+  chVTObjectInit(&SD1.rxvt);
+#endif
 #endif
 
 #if MSP430X_SERIAL_USE_USART2 == TRUE
   sdObjectInit(&SD2, NULL, notify2);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+  SD2.dmarx.registers = NULL;
+  chVTObjectInit(&SD2.rxvt);
+#endif
 #endif
 
 #if MSP430X_SERIAL_USE_USART3 == TRUE
   sdObjectInit(&SD3, NULL, notify3);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+  SD3.dmarx.registers = NULL;
+  chVTObjectInit(&SD3.rxvt);
+#endif
 #endif
 }
 
@@ -608,21 +732,45 @@ void sd_lld_start(SerialDriver * sdp, const SerialConfig * config) {
 #if MSP430X_SERIAL_USE_USART0 == TRUE
     if (&SD0 == sdp) {
       usart0_init(config);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+      if (rx_dma_start(sdp, config, &UCA0RXBUF,
+                       DMA_TRIGGER_MNEM(UCA0RXIFG))) {
+        UCA0IE &= ~UCRXIE;
+      }
+#endif
     }
 #endif
 #if MSP430X_SERIAL_USE_USART1 == TRUE
     if (&SD1 == sdp) {
       usart1_init(config);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+      if (rx_dma_start(sdp, config, &UCA1RXBUF,
+                       DMA_TRIGGER_MNEM(UCA1RXIFG))) {
+        UCA1IE &= ~UCRXIE;
+      }
+#endif
     }
 #endif
 #if MSP430X_SERIAL_USE_USART2 == TRUE
     if (&SD2 == sdp) {
       usart2_init(config);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+      if (rx_dma_start(sdp, config, &UCA2RXBUF,
+                       DMA_TRIGGER_MNEM(UCA2RXIFG))) {
+        UCA2IE &= ~UCRXIE;
+      }
+#endif
     }
 #endif
 #if MSP430X_SERIAL_USE_USART3 == TRUE
     if (&SD3 == sdp) {
       usart3_init(config);
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+      if (rx_dma_start(sdp, config, &UCA3RXBUF,
+                       DMA_TRIGGER_MNEM(UCA3RXIFG))) {
+        UCA3IE &= ~UCRXIE;
+      }
+#endif
     }
 #endif
   }
@@ -640,6 +788,9 @@ void sd_lld_start(SerialDriver * sdp, const SerialConfig * config) {
 void sd_lld_stop(SerialDriver * sdp) {
 
   if (sdp->state == SD_READY) {
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+    rx_dma_stop(sdp);
+#endif
 #if MSP430X_SERIAL_USE_USART0 == TRUE
     if (&SD0 == sdp) {
       UCA0CTLW0 = UCSWRST;
@@ -107,6 +107,35 @@
 #define MSP430X_SERIAL_USE_USART3             FALSE
 #endif
 
+/**
+ * @brief   DMA receive enable switch.
+ * @details If set to @p TRUE the support for receiving through an exclusive
+ *          DMA channel is included, the channel is selected per port in the
+ *          @p SerialConfig structure.
+ * @note    The eUSCI has no idle line interrupt, the DMA buffer is polled
+ *          by a virtual timer instead.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(MSP430X_SERIAL_USE_RX_DMA) || defined(__DOXYGEN__)
+#define MSP430X_SERIAL_USE_RX_DMA             FALSE
+#endif
+
+/**
+ * @brief   DMA receive buffer size.
+ * @note    The buffer must hold the bytes received during one poll
+ *          interval.
+ */
+#if !defined(MSP430X_SERIAL_RX_DMA_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define MSP430X_SERIAL_RX_DMA_BUFFER_SIZE     32
+#endif
+
+/**
+ * @brief   DMA receive buffer poll interval, in milliseconds.
+ */
+#if !defined(MSP430X_SERIAL_RX_DMA_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define MSP430X_SERIAL_RX_DMA_POLL_INTERVAL   2
+#endif
+
 #if MSP430X_SERIAL_USE_USART0
   #if !defined(MSP430X_USART0_PARITY)
     #define MSP430X_USART0_PARITY NONE
@@ -241,6 +270,14 @@
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (MSP430X_SERIAL_USE_RX_DMA == TRUE) && (HAL_USE_DMA != TRUE)
+#error "MSP430X_SERIAL_USE_RX_DMA requires HAL_USE_DMA"
+#endif
+
+#if MSP430X_SERIAL_USE_RX_DMA == TRUE
+#include "hal_serial_dmarx.h"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -260,8 +297,35 @@ typedef struct {
   uint32_t                  sc_bitrate;
     
   /* End of the mandatory fields.*/
+#if (MSP430X_SERIAL_USE_RX_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief The index of the RX DMA channel.
+   * @note  This may be >MSP430X_DMA_CHANNELS to indicate that DMA is not
+   *        used for receiving.
+   */
+  uint8_t                   dmarx_index;
+#endif
 } SerialConfig;
 
+#if (MSP430X_SERIAL_USE_RX_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   @p SerialDriver DMA receive data.
+ */
+#define _serial_driver_dmarx_data                                           \
+  /* RX DMA channel, NULL registers if not in use.*/                        \
+  msp430x_dma_ch_t          dmarx;                                          \
+  /* RX DMA request.*/                                                      \
+  msp430x_dma_req_t         rx_req;                                         \
+  /* RX DMA ring.*/                                                         \
+  sd_dmarx_ring_t           rxring;                                         \
+  /* RX DMA poll timer.*/                                                   \
+  virtual_timer_t           rxvt;                                           \
+  /* RX DMA buffer.*/                                                       \
+  uint8_t                   rxbuf[MSP430X_SERIAL_RX_DMA_BUFFER_SIZE];
+#else
+#define _serial_driver_dmarx_data
+#endif
+
 /**
  * @brief   @p SerialDriver specific data.
  */
@@ -277,7 +341,8 @@ typedef struct {
   uint8_t                   ib[SERIAL_BUFFERS_SIZE];                        \
   /* Output circular buffer.*/                                              \
   uint8_t                   ob[SERIAL_BUFFERS_SIZE];                        \
-  /* End of the mandatory fields.*/
+  /* End of the mandatory fields.*/                                         \
+  _serial_driver_dmarx_data
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -1,2 +1,9 @@
-PLATFORMSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/DMA2Dv1/hal_stm32_dma2d.c
-PLATFORMINC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/DMA2Dv1
+PLATFORMSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/DMA2Dv1/hal_stm32_dma2d.c \
+                       ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/DMA2Dv1/hal_stm32_dma2d_atlas.c
+PLATFORMINC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/DMA2Dv1
+
+# Pixel format library, shared with the LTDC driver.
+ifeq ($(HALSRC_PIXFMT),)
+HALSRC_PIXFMT := ${CHIBIOS_CONTRIB}/os/hal/src/hal_pixfmt.c
+PLATFORMSRC_CONTRIB += $(HALSRC_PIXFMT)
+endif
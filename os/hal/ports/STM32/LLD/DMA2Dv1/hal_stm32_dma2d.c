@@ -50,23 +50,6 @@ DMA2DDriver DMA2DD1;
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-/**
- * @brief   Bits per pixel lookup table.
- */
-static const uint8_t dma2d_bpp[DMA2D_MAX_PIXFMT_ID + 1] = {
-  32,  /* DMA2D_FMT_ARGB8888 */
-  24,  /* DMA2D_FMT_RGB888 */
-  16,  /* DMA2D_FMT_RGB565 */
-  16,  /* DMA2D_FMT_ARGB1555 */
-  16,  /* DMA2D_FMT_ARGB4444 */
-   8,  /* DMA2D_FMT_L8 */
-   8,  /* DMA2D_FMT_AL44 */
-  16,  /* DMA2D_FMT_AL88 */
-   4,  /* DMA2D_FMT_L4 */
-   8,  /* DMA2D_FMT_A8 */
-   4   /* DMA2D_FMT_A4 */
-};
-
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -2977,9 +2960,9 @@ bool dma2dIsAligned(const void *bufferp, dma2d_pixfmt_t fmt) {
  */
 size_t dma2dBitsPerPixel(dma2d_pixfmt_t fmt) {
 
-  osalDbgAssert(fmt < DMA2D_MAX_PIXFMT_ID, "invalid format");
+  osalDbgAssert(fmt < PIXFMT_COUNT, "invalid format");
 
-  return (size_t)dma2d_bpp[(unsigned)fmt];
+  return (size_t)PIXFMT_BPP(fmt);
 }
 
 #if DMA2D_USE_SOFTWARE_CONVERSIONS || defined(__DOXYGEN__)
@@ -2998,54 +2981,9 @@ size_t dma2dBitsPerPixel(dma2d_pixfmt_t fmt) {
  */
 dma2d_color_t dma2dFromARGB8888(dma2d_color_t c, dma2d_pixfmt_t fmt) {
 
-  switch (fmt) {
-  case DMA2D_FMT_ARGB8888: {
-    return c;
-  }
-  case DMA2D_FMT_RGB888: {
-    return (c & 0x00FFFFFF);
-  }
-  case DMA2D_FMT_RGB565: {
-    return (((c & 0x000000F8) >> ( 8 -  5)) |
-            ((c & 0x0000FC00) >> (16 - 11)) |
-            ((c & 0x00F80000) >> (24 - 16)));
-  }
-  case DMA2D_FMT_ARGB1555: {
-    return (((c & 0x000000F8) >> ( 8 -  5)) |
-            ((c & 0x0000F800) >> (16 - 10)) |
-            ((c & 0x00F80000) >> (24 - 15)) |
-            ((c & 0x80000000) >> (32 - 16)));
-  }
-  case DMA2D_FMT_ARGB4444: {
-    return (((c & 0x000000F0) >> ( 8 -  4)) |
-            ((c & 0x0000F000) >> (16 -  8)) |
-            ((c & 0x00F00000) >> (24 - 12)) |
-            ((c & 0xF0000000) >> (32 - 16)));
-  }
-  case DMA2D_FMT_L8: {
-    return (c & 0x000000FF);
-  }
-  case DMA2D_FMT_AL44: {
-    return (((c & 0x000000F0) >> ( 8 - 4)) |
-            ((c & 0xF0000000) >> (32 - 8)));
-  }
-  case DMA2D_FMT_AL88: {
-    return (((c & 0x000000FF) >> ( 8 -  8)) |
-            ((c & 0xFF000000) >> (32 - 16)));
-  }
-  case DMA2D_FMT_L4: {
-    return (c & 0x0000000F);
-  }
-  case DMA2D_FMT_A8: {
-    return ((c & 0xFF000000) >> (32 - 8));
-  }
-  case DMA2D_FMT_A4: {
-    return ((c & 0xF0000000) >> (32 - 4));
-  }
-  default:
-    osalDbgAssert(false, "invalid format");
-    return 0;
-  }
+  osalDbgAssert(fmt < PIXFMT_COUNT, "invalid format");
+
+  return (dma2d_color_t)pixfmtFromARGB8888((uint32_t)c, (unsigned)fmt);
 }
 
 /**
@@ -3062,62 +3000,31 @@ dma2d_color_t dma2dFromARGB8888(dma2d_color_t c, dma2d_pixfmt_t fmt) {
  */
 dma2d_color_t dma2dToARGB8888(dma2d_color_t c, dma2d_pixfmt_t fmt) {
 
-  switch (fmt) {
-  case DMA2D_FMT_ARGB8888: {
-    return c;
-  }
-  case DMA2D_FMT_RGB888: {
-    return ((c & 0x00FFFFFF) | 0xFF000000);
-  }
-  case DMA2D_FMT_RGB565: {
-    register dma2d_color_t output = 0xFF000000;
-    if (c & 0x001F) output |= (((c & 0x001F) << ( 8 -  5)) | 0x00000007);
-    if (c & 0x07E0) output |= (((c & 0x07E0) << (16 - 11)) | 0x00000300);
-    if (c & 0xF800) output |= (((c & 0xF800) << (24 - 16)) | 0x00070000);
-    return output;
-  }
-  case DMA2D_FMT_ARGB1555: {
-    register dma2d_color_t output = 0x00000000;
-    if (c & 0x001F) output |= (((c & 0x001F) << ( 8 -  5)) | 0x00000007);
-    if (c & 0x03E0) output |= (((c & 0x03E0) << (16 - 10)) | 0x00000700);
-    if (c & 0x7C00) output |= (((c & 0x7C00) << (24 - 15)) | 0x00070000);
-    if (c & 0x8000) output |= 0xFF000000;
-    return output;
-  }
-  case DMA2D_FMT_ARGB4444: {
-    register dma2d_color_t output = 0x00000000;
-    if (c & 0x000F) output |= (((c & 0x000F) << ( 8 -  4)) | 0x0000000F);
-    if (c & 0x00F0) output |= (((c & 0x00F0) << (16 -  8)) | 0x00000F00);
-    if (c & 0x0F00) output |= (((c & 0x0F00) << (24 - 12)) | 0x000F0000);
-    if (c & 0xF000) output |= (((c & 0xF000) << (32 - 16)) | 0x0F000000);
-    return output;
-  }
-  case DMA2D_FMT_L8: {
-    return (c & 0xFF) | 0xFF000000;
-  }
-  case DMA2D_FMT_AL44: {
-    register dma2d_color_t output = 0x00000000;
-    if (c & 0x0F) output |= (((c & 0x0F) << ( 8 - 4)) | 0x0000000F);
-    if (c & 0xF0) output |= (((c & 0xF0) << (32 - 8)) | 0x0F000000);
-    return output;
-  }
-  case DMA2D_FMT_AL88: {
-    return (((c & 0x00FF) << ( 8 -  8)) |
-            ((c & 0xFF00) << (32 - 16)));
-  }
-  case DMA2D_FMT_L4: {
-    return ((c & 0x0F) | 0xFF000000);
-  }
-  case DMA2D_FMT_A8: {
-    return ((c & 0xFF) << (32 - 8));
-  }
-  case DMA2D_FMT_A4: {
-    return ((c & 0x0F) << (32 - 4));
-  }
-  default:
-    osalDbgAssert(false, "invalid format");
-    return 0;
-  }
+  osalDbgAssert(fmt < PIXFMT_COUNT, "invalid format");
+
+  return (dma2d_color_t)pixfmtToARGB8888((uint32_t)c, (unsigned)fmt);
+}
+
+/**
+ * @brief   Convert pixel span.
+ * @details Converts a span of pixels between two pixel formats. The
+ *          conversion kernel is selected once for the whole span.
+ *
+ * @param[in] srcp      source pixels
+ * @param[in] srcfmt    source pixel format
+ * @param[out] dstp     destination pixels
+ * @param[in] dstfmt    destination pixel format
+ * @param[in] n         number of pixels
+ *
+ * @api
+ */
+void dma2dConvertSpan(const void *srcp, dma2d_pixfmt_t srcfmt,
+                      void *dstp, dma2d_pixfmt_t dstfmt, size_t n) {
+
+  osalDbgAssert(srcfmt < PIXFMT_COUNT, "invalid format");
+  osalDbgAssert(dstfmt < PIXFMT_COUNT, "invalid format");
+
+  pixfmtConvertSpan(srcp, (unsigned)srcfmt, dstp, (unsigned)dstfmt, n);
 }
 
 #endif  /* DMA2D_NEED_CONVERSIONS */
@@ -25,6 +25,8 @@
 #ifndef HAL_STM32_DMA2D_H_
 #define HAL_STM32_DMA2D_H_
 
+#include "hal_pixfmt.h"
+
 /**
  * @brief   Using the DMA2D driver.
  */
@@ -230,6 +232,20 @@
 #error "DMA2D not present in the selected device"
 #endif
 
+#if (DMA2D_FMT_ARGB8888 != PIXFMT_ARGB8888) || \
+    (DMA2D_FMT_RGB888 != PIXFMT_RGB888) || \
+    (DMA2D_FMT_RGB565 != PIXFMT_RGB565) || \
+    (DMA2D_FMT_ARGB1555 != PIXFMT_ARGB1555) || \
+    (DMA2D_FMT_ARGB4444 != PIXFMT_ARGB4444) || \
+    (DMA2D_FMT_L8 != PIXFMT_L8) || \
+    (DMA2D_FMT_AL44 != PIXFMT_AL44) || \
+    (DMA2D_FMT_AL88 != PIXFMT_AL88) || \
+    (DMA2D_FMT_L4 != PIXFMT_L4) || \
+    (DMA2D_FMT_A8 != PIXFMT_A8) || \
+    (DMA2D_FMT_A4 != PIXFMT_A4)
+#error "DMA2D pixel formats do not match hal_pixfmt.h"
+#endif
+
 #if (TRUE == DMA2D_USE_MUTUAL_EXCLUSION)
 #if (TRUE != CH_CFG_USE_MUTEXES) && (TRUE != CH_CFG_USE_SEMAPHORES)
 #error "DMA2D_USE_MUTUAL_EXCLUSION requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
@@ -651,6 +667,8 @@ extern "C" {
 #if (TRUE == DMA2D_USE_SOFTWARE_CONVERSIONS) || defined(__DOXYGEN__)
   dma2d_color_t dma2dFromARGB8888(dma2d_color_t c, dma2d_pixfmt_t fmt);
   dma2d_color_t dma2dToARGB8888(dma2d_color_t c, dma2d_pixfmt_t fmt);
+  void dma2dConvertSpan(const void *srcp, dma2d_pixfmt_t srcfmt,
+                        void *dstp, dma2d_pixfmt_t dstfmt, size_t n);
 #endif  /* DMA2D_USE_SOFTWARE_CONVERSIONS */
 
 #ifdef __cplusplus
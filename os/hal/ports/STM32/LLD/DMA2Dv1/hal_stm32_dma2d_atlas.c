@@ -0,0 +1,414 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_stm32_dma2d_atlas.c
+ * @brief   DMA2D glyph and sprite atlas renderer.
+ */
+
+#include "hal.h"
+
+#include "hal_stm32_dma2d_atlas.h"
+
+#if STM32_DMA2D_USE_DMA2D || defined(__DOXYGEN__)
+
+/**
+ * @addtogroup dma2d_atlas
+ * @{
+ */
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Sets up the layers shared by all the entries of a run.
+ * @details Loads the atlas palette (if not already cached), selects the
+ *          blending job and the layer formats. Only per-entry addresses,
+ *          offsets and sizes are programmed afterwards.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the atlas
+ * @param[in] c         color (A-4/A-8) and opacity, ARGB-8888
+ *
+ * @notapi
+ */
+static void atlas_setup_s(DMA2DAtlasRenderer *arp,
+                          const dma2d_surface_t *surfacep,
+                          const dma2d_atlas_t *atlasp,
+                          dma2d_color_t c) {
+
+  DMA2DDriver *const dma2dp = arp->dma2dp;
+
+  if (atlasp->palettep != NULL)
+    dma2dAtlasLoadPaletteS(arp, atlasp->palettep);
+
+  dma2dJobSetModeI(dma2dp, DMA2D_JOB_BLEND);
+
+  dma2dFgSetPixelFormatI(dma2dp, atlasp->fmt);
+  dma2dFgSetDefaultColorI(dma2dp, c & 0x00FFFFFF);
+  dma2dFgSetAlphaModeI(dma2dp, DMA2D_ALPHA_MODULATE);
+  dma2dFgSetConstantAlphaI(dma2dp, (uint8_t)(c >> 24));
+
+  dma2dBgSetPixelFormatI(dma2dp, surfacep->fmt);
+  dma2dBgSetAlphaModeI(dma2dp, DMA2D_ALPHA_KEEP);
+
+  dma2dOutSetPixelFormatI(dma2dp, surfacep->fmt);
+}
+
+/**
+ * @brief   Blends one atlas entry onto the surface.
+ * @details The entry is clipped against the surface bounds. With 4-bit atlas
+ *          formats the clipped area is kept byte aligned.
+ * @pre     The layers have been set up by @p atlas_setup_s().
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the atlas
+ * @param[in] entryp    pointer to the atlas entry
+ * @param[in] x         destination horizontal coordinate
+ * @param[in] y         destination vertical coordinate
+ *
+ * @notapi
+ */
+static void atlas_blit_s(DMA2DAtlasRenderer *arp,
+                         const dma2d_surface_t *surfacep,
+                         const dma2d_atlas_t *atlasp,
+                         const dma2d_atlas_entry_t *entryp,
+                         int x, int y) {
+
+  DMA2DDriver *const dma2dp = arp->dma2dp;
+  int sx = entryp->x;
+  int sy = entryp->y;
+  int w = entryp->width;
+  int h = entryp->height;
+  size_t src_pitch, dst_stride;
+  const void *srcp;
+  void *dstp;
+
+  /* Clipping.*/
+  if (x < 0) {
+    sx -= x;
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    sy -= y;
+    h += y;
+    y = 0;
+  }
+  if (x + w > (int)surfacep->width)
+    w = (int)surfacep->width - x;
+  if (y + h > (int)surfacep->height)
+    h = (int)surfacep->height - y;
+  if (dma2dBitsPerPixel(atlasp->fmt) < 8) {
+    if (sx & 1) {
+      ++sx;
+      ++x;
+      --w;
+    }
+    w &= ~1;
+  }
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  src_pitch = ((size_t)atlasp->width * dma2dBitsPerPixel(atlasp->fmt)) >> 3;
+  dst_stride = (surfacep->pitch << 3) / dma2dBitsPerPixel(surfacep->fmt);
+
+  srcp = dma2dComputeAddressConst(atlasp->pixelsp, src_pitch, atlasp->fmt,
+                                  (uint16_t)sx, (uint16_t)sy);
+  dstp = dma2dComputeAddress(surfacep->bufferp, surfacep->pitch,
+                             surfacep->fmt, (uint16_t)x, (uint16_t)y);
+
+  dma2dFgSetAddressI(dma2dp, (void *)srcp);
+  dma2dFgSetWrapOffsetI(dma2dp, (size_t)atlasp->width - (size_t)w);
+  dma2dBgSetAddressI(dma2dp, dstp);
+  dma2dBgSetWrapOffsetI(dma2dp, dst_stride - (size_t)w);
+  dma2dOutSetAddressI(dma2dp, dstp);
+  dma2dOutSetWrapOffsetI(dma2dp, dst_stride - (size_t)w);
+  dma2dJobSetSizeI(dma2dp, (uint16_t)w, (uint16_t)h);
+  dma2dJobExecuteS(dma2dp);
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an atlas renderer object.
+ *
+ * @param[out] arp      pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] dma2dp    pointer to the @p DMA2DDriver object
+ *
+ * @init
+ */
+void dma2dAtlasObjectInit(DMA2DAtlasRenderer *arp, DMA2DDriver *dma2dp) {
+
+  osalDbgCheck((arp != NULL) && (dma2dp != NULL));
+
+  arp->dma2dp = dma2dp;
+  arp->clut_colorsp = NULL;
+  arp->clut_length = 0;
+  arp->clut_fmt = DMA2D_FMT_ARGB8888;
+  arp->clut_loads = 0;
+}
+
+/**
+ * @brief   Loads a foreground palette through the CLUT cache.
+ * @details The CLUT transfer is skipped if the same palette is already
+ *          loaded into the foreground CLUT.
+ * @pre     DMA2D is ready.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] palettep  pointer to the palette specifications
+ *
+ * @return              The CLUT transfer state.
+ * @retval false        palette already loaded, nothing done.
+ * @retval true         palette transferred into the CLUT.
+ *
+ * @sclass
+ */
+bool dma2dAtlasLoadPaletteS(DMA2DAtlasRenderer *arp,
+                            const dma2d_palcfg_t *palettep) {
+
+  osalDbgCheckClassS();
+  osalDbgCheck((arp != NULL) && (palettep != NULL));
+
+  if ((arp->clut_colorsp == palettep->colorsp) &&
+      (arp->clut_length == palettep->length) &&
+      (arp->clut_fmt == palettep->fmt))
+    return false;
+
+  dma2dFgSetPaletteS(arp->dma2dp, palettep);
+  arp->clut_colorsp = palettep->colorsp;
+  arp->clut_length = palettep->length;
+  arp->clut_fmt = palettep->fmt;
+  arp->clut_loads++;
+  return true;
+}
+
+/**
+ * @brief   Looks up the atlas entry of a character code.
+ *
+ * @param[in] atlasp    pointer to the atlas
+ * @param[in] code      character code
+ *
+ * @return              The entry index, the atlas fallback entry if the code
+ *                      is not mapped.
+ *
+ * @api
+ */
+uint16_t dma2dAtlasLookup(const dma2d_atlas_t *atlasp, uint16_t code) {
+
+  osalDbgCheck(atlasp != NULL);
+
+  if ((code >= atlasp->first) &&
+      ((uint32_t)code - atlasp->first < atlasp->count))
+    return (uint16_t)(code - atlasp->first);
+  return atlasp->fallback;
+}
+
+/**
+ * @brief   Computes the width of a text.
+ * @details The width of multi-line texts is the width of the longest line.
+ *
+ * @param[in] atlasp    pointer to the font atlas
+ * @param[in] text      zero-terminated text
+ *
+ * @return              The text width, in pixels.
+ *
+ * @api
+ */
+uint16_t dma2dAtlasTextWidth(const dma2d_atlas_t *atlasp, const char *text) {
+
+  uint16_t width = 0, line = 0, index;
+
+  osalDbgCheck((atlasp != NULL) && (text != NULL));
+
+  for (; *text != '\0'; ++text) {
+    if (*text == '\n') {
+      line = 0;
+      continue;
+    }
+    index = dma2dAtlasLookup(atlasp, (uint8_t)*text);
+    if (index != DMA2D_ATLAS_NO_ENTRY)
+      line += atlasp->entriesp[index].advance;
+    if (line > width)
+      width = line;
+  }
+  return width;
+}
+
+/**
+ * @brief   Draws an atlas entry.
+ * @details Blends a sprite or glyph onto the surface. Glyphs of alpha-only
+ *          atlases are drawn with the RGB part of @p c; for all atlases the
+ *          alpha part of @p c modulates the opacity.
+ * @pre     DMA2D is ready.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the atlas
+ * @param[in] index     entry index
+ * @param[in] x         destination horizontal coordinate of the pen
+ * @param[in] y         destination vertical coordinate of the pen
+ * @param[in] c         color and opacity, ARGB-8888
+ *
+ * @sclass
+ */
+void dma2dAtlasDrawEntryS(DMA2DAtlasRenderer *arp,
+                          const dma2d_surface_t *surfacep,
+                          const dma2d_atlas_t *atlasp, uint16_t index,
+                          int x, int y, dma2d_color_t c) {
+
+  const dma2d_atlas_entry_t *entryp;
+
+  osalDbgCheckClassS();
+  osalDbgCheck((arp != NULL) && (surfacep != NULL) && (atlasp != NULL));
+  osalDbgCheck(index < atlasp->count);
+
+  entryp = &atlasp->entriesp[index];
+  atlas_setup_s(arp, surfacep, atlasp, c);
+  atlas_blit_s(arp, surfacep, atlasp, entryp,
+               x + entryp->xoff, y + entryp->yoff);
+}
+
+/**
+ * @brief   Draws an atlas entry.
+ * @details Blends a sprite or glyph onto the surface. Glyphs of alpha-only
+ *          atlases are drawn with the RGB part of @p c; for all atlases the
+ *          alpha part of @p c modulates the opacity.
+ * @pre     DMA2D is ready.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the atlas
+ * @param[in] index     entry index
+ * @param[in] x         destination horizontal coordinate of the pen
+ * @param[in] y         destination vertical coordinate of the pen
+ * @param[in] c         color and opacity, ARGB-8888
+ *
+ * @api
+ */
+void dma2dAtlasDrawEntry(DMA2DAtlasRenderer *arp,
+                         const dma2d_surface_t *surfacep,
+                         const dma2d_atlas_t *atlasp, uint16_t index,
+                         int x, int y, dma2d_color_t c) {
+
+  chSysLock();
+  dma2dAtlasDrawEntryS(arp, surfacep, atlasp, index, x, y, c);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Draws a text.
+ * @details Blends a run of glyphs onto the surface. The layers are set up
+ *          once for the whole run, then one blending job per visible glyph
+ *          is executed. A <tt>'\\n'</tt> moves the pen to the next line.
+ * @pre     DMA2D is ready.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the font atlas
+ * @param[in] text      zero-terminated text
+ * @param[in] x         horizontal coordinate of the pen
+ * @param[in] y         vertical coordinate of the pen, top of the line
+ * @param[in] c         color and opacity, ARGB-8888
+ *
+ * @return              The horizontal coordinate of the pen after the text.
+ *
+ * @sclass
+ */
+int dma2dAtlasDrawTextS(DMA2DAtlasRenderer *arp,
+                        const dma2d_surface_t *surfacep,
+                        const dma2d_atlas_t *atlasp, const char *text,
+                        int x, int y, dma2d_color_t c) {
+
+  const dma2d_atlas_entry_t *entryp;
+  const int x0 = x;
+  uint16_t index;
+
+  osalDbgCheckClassS();
+  osalDbgCheck((arp != NULL) && (surfacep != NULL) && (atlasp != NULL));
+  osalDbgCheck(text != NULL);
+
+  atlas_setup_s(arp, surfacep, atlasp, c);
+
+  for (; *text != '\0'; ++text) {
+    if (*text == '\n') {
+      x = x0;
+      y += atlasp->line_height;
+      continue;
+    }
+    index = dma2dAtlasLookup(atlasp, (uint8_t)*text);
+    if (index == DMA2D_ATLAS_NO_ENTRY)
+      continue;
+    entryp = &atlasp->entriesp[index];
+    if ((entryp->width > 0) && (entryp->height > 0))
+      atlas_blit_s(arp, surfacep, atlasp, entryp,
+                   x + entryp->xoff, y + entryp->yoff);
+    x += entryp->advance;
+  }
+  return x;
+}
+
+/**
+ * @brief   Draws a text.
+ * @details Blends a run of glyphs onto the surface. The layers are set up
+ *          once for the whole run, then one blending job per visible glyph
+ *          is executed. A <tt>'\\n'</tt> moves the pen to the next line.
+ * @pre     DMA2D is ready.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ * @param[in] surfacep  pointer to the destination surface
+ * @param[in] atlasp    pointer to the font atlas
+ * @param[in] text      zero-terminated text
+ * @param[in] x         horizontal coordinate of the pen
+ * @param[in] y         vertical coordinate of the pen, top of the line
+ * @param[in] c         color and opacity, ARGB-8888
+ *
+ * @return              The horizontal coordinate of the pen after the text.
+ *
+ * @api
+ */
+int dma2dAtlasDrawText(DMA2DAtlasRenderer *arp,
+                       const dma2d_surface_t *surfacep,
+                       const dma2d_atlas_t *atlasp, const char *text,
+                       int x, int y, dma2d_color_t c) {
+
+  int pen;
+  chSysLock();
+  pen = dma2dAtlasDrawTextS(arp, surfacep, atlasp, text, x, y, c);
+  chSysUnlock();
+  return pen;
+}
+
+/** @} */
+
+#endif  /* STM32_DMA2D_USE_DMA2D */
@@ -0,0 +1,179 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_stm32_dma2d_atlas.h
+ * @brief   DMA2D glyph and sprite atlas renderer.
+ * @details Draws glyphs and sprites packed into indexed (L-4, L-8) or
+ *          alpha-only (A-4, A-8) atlases, blending them onto a surface with
+ *          the DMA2D. Atlases are generated offline by
+ *          <tt>tools/dma2d_atlas.py</tt>.
+ *
+ * @addtogroup dma2d_atlas
+ * @{
+ */
+
+#ifndef HAL_STM32_DMA2D_ATLAS_H_
+#define HAL_STM32_DMA2D_ATLAS_H_
+
+#include "hal_stm32_dma2d.h"
+
+#if (TRUE == STM32_DMA2D_USE_DMA2D) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Invalid atlas entry index.
+ */
+#define DMA2D_ATLAS_NO_ENTRY            (0xFFFF)
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    DMA2D atlas data types
+ * @{
+ */
+
+/**
+ * @brief   Atlas entry (glyph or sprite).
+ * @note    For 4-bit atlas formats, @p x and @p width are always even.
+ */
+typedef struct dma2d_atlas_entry_t {
+  uint16_t          x;                /**< Horizontal position in the atlas.*/
+  uint16_t          y;                /**< Vertical position in the atlas.*/
+  uint8_t           width;            /**< Width, in pixels.*/
+  uint8_t           height;           /**< Height, in pixels.*/
+  int8_t            xoff;             /**< Horizontal bearing from the pen.*/
+  int8_t            yoff;             /**< Vertical bearing from the top.*/
+  uint8_t           advance;          /**< Pen advance, in pixels.*/
+} dma2d_atlas_entry_t;
+
+/**
+ * @brief   Atlas specifications.
+ * @details The atlas pixels are stored as one bitmap of @p width by
+ *          @p height pixels, in one of the compact input formats:
+ *          - @p DMA2D_FMT_A4 or @p DMA2D_FMT_A8 for glyphs, colored at
+ *            drawing time;
+ *          - @p DMA2D_FMT_L4 or @p DMA2D_FMT_L8 for sprites, colored by the
+ *            atlas palette.
+ */
+typedef struct dma2d_atlas_t {
+  const void                *pixelsp; /**< Atlas bitmap.*/
+  uint16_t                  width;    /**< Bitmap width, in pixels.*/
+  uint16_t                  height;   /**< Bitmap height, in pixels.*/
+  dma2d_pixfmt_t            fmt;      /**< Bitmap pixel format.*/
+  const dma2d_palcfg_t      *palettep;/**< Palette for L-4/L-8, or @p NULL.*/
+  const dma2d_atlas_entry_t *entriesp;/**< Entry table.*/
+  uint16_t                  count;    /**< Number of entries.*/
+  uint16_t                  first;    /**< Character code of entry 0.*/
+  uint16_t                  fallback; /**< Entry for unmapped characters.*/
+  uint8_t                   line_height; /**< Line height, in pixels.*/
+} dma2d_atlas_t;
+
+/**
+ * @brief   Drawing surface specifications.
+ */
+typedef struct dma2d_surface_t {
+  void              *bufferp;         /**< Frame buffer address.*/
+  size_t            pitch;            /**< Line pitch, in bytes.*/
+  uint16_t          width;            /**< Width, in pixels.*/
+  uint16_t          height;           /**< Height, in pixels.*/
+  dma2d_pixfmt_t    fmt;              /**< Pixel format, output capable.*/
+} dma2d_surface_t;
+
+/**
+ * @brief   Atlas renderer object.
+ * @details Tracks the foreground palette last loaded into the DMA2D CLUT, so
+ *          that consecutive draws from the same atlas do not reload it.
+ */
+typedef struct DMA2DAtlasRenderer {
+  DMA2DDriver       *dma2dp;          /**< Associated DMA2D driver.*/
+  const void        *clut_colorsp;    /**< Cached CLUT source, or @p NULL.*/
+  uint16_t          clut_length;      /**< Cached CLUT length.*/
+  dma2d_pixfmt_t    clut_fmt;         /**< Cached CLUT format.*/
+  uint32_t          clut_loads;       /**< Number of CLUT transfers done.*/
+} DMA2DAtlasRenderer;
+
+/** @} */
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Invalidates the CLUT cache.
+ * @details Must be called whenever the foreground palette is loaded by other
+ *          means than the atlas renderer, or when the contents of a cached
+ *          palette are modified in place.
+ *
+ * @param[in] arp       pointer to the @p DMA2DAtlasRenderer object
+ *
+ * @iclass
+ */
+#define dma2dAtlasInvalidateI(arp)                                          \
+  do {                                                                      \
+    (arp)->clut_colorsp = NULL;                                             \
+  } while (false)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dma2dAtlasObjectInit(DMA2DAtlasRenderer *arp, DMA2DDriver *dma2dp);
+  bool dma2dAtlasLoadPaletteS(DMA2DAtlasRenderer *arp,
+                              const dma2d_palcfg_t *palettep);
+  uint16_t dma2dAtlasLookup(const dma2d_atlas_t *atlasp, uint16_t code);
+  uint16_t dma2dAtlasTextWidth(const dma2d_atlas_t *atlasp, const char *text);
+  void dma2dAtlasDrawEntryS(DMA2DAtlasRenderer *arp,
+                            const dma2d_surface_t *surfacep,
+                            const dma2d_atlas_t *atlasp, uint16_t index,
+                            int x, int y, dma2d_color_t c);
+  void dma2dAtlasDrawEntry(DMA2DAtlasRenderer *arp,
+                           const dma2d_surface_t *surfacep,
+                           const dma2d_atlas_t *atlasp, uint16_t index,
+                           int x, int y, dma2d_color_t c);
+  int dma2dAtlasDrawTextS(DMA2DAtlasRenderer *arp,
+                          const dma2d_surface_t *surfacep,
+                          const dma2d_atlas_t *atlasp, const char *text,
+                          int x, int y, dma2d_color_t c);
+  int dma2dAtlasDrawText(DMA2DAtlasRenderer *arp,
+                         const dma2d_surface_t *surfacep,
+                         const dma2d_atlas_t *atlasp, const char *text,
+                         int x, int y, dma2d_color_t c);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* STM32_DMA2D_USE_DMA2D */
+
+#endif  /* HAL_STM32_DMA2D_ATLAS_H_ */
+
+/** @} */
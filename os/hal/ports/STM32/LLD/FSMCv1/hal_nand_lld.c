@@ -159,6 +159,101 @@ static uint32_t calc_eccps(NANDDriver *nandp) {
   return i << 17;
 }
 
+/**
+ * @brief   Moves the address to the next page.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void next_page_addr(NANDDriver *nandp) {
+  size_t i;
+
+  for (i = nandp->config->colcycles; i < nandp->addrlen; i++) {
+    nandp->addr[i]++;
+    if (nandp->addr[i] != 0)
+      break;
+  }
+}
+
+/**
+ * @brief   Starts the ECC computation, if requested.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void ecc_start(NANDDriver *nandp) {
+
+  if (NULL != nandp->ecc){
+    nandp->nand->PCR |= FSMC_PCR_ECCEN;
+  }
+}
+
+/**
+ * @brief   Stores the ECC of the page just transferred.
+ * @details The computation is stopped, it is restarted with the next page
+ *          data transfer.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void ecc_store(NANDDriver *nandp) {
+
+  if (NULL != nandp->ecc){
+    while (! (nandp->nand->SR & FSMC_SR_FEMPT))
+      ;
+    *nandp->ecc++ = nandp->nand->ECCR;
+    nandp->nand->PCR &= ~FSMC_PCR_ECCEN;
+  }
+}
+
+/**
+ * @brief   Starts reading the current page from the memory array.
+ * @details The ready interrupt follows when the page is loaded.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void read_start(NANDDriver *nandp) {
+
+  nandp->state = NAND_READ;
+  set_16bit_bus(nandp);
+  nand_lld_write_cmd(nandp, NAND_CMD_READ0);
+  nand_lld_write_addr(nandp, nandp->addr, nandp->addrlen);
+  nand_lld_write_cmd(nandp, NAND_CMD_READ0_CONFIRM);
+  set_8bit_bus(nandp);
+}
+
+/**
+ * @brief   Moves the loaded page to the cache register.
+ * @details Unless it is the last one, the next page is loaded from the
+ *          memory array while the cache register is read out.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void read_cache_next(NANDDriver *nandp) {
+
+  nandp->state = NAND_READ;
+  set_16bit_bus(nandp);
+  nand_lld_write_cmd(nandp, nandp->pages > 1 ? NAND_CMD_READ_CACHE :
+                                               NAND_CMD_READ_CACHE_END);
+  set_8bit_bus(nandp);
+}
+
+/**
+ * @brief   Starts writing the current page to the NAND buffer.
+ * @details The DMA end interrupt follows when the data has been moved.
+ *
+ * @param[in] nandp    pointer to the @p NANDDriver object
+ */
+static void write_start(NANDDriver *nandp) {
+
+  nandp->state = NAND_DMA_TX;
+  set_16bit_bus(nandp);
+  nand_lld_write_cmd(nandp, NAND_CMD_WRITE);
+  nand_lld_write_addr(nandp, nandp->addr, nandp->addrlen);
+  set_8bit_bus(nandp);
+
+  ecc_start(nandp);
+  dmaStartMemCopy(nandp->dma, nandp->dmamode, nandp->txdata, nandp->map_data,
+                  nandp->datalen/AHB_TRANSACTION_WIDTH);
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -205,14 +300,35 @@ static void nand_isr_handler(NANDDriver *nandp) {
 
   switch (nandp->state){
   case NAND_READ:
+    if (nandp->cache_pending) {
+      /* First page loaded, cache read can start.*/
+      nandp->cache_pending = false;
+      read_cache_next(nandp);
+      break;
+    }
     nandp->state = NAND_DMA_RX;
+    ecc_start(nandp);
     dmaStartMemCopy(nandp->dma, nandp->dmamode, nandp->map_data, nandp->rxdata,
                     nandp->datalen/AHB_TRANSACTION_WIDTH);
     /* thread will be waked up from DMA ISR */
     break;
 
-  case NAND_ERASE:      /* NAND reports about erase finish */
   case NAND_PROGRAM:    /* NAND reports about page programming finish */
+    if (nandp->pages > 0) {
+      /* Next page of a multi-page write, with cache program the previous
+         page is still being programmed.*/
+      nandp->status |= nand_lld_read_status(nandp) &
+                       (NAND_STATUS_FAIL | NAND_STATUS_FAILC);
+      nandp->txdata = (const uint8_t *)nandp->txdata + nandp->datalen;
+      next_page_addr(nandp);
+      write_start(nandp);
+      break;
+    }
+    nandp->state = NAND_READY;
+    wakeup_isr(nandp);
+    break;
+
+  case NAND_ERASE:      /* NAND reports about erase finish */
   case NAND_RESET:      /* NAND reports about finished reset recover */
     nandp->state = NAND_READY;
     wakeup_isr(nandp);
@@ -249,12 +365,32 @@ static void nand_lld_serve_transfer_end_irq(NANDDriver *nandp, uint32_t flags) {
 
   switch (nandp->state){
   case NAND_DMA_TX:
+    nandp->pages--;
+    ecc_store(nandp);
     nandp->state = NAND_PROGRAM;
-    nandp->map_cmd[0] = NAND_CMD_PAGEPROG;
+    if ((nandp->pages > 0) && nandp->cache)
+      nandp->map_cmd[0] = NAND_CMD_CACHEPROG;
+    else
+      nandp->map_cmd[0] = NAND_CMD_PAGEPROG;
     /* thread will be woken up from ready_isr() */
     break;
 
   case NAND_DMA_RX:
+    nandp->pages--;
+    ecc_store(nandp);
+    if (nandp->pages > 0) {
+      /* Next page of a multi-page read, the ECC has been collected before
+         issuing the next command.*/
+      nandp->rxdata = (uint8_t *)nandp->rxdata + nandp->datalen;
+      if (nandp->cache) {
+        read_cache_next(nandp);
+      }
+      else {
+        next_page_addr(nandp);
+        read_start(nandp);
+      }
+      break;
+    }
     nandp->state = NAND_READY;
     nandp->rxdata = NULL;
     nandp->datalen = 0;
@@ -286,7 +422,12 @@ void nand_lld_init(void) {
   /* Driver initialization.*/
   nandObjectInit(&NANDD1);
   NANDD1.rxdata   = NULL;
+  NANDD1.txdata   = NULL;
   NANDD1.datalen  = 0;
+  NANDD1.pages    = 0;
+  NANDD1.cache    = false;
+  NANDD1.cache_pending = false;
+  NANDD1.ecc      = NULL;
   NANDD1.thread   = NULL;
   NANDD1.dma      = STM32_DMA_STREAM(STM32_NAND_DMA_STREAM);
   NANDD1.nand     = FSMCD1.nand1;
@@ -300,7 +441,12 @@ void nand_lld_init(void) {
   /* Driver initialization.*/
   nandObjectInit(&NANDD2);
   NANDD2.rxdata   = NULL;
+  NANDD2.txdata   = NULL;
   NANDD2.datalen  = 0;
+  NANDD2.pages    = 0;
+  NANDD2.cache    = false;
+  NANDD2.cache_pending = false;
+  NANDD2.ecc      = NULL;
   NANDD2.thread   = NULL;
   NANDD2.dma      = STM32_DMA_STREAM(STM32_NAND_DMA_STREAM);
   NANDD2.nand     = FSMCD1.nand2;
@@ -399,39 +545,52 @@ void nand_lld_stop(NANDDriver *nandp) {
 void nand_lld_read_data(NANDDriver *nandp, uint16_t *data, size_t datalen,
                         uint8_t *addr, size_t addrlen, uint32_t *ecc){
 
+  nand_lld_read_pages(nandp, data, datalen, 1, addr, addrlen, ecc);
+}
+
+/**
+ * @brief   Read consecutive pages from NAND.
+ * @details The whole sequence runs from the ready and DMA interrupts, the
+ *          thread is woken up once at the end.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[out] data         pointer to data buffer
+ * @param[in] datalen       size of data per page in bytes
+ * @param[in] npages        number of pages
+ * @param[in] addr          pointer to address buffer of the first page
+ * @param[in] addrlen       length of address
+ * @param[out] ecc          pointer to store computed ECC, one per page.
+ *                          Ignored when NULL.
+ *
+ * @notapi
+ */
+void nand_lld_read_pages(NANDDriver *nandp, uint16_t *data, size_t datalen,
+                size_t npages, uint8_t *addr, size_t addrlen, uint32_t *ecc) {
+
   align_check(data, datalen);
+  osalDbgAssert((nandp->nand->PCR & FSMC_PCR_ECCEN) == 0,
+          "State machine broken. ECCEN must be previously disabled.");
 
-  nandp->state = NAND_READ;
-  nandp->rxdata = data;
+  nandp->rxdata  = data;
   nandp->datalen = datalen;
-
-  set_16bit_bus(nandp);
-  nand_lld_write_cmd(nandp, NAND_CMD_READ0);
-  nand_lld_write_addr(nandp, addr, addrlen);
-  osalSysLock();
-  nand_lld_write_cmd(nandp, NAND_CMD_READ0_CONFIRM);
-  set_8bit_bus(nandp);
+  nandp->pages   = npages;
+  nandp->addr    = addr;
+  nandp->addrlen = addrlen;
+  nandp->ecc     = ecc;
+  nandp->cache   = (npages > 1) &&
+                   ((nandp->config->features & NAND_FEATURE_CACHE_READ) != 0);
+  nandp->cache_pending = nandp->cache;
 
   /* Here NAND asserts busy signal and starts transferring from memory
      array to page buffer. After the end of transmission ready_isr functions
      starts DMA transfer from page buffer to MCU's RAM.*/
-  osalDbgAssert((nandp->nand->PCR & FSMC_PCR_ECCEN) == 0,
-          "State machine broken. ECCEN must be previously disabled.");
-
-  if (NULL != ecc){
-    nandp->nand->PCR |= FSMC_PCR_ECCEN;
-  }
-
+  osalSysLock();
+  read_start(nandp);
   nand_lld_suspend_thread(nandp);
   osalSysUnlock();
 
   /* thread was woken up from DMA ISR */
-  if (NULL != ecc){
-    while (! (nandp->nand->SR & FSMC_SR_FEMPT))
-      ;
-    *ecc = nandp->nand->ECCR;
-    nandp->nand->PCR &= ~FSMC_PCR_ECCEN;
-  }
+  nandp->ecc = NULL;
 }
 
 /**
@@ -451,40 +610,63 @@ void nand_lld_read_data(NANDDriver *nandp, uint16_t *data, size_t datalen,
 uint8_t nand_lld_write_data(NANDDriver *nandp, const uint16_t *data,
                 size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc) {
 
-  align_check(data, datalen);
+  return nand_lld_write_pages(nandp, data, datalen, 1, addr, addrlen, ecc);
+}
 
-  nandp->state = NAND_WRITE;
+/**
+ * @brief   Write consecutive pages to NAND.
+ * @details The whole sequence runs from the ready and DMA interrupts, the
+ *          thread is woken up once at the end.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] data          buffer with data to be written
+ * @param[in] datalen       size of data per page in bytes
+ * @param[in] npages        number of pages
+ * @param[in] addr          pointer to address buffer of the first page
+ * @param[in] addrlen       length of address
+ * @param[out] ecc          pointer to store computed ECC, one per page.
+ *                          Ignored when NULL.
+ *
+ * @return    The operation status reported by NAND IC (0x70 command), with
+ *            @p NAND_STATUS_FAIL also set if an intermediate page failed.
+ *
+ * @notapi
+ */
+uint8_t nand_lld_write_pages(NANDDriver *nandp, const uint16_t *data,
+                size_t datalen, size_t npages, uint8_t *addr, size_t addrlen,
+                uint32_t *ecc) {
 
-  set_16bit_bus(nandp);
-  nand_lld_write_cmd(nandp, NAND_CMD_WRITE);
-  osalSysLock();
-  nand_lld_write_addr(nandp, addr, addrlen);
-  set_8bit_bus(nandp);
+  uint8_t status;
 
-  /* Now start DMA transfer to NAND buffer and put thread in sleep state.
-     Tread will be woken up from ready ISR. */
-  nandp->state = NAND_DMA_TX;
+  align_check(data, datalen);
   osalDbgAssert((nandp->nand->PCR & FSMC_PCR_ECCEN) == 0,
           "State machine broken. ECCEN must be previously disabled.");
 
-  if (NULL != ecc){
-    nandp->nand->PCR |= FSMC_PCR_ECCEN;
-  }
-
-  dmaStartMemCopy(nandp->dma, nandp->dmamode, data, nandp->map_data,
-                  datalen/AHB_TRANSACTION_WIDTH);
+  nandp->txdata  = data;
+  nandp->datalen = datalen;
+  nandp->pages   = npages;
+  nandp->addr    = addr;
+  nandp->addrlen = addrlen;
+  nandp->ecc     = ecc;
+  nandp->status  = 0;
+  nandp->cache   = (npages > 1) &&
+                   ((nandp->config->features & NAND_FEATURE_CACHE_PROGRAM) != 0);
 
+  /* Now start DMA transfer to NAND buffer and put thread in sleep state.
+     Tread will be woken up from ready ISR after the last page. */
+  osalSysLock();
+  write_start(nandp);
   nand_lld_suspend_thread(nandp);
   osalSysUnlock();
 
-  if (NULL != ecc){
-    while (! (nandp->nand->SR & FSMC_SR_FEMPT))
-      ;
-    *ecc = nandp->nand->ECCR;
-    nandp->nand->PCR &= ~FSMC_PCR_ECCEN;
-  }
+  nandp->ecc = NULL;
+  nandp->txdata = NULL;
 
-  return nand_lld_read_status(nandp);
+  status = nand_lld_read_status(nandp);
+  if (nandp->status != 0)
+    status |= NAND_STATUS_FAIL;
+
+  return status;
 }
 
 /**
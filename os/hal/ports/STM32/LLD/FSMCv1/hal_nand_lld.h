@@ -177,6 +177,12 @@ typedef struct {
    *          from STMicroelectronics.
    */
   uint32_t                  pmem;
+  /**
+   * @brief   Optional device features, @p NAND_FEATURE_xxx mask.
+   * @details Cache read and cache program are used by the multi-page
+   *          operations.
+   */
+  uint32_t                  features;
 } NANDConfig;
 
 /**
@@ -213,10 +219,42 @@ struct NANDDriver {
    * @brief   Pointer to current transaction buffer.
    */
   void                      *rxdata;
+  /**
+   * @brief   Pointer to current transaction buffer for writes.
+   */
+  const void                *txdata;
   /**
    * @brief   Current transaction length in bytes.
    */
   size_t                    datalen;
+  /**
+   * @brief   Pages left in the current multi-page transaction.
+   */
+  size_t                    pages;
+  /**
+   * @brief   Address of the current page.
+   */
+  uint8_t                   *addr;
+  /**
+   * @brief   Address length.
+   */
+  size_t                    addrlen;
+  /**
+   * @brief   Where to store the ECC of the current page or @p NULL.
+   */
+  uint32_t                  *ecc;
+  /**
+   * @brief   Fail bits collected from the intermediate pages.
+   */
+  uint8_t                   status;
+  /**
+   * @brief   Cache operation in progress.
+   */
+  bool                      cache;
+  /**
+   * @brief   Cache read waiting for the first page to be loaded.
+   */
+  bool                      cache_pending;
   /**
    * @brief DMA mode bit mask.
    */
@@ -250,6 +288,17 @@ struct NANDDriver {
    * @details One bit per block. All memory allocation is user's responsibility.
    */
   bitmap_t                  *bb_map;
+#if NAND_USE_BBT || defined(__DOXYGEN__)
+  /**
+   * @brief   Version of the last bad block table loaded or stored.
+   */
+  uint32_t                  bbt_version;
+  /**
+   * @brief   Bad blocks among the table reserved blocks, bit 0 is the
+   *          last block of the device.
+   */
+  uint32_t                  bbt_bad;
+#endif /* NAND_USE_BBT */
 };
 
 /*===========================================================================*/
@@ -277,10 +326,15 @@ extern "C" {
   uint8_t nand_lld_erase(NANDDriver *nandp, uint8_t *addr, size_t addrlen);
   void nand_lld_read_data(NANDDriver *nandp, uint16_t *data,
                 size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc);
+  void nand_lld_read_pages(NANDDriver *nandp, uint16_t *data, size_t datalen,
+                size_t npages, uint8_t *addr, size_t addrlen, uint32_t *ecc);
   void nand_lld_write_addr(NANDDriver *nandp, const uint8_t *addr, size_t len);
   void nand_lld_write_cmd(NANDDriver *nandp, uint8_t cmd);
   uint8_t nand_lld_write_data(NANDDriver *nandp, const uint16_t *data,
                 size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc);
+  uint8_t nand_lld_write_pages(NANDDriver *nandp, const uint16_t *data,
+                size_t datalen, size_t npages, uint8_t *addr, size_t addrlen,
+                uint32_t *ecc);
   uint8_t nand_lld_read_status(NANDDriver *nandp);
   void nand_lld_reset(NANDDriver *nandp);
 #ifdef __cplusplus
@@ -1,2 +1,8 @@
 PLATFORMSRC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/LTDCv1/hal_stm32_ltdc.c
 PLATFORMINC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/STM32/LLD/LTDCv1
+
+# Pixel format library, shared with the DMA2D driver.
+ifeq ($(HALSRC_PIXFMT),)
+HALSRC_PIXFMT := ${CHIBIOS_CONTRIB}/os/hal/src/hal_pixfmt.c
+PLATFORMSRC_CONTRIB += $(HALSRC_PIXFMT)
+endif
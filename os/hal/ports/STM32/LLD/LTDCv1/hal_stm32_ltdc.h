@@ -25,6 +25,8 @@
 #ifndef HAL_STM32_LTDC_H_
 #define HAL_STM32_LTDC_H_
 
+#include "hal_pixfmt.h"
+
 /**
  * @brief   Using the LTDC driver.
  */
@@ -269,6 +271,17 @@
 #error "LTDC not present in the selected device"
 #endif
 
+#if (LTDC_FMT_ARGB8888 != PIXFMT_ARGB8888) || \
+    (LTDC_FMT_RGB888 != PIXFMT_RGB888) || \
+    (LTDC_FMT_RGB565 != PIXFMT_RGB565) || \
+    (LTDC_FMT_ARGB1555 != PIXFMT_ARGB1555) || \
+    (LTDC_FMT_ARGB4444 != PIXFMT_ARGB4444) || \
+    (LTDC_FMT_L8 != PIXFMT_L8) || \
+    (LTDC_FMT_AL44 != PIXFMT_AL44) || \
+    (LTDC_FMT_AL88 != PIXFMT_AL88)
+#error "LTDC pixel formats do not match hal_pixfmt.h"
+#endif
+
 #if (TRUE == LTDC_USE_MUTUAL_EXCLUSION)
 #if (TRUE != CH_CFG_USE_MUTEXES) && (TRUE != CH_CFG_USE_SEMAPHORES)
 #error "LTDC_USE_MUTUAL_EXCLUSION requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
@@ -723,6 +736,8 @@ extern "C" {
 #if (TRUE == LTDC_USE_SOFTWARE_CONVERSIONS) || defined(__DOXYGEN__)
   ltdc_color_t ltdcFromARGB8888(ltdc_color_t c, ltdc_pixfmt_t fmt);
   ltdc_color_t ltdcToARGB8888(ltdc_color_t c, ltdc_pixfmt_t fmt);
+  void ltdcConvertSpan(const void *srcp, ltdc_pixfmt_t srcfmt,
+                       void *dstp, ltdc_pixfmt_t dstfmt, size_t n);
 #endif  /* LTDC_USE_SOFTWARE_CONVERSIONS */
 
 #ifdef __cplusplus
@@ -379,6 +379,82 @@ static void eicu_lld_serve_interrupt(EICUDriver *eicup) {
     eicu_isr_invoke_cb(eicup, EICU_CHANNEL_4);
 }
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Capture DMA streams ISR service routine.
+ * @details Counts the half ring transfers, the captured edges are decoded
+ *          later by @p eicuReadCaptures().
+ *
+ * @param[in] chp       pointer to the @p EICUChannel object
+ * @param[in] flags     pre-shifted content of the ISR register
+ *
+ * @notapi
+ */
+static void eicu_lld_serve_dma_interrupt(EICUChannel *chp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+  if ((flags & STM32_DMA_ISR_TEIF) != 0) {
+    STM32_EICU_DMA_ERROR_HOOK(chp);
+  }
+  if ((flags & STM32_DMA_ISR_HTIF) != 0)
+    chp->halves++;
+  if ((flags & STM32_DMA_ISR_TCIF) != 0)
+    chp->halves++;
+}
+
+/**
+ * @brief   Allocates the capture DMA streams.
+ * @note    In @p EICU_INPUT_PULSE and @p EICU_INPUT_BOTH modes the polarity
+ *          cannot be inverted on each edge, both edges are captured instead.
+ *          This requires the CCxNP bits, not available on STM32F1.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ */
+static void start_dma_channels(EICUDriver *eicup) {
+  size_t ch;
+
+  for (ch = 0; ch < EICU_CHANNEL_ENUM_END; ch++) {
+    EICUChannel *chp = &eicup->channel[ch];
+    const EICUChannelConfig *ccp = chp->config;
+    bool b;
+
+    /* Streams of a previous configuration.*/
+    if (chp->dma != NULL) {
+      dmaStreamRelease(chp->dma);
+      chp->dma = NULL;
+    }
+    if ((ccp == NULL) || (ccp->dma_buf == NULL))
+      continue;
+
+    osalDbgAssert((ccp->mode == EICU_INPUT_EDGE) ||
+                  (STM32_EICU_HAS_BOTH_EDGES == TRUE),
+                  "both edges capture not supported");
+
+    osalDbgCheck((ccp->dma_depth >= 4U) && (ccp->dma_depth <= 0x8000U) &&
+                 ((ccp->dma_depth & (ccp->dma_depth - 1U)) == 0U));
+
+    chp->dma = STM32_DMA_STREAM(ccp->dma_stream);
+    b = dmaStreamAllocate(chp->dma,
+                          STM32_EICU_DMA_IRQ_PRIORITY,
+                          (stm32_dmaisr_t)eicu_lld_serve_dma_interrupt,
+                          (void *)chp);
+    osalDbgAssert(!b, "stream already allocated");
+
+    chp->dmamode = STM32_DMA_CR_CHSEL(ccp->dma_channel) |
+                   STM32_DMA_CR_PL(STM32_EICU_DMA_PRIORITY) |
+                   STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                   STM32_DMA_CR_CIRC | STM32_DMA_CR_PSIZE_WORD |
+                   STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_HTIE |
+                   STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE;
+    dmaStreamSetPeripheral(chp->dma, chp->ccrp);
+
+    if (ccp->mode != EICU_INPUT_EDGE)
+      eicup->tim->CCER |= (STM32_TIM_CCER_CC1P | STM32_TIM_CCER_CC1NP) <<
+                          (ch * 4);
+  }
+}
+#endif /* EICU_USE_DMA == TRUE */
+
 /**
  * @brief   Starts every channel.
  *
@@ -1035,6 +1111,9 @@ void eicu_lld_start(EICUDriver *eicup) {
   }
 
   start_channels(eicup);
+#if EICU_USE_DMA == TRUE
+  start_dma_channels(eicup);
+#endif
 }
 
 /**
@@ -1053,6 +1132,15 @@ void eicu_lld_stop(EICUDriver *eicup) {
     eicup->tim->DIER = 0;                     /* All IRQs disabled.           */
     eicup->tim->SR   = 0;                     /* Clear eventual pending IRQs. */
 
+#if EICU_USE_DMA == TRUE
+    for (size_t ch = 0; ch < EICU_CHANNEL_ENUM_END; ch++) {
+      if (eicup->channel[ch].dma != NULL) {
+        dmaStreamRelease(eicup->channel[ch].dma);
+        eicup->channel[ch].dma = NULL;
+      }
+    }
+#endif
+
 #if STM32_EICU_USE_TIM1
     if (&EICUD1 == eicup) {
       nvicDisableVector(STM32_TIM1_UP_NUMBER);
@@ -1155,6 +1243,26 @@ void eicu_lld_enable(EICUDriver *eicup) {
       (eicup->config->iccfgp[EICU_CHANNEL_4]->capture_cb != NULL))
     eicup->tim->DIER |= STM32_TIM_DIER_CC4IE;
 
+#if EICU_USE_DMA == TRUE
+  /* Capture ring channels, DMA requests instead of interrupts.*/
+  for (size_t ch = 0; ch < EICU_CHANNEL_ENUM_END; ch++) {
+    EICUChannel *chp = &eicup->channel[ch];
+
+    if (chp->dma == NULL)
+      continue;
+    chp->halves = 0;
+    chp->rdpos  = 0;
+    chp->lost   = 0;
+    eicuDecoderInit(&chp->decoder, chp->config->mode, eicup->width);
+    dmaStreamSetMemory0(chp->dma, chp->config->dma_buf);
+    dmaStreamSetTransactionSize(chp->dma, chp->config->dma_depth);
+    dmaStreamSetMode(chp->dma, chp->dmamode);
+    dmaStreamEnable(chp->dma);
+    eicup->tim->DIER = (eicup->tim->DIER & ~(STM32_TIM_DIER_CC1IE << ch)) |
+                       (STM32_TIM_DIER_CC1DE << ch);
+  }
+#endif
+
   eicup->tim->CR1 = STM32_TIM_CR1_URS | STM32_TIM_CR1_CEN;
 }
 
@@ -1171,6 +1279,42 @@ void eicu_lld_disable(EICUDriver *eicup) {
 
   /* All interrupts disabled.*/
   eicup->tim->DIER &= ~STM32_TIM_DIER_IRQ_MASK;
+
+#if EICU_USE_DMA == TRUE
+  /* Capture DMA stopped, the captured edges can still be read.*/
+  for (size_t ch = 0; ch < EICU_CHANNEL_ENUM_END; ch++) {
+    if (eicup->channel[ch].dma != NULL) {
+      eicup->tim->DIER &= ~(STM32_TIM_DIER_CC1DE << ch);
+      dmaStreamDisable(eicup->channel[ch].dma);
+    }
+  }
+#endif
+}
+
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of edges captured by DMA on a channel.
+ * @details The count is modulo 2^32, the ring index of the next edge is
+ *          the count modulo the ring depth. A half transfer not yet served
+ *          by the DMA ISR is detected from the stream position.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] channel   EICU channel, configured with a capture ring
+ * @return              The number of captured edges.
+ *
+ * @notapi
+ */
+uint32_t eicu_lld_get_captured(EICUDriver *eicup, eicuchannel_t channel) {
+  const EICUChannel *chp = &eicup->channel[channel];
+  uint32_t depth = (uint32_t)chp->config->dma_depth;
+  uint32_t pos = depth - (uint32_t)dmaStreamGetTransactionSize(chp->dma);
+  uint32_t halves = chp->halves;
+
+  if (((halves & 1U) != 0U) != (pos >= (depth / 2U)))
+    halves++;
+
+  return ((halves / 2U) * depth) + pos;
 }
+#endif /* EICU_USE_DMA == TRUE */
 
 #endif /* HAL_USE_EICU */
@@ -33,6 +33,22 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   This driver supports the DMA capture mode.
+ */
+#define EICU_SUPPORTS_DMA                    TRUE
+
+/**
+ * @brief   The timers can capture on both edges (CCxP and CCxNP set).
+ * @note    The STM32F1 timers have no CCxNP bits, there the DMA capture
+ *          ring can only be used in @p EICU_INPUT_EDGE mode.
+ */
+#if defined(STM32F1XX) || defined(__DOXYGEN__)
+#define STM32_EICU_HAS_BOTH_EDGES            FALSE
+#else
+#define STM32_EICU_HAS_BOTH_EDGES            TRUE
+#endif
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -196,6 +212,29 @@
 #if !defined(STM32_EICU_TIM14_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_EICU_TIM14_IRQ_PRIORITY         7
 #endif
+
+/**
+ * @brief   Capture DMA streams priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_EICU_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_PRIORITY              2
+#endif
+
+/**
+ * @brief   Capture DMA streams interrupt priority level setting.
+ */
+#if !defined(STM32_EICU_DMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_IRQ_PRIORITY          7
+#endif
+
+/**
+ * @brief   Capture DMA error hook.
+ * @note    The default action for DMA errors is a system halt because DMA
+ *          error can only happen because programming errors.
+ */
+#if !defined(STM32_EICU_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_ERROR_HOOK(chp)       osalSysHalt("DMA failure")
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -319,6 +358,20 @@
 #error "Invalid IRQ priority assigned to TIM14"
 #endif
 
+#if EICU_USE_DMA == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_EICU_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to EICU"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_EICU_DMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to EICU DMA"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* EICU_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -400,6 +453,31 @@ typedef struct {
    *          pulse period capture event.
    */
   eicucallback_t          capture_cb;
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Capture ring, @p NULL for interrupt driven capture.
+   * @details When set the captured counter values are stored by DMA in a
+   *          circular buffer and decoded by @p eicuReadCaptures(), the
+   *          callback is not invoked.
+   * @note    In @p EICU_INPUT_PULSE and @p EICU_INPUT_BOTH modes both edges
+   *          are captured, the input must be idle when the driver is
+   *          enabled.
+   */
+  eicucnt_t               *dma_buf;
+  /**
+   * @brief   Capture ring size in samples, a power of two.
+   */
+  size_t                  dma_depth;
+  /**
+   * @brief   DMA stream serving the channel request, see
+   *          @p STM32_DMA_STREAM_ID().
+   */
+  uint32_t                dma_stream;
+  /**
+   * @brief   DMA channel (request) selection of the stream.
+   */
+  uint32_t                dma_channel;
+#endif
 } EICUChannelConfig;
 
 /** 
@@ -426,6 +504,32 @@ typedef struct {
    * @brief   CCR register pointer for faster access.
    */
   volatile uint32_t       *ccrp;
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Capture DMA stream, @p NULL if unused.
+   */
+  const stm32_dma_stream_t *dma;
+  /**
+   * @brief   Capture DMA mode bit mask.
+   */
+  uint32_t                dmamode;
+  /**
+   * @brief   Half ring transfers completed by the DMA.
+   */
+  volatile uint32_t       halves;
+  /**
+   * @brief   Captured edges already read.
+   */
+  uint32_t                rdpos;
+  /**
+   * @brief   Captured edges lost because of ring overruns.
+   */
+  uint32_t                lost;
+  /**
+   * @brief   Decoder of the captured edges.
+   */
+  eicudecoder_t           decoder;
+#endif
 } EICUChannel;
 
 /**
@@ -545,6 +649,9 @@ extern "C" {
   void eicu_lld_stop(EICUDriver *eicup);
   void eicu_lld_enable(EICUDriver *eicup);
   void eicu_lld_disable(EICUDriver *eicup);
+#if EICU_USE_DMA == TRUE
+  uint32_t eicu_lld_get_captured(EICUDriver *eicup, eicuchannel_t channel);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -59,19 +59,26 @@ ADCDriver ADCD2;
  */
 static void serve_interrupt(ADCDriver *adcp)
 {
-  tiva_udma_table_entry_t *pri = &udmaControlTable.primary[adcp->dmanr];
   tiva_udma_table_entry_t *alt = &udmaControlTable.alternate[adcp->dmanr];
 
-  if ((pri->chctl & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP) {
-    /* Primary is used only for circular transfers */
-    if (adcp->grpp->circular) {
-      if (adcp->depth > 1) {
-        _adc_isr_half_code(adcp);
-      }
-
-      /* Reconfigure DMA for new lower half transfer */
-      pri->chctl = adcp->prictl;
+  if ((adcp->grpp->circular) && (adcp->depth > 1)) {
+    /* Ping-pong transfer, the completed halves are re-armed before being
+       reported so the sampling never stalls.*/
+    uint32_t done = udmaPingPongServe(adcp->dmanr);
+
+    if (done == (UDMA_PINGPONG_PRIMARY | UDMA_PINGPONG_ALTERNATE)) {
+      /* Both halves completed before being served, the channel stopped
+         after the alternate one and restarts from the primary one.*/
+      dmaChannelPrimary(adcp->dmanr);
+      dmaChannelEnable(adcp->dmanr);
+    }
+    if (done & UDMA_PINGPONG_PRIMARY) {
+      _adc_isr_half_code(adcp);
     }
+    if (done & UDMA_PINGPONG_ALTERNATE) {
+      _adc_isr_full_code(adcp);
+    }
+    return;
   }
 
   if ((alt->chctl & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP) {
@@ -256,35 +263,20 @@ void adc_lld_start_conversion(ADCDriver *adcp)
   /* Configure the sample control bits */
   HWREG(adc + ADC_O_SSCTL0) = adcp->grpp->ssctl | 0x44444444; /* Enforce IEn bits */
 
-  /* Alternate source endpoint is the same for all transfers */
-  alternate->srcendp = (void *)(adcp->adc + ADC_O_SSFIFO0);
-
   /* Configure DMA */
   if ((adcp->grpp->circular) && (adcp->depth > 1)) {
     /* Configure DMA in ping-pong mode.
        Ping (1st half) is configured in the primary control structure.
        Pong (2nd half) is configured in the alternate control structure. */
+    size_t half = adcp->grpp->num_channels * adcp->depth / 2;
 
-    uint32_t ctl;
-
-    /* configure the primary source endpoint */
-    primary->srcendp = (void *)(adcp->adc + ADC_O_SSFIFO0);
-
-    /* sample buffer is split in half, the upper half is used here */
-    primary->dstendp = (void *)(adcp->samples +
-                               (adcp->grpp->num_channels * adcp->depth / 2) - 1);
-    /* the lower half is used here */
-    alternate->dstendp = (void *)(adcp->samples +
-                                 (adcp->grpp->num_channels * adcp->depth) - 1);
-
-    ctl = UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_DSTINC_32 |
-          UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_SRCINC_NONE |
-          UDMA_CHCTL_ARBSIZE_1 |
-          UDMA_CHCTL_XFERSIZE(adcp->grpp->num_channels * adcp->depth / 2) |
-          UDMA_CHCTL_XFERMODE_PINGPONG;
-
-    adcp->prictl = ctl;
-    adcp->altctl = ctl;
+    udmaPingPongSetup(adcp->dmanr,
+                      (void *)(adcp->adc + ADC_O_SSFIFO0), adcp->samples,
+                      (void *)(adcp->adc + ADC_O_SSFIFO0), adcp->samples + half,
+                      UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_DSTINC_32 |
+                      UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_SRCINC_NONE |
+                      UDMA_CHCTL_ARBSIZE_1,
+                      half);
 
     dmaChannelPrimary(adcp->dmanr);
   }
@@ -292,6 +284,7 @@ void adc_lld_start_conversion(ADCDriver *adcp)
     /* Configure the DMA in basic mode.
        This is used for both circular buffers with a depth of 1 and linear
        buffers.*/
+    alternate->srcendp = (void *)(adcp->adc + ADC_O_SSFIFO0);
     alternate->dstendp = (void *)(adcp->samples +
                                  (adcp->grpp->num_channels * adcp->depth) - 1);
     adcp->prictl = UDMA_CHCTL_XFERMODE_STOP;
@@ -301,13 +294,13 @@ void adc_lld_start_conversion(ADCDriver *adcp)
                    UDMA_CHCTL_XFERSIZE(adcp->grpp->num_channels * adcp->depth) |
                    UDMA_CHCTL_XFERMODE_BASIC;
 
+    /* Configure primary and alternate channel control fields */
+    primary->chctl = adcp->prictl;
+    alternate->chctl = adcp->altctl;
+
     dmaChannelAlternate(adcp->dmanr);
   }
 
-  /* Configure primary and alternate channel control fields */
-  primary->chctl = adcp->prictl;
-  alternate->chctl = adcp->altctl;
-
   /* Configure DMA channel */
   dmaChannelBurstOnly(adcp->dmanr);
   dmaChannelPriorityDefault(adcp->dmanr);
@@ -52,6 +52,10 @@
 #define EMAC_MIIADDR_MIIW       0x00000002  /* MII Write */
 #define EMAC_MIIADDR_MIIB       0x00000001  /* MII Busy */
 
+/* Transmit descriptor lock states.*/
+#define TX_LOCKED               1   /* Being filled by a thread.*/
+#define TX_SEGMENT              2   /* Frame segment, waiting reclaim.*/
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -212,6 +216,19 @@ static void mac_lld_set_address(const uint8_t *p)
   HWREG(EMAC0_BASE + EMAC_O_HASHTBLL) = 0;
 }
 
+/**
+ * @brief   Restarts the transmit DMA if it is suspended.
+ *
+ * @notapi
+ */
+static void mac_lld_tx_poll(void)
+{
+  if ((HWREG(EMAC0_BASE + EMAC_O_DMARIS) & (0x7 << 20)) == (6 << 20)) {
+    HWREG(EMAC0_BASE + EMAC_O_DMARIS)   = (1 << 2);
+    HWREG(EMAC0_BASE + EMAC_O_TXPOLLD) = 1; /* Any value is OK.*/
+  }
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -265,6 +282,11 @@ void mac_lld_init(void)
      word is not initialized here but in mac_lld_start().*/
   for (i = 0; i < TIVA_MAC_RECEIVE_BUFFERS; i++) {
     rd[i].rdes1 = TIVA_RDES1_RCH | TIVA_RDES1_RBS1(TIVA_MAC_BUFFERS_SIZE);
+    /* Interrupt coalescing, only one descriptor out of
+       TIVA_MAC_RX_COALESCE_FRAMES interrupts on completion, the watchdog
+       takes care of the others.*/
+    if ((i + 1) % TIVA_MAC_RX_COALESCE_FRAMES != 0)
+      rd[i].rdes1 |= TIVA_RDES1_DIC;
     rd[i].rdes2 = (uint32_t)rb[i];
     rd[i].rdes3 = (uint32_t)&rd[(i + 1) % TIVA_MAC_RECEIVE_BUFFERS];
   }
@@ -369,7 +391,10 @@ void mac_lld_start(MACDriver *macp)
 
   for (i = 0; i < TIVA_MAC_TRANSMIT_BUFFERS; i++) {
     td[i].tdes0 = TIVA_TDES0_TCH;
-    td[i].locked = 0;
+    td[i].tdes2 = (uint32_t)tb[i];
+    /* Segments not released before the driver stop are released by the
+       next macTivaReclaimTransmit().*/
+    td[i].locked = (td[i].arg != NULL) ? TX_SEGMENT : 0;
   }
   macp->txptr = (tiva_eth_tx_descriptor_t *)td;
 
@@ -411,11 +436,22 @@ void mac_lld_start(MACDriver *macp)
   HWREG(EMAC0_BASE + EMAC_O_CFG) =             (1 << 3) | (1 << 2);
 #endif
 
+  /* Internal loopback, the link is forced up in full duplex.*/
+  if (macp->config->loopback)
+    HWREG(EMAC0_BASE + EMAC_O_CFG) |= (1 << 14) | (1 << 12) | (1 << 11);
+
   /* DMA configuration:
      Descriptor chains pointers.*/
   HWREG(EMAC0_BASE + EMAC_O_RXDLADDR) = (uint32_t)rd;
   HWREG(EMAC0_BASE + EMAC_O_TXDLADDR) = (uint32_t)td;
 
+  /* Receive interrupt watchdog, used by the interrupt coalescing.*/
+#if TIVA_MAC_RX_COALESCE_FRAMES > 1
+  HWREG(EMAC0_BASE + EMAC_O_RXINTWDT) = TIVA_MAC_RIWT;
+#else
+  HWREG(EMAC0_BASE + EMAC_O_RXINTWDT) = 0;
+#endif
+
   /* Enabling required interrupt sources.*/
   HWREG(EMAC0_BASE + EMAC_O_DMARIS) &= 0xFFFF;
   HWREG(EMAC0_BASE + EMAC_O_DMAIM) = (1 << 16) | (1 << 6) | (1 << 0);
@@ -486,6 +522,11 @@ msg_t mac_lld_get_transmit_descriptor(MACDriver *macp,
   if (!macp->link_up)
     return MSG_TIMEOUT;
 
+#if MAC_USE_ZERO_COPY
+  /* Descriptors may still be held by transmitted segments.*/
+  (void)macTivaReclaimTransmit(macp);
+#endif
+
   osalSysLock();
 
   /* Get Current TX descriptor.*/
@@ -498,8 +539,10 @@ msg_t mac_lld_get_transmit_descriptor(MACDriver *macp,
     return MSG_TIMEOUT;
   }
 
-  /* Marks the current descriptor as locked.*/
-  tdes->locked = 1;
+  /* Marks the current descriptor as locked, its buffer may have been
+     replaced by a segment.*/
+  tdes->locked = TX_LOCKED;
+  tdes->tdes2  = (uint32_t)tb[tdes - td];
 
   /* Next TX descriptor to use.*/
   macp->txptr = (tiva_eth_tx_descriptor_t *)tdes->tdes3;
@@ -537,10 +580,7 @@ void mac_lld_release_transmit_descriptor(MACTransmitDescriptor *tdp)
   tdp->physdesc->locked = 0;
 
   /* If the DMA engine is stalled then a restart request is issued.*/
-  if ((HWREG(EMAC0_BASE + EMAC_O_DMARIS) & (0x7 << 20)) == (6 << 20)) {
-    HWREG(EMAC0_BASE + EMAC_O_DMARIS)   = (1 << 2);
-    HWREG(EMAC0_BASE + EMAC_O_TXPOLLD) = 1; /* Any value is OK.*/
-  }
+  mac_lld_tx_poll();
 
   osalSysUnlock();
 }
@@ -571,8 +611,10 @@ msg_t mac_lld_get_receive_descriptor(MACDriver *macp,
   while (!(rdes->rdes0 & TIVA_RDES0_OWN)) {
     if (!(rdes->rdes0 & (TIVA_RDES0_AFM | TIVA_RDES0_ES))
 #if TIVA_MAC_IP_CHECKSUM_OFFLOAD
-        && (rdes->rdes0 & TIVA_RDES0_FT)
-        && !(rdes->rdes0 & (TIVA_RDES0_IPHCE | TIVA_RDES0_PCE))
+        /* Only IP frames with checksum errors are discarded, FT is clear
+           for the frames bypassing the checksum engine, e.g. ARP.*/
+        && !((rdes->rdes0 & TIVA_RDES0_FT) &&
+             (rdes->rdes0 & (TIVA_RDES0_IPHCE | TIVA_RDES0_PCE)))
 #endif
         && (rdes->rdes0 & TIVA_RDES0_FS) && (rdes->rdes0 & TIVA_RDES0_LS)) {
       /* Found a valid one.*/
@@ -615,10 +657,11 @@ void mac_lld_release_receive_descriptor(MACReceiveDescriptor *rdp)
   /* Give buffer back to the Ethernet DMA.*/
   rdp->physdesc->rdes0 = TIVA_RDES0_OWN;
 
-  /* If the DMA engine is stalled then a restart request is issued.*/
-  if ((HWREG(EMAC0_BASE + EMAC_O_STATUS) & (0xf << 17)) == (4 << 17)) {
+  /* If the DMA engine is suspended for lack of descriptors then a restart
+     request is issued.*/
+  if ((HWREG(EMAC0_BASE + EMAC_O_DMARIS) & (0x7 << 17)) == (4 << 17)) {
     HWREG(EMAC0_BASE + EMAC_O_DMARIS)   = (1 << 7);
-    HWREG(EMAC0_BASE + EMAC_O_TXPOLLD) = 1; /* Any value is OK.*/
+    HWREG(EMAC0_BASE + EMAC_O_RXPOLLD) = 1; /* Any value is OK.*/
   }
 
   osalSysUnlock();
@@ -638,6 +681,10 @@ bool mac_lld_poll_link_status(MACDriver *macp)
 {
   uint32_t maccfg, bmsr, bmcr;
 
+  /* No PHY involved in loopback mode.*/
+  if (macp->config->loopback)
+    return macp->link_up = true;
+
   maccfg = HWREG(EMAC0_BASE + EMAC_O_CFG);
 
   /* PHY CR and SR registers read.*/
@@ -816,6 +863,158 @@ const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
   *sizep = 0;
   return NULL;
 }
+
+/**
+ * @brief   Transmits a frame made of several segments, without copying.
+ * @details Each segment takes a transmit descriptor pointing to its data,
+ *          so a buffer chain such as an lwIP @p pbuf chain is sent in place.
+ *          The segments must remain valid until the frame has been sent,
+ *          then @p arg is passed to the @p tx_release callback of the
+ *          configuration.
+ * @note    Completed frames are released by @p macTivaReclaimTransmit(),
+ *          called here and when a transmit descriptor is requested.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] segp      array of segments, forming the frame in order
+ * @param[in] n         number of segments, at most
+ *                      @p TIVA_MAC_TRANSMIT_BUFFERS
+ * @param[in] arg       argument passed to the release callback
+ * @return              The operation status.
+ * @retval MSG_OK       the frame has been queued for transmission.
+ * @retval MSG_TIMEOUT  link down or not enough free descriptors.
+ *
+ * @api
+ */
+msg_t macTivaTransmitSegments(MACDriver *macp,
+                              const tiva_mac_segment_t *segp,
+                              size_t n, void *arg)
+{
+  tiva_eth_tx_descriptor_t *first, *tdes;
+  size_t i;
+
+  osalDbgCheck((macp != NULL) && (segp != NULL) &&
+               (n > 0) && (n <= TIVA_MAC_TRANSMIT_BUFFERS));
+  osalDbgAssert(macp->config->tx_release != NULL, "no release callback");
+
+  if (!macp->link_up)
+    return MSG_TIMEOUT;
+
+  (void)macTivaReclaimTransmit(macp);
+
+  osalSysLock();
+
+  /* All the descriptors of the frame must be free.*/
+  first = tdes = macp->txptr;
+  for (i = 0; i < n; i++) {
+    if ((tdes->tdes0 & TIVA_TDES0_OWN) || tdes->locked) {
+      osalSysUnlock();
+      return MSG_TIMEOUT;
+    }
+    tdes = (tiva_eth_tx_descriptor_t *)tdes->tdes3;
+  }
+
+  /* Descriptors setup, the frame argument goes with the last one.*/
+  tdes = first;
+  for (i = 0; i < n; i++) {
+    uint32_t tdes0 = TIVA_TDES0_CIC(TIVA_MAC_IP_CHECKSUM_OFFLOAD) |
+                     TIVA_TDES0_TCH;
+
+    osalDbgCheck(segp[i].size <= TIVA_TDES1_TBS1_MASK);
+
+    if (i == 0)
+      tdes0 |= TIVA_TDES0_FS;
+    else
+      tdes0 |= TIVA_TDES0_OWN;
+    if (i == n - 1)
+      tdes0 |= TIVA_TDES0_LS | TIVA_TDES0_IC;
+
+    tdes->tdes1  = TIVA_TDES1_TBS1(segp[i].size);
+    tdes->tdes2  = (uint32_t)segp[i].buf;
+    tdes->arg    = (i == n - 1) ? arg : NULL;
+    tdes->locked = TX_SEGMENT;
+    tdes->tdes0  = tdes0;
+    tdes = (tiva_eth_tx_descriptor_t *)tdes->tdes3;
+  }
+  macp->txptr = tdes;
+
+  /* The first descriptor is given to the DMA last, so that it never sees a
+     partially built frame.*/
+  first->tdes0 |= TIVA_TDES0_OWN;
+
+  /* If the DMA engine is stalled then a restart request is issued.*/
+  mac_lld_tx_poll();
+
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Releases the segments of the transmitted frames.
+ * @details The descriptors of the segments already read by the DMA are made
+ *          available again, and the @p tx_release callback is invoked for
+ *          each completely transmitted frame.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @return              The number of frames released.
+ *
+ * @api
+ */
+size_t macTivaReclaimTransmit(MACDriver *macp)
+{
+  size_t i, n = 0;
+
+  osalDbgCheck(macp != NULL);
+
+  for (i = 0; i < TIVA_MAC_TRANSMIT_BUFFERS; i++) {
+    void *arg = NULL;
+
+    osalSysLock();
+    if ((td[i].locked == TX_SEGMENT) && !(td[i].tdes0 & TIVA_TDES0_OWN)) {
+      arg = td[i].arg;
+      td[i].arg = NULL;
+      td[i].locked = 0;
+    }
+    osalSysUnlock();
+
+    /* The DMA processes the descriptors in order, the descriptor holding
+       the argument is the last one of its frame.*/
+    if (arg != NULL) {
+      macp->config->tx_release(macp, arg);
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief   Swaps the buffer of a receive descriptor.
+ * @details The frame buffer is handed to the caller, which becomes its
+ *          owner, and is replaced by @p buf for the next frames. This allows
+ *          passing the received frames up without copying them, e.g. wrapped
+ *          in lwIP custom @p pbufs, while refilling the ring from a pool.
+ * @note    Must be called before releasing the receive descriptor.
+ *
+ * @param[in] rdp       pointer to a @p MACReceiveDescriptor structure
+ * @param[in] buf       new buffer, word aligned and at least
+ *                      @p TIVA_MAC_BUFFERS_SIZE bytes
+ * @return              The buffer holding the received frame.
+ *
+ * @api
+ */
+uint8_t *macTivaSwapReceiveBuffer(MACReceiveDescriptor *rdp, uint8_t *buf)
+{
+  uint8_t *frame;
+
+  osalDbgCheck((rdp != NULL) && (buf != NULL) && (((uint32_t)buf & 3) == 0));
+  osalDbgAssert(!(rdp->physdesc->rdes0 & TIVA_RDES0_OWN),
+              "attempt to swap descriptor already owned by DMA");
+
+  frame = (uint8_t *)rdp->physdesc->rdes2;
+  rdp->physdesc->rdes2 = (uint32_t)buf;
+
+  return frame;
+}
 #endif /* MAC_USE_ZERO_COPY */
 
 #endif /* HAL_USE_MAC */
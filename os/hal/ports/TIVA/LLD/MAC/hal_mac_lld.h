@@ -62,6 +62,10 @@
 #define TIVA_RDES0_DE               0x00000004
 #define TIVA_RDES0_CE               0x00000002
 #define TIVA_RDES0_ESA              0x00000001
+
+/* Meaning of TAGF and ESA when IP checksum offload is enabled.*/
+#define TIVA_RDES0_IPHCE            0x00000080
+#define TIVA_RDES0_PCE              0x00000001
 /** @} */
 
 /**
@@ -183,14 +187,14 @@
  * @brief   Number of available transmit buffers.
  */
 #if !defined(TIVA_MAC_TRANSMIT_BUFFERS) || defined(__DOXYGEN__)
-#define TIVA_MAC_TRANSMIT_BUFFERS           2
+#define TIVA_MAC_TRANSMIT_BUFFERS           4
 #endif
 
 /**
  * @brief   Number of available receive buffers.
  */
 #if !defined(TIVA_MAC_RECEIVE_BUFFERS) || defined(__DOXYGEN__)
-#define TIVA_MAC_RECEIVE_BUFFERS            4
+#define TIVA_MAC_RECEIVE_BUFFERS            8
 #endif
 
 /**
@@ -243,6 +247,26 @@
 #if !defined(TIVA_MAC_IP_CHECKSUM_OFFLOAD) || defined(__DOXYGEN__)
 #define TIVA_MAC_IP_CHECKSUM_OFFLOAD        0
 #endif
+
+/**
+ * @brief   Received frames per receive interrupt.
+ * @details Only one receive descriptor out of this number raises an
+ *          interrupt on completion, the others rely on the receive
+ *          interrupt watchdog. A value of one disables the coalescing.
+ */
+#if !defined(TIVA_MAC_RX_COALESCE_FRAMES) || defined(__DOXYGEN__)
+#define TIVA_MAC_RX_COALESCE_FRAMES         1
+#endif
+
+/**
+ * @brief   Receive interrupt coalescing timeout, in microseconds.
+ * @details Maximum delay between the reception of a frame and its receive
+ *          interrupt, when @p TIVA_MAC_RX_COALESCE_FRAMES is greater than
+ *          one. The hardware limit is 255 * 256 system clock cycles.
+ */
+#if !defined(TIVA_MAC_RX_COALESCE_TIME) || defined(__DOXYGEN__)
+#define TIVA_MAC_RX_COALESCE_TIME           100
+#endif
 /** @} */
 
 #ifndef EMAC_PHY_CONFIG
@@ -266,6 +290,22 @@
 #error "Invalid IRQ priority assigned to MAC"
 #endif
 
+#if (TIVA_MAC_RX_COALESCE_FRAMES < 1) ||                                    \
+    (TIVA_MAC_RX_COALESCE_FRAMES > TIVA_MAC_RECEIVE_BUFFERS)
+#error "TIVA_MAC_RX_COALESCE_FRAMES out of range"
+#endif
+
+/**
+ * @brief   Receive interrupt watchdog setting.
+ */
+#define TIVA_MAC_RIWT                                                       \
+  (((TIVA_MAC_RX_COALESCE_TIME * (TIVA_SYSCLK / 1000000)) + 255) / 256)
+
+#if (TIVA_MAC_RX_COALESCE_FRAMES > 1) &&                                    \
+    ((TIVA_MAC_RIWT < 1) || (TIVA_MAC_RIWT > 255))
+#error "TIVA_MAC_RX_COALESCE_TIME out of range"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -291,8 +331,34 @@ typedef struct
   volatile uint32_t     tdes2;
   volatile uint32_t     tdes3;
   volatile uint32_t     locked;
+  void                  *arg;
 } tiva_eth_tx_descriptor_t;
 
+#if MAC_USE_ZERO_COPY || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a transmit frame segment.
+ */
+typedef struct
+{
+  /**
+   * @brief Segment data, transmitted in place.
+   */
+  const void            *buf;
+  /**
+   * @brief Segment size.
+   */
+  size_t                size;
+} tiva_mac_segment_t;
+
+/**
+ * @brief   Type of a transmitted frame release callback.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] arg       argument passed to @p macTivaTransmitSegments()
+ */
+typedef void (*tiva_mac_release_t)(MACDriver *macp, void *arg);
+#endif
+
 /**
  * @brief   Driver configuration structure.
  */
@@ -303,6 +369,18 @@ typedef struct
    */
   uint8_t               *mac_address;
   /* End of the mandatory fields.*/
+  /**
+   * @brief Internal loopback, transmitted frames are received back and the
+   *        PHY is ignored.
+   */
+  bool                  loopback;
+#if MAC_USE_ZERO_COPY || defined(__DOXYGEN__)
+  /**
+   * @brief Callback releasing the segments of the frames sent with
+   *        @p macTivaTransmitSegments(), called from thread context.
+   */
+  tiva_mac_release_t    tx_release;
+#endif
 } MACConfig;
 
 /**
@@ -426,6 +504,11 @@ extern "C" {
                                             size_t *sizep);
   const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
                                                  size_t *sizep);
+  msg_t macTivaTransmitSegments(MACDriver *macp,
+                                const tiva_mac_segment_t *segp,
+                                size_t n, void *arg);
+  size_t macTivaReclaimTransmit(MACDriver *macp);
+  uint8_t *macTivaSwapReceiveBuffer(MACReceiveDescriptor *rdp, uint8_t *buf);
 #endif /* MAC_USE_ZERO_COPY */
 #ifdef __cplusplus
 }
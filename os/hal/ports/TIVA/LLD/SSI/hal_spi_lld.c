@@ -70,6 +70,97 @@ static uint16_t dummyrx;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Programs the primary structure of one of the SSI DMA channels.
+ * @details Transfers longer than a single control structure are chained as
+ *          a peripheral scatter-gather task list, the channel still
+ *          interrupts once at the end.
+ *
+ * @param[in] dmach     DMA channel number
+ * @param[in] tasks     task list used for long transfers
+ * @param[in] src       source start address
+ * @param[in] dst       destination start address
+ * @param[in] ctl       CHCTL value without the XFERSIZE and XFERMODE fields
+ * @param[in] n         number of frames
+ */
+static void spi_dma_setup(uint8_t dmach, tiva_udma_table_entry_t *tasks,
+                          const volatile void *src, volatile void *dst,
+                          uint32_t ctl, size_t n)
+{
+  size_t ntasks;
+
+  if (n <= UDMA_MAX_TRANSFER) {
+    udmaEntrySetup(&udmaControlTable.primary[dmach], src, dst,
+                   ctl | UDMA_CHCTL_XFERMODE_BASIC, n);
+    return;
+  }
+
+  ntasks = udmaTaskListSetup(tasks, TIVA_SPI_UDMA_MAX_TASKS, src, dst, ctl, n,
+                             TRUE);
+  osalDbgAssert(ntasks > 0, "transfer too long");
+  udmaScatterGatherSetup(dmach, tasks, ntasks, TRUE);
+}
+
+/**
+ * @brief   Starts a DMA transfer on the SSI.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of frames
+ * @param[in] txbuf     the pointer to the transmit buffer, @p NULL to send
+ *                      idle frames
+ * @param[out] rxbuf    the pointer to the receive buffer, @p NULL to discard
+ *                      the received frames
+ */
+static void spi_start_dma(SPIDriver *spip, size_t n,
+                          const void *txbuf, void *rxbuf)
+{
+  void *dr = (void *)(spip->ssi + SSI_O_DR);
+  uint32_t txctl, rxctl;
+
+  if ((spip->config->cr0 & SSI_CR0_DSS_M) < 8) {
+    /* Configure for 8-bit transfers.*/
+    txctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
+            UDMA_CHCTL_SRCSIZE_8 |
+            (txbuf != NULL ? UDMA_CHCTL_SRCINC_8 : UDMA_CHCTL_SRCINC_NONE);
+    rxctl = UDMA_CHCTL_DSTSIZE_8 |
+            (rxbuf != NULL ? UDMA_CHCTL_DSTINC_8 : UDMA_CHCTL_DSTINC_NONE) |
+            UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE;
+  }
+  else {
+    /* Configure for 16-bit transfers.*/
+    txctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
+            UDMA_CHCTL_SRCSIZE_16 |
+            (txbuf != NULL ? UDMA_CHCTL_SRCINC_16 : UDMA_CHCTL_SRCINC_NONE);
+    rxctl = UDMA_CHCTL_DSTSIZE_16 |
+            (rxbuf != NULL ? UDMA_CHCTL_DSTINC_16 : UDMA_CHCTL_DSTINC_NONE) |
+            UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE;
+  }
+
+  if (txbuf == NULL)
+    txbuf = &dummytx;
+  if (rxbuf == NULL)
+    rxbuf = &dummyrx;
+
+  spi_dma_setup(spip->dmatxnr, spip->txtasks, txbuf, dr,
+                txctl | UDMA_CHCTL_ARBSIZE_4, n);
+  spi_dma_setup(spip->dmarxnr, spip->rxtasks, dr, rxbuf,
+                rxctl | UDMA_CHCTL_ARBSIZE_4, n);
+
+  dmaChannelSingleBurst(spip->dmatxnr);
+  dmaChannelPrimary(spip->dmatxnr);
+  dmaChannelPriorityDefault(spip->dmatxnr);
+  dmaChannelEnableRequest(spip->dmatxnr);
+
+  dmaChannelSingleBurst(spip->dmarxnr);
+  dmaChannelPrimary(spip->dmarxnr);
+  dmaChannelPriorityDefault(spip->dmarxnr);
+  dmaChannelEnableRequest(spip->dmarxnr);
+
+  /* Enable DMA channels, when the TX channel is enabled the transfer starts.*/
+  dmaChannelEnable(spip->dmarxnr);
+  dmaChannelEnable(spip->dmatxnr);
+}
+
 /**
  * @brief   Common IRQ handler.
  *
@@ -399,58 +490,7 @@ void spi_lld_unselect(SPIDriver *spip)
  */
 void spi_lld_ignore(SPIDriver *spip, size_t n)
 {
-  tiva_udma_table_entry_t *primary = udmaControlTable.primary;
-
-  if ((spip->config->cr0 & SSI_CR0_DSS_M) < 8) {
-    /* Configure for 8-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)&dummytx;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = &dummyrx;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-  else {
-    /* Configure for 16-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)&dummytx;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = &dummyrx;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-
-  dmaChannelSingleBurst(spip->dmatxnr);
-  dmaChannelPrimary(spip->dmatxnr);
-  dmaChannelPriorityDefault(spip->dmatxnr);
-  dmaChannelEnableRequest(spip->dmatxnr);
-
-  dmaChannelSingleBurst(spip->dmarxnr);
-  dmaChannelPrimary(spip->dmarxnr);
-  dmaChannelPriorityDefault(spip->dmarxnr);
-  dmaChannelEnableRequest(spip->dmarxnr);
-
-  /* Enable DMA channels, when the TX channel is enabled the transfer starts.*/
-  dmaChannelEnable(spip->dmarxnr);
-  dmaChannelEnable(spip->dmatxnr);
+  spi_start_dma(spip, n, NULL, NULL);
 }
 
 /**
@@ -470,58 +510,7 @@ void spi_lld_ignore(SPIDriver *spip, size_t n)
  */
 void spi_lld_exchange(SPIDriver *spip, size_t n, const void *txbuf, void *rxbuf)
 {
-  tiva_udma_table_entry_t *primary = udmaControlTable.primary;
-
-  if ((spip->config->cr0 & SSI_CR0_DSS_M) < 8) {
-    /* Configure for 8-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)txbuf+n-1;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_8 |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = rxbuf+n-1;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_8 |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-  else {
-    /* Configure for 16-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)txbuf+(n*2)-1;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_16 |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = rxbuf+(n*2)-1;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_16 |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-
-  dmaChannelSingleBurst(spip->dmatxnr);
-  dmaChannelPrimary(spip->dmatxnr);
-  dmaChannelPriorityDefault(spip->dmatxnr);
-  dmaChannelEnableRequest(spip->dmatxnr);
-
-  dmaChannelSingleBurst(spip->dmarxnr);
-  dmaChannelPrimary(spip->dmarxnr);
-  dmaChannelPriorityDefault(spip->dmarxnr);
-  dmaChannelEnableRequest(spip->dmarxnr);
-
-  /* Enable DMA channels, when the TX channel is enabled the transfer starts.*/
-  dmaChannelEnable(spip->dmarxnr);
-  dmaChannelEnable(spip->dmatxnr);
+  spi_start_dma(spip, n, txbuf, rxbuf);
 }
 
 /**
@@ -539,58 +528,7 @@ void spi_lld_exchange(SPIDriver *spip, size_t n, const void *txbuf, void *rxbuf)
  */
 void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf)
 {
-  tiva_udma_table_entry_t *primary = udmaControlTable.primary;
-
-  if ((spip->config->cr0 & SSI_CR0_DSS_M) < 8) {
-    /* Configure for 8-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)txbuf+n-1;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_8 |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].srcendp = &dummyrx;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-  else {
-    /* Configure for 16-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)txbuf+(n*2)-1;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_16 |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].srcendp = &dummyrx;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-
-  dmaChannelSingleBurst(spip->dmatxnr);
-  dmaChannelPrimary(spip->dmatxnr);
-  dmaChannelPriorityDefault(spip->dmatxnr);
-  dmaChannelEnableRequest(spip->dmatxnr);
-
-  dmaChannelSingleBurst(spip->dmarxnr);
-  dmaChannelPrimary(spip->dmarxnr);
-  dmaChannelPriorityDefault(spip->dmarxnr);
-  dmaChannelEnableRequest(spip->dmarxnr);
-
-  /* Enable DMA channels, when the TX channel is enabled the transfer starts.*/
-  dmaChannelEnable(spip->dmarxnr);
-  dmaChannelEnable(spip->dmatxnr);
+  spi_start_dma(spip, n, txbuf, NULL);
 }
 
 /**
@@ -608,58 +546,7 @@ void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf)
  */
 void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) 
 {
-  tiva_udma_table_entry_t *primary = udmaControlTable.primary;
-
-  if ((spip->config->cr0 & SSI_CR0_DSS_M) < 8) {
-    /* Configure for 8-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)&dummytx;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = rxbuf+n-1;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_8 |
-                                   UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-  else {
-    /* Configure for 16-bit transfers.*/
-    primary[spip->dmatxnr].srcendp = (volatile void *)&dummytx;
-    primary[spip->dmatxnr].dstendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmatxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_NONE |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-
-    primary[spip->dmarxnr].srcendp = (void *)(spip->ssi + SSI_O_DR);
-    primary[spip->dmarxnr].dstendp = rxbuf+(n*2)-1;
-    primary[spip->dmarxnr].chctl = UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_DSTINC_16 |
-                                   UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_SRCINC_NONE |
-                                   UDMA_CHCTL_ARBSIZE_4 |
-                                   UDMA_CHCTL_XFERSIZE(n) |
-                                   UDMA_CHCTL_XFERMODE_BASIC;
-  }
-
-  dmaChannelSingleBurst(spip->dmatxnr);
-  dmaChannelPrimary(spip->dmatxnr);
-  dmaChannelPriorityDefault(spip->dmatxnr);
-  dmaChannelEnableRequest(spip->dmatxnr);
-
-  dmaChannelSingleBurst(spip->dmarxnr);
-  dmaChannelPrimary(spip->dmarxnr);
-  dmaChannelPriorityDefault(spip->dmarxnr);
-  dmaChannelEnableRequest(spip->dmarxnr);
-
-  /* Enable DMA channels, when the TX channel is enabled the transfer starts.*/
-  dmaChannelEnable(spip->dmarxnr);
-  dmaChannelEnable(spip->dmatxnr);
+  spi_start_dma(spip, n, NULL, rxbuf);
 }
 
 /**
@@ -116,6 +116,16 @@
 #define TIVA_SPI_SSI_ERROR_HOOK(spip)       osalSysHalt("SSI failure")
 #endif
 
+/**
+ * @brief   Scatter-gather tasks per DMA channel.
+ * @details Transfers longer than @p UDMA_MAX_TRANSFER frames are chained as
+ *          task lists, this sets the longest transfer to this many times
+ *          @p UDMA_MAX_TRANSFER frames.
+ */
+#if !defined(TIVA_SPI_UDMA_MAX_TASKS) || defined(__DOXYGEN__)
+#define TIVA_SPI_UDMA_MAX_TASKS             4
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -161,6 +171,10 @@
 #error "Invalid IRQ priority assigned to SSI3"
 #endif
 
+#if (TIVA_SPI_UDMA_MAX_TASKS < 1) || (TIVA_SPI_UDMA_MAX_TASKS > 256)
+#error "TIVA_SPI_UDMA_MAX_TASKS out of range"
+#endif
+
 #if !defined(TIVA_UDMA_REQUIRED)
 #define TIVA_UDMA_REQUIRED
 #endif
@@ -279,6 +293,16 @@ struct SPIDriver {
    * @brief Transmit DMA channel map.
    */
   uint8_t               txchnmap;
+  /**
+   * @brief Receive DMA scatter-gather tasks.
+   */
+  tiva_udma_table_entry_t rxtasks[TIVA_SPI_UDMA_MAX_TASKS]
+                          __attribute__((aligned(4)));
+  /**
+   * @brief Transmit DMA scatter-gather tasks.
+   */
+  tiva_udma_table_entry_t txtasks[TIVA_SPI_UDMA_MAX_TASKS]
+                          __attribute__((aligned(4)));
 };
 
 /*===========================================================================*/
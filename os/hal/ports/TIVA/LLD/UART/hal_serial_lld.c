@@ -30,6 +30,22 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if TIVA_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Receive DMA half ring size.
+ */
+#define RX_DMA_HALF_SIZE        (TIVA_SERIAL_RX_DMA_BUFFER_SIZE / 2)
+
+/**
+ * @brief   Receive DMA control word, for both halves of the ring.
+ * @note    The arbitration size matches the FIFO trigger level forced in
+ *          DMA mode.
+ */
+#define RX_DMA_CHCTL            (UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_8 | \
+                                 UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_NONE | \
+                                 UDMA_CHCTL_ARBSIZE_8)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -152,6 +168,46 @@ static uint8_t sd_in_buf8[TIVA_SERIAL_UART7_IN_BUF_SIZE];
 static uint8_t sd_out_buf8[TIVA_SERIAL_UART7_OUT_BUF_SIZE];
 #endif
 
+#if TIVA_SERIAL_USE_UART0_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD1.*/
+static uint8_t sd_rx_dma_buf1[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART1_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD2.*/
+static uint8_t sd_rx_dma_buf2[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART2_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD3.*/
+static uint8_t sd_rx_dma_buf3[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART3_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD4.*/
+static uint8_t sd_rx_dma_buf4[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART4_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD5.*/
+static uint8_t sd_rx_dma_buf5[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART5_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD6.*/
+static uint8_t sd_rx_dma_buf6[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART6_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD7.*/
+static uint8_t sd_rx_dma_buf7[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
+#if TIVA_SERIAL_USE_UART7_RX_DMA || defined(__DOXYGEN__)
+/** @brief Receive DMA ring for SD8.*/
+static uint8_t sd_rx_dma_buf8[TIVA_SERIAL_RX_DMA_BUFFER_SIZE];
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -243,6 +299,113 @@ static void set_error(SerialDriver *sdp, uint16_t err)
   osalSysUnlockFromISR();
 }
 
+#if TIVA_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Index of the next byte the uDMA will write in the ring.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static size_t rx_dma_wridx(SerialDriver *sdp)
+{
+  uint8_t ch = sdp->dmarxnr;
+  tiva_udma_table_entry_t *e = &udmaControlTable.primary[ch];
+  size_t base = 0;
+
+  if (HWREG(UDMA_ALTSET) & (1 << ch)) {
+    e = &udmaControlTable.alternate[ch];
+    base = RX_DMA_HALF_SIZE;
+  }
+
+  return base + RX_DMA_HALF_SIZE - udmaEntryRemaining(e);
+}
+
+/**
+ * @brief   Starts receiving through the uDMA.
+ * @details Ping-pong transfer, the primary structure fills the lower half of
+ *          the ring and the alternate structure the upper half.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void rx_dma_start(SerialDriver *sdp)
+{
+  uint32_t u = sdp->uart;
+  uint8_t ch = sdp->dmarxnr;
+
+  dmaChannelDisable(ch);
+
+  sdp->rxring.rdidx = 0;
+  udmaPingPongSetup(ch, (void *)(u + UART_O_DR), sdp->rxring.buffer,
+                    (void *)(u + UART_O_DR),
+                    sdp->rxring.buffer + RX_DMA_HALF_SIZE,
+                    RX_DMA_CHCTL, RX_DMA_HALF_SIZE);
+
+  dmaChannelPrimary(ch);
+  dmaChannelBurstOnly(ch);
+  dmaChannelPriorityDefault(ch);
+  dmaChannelEnableRequest(ch);
+  HWREG(UDMA_CHIS) = (1 << ch);
+  dmaChannelEnable(ch);
+
+  /* Bursts are requested at half FIFO, the bytes left below it are served
+     by the receive timeout interrupt.*/
+  HWREG(u + UART_O_IFLS) = (HWREG(u + UART_O_IFLS) & ~UART_IFLS_RX_M) |
+                           UART_IFLS_RX4_8;
+  HWREG(u + UART_O_IM) &= ~UART_IM_RXIM;
+  HWREG(u + UART_O_DMACTL) = UART_DMACTL_RXDMAE;
+}
+
+/**
+ * @brief   Receive DMA service routine.
+ * @details Moves the ring and then the FIFO leftovers to the input queue,
+ *          re-arms the completed halves.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] mis       UART MIS register value
+ */
+static void rx_dma_serve_interrupt(SerialDriver *sdp, uint16_t mis)
+{
+  uint32_t u = sdp->uart;
+  uint8_t ch = sdp->dmarxnr;
+  eventflags_t flags;
+
+  /* Keeps the uDMA off the FIFO while draining it, the bytes must reach the
+     queue in order.*/
+  dmaChannelDisableRequest(ch);
+  HWREG(UDMA_CHIS) = (1 << ch);
+
+  osalSysLockFromISR();
+  flags = sdDmaRxRingFlushI(&sdp->rxring, &sdp->iqueue, rx_dma_wridx(sdp));
+  if (mis & UART_MIS_RTMIS) {
+    if (((HWREG(u + UART_O_FR) & UART_FR_RXFE) == 0) &&
+        iqIsEmptyI(&sdp->iqueue)) {
+      flags |= CHN_INPUT_AVAILABLE;
+    }
+    while ((HWREG(u + UART_O_FR) & UART_FR_RXFE) == 0) {
+      if (iqPutI(&sdp->iqueue, HWREG(u + UART_O_DR)) < Q_OK) {
+        flags |= SD_QUEUE_FULL_ERROR;
+      }
+    }
+  }
+
+  (void)udmaPingPongServe(ch);
+  if ((HWREG(UDMA_ENASET) & (1 << ch)) == 0) {
+    /* Both halves filled before being served, the channel stopped. Restarts
+       from the ring start, the bytes not moved above are lost.*/
+    flags |= SD_OVERRUN_ERROR;
+    sdp->rxring.rdidx = 0;
+    dmaChannelPrimary(ch);
+    dmaChannelEnable(ch);
+  }
+
+  if (flags != 0) {
+    chnAddFlagsI(sdp, flags);
+  }
+  osalSysUnlockFromISR();
+
+  dmaChannelEnableRequest(ch);
+}
+#endif /* TIVA_SERIAL_HAS_RX_DMA */
+
 /**
  * @brief   Common IRQ handler.
  * @note    Tries hard to clear all the pending interrupt sources, we don't
@@ -263,6 +426,15 @@ static void serial_serve_interrupt(SerialDriver *sdp)
     set_error(sdp, mis);
   }
 
+#if TIVA_SERIAL_HAS_RX_DMA
+  if (sdp->rxring.buffer != NULL) {
+    if ((HWREG(UDMA_CHIS) & (1 << sdp->dmarxnr)) || (mis & UART_MIS_RTMIS)) {
+      rx_dma_serve_interrupt(sdp, mis);
+    }
+    mis &= ~(UART_MIS_RXMIS | UART_MIS_RTMIS);
+  }
+#endif
+
   if ((mis & UART_MIS_RXMIS) || (mis &  UART_MIS_RTMIS)) {
     osalSysLockFromISR();
     if (iqIsEmptyI(&sdp->iqueue)) {
@@ -578,6 +750,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD1.iqueue, sd_in_buf1, sizeof sd_in_buf1, NULL, &SD1);
   oqObjectInit(&SD1.oqueue, sd_out_buf1, sizeof sd_out_buf1, notify1, &SD1);
   SD1.uart = UART0_BASE;
+#if TIVA_SERIAL_USE_UART0_RX_DMA
+  sdDmaRxRingInit(&SD1.rxring, sd_rx_dma_buf1, sizeof sd_rx_dma_buf1);
+  SD1.dmarxnr = TIVA_SERIAL_UART0_RX_UDMA_CHANNEL;
+  SD1.rxchnmap = TIVA_SERIAL_UART0_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART1
@@ -585,6 +762,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD2.iqueue, sd_in_buf2, sizeof sd_in_buf2, NULL, &SD2);
   oqObjectInit(&SD2.oqueue, sd_out_buf2, sizeof sd_out_buf2, notify2, &SD2);
   SD2.uart = UART1_BASE;
+#if TIVA_SERIAL_USE_UART1_RX_DMA
+  sdDmaRxRingInit(&SD2.rxring, sd_rx_dma_buf2, sizeof sd_rx_dma_buf2);
+  SD2.dmarxnr = TIVA_SERIAL_UART1_RX_UDMA_CHANNEL;
+  SD2.rxchnmap = TIVA_SERIAL_UART1_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART2
@@ -592,6 +774,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD3.iqueue, sd_in_buf3, sizeof sd_in_buf3, NULL, &SD3);
   oqObjectInit(&SD3.oqueue, sd_out_buf3, sizeof sd_out_buf3, notify3, &SD3);
   SD3.uart = UART2_BASE;
+#if TIVA_SERIAL_USE_UART2_RX_DMA
+  sdDmaRxRingInit(&SD3.rxring, sd_rx_dma_buf3, sizeof sd_rx_dma_buf3);
+  SD3.dmarxnr = TIVA_SERIAL_UART2_RX_UDMA_CHANNEL;
+  SD3.rxchnmap = TIVA_SERIAL_UART2_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART3
@@ -599,6 +786,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD4.iqueue, sd_in_buf4, sizeof sd_in_buf4, NULL, &SD4);
   oqObjectInit(&SD4.oqueue, sd_out_buf4, sizeof sd_out_buf4, notify4, &SD4);
   SD4.uart = UART3_BASE;
+#if TIVA_SERIAL_USE_UART3_RX_DMA
+  sdDmaRxRingInit(&SD4.rxring, sd_rx_dma_buf4, sizeof sd_rx_dma_buf4);
+  SD4.dmarxnr = TIVA_SERIAL_UART3_RX_UDMA_CHANNEL;
+  SD4.rxchnmap = TIVA_SERIAL_UART3_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART4
@@ -606,6 +798,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD5.iqueue, sd_in_buf5, sizeof sd_in_buf5, NULL, &SD5);
   oqObjectInit(&SD5.oqueue, sd_out_buf5, sizeof sd_out_buf5, notify5, &SD5);
   SD5.uart = UART4_BASE;
+#if TIVA_SERIAL_USE_UART4_RX_DMA
+  sdDmaRxRingInit(&SD5.rxring, sd_rx_dma_buf5, sizeof sd_rx_dma_buf5);
+  SD5.dmarxnr = TIVA_SERIAL_UART4_RX_UDMA_CHANNEL;
+  SD5.rxchnmap = TIVA_SERIAL_UART4_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART5
@@ -613,6 +810,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD6.iqueue, sd_in_buf6, sizeof sd_in_buf6, NULL, &SD6);
   oqObjectInit(&SD6.oqueue, sd_out_buf6, sizeof sd_out_buf6, notify6, &SD6);
   SD6.uart = UART5_BASE;
+#if TIVA_SERIAL_USE_UART5_RX_DMA
+  sdDmaRxRingInit(&SD6.rxring, sd_rx_dma_buf6, sizeof sd_rx_dma_buf6);
+  SD6.dmarxnr = TIVA_SERIAL_UART5_RX_UDMA_CHANNEL;
+  SD6.rxchnmap = TIVA_SERIAL_UART5_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART6
@@ -620,6 +822,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD7.iqueue, sd_in_buf7, sizeof sd_in_buf7, NULL, &SD7);
   oqObjectInit(&SD7.oqueue, sd_out_buf7, sizeof sd_out_buf7, notify7, &SD7);
   SD7.uart = UART6_BASE;
+#if TIVA_SERIAL_USE_UART6_RX_DMA
+  sdDmaRxRingInit(&SD7.rxring, sd_rx_dma_buf7, sizeof sd_rx_dma_buf7);
+  SD7.dmarxnr = TIVA_SERIAL_UART6_RX_UDMA_CHANNEL;
+  SD7.rxchnmap = TIVA_SERIAL_UART6_RX_UDMA_MAPPING;
+#endif
 #endif
 
 #if TIVA_SERIAL_USE_UART7
@@ -627,6 +834,11 @@ void sd_lld_init(void)
   iqObjectInit(&SD8.iqueue, sd_in_buf8, sizeof sd_in_buf8, NULL, &SD8);
   oqObjectInit(&SD8.oqueue, sd_out_buf8, sizeof sd_out_buf8, notify8, &SD8);
   SD8.uart = UART7_BASE;
+#if TIVA_SERIAL_USE_UART7_RX_DMA
+  sdDmaRxRingInit(&SD8.rxring, sd_rx_dma_buf8, sizeof sd_rx_dma_buf8);
+  SD8.dmarxnr = TIVA_SERIAL_UART7_RX_UDMA_CHANNEL;
+  SD8.rxchnmap = TIVA_SERIAL_UART7_RX_UDMA_MAPPING;
+#endif
 #endif
 }
 
@@ -725,9 +937,27 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config)
 
       nvicEnableVector(TIVA_UART7_NUMBER, TIVA_SERIAL_UART7_PRIORITY);
     }
+#endif
+#if TIVA_SERIAL_HAS_RX_DMA
+    if (sdp->rxring.buffer != NULL) {
+      uint32_t chmap = UDMA_CHMAP0 + (sdp->dmarxnr / 8) * 4;
+      uint32_t shift = (sdp->dmarxnr % 8) * 4;
+      bool b;
+
+      b = udmaChannelAllocate(sdp->dmarxnr);
+      osalDbgAssert(!b, "channel already allocated");
+      HWREG(chmap) = (HWREG(chmap) & ~(0xF << shift)) |
+                     (sdp->rxchnmap << shift);
+    }
 #endif
   }
   uart_init(sdp, config);
+#if TIVA_SERIAL_HAS_RX_DMA
+  if (sdp->rxring.buffer != NULL) {
+    osalDbgAssert(config->lcrh & UART_LCRH_FEN, "DMA receive requires FIFO");
+    rx_dma_start(sdp);
+  }
+#endif
 }
 
 /**
@@ -743,6 +973,13 @@ void sd_lld_stop(SerialDriver *sdp)
 {
   if (sdp->state == SD_READY) {
     uart_deinit(sdp->uart);
+#if TIVA_SERIAL_HAS_RX_DMA
+    if (sdp->rxring.buffer != NULL) {
+      HWREG(sdp->uart + UART_O_DMACTL) = 0;
+      dmaChannelDisable(sdp->dmarxnr);
+      udmaChannelRelease(sdp->dmarxnr);
+    }
+#endif
 #if TIVA_SERIAL_USE_UART0
     if (&SD1 == sdp) {
       HWREG(SYSCTL_RCGCUART) &= ~(1 << 0);  /* disable UART0 module */
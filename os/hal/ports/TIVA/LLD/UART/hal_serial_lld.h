@@ -287,6 +287,105 @@
 #if !defined(TIVA_SERIAL_UART7_OUT_BUF_SIZE) || defined(__DOXYGEN__)
 #define TIVA_SERIAL_UART7_OUT_BUF_SIZE  SERIAL_BUFFERS_SIZE
 #endif
+
+/**
+ * @brief   UART0 DMA receive enable switch.
+ * @details If set to @p TRUE SD1 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART0_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART0_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART0_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART0_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART1 DMA receive enable switch.
+ * @details If set to @p TRUE SD2 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART1_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART1_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART1_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART1_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART2 DMA receive enable switch.
+ * @details If set to @p TRUE SD3 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART2_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART2_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART2_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART2_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART3 DMA receive enable switch.
+ * @details If set to @p TRUE SD4 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART3_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART3_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART3_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART3_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART4 DMA receive enable switch.
+ * @details If set to @p TRUE SD5 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART4_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART4_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART4_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART4_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART5 DMA receive enable switch.
+ * @details If set to @p TRUE SD6 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART5_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART5_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART5_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART5_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART6 DMA receive enable switch.
+ * @details If set to @p TRUE SD7 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART6_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART6_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART6_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART6_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   UART7 DMA receive enable switch.
+ * @details If set to @p TRUE SD8 receives through an uDMA channel in
+ *          ping-pong mode over a ring buffer.
+ * @note    Requires @p TIVA_SERIAL_UART7_RX_UDMA_CHANNEL and
+ *          @p TIVA_SERIAL_UART7_RX_UDMA_MAPPING.
+ */
+#if !defined(TIVA_SERIAL_USE_UART7_RX_DMA) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_USE_UART7_RX_DMA    FALSE
+#endif
+
+/**
+ * @brief   Receive DMA ring size, per UART.
+ * @details Each half of the ring is moved to the input queue when filled,
+ *          the bytes left in the FIFO when the line goes idle are moved by
+ *          the receive timeout interrupt.
+ * @note    Must be a multiple of 16, the uDMA moves 8 bytes bursts.
+ */
+#if !defined(TIVA_SERIAL_RX_DMA_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define TIVA_SERIAL_RX_DMA_BUFFER_SIZE  64
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -340,6 +439,108 @@
 #error "Invalid IRQ priority assigned to UART7"
 #endif
 
+/**
+ * @brief   At least one UART receives through DMA.
+ */
+#define TIVA_SERIAL_HAS_RX_DMA                                              \
+  (TIVA_SERIAL_USE_UART0_RX_DMA || TIVA_SERIAL_USE_UART1_RX_DMA ||          \
+   TIVA_SERIAL_USE_UART2_RX_DMA || TIVA_SERIAL_USE_UART3_RX_DMA ||          \
+   TIVA_SERIAL_USE_UART4_RX_DMA || TIVA_SERIAL_USE_UART5_RX_DMA ||          \
+   TIVA_SERIAL_USE_UART6_RX_DMA || TIVA_SERIAL_USE_UART7_RX_DMA)
+
+#if TIVA_SERIAL_USE_UART0_RX_DMA
+#if !TIVA_SERIAL_USE_UART0
+#error "TIVA_SERIAL_USE_UART0_RX_DMA requires TIVA_SERIAL_USE_UART0"
+#endif
+#if !defined(TIVA_SERIAL_UART0_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART0_RX_UDMA_MAPPING)
+#error "UART0 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART1_RX_DMA
+#if !TIVA_SERIAL_USE_UART1
+#error "TIVA_SERIAL_USE_UART1_RX_DMA requires TIVA_SERIAL_USE_UART1"
+#endif
+#if !defined(TIVA_SERIAL_UART1_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART1_RX_UDMA_MAPPING)
+#error "UART1 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART2_RX_DMA
+#if !TIVA_SERIAL_USE_UART2
+#error "TIVA_SERIAL_USE_UART2_RX_DMA requires TIVA_SERIAL_USE_UART2"
+#endif
+#if !defined(TIVA_SERIAL_UART2_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART2_RX_UDMA_MAPPING)
+#error "UART2 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART3_RX_DMA
+#if !TIVA_SERIAL_USE_UART3
+#error "TIVA_SERIAL_USE_UART3_RX_DMA requires TIVA_SERIAL_USE_UART3"
+#endif
+#if !defined(TIVA_SERIAL_UART3_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART3_RX_UDMA_MAPPING)
+#error "UART3 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART4_RX_DMA
+#if !TIVA_SERIAL_USE_UART4
+#error "TIVA_SERIAL_USE_UART4_RX_DMA requires TIVA_SERIAL_USE_UART4"
+#endif
+#if !defined(TIVA_SERIAL_UART4_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART4_RX_UDMA_MAPPING)
+#error "UART4 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART5_RX_DMA
+#if !TIVA_SERIAL_USE_UART5
+#error "TIVA_SERIAL_USE_UART5_RX_DMA requires TIVA_SERIAL_USE_UART5"
+#endif
+#if !defined(TIVA_SERIAL_UART5_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART5_RX_UDMA_MAPPING)
+#error "UART5 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART6_RX_DMA
+#if !TIVA_SERIAL_USE_UART6
+#error "TIVA_SERIAL_USE_UART6_RX_DMA requires TIVA_SERIAL_USE_UART6"
+#endif
+#if !defined(TIVA_SERIAL_UART6_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART6_RX_UDMA_MAPPING)
+#error "UART6 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_USE_UART7_RX_DMA
+#if !TIVA_SERIAL_USE_UART7
+#error "TIVA_SERIAL_USE_UART7_RX_DMA requires TIVA_SERIAL_USE_UART7"
+#endif
+#if !defined(TIVA_SERIAL_UART7_RX_UDMA_CHANNEL) ||                          \
+    !defined(TIVA_SERIAL_UART7_RX_UDMA_MAPPING)
+#error "UART7 receive uDMA channel or mapping not defined"
+#endif
+#endif
+
+#if TIVA_SERIAL_HAS_RX_DMA
+#if ((TIVA_SERIAL_RX_DMA_BUFFER_SIZE % 16) != 0) ||                         \
+    (TIVA_SERIAL_RX_DMA_BUFFER_SIZE > 2048)
+#error "TIVA_SERIAL_RX_DMA_BUFFER_SIZE must be a multiple of 16, up to 2048"
+#endif
+
+#if !defined(TIVA_UDMA_REQUIRED)
+#define TIVA_UDMA_REQUIRED
+#endif
+
+#include "hal_serial_dmarx.h"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -376,6 +577,21 @@ typedef struct {
   uint8_t                   cc;
 } SerialConfig;
 
+#if TIVA_SERIAL_HAS_RX_DMA || defined(__DOXYGEN__)
+/**
+ * @brief @p SerialDriver DMA receive data.
+ */
+#define _serial_driver_dmarx_data                                           \
+  /* RX DMA ring, NULL buffer if not in use.*/                              \
+  sd_dmarx_ring_t           rxring;                                         \
+  /* RX uDMA channel.*/                                                     \
+  uint8_t                   dmarxnr;                                        \
+  /* RX uDMA channel mapping.*/                                             \
+  uint8_t                   rxchnmap;
+#else
+#define _serial_driver_dmarx_data
+#endif
+
 /**
  * @brief @p SerialDriver specific data.
  */
@@ -389,7 +605,8 @@ typedef struct {
   output_queue_t            oqueue;                                         \
   /* End of the mandatory fields.*/                                         \
   /* Pointer to the USART registers block.*/                                \
-  uint32_t                  uart;
+  uint32_t                  uart;                                           \
+  _serial_driver_dmarx_data
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -32,6 +32,11 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/**
+ * @brief   Increment field value meaning no increment.
+ */
+#define UDMA_INC_NONE                   3U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -44,10 +49,47 @@ udmaControlTable_t udmaControlTable;
 
 static uint32_t udma_channel_mask;
 
+/**
+ * @brief   Control words re-armed by @p udmaPingPongServe().
+ */
+static uint32_t udma_pingpong_ctl[32];
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Address of the last item of a transfer.
+ *
+ * @param[in] p         start address
+ * @param[in] inc       SRCINC or DSTINC field value
+ * @param[in] n         number of items
+ */
+static volatile void *udma_endp(const volatile void *p, uint32_t inc,
+                                size_t n)
+{
+  if (inc == UDMA_INC_NONE)
+    return (volatile void *)p;
+
+  return (volatile void *)((const volatile uint8_t *)p + ((n - 1) << inc));
+}
+
+/**
+ * @brief   Address following a transfer, to chain the next one.
+ *
+ * @param[in] p         start address
+ * @param[in] inc       SRCINC or DSTINC field value
+ * @param[in] n         number of items
+ */
+static volatile void *udma_nextp(const volatile void *p, uint32_t inc,
+                                 size_t n)
+{
+  if (inc == UDMA_INC_NONE)
+    return (volatile void *)p;
+
+  return (volatile void *)((const volatile uint8_t *)p + (n << inc));
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -146,6 +188,206 @@ void udmaChannelRelease(uint8_t dmach)
   udma_channel_mask &= ~(1 << dmach);
 }
 
+/**
+ * @brief   Fills a channel control structure.
+ * @details The end pointers are computed from the increment fields of
+ *          @p ctl, addresses with no increment are used as they are.
+ * @note    Only touches memory, the structure can be a control table entry
+ *          as well as a scatter-gather task.
+ *
+ * @param[out] ep       pointer to the control structure
+ * @param[in] src       source start address
+ * @param[in] dst       destination start address
+ * @param[in] ctl       CHCTL value without the XFERSIZE field
+ * @param[in] n         number of items, 1 to @p UDMA_MAX_TRANSFER
+ *
+ * @special
+ */
+void udmaEntrySetup(tiva_udma_table_entry_t *ep, const volatile void *src,
+                    volatile void *dst, uint32_t ctl, size_t n)
+{
+  osalDbgCheck((ep != NULL) && (n > 0) && (n <= UDMA_MAX_TRANSFER));
+
+  ep->srcendp = udma_endp(src, (ctl & UDMA_CHCTL_SRCINC_M) >> 26, n);
+  ep->dstendp = udma_endp(dst, (ctl & UDMA_CHCTL_DSTINC_M) >> 30, n);
+  ep->chctl   = (ctl & ~UDMA_CHCTL_XFERSIZE_M) | UDMA_CHCTL_XFERSIZE(n);
+}
+
+/**
+ * @brief   Number of items still to be moved by a control structure.
+ *
+ * @param[in] ep        pointer to the control structure
+ * @return              The remaining items, zero once the structure has
+ *                      been completed.
+ *
+ * @special
+ */
+size_t udmaEntryRemaining(const tiva_udma_table_entry_t *ep)
+{
+  uint32_t ctl = ep->chctl;
+
+  if ((ctl & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP)
+    return 0;
+
+  return ((ctl & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+}
+
+/**
+ * @brief   Builds a scatter-gather task list for a long transfer.
+ * @details The transfer is split in tasks of at most @p UDMA_MAX_TRANSFER
+ *          items. All the tasks but the last one continue the scatter-gather
+ *          sequence, the last one runs in auto-request mode for memory
+ *          transfers and in basic mode for peripheral transfers, so the
+ *          channel completes and interrupts once for the whole list.
+ * @note    The task list must be word aligned and must stay valid until the
+ *          transfer completes.
+ *
+ * @param[out] tasks    pointer to the task list
+ * @param[in] maxtasks  number of tasks available in the list
+ * @param[in] src       source start address
+ * @param[in] dst       destination start address
+ * @param[in] ctl       CHCTL value without the XFERSIZE and XFERMODE fields
+ * @param[in] n         number of items
+ * @param[in] periph    @p true for a peripheral scatter-gather transfer
+ * @return              The number of tasks used.
+ * @retval 0            if the transfer does not fit in the list.
+ *
+ * @special
+ */
+size_t udmaTaskListSetup(tiva_udma_table_entry_t *tasks, size_t maxtasks,
+                         const volatile void *src, volatile void *dst,
+                         uint32_t ctl, size_t n, bool periph)
+{
+  uint32_t srcinc = (ctl & UDMA_CHCTL_SRCINC_M) >> 26;
+  uint32_t dstinc = (ctl & UDMA_CHCTL_DSTINC_M) >> 30;
+  size_t ntasks = (n + UDMA_MAX_TRANSFER - 1) / UDMA_MAX_TRANSFER;
+  size_t i;
+
+  osalDbgCheck((tasks != NULL) && (n > 0));
+  osalDbgCheck(((uint32_t)tasks & 3) == 0);
+
+  if ((ntasks > maxtasks) || (ntasks > UDMA_MAX_TASKS))
+    return 0;
+
+  ctl &= ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+  for (i = 0; i < ntasks; i++) {
+    size_t chunk = n > UDMA_MAX_TRANSFER ? UDMA_MAX_TRANSFER : n;
+    uint32_t mode;
+
+    if (i < ntasks - 1)
+      mode = periph ? UDMA_CHCTL_XFERMODE_PER_SGA : UDMA_CHCTL_XFERMODE_MEM_SGA;
+    else
+      mode = periph ? UDMA_CHCTL_XFERMODE_BASIC : UDMA_CHCTL_XFERMODE_AUTO;
+
+    udmaEntrySetup(&tasks[i], src, dst, ctl | mode, chunk);
+    tasks[i].unused = 0;
+
+    src = udma_nextp(src, srcinc, chunk);
+    dst = udma_nextp(dst, dstinc, chunk);
+    n -= chunk;
+  }
+
+  return ntasks;
+}
+
+/**
+ * @brief   Programs a channel for a scatter-gather task list.
+ * @details The primary structure copies one task at a time into the
+ *          alternate structure, which then runs it. The destination end
+ *          pointer stays on the last word of the alternate structure, the
+ *          controller wraps it every four words.
+ * @note    The caller selects the primary structure and enables the
+ *          channel.
+ *
+ * @param[in] dmach     DMA channel number
+ * @param[in] tasks     pointer to a task list built with
+ *                      @p udmaTaskListSetup()
+ * @param[in] ntasks    number of tasks in the list
+ * @param[in] periph    @p true for a peripheral scatter-gather transfer
+ *
+ * @special
+ */
+void udmaScatterGatherSetup(uint8_t dmach,
+                            const tiva_udma_table_entry_t *tasks,
+                            size_t ntasks, bool periph)
+{
+  tiva_udma_table_entry_t *pri = &udmaControlTable.primary[dmach];
+
+  osalDbgCheck((dmach < 32) && (ntasks > 0) && (ntasks <= UDMA_MAX_TASKS));
+
+  pri->srcendp = (volatile void *)&tasks[ntasks - 1].unused;
+  pri->dstendp = &udmaControlTable.alternate[dmach].unused;
+  pri->chctl   = UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_DSTINC_32 |
+                 UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_SRCINC_32 |
+                 UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERSIZE(ntasks * 4) |
+                 (periph ? UDMA_CHCTL_XFERMODE_PER_SG :
+                           UDMA_CHCTL_XFERMODE_MEM_SG);
+}
+
+/**
+ * @brief   Programs a channel for a continuous ping-pong transfer.
+ * @details The primary structure moves the first block and the alternate
+ *          structure the second one, the completed structures are re-armed
+ *          by @p udmaPingPongServe().
+ * @note    The caller selects the primary structure and enables the
+ *          channel.
+ *
+ * @param[in] dmach     DMA channel number
+ * @param[in] src0      source start address of the first block
+ * @param[in] dst0      destination start address of the first block
+ * @param[in] src1      source start address of the second block
+ * @param[in] dst1      destination start address of the second block
+ * @param[in] ctl       CHCTL value without the XFERSIZE and XFERMODE fields
+ * @param[in] n         number of items per block
+ *
+ * @special
+ */
+void udmaPingPongSetup(uint8_t dmach,
+                       const volatile void *src0, volatile void *dst0,
+                       const volatile void *src1, volatile void *dst1,
+                       uint32_t ctl, size_t n)
+{
+  osalDbgCheck(dmach < 32);
+
+  ctl = (ctl & ~UDMA_CHCTL_XFERMODE_M) | UDMA_CHCTL_XFERMODE_PINGPONG;
+  udmaEntrySetup(&udmaControlTable.primary[dmach], src0, dst0, ctl, n);
+  udmaEntrySetup(&udmaControlTable.alternate[dmach], src1, dst1, ctl, n);
+  udma_pingpong_ctl[dmach] = udmaControlTable.primary[dmach].chctl;
+}
+
+/**
+ * @brief   Re-arms the completed halves of a ping-pong transfer.
+ * @details Meant to be called from the peripheral interrupt, once per
+ *          completed block. The end pointers are left untouched, each half
+ *          keeps moving the same block.
+ * @note    If both halves completed the channel stopped, the caller has to
+ *          select the primary structure and enable the channel again.
+ *
+ * @param[in] dmach     DMA channel number
+ * @return              The completed halves, a combination of
+ *                      @p UDMA_PINGPONG_PRIMARY and
+ *                      @p UDMA_PINGPONG_ALTERNATE.
+ *
+ * @special
+ */
+uint32_t udmaPingPongServe(uint8_t dmach)
+{
+  tiva_udma_table_entry_t *pri = &udmaControlTable.primary[dmach];
+  tiva_udma_table_entry_t *alt = &udmaControlTable.alternate[dmach];
+  uint32_t done = 0;
+
+  if ((pri->chctl & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP) {
+    pri->chctl = udma_pingpong_ctl[dmach];
+    done |= UDMA_PINGPONG_PRIMARY;
+  }
+  if ((alt->chctl & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP) {
+    alt->chctl = udma_pingpong_ctl[dmach];
+    done |= UDMA_PINGPONG_ALTERNATE;
+  }
+
+  return done;
+}
+
 #endif
 
 /** @} */
@@ -34,6 +34,25 @@
  */
 #define UDMA_CHCTL_XFERSIZE(n)          (((n)-1) << 4)
 
+/**
+ * @brief   Maximum number of items moved by a single control structure.
+ */
+#define UDMA_MAX_TRANSFER               1024U
+
+/**
+ * @brief   Maximum number of tasks in a scatter-gather task list.
+ * @note    The primary structure copies four words per task.
+ */
+#define UDMA_MAX_TASKS                  (UDMA_MAX_TRANSFER / 4U)
+
+/**
+ * @name    Ping-pong halves masks
+ * @{
+ */
+#define UDMA_PINGPONG_PRIMARY           (1U << 0)
+#define UDMA_PINGPONG_ALTERNATE         (1U << 1)
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -153,6 +172,20 @@ extern "C" {
   void udmaInit(void);
   bool udmaChannelAllocate(uint8_t dmach);
   void udmaChannelRelease(uint8_t dmach);
+  void udmaEntrySetup(tiva_udma_table_entry_t *ep, const volatile void *src,
+                      volatile void *dst, uint32_t ctl, size_t n);
+  size_t udmaEntryRemaining(const tiva_udma_table_entry_t *ep);
+  size_t udmaTaskListSetup(tiva_udma_table_entry_t *tasks, size_t maxtasks,
+                           const volatile void *src, volatile void *dst,
+                           uint32_t ctl, size_t n, bool periph);
+  void udmaScatterGatherSetup(uint8_t dmach,
+                              const tiva_udma_table_entry_t *tasks,
+                              size_t ntasks, bool periph);
+  void udmaPingPongSetup(uint8_t dmach,
+                         const volatile void *src0, volatile void *dst0,
+                         const volatile void *src1, volatile void *dst1,
+                         uint32_t ctl, size_t n);
+  uint32_t udmaPingPongServe(uint8_t dmach);
 #ifdef __cplusplus
 }
 #endif
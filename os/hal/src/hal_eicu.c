@@ -33,6 +33,15 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/**
+ * @name    Decoder flags
+ * @{
+ */
+#define EICU_DEC_HAVE_ACTIVE        0x01U   /**< @p last_active is valid.   */
+#define EICU_DEC_HAVE_IDLE          0x02U   /**< @p last_idle is valid.     */
+#define EICU_DEC_IDLE_NEXT          0x04U   /**< Next edge is an idle one.  */
+/** @} */
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -150,4 +159,199 @@ void eicuDisable(EICUDriver *eicup) {
   osalSysUnlock();
 }
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reads the captures of a DMA channel.
+ * @details Decodes the edges stored in the capture ring since the previous
+ *          call. If the ring has been overrun the oldest edges are skipped,
+ *          and counted by @p eicuGetLostEdgesX(), so that the reading
+ *          restarts half a ring behind the DMA.
+ * @note    The ring must be read at least once every half ring of edges
+ *          in order to not lose captures.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] channel   EICU channel, configured with a capture ring
+ * @param[out] rp       Pointer to the results array
+ * @param[in] n         Size of the results array
+ * @return              The number of results written.
+ *
+ * @api
+ */
+size_t eicuReadCaptures(EICUDriver *eicup, eicuchannel_t channel,
+                        eicuresult_t *rp, size_t n) {
+  EICUChannel *chp;
+  const eicucnt_t *buf;
+  uint32_t depth, start, avail, written;
+  size_t done = 0;
+
+  osalDbgCheck((eicup != NULL) && (channel < EICU_CHANNEL_ENUM_END) &&
+               (rp != NULL));
+
+  chp = &eicup->channel[channel];
+  osalDbgAssert(chp->dma != NULL, "not a DMA channel");
+  buf   = chp->config->dma_buf;
+  depth = (uint32_t)chp->config->dma_depth;
+
+  osalSysLock();
+  osalDbgAssert((eicup->state == EICU_READY) || (eicup->state == EICU_IDLE) ||
+                (eicup->state == EICU_ACTIVE) || (eicup->state == EICU_WAITING),
+                "invalid state");
+  written = eicu_lld_get_captured(eicup, channel);
+  osalSysUnlock();
+
+  /* Overrun, skipping an even number of edges so that the active and idle
+     edges keep alternating.*/
+  avail = written - chp->rdpos;
+  if (avail > depth) {
+    uint32_t skip = (avail - (depth / 2U) + 1U) & ~1U;
+    chp->rdpos += skip;
+    chp->lost  += skip;
+    avail      -= skip;
+    chp->decoder.flags &= ~(EICU_DEC_HAVE_ACTIVE | EICU_DEC_HAVE_IDLE);
+  }
+
+  /* At most two contiguous chunks, the ring end and the ring start.*/
+  start = chp->rdpos;
+  while ((avail > 0U) && (done < n)) {
+    uint32_t idx = chp->rdpos & (depth - 1U);
+    size_t len = (size_t)(depth - idx);
+    size_t cnt = n - done;
+    size_t used;
+
+    if (len > avail) {
+      len = avail;
+    }
+    used = eicuDecodeEdges(&chp->decoder, &buf[idx], len, &rp[done], &cnt);
+    chp->rdpos += (uint32_t)used;
+    avail      -= (uint32_t)used;
+    done       += cnt;
+    if (used < len) {
+      break;
+    }
+  }
+
+  /* Edges overwritten by the DMA while being decoded, the results are not
+     reliable and are discarded.*/
+  osalSysLock();
+  written = eicu_lld_get_captured(eicup, channel);
+  osalSysUnlock();
+  if ((written - start) > depth) {
+    chp->lost += chp->rdpos - start;
+    chp->decoder.flags &= ~(EICU_DEC_HAVE_ACTIVE | EICU_DEC_HAVE_IDLE);
+    done = 0;
+  }
+
+  return done;
+}
+
+/**
+ * @brief   Initializes a captured edges decoder.
+ * @details The first edge fed to the decoder is an active one.
+ *
+ * @param[out] dp       Pointer to the @p eicudecoder_t object
+ * @param[in] mode      Capture mode
+ * @param[in] width     Width of the captured counter values
+ *
+ * @init
+ */
+void eicuDecoderInit(eicudecoder_t *dp, eicucapturemode_t mode,
+                     eicutimerwidth_t width) {
+
+  osalDbgCheck(dp != NULL);
+
+  dp->mask        = (width == EICU_WIDTH_16) ? 0xFFFFU : 0xFFFFFFFFU;
+  dp->last_active = 0U;
+  dp->last_idle   = 0U;
+  dp->mode        = (uint8_t)mode;
+  dp->flags       = 0U;
+}
+
+/**
+ * @brief   Decodes captured edges.
+ * @details Produces the same widths and periods the capture callback would
+ *          be invoked with, without the spurious first results:
+ *          - @p EICU_INPUT_EDGE, every edge is an active one, a period per
+ *            edge;
+ *          - @p EICU_INPUT_PULSE, alternating active and idle edges, a
+ *            width per idle edge;
+ *          - @p EICU_INPUT_BOTH, alternating active and idle edges, a width
+ *            and a period per active edge.
+ *          .
+ *          The decoding stops early when the results array is full, the
+ *          remaining edges are to be fed again.
+ *
+ * @param[in,out] dp    Pointer to the @p eicudecoder_t object
+ * @param[in] edges     Captured counter values
+ * @param[in] n         Number of captured counter values
+ * @param[out] rp       Pointer to the results array
+ * @param[in,out] countp On entry the size of the results array, on exit
+ *                      the number of results written
+ * @return              The number of edges consumed.
+ *
+ * @api
+ */
+size_t eicuDecodeEdges(eicudecoder_t *dp, const eicucnt_t *edges, size_t n,
+                       eicuresult_t *rp, size_t *countp) {
+  size_t i, cnt = 0, max;
+
+  osalDbgCheck((dp != NULL) && (countp != NULL));
+  osalDbgCheck((n == 0U) || ((edges != NULL) && (rp != NULL)));
+
+  max = *countp;
+  for (i = 0; i < n; i++) {
+    uint32_t e = edges[i];
+    bool active, ready;
+
+    if (dp->mode == (uint8_t)EICU_INPUT_EDGE) {
+      active = true;
+      ready  = (dp->flags & EICU_DEC_HAVE_ACTIVE) != 0U;
+    }
+    else {
+      active = (dp->flags & EICU_DEC_IDLE_NEXT) == 0U;
+      if (dp->mode == (uint8_t)EICU_INPUT_PULSE)
+        ready = !active && ((dp->flags & EICU_DEC_HAVE_ACTIVE) != 0U);
+      else
+        ready = active && ((dp->flags & EICU_DEC_HAVE_IDLE) != 0U);
+      dp->flags ^= EICU_DEC_IDLE_NEXT;
+    }
+
+    if (ready) {
+      if (cnt >= max) {
+        /* Results array full, the edge is left for the next call.*/
+        if (dp->mode != (uint8_t)EICU_INPUT_EDGE)
+          dp->flags ^= EICU_DEC_IDLE_NEXT;
+        break;
+      }
+      if (dp->mode == (uint8_t)EICU_INPUT_EDGE) {
+        rp[cnt].width  = 0U;
+        rp[cnt].period = (e - dp->last_active) & dp->mask;
+      }
+      else if (dp->mode == (uint8_t)EICU_INPUT_PULSE) {
+        rp[cnt].width  = (e - dp->last_active) & dp->mask;
+        rp[cnt].period = 0U;
+      }
+      else {
+        rp[cnt].width  = (dp->last_idle - dp->last_active) & dp->mask;
+        rp[cnt].period = (e - dp->last_active) & dp->mask;
+      }
+      cnt++;
+    }
+
+    if (active) {
+      dp->last_active = e;
+      dp->flags = (uint8_t)((dp->flags | EICU_DEC_HAVE_ACTIVE) &
+                            ~EICU_DEC_HAVE_IDLE);
+    }
+    else {
+      dp->last_idle = e;
+      if ((dp->flags & EICU_DEC_HAVE_ACTIVE) != 0U)
+        dp->flags |= EICU_DEC_HAVE_IDLE;
+    }
+  }
+
+  *countp = cnt;
+  return i;
+}
+#endif /* EICU_USE_DMA == TRUE */
+
 #endif /* HAL_USE_EICU */
@@ -32,6 +32,11 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/**
+ * @brief   Bad block table magic number, "NBBT".
+ */
+#define NAND_BBT_MAGIC          0x5442424EU
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -40,6 +45,35 @@
 /* Driver local types.                                                       */
 /*===========================================================================*/
 
+#if NAND_USE_BBT || defined(__DOXYGEN__)
+/**
+ * @brief   Bad block table header, first page of a table block.
+ * @details The map follows from the second page on.
+ */
+typedef struct {
+  /**
+   * @brief   Magic number.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief   Version, incremented on each update.
+   */
+  uint32_t                  version;
+  /**
+   * @brief   Number of blocks of the device.
+   */
+  uint32_t                  blocks;
+  /**
+   * @brief   Map size in bytes.
+   */
+  uint32_t                  size;
+  /**
+   * @brief   CRC32 of the header fields above and of the map.
+   */
+  uint32_t                  crc;
+} bbt_header_t;
+#endif /* NAND_USE_BBT */
+
 /*===========================================================================*/
 /* Driver local variables.                                                   */
 /*===========================================================================*/
@@ -173,6 +207,314 @@ static void scan_bad_blocks(NANDDriver *nandp) {
   }
 }
 
+/**
+ * @brief   Write badness mark to both first pages of block.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ *
+ * @notapi
+ */
+static void write_bad_mark(NANDDriver *nandp, uint32_t block) {
+
+  uint16_t bb_mark = 0;
+
+  nandWritePageSpare(nandp, block, 0, &bb_mark, sizeof(bb_mark));
+  nandWritePageSpare(nandp, block, 1, &bb_mark, sizeof(bb_mark));
+}
+
+#if NAND_USE_BBT || defined(__DOXYGEN__)
+/**
+ * @brief   Block number of a bad block table reserved block.
+ *
+ * @param[in] cfg           pointer to the @p NANDConfig
+ * @param[in] i             reserved block index, 0 is the last block
+ *
+ * @notapi
+ */
+static uint32_t bbt_block(const NANDConfig *cfg, size_t i) {
+
+  return cfg->blocks - 1 - i;
+}
+
+/**
+ * @brief   Size of the stored map in bytes, whole words covering all blocks.
+ *
+ * @param[in] cfg           pointer to the @p NANDConfig
+ *
+ * @notapi
+ */
+static size_t bbt_size(const NANDConfig *cfg) {
+
+  const size_t bits = sizeof(bitmap_word_t) * 8;
+
+  return ((cfg->blocks + bits - 1) / bits) * sizeof(bitmap_word_t);
+}
+
+/**
+ * @brief   CRC32 update, bitwise.
+ * @note    Only used at start and on table updates, no table needed.
+ *
+ * @param[in] crc           current CRC value
+ * @param[in] data          pointer to data
+ * @param[in] n             data length in bytes
+ *
+ * @notapi
+ */
+static uint32_t crc32_update(uint32_t crc, const void *data, size_t n) {
+
+  const uint8_t *p = data;
+  unsigned b;
+
+  while (n-- > 0) {
+    crc ^= *p++;
+    for (b=0; b<8; b++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return crc;
+}
+
+/**
+ * @brief   Bad block table CRC32.
+ *
+ * @param[in] hdr           pointer to the table header
+ * @param[in] map           pointer to the map
+ *
+ * @notapi
+ */
+static uint32_t bbt_crc(const bbt_header_t *hdr, const bitmap_t *map) {
+
+  uint32_t crc;
+
+  crc = crc32_update(0xFFFFFFFF, hdr, offsetof(bbt_header_t, crc));
+  return ~crc32_update(crc, map->array, hdr->size);
+}
+
+/**
+ * @brief   Read the map of a bad block table.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         table block number
+ * @param[in] size          map size in bytes
+ *
+ * @notapi
+ */
+static void bbt_read_map(NANDDriver *nandp, uint32_t block, size_t size) {
+
+  const size_t pagesize = nandp->config->page_data_size;
+  uint8_t *p = (uint8_t *)nandp->bb_map->array;
+  uint32_t page = 1;
+  size_t n;
+
+  while (size > 0) {
+    n = (size < pagesize) ? size : pagesize;
+    nandReadPageData(nandp, block, page++, p, n, NULL);
+    p += n;
+    size -= n;
+  }
+}
+
+/**
+ * @brief   Write a bad block table copy to an erased block.
+ * @details The header is written last, an interrupted update leaves a
+ *          copy without header.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         table block number
+ * @param[in] hdr           pointer to the table header
+ *
+ * @return                  The operation status.
+ * @retval true             if the copy has been written.
+ * @retval false            if the block failed.
+ *
+ * @notapi
+ */
+static bool bbt_write(NANDDriver *nandp, uint32_t block,
+                      const bbt_header_t *hdr) {
+
+  const size_t pagesize = nandp->config->page_data_size;
+  const uint8_t *p = (const uint8_t *)nandp->bb_map->array;
+  size_t size = hdr->size;
+  uint32_t page = 1;
+  size_t n;
+
+  while (size > 0) {
+    n = (size < pagesize) ? size : pagesize;
+    if (nandWritePageData(nandp, block, page++, p, n, NULL) & NAND_STATUS_FAIL)
+      return false;
+    p += n;
+    size -= n;
+  }
+
+  return 0 == (nandWritePageData(nandp, block, 0, hdr, sizeof(*hdr), NULL) &
+               NAND_STATUS_FAIL);
+}
+
+/**
+ * @brief   Store the bad block map as a new table version.
+ * @details The table and its mirror go to the first two good reserved
+ *          blocks, one after the other so that a valid copy always
+ *          exists. Reserved blocks failing are marked bad and skipped.
+ *
+ *          The new bad block, if any, is only marked after the first
+ *          copy has been erased. An update interrupted from there on
+ *          leaves the two copies different, @p load_bad_blocks() then
+ *          reads the bad marks again and the new block is not lost.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] mark          whether @p block has to be marked bad
+ * @param[in] block         block number of the new bad block
+ *
+ * @notapi
+ */
+static void bbt_save(NANDDriver *nandp, bool mark, uint32_t block) {
+
+  const NANDConfig *cfg = nandp->config;
+  bbt_header_t hdr;
+  unsigned copies = 0;
+  size_t i;
+
+  hdr.magic   = NAND_BBT_MAGIC;
+  hdr.version = nandp->bbt_version + 1;
+  hdr.blocks  = cfg->blocks;
+  hdr.size    = bbt_size(cfg);
+  hdr.crc     = bbt_crc(&hdr, nandp->bb_map);
+
+  for (i=0; (i<NAND_BBT_BLOCKS) && (copies<2); i++) {
+    if (nandp->bbt_bad & (1U << i))
+      continue;
+    if (0 == (nandErase(nandp, bbt_block(cfg, i)) & NAND_STATUS_FAIL)) {
+      if (mark) {
+        write_bad_mark(nandp, block);
+        mark = false;
+      }
+      if (bbt_write(nandp, bbt_block(cfg, i), &hdr)) {
+        copies++;
+        continue;
+      }
+    }
+    nandp->bbt_bad |= 1U << i;
+    write_bad_mark(nandp, bbt_block(cfg, i));
+  }
+
+  /* No reserved block left, the mark is the only record.*/
+  if (mark)
+    write_bad_mark(nandp, block);
+
+  nandp->bbt_version = hdr.version;
+}
+
+/**
+ * @brief   Load the newest valid bad block table.
+ * @details The last update is complete if the newest version is found in
+ *          two copies, or in the only good reserved block.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[out] complete     whether the last update is complete
+ *
+ * @return                  The operation status.
+ * @retval true             if a table has been loaded.
+ * @retval false            if no valid table exists.
+ *
+ * @notapi
+ */
+static bool bbt_load(NANDDriver *nandp, bool *complete) {
+
+  const NANDConfig *cfg = nandp->config;
+  const size_t size = bbt_size(cfg);
+  bbt_header_t hdr[NAND_BBT_BLOCKS];
+  uint32_t candidates = 0;
+  unsigned good = 0, copies = 0;
+  size_t i, best;
+
+  for (i=0; i<NAND_BBT_BLOCKS; i++) {
+    if (nandp->bbt_bad & (1U << i))
+      continue;
+    good++;
+    nandReadPageData(nandp, bbt_block(cfg, i), 0, &hdr[i], sizeof(hdr[i]),
+                     NULL);
+    if ((NAND_BBT_MAGIC == hdr[i].magic) && (cfg->blocks == hdr[i].blocks) &&
+        (size == hdr[i].size))
+      candidates |= 1U << i;
+  }
+
+  /* Newest first, falling back to the older copies on CRC errors.*/
+  *complete = true;
+  while (0 != candidates) {
+    best = NAND_BBT_BLOCKS;
+    for (i=0; i<NAND_BBT_BLOCKS; i++) {
+      if ((candidates & (1U << i)) &&
+          ((NAND_BBT_BLOCKS == best) || (hdr[i].version > hdr[best].version)))
+        best = i;
+    }
+    for (i=0; i<NAND_BBT_BLOCKS; i++) {
+      if ((candidates & (1U << i)) && (hdr[i].version == hdr[best].version))
+        copies++;
+    }
+    if (copies < ((good < 2) ? good : 2))
+      *complete = false;
+    candidates &= ~(1U << best);
+
+    bbt_read_map(nandp, bbt_block(cfg, best), size);
+    if (bbt_crc(&hdr[best], nandp->bb_map) == hdr[best].crc) {
+      nandp->bbt_version = hdr[best].version;
+      return true;
+    }
+    /* The newest copy is not usable, the older ones can miss blocks.*/
+    *complete = false;
+    copies = 0;
+  }
+  return false;
+}
+
+/**
+ * @brief   Fill the bad block map from the stored table or by scanning.
+ * @details Only the bad marks of the reserved blocks are read when a valid
+ *          table exists. Otherwise the whole device is scanned and the
+ *          table is stored for the next start.
+ *
+ *          When the last table update has been interrupted, the bad marks
+ *          of all blocks are merged into the loaded table and the table is
+ *          stored again, the block marked bad by that update is in the
+ *          marks only.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @notapi
+ */
+static void load_bad_blocks(NANDDriver *nandp) {
+
+  const NANDConfig *cfg = nandp->config;
+  bool complete;
+  size_t b, i;
+
+  osalDbgCheck(bitmapGetBitsCount(nandp->bb_map) >= cfg->blocks);
+  osalDbgCheck(cfg->blocks > NAND_BBT_BLOCKS);
+
+  bitmapObjectInit(nandp->bb_map, 0);
+  nandp->bbt_version = 0;
+  nandp->bbt_bad = 0;
+  for (i=0; i<NAND_BBT_BLOCKS; i++) {
+    if (read_is_block_bad(nandp, bbt_block(cfg, i)))
+      nandp->bbt_bad |= 1U << i;
+  }
+
+  if (!bbt_load(nandp, &complete)) {
+    scan_bad_blocks(nandp);
+    for (i=0; i<NAND_BBT_BLOCKS; i++)
+      bitmapSet(nandp->bb_map, bbt_block(cfg, i));
+    bbt_save(nandp, false, 0);
+  }
+  else if (!complete) {
+    for (b=0; b<cfg->blocks - NAND_BBT_BLOCKS; b++) {
+      if ((0 == bitmapGet(nandp->bb_map, b)) && read_is_block_bad(nandp, b))
+        bitmapSet(nandp->bb_map, b);
+    }
+    bbt_save(nandp, false, 0);
+  }
+}
+#endif /* NAND_USE_BBT */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -212,6 +554,8 @@ void nandObjectInit(NANDDriver *nandp) {
 
 /**
  * @brief   Configures and activates the NAND peripheral.
+ * @note    With @p NAND_USE_BBT the bad block map is loaded from the
+ *          stored table, the device is only scanned when none is valid.
  *
  * @param[in] nandp         pointer to the @p NANDDriver object
  * @param[in] config        pointer to the @p NANDConfig object
@@ -234,7 +578,11 @@ void nandStart(NANDDriver *nandp, const NANDConfig *config, bitmap_t *bb_map) {
 
   if (NULL != bb_map) {
     nandp->bb_map = bb_map;
+#if NAND_USE_BBT
+    load_bad_blocks(nandp);
+#else
     scan_bad_blocks(nandp);
+#endif
   }
 }
 
@@ -369,6 +717,148 @@ uint8_t nandWritePageData(NANDDriver *nandp, uint32_t block, uint32_t page,
   return retval;
 }
 
+/**
+ * @brief   Read consecutive pages data without spare area.
+ * @details The pages are moved back to back without waking the calling
+ *          thread in between. With devices supporting cache read the array
+ *          read of the next page overlaps the transfer of the current one.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ * @param[in] page          first page number related to begin of block
+ * @param[in] npages        number of pages, all in the same block
+ * @param[out] data         buffer to store data, @p npages times
+ *                          @p datalen bytes, half word aligned
+ * @param[in] datalen       length of data per page in bytes, half word
+ *                          aligned
+ * @param[out] ecc          array of @p npages calculated ECC. Ignored when
+ *                          NULL.
+ *
+ * @api
+ */
+void nandReadPages(NANDDriver *nandp, uint32_t block, uint32_t page,
+                   size_t npages, void *data, size_t datalen, uint32_t *ecc) {
+
+  const NANDConfig *cfg = nandp->config;
+  const size_t addrlen = cfg->rowcycles + cfg->colcycles;
+  uint8_t addr[addrlen];
+
+  osalDbgCheck((nandp != NULL) && (data != NULL) && (npages > 0));
+  osalDbgCheck((datalen <= cfg->page_data_size));
+  osalDbgCheck(page + npages <= cfg->pages_per_block);
+  osalDbgAssert(nandp->state == NAND_READY, "invalid state");
+
+  calc_addr(cfg, block, page, 0, addr, addrlen);
+  nand_lld_read_pages(nandp, data, datalen, npages, addr, addrlen, ecc);
+}
+
+/**
+ * @brief   Write consecutive pages data without spare area.
+ * @details The pages are programmed back to back without waking the calling
+ *          thread in between. With devices supporting cache program the
+ *          transfer of the next page overlaps the programming of the
+ *          current one.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ * @param[in] page          first page number related to begin of block
+ * @param[in] npages        number of pages, all in the same block
+ * @param[in] data          buffer with data to be written, @p npages times
+ *                          @p datalen bytes, half word aligned
+ * @param[in] datalen       length of data per page in bytes, half word
+ *                          aligned
+ * @param[out] ecc          array of @p npages calculated ECC. Ignored when
+ *                          NULL.
+ *
+ * @return    The operation status reported by NAND IC (0x70 command), with
+ *            @p NAND_STATUS_FAIL also set if any of the pages failed.
+ *
+ * @api
+ */
+uint8_t nandWritePages(NANDDriver *nandp, uint32_t block, uint32_t page,
+                       size_t npages, const void *data, size_t datalen,
+                       uint32_t *ecc) {
+
+  const NANDConfig *cfg = nandp->config;
+  const size_t addrlen = cfg->rowcycles + cfg->colcycles;
+  uint8_t addr[addrlen];
+
+  osalDbgCheck((nandp != NULL) && (data != NULL) && (npages > 0));
+  osalDbgCheck((datalen <= cfg->page_data_size));
+  osalDbgCheck(page + npages <= cfg->pages_per_block);
+  osalDbgAssert(nandp->state == NAND_READY, "invalid state");
+
+  calc_addr(cfg, block, page, 0, addr, addrlen);
+  return nand_lld_write_pages(nandp, data, datalen, npages, addr, addrlen,
+                              ecc);
+}
+
+#if NAND_USE_SOFT_ECC || defined(__DOXYGEN__)
+/**
+ * @brief   Read whole page and correct it with the software ECC.
+ * @details The ECC is taken from the spare area, as laid out by @p eccp.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ * @param[in] page          page number related to begin of block
+ * @param[in] eccp          pointer to an initialized @p nand_ecc_t object
+ * @param[out] data         buffer to store the whole page, data area
+ *                          followed by spare area, half word aligned
+ *
+ * @return                  The highest number of bits corrected in an ECC
+ *                          step.
+ * @retval NAND_ECC_UNCORRECTABLE if the data could not be corrected.
+ *
+ * @api
+ */
+int nandReadPageEcc(NANDDriver *nandp, uint32_t block, uint32_t page,
+                    const nand_ecc_t *eccp, void *data) {
+
+  const NANDConfig *cfg = nandp->config;
+  uint8_t *p = data;
+
+  osalDbgCheck((nandp != NULL) && (eccp != NULL) && (data != NULL));
+  osalDbgCheck(nandEccSpareSize(eccp, cfg->page_data_size) <=
+               cfg->page_spare_size);
+
+  nandReadPageWhole(nandp, block, page, data,
+                    cfg->page_data_size + cfg->page_spare_size);
+  return nandEccCorrect(eccp, p, cfg->page_data_size,
+                        &p[cfg->page_data_size]);
+}
+
+/**
+ * @brief   Write whole page with the software ECC.
+ * @details The ECC is computed into the spare area of @p data, as laid
+ *          out by @p eccp, the other spare bytes are written as they are.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ * @param[in] page          page number related to begin of block
+ * @param[in] eccp          pointer to an initialized @p nand_ecc_t object
+ * @param[in,out] data      buffer with the whole page, data area followed
+ *                          by spare area, half word aligned
+ *
+ * @return    The operation status reported by NAND IC (0x70 command).
+ *
+ * @api
+ */
+uint8_t nandWritePageEcc(NANDDriver *nandp, uint32_t block, uint32_t page,
+                         const nand_ecc_t *eccp, void *data) {
+
+  const NANDConfig *cfg = nandp->config;
+  uint8_t *p = data;
+
+  osalDbgCheck((nandp != NULL) && (eccp != NULL) && (data != NULL));
+  osalDbgCheck(nandEccSpareSize(eccp, cfg->page_data_size) <=
+               cfg->page_spare_size);
+
+  nandEccCalculate(eccp, p, cfg->page_data_size, &p[cfg->page_data_size]);
+  return nandWritePageWhole(nandp, block, page, data,
+                            cfg->page_data_size + cfg->page_spare_size);
+}
+#endif /* NAND_USE_SOFT_ECC */
+
 /**
  * @brief   Read page spare area.
  *
@@ -425,6 +915,7 @@ uint8_t nandWritePageSpare(NANDDriver *nandp, uint32_t block, uint32_t page,
 
 /**
  * @brief   Mark block as bad.
+ * @note    With @p NAND_USE_BBT the stored table is updated too.
  *
  * @param[in] nandp         pointer to the @p NANDDriver object
  * @param[in] block         block number
@@ -433,10 +924,16 @@ uint8_t nandWritePageSpare(NANDDriver *nandp, uint32_t block, uint32_t page,
  */
 void nandMarkBad(NANDDriver *nandp, uint32_t block) {
 
-  uint16_t bb_mark = 0;
+#if NAND_USE_BBT
+  if ((NULL != nandp->bb_map) && (0 == bitmapGet(nandp->bb_map, block))) {
+    /* The mark is written by the table update, see bbt_save().*/
+    bitmapSet(nandp->bb_map, block);
+    bbt_save(nandp, true, block);
+    return;
+  }
+#endif
 
-  nandWritePageSpare(nandp, block, 0, &bb_mark, sizeof(bb_mark));
-  nandWritePageSpare(nandp, block, 1, &bb_mark, sizeof(bb_mark));
+  write_bad_mark(nandp, block);
 
   if (NULL != nandp->bb_map)
     bitmapSet(nandp->bb_map, block);
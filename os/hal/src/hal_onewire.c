@@ -34,6 +34,16 @@
 
 For data write it is only master channel needed. Data bit width updates
 on every timer overflow event.
+
+UART backend (ONEWIRE_USE_UART):
+
+1) connect UART TX and RX to the bus (half duplex, open drain TX).
+2) every timeslot is one character, its echo is the sampled bus state:
+   - reset:        0xF0 at 9600 baud, presence if the echo differs,
+   - write 1/read: 0xFF at 115200 baud, 1 read if the echo is still 0xFF,
+   - write 0:      0x00 at 115200 baud.
+3) whole transfers are received in one UART operation, so a transaction
+   costs one completion interrupt instead of one or two per bit.
 */
 
 /*===========================================================================*/
@@ -57,6 +67,7 @@ on every timer overflow event.
 
 #if (HAL_USE_ONEWIRE == TRUE) || defined(__DOXYGEN__)
 
+#include <stddef.h>
 #include <string.h>
 #include <limits.h>
 
@@ -81,6 +92,37 @@ on every timer overflow event.
 #define ONEWIRE_RESET_SAMPLE_WIDTH    550
 #define ONEWIRE_RESET_TOTAL_WIDTH     960
 
+#if ONEWIRE_USE_UART
+/**
+ * @brief     UART speeds for reset pulses and data timeslots.
+ */
+#define ONEWIRE_UART_RESET_SPEED      9600
+#define ONEWIRE_UART_DATA_SPEED       115200
+#define ONEWIRE_UART_OD_RESET_SPEED   115200
+#define ONEWIRE_UART_OD_DATA_SPEED    1000000
+
+/**
+ * @brief     UART characters generating timeslots.
+ * @note      The overdrive reset character keeps the bus low for 6 bit
+ *            times (52us), the presence pulse follows within the same
+ *            character.
+ */
+#define ONEWIRE_UART_RESET            0xF0
+#define ONEWIRE_UART_OD_RESET         0xE0
+#define ONEWIRE_UART_WRITE_1          0xFF
+#define ONEWIRE_UART_WRITE_0          0x00
+
+/**
+ * @brief     UART speed for data timeslots at current bus speed.
+ */
+#define ow_uart_data_speed(owp)                                             \
+  ((owp)->reg.overdrive ? ONEWIRE_UART_OD_DATA_SPEED : ONEWIRE_UART_DATA_SPEED)
+
+/**
+ * @brief     Local function declarations.
+ */
+static void uart_rxend_cb(UARTDriver *uartp);
+#else /* !ONEWIRE_USE_UART */
 /**
  * @brief     Local function declarations.
  */
@@ -94,6 +136,7 @@ static void pwm_write_bit_cb(PWMDriver *pwmp);
 static void ow_search_rom_cb(PWMDriver *pwmp, onewireDriver *owp);
 static void pwm_search_rom_cb(PWMDriver *pwmp);
 #endif
+#endif /* !ONEWIRE_USE_UART */
 
 /*===========================================================================*/
 /* Driver exported variables.                                                */
@@ -147,6 +190,146 @@ static const uint8_t onewire_crc_table[256] = {
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
+/**
+ * @brief     Function performing read of single bit.
+ * @note      It must be callable from any context.
+ */
+static ioline_t ow_read_bit(onewireDriver *owp) {
+#if ONEWIRE_SYNTH_SEARCH_TEST
+  (void)owp;
+  return _synth_ow_read_bit();
+#else
+  return palReadPad(owp->config->port, owp->config->pad);
+#endif
+}
+
+#if ONEWIRE_USE_UART
+/**
+ * @brief     UART adapter
+ */
+static void uart_rxend_cb(UARTDriver *uartp) {
+
+  /* The UART runs with the configuration copy inside the driver.*/
+  onewireDriver *owp = (onewireDriver *)(void *)((uint8_t *)uartp->config -
+                       offsetof(onewireDriver, uartcfg));
+
+#if ONEWIRE_USE_STRONG_PULLUP
+  if (owp->reg.need_pullup && owp->reg.final_timeslot) {
+    owp->reg.state = ONEWIRE_PULL_UP;
+    owp->config->pullup_assert();
+    owp->reg.need_pullup = false;
+  }
+#endif
+
+  osalSysLockFromISR();
+  osalThreadResumeI(&owp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief     Switches the UART speed, if needed.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] speed     UART speed, in baud
+ *
+ * @notapi
+ */
+static void ow_uart_speed(onewireDriver *owp, uint32_t speed) {
+  if (owp->uartcfg.speed != speed) {
+    owp->uartcfg.speed = speed;
+    /* Restarting an active UART only reprograms it.*/
+    uartStart(owp->config->uartd, &owp->uartcfg);
+  }
+}
+
+/**
+ * @brief     Sends the timeslot buffer and samples the bus in place.
+ * @details   Returns after the echo of the last timeslot, on a single
+ *            receive completion interrupt.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] n         number of timeslots
+ *
+ * @notapi
+ */
+static void ow_uart_xfer(onewireDriver *owp, size_t n) {
+  UARTDriver *uartp = owp->config->uartd;
+
+  osalSysLock();
+  uartStartReceiveI(uartp, n, owp->uart_buf);
+  uartStartSendI(uartp, n, owp->uart_buf);
+  osalThreadSuspendS(&owp->thread);
+  osalSysUnlock();
+}
+
+/**
+ * @brief     Reads bytes, one chunk of timeslots at a time.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[out] rxbuf    pointer to the buffer for read data
+ * @param[in] rxbytes   amount of data to be received
+ *
+ * @notapi
+ */
+static void ow_uart_read(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+  const uint8_t *slot;
+  size_t n, i;
+  uint8_t bit;
+
+  ow_uart_speed(owp, ow_uart_data_speed(owp));
+  while (rxbytes > 0) {
+    n = rxbytes < (ONEWIRE_UART_BUFFER_SIZE / 8U) ?
+        rxbytes : (ONEWIRE_UART_BUFFER_SIZE / 8U);
+    memset(owp->uart_buf, ONEWIRE_UART_WRITE_1, n * 8U);
+    ow_uart_xfer(owp, n * 8U);
+
+    slot = owp->uart_buf;
+    for (i = 0; i < n; i++) {
+      for (bit = 0; bit < 8; bit++) {
+        if (ONEWIRE_UART_WRITE_1 == *slot++)
+          rxbuf[i] |= 1U << bit;
+      }
+    }
+    rxbuf += n;
+    rxbytes -= n;
+  }
+}
+
+/**
+ * @brief     Writes bytes, one chunk of timeslots at a time.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] txbuf     pointer to the buffer with data to be written
+ * @param[in] txbytes   amount of data to be written
+ *
+ * @notapi
+ */
+static void ow_uart_write(onewireDriver *owp, const uint8_t *txbuf,
+                          size_t txbytes) {
+  uint8_t *slot;
+  size_t n, i;
+  uint8_t bit;
+
+  ow_uart_speed(owp, ow_uart_data_speed(owp));
+  while (txbytes > 0) {
+    n = txbytes < (ONEWIRE_UART_BUFFER_SIZE / 8U) ?
+        txbytes : (ONEWIRE_UART_BUFFER_SIZE / 8U);
+    slot = owp->uart_buf;
+    for (i = 0; i < n; i++) {
+      for (bit = 0; bit < 8; bit++) {
+        *slot++ = ((txbuf[i] >> bit) & 1U) ?
+                  ONEWIRE_UART_WRITE_1 : ONEWIRE_UART_WRITE_0;
+      }
+    }
+    txbuf += n;
+    txbytes -= n;
+
+    /* strong pull up, if needed, is asserted on the last echo */
+    owp->reg.final_timeslot = (0 == txbytes);
+    ow_uart_xfer(owp, n * 8U);
+  }
+}
+#else /* !ONEWIRE_USE_UART */
 /**
  * @brief     Put bus in idle mode.
  */
@@ -169,19 +352,6 @@ static void ow_bus_active(onewireDriver *owp) {
 #endif
 }
 
-/**
- * @brief     Function performing read of single bit.
- * @note      It must be callable from any context.
- */
-static ioline_t ow_read_bit(onewireDriver *owp) {
-#if ONEWIRE_SYNTH_SEARCH_TEST
-  (void)owp;
-  return _synth_ow_read_bit();
-#else
-  return palReadPad(owp->config->port, owp->config->pad);
-#endif
-}
-
 /**
  * @brief     PWM adapter
  */
@@ -340,6 +510,7 @@ static void ow_write_bit_cb(PWMDriver *pwmp, onewireDriver *owp) {
   ow_write_bit_I(owp, (*owp->buf >> owp->reg.bit) & 1);
   owp->reg.bit++;
 }
+#endif /* !ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_SEARCH_ROM
 /**
@@ -422,6 +593,72 @@ static uint8_t collision_handler(onewire_search_rom_t *sr) {
   }
 }
 
+#if ONEWIRE_USE_UART
+/**
+ * @brief     Discovers one ROM, after the 'search ROM' command.
+ * @details   The write timeslot of every ROM bit is sent together with the
+ *            two read timeslots of the next one, so a ROM costs 64
+ *            interrupts instead of about 200.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ *
+ * @notapi
+ */
+static void ow_uart_search_rom(onewireDriver *owp) {
+
+  onewire_search_rom_t *sr = &owp->search_rom;
+  uint8_t *buf = owp->uart_buf;
+  uint8_t bit;
+
+  ow_uart_speed(owp, ow_uart_data_speed(owp));
+  buf[0] = ONEWIRE_UART_WRITE_1;
+  buf[1] = ONEWIRE_UART_WRITE_1;
+  ow_uart_xfer(owp, 2);
+
+  while (true) {
+    sr->reg.bit_buf = (ONEWIRE_UART_WRITE_1 == buf[0]) |
+                      ((ONEWIRE_UART_WRITE_1 == buf[1]) << 1);
+    switch(sr->reg.bit_buf){
+    case 0b11:
+      /* no one device on bus or any other fail happened */
+      sr->reg.result = ONEWIRE_SEARCH_ROM_ERROR;
+      return;
+    case 0b01:
+      /* all slaves have 1 in this position */
+      store_bit(sr, 1);
+      bit = 1;
+      break;
+    case 0b10:
+      /* all slaves have 0 in this position */
+      store_bit(sr, 0);
+      bit = 0;
+      break;
+    default:
+      /* collision */
+      sr->reg.single_device = false;
+      bit = collision_handler(sr);
+      break;
+    }
+
+    buf[0] = (0 == bit) ? ONEWIRE_UART_WRITE_0 : ONEWIRE_UART_WRITE_1;
+    if (64 == sr->reg.rombit) {
+      ow_uart_xfer(owp, 1);
+      break;
+    }
+    buf[1] = ONEWIRE_UART_WRITE_1;
+    buf[2] = ONEWIRE_UART_WRITE_1;
+    ow_uart_xfer(owp, 3);
+    buf[0] = buf[1];
+    buf[1] = buf[2];
+  }
+
+  /* one ROM successfully discovered */
+  sr->reg.devices_found++;
+  sr->reg.search_iter = ONEWIRE_SEARCH_ROM_NEXT;
+  if (true == sr->reg.single_device)
+    sr->reg.result = ONEWIRE_SEARCH_ROM_LAST;
+}
+#else /* !ONEWIRE_USE_UART */
 /**
  * @brief     1-wire search ROM callback.
  * @note      Must be called from PWM's ISR.
@@ -495,6 +732,7 @@ THE_END:
   osalSysUnlockFromISR();
 #endif
 }
+#endif /* !ONEWIRE_USE_UART */
 
 /**
  * @brief       Helper function. Initialize structures required by 'search ROM'.
@@ -573,6 +811,7 @@ void onewireObjectInit(onewireDriver *owp) {
   owp->reg.bytes = 0;
   owp->reg.bit = 0;
   owp->reg.final_timeslot = false;
+  owp->reg.overdrive = false;
   owp->buf = NULL;
 
 #if ONEWIRE_USE_STRONG_PULLUP
@@ -591,8 +830,13 @@ void onewireObjectInit(onewireDriver *owp) {
 void onewireStart(onewireDriver *owp, const onewireConfig *config) {
 
   osalDbgCheck((NULL != owp) && (NULL != config));
+#if ONEWIRE_USE_UART
+  osalDbgAssert(UART_STOP == config->uartd->state,
+      "UART will be started by onewire driver internally");
+#else
   osalDbgAssert(PWM_STOP == config->pwmd->state,
       "PWM will be started by onewire driver internally");
+#endif
   osalDbgAssert(ONEWIRE_STOP == owp->reg.state, "Invalid state");
 #if ONEWIRE_USE_STRONG_PULLUP
   osalDbgCheck((NULL != config->pullup_assert) &&
@@ -600,6 +844,14 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
 #endif
 
   owp->config = config;
+#if ONEWIRE_USE_UART
+  owp->uartcfg = *config->uartcfg;
+  owp->uartcfg.rxend_cb = uart_rxend_cb;
+  owp->uartcfg.speed = ONEWIRE_UART_DATA_SPEED;
+  palSetPadMode(owp->config->port, owp->config->pad,
+      owp->config->pad_mode_active);
+  uartStart(owp->config->uartd, &owp->uartcfg);
+#else
   owp->config->pwmcfg->frequency = ONEWIRE_PWM_FREQUENCY;
   owp->config->pwmcfg->period = ONEWIRE_RESET_TOTAL_WIDTH;
 
@@ -608,11 +860,12 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
       owp->config->pad_mode_active);
 #endif
   ow_bus_idle(owp);
+#endif
   owp->reg.state = ONEWIRE_READY;
 }
 
 /**
- * @brief   Deactivates the UART peripheral.
+ * @brief   Deactivates the 1-wire driver.
  *
  * @param[in] owp       pointer to the @p onewireDriver object
  *
@@ -623,8 +876,12 @@ void onewireStop(onewireDriver *owp) {
 #if ONEWIRE_USE_STRONG_PULLUP
   owp->config->pullup_release();
 #endif
+#if ONEWIRE_USE_UART
+  uartStop(owp->config->uartd);
+#else
   ow_bus_idle(owp);
   pwmStop(owp->config->pwmd);
+#endif
   owp->config = NULL;
   owp->reg.state = ONEWIRE_STOP;
 }
@@ -638,9 +895,13 @@ void onewireStop(onewireDriver *owp) {
  * @retval true         There is at least one device on bus.
  */
 bool onewireReset(onewireDriver *owp) {
+#if ONEWIRE_USE_UART
+  uint8_t reset, echo;
+#else
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck(NULL != owp);
   osalDbgAssert(owp->reg.state == ONEWIRE_READY, "Invalid state");
@@ -649,6 +910,23 @@ bool onewireReset(onewireDriver *owp) {
   if (PAL_LOW == ow_read_bit(owp))
     return false;
 
+#if ONEWIRE_USE_UART
+  if (owp->reg.overdrive) {
+    ow_uart_speed(owp, ONEWIRE_UART_OD_RESET_SPEED);
+    owp->uart_buf[0] = ONEWIRE_UART_OD_RESET;
+  }
+  else {
+    ow_uart_speed(owp, ONEWIRE_UART_RESET_SPEED);
+    owp->uart_buf[0] = ONEWIRE_UART_RESET;
+  }
+  reset = owp->uart_buf[0];
+  ow_uart_xfer(owp, 1);
+  echo = owp->uart_buf[0];
+
+  /* presence pulse changes the echo, a stuck bus zeroes it */
+  owp->reg.slave_present = (reset != echo) && (0 != echo);
+  return (true == owp->reg.slave_present);
+#else
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -676,6 +954,7 @@ bool onewireReset(onewireDriver *owp) {
   /* wait until slave release bus to discriminate short circuit condition */
   osalThreadSleepMicroseconds(500);
   return (PAL_HIGH == ow_read_bit(owp)) && (true == owp->reg.slave_present);
+#endif
 }
 
 /**
@@ -686,9 +965,11 @@ bool onewireReset(onewireDriver *owp) {
  * @param[in] rxbytes   amount of data to be received
  */
 void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != rxbuf));
   osalDbgCheck((rxbytes > 0) && (rxbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -698,6 +979,9 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
      bits using |= operation.*/
   memset(rxbuf, 0, rxbytes);
 
+#if ONEWIRE_USE_UART
+  ow_uart_read(owp, rxbuf, rxbytes);
+#else
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -724,6 +1008,7 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
   osalSysUnlock();
 
   ow_bus_idle(owp);
+#endif
 }
 
 /**
@@ -737,9 +1022,11 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
  */
 void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
                   size_t txbytes, systime_t pullup_time) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != txbuf));
   osalDbgCheck((txbytes > 0) && (txbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -749,6 +1036,16 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
       "Non zero time is valid only when strong pull enabled");
 #endif
 
+#if ONEWIRE_USE_UART
+#if ONEWIRE_USE_STRONG_PULLUP
+  if (pullup_time > 0) {
+    owp->reg.state = ONEWIRE_PULL_UP;
+    owp->reg.need_pullup = true;
+  }
+#endif
+
+  ow_uart_write(owp, txbuf, txbytes);
+#else /* !ONEWIRE_USE_UART */
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -781,6 +1078,7 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
 
   pwmDisablePeriodicNotification(pwmd);
   ow_bus_idle(owp);
+#endif /* !ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_STRONG_PULLUP
   if (pullup_time > 0) {
@@ -791,6 +1089,34 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
 #endif
 }
 
+/**
+ * @brief     Switches timeslots between standard and overdrive speed.
+ * @details   Only the timing of the master changes: devices are switched
+ *            to overdrive by the @p ONEWIRE_CMD_OVERDRIVE_SKIP_ROM or
+ *            @p ONEWIRE_CMD_OVERDRIVE_MATCH_ROM commands, sent at standard
+ *            speed, and back to standard speed by a standard reset pulse.
+ * @note      Overdrive is supported by the UART backend only.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] enable    @p true for overdrive, @p false for standard speed
+ *
+ * @return              Speed switch result.
+ * @retval true         Speed switched.
+ * @retval false        Speed not supported by the backend.
+ */
+bool onewireSetOverdrive(onewireDriver *owp, bool enable) {
+
+  osalDbgCheck(NULL != owp);
+  osalDbgAssert(owp->reg.state == ONEWIRE_READY, "Invalid state");
+
+#if ONEWIRE_USE_UART
+  owp->reg.overdrive = enable;
+  return true;
+#else
+  return !enable;
+#endif
+}
+
 #if ONEWIRE_USE_SEARCH_ROM
 /**
  * @brief   Performs tree search on bus.
@@ -798,28 +1124,33 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
  *          iteration.
  *
  * @param[in] owp         pointer to a @p OWDriver object
+ * @param[in] cmd         search command
  * @param[out] result     pointer to buffer for discovered ROMs
  * @param[in] max_rom_cnt buffer size in ROMs count for overflow prevention
  *
  * @return              Count of discovered ROMs. May be more than max_rom_cnt.
  * @retval 0            no ROMs found or communication error occurred.
+ *
+ * @notapi
  */
-size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
+static size_t ow_search(onewireDriver *owp, uint8_t cmd, uint8_t *result,
                         size_t max_rom_cnt) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
-  uint8_t cmd;
   size_t mch, sch;
+#endif
 
   osalDbgCheck(NULL != owp);
   osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
   osalDbgCheck((max_rom_cnt <= 256) && (max_rom_cnt > 0));
 
+#if !ONEWIRE_USE_UART
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
-  cmd = ONEWIRE_CMD_SEARCH_ROM;
   mch = owp->config->master_channel;
   sch = owp->config->sample_channel;
+#endif
 
   search_clean_start(&owp->search_rom);
 
@@ -839,8 +1170,11 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
     search_clean_iteration(&owp->search_rom);
 
     /**/
-    onewireWrite(&OWD1, &cmd, 1, 0);
+    onewireWrite(owp, &cmd, 1, 0);
 
+#if ONEWIRE_USE_UART
+    ow_uart_search_rom(owp);
+#else
     /* Reconfiguration always needed because of previous call onewireWrite.*/
     pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
     pwmcfg->callback = NULL;
@@ -858,6 +1192,7 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
     osalSysUnlock();
 
     ow_bus_idle(owp);
+#endif
 
     if (ONEWIRE_SEARCH_ROM_ERROR != owp->search_rom.reg.result) {
       /* check CRC and return 0 (0 == error) if mismatch */
@@ -875,6 +1210,43 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
   else
     return owp->search_rom.reg.devices_found;
 }
+
+/**
+ * @brief   Performs tree search on bus.
+ * @note    This function does internal 1-wire reset calls every search
+ *          iteration.
+ *
+ * @param[in] owp         pointer to a @p OWDriver object
+ * @param[out] result     pointer to buffer for discovered ROMs
+ * @param[in] max_rom_cnt buffer size in ROMs count for overflow prevention
+ *
+ * @return              Count of discovered ROMs. May be more than max_rom_cnt.
+ * @retval 0            no ROMs found or communication error occurred.
+ */
+size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
+                        size_t max_rom_cnt) {
+
+  return ow_search(owp, ONEWIRE_CMD_SEARCH_ROM, result, max_rom_cnt);
+}
+
+/**
+ * @brief   Performs conditional tree search on bus.
+ * @details Only devices with their alarm condition set take part to the
+ *          search.
+ *
+ * @param[in] owp         pointer to a @p OWDriver object
+ * @param[out] result     pointer to buffer for discovered ROMs
+ * @param[in] max_rom_cnt buffer size in ROMs count for overflow prevention
+ *
+ * @return              Count of discovered ROMs. May be more than max_rom_cnt.
+ * @retval 0            no alarms, no ROMs found or communication error
+ *                      occurred.
+ */
+size_t onewireSearchAlarm(onewireDriver *owp, uint8_t *result,
+                          size_t max_rom_cnt) {
+
+  return ow_search(owp, ONEWIRE_CMD_ALARM_SEARCH, result, max_rom_cnt);
+}
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
 /*
@@ -0,0 +1,71 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_pixfmt.c
+ * @brief   Pixel format conversion library, run-time dispatcher.
+ *
+ * @addtogroup pixfmt
+ * @{
+ */
+
+#include "hal.h"
+
+#if (defined(STM32_LTDC_USE_LTDC) && (STM32_LTDC_USE_LTDC == TRUE)) ||      \
+    (defined(STM32_DMA2D_USE_DMA2D) && (STM32_DMA2D_USE_DMA2D == TRUE)) ||  \
+    defined(__DOXYGEN__)
+
+#include "hal_pixfmt.h"
+
+/*===========================================================================*/
+/* Local variables.                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief   Span conversion kernels, by source and destination format.
+ */
+PIXFMT_SPAN_TABLE(pixfmt_spans);
+
+/*===========================================================================*/
+/* Exported functions.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts a span of pixels.
+ * @details The conversion kernel is selected once for the whole span.
+ * @note    4-bit spans must start on a byte boundary.
+ *
+ * @param[in] srcp      source pixels
+ * @param[in] srcfmt    source pixel format
+ * @param[out] dstp     destination pixels
+ * @param[in] dstfmt    destination pixel format
+ * @param[in] n         number of pixels
+ *
+ * @api
+ */
+void pixfmtConvertSpan(const void *srcp, unsigned srcfmt,
+                       void *dstp, unsigned dstfmt, size_t n) {
+
+  osalDbgCheck((srcp != NULL) && (dstp != NULL));
+  osalDbgAssert((srcfmt < PIXFMT_COUNT) && (dstfmt < PIXFMT_COUNT),
+                "invalid format");
+
+  pixfmt_spans[srcfmt][dstfmt](srcp, dstp, n);
+}
+
+#endif /* STM32_LTDC_USE_LTDC || STM32_DMA2D_USE_DMA2D */
+
+/** @} */
@@ -21,10 +21,21 @@
 
 #if (HAL_USE_RNG == TRUE) || defined(__DOXYGEN__)
 
+#include <string.h>
+
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#define RNG_SERVICE_THD_PRIO            NORMALPRIO
+
+#define RNG_SERVICE_THD_WA_SIZE         768
+
+/**
+ * @brief   Raw samples health tested before the first seeding.
+ */
+#define RNG_SERVICE_STARTUP_SAMPLES     1024U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -33,10 +44,137 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (RNG_USE_CSPRNG == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Random service.
+ */
+static struct {
+  /**
+   * @brief   Service generator, reseeded from the hardware.
+   */
+  csprng_t                  drbg;
+  /**
+   * @brief   Protects @p drbg.
+   */
+  mutex_t                   mutex;
+  /**
+   * @brief   Reseed count, zero until the first seeding.
+   */
+  volatile uint32_t         epoch;
+  /**
+   * @brief   Threads waiting for the first seeding.
+   */
+  threads_queue_t           waiting;
+  /**
+   * @brief   Raw source health tests.
+   */
+  csprng_health_t           health;
+  /**
+   * @brief   Health tests failures count.
+   */
+  volatile uint32_t         failures;
+  /**
+   * @brief   Feeder thread.
+   */
+  thread_t                  *thread;
+} rng_service;
+
+/**
+ * @brief   Feeder thread working area.
+ */
+static THD_WORKING_AREA(wa_rng_service, RNG_SERVICE_THD_WA_SIZE);
+#endif /* RNG_USE_CSPRNG == TRUE */
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (RNG_USE_CSPRNG == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Random service feeder thread.
+ * @details Collects raw bytes from the RNG driver, runs the health tests
+ *          on them and reseeds the service generator. Samples are read one
+ *          at a time, some drivers produce them with the system locked.
+ *
+ * @param[in] arg       pointer to the @p RNGDriver object
+ *
+ * @notapi
+ */
+static THD_FUNCTION(rng_service_thread, arg) {
+  RNGDriver *rngp = arg;
+  uint8_t pool[RNG_CSPRNG_POOL_SIZE];
+  size_t i;
+
+  chRegSetThreadName("rng_service");
+
+  while (!chThdShouldTerminateX()) {
+    for (i = 0U; i < sizeof pool; i++) {
+      if (rngWrite(rngp, &pool[i], 1U, OSAL_MS2I(100)) != MSG_OK) {
+        break;
+      }
+    }
+
+    if (i < sizeof pool) {
+      /* Driver timeout, the partial pool is discarded.*/
+      continue;
+    }
+
+    if (!csprngHealthTest(&rng_service.health, pool, sizeof pool)) {
+      /* Source failure, startup testing starts over.*/
+      rng_service.failures++;
+      csprngHealthInit(&rng_service.health, RNG_CSPRNG_MIN_ENTROPY);
+    }
+    else if (rng_service.health.samples >= RNG_SERVICE_STARTUP_SAMPLES) {
+      osalMutexLock(&rng_service.mutex);
+      csprngReseed(&rng_service.drbg, pool, sizeof pool);
+      osalMutexUnlock(&rng_service.mutex);
+
+      osalSysLock();
+      if (++rng_service.epoch == 0U) {
+        rng_service.epoch = 1U;
+      }
+      osalThreadDequeueAllI(&rng_service.waiting, MSG_OK);
+      osalOsRescheduleS();
+      osalSysUnlock();
+
+      memset(pool, 0, sizeof pool);
+      osalThreadSleepMilliseconds(RNG_CSPRNG_RESEED_INTERVAL);
+    }
+  }
+
+  memset(pool, 0, sizeof pool);
+  chThdExit(MSG_OK);
+}
+
+/**
+ * @brief   Reseeds a stream from the service generator.
+ * @details Waits for the first seeding of the service.
+ *
+ * @param[in] sp        pointer to the @p RNGStream object
+ *
+ * @notapi
+ */
+static void stream_reseed(RNGStream *sp) {
+  uint8_t seed[CSPRNG_KEY_SIZE];
+  uint32_t epoch;
+
+  osalSysLock();
+  while (rng_service.epoch == 0U) {
+    (void) osalThreadEnqueueTimeoutS(&rng_service.waiting, TIME_INFINITE);
+  }
+  osalSysUnlock();
+
+  osalMutexLock(&rng_service.mutex);
+  epoch = rng_service.epoch;
+  csprngGenerate(&rng_service.drbg, seed, sizeof seed);
+  osalMutexUnlock(&rng_service.mutex);
+
+  csprngReseed(&sp->drbg, seed, sizeof seed);
+  memset(seed, 0, sizeof seed);
+  sp->epoch = epoch;
+}
+#endif /* RNG_USE_CSPRNG == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -48,6 +186,14 @@
  */
 void rngInit(void) {
   rng_lld_init();
+#if RNG_USE_CSPRNG == TRUE
+  csprngInit(&rng_service.drbg, NULL, 0U);
+  osalMutexObjectInit(&rng_service.mutex);
+  osalThreadQueueObjectInit(&rng_service.waiting);
+  rng_service.epoch    = 0U;
+  rng_service.failures = 0U;
+  rng_service.thread   = NULL;
+#endif
 }
 
 /**
@@ -179,4 +325,100 @@ void rngReleaseUnit(RNGDriver *rngp) {
 }
 #endif /* RNG_USE_MUTUAL_EXCLUSION == TRUE */
 
+#if (RNG_USE_CSPRNG == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the random service.
+ * @details The service owns the driver from now on, it must not be used
+ *          directly until @p rngServiceStop().
+ * @pre     The driver must be started.
+ * @pre     In order to use this function the option @p RNG_USE_CSPRNG
+ *          must be enabled.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object feeding the
+ *                      service
+ *
+ * @api
+ */
+void rngServiceStart(RNGDriver *rngp) {
+  osalDbgCheck(rngp != NULL);
+  osalDbgAssert(rngp->state == RNG_READY, "not ready");
+  osalDbgAssert(rng_service.thread == NULL, "already started");
+
+  /* The generator state is kept across restarts, the streams seeded from
+     it stay valid.*/
+  csprngHealthInit(&rng_service.health, RNG_CSPRNG_MIN_ENTROPY);
+  rng_service.thread   = chThdCreateStatic(wa_rng_service,
+                                           sizeof(wa_rng_service),
+                                           RNG_SERVICE_THD_PRIO,
+                                           rng_service_thread, rngp);
+}
+
+/**
+ * @brief   Stops the random service.
+ * @note    Streams keep working from their current state, threads reading
+ *          a stream not seeded yet stay waiting until the service is
+ *          started again.
+ *
+ * @api
+ */
+void rngServiceStop(void) {
+
+  osalDbgAssert(rng_service.thread != NULL, "not started");
+
+  chThdTerminate(rng_service.thread);
+  chThdWait(rng_service.thread);
+  rng_service.thread = NULL;
+}
+
+/**
+ * @brief   Number of health tests failures of the raw source.
+ * @details The service is not reseeded from failing samples.
+ *
+ * @return              The failures count since initialization.
+ *
+ * @api
+ */
+uint32_t rngServiceHealthFailures(void) {
+
+  return rng_service.failures;
+}
+
+/**
+ * @brief   Initializes a random stream.
+ *
+ * @param[out] sp       pointer to the @p RNGStream object
+ *
+ * @init
+ */
+void rngStreamObjectInit(RNGStream *sp) {
+  osalDbgCheck(sp != NULL);
+
+  csprngInit(&sp->drbg, NULL, 0U);
+  sp->epoch = 0U;
+}
+
+/**
+ * @brief   Reads random bytes from a stream.
+ * @details Bytes come from the stream generator without locking, the
+ *          service is only accessed when it has reseeded since the last
+ *          read. The first read waits for the service first seeding.
+ * @note    A stream must not be shared between threads.
+ *
+ * @param[in] sp        pointer to the @p RNGStream object
+ * @param[out] buf      output buffer
+ * @param[in] n         number of bytes
+ *
+ * @api
+ */
+void rngStreamRead(RNGStream *sp, uint8_t *buf, size_t n) {
+  osalDbgCheck((sp != NULL) && (buf != NULL));
+
+  /* A zero epoch is an unseeded stream, its key is all zeros.*/
+  if ((sp->epoch == 0U) || (sp->epoch != rng_service.epoch)) {
+    stream_reseed(sp);
+  }
+  csprngGenerate(&sp->drbg, buf, n);
+}
+#endif /* RNG_USE_CSPRNG == TRUE */
+
 #endif /* HAL_USE_RNG */
@@ -168,11 +168,16 @@ static uint32_t scsi_transport_transmit(const SCSITransport *transport,
                                         const uint8_t *data, size_t len) {
 
   usb_scsi_transport_handler_t *trp = transport->handler;
-  msg_t status = usbTransmit(trp->usbp, trp->ep, data, len);
-  if (MSG_OK == status)
-    return len;
-  else
-    return 0;
+  size_t done = 0;
+
+  while (done < len) {
+    const size_t n = ((len - done) < USB_MSD_MAX_TRANSFER_SIZE) ?
+                     (len - done) : USB_MSD_MAX_TRANSFER_SIZE;
+    if (MSG_OK != usbTransmit(trp->usbp, trp->ep, &data[done], n))
+      break;
+    done += n;
+  }
+  return done;
 }
 
 /**
@@ -190,15 +195,38 @@ static uint32_t scsi_transport_receive(const SCSITransport *transport,
                                        uint8_t *data, size_t len) {
 
   usb_scsi_transport_handler_t *trp = transport->handler;
-  msg_t status = usbReceive(trp->usbp, trp->ep, data, len);
-  if (MSG_RESET != status)
-    return status;
-  else
-    return 0;
+  size_t done = 0;
+
+  while (done < len) {
+    const size_t n = ((len - done) < USB_MSD_MAX_TRANSFER_SIZE) ?
+                     (len - done) : USB_MSD_MAX_TRANSFER_SIZE;
+    msg_t status = usbReceive(trp->usbp, trp->ep, &data[done], n);
+    if (MSG_RESET == status)
+      break;
+    done += status;
+    if ((size_t)status < n)
+      break;    /* short packet, the host ended the data phase */
+  }
+  return done;
+}
+
+/**
+ * @brief   Prepares the CSW message for the current CBW.
+ * @details Done before the command is executed, only status and residue
+ *          are left to be filled once the data phase ends.
+ *
+ * @param[in] msdp      pointer to the @p USBMassStorageDriver object
+ *
+ * @notapi
+ */
+static void prepare_csw(USBMassStorageDriver *msdp) {
+
+  msdp->csw.signature = MSD_CSW_SIGNATURE;
+  msdp->csw.tag = msdp->cbw.tag;
 }
 
 /**
- * @brief   Fills and sends CSW message.
+ * @brief   Completes and sends CSW message.
  *
  * @param[in] msdp      pointer to the @p USBMassStorageDriver object
  * @param[in] status    status returned by SCSI layer
@@ -209,9 +237,7 @@ static uint32_t scsi_transport_receive(const SCSITransport *transport,
 static void send_csw(USBMassStorageDriver *msdp, uint8_t status,
                      uint32_t residue) {
 
-  msdp->csw.signature = MSD_CSW_SIGNATURE;
   msdp->csw.data_residue = residue;
-  msdp->csw.tag = msdp->cbw.tag;
   msdp->csw.status = status;
 
   usbTransmit(msdp->usbp, USB_MSD_DATA_EP, (uint8_t *)&msdp->csw,
@@ -236,6 +262,7 @@ static THD_FUNCTION(usb_msd_worker, arg) {
       osalThreadSleepMilliseconds(50);
     }
     else if (cbw_valid(&msdp->cbw, status) && cbw_meaningful(&msdp->cbw)) {
+      prepare_csw(msdp);
       if (SCSI_SUCCESS == scsiExecCmd(&msdp->scsi_target, msdp->cbw.cmd_data)) {
         send_csw(msdp, CSW_STATUS_PASSED, 0);
       }
@@ -345,10 +372,51 @@ void msdObjectInit(USBMassStorageDriver *msdp) {
   msdp->state = USB_MSD_STOP;
   msdp->usbp = NULL;
   msdp->worker = NULL;
+  msdp->scsi_config.blkbuf_size = 0;
+  msdp->scsi_config.blkmap = NULL;
 
   scsiObjectInit(&msdp->scsi_target);
 }
 
+/**
+ * @brief   Sets the size of the working area buffer.
+ * @details With a buffer holding several blocks, reads and writes not served
+ *          by the block map move that many blocks per USB transfer.
+ *
+ * @param[in] msdp      pointer to the @p USBMassStorageDriver object
+ * @param[in] size      size of the buffer passed to @p msdStart() in bytes,
+ *                      zero for a single block buffer
+ *
+ * @api
+ */
+void msdSetBufferSize(USBMassStorageDriver *msdp, size_t size) {
+
+  osalDbgCheck(msdp != NULL);
+  osalDbgAssert((msdp->state == USB_MSD_STOP), "invalid state");
+
+  msdp->scsi_config.blkbuf_size = size;
+}
+
+/**
+ * @brief   Sets the block device memory mapping call.
+ * @details Reads of spans the call maps are transmitted directly from the
+ *          block device memory, without copies, for RAM disks and memory
+ *          mapped flash.
+ *
+ * @param[in] msdp      pointer to the @p USBMassStorageDriver object
+ * @param[in] map       mapping call for the block device passed to
+ *                      @p msdStart(), @p NULL to disable
+ *
+ * @api
+ */
+void msdSetBlockMap(USBMassStorageDriver *msdp, scsi_blk_map_t map) {
+
+  osalDbgCheck(msdp != NULL);
+  osalDbgAssert((msdp->state == USB_MSD_STOP), "invalid state");
+
+  msdp->scsi_config.blkmap = map;
+}
+
 /**
  * @brief   Stops the USB mass storage driver.
  *
@@ -378,7 +446,8 @@ void msdStop(USBMassStorageDriver *msdp) {
  * @param[in] usbp      pointer to the @p USBDriver object
  * @param[in] blkdev    pointer to the @p BaseBlockDevice object
  * @param[in] blkbuf    pointer to the working area buffer, must be allocated
- *                      by user, must be big enough to store 1 data block
+ *                      by user, must be big enough to store 1 data block,
+ *                      see @p msdSetBufferSize() for larger buffers
  * @param[in] inquiry   pointer to the SCSI inquiry response structure,
  *                      set it to @p NULL to use default hardcoded value.
  *
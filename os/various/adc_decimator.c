@@ -0,0 +1,306 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adc_decimator.c
+ * @brief   Fixed point CIC and FIR decimator code.
+ *
+ * @addtogroup ADC_DECIMATOR
+ * @{
+ */
+
+#include <string.h>
+
+#include "adc_decimator.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static int16_t sat16(int32_t x) {
+
+  if (x > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (x < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)x;
+}
+
+/**
+ * @brief   Number of bits needed to represent <tt>x - 1</tt>.
+ */
+static unsigned ceil_log2(uint32_t x) {
+  unsigned bits = 0U;
+
+  while ((1UL << bits) < x) {
+    bits++;
+  }
+  return bits;
+}
+
+/**
+ * @brief   Feeds one sample to the CIC stage.
+ *
+ * @param[in] dp        pointer to the @p decimator_t object
+ * @param[in] x         centered input sample
+ * @param[out] yp       CIC output, Q15
+ * @return              @p true if an output has been produced.
+ */
+static inline bool cic_step(decimator_t *dp, int32_t x, int16_t *yp) {
+  unsigned order = dp->config->cic_order;
+  uint32_t v = (uint32_t)x;
+  unsigned i;
+
+  for (i = 0U; i < order; i++) {
+    dp->integ[i] += v;
+    v = dp->integ[i];
+  }
+  if (--dp->cic_count > 0U) {
+    return false;
+  }
+  dp->cic_count = dp->config->cic_ratio;
+  for (i = 0U; i < order; i++) {
+    uint32_t t = v;
+    v -= dp->comb[i];
+    dp->comb[i] = t;
+  }
+
+  if (dp->shift > 0) {
+    *yp = sat16(((int32_t)v + (1L << (dp->shift - 1))) >> dp->shift);
+  }
+  else {
+    *yp = sat16((int32_t)v * (1L << -dp->shift));
+  }
+  return true;
+}
+
+/**
+ * @brief   Computes one FIR output.
+ *
+ * @param[in] h         coefficients, Q15
+ * @param[in] taps      number of coefficients
+ * @param[in] xp        pointer to the newest sample
+ */
+static int16_t fir_output(const int16_t *h, size_t taps, const int16_t *xp) {
+  int64_t acc = 0;
+  size_t j;
+
+  for (j = 0U; j < taps; j++) {
+    acc += (int32_t)h[j] * (int32_t)xp[-(ptrdiff_t)j];
+  }
+  acc = (acc + (1L << 14)) >> 15;
+  if (acc > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (acc < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)acc;
+}
+
+/**
+ * @brief   Decimates a block, common code of the sample size variants.
+ * @details Inlined with a constant @p wide so each variant keeps a single
+ *          load in its inner loop.
+ *
+ * @param[in] dp        pointer to the @p decimator_t object
+ * @param[in] in        pointer to the first input sample
+ * @param[in] wide      @p true for 32 bits input samples
+ * @param[in] stride    distance between input samples, in samples
+ * @param[in] n         number of input samples
+ * @param[out] out      output buffer
+ * @return              The number of output samples.
+ */
+static inline size_t process(decimator_t *dp, const void *in, bool wide,
+                             size_t stride, size_t n, int16_t *out) {
+  const decimator_config_t *cfgp = dp->config;
+  const uint16_t *in16 = (const uint16_t *)in;
+  const uint32_t *in32 = (const uint32_t *)in;
+  int32_t mid = (int32_t)1 << (cfgp->resolution - 1U);
+  size_t taps = cfgp->fir_taps;
+  size_t nout = 0U, i = 0U;
+  int16_t y;
+
+  if (taps == 0U) {
+    while (n-- > 0U) {
+      int32_t x = (int32_t)(wide ? in32[i] : in16[i]) - mid;
+      i += stride;
+      if (cic_step(dp, x, &y)) {
+        out[nout++] = y;
+      }
+    }
+    return nout;
+  }
+
+  while (n > 0U) {
+    size_t drop;
+
+    /* Fills the state buffer with the CIC outputs.*/
+    while ((n > 0U) && (dp->fill < dp->state_size)) {
+      int32_t x = (int32_t)(wide ? in32[i] : in16[i]) - mid;
+      i += stride;
+      n--;
+      if (cic_step(dp, x, &y)) {
+        dp->state[dp->fill++] = y;
+      }
+    }
+
+    /* Runs the FIR over the whole block.*/
+    while (dp->next < dp->fill) {
+      out[nout++] = fir_output(cfgp->fir_coeffs, taps,
+                               &dp->state[dp->next]);
+      dp->next += cfgp->fir_ratio;
+    }
+
+    /* Keeps the history for the next block.*/
+    drop = dp->fill - (taps - 1U);
+    if (drop > 0U) {
+      memmove(dp->state, &dp->state[drop], (taps - 1U) * sizeof (int16_t));
+      dp->fill -= drop;
+      dp->next -= drop;
+    }
+  }
+  return nout;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a decimator object.
+ *
+ * @param[out] dp       pointer to the @p decimator_t object
+ * @param[in] config    pointer to the @p decimator_config_t object
+ * @param[in] state     FIR state buffer, can be @p NULL without FIR stage
+ * @param[in] state_size FIR state buffer size, in samples, at least
+ *                      @p DECIMATOR_STATE_MIN()
+ * @return              The operation status.
+ * @retval false        if the configuration is not valid.
+ *
+ * @init
+ */
+bool decimatorInit(decimator_t *dp, const decimator_config_t *config,
+                   int16_t *state, size_t state_size) {
+  unsigned growth;
+
+  if ((config->resolution < 1U) || (config->resolution > 16U) ||
+      (config->cic_order > DECIMATOR_CIC_MAX_ORDER) ||
+      (config->cic_ratio < 1U) || (config->fir_ratio < 1U)) {
+    return false;
+  }
+  if ((config->cic_order == 0U) && (config->cic_ratio != 1U)) {
+    return false;
+  }
+  if ((config->fir_taps == 0U) && (config->fir_ratio != 1U)) {
+    return false;
+  }
+  if ((config->fir_taps > 0U) &&
+      ((config->fir_coeffs == NULL) || (state == NULL) ||
+       (state_size < DECIMATOR_STATE_MIN(config->fir_taps)))) {
+    return false;
+  }
+
+  /* Bit growth rounded up per stage, the gain stays at most one.*/
+  growth = config->cic_order * ceil_log2(config->cic_ratio);
+  if (config->resolution + growth > 32U) {
+    return false;
+  }
+
+  dp->config     = config;
+  dp->shift      = (int8_t)((int)(config->resolution + growth) - 16);
+  dp->state      = state;
+  dp->state_size = state_size;
+  decimatorReset(dp);
+
+  return true;
+}
+
+/**
+ * @brief   Clears the filters history.
+ *
+ * @param[in] dp        pointer to the @p decimator_t object
+ *
+ * @api
+ */
+void decimatorReset(decimator_t *dp) {
+  size_t taps = dp->config->fir_taps;
+
+  memset(dp->integ, 0, sizeof dp->integ);
+  memset(dp->comb, 0, sizeof dp->comb);
+  dp->cic_count = dp->config->cic_ratio;
+  if (taps > 0U) {
+    memset(dp->state, 0, (taps - 1U) * sizeof (int16_t));
+    dp->fill = taps - 1U;
+    dp->next = (taps - 1U) + (dp->config->fir_ratio - 1U);
+  }
+}
+
+/**
+ * @brief   Decimates a block of 16 bits samples.
+ *
+ * @param[in] dp        pointer to the @p decimator_t object
+ * @param[in] in        pointer to the first input sample
+ * @param[in] stride    distance between input samples, in samples, e.g. the
+ *                      number of channels of an interleaved buffer
+ * @param[in] n         number of input samples
+ * @param[out] out      output buffer, at least @p decimatorMaxOutput()
+ *                      samples
+ * @return              The number of output samples.
+ *
+ * @api
+ */
+size_t decimatorProcessU16(decimator_t *dp, const uint16_t *in,
+                           size_t stride, size_t n, int16_t *out) {
+
+  return process(dp, in, false, stride, n, out);
+}
+
+/**
+ * @brief   Decimates a block of 32 bits samples.
+ *
+ * @param[in] dp        pointer to the @p decimator_t object
+ * @param[in] in        pointer to the first input sample
+ * @param[in] stride    distance between input samples, in samples, e.g. the
+ *                      number of channels of an interleaved buffer
+ * @param[in] n         number of input samples
+ * @param[out] out      output buffer, at least @p decimatorMaxOutput()
+ *                      samples
+ * @return              The number of output samples.
+ *
+ * @api
+ */
+size_t decimatorProcessU32(decimator_t *dp, const uint32_t *in,
+                           size_t stride, size_t n, int16_t *out) {
+
+  return process(dp, in, true, stride, n, out);
+}
+
+/** @} */
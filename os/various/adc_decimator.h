@@ -0,0 +1,193 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adc_decimator.h
+ * @brief   Fixed point CIC and FIR decimator header.
+ * @details Decimates one channel of raw ADC samples in two stages:
+ *          - a CIC filter of order 1 to @p DECIMATOR_CIC_MAX_ORDER
+ *            decimating by @p cic_ratio, no multiplications;
+ *          - an optional FIR filter with Q15 coefficients decimating by
+ *            @p fir_ratio, usually designed to flatten the CIC droop and
+ *            to cut the remaining aliases.
+ *          .
+ *          Samples are processed in blocks, with a stride so that one
+ *          channel can be taken directly from an interleaved ADC buffer.
+ *          The output is signed Q15, full scale being the ADC range
+ *          centered on its mid-scale code.
+ * @note    This module only depends on the C library, it builds as is on
+ *          a host for testing and benchmarking.
+ *
+ * @addtogroup ADC_DECIMATOR
+ * @{
+ */
+
+#ifndef ADC_DECIMATOR_H_
+#define ADC_DECIMATOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Highest supported CIC order.
+ */
+#define DECIMATOR_CIC_MAX_ORDER         5U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Decimator configuration structure.
+ * @note    One configuration can be shared by all the channels of a group.
+ */
+typedef struct {
+  /**
+   * @brief   ADC resolution in bits, 1 to 16.
+   */
+  uint8_t               resolution;
+  /**
+   * @brief   CIC order, zero to bypass the CIC stage.
+   * @note    The CIC registers grow by @p cic_order times log2
+   *          @p cic_ratio bits, added to @p resolution the total must not
+   *          exceed 32 bits.
+   */
+  uint8_t               cic_order;
+  /**
+   * @brief   CIC decimation ratio, one when bypassed.
+   * @note    The CIC gain is normalized by a shift, ratios that are not
+   *          powers of two leave a gain below one.
+   */
+  uint16_t              cic_ratio;
+  /**
+   * @brief   FIR decimation ratio, one when there is no FIR stage.
+   */
+  uint16_t              fir_ratio;
+  /**
+   * @brief   Number of FIR taps, zero to bypass the FIR stage.
+   */
+  uint16_t              fir_taps;
+  /**
+   * @brief   FIR coefficients, Q15.
+   */
+  const int16_t         *fir_coeffs;
+} decimator_config_t;
+
+/**
+ * @brief   Decimator object, one per channel.
+ */
+typedef struct {
+  /**
+   * @brief   Current configuration.
+   */
+  const decimator_config_t *config;
+  /**
+   * @brief   CIC integrators.
+   * @note    Wrapping arithmetic, the combs recover the exact result.
+   */
+  uint32_t              integ[DECIMATOR_CIC_MAX_ORDER];
+  /**
+   * @brief   CIC comb delay lines.
+   */
+  uint32_t              comb[DECIMATOR_CIC_MAX_ORDER];
+  /**
+   * @brief   Input samples to go before the next CIC output.
+   */
+  uint16_t              cic_count;
+  /**
+   * @brief   CIC output normalization, right shift if positive.
+   */
+  int8_t                shift;
+  /**
+   * @brief   FIR state buffer, history followed by the new samples.
+   */
+  int16_t               *state;
+  /**
+   * @brief   FIR state buffer size, in samples.
+   */
+  size_t                state_size;
+  /**
+   * @brief   Samples in the FIR state buffer.
+   */
+  size_t                fill;
+  /**
+   * @brief   State index of the newest sample of the next FIR output.
+   */
+  size_t                next;
+} decimator_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Minimum FIR state buffer size, in samples.
+ * @details Larger buffers let the FIR run on longer blocks.
+ *
+ * @param[in] taps      number of FIR taps
+ */
+#define DECIMATOR_STATE_MIN(taps)       ((size_t)(taps) + 1U)
+
+/**
+ * @brief   Overall decimation ratio.
+ *
+ * @param[in] cfgp      pointer to a @p decimator_config_t structure
+ */
+#define decimatorRatio(cfgp)                                                \
+  ((size_t)(cfgp)->cic_ratio * (size_t)(cfgp)->fir_ratio)
+
+/**
+ * @brief   Highest number of outputs for a block of input samples.
+ *
+ * @param[in] cfgp      pointer to a @p decimator_config_t structure
+ * @param[in] n         number of input samples
+ */
+#define decimatorMaxOutput(cfgp, n) (((n) / decimatorRatio(cfgp)) + 1U)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool decimatorInit(decimator_t *dp, const decimator_config_t *config,
+                     int16_t *state, size_t state_size);
+  void decimatorReset(decimator_t *dp);
+  size_t decimatorProcessU16(decimator_t *dp, const uint16_t *in,
+                             size_t stride, size_t n, int16_t *out);
+  size_t decimatorProcessU32(decimator_t *dp, const uint32_t *in,
+                             size_t stride, size_t n, int16_t *out);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_DECIMATOR_H_ */
+
+/** @} */
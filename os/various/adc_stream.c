@@ -0,0 +1,214 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adc_stream.c
+ * @brief   Decimated ADC streaming code.
+ *
+ * @addtogroup ADC_STREAM
+ * @{
+ */
+
+#include "adc_stream.h"
+
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Running streams, looked up by driver from the group callback.
+ */
+static ADCStream *adc_streams[ADC_STREAM_MAX_STREAMS];
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Decimates one channel of a half buffer.
+ */
+static size_t process(decimator_t *dp, const adcsample_t *in, size_t stride,
+                      size_t n, int16_t *out) {
+
+  if (sizeof (adcsample_t) == sizeof (uint16_t)) {
+    return decimatorProcessU16(dp, (const uint16_t *)in, stride, n, out);
+  }
+  return decimatorProcessU32(dp, (const uint32_t *)in, stride, n, out);
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a stream object.
+ *
+ * @param[out] asp      pointer to the @p ADCStream object
+ *
+ * @init
+ */
+void adcStreamObjectInit(ADCStream *asp) {
+
+  osalDbgCheck(asp != NULL);
+
+  asp->config   = NULL;
+  asp->adcp     = NULL;
+  asp->channels = 0U;
+}
+
+/**
+ * @brief   Starts a stream.
+ * @details Initializes the decimators and starts the circular conversion.
+ * @pre     The ADC driver must be started.
+ *
+ * @param[in] asp       pointer to the @p ADCStream object
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] grpp      pointer to a circular conversion group using
+ *                      @p adcStreamCallback()
+ * @param[in] config    pointer to the @p ADCStreamConfig object
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the stream started.
+ * @retval HAL_FAILED   if the decimation chain is not valid or too many
+ *                      streams are running.
+ *
+ * @api
+ */
+bool adcStreamStart(ADCStream *asp, ADCDriver *adcp,
+                    const ADCConversionGroup *grpp,
+                    const ADCStreamConfig *config) {
+  size_t ch, slot;
+
+  osalDbgCheck((asp != NULL) && (adcp != NULL) && (grpp != NULL) &&
+               (config != NULL) && (config->buffer != NULL) &&
+               (config->out != NULL) && (config->end_cb != NULL));
+  osalDbgCheck((config->depth >= 2U) && ((config->depth & 1U) == 0U));
+  osalDbgCheck(config->out_size >=
+               decimatorMaxOutput(config->decimator, config->depth / 2U));
+  osalDbgAssert(grpp->circular && (grpp->end_cb == adcStreamCallback),
+                "invalid group");
+  osalDbgAssert((grpp->num_channels > 0U) &&
+                (grpp->num_channels <= ADC_STREAM_MAX_CHANNELS),
+                "too many channels");
+  osalDbgAssert(asp->config == NULL, "already started");
+
+  for (ch = 0U; ch < grpp->num_channels; ch++) {
+    int16_t *state = config->state == NULL ? NULL :
+                     &config->state[ch * config->state_size];
+    if (!decimatorInit(&asp->decimators[ch], config->decimator,
+                       state, config->state_size)) {
+      return HAL_FAILED;
+    }
+  }
+
+  osalSysLock();
+  for (slot = 0U; slot < ADC_STREAM_MAX_STREAMS; slot++) {
+    if (adc_streams[slot] == NULL) {
+      break;
+    }
+  }
+  if (slot >= ADC_STREAM_MAX_STREAMS) {
+    osalSysUnlock();
+    return HAL_FAILED;
+  }
+  asp->config   = config;
+  asp->adcp     = adcp;
+  asp->channels = grpp->num_channels;
+  adc_streams[slot] = asp;
+  osalSysUnlock();
+
+  adcStartConversion(adcp, grpp, config->buffer, config->depth);
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Stops a stream.
+ *
+ * @param[in] asp       pointer to the @p ADCStream object
+ *
+ * @api
+ */
+void adcStreamStop(ADCStream *asp) {
+  size_t slot;
+
+  osalDbgCheck(asp != NULL);
+
+  if (asp->config == NULL) {
+    return;
+  }
+
+  adcStopConversion(asp->adcp);
+
+  osalSysLock();
+  for (slot = 0U; slot < ADC_STREAM_MAX_STREAMS; slot++) {
+    if (adc_streams[slot] == asp) {
+      adc_streams[slot] = NULL;
+    }
+  }
+  asp->config = NULL;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Conversion group callback.
+ * @details Decimates the half buffer just filled, channel by channel, and
+ *          invokes the stream callback with the new output blocks.
+ * @note    To be set as the @p end_cb of the streamed conversion groups.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] buffer    pointer to the filled half buffer
+ * @param[in] n         number of rows in the half buffer
+ *
+ * @special
+ */
+void adcStreamCallback(ADCDriver *adcp, adcsample_t *buffer, size_t n) {
+  ADCStream *asp = NULL;
+  size_t ch, slot, nout = 0U;
+
+  for (slot = 0U; slot < ADC_STREAM_MAX_STREAMS; slot++) {
+    if ((adc_streams[slot] != NULL) && (adc_streams[slot]->adcp == adcp)) {
+      asp = adc_streams[slot];
+      break;
+    }
+  }
+  if (asp == NULL) {
+    return;
+  }
+
+  /* All the channels share the same chain, they output the same number
+     of samples.*/
+  for (ch = 0U; ch < asp->channels; ch++) {
+    nout = process(&asp->decimators[ch], &buffer[ch], asp->channels, n,
+                   adcStreamGetOutput(asp, ch));
+  }
+  if (nout > 0U) {
+    asp->config->end_cb(asp, nout);
+  }
+}
+
+#endif /* HAL_USE_ADC == TRUE */
+
+/** @} */
@@ -0,0 +1,203 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adc_stream.h
+ * @brief   Decimated ADC streaming header.
+ * @details Runs an ADC group in circular mode and decimates each channel
+ *          with an @p decimator_t chain on every half buffer, the output
+ *          blocks are delivered per channel to a callback. Works with any
+ *          ADC driver calling the group callback on half and full buffer,
+ *          e.g. the Kinetis, TIVA and NRF5 ones.
+ *
+ *          The conversion group must be circular and must use
+ *          @p adcStreamCallback() as its end callback:
+ *          @code
+ *          static const ADCConversionGroup grp = {
+ *            .circular     = true,
+ *            .num_channels = 2,
+ *            .end_cb       = adcStreamCallback,
+ *            ...
+ *          };
+ *          @endcode
+ * @note    The decimation runs in the ADC interrupt, half a buffer at a
+ *          time. The buffer depth sets the trade-off between interrupt
+ *          rate and latency.
+ *
+ * @addtogroup ADC_STREAM
+ * @{
+ */
+
+#ifndef ADC_STREAM_H_
+#define ADC_STREAM_H_
+
+#include "hal.h"
+#include "adc_decimator.h"
+
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of channels per stream.
+ */
+#if !defined(ADC_STREAM_MAX_CHANNELS) || defined(__DOXYGEN__)
+#define ADC_STREAM_MAX_CHANNELS             8
+#endif
+
+/**
+ * @brief   Maximum number of streams running at the same time.
+ */
+#if !defined(ADC_STREAM_MAX_STREAMS) || defined(__DOXYGEN__)
+#define ADC_STREAM_MAX_STREAMS              2
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if ADC_STREAM_MAX_CHANNELS < 1
+#error "invalid ADC_STREAM_MAX_CHANNELS value"
+#endif
+
+#if ADC_STREAM_MAX_STREAMS < 1
+#error "invalid ADC_STREAM_MAX_STREAMS value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a structure representing a stream.
+ */
+typedef struct ADCStream ADCStream;
+
+/**
+ * @brief   Stream output callback type.
+ *
+ * @param[in] asp       pointer to the @p ADCStream object
+ * @param[in] n         number of new output samples per channel, see
+ *                      @p adcStreamGetOutput()
+ */
+typedef void (*adcstreamcallback_t)(ADCStream *asp, size_t n);
+
+/**
+ * @brief   Stream configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Decimation chain, shared by all the channels.
+   */
+  const decimator_config_t  *decimator;
+  /**
+   * @brief   Circular sample buffer, @p depth rows of interleaved
+   *          channels.
+   */
+  adcsample_t               *buffer;
+  /**
+   * @brief   Buffer depth, even.
+   */
+  size_t                    depth;
+  /**
+   * @brief   FIR state buffers, @p state_size samples per channel.
+   * @note    Can be @p NULL if the chain has no FIR stage.
+   */
+  int16_t                   *state;
+  /**
+   * @brief   FIR state buffer size per channel.
+   */
+  size_t                    state_size;
+  /**
+   * @brief   Output buffers, @p out_size samples per channel.
+   */
+  int16_t                   *out;
+  /**
+   * @brief   Output buffer size per channel, at least
+   *          <tt>decimatorMaxOutput(decimator, depth / 2)</tt>.
+   */
+  size_t                    out_size;
+  /**
+   * @brief   Output callback.
+   */
+  adcstreamcallback_t       end_cb;
+} ADCStreamConfig;
+
+/**
+ * @brief   Structure representing a stream.
+ */
+struct ADCStream {
+  /**
+   * @brief   Current configuration, @p NULL when stopped.
+   */
+  const ADCStreamConfig     *config;
+  /**
+   * @brief   ADC driver running the stream.
+   */
+  ADCDriver                 *adcp;
+  /**
+   * @brief   Number of channels.
+   */
+  size_t                    channels;
+  /**
+   * @brief   Channels decimators.
+   */
+  decimator_t               decimators[ADC_STREAM_MAX_CHANNELS];
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Output buffer of a channel.
+ * @note    The buffer is overwritten on the next half buffer, the callback
+ *          must consume or copy it.
+ *
+ * @param[in] asp       pointer to the @p ADCStream object
+ * @param[in] ch        channel index in the conversion group
+ */
+#define adcStreamGetOutput(asp, ch)                                         \
+  (&(asp)->config->out[(size_t)(ch) * (asp)->config->out_size])
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void adcStreamObjectInit(ADCStream *asp);
+  bool adcStreamStart(ADCStream *asp, ADCDriver *adcp,
+                      const ADCConversionGroup *grpp,
+                      const ADCStreamConfig *config);
+  void adcStreamStop(ADCStream *asp);
+  void adcStreamCallback(ADCDriver *adcp, adcsample_t *buffer, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_ADC == TRUE */
+
+#endif /* ADC_STREAM_H_ */
+
+/** @} */
@@ -0,0 +1,344 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    csprng.c
+ * @brief   ChaCha20 DRBG and entropy source health tests code.
+ *
+ * @addtogroup CSPRNG
+ * @{
+ */
+
+#include <string.h>
+
+#include "csprng.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Nonce domain of the output keystream.
+ */
+#define DOMAIN_OUTPUT           0U
+
+/**
+ * @brief   Nonce domain of the seed folding rekeys.
+ */
+#define DOMAIN_RESEED           1U
+
+/**
+ * @brief   Largest number of blocks generated straight to the caller
+ *          buffer before a rekey.
+ */
+#define DIRECT_MAX_BLOCKS       0x10000U
+
+#define ROTL(x, n)              (((x) << (n)) | ((x) >> (32U - (n))))
+
+#define QR(a, b, c, d) {                                                    \
+  a += b; d ^= a; d = ROTL(d, 16);                                          \
+  c += d; b ^= c; b = ROTL(b, 12);                                          \
+  a += b; d ^= a; d = ROTL(d, 8);                                           \
+  c += d; b ^= c; b = ROTL(b, 7);                                           \
+}
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Adaptive proportion test cutoffs for a 512 samples window, by
+ *          min-entropy per sample from 1 to 8 bits.
+ */
+static const uint16_t apt_cutoffs[8] = {
+  311U, 177U, 103U, 62U, 39U, 25U, 18U, 13U
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static void store32(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t load32(const uint8_t *p) {
+
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief   Keystream block to a byte buffer.
+ */
+static void block_out(const uint32_t *key, uint32_t counter, uint32_t domain,
+                      uint8_t *out) {
+  const uint32_t nonce[3] = {domain, 0U, 0U};
+  uint32_t w[16];
+  unsigned i;
+
+  csprngChaChaBlock(key, counter, nonce, w);
+  for (i = 0U; i < 16U; i++) {
+    store32(&out[i * 4U], w[i]);
+  }
+  memset(w, 0, sizeof w);
+}
+
+/**
+ * @brief   Refills the output buffer and replaces the key.
+ */
+static void refill(csprng_t *cp) {
+  unsigned i;
+
+  for (i = 0U; i < CSPRNG_BUFFER_BLOCKS; i++) {
+    block_out(cp->key, i, DOMAIN_OUTPUT, &cp->buf[i * CSPRNG_BLOCK_SIZE]);
+  }
+  for (i = 0U; i < CSPRNG_KEY_SIZE / 4U; i++) {
+    cp->key[i] = load32(&cp->buf[i * 4U]);
+  }
+  memset(cp->buf, 0, CSPRNG_KEY_SIZE);
+  cp->avail = CSPRNG_BUFFER_SIZE - CSPRNG_KEY_SIZE;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   ChaCha20 block function, RFC 7539.
+ *
+ * @param[in] key       key words
+ * @param[in] counter   block counter
+ * @param[in] nonce     nonce words
+ * @param[out] out      keystream block words
+ *
+ * @api
+ */
+void csprngChaChaBlock(const uint32_t key[8], uint32_t counter,
+                       const uint32_t nonce[3], uint32_t out[16]) {
+  uint32_t x0  = 0x61707865U, x1  = 0x3320646eU;
+  uint32_t x2  = 0x79622d32U, x3  = 0x6b206574U;
+  uint32_t x4  = key[0], x5  = key[1], x6  = key[2], x7  = key[3];
+  uint32_t x8  = key[4], x9  = key[5], x10 = key[6], x11 = key[7];
+  uint32_t x12 = counter, x13 = nonce[0], x14 = nonce[1], x15 = nonce[2];
+  unsigned i;
+
+  for (i = 0U; i < 10U; i++) {
+    QR(x0, x4, x8,  x12);
+    QR(x1, x5, x9,  x13);
+    QR(x2, x6, x10, x14);
+    QR(x3, x7, x11, x15);
+    QR(x0, x5, x10, x15);
+    QR(x1, x6, x11, x12);
+    QR(x2, x7, x8,  x13);
+    QR(x3, x4, x9,  x14);
+  }
+
+  out[0]  = x0  + 0x61707865U;
+  out[1]  = x1  + 0x3320646eU;
+  out[2]  = x2  + 0x79622d32U;
+  out[3]  = x3  + 0x6b206574U;
+  out[4]  = x4  + key[0];
+  out[5]  = x5  + key[1];
+  out[6]  = x6  + key[2];
+  out[7]  = x7  + key[3];
+  out[8]  = x8  + key[4];
+  out[9]  = x9  + key[5];
+  out[10] = x10 + key[6];
+  out[11] = x11 + key[7];
+  out[12] = x12 + counter;
+  out[13] = x13 + nonce[0];
+  out[14] = x14 + nonce[1];
+  out[15] = x15 + nonce[2];
+}
+
+/**
+ * @brief   Initializes a DRBG.
+ *
+ * @param[out] cp       pointer to the @p csprng_t object
+ * @param[in] seed      seed bytes, can be @p NULL if @p len is zero
+ * @param[in] len       number of seed bytes
+ *
+ * @init
+ */
+void csprngInit(csprng_t *cp, const uint8_t *seed, size_t len) {
+
+  memset(cp->key, 0, sizeof cp->key);
+  csprngReseed(cp, seed, len);
+}
+
+/**
+ * @brief   Mixes a seed into the DRBG key.
+ * @details The buffered output is discarded, the next bytes are generated
+ *          from the new key.
+ *
+ * @param[in] cp        pointer to the @p csprng_t object
+ * @param[in] seed      seed bytes, can be @p NULL if @p len is zero
+ * @param[in] len       number of seed bytes
+ *
+ * @api
+ */
+void csprngReseed(csprng_t *cp, const uint8_t *seed, size_t len) {
+  uint8_t next[CSPRNG_BLOCK_SIZE];
+  size_t i, n;
+
+  do {
+    n = len < CSPRNG_KEY_SIZE ? len : CSPRNG_KEY_SIZE;
+    for (i = 0U; i < n; i++) {
+      cp->key[i / 4U] ^= (uint32_t)seed[i] << ((i % 4U) * 8U);
+    }
+    block_out(cp->key, 0U, DOMAIN_RESEED, next);
+    for (i = 0U; i < CSPRNG_KEY_SIZE / 4U; i++) {
+      cp->key[i] = load32(&next[i * 4U]);
+    }
+    seed += n;
+    len  -= n;
+  } while (len > 0U);
+
+  memset(next, 0, sizeof next);
+  memset(cp->buf, 0, sizeof cp->buf);
+  cp->avail = 0U;
+}
+
+/**
+ * @brief   Generates random bytes.
+ * @details Small requests are served from the output buffer, the whole
+ *          blocks of large requests are generated straight to @p out.
+ *
+ * @param[in] cp        pointer to the @p csprng_t object
+ * @param[out] out      output buffer
+ * @param[in] n         number of bytes
+ *
+ * @api
+ */
+void csprngGenerate(csprng_t *cp, uint8_t *out, size_t n) {
+  size_t i, take;
+
+  while (n > 0U) {
+    if (cp->avail == 0U) {
+      if (n >= CSPRNG_BLOCK_SIZE) {
+        /* Counters past the buffer ones, the refill after them erases the
+           key.*/
+        take = n / CSPRNG_BLOCK_SIZE;
+        if (take > DIRECT_MAX_BLOCKS) {
+          take = DIRECT_MAX_BLOCKS;
+        }
+        for (i = 0U; i < take; i++) {
+          block_out(cp->key, CSPRNG_BUFFER_BLOCKS + i, DOMAIN_OUTPUT, out);
+          out += CSPRNG_BLOCK_SIZE;
+        }
+        n -= take * CSPRNG_BLOCK_SIZE;
+      }
+      refill(cp);
+      continue;
+    }
+
+    take = n < cp->avail ? n : cp->avail;
+    i = CSPRNG_BUFFER_SIZE - cp->avail;
+    memcpy(out, &cp->buf[i], take);
+    memset(&cp->buf[i], 0, take);
+    cp->avail -= take;
+    out += take;
+    n   -= take;
+  }
+}
+
+/**
+ * @brief   Initializes the health tests.
+ *
+ * @param[out] hp       pointer to the @p csprng_health_t object
+ * @param[in] min_entropy assumed min-entropy per byte sample, in bits from
+ *                      1 to 8
+ *
+ * @init
+ */
+void csprngHealthInit(csprng_health_t *hp, unsigned min_entropy) {
+
+  if (min_entropy < 1U) {
+    min_entropy = 1U;
+  }
+  if (min_entropy > 8U) {
+    min_entropy = 8U;
+  }
+  hp->rct_cutoff = (uint16_t)(1U + ((20U + min_entropy - 1U) / min_entropy));
+  hp->apt_cutoff = apt_cutoffs[min_entropy - 1U];
+  hp->samples    = 0U;
+  hp->rct_last   = 0U;
+  hp->rct_count  = 0U;
+  hp->apt_first  = 0U;
+  hp->apt_count  = 0U;
+  hp->apt_index  = 0U;
+}
+
+/**
+ * @brief   Runs the health tests over raw samples.
+ * @note    After a failure the object must be initialized again.
+ *
+ * @param[in] hp        pointer to the @p csprng_health_t object
+ * @param[in] data      raw byte samples
+ * @param[in] n         number of samples
+ * @return              The test result.
+ * @retval true         if the samples passed both tests.
+ * @retval false        if the source failed.
+ *
+ * @api
+ */
+bool csprngHealthTest(csprng_health_t *hp, const uint8_t *data, size_t n) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    const uint8_t x = data[i];
+
+    /* Repetition count test.*/
+    if ((hp->samples > 0U) && (x == hp->rct_last)) {
+      if (++hp->rct_count >= hp->rct_cutoff) {
+        return false;
+      }
+    }
+    else {
+      hp->rct_last  = x;
+      hp->rct_count = 1U;
+    }
+
+    /* Adaptive proportion test.*/
+    if (hp->apt_index == 0U) {
+      hp->apt_first = x;
+      hp->apt_count = 1U;
+    }
+    else if (x == hp->apt_first) {
+      if (++hp->apt_count >= hp->apt_cutoff) {
+        return false;
+      }
+    }
+    if (++hp->apt_index >= CSPRNG_APT_WINDOW) {
+      hp->apt_index = 0U;
+    }
+
+    hp->samples++;
+  }
+
+  return true;
+}
+
+/** @} */
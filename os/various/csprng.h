@@ -0,0 +1,166 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    csprng.h
+ * @brief   ChaCha20 DRBG and entropy source health tests header.
+ * @details The generator runs ChaCha20 in counter mode over an output
+ *          buffer. Each refill uses the first 32 bytes of keystream as the
+ *          next key, so that a captured state does not reveal the bytes
+ *          already returned (fast key erasure). Bytes are wiped from the
+ *          buffer as they are returned.
+ *
+ *          Seeds are folded into the key 32 bytes at a time, each fold is
+ *          followed by a ChaCha20 rekey in a separate nonce domain.
+ *
+ *          The health tests are the SP 800-90B repetition count and
+ *          adaptive proportion tests over byte samples, with cutoffs for
+ *          a false positive rate of 2^-20 at the assumed min-entropy.
+ * @note    This module only depends on the C library, it builds as is on
+ *          a host for testing and benchmarking.
+ *
+ * @addtogroup CSPRNG
+ * @{
+ */
+
+#ifndef CSPRNG_H_
+#define CSPRNG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   ChaCha20 block size, in bytes.
+ */
+#define CSPRNG_BLOCK_SIZE               64U
+
+/**
+ * @brief   Key size, in bytes.
+ */
+#define CSPRNG_KEY_SIZE                 32U
+
+/**
+ * @brief   Adaptive proportion test window, in samples.
+ */
+#define CSPRNG_APT_WINDOW               512U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Output buffer size, in ChaCha20 blocks.
+ * @note    The first 32 bytes of each refill become the next key.
+ */
+#if !defined(CSPRNG_BUFFER_BLOCKS) || defined(__DOXYGEN__)
+#define CSPRNG_BUFFER_BLOCKS            4
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CSPRNG_BUFFER_BLOCKS < 1
+#error "invalid CSPRNG_BUFFER_BLOCKS value"
+#endif
+
+/**
+ * @brief   Output buffer size, in bytes.
+ */
+#define CSPRNG_BUFFER_SIZE              (CSPRNG_BUFFER_BLOCKS * CSPRNG_BLOCK_SIZE)
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   DRBG object.
+ */
+typedef struct {
+  /**
+   * @brief   Current key.
+   */
+  uint32_t              key[CSPRNG_KEY_SIZE / 4U];
+  /**
+   * @brief   Keystream not returned yet, at the end of the buffer.
+   */
+  size_t                avail;
+  /**
+   * @brief   Output buffer.
+   */
+  uint8_t               buf[CSPRNG_BUFFER_SIZE];
+} csprng_t;
+
+/**
+ * @brief   Health tests object.
+ */
+typedef struct {
+  /**
+   * @brief   Repetition count test cutoff.
+   */
+  uint16_t              rct_cutoff;
+  /**
+   * @brief   Adaptive proportion test cutoff.
+   */
+  uint16_t              apt_cutoff;
+  /**
+   * @brief   Samples tested since the last reset.
+   */
+  uint32_t              samples;
+  /**
+   * @brief   Last sample and number of repetitions.
+   */
+  uint8_t               rct_last;
+  uint16_t              rct_count;
+  /**
+   * @brief   First sample of the window, its occurrences and the window
+   *          position.
+   */
+  uint8_t               apt_first;
+  uint16_t              apt_count;
+  uint16_t              apt_index;
+} csprng_health_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void csprngChaChaBlock(const uint32_t key[8], uint32_t counter,
+                         const uint32_t nonce[3], uint32_t out[16]);
+  void csprngInit(csprng_t *cp, const uint8_t *seed, size_t len);
+  void csprngReseed(csprng_t *cp, const uint8_t *seed, size_t len);
+  void csprngGenerate(csprng_t *cp, uint8_t *out, size_t n);
+  void csprngHealthInit(csprng_health_t *hp, unsigned min_entropy);
+  bool csprngHealthTest(csprng_health_t *hp, const uint8_t *data, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSPRNG_H_ */
+
+/** @} */
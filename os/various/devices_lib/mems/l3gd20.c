@@ -43,6 +43,16 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#define  CTRL_REG3_I2_ORUN                       ((uint8_t)0x02)
+#define  CTRL_REG3_I2_WTM                        ((uint8_t)0x04)
+#define  CTRL_REG5_FIFO_EN                       ((uint8_t)0x40)
+#define  FIFO_CTRL_FM_BYPASS                     ((uint8_t)0x00)
+#define  FIFO_CTRL_FM_STREAM                     ((uint8_t)0x40)
+#define  FIFO_CTRL_WTM                           ((uint8_t)0x1F)
+#define  FIFO_SRC_FSS                            ((uint8_t)0x1F)
+#define  FIFO_SRC_EMPTY                          ((uint8_t)0x20)
+#define  FIFO_SRC_OVRN                           ((uint8_t)0x40)
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -120,4 +130,88 @@ void l3gd20WriteRegister(SPIDriver *spip, uint8_t reg, uint8_t value) {
       spiUnselect(spip);
   }
 }
+
+/**
+ * @brief   Enables the FIFO in stream mode.
+ * @details The FIFO content is discarded. The watermark and overrun
+ *          interrupts are routed to the DRDY/INT2 pin.
+ * @pre     The SPI interface must be initialized and the driver started.
+ *
+ * @param[in] spip      pointer to the SPI interface
+ * @param[in] watermark FIFO level raising the watermark interrupt, 0 to 31
+ */
+void l3gd20FIFOStart(SPIDriver *spip, uint8_t watermark) {
+
+  osalDbgCheck((spip != NULL) && (watermark <= FIFO_CTRL_WTM));
+
+  l3gd20WriteRegister(spip, L3GD20_AD_FIFO_CTRL_REG, FIFO_CTRL_FM_BYPASS);
+  l3gd20WriteRegister(spip, L3GD20_AD_CTRL_REG5,
+                      l3gd20ReadRegister(spip, L3GD20_AD_CTRL_REG5) |
+                      CTRL_REG5_FIFO_EN);
+  l3gd20WriteRegister(spip, L3GD20_AD_FIFO_CTRL_REG,
+                      FIFO_CTRL_FM_STREAM | watermark);
+  l3gd20WriteRegister(spip, L3GD20_AD_CTRL_REG3,
+                      l3gd20ReadRegister(spip, L3GD20_AD_CTRL_REG3) |
+                      CTRL_REG3_I2_WTM | CTRL_REG3_I2_ORUN);
+}
+
+/**
+ * @brief   Disables the FIFO.
+ * @pre     The SPI interface must be initialized and the driver started.
+ *
+ * @param[in] spip      pointer to the SPI interface
+ */
+void l3gd20FIFOStop(SPIDriver *spip) {
+
+  osalDbgCheck(spip != NULL);
+
+  l3gd20WriteRegister(spip, L3GD20_AD_CTRL_REG3,
+                      l3gd20ReadRegister(spip, L3GD20_AD_CTRL_REG3) &
+                      ~(CTRL_REG3_I2_WTM | CTRL_REG3_I2_ORUN));
+  l3gd20WriteRegister(spip, L3GD20_AD_FIFO_CTRL_REG, FIFO_CTRL_FM_BYPASS);
+  l3gd20WriteRegister(spip, L3GD20_AD_CTRL_REG5,
+                      l3gd20ReadRegister(spip, L3GD20_AD_CTRL_REG5) &
+                      ~CTRL_REG5_FIFO_EN);
+}
+
+/**
+ * @brief   Drains the FIFO into a stream.
+ * @details Two bus transactions whatever the FIFO level: the FIFO source
+ *          register, then all the samples in a single auto increment burst.
+ *          In FIFO mode the address rolls back from OUT_Z_H to OUT_X_L.
+ * @pre     The FIFO must have been enabled with @p l3gd20FIFOStart().
+ *
+ * @param[in] spip      pointer to the SPI interface
+ * @param[in] msp       pointer to the @p mems_stream_t object, in dps
+ * @return              number of samples read.
+ */
+size_t l3gd20FIFORead(SPIDriver *spip, mems_stream_t *msp) {
+  uint8_t src, addr = L3GD20_RW | L3GD20_MS | L3GD20_AD_OUT_X_L;
+  systime_t time;
+  size_t n;
+
+  osalDbgCheck((spip != NULL) && (msp != NULL));
+
+  src = l3gd20ReadRegister(spip, L3GD20_AD_FIFO_SRC_REG);
+  msp->transactions++;
+  if ((src & FIFO_SRC_EMPTY) != 0U) {
+    return 0;
+  }
+  /* FSS counts up to 31, an overrun means a full FIFO.*/
+  n = (src & FIFO_SRC_OVRN) != 0U ? 32U : (size_t)(src & FIFO_SRC_FSS);
+  if (n > MEMS_STREAM_BURST_SIZE) {
+    n = MEMS_STREAM_BURST_SIZE;
+  }
+
+  time = chVTGetSystemTimeX();
+  spiSelect(spip);
+  spiSend(spip, 1, &addr);
+  spiReceive(spip, n * MEMS_STREAM_SAMPLE_SIZE, msp->raw);
+  spiUnselect(spip);
+  msp->transactions++;
+
+  memsStreamPush(msp, msp->raw, n, MEMS_STREAM_SAMPLE_SIZE, time,
+                 (src & FIFO_SRC_OVRN) != 0U);
+  return n;
+}
 /** @} */
@@ -36,6 +36,8 @@
 #ifndef _L3GD20_H_
 #define _L3GD20_H_
 
+#include "mems_stream.h"
+
 /*===========================================================================*/
 /* Driver constants.                                                         */
 /*===========================================================================*/
@@ -233,6 +235,9 @@ extern "C" {
 
   uint8_t l3gd20ReadRegister(SPIDriver *spip, uint8_t reg);
   void l3gd20WriteRegister(SPIDriver *spip, uint8_t reg, uint8_t value);
+  void l3gd20FIFOStart(SPIDriver *spip, uint8_t watermark);
+  void l3gd20FIFOStop(SPIDriver *spip);
+  size_t l3gd20FIFORead(SPIDriver *spip, mems_stream_t *msp);
 #ifdef __cplusplus
 }
 #endif
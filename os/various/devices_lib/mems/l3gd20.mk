@@ -0,0 +1,9 @@
+# L3GD20 driver files.
+L3GD20SRC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/l3gd20.c
+L3GD20INC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems
+
+# Shared variables
+ALLCSRC += $(L3GD20SRC)
+ALLINC  += $(L3GD20INC)
+
+include $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/mems_stream.mk
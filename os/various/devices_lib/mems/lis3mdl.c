@@ -43,6 +43,9 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#define  STATUS_ZYXDA                            ((uint8_t)0x08)
+#define  STATUS_ZYXOR                            ((uint8_t)0x80)
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -148,4 +151,40 @@ void lis3mdlWriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
     break;
   }
 }
+
+/**
+ * @brief   Reads a sample into a stream.
+ * @details The LIS3MDL has no FIFO, the status register and the three axes
+ *          are read by a single auto increment burst. To be called on the
+ *          DRDY signal or at the output data rate.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] sad        slave address without R bit
+ * @param[in] msp        pointer to the @p mems_stream_t object, in Gauss
+ * @param[out] message   pointer to message
+ * @return               number of samples read, zero or one.
+ */
+size_t lis3mdlStreamRead(I2CDriver *i2cp, uint8_t sad, mems_stream_t *msp,
+                         msg_t* message) {
+  uint8_t txbuf = LIS3MDL_SUB_MSB | LIS3MDL_SUB_STATUS_REG;
+  size_t n = 0;
+  msg_t msg;
+
+  osalDbgCheck((i2cp != NULL) && (msp != NULL));
+
+  msg = i2cMasterTransmitTimeout(i2cp, sad, &txbuf, 1, msp->raw,
+                                 MEMS_STREAM_SAMPLE_SIZE + 1, TIME_INFINITE);
+  msp->transactions++;
+  if ((msg == MSG_OK) && ((msp->raw[0] & STATUS_ZYXDA) != 0U)) {
+    memsStreamPush(msp, &msp->raw[1], 1, MEMS_STREAM_SAMPLE_SIZE,
+                   chVTGetSystemTimeX(),
+                   (msp->raw[0] & STATUS_ZYXOR) != 0U);
+    n = 1;
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+  return n;
+}
 /** @} */
@@ -36,6 +36,8 @@
 #ifndef _LIS3MDL_H_
 #define _LIS3MDL_H_
 
+#include "mems_stream.h"
+
 /*===========================================================================*/
 /* Driver constants.                                                         */
 /*===========================================================================*/
@@ -249,6 +251,8 @@ extern "C" {
                                  msg_t* message);
   void lis3mdlWriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  size_t lis3mdlStreamRead(I2CDriver *i2cp, uint8_t sad, mems_stream_t *msp,
+                           msg_t* message);
 #ifdef __cplusplus
 }
 #endif
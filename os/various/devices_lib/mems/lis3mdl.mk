@@ -0,0 +1,9 @@
+# LIS3MDL driver files.
+LIS3MDLSRC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/lis3mdl.c
+LIS3MDLINC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems
+
+# Shared variables
+ALLCSRC += $(LIS3MDLSRC)
+ALLINC  += $(LIS3MDLINC)
+
+include $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/mems_stream.mk
@@ -43,6 +43,16 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#define  CTRL_REG3_A_I1_OVERRUN                  ((uint8_t)0x02)
+#define  CTRL_REG3_A_I1_WTM                      ((uint8_t)0x04)
+#define  CTRL_REG5_A_FIFO_EN                     ((uint8_t)0x40)
+#define  FIFO_CTRL_A_FM_BYPASS                   ((uint8_t)0x00)
+#define  FIFO_CTRL_A_FM_STREAM                   ((uint8_t)0x80)
+#define  FIFO_CTRL_A_FTH                         ((uint8_t)0x1F)
+#define  FIFO_SRC_A_FSS                          ((uint8_t)0x1F)
+#define  FIFO_SRC_A_EMPTY                        ((uint8_t)0x20)
+#define  FIFO_SRC_A_OVRN                         ((uint8_t)0x40)
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -56,6 +66,22 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Read-modify-write of an accelerometer register.
+ */
+static msg_t acc_update(I2CDriver *i2cp, uint8_t sub, uint8_t clear,
+                        uint8_t set) {
+  msg_t msg;
+  uint8_t value;
+
+  value = lsm303dlhcReadRegister(i2cp, LSM303DLHC_SAD_ACCEL, sub, &msg);
+  if (msg == MSG_OK) {
+    lsm303dlhcWriteRegister(i2cp, LSM303DLHC_SAD_ACCEL, sub,
+                            (value & ~clear) | set, &msg);
+  }
+  return msg;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -202,4 +228,118 @@ void lsm303dlhcWriteRegister(I2CDriver *i2cp,uint8_t sad, uint8_t sub,
     }
   }
 }
+
+/**
+ * @brief   Enables the accelerometer FIFO in stream mode.
+ * @details The FIFO content is discarded. The watermark and overrun
+ *          interrupts are routed to the INT1 pin.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] watermark  FIFO level raising the watermark interrupt, 0 to 31
+ * @param[out] message   pointer to message
+ */
+void lsm303dlhcFIFOStart(I2CDriver *i2cp, uint8_t watermark,
+                         msg_t* message) {
+  msg_t msg;
+
+  osalDbgCheck((i2cp != NULL) && (watermark <= FIFO_CTRL_A_FTH));
+
+  lsm303dlhcWriteRegister(i2cp, LSM303DLHC_SAD_ACCEL,
+                          LSM303DLHC_SUB_ACC_FIFO_CTRL_REG,
+                          FIFO_CTRL_A_FM_BYPASS, &msg);
+  if (msg == MSG_OK) {
+    msg = acc_update(i2cp, LSM303DLHC_SUB_ACC_CTRL_REG5, 0,
+                     CTRL_REG5_A_FIFO_EN);
+  }
+  if (msg == MSG_OK) {
+    lsm303dlhcWriteRegister(i2cp, LSM303DLHC_SAD_ACCEL,
+                            LSM303DLHC_SUB_ACC_FIFO_CTRL_REG,
+                            FIFO_CTRL_A_FM_STREAM | watermark, &msg);
+  }
+  if (msg == MSG_OK) {
+    msg = acc_update(i2cp, LSM303DLHC_SUB_ACC_CTRL_REG3, 0,
+                     CTRL_REG3_A_I1_WTM | CTRL_REG3_A_I1_OVERRUN);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Disables the accelerometer FIFO.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[out] message   pointer to message
+ */
+void lsm303dlhcFIFOStop(I2CDriver *i2cp, msg_t* message) {
+  msg_t msg;
+
+  osalDbgCheck(i2cp != NULL);
+
+  msg = acc_update(i2cp, LSM303DLHC_SUB_ACC_CTRL_REG3,
+                   CTRL_REG3_A_I1_WTM | CTRL_REG3_A_I1_OVERRUN, 0);
+  if (msg == MSG_OK) {
+    lsm303dlhcWriteRegister(i2cp, LSM303DLHC_SAD_ACCEL,
+                            LSM303DLHC_SUB_ACC_FIFO_CTRL_REG,
+                            FIFO_CTRL_A_FM_BYPASS, &msg);
+  }
+  if (msg == MSG_OK) {
+    msg = acc_update(i2cp, LSM303DLHC_SUB_ACC_CTRL_REG5,
+                     CTRL_REG5_A_FIFO_EN, 0);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Drains the accelerometer FIFO into a stream.
+ * @details Two bus transactions whatever the FIFO level: the FIFO source
+ *          register, then all the samples in a single auto increment burst.
+ *          In FIFO mode the address rolls back from OUT_Z_H_A to OUT_X_L_A.
+ * @pre     The FIFO must have been enabled with @p lsm303dlhcFIFOStart().
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] msp        pointer to the @p mems_stream_t object, in m/s^2
+ * @param[out] message   pointer to message
+ * @return               number of samples read.
+ */
+size_t lsm303dlhcFIFORead(I2CDriver *i2cp, mems_stream_t *msp,
+                          msg_t* message) {
+  uint8_t src, txbuf = LSM303DLHC_SUB_MSB | LSM303DLHC_SUB_ACC_OUT_X_L;
+  systime_t time;
+  size_t n = 0;
+  msg_t msg;
+
+  osalDbgCheck((i2cp != NULL) && (msp != NULL));
+
+  src = lsm303dlhcReadRegister(i2cp, LSM303DLHC_SAD_ACCEL,
+                               LSM303DLHC_SUB_ACC_FIFO_SRC_REG, &msg);
+  msp->transactions++;
+  if ((msg == MSG_OK) && ((src & FIFO_SRC_A_EMPTY) == 0U)) {
+    /* FSS counts up to 31, an overrun means a full FIFO.*/
+    n = (src & FIFO_SRC_A_OVRN) != 0U ? 32U : (size_t)(src & FIFO_SRC_A_FSS);
+    if (n > MEMS_STREAM_BURST_SIZE) {
+      n = MEMS_STREAM_BURST_SIZE;
+    }
+    time = chVTGetSystemTimeX();
+    msg = i2cMasterTransmitTimeout(i2cp, LSM303DLHC_SAD_ACCEL, &txbuf, 1,
+                                   msp->raw, n * MEMS_STREAM_SAMPLE_SIZE,
+                                   TIME_INFINITE);
+    msp->transactions++;
+    if (msg == MSG_OK) {
+      memsStreamPush(msp, msp->raw, n, MEMS_STREAM_SAMPLE_SIZE, time,
+                     (src & FIFO_SRC_A_OVRN) != 0U);
+    }
+    else {
+      n = 0;
+    }
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+  return n;
+}
 /** @} */
@@ -37,6 +37,8 @@
 #ifndef _LSM303DLHC_H_
 #define _LSM303DLHC_H_
 
+#include "mems_stream.h"
+
 /*===========================================================================*/
 /* Driver constants.                                                         */
 /*===========================================================================*/
@@ -343,6 +345,11 @@ extern "C" {
                                  msg_t* message);
   void lsm303dlhcWriteRegister(I2CDriver *i2cp,uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  void lsm303dlhcFIFOStart(I2CDriver *i2cp, uint8_t watermark,
+                           msg_t* message);
+  void lsm303dlhcFIFOStop(I2CDriver *i2cp, msg_t* message);
+  size_t lsm303dlhcFIFORead(I2CDriver *i2cp, mems_stream_t *msp,
+                            msg_t* message);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,9 @@
+# LSM303DLHC driver files.
+LSM303DLHCSRC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/lsm303dlhc.c
+LSM303DLHCINC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems
+
+# Shared variables
+ALLCSRC += $(LSM303DLHCSRC)
+ALLINC  += $(LSM303DLHCINC)
+
+include $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/mems_stream.mk
@@ -43,6 +43,15 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#define  INT_CTRL_FTH                            ((uint8_t)0x08)
+#define  INT_CTRL_OVR                            ((uint8_t)0x10)
+#define  CTRL_REG9_FIFO_EN                       ((uint8_t)0x02)
+#define  FIFO_CTRL_FMODE_BYPASS                  ((uint8_t)0x00)
+#define  FIFO_CTRL_FMODE_CONTINUOUS              ((uint8_t)0xC0)
+#define  FIFO_CTRL_FTH                           ((uint8_t)0x1F)
+#define  FIFO_SRC_FSS                            ((uint8_t)0x3F)
+#define  FIFO_SRC_OVRN                           ((uint8_t)0x40)
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -55,6 +64,31 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Read-modify-write of a register.
+ */
+static msg_t reg_update(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                        uint8_t clear, uint8_t set) {
+  msg_t msg;
+  uint8_t value;
+
+  value = lsm6ds0ReadRegister(i2cp, sad, sub, &msg);
+  if (msg == MSG_OK) {
+    lsm6ds0WriteRegister(i2cp, sad, sub, (value & ~clear) | set, &msg);
+  }
+  return msg;
+}
+
+/**
+ * @brief   Reads a three axes sample, six registers from @p sub.
+ */
+static msg_t sample_read(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                         uint8_t *dp) {
+
+  return i2cMasterTransmitTimeout(i2cp, sad, &sub, 1, dp,
+                                  MEMS_STREAM_SAMPLE_SIZE, TIME_INFINITE);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -181,4 +215,137 @@ void lsm6ds0WriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
   }
 }
 
+/**
+ * @brief   Enables the FIFO in continuous mode.
+ * @details The FIFO content is discarded. The threshold and overrun
+ *          interrupts are routed to the INT1_A/G pin.
+ * @pre     The I2C interface must be initialized and the driver started,
+ *          register address auto increment (IF_ADD_INC) must be enabled.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] sad        slave address without R bit
+ * @param[in] watermark  FIFO threshold raising the interrupt, 0 to 31
+ * @param[out] message   pointer to message
+ */
+void lsm6ds0FIFOStart(I2CDriver *i2cp, uint8_t sad, uint8_t watermark,
+                      msg_t* message) {
+  msg_t msg;
+
+  osalDbgCheck((i2cp != NULL) && (watermark <= FIFO_CTRL_FTH));
+
+  lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                       FIFO_CTRL_FMODE_BYPASS, &msg);
+  if (msg == MSG_OK) {
+    msg = reg_update(i2cp, sad, LSM6DS0_SUB_CTRL_REG9, 0, CTRL_REG9_FIFO_EN);
+  }
+  if (msg == MSG_OK) {
+    lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                         FIFO_CTRL_FMODE_CONTINUOUS | watermark, &msg);
+  }
+  if (msg == MSG_OK) {
+    msg = reg_update(i2cp, sad, LSM6DS0_SUB_INT_CTRL, 0,
+                     INT_CTRL_FTH | INT_CTRL_OVR);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Disables the FIFO.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] sad        slave address without R bit
+ * @param[out] message   pointer to message
+ */
+void lsm6ds0FIFOStop(I2CDriver *i2cp, uint8_t sad, msg_t* message) {
+  msg_t msg;
+
+  osalDbgCheck(i2cp != NULL);
+
+  msg = reg_update(i2cp, sad, LSM6DS0_SUB_INT_CTRL,
+                   INT_CTRL_FTH | INT_CTRL_OVR, 0);
+  if (msg == MSG_OK) {
+    lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                         FIFO_CTRL_FMODE_BYPASS, &msg);
+  }
+  if (msg == MSG_OK) {
+    msg = reg_update(i2cp, sad, LSM6DS0_SUB_CTRL_REG9, CTRL_REG9_FIFO_EN, 0);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Drains the FIFO into the gyroscope and accelerometer streams.
+ * @details The FIFO source register is read once, then each FIFO level is
+ *          read by a OUT_X_L_G to OUT_Z_H_G burst, when the gyroscope is
+ *          enabled, and a OUT_X_L_XL to OUT_Z_H_XL burst. A single burst
+ *          would read INT_GEN_SRC_XL on the way, clearing a latched
+ *          interrupt, so the two are kept apart. The FIFO advances once
+ *          OUT_Z_H_XL is read.
+ * @pre     The FIFO must have been enabled with @p lsm6ds0FIFOStart().
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] sad        slave address without R bit
+ * @param[in] gyrop      pointer to the gyroscope @p mems_stream_t object,
+ *                       in dps, @p NULL if the gyroscope is powered down
+ * @param[in] accp       pointer to the accelerometer @p mems_stream_t
+ *                       object, in m/s^2
+ * @param[out] message   pointer to message
+ * @return               number of FIFO levels read.
+ */
+size_t lsm6ds0FIFORead(I2CDriver *i2cp, uint8_t sad, mems_stream_t *gyrop,
+                       mems_stream_t *accp, msg_t* message) {
+  uint8_t src;
+  systime_t time;
+  size_t i, n;
+  bool overrun;
+  msg_t msg;
+
+  osalDbgCheck((i2cp != NULL) && (accp != NULL));
+
+  src = lsm6ds0ReadRegister(i2cp, sad, LSM6DS0_SUB_FIFO_SRC, &msg);
+  accp->transactions++;
+  n = (msg == MSG_OK) ? (size_t)(src & FIFO_SRC_FSS) : 0U;
+  if (n > MEMS_STREAM_BURST_SIZE) {
+    n = MEMS_STREAM_BURST_SIZE;
+  }
+  overrun = (src & FIFO_SRC_OVRN) != 0U;
+
+  time = chVTGetSystemTimeX();
+  for (i = 0; i < n; i++) {
+    if (gyrop != NULL) {
+      msg = sample_read(i2cp, sad, LSM6DS0_SUB_OUT_X_L_G,
+                        &gyrop->raw[i * MEMS_STREAM_SAMPLE_SIZE]);
+      accp->transactions++;
+      if (msg != MSG_OK) {
+        break;
+      }
+    }
+    msg = sample_read(i2cp, sad, LSM6DS0_SUB_OUT_X_L_XL,
+                      &accp->raw[i * MEMS_STREAM_SAMPLE_SIZE]);
+    accp->transactions++;
+    if (msg != MSG_OK) {
+      break;
+    }
+  }
+  /* Levels read before a failure are kept.*/
+  n = i;
+  if (n > 0U) {
+    if (gyrop != NULL) {
+      memsStreamPush(gyrop, gyrop->raw, n, MEMS_STREAM_SAMPLE_SIZE, time,
+                     overrun);
+    }
+    memsStreamPush(accp, accp->raw, n, MEMS_STREAM_SAMPLE_SIZE, time,
+                   overrun);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+  return n;
+}
+
 /** @} */
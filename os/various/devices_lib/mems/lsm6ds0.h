@@ -36,6 +36,8 @@
 #ifndef _LSM6DS0_H_
 #define _LSM6DS0_H_
 
+#include "mems_stream.h"
+
 /*===========================================================================*/
 /* Driver constants.                                                         */
 /*===========================================================================*/
@@ -473,6 +475,11 @@ extern "C" {
                                  msg_t* message);
   void lsm6ds0WriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  void lsm6ds0FIFOStart(I2CDriver *i2cp, uint8_t sad, uint8_t watermark,
+                        msg_t* message);
+  void lsm6ds0FIFOStop(I2CDriver *i2cp, uint8_t sad, msg_t* message);
+  size_t lsm6ds0FIFORead(I2CDriver *i2cp, uint8_t sad, mems_stream_t *gyrop,
+                         mems_stream_t *accp, msg_t* message);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,9 @@
+# LSM6DS0 driver files.
+LSM6DS0SRC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/lsm6ds0.c
+LSM6DS0INC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems
+
+# Shared variables
+ALLCSRC += $(LSM6DS0SRC)
+ALLINC  += $(LSM6DS0INC)
+
+include $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/mems_stream.mk
@@ -0,0 +1,171 @@
+/*
+    Pretty LAYer for ChibiOS/RT - Copyright (C) 2015 Rocco Marco Guglielmi
+	
+    This file is part of PLAY for ChibiOS/RT.
+
+    PLAY is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    PLAY is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Special thanks to Giovanni Di Sirio for teachings, his moral support and
+    friendship. Note that some or every piece of this file could be part of
+    the ChibiOS project that is intellectual property of Giovanni Di Sirio.
+    Please refer to ChibiOS/RT license before use this file.
+	
+	For suggestion or Bug report - roccomarco.guglielmi@playembedded.org
+ */
+
+
+/**
+ * @file    mems_stream.c
+ * @brief   MEMS FIFO streaming helpers code.
+ *
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+
+#include "mems_stream.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static int16_t raw_axis(const uint8_t *p, bool bigendian) {
+
+  if (bigendian) {
+    return (int16_t)(((uint16_t)p[0] << 8) | p[1]);
+  }
+  return (int16_t)(((uint16_t)p[1] << 8) | p[0]);
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a MEMS stream object.
+ *
+ * @param[out] msp          pointer to the @p mems_stream_t object
+ * @param[in] buffer        ring buffer
+ * @param[in] size          ring buffer size, a power of two
+ * @param[in] sensitivity   raw units per engineering unit, for each axis
+ * @param[in] period        sample period, in microseconds
+ * @param[in] bigendian     raw samples endianness, as configured in the
+ *                          sensor
+ */
+void memsStreamObjectInit(mems_stream_t *msp, mems_sample_t *buffer,
+                          uint32_t size, const float sensitivity[3],
+                          uint32_t period, bool bigendian) {
+  unsigned i;
+
+  osalDbgCheck((msp != NULL) && (buffer != NULL) && (sensitivity != NULL));
+  osalDbgCheck((size > 0U) && ((size & (size - 1U)) == 0U));
+
+  msp->buffer = buffer;
+  msp->size = size;
+  msp->wr = 0;
+  msp->rd = 0;
+  for (i = 0; i < 3; i++) {
+    msp->sensitivity[i] = sensitivity[i];
+  }
+  msp->period = period;
+  msp->bigendian = bigendian;
+  msp->seq = 0;
+  msp->overruns = 0;
+  msp->dropped = 0;
+  msp->transactions = 0;
+}
+
+/**
+ * @brief   Converts raw samples and appends them to the ring.
+ * @note    Only the producer thread can call this function.
+ *
+ * @param[in] msp       pointer to the @p mems_stream_t object
+ * @param[in] raw       raw samples, X, Y and Z axes, 16 bits each
+ * @param[in] n         number of samples
+ * @param[in] stride    distance between samples in @p raw, in bytes
+ * @param[in] time      system time of the last sample
+ * @param[in] overrun   the sensor FIFO overran before this burst, samples
+ *                      were lost
+ */
+void memsStreamPush(mems_stream_t *msp, const uint8_t *raw, size_t n,
+                    size_t stride, systime_t time, bool overrun) {
+  uint32_t wr = msp->wr;
+  size_t i;
+
+  if (overrun) {
+    /* The number of lost samples is unknown, at least one.*/
+    msp->overruns++;
+    msp->seq++;
+  }
+  for (i = 0; i < n; i++, raw += stride) {
+    mems_sample_t *sp;
+    unsigned axis;
+
+    if (wr - msp->rd >= msp->size) {
+      msp->dropped++;
+      msp->seq++;
+      continue;
+    }
+    sp = &msp->buffer[wr & (msp->size - 1U)];
+    sp->time = time - (systime_t)TIME_US2I((n - 1U - i) * msp->period);
+    sp->seq = msp->seq++;
+    for (axis = 0; axis < 3; axis++) {
+      sp->axes[axis] = (float)raw_axis(&raw[axis * 2U], msp->bigendian) /
+                       msp->sensitivity[axis];
+    }
+    wr++;
+  }
+  /* Samples are written before being published.*/
+  __DMB();
+  msp->wr = wr;
+}
+
+/**
+ * @brief   Gets a sample from the ring.
+ * @note    Only the consumer thread can call this function.
+ *
+ * @param[in] msp       pointer to the @p mems_stream_t object
+ * @param[out] sp       the sample
+ * @return              The operation status.
+ * @retval true         a sample has been returned.
+ * @retval false        the ring is empty.
+ */
+bool memsStreamGet(mems_stream_t *msp, mems_sample_t *sp) {
+  uint32_t rd = msp->rd;
+
+  if (rd == msp->wr) {
+    return false;
+  }
+  *sp = msp->buffer[rd & (msp->size - 1U)];
+  __DMB();
+  msp->rd = rd + 1U;
+  return true;
+}
+
+/** @} */
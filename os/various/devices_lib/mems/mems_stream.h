@@ -0,0 +1,180 @@
+/*
+    Pretty LAYer for ChibiOS/RT - Copyright (C) 2015 Rocco Marco Guglielmi
+	
+    This file is part of PLAY for ChibiOS/RT.
+
+    PLAY is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    PLAY is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Special thanks to Giovanni Di Sirio for teachings, his moral support and
+    friendship. Note that some or every piece of this file could be part of
+    the ChibiOS project that is intellectual property of Giovanni Di Sirio.
+    Please refer to ChibiOS/RT license before use this file.
+	
+	For suggestion or Bug report - roccomarco.guglielmi@playembedded.org
+ */
+
+
+/**
+ * @file    mems_stream.h
+ * @brief   MEMS FIFO streaming helpers header.
+ * @details Timestamped ring of samples in engineering units, filled by the
+ *          FIFO read functions of the MEMS drivers, e.g. @p l3gd20FIFORead().
+ *          The ring has a single producer, the thread draining the sensor,
+ *          and a single consumer. It is built by the driver makefiles,
+ *          e.g. @p l3gd20.mk.
+ *
+ * @{
+ */
+
+#ifndef _MEMS_STREAM_H_
+#define _MEMS_STREAM_H_
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a raw three axes sample, in bytes.
+ */
+#define MEMS_STREAM_SAMPLE_SIZE         6U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of raw samples read in a single burst.
+ * @details The sensors FIFOs are 32 levels deep.
+ */
+#if !defined(MEMS_STREAM_BURST_SIZE) || defined(__DOXYGEN__)
+#define MEMS_STREAM_BURST_SIZE          32U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Sample in engineering units.
+ */
+typedef struct {
+  /**
+   * @brief System time of the sample.
+   * @details Back dated from the time of the burst read, by the sample
+   *          period times the number of following samples in the burst.
+   */
+  systime_t     time;
+  /**
+   * @brief Sample number since @p memsStreamObjectInit(), gaps are samples
+   *        lost in the sensor FIFO or in the ring.
+   */
+  uint32_t      seq;
+  /**
+   * @brief X, Y and Z axes.
+   */
+  float         axes[3];
+} mems_sample_t;
+
+/**
+ * @brief   MEMS stream object.
+ */
+typedef struct {
+  /**
+   * @brief Ring buffer.
+   */
+  mems_sample_t *buffer;
+  /**
+   * @brief Ring buffer size, a power of two.
+   */
+  uint32_t      size;
+  /**
+   * @brief Write index, free running, only written by the producer.
+   */
+  volatile uint32_t wr;
+  /**
+   * @brief Read index, free running, only written by the consumer.
+   */
+  volatile uint32_t rd;
+  /**
+   * @brief Sensitivity per axis, raw units per engineering unit, e.g.
+   *        @p L3GD20_SENS_250DPS.
+   */
+  float         sensitivity[3];
+  /**
+   * @brief Sample period, in microseconds.
+   */
+  uint32_t      period;
+  /**
+   * @brief Bool flag. If @p true raw samples are big endian.
+   */
+  bool          bigendian;
+  /**
+   * @brief Next sample number.
+   */
+  uint32_t      seq;
+  /**
+   * @brief Sensor FIFO overruns detected.
+   */
+  uint32_t      overruns;
+  /**
+   * @brief Samples dropped because the ring was full.
+   */
+  uint32_t      dropped;
+  /**
+   * @brief Bus transactions done by the FIFO read functions.
+   */
+  uint32_t      transactions;
+  /**
+   * @brief Burst buffer, an extra byte for the SPI address.
+   */
+  uint8_t       raw[MEMS_STREAM_BURST_SIZE * MEMS_STREAM_SAMPLE_SIZE + 1];
+} mems_stream_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of samples in the ring.
+ *
+ * @param[in] msp       pointer to the @p mems_stream_t object
+ */
+#define memsStreamGetUsed(msp) ((size_t)((msp)->wr - (msp)->rd))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void memsStreamObjectInit(mems_stream_t *msp, mems_sample_t *buffer,
+                            uint32_t size, const float sensitivity[3],
+                            uint32_t period, bool bigendian);
+  void memsStreamPush(mems_stream_t *msp, const uint8_t *raw, size_t n,
+                      size_t stride, systime_t time, bool overrun);
+  bool memsStreamGet(mems_stream_t *msp, mems_sample_t *sp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MEMS_STREAM_H_ */
+
+/** @} */
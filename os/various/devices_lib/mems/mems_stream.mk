@@ -0,0 +1,7 @@
+# MEMS FIFO streaming helpers, included by the MEMS driver makefiles.
+ifeq ($(MEMSSTREAMSRC),)
+MEMSSTREAMSRC := $(CHIBIOS_CONTRIB)/os/various/devices_lib/mems/mems_stream.c
+
+# Shared variables
+ALLCSRC += $(MEMSSTREAMSRC)
+endif
@@ -37,6 +37,8 @@
 #include "ch.h"
 #include "hal.h"
 
+#include <string.h>
+
 #include "nrf24l01.h"
 
 /*===========================================================================*/
@@ -44,6 +46,37 @@
 /*===========================================================================*/
 
 #define ACTIVATE                  0x73
+
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @name    Driver thread events
+ * @{
+ */
+#define EVT_IRQ                   EVENT_MASK(0)
+#define EVT_KICK                  EVENT_MASK(1)
+#define EVT_MODE                  EVENT_MASK(2)
+/** @} */
+
+/**
+ * @brief   Maximum number of packets loaded in the chip TX FIFO.
+ * @details With at most two payloads in the FIFO a TX_DS flag, even when it
+ *          stands for several sent payloads, is resolved by a single
+ *          TX_EMPTY check. In PRX mode one ACK payload at a time is loaded,
+ *          so that TX_DS always refers to it.
+ */
+#define TX_LOADED_MAX             2U
+
+#define STATUS_IRQ_FLAGS          (NRF24L01_DI_STATUS_MAX_RT |                \
+                                   NRF24L01_DI_STATUS_TX_DS |                 \
+                                   NRF24L01_DI_STATUS_RX_DR)
+#define STATUS_RX_P_NO(status)    (((status) >> 1) & 7U)
+
+#define CONFIG_PTX                (NRF24L01_DI_CONFIG_EN_CRC |                \
+                                   NRF24L01_DI_CONFIG_CRCO |                  \
+                                   NRF24L01_DI_CONFIG_PWR_UP)
+#define CONFIG_PRX                (CONFIG_PTX | NRF24L01_DI_CONFIG_PRIM_RX)
+#endif /* NRF24L01_USE_DRIVER */
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -56,6 +89,342 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Executes a command.
+ * @details Command and data are clocked in a single exchange, the status
+ *          register comes for free as first received byte.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ * @param[in] n         number of bytes in @p txbuf, command included
+ *
+ * @return              the status register value
+ *
+ * @notapi
+ */
+static NRF24L01_status_t drv_xfer(NRF24L01Driver *devp, size_t n) {
+  SPIDriver *spip = devp->config->spip;
+
+  spiSelect(spip);
+  spiExchange(spip, n, devp->txbuf, devp->rxbuf);
+  spiUnselect(spip);
+  devp->spi_transfers++;
+  return devp->rxbuf[0];
+}
+
+static NRF24L01_status_t drv_cmd(NRF24L01Driver *devp, uint8_t cmd) {
+
+  devp->txbuf[0] = cmd;
+  return drv_xfer(devp, 1);
+}
+
+static NRF24L01_status_t drv_write_reg(NRF24L01Driver *devp, uint8_t reg,
+                                       uint8_t value) {
+
+  devp->txbuf[0] = NRF24L01_CMD_WRITE | reg;
+  devp->txbuf[1] = value;
+  return drv_xfer(devp, 2);
+}
+
+static uint8_t drv_read_reg(NRF24L01Driver *devp, uint8_t reg) {
+
+  devp->txbuf[0] = NRF24L01_CMD_READ | reg;
+  devp->txbuf[1] = NRF24L01_CMD_NOP;
+  (void)drv_xfer(devp, 2);
+  return devp->rxbuf[1];
+}
+
+/**
+ * @brief   Tells if payloads have a dynamic length.
+ * @details Otherwise every pipe receives @p NRF24L01_MAX_PL_LENGHT bytes, see
+ *          @p nrf24l01Start().
+ *
+ * @notapi
+ */
+static bool drv_dpl(NRF24L01Driver *devp) {
+
+#if NRF24L01_USE_FEATURE
+  return devp->config->en_dpl != NRF24L01_DPL_disabled;
+#else
+  (void)devp;
+  return false;
+#endif
+}
+
+static void drv_ce(NRF24L01Driver *devp, bool on) {
+
+  if (on) {
+    palSetPad(devp->config->ceport, devp->config->cepad);
+  }
+  else {
+    palClearPad(devp->config->ceport, devp->config->cepad);
+  }
+}
+
+/**
+ * @brief   Applies the requested operating mode.
+ * @note    Loaded payloads are flushed, they are still in the TX queue and
+ *          are loaded again for the new mode.
+ *
+ * @notapi
+ */
+static void drv_set_mode(NRF24L01Driver *devp) {
+
+  devp->chip_mode = devp->mode;
+  drv_ce(devp, false);
+  (void)drv_cmd(devp, NRF24L01_CMD_FLUSH_TX);
+  devp->tx_loaded = 0;
+  if (devp->chip_mode == NRF24L01_MODE_PRX) {
+    (void)drv_write_reg(devp, NRF24L01_AD_CONFIG, CONFIG_PRX);
+    drv_ce(devp, true);
+  }
+  else {
+    (void)drv_write_reg(devp, NRF24L01_AD_CONFIG, CONFIG_PTX);
+  }
+}
+
+/**
+ * @brief   Removes packets from the head of the TX queue.
+ *
+ * @notapi
+ */
+static void drv_tx_pop(NRF24L01Driver *devp, unsigned n) {
+
+  chSysLock();
+  while (n-- > 0U) {
+    devp->tx_rd = (uint8_t)((devp->tx_rd + 1U) % NRF24L01_TX_QUEUE_SIZE);
+    devp->tx_count--;
+    chSemSignalI(&devp->tx_sem);
+  }
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Loads the chip TX FIFO from the TX queue.
+ * @details One exchange per payload. In PTX mode CE is kept high while
+ *          payloads are loaded, so that they are sent back to back.
+ * @note    Without dynamic payloads the receiver expects exactly
+ *          @p NRF24L01_MAX_PL_LENGHT bytes, shorter packets are padded with
+ *          zeros.
+ *
+ * @notapi
+ */
+static void drv_tx_load(NRF24L01Driver *devp) {
+  bool prx = devp->chip_mode == NRF24L01_MODE_PRX;
+  unsigned max = prx ? 1U : TX_LOADED_MAX;
+
+  while ((devp->tx_loaded < max) && (devp->tx_loaded < devp->tx_count)) {
+    const NRF24L01_packet_t *pkt;
+    unsigned i, n;
+
+    i = (devp->tx_rd + devp->tx_loaded) % NRF24L01_TX_QUEUE_SIZE;
+    pkt = &devp->txq[i];
+#if NRF24L01_USE_FEATURE
+    if (prx) {
+      devp->txbuf[0] = NRF24L01_CMD_W_ACK_PAYLOAD | pkt->pipe;
+    }
+    else if (pkt->noack && devp->config->en_dyn_ack) {
+      devp->txbuf[0] = NRF24L01_CMD_W_TX_PAYLOAD_NOACK;
+    }
+    else
+#endif
+    {
+      devp->txbuf[0] = NRF24L01_CMD_W_TX_PAYLOAD;
+    }
+    n = pkt->length;
+    memcpy(&devp->txbuf[1], pkt->data, n);
+    if (!drv_dpl(devp)) {
+      memset(&devp->txbuf[1U + n], 0, NRF24L01_MAX_PL_LENGHT - n);
+      n = NRF24L01_MAX_PL_LENGHT;
+    }
+    (void)drv_xfer(devp, 1U + n);
+    devp->tx_loaded++;
+  }
+  if (!prx && (devp->tx_loaded > 0U)) {
+    drv_ce(devp, true);
+  }
+}
+
+/**
+ * @brief   Handles the TX_DS and MAX_RT flags.
+ *
+ * @notapi
+ */
+static eventflags_t drv_tx_serve(NRF24L01Driver *devp, NRF24L01_status_t status) {
+  eventflags_t flags = 0;
+  unsigned sent = 0;
+
+  if ((status & NRF24L01_DI_STATUS_TX_DS) != 0U) {
+    /* With two payloads loaded, one is still there unless the FIFO is empty,
+       see TX_LOADED_MAX.*/
+    sent = devp->tx_loaded;
+    if ((sent > 1U) &&
+        ((drv_read_reg(devp, NRF24L01_AD_FIFO_STATUS) &
+          NRF24L01_DI_FIFO_STATUS_TX_EMPTY) == 0U)) {
+      sent = 1U;
+    }
+    if (sent > 0U) {
+      devp->tx_loaded -= (uint8_t)sent;
+      devp->tx_done += sent;
+      drv_tx_pop(devp, sent);
+      flags |= NRF24L01_EVT_TX_DONE;
+    }
+  }
+  if ((status & NRF24L01_DI_STATUS_MAX_RT) != 0U) {
+    /* The head payload is dropped, the following ones are loaded again.*/
+    (void)drv_cmd(devp, NRF24L01_CMD_FLUSH_TX);
+    if (devp->tx_loaded > 0U) {
+      devp->tx_failed++;
+      drv_tx_pop(devp, 1U);
+    }
+    devp->tx_loaded = 0;
+    flags |= NRF24L01_EVT_TX_FAILED;
+  }
+  if ((devp->chip_mode == NRF24L01_MODE_PTX) && (devp->tx_loaded == 0U)) {
+    drv_ce(devp, false);
+  }
+  return flags;
+}
+
+/**
+ * @brief   Moves a payload from the chip RX FIFO to the RX queue.
+ *
+ * @notapi
+ */
+static void drv_rx_read(NRF24L01Driver *devp, uint8_t pipe, uint8_t len) {
+  NRF24L01_packet_t *pkt;
+
+  devp->txbuf[0] = NRF24L01_CMD_R_RX_PAYLOAD;
+  memset(&devp->txbuf[1], NRF24L01_CMD_NOP, len);
+  (void)drv_xfer(devp, 1U + len);
+
+  /* The slot at rx_wr is not visible to readers until rx_count is
+     incremented, only this thread writes it.*/
+  if (devp->rx_count >= NRF24L01_RX_QUEUE_SIZE) {
+    devp->rx_dropped++;
+    return;
+  }
+  pkt = &devp->rxq[devp->rx_wr];
+  pkt->pipe = pipe;
+  pkt->length = len;
+  pkt->noack = false;
+  memcpy(pkt->data, &devp->rxbuf[1], len);
+  devp->rx_received++;
+
+  chSysLock();
+  devp->rx_wr = (uint8_t)((devp->rx_wr + 1U) % NRF24L01_RX_QUEUE_SIZE);
+  devp->rx_count++;
+  chSemSignalI(&devp->rx_sem);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Empties the chip RX FIFO.
+ * @details The status byte clocked out by each command tells the pipe of the
+ *          next payload, so that no separate status or FIFO_STATUS read is
+ *          needed: with dynamic payloads R_RX_PL_WID doubles as status probe,
+ *          two exchanges per payload in both cases.
+ *
+ * @notapi
+ */
+static eventflags_t drv_rx_serve(NRF24L01Driver *devp, NRF24L01_status_t status) {
+  eventflags_t flags = 0;
+
+#if NRF24L01_USE_FEATURE
+  if (drv_dpl(devp)) {
+    while (true) {
+      uint8_t len;
+
+      devp->txbuf[0] = NRF24L01_CMD_R_RX_PL_WID;
+      devp->txbuf[1] = NRF24L01_CMD_NOP;
+      status = drv_xfer(devp, 2);
+      if (STATUS_RX_P_NO(status) > NRF24L01_MAX_PPP) {
+        break;
+      }
+      len = devp->rxbuf[1];
+      if ((len == 0U) || (len > NRF24L01_MAX_PL_LENGHT)) {
+        /* Corrupted width, the datasheet requires a flush.*/
+        (void)drv_cmd(devp, NRF24L01_CMD_FLUSH_RX);
+        devp->rx_dropped++;
+        break;
+      }
+      drv_rx_read(devp, STATUS_RX_P_NO(status), len);
+      flags |= NRF24L01_EVT_RX;
+    }
+    return flags;
+  }
+#endif
+  while (STATUS_RX_P_NO(status) <= NRF24L01_MAX_PPP) {
+    drv_rx_read(devp, STATUS_RX_P_NO(status), NRF24L01_MAX_PL_LENGHT);
+    flags |= NRF24L01_EVT_RX;
+    status = drv_cmd(devp, NRF24L01_CMD_NOP);
+  }
+  return flags;
+}
+
+/**
+ * @brief   Serves the chip interrupt.
+ * @details Flags are read and cleared by a single STATUS write.
+ *
+ * @notapi
+ */
+static void drv_serve(NRF24L01Driver *devp) {
+  NRF24L01_status_t status;
+  eventflags_t flags = 0;
+
+  status = drv_write_reg(devp, NRF24L01_AD_STATUS, STATUS_IRQ_FLAGS);
+  if ((status & (NRF24L01_DI_STATUS_TX_DS | NRF24L01_DI_STATUS_MAX_RT)) != 0U) {
+    flags |= drv_tx_serve(devp, status);
+  }
+  if (((status & NRF24L01_DI_STATUS_RX_DR) != 0U) ||
+      (STATUS_RX_P_NO(status) <= NRF24L01_MAX_PPP)) {
+    flags |= drv_rx_serve(devp, status);
+  }
+  if (flags != 0U) {
+    chEvtBroadcastFlags(&devp->event, flags);
+  }
+}
+
+static bool drv_irq_asserted(NRF24L01Driver *devp) {
+
+  return palReadPad(devp->config->irqport, devp->config->irqpad) == PAL_LOW;
+}
+
+static void drv_irq_cb(void *arg) {
+  NRF24L01Driver *devp = (NRF24L01Driver *)arg;
+
+  chSysLockFromISR();
+  chEvtSignalI(devp->thread, EVT_IRQ);
+  chSysUnlockFromISR();
+}
+
+static THD_FUNCTION(drv_thread, arg) {
+  NRF24L01Driver *devp = (NRF24L01Driver *)arg;
+
+  chRegSetThreadName("nrf24l01");
+
+  while (true) {
+    eventmask_t evt = chEvtWaitAny(ALL_EVENTS);
+
+    if (chThdShouldTerminateX()) {
+      break;
+    }
+    if ((evt & EVT_MODE) != 0U) {
+      drv_set_mode(devp);
+    }
+    /* The IRQ line is a level, it is checked again so that an edge lost
+       while serving is not a stall.*/
+    while (drv_irq_asserted(devp)) {
+      drv_serve(devp);
+    }
+    drv_tx_load(devp);
+  }
+  chThdExit(MSG_OK);
+}
+#endif /* NRF24L01_USE_DRIVER */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -437,4 +806,234 @@ NRF24L01_status_t nrf24l01WriteTxPlNoAck(SPIDriver *spip, uint8_t paylen,
 }
 #endif /* NRF24L01_USE_FEATURE */
 
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p NRF24L01Driver object
+ *
+ * @init
+ */
+void nrf24l01ObjectInit(NRF24L01Driver *devp) {
+
+  devp->state = NRF24L01_STOP;
+  devp->config = NULL;
+  devp->thread = NULL;
+  chEvtObjectInit(&devp->event);
+  chSemObjectInit(&devp->tx_sem, NRF24L01_TX_QUEUE_SIZE);
+  chSemObjectInit(&devp->rx_sem, 0);
+}
+
+/**
+ * @brief   Configures and activates the RF Transceiver.
+ * @details The chip is set up with auto ACK on every pipe, 16 bits CRC and
+ *          fixed 32 bytes payloads unless dynamic payloads are enabled. It
+ *          starts in PTX mode.
+ * @note    Addresses are not part of the configuration, they can be written
+ *          with @p nrf24l01WriteAddress() after this call, before queueing
+ *          packets or changing mode.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ * @param[in] config    pointer to the @p NRF24L01_Config object
+ *
+ * @api
+ */
+void nrf24l01Start(NRF24L01Driver *devp, const NRF24L01_Config *config) {
+  uint8_t feature = 0, i;
+
+  osalDbgCheck((devp != NULL) && (config != NULL));
+  osalDbgAssert(devp->state == NRF24L01_STOP,
+                "nrf24l01Start(), invalid state");
+
+  devp->config = config;
+  devp->mode = NRF24L01_MODE_PTX;
+  devp->chip_mode = NRF24L01_MODE_PTX;
+  devp->tx_rd = devp->tx_wr = devp->tx_count = devp->tx_loaded = 0;
+  devp->rx_rd = devp->rx_wr = devp->rx_count = 0;
+  devp->tx_done = devp->tx_failed = 0;
+  devp->rx_received = devp->rx_dropped = 0;
+  devp->spi_transfers = 0;
+  chSemReset(&devp->tx_sem, NRF24L01_TX_QUEUE_SIZE);
+  chSemReset(&devp->rx_sem, 0);
+
+  spiStart(config->spip, config->spicfg);
+  drv_ce(devp, false);
+
+  (void)drv_write_reg(devp, NRF24L01_AD_CONFIG, CONFIG_PTX);
+  (void)drv_write_reg(devp, NRF24L01_AD_EN_AA, NRF24L01_DI_EN_AA);
+  (void)drv_write_reg(devp, NRF24L01_AD_EN_RXADDR,
+                      NRF24L01_DI_EN_RXADDR_P0 | NRF24L01_DI_EN_RXADDR_P1);
+  (void)drv_write_reg(devp, NRF24L01_AD_SETUP_AW, config->address_width);
+  (void)drv_write_reg(devp, NRF24L01_AD_SETUP_RETR,
+                      config->auto_retr_delay | config->auto_retr_count);
+  (void)drv_write_reg(devp, NRF24L01_AD_RF_CH, config->channel_freq);
+  (void)drv_write_reg(devp, NRF24L01_AD_RF_SETUP,
+                      config->data_rate | config->out_pwr | config->lna);
+#if NRF24L01_USE_FEATURE
+  feature = config->en_dpl | config->en_ack_pay | config->en_dyn_ack;
+  (void)drv_write_reg(devp, NRF24L01_AD_FEATURE, feature);
+  if ((feature != 0U) &&
+      (drv_read_reg(devp, NRF24L01_AD_FEATURE) != feature)) {
+    /* nRF24L01 (non plus) parts need the features activated first.*/
+    devp->txbuf[0] = NRF24L01_CMD_ACTIVATE;
+    devp->txbuf[1] = ACTIVATE;
+    (void)drv_xfer(devp, 2);
+    (void)drv_write_reg(devp, NRF24L01_AD_FEATURE, feature);
+  }
+  (void)drv_write_reg(devp, NRF24L01_AD_DYNPD,
+                      config->en_dpl ? NRF24L01_DI_DYNPD : 0U);
+#endif
+  if ((feature & NRF24L01_DI_FEATURE_EN_DPL) == 0U) {
+    for (i = 0; i <= NRF24L01_MAX_PPP; i++) {
+      (void)drv_write_reg(devp, NRF24L01_AD_RX_PW_P0 + i,
+                          NRF24L01_MAX_PL_LENGHT);
+    }
+  }
+  (void)drv_cmd(devp, NRF24L01_CMD_FLUSH_TX);
+  (void)drv_cmd(devp, NRF24L01_CMD_FLUSH_RX);
+  (void)drv_write_reg(devp, NRF24L01_AD_STATUS, STATUS_IRQ_FLAGS);
+
+  /* Power up time, Tpd2stby.*/
+  chThdSleepMilliseconds(2);
+
+  devp->thread = chThdCreateStatic(devp->wa, sizeof(devp->wa),
+                                   NRF24L01_THREAD_PRIORITY, drv_thread, devp);
+  palSetPadCallback(config->irqport, config->irqpad, drv_irq_cb, devp);
+  palEnablePadEvent(config->irqport, config->irqpad,
+                    PAL_EVENT_MODE_FALLING_EDGE);
+  devp->state = NRF24L01_READY;
+}
+
+/**
+ * @brief   Deactivates the RF Transceiver.
+ * @details Queued packets are discarded, waiting threads are released with
+ *          @p MSG_RESET.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ *
+ * @api
+ */
+void nrf24l01Stop(NRF24L01Driver *devp) {
+
+  osalDbgCheck(devp != NULL);
+  osalDbgAssert((devp->state == NRF24L01_STOP) ||
+                (devp->state == NRF24L01_READY),
+                "nrf24l01Stop(), invalid state");
+
+  if (devp->state == NRF24L01_READY) {
+    palDisablePadEvent(devp->config->irqport, devp->config->irqpad);
+    chThdTerminate(devp->thread);
+    chEvtSignal(devp->thread, EVT_KICK);
+    (void)chThdWait(devp->thread);
+    devp->thread = NULL;
+
+    drv_ce(devp, false);
+    (void)drv_write_reg(devp, NRF24L01_AD_CONFIG, 0);
+    spiStop(devp->config->spip);
+
+    chSemReset(&devp->tx_sem, NRF24L01_TX_QUEUE_SIZE);
+    chSemReset(&devp->rx_sem, 0);
+  }
+  devp->state = NRF24L01_STOP;
+}
+
+/**
+ * @brief   Switches between PTX and PRX mode.
+ * @details The change is applied by the driver thread. Packets still in the
+ *          TX queue are kept: in PRX mode they become ACK payloads.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ * @param[in] mode      new operating mode
+ *
+ * @api
+ */
+void nrf24l01SetMode(NRF24L01Driver *devp, NRF24L01_mode_t mode) {
+
+  osalDbgCheck(devp != NULL);
+  osalDbgAssert(devp->state == NRF24L01_READY,
+                "nrf24l01SetMode(), invalid state");
+
+  devp->mode = mode;
+  chEvtSignal(devp->thread, EVT_MODE);
+}
+
+/**
+ * @brief   Queues a packet.
+ * @details In PTX mode the packet is transmitted, in PRX mode it is the
+ *          payload of the next ACK sent on @p pkt->pipe. ACK payloads are
+ *          sent in queue order. The result is reported by the
+ *          @p NRF24L01_EVT_TX_DONE and @p NRF24L01_EVT_TX_FAILED flags.
+ * @note    Without dynamic payloads the packet is padded with zeros to
+ *          @p NRF24L01_MAX_PL_LENGHT bytes, the receiver gets them all.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ * @param[in] pkt       packet to be queued, copied
+ * @param[in] timeout   time to wait for a free queue slot
+ * @return              The operation status.
+ * @retval MSG_OK       packet queued.
+ * @retval MSG_TIMEOUT  queue full until the timeout.
+ * @retval MSG_RESET    driver stopped while waiting.
+ *
+ * @api
+ */
+msg_t nrf24l01Send(NRF24L01Driver *devp, const NRF24L01_packet_t *pkt,
+                   sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((devp != NULL) && (pkt != NULL));
+  osalDbgCheck((pkt->length > 0U) && (pkt->length <= NRF24L01_MAX_PL_LENGHT));
+  osalDbgCheck(pkt->pipe <= NRF24L01_MAX_PPP);
+  osalDbgAssert(devp->state == NRF24L01_READY,
+                "nrf24l01Send(), invalid state");
+
+  msg = chSemWaitTimeout(&devp->tx_sem, timeout);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  chSysLock();
+  devp->txq[devp->tx_wr] = *pkt;
+  devp->tx_wr = (uint8_t)((devp->tx_wr + 1U) % NRF24L01_TX_QUEUE_SIZE);
+  devp->tx_count++;
+  chEvtSignalI(devp->thread, EVT_KICK);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Gets a received packet.
+ *
+ * @param[in] devp      pointer to the @p NRF24L01Driver object
+ * @param[out] pkt      received packet
+ * @param[in] timeout   time to wait for a packet
+ * @return              The operation status.
+ * @retval MSG_OK       packet received.
+ * @retval MSG_TIMEOUT  no packet until the timeout.
+ * @retval MSG_RESET    driver stopped while waiting.
+ *
+ * @api
+ */
+msg_t nrf24l01Receive(NRF24L01Driver *devp, NRF24L01_packet_t *pkt,
+                      sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((devp != NULL) && (pkt != NULL));
+
+  msg = chSemWaitTimeout(&devp->rx_sem, timeout);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  chSysLock();
+  *pkt = devp->rxq[devp->rx_rd];
+  devp->rx_rd = (uint8_t)((devp->rx_rd + 1U) % NRF24L01_RX_QUEUE_SIZE);
+  devp->rx_count--;
+  chSysUnlock();
+
+  return MSG_OK;
+}
+#endif /* NRF24L01_USE_DRIVER */
+
 /** @} */
@@ -272,6 +272,48 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    NRF24L01 driver configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the asynchronous driver object.
+ * @details The driver serves the IRQ line from a thread and keeps software
+ *          TX/RX packet queues in front of the chip FIFOs.
+ */
+#if !defined(NRF24L01_USE_DRIVER) || defined(__DOXYGEN__)
+#define NRF24L01_USE_DRIVER                      FALSE
+#endif
+
+/**
+ * @brief   Number of packets in the TX queue.
+ */
+#if !defined(NRF24L01_TX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_TX_QUEUE_SIZE                   8
+#endif
+
+/**
+ * @brief   Number of packets in the RX queue.
+ */
+#if !defined(NRF24L01_RX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_RX_QUEUE_SIZE                   8
+#endif
+
+/**
+ * @brief   Driver thread working area size.
+ */
+#if !defined(NRF24L01_THREAD_WA_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_THREAD_WA_SIZE                  256
+#endif
+
+/**
+ * @brief   Driver thread priority.
+ */
+#if !defined(NRF24L01_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define NRF24L01_THREAD_PRIORITY                 (NORMALPRIO + 2)
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -280,8 +322,8 @@
 #error "RF_NRF24L01 requires HAL_USE_SPI."
 #endif
 
-#if !(HAL_USE_EXT)
-#error "RF_NRF24L01 requires HAL_USE_EXT."
+#if NRF24L01_USE_DRIVER && !PAL_USE_CALLBACKS
+#error "NRF24L01_USE_DRIVER requires PAL_USE_CALLBACKS."
 #endif
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
@@ -395,7 +437,7 @@ typedef  enum {
  * @details This type specifies if trasmission must be compatible to receive
  *          from an nRF2401/nRF2402/nRF24E1/nRF24E.
  */
-typedef  bool_t                   NRF24L01_bckwrdcmp_t;
+typedef  bool                     NRF24L01_bckwrdcmp_t;
 
 #if NRF24L01_USE_FEATURE || defined(__doxigen__)
 /**
@@ -458,6 +500,7 @@ typedef struct {
    * @brief Pointer to the SPI configuration .
    */
   const SPIConfig           *spicfg;
+#if HAL_USE_EXT || defined(__DOXYGEN__)
   /**
    * @brief Pointer to the EXT driver associated to this RF.
    */
@@ -466,6 +509,7 @@ typedef struct {
    * @brief EXT configuration.
    */
   EXTConfig                 *extcfg;
+#endif
   /**
    * @brief RF Transceiver auto retransmit count.
    */
@@ -516,6 +560,116 @@ typedef struct {
  * @brief   RF Transceiver status register value.
  */
 typedef  uint8_t             NRF24L01_status_t;
+
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  NRF24L01_UNINIT = 0,                   /**< Not initialized.               */
+  NRF24L01_STOP = 1,                     /**< Stopped, chip powered down.    */
+  NRF24L01_READY = 2                     /**< Ready, thread running.         */
+} NRF24L01_state_t;
+
+/**
+ * @brief   RF Transceiver operating mode.
+ */
+typedef enum {
+  NRF24L01_MODE_PTX = 0,                 /**< Primary transmitter.           */
+  NRF24L01_MODE_PRX = 1                  /**< Primary receiver.              */
+} NRF24L01_mode_t;
+
+/**
+ * @name    Driver event flags
+ * @{
+ */
+#define NRF24L01_EVT_RX                          ((eventflags_t)1)
+#define NRF24L01_EVT_TX_DONE                     ((eventflags_t)2)
+#define NRF24L01_EVT_TX_FAILED                   ((eventflags_t)4)
+/** @} */
+
+/**
+ * @brief   RF packet.
+ * @details In PTX mode a queued packet is sent to the configured TX address,
+ *          in PRX mode it is sent as payload of the next ACK on @p pipe.
+ */
+typedef struct {
+  uint8_t                   pipe;        /**< Pipe, 0 to 5.                  */
+  uint8_t                   length;      /**< Payload length, 1 to 32.       */
+  bool                      noack;       /**< No ACK requested (EN_DYN_ACK). */
+  uint8_t                   data[NRF24L01_MAX_PL_LENGHT];
+} NRF24L01_packet_t;
+
+/**
+ * @brief   Asynchronous RF Transceiver driver.
+ */
+typedef struct {
+  /**
+   * @brief Driver state.
+   */
+  NRF24L01_state_t          state;
+  /**
+   * @brief Current configuration data.
+   */
+  const NRF24L01_Config     *config;
+  /**
+   * @brief Requested operating mode.
+   */
+  NRF24L01_mode_t           mode;
+  /**
+   * @brief Operating mode set in the chip.
+   */
+  NRF24L01_mode_t           chip_mode;
+  /**
+   * @brief Driver thread.
+   */
+  thread_t                  *thread;
+  /**
+   * @brief Events source, @p NRF24L01_EVT_xxx flags.
+   */
+  event_source_t            event;
+  /**
+   * @brief TX queue, the first @p tx_loaded packets are in the chip.
+   */
+  NRF24L01_packet_t         txq[NRF24L01_TX_QUEUE_SIZE];
+  uint8_t                   tx_rd;
+  uint8_t                   tx_wr;
+  volatile uint8_t          tx_count;
+  uint8_t                   tx_loaded;
+  /**
+   * @brief Counts the free TX queue slots.
+   */
+  semaphore_t               tx_sem;
+  /**
+   * @brief RX queue.
+   */
+  NRF24L01_packet_t         rxq[NRF24L01_RX_QUEUE_SIZE];
+  uint8_t                   rx_rd;
+  uint8_t                   rx_wr;
+  volatile uint8_t          rx_count;
+  /**
+   * @brief Counts the packets in the RX queue.
+   */
+  semaphore_t               rx_sem;
+  /**
+   * @brief SPI buffers, command byte plus a payload.
+   */
+  uint8_t                   txbuf[NRF24L01_MAX_PL_LENGHT + 1];
+  uint8_t                   rxbuf[NRF24L01_MAX_PL_LENGHT + 1];
+  /**
+   * @brief Statistics.
+   */
+  uint32_t                  tx_done;
+  uint32_t                  tx_failed;
+  uint32_t                  rx_received;
+  uint32_t                  rx_dropped;
+  uint32_t                  spi_transfers;
+  /**
+   * @brief Driver thread working area.
+   */
+  THD_WORKING_AREA(wa, NRF24L01_THREAD_WA_SIZE);
+} NRF24L01Driver;
+#endif /* NRF24L01_USE_DRIVER */
 /** @}  */
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -566,6 +720,16 @@ NRF24L01_status_t nrf24l01WriteAckPl(SPIDriver *spip, uint8_t ppp, uint8_t payle
 NRF24L01_status_t nrf24l01WriteTxPlNoAck(SPIDriver *spip, uint8_t paylen,
                                          uint8_t* txbuf);
 #endif /* NRF24L01_USE_FEATURE */
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+void nrf24l01ObjectInit(NRF24L01Driver *devp);
+void nrf24l01Start(NRF24L01Driver *devp, const NRF24L01_Config *config);
+void nrf24l01Stop(NRF24L01Driver *devp);
+void nrf24l01SetMode(NRF24L01Driver *devp, NRF24L01_mode_t mode);
+msg_t nrf24l01Send(NRF24L01Driver *devp, const NRF24L01_packet_t *pkt,
+                   sysinterval_t timeout);
+msg_t nrf24l01Receive(NRF24L01Driver *devp, NRF24L01_packet_t *pkt,
+                      sysinterval_t timeout);
+#endif /* NRF24L01_USE_DRIVER */
 #ifdef __cplusplus
 }
 #endif
@@ -24,7 +24,6 @@
 
 
 #define BIT_MASK_UINT_8(x) 					  (0xFF >> (8 - (x)))
-#define NRF52_PIPE_COUNT 					  9
 
 #define RADIO_SHORTS_COMMON ( RADIO_SHORTS_READY_START_Msk | RADIO_SHORTS_END_DISABLE_Msk | \
             RADIO_SHORTS_ADDRESS_RSSISTART_Msk | RADIO_SHORTS_DISABLED_RSSISTOP_Msk )
@@ -95,76 +94,31 @@
 #error "Event thread priority need to be defined"
 #endif
 
-#define VERIFY_PAYLOAD_LENGTH(p)                            \
-do                                                          \
-{                                                           \
-    if(p->length == 0 ||                                    \
-       p->length > NRF52_MAX_PAYLOAD_LENGTH ||              \
-       (RFD1.config.protocol == NRF52_PROTOCOL_ESB &&       \
-        p->length > RFD1.config.payload_length))            \
-    {                                                       \
-        return NRF52_ERROR_INVALID_LENGTH;                  \
-    }                                                       \
-}while(0)
-
-//Structure holding pipe info PID and CRC and ack payload.
-typedef struct
-{
-    uint16_t            m_crc;
-    uint8_t             m_pid;
-    uint8_t             m_ack_payload;
-} pipe_info_t;
-
-// First in first out queue of payloads to be transmitted.
-typedef struct
-{
-    nrf52_payload_t *   p_payload[NRF52_TX_FIFO_SIZE];      /**< Pointer to the actual queue. */
-    uint32_t            entry_point;                        /**< Current start of queue. */
-    uint32_t            exit_point;                         /**< Current end of queue. */
-    uint32_t            count;                              /**< Current number of elements in the queue. */
-} nrf52_payload_tx_fifo_t;
-
-// First in first out queue of received payloads.
-typedef struct
-{
-    nrf52_payload_t *   p_payload[NRF52_RX_FIFO_SIZE];      /**< Pointer to the actual queue. */
-    uint32_t            entry_point;                        /**< Current start of queue. */
-    uint32_t            exit_point;                         /**< Current end of queue. */
-    uint32_t            count;                              /**< Current number of elements in the queue. */
-} nrf52_payload_rx_fifo_t;
-
-// These function pointers are changed dynamically, depending on protocol configuration and state.
-//static void (*on_radio_end)(RFDriver *rfp) = NULL;
-static void (*set_rf_payload_format)(RFDriver *rfp, uint32_t payload_length) = NULL;
-
-// The following functions are assigned to the function pointers above.
+#if (NRF52_TX_FIFO_SIZE & (NRF52_TX_FIFO_SIZE - 1)) != 0
+#error "NRF52_TX_FIFO_SIZE must be a power of two"
+#endif
+
+#if (NRF52_RX_FIFO_SIZE & (NRF52_RX_FIFO_SIZE - 1)) != 0
+#error "NRF52_RX_FIFO_SIZE must be a power of two"
+#endif
+
+// Radio thread requests
+#define NRF52_REQ_DISABLED                    (1 << 0)    /*< The radio raised the DISABLED event. */
+#define NRF52_REQ_FLUSH_TX                    (1 << 1)    /*< Payloads were dropped from the TX FIFO. */
+#define NRF52_REQ_START_TX                    (1 << 2)    /*< Start transmitting if idle. */
+
+#define TX_FIFO_SLOT(rfp, i)    (&(rfp)->tx_fifo.payload[(i) & (NRF52_TX_FIFO_SIZE - 1)])
+#define RX_FIFO_SLOT(rfp, i)    (&(rfp)->rx_fifo.payload[(i) & (NRF52_RX_FIFO_SIZE - 1)])
+
+// The following functions are called by the interrupt handle thread, depending on state.
 static void on_radio_disabled_tx_noack(RFDriver *rfp);
 static void on_radio_disabled_tx(RFDriver *rfp);
 static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp);
 static void on_radio_disabled_rx(RFDriver *rfp);
 static void on_radio_disabled_rx_ack(RFDriver *rfp);
-
-static volatile uint16_t wait_for_ack_timeout_us;
-static nrf52_payload_t * p_current_payload;
-
-// TX FIFO
-static nrf52_payload_t            tx_fifo_payload[NRF52_TX_FIFO_SIZE];
-static nrf52_payload_tx_fifo_t    tx_fifo;
-
-// RX FIFO
-static nrf52_payload_t            rx_fifo_payload[NRF52_RX_FIFO_SIZE];
-static nrf52_payload_rx_fifo_t    rx_fifo;
-
-// Payload buffers
-static uint8_t                    tx_payload_buffer[NRF52_MAX_PAYLOAD_LENGTH + 2];
-static uint8_t                    rx_payload_buffer[NRF52_MAX_PAYLOAD_LENGTH + 2];
-
-static uint8_t                    pids[NRF52_PIPE_COUNT];
-static pipe_info_t                rx_pipe_info[NRF52_PIPE_COUNT];
-
- // disable and events semaphores.
-static binary_semaphore_t disable_sem;
-static binary_semaphore_t events_sem;
+static void tx_fifo_sync(RFDriver *rfp);
+static nrf52_payload_t *tx_fifo_peek(RFDriver *rfp);
+static void start_tx_transaction(RFDriver *rfp);
 
 RFDriver RFD1;
 
@@ -183,24 +137,24 @@ static uint32_t addr_conv(uint8_t const* p_addr) {
 static thread_t *rfEvtThread_p;
 static THD_WORKING_AREA(waRFEvtThread, 64);
 static THD_FUNCTION(rfEvtThread, arg) {
-    (void)arg;
+    RFDriver *rfp = (RFDriver *)arg;
 
     chRegSetThreadName("rfevent");
 
     while (!chThdShouldTerminateX()) {
-    	chBSemWait(&events_sem);
+    	chBSemWait(&rfp->events_sem);
 
-    	nrf52_int_flags_t interrupts = RFD1.flags;
-        RFD1.flags = 0;
+    	nrf52_int_flags_t interrupts = rfp->flags;
+        rfp->flags = 0;
 
         if (interrupts & NRF52_INT_TX_SUCCESS_MSK) {
-            chEvtBroadcastFlags(&RFD1.eventsrc, (eventflags_t) NRF52_EVENT_TX_SUCCESS);
+            chEvtBroadcastFlags(&rfp->eventsrc, (eventflags_t) NRF52_EVENT_TX_SUCCESS);
         }
         if (interrupts & NRF52_INT_TX_FAILED_MSK) {
-        	chEvtBroadcastFlags(&RFD1.eventsrc, (eventflags_t) NRF52_EVENT_TX_FAILED);
+        	chEvtBroadcastFlags(&rfp->eventsrc, (eventflags_t) NRF52_EVENT_TX_FAILED);
         }
         if (interrupts & NRF52_INT_RX_DR_MSK) {
-        	chEvtBroadcastFlags(&RFD1.eventsrc, (eventflags_t) NRF52_EVENT_RX_RECEIVED);
+        	chEvtBroadcastFlags(&rfp->eventsrc, (eventflags_t) NRF52_EVENT_RX_RECEIVED);
         }
     }
     chThdExit((msg_t) 0);
@@ -209,37 +163,54 @@ static THD_FUNCTION(rfEvtThread, arg) {
 static thread_t *rfIntThread_p;
 static THD_WORKING_AREA(waRFIntThread, 64);
 static THD_FUNCTION(rfIntThread, arg) {
-    (void)arg;
+    RFDriver *rfp = (RFDriver *)arg;
 
     chRegSetThreadName("rfint");
 
     while (!chThdShouldTerminateX()) {
-    	chBSemWait(&disable_sem);
-    	switch (RFD1.state) {
-    	  case NRF52_STATE_PTX_TX:
-    		  on_radio_disabled_tx_noack(&RFD1);
+    	uint32_t requests;
+
+    	chBSemWait(&rfp->disable_sem);
+    	chSysLock();
+    	requests = rfp->requests;
+    	rfp->requests = 0;
+    	chSysUnlock();
+
+    	if (requests & NRF52_REQ_DISABLED) {
+    	  switch (rfp->state) {
+    	    case NRF52_STATE_PTX_TX:
+    		  on_radio_disabled_tx_noack(rfp);
     		  break;
-    	  case NRF52_STATE_PTX_TX_ACK:
-    		  on_radio_disabled_tx(&RFD1);
+    	    case NRF52_STATE_PTX_TX_ACK:
+    		  on_radio_disabled_tx(rfp);
     		  break;
-    	  case NRF52_STATE_PTX_RX_ACK:
-    		  on_radio_disabled_tx_wait_for_ack(&RFD1);
+    	    case NRF52_STATE_PTX_RX_ACK:
+    		  on_radio_disabled_tx_wait_for_ack(rfp);
     		  break;
-    	  case NRF52_STATE_PRX:
-    		  on_radio_disabled_rx(&RFD1);
+    	    case NRF52_STATE_PRX:
+    		  on_radio_disabled_rx(rfp);
     		  break;
-    	  case NRF52_STATE_PRX_SEND_ACK:
-    		  on_radio_disabled_rx_ack(&RFD1);
+    	    case NRF52_STATE_PRX_SEND_ACK:
+    		  on_radio_disabled_rx_ack(rfp);
     		  break;
-    	  default:
+    	    default:
     		  break;
+    	  }
+    	}
+
+    	// Requests of the application, this thread is the only TX FIFO consumer
+    	if (requests & NRF52_REQ_FLUSH_TX) {
+    	    tx_fifo_sync(rfp);
+    	}
+    	if ((requests & NRF52_REQ_START_TX) && rfp->state == NRF52_STATE_IDLE &&
+    	    tx_fifo_peek(rfp) != NULL) {
+    	    start_tx_transaction(rfp);
     	}
     }
 	chThdExit((msg_t) 0);
 }
 
 static void serve_radio_interrupt(RFDriver *rfp) {
-	(void) rfp;
     if ((NRF_RADIO->INTENSET & RADIO_INTENSET_READY_Msk) && NRF_RADIO->EVENTS_READY) {
         NRF_RADIO->EVENTS_READY = 0;
         (void) NRF_RADIO->EVENTS_READY;
@@ -248,7 +219,8 @@ static void serve_radio_interrupt(RFDriver *rfp) {
         NRF_RADIO->EVENTS_DISABLED = 0;
         (void) NRF_RADIO->EVENTS_DISABLED;
         chSysLockFromISR();
-       	chBSemSignalI(&disable_sem);
+        rfp->requests |= NRF52_REQ_DISABLED;
+       	chBSemSignalI(&rfp->disable_sem);
        	chSysUnlockFromISR();
     }
 }
@@ -322,6 +294,17 @@ static void set_addresses(RFDriver *rfp, uint8_t update_mask) {
     }
 }
 
+static void set_rf_payload_format(RFDriver *rfp, uint32_t payload_length) {
+    switch (rfp->config.protocol) {
+        case NRF52_PROTOCOL_ESB_DPL:
+            set_rf_payload_format_esb_dpl(rfp, payload_length);
+            break;
+        case NRF52_PROTOCOL_ESB:
+            set_rf_payload_format_esb(rfp, payload_length);
+            break;
+    }
+}
+
 static void set_tx_power(RFDriver *rfp) {
     NRF_RADIO->TXPOWER = rfp->config.tx_power << RADIO_TXPOWER_TXPOWER_Pos;
 }
@@ -331,21 +314,10 @@ static void set_bitrate(RFDriver *rfp) {
 
     switch (rfp->config.bitrate) {
         case NRF52_BITRATE_2MBPS:
-            wait_for_ack_timeout_us = RX_WAIT_FOR_ACK_TIMEOUT_US_2MBPS;
+            rfp->wait_for_ack_timeout_us = RX_WAIT_FOR_ACK_TIMEOUT_US_2MBPS;
             break;
         case NRF52_BITRATE_1MBPS:
-            wait_for_ack_timeout_us = RX_WAIT_FOR_ACK_TIMEOUT_US_1MBPS;
-            break;
-    }
-}
-
-static void set_protocol(RFDriver *rfp) {
-    switch (rfp->config.protocol) {
-        case NRF52_PROTOCOL_ESB_DPL:
-            set_rf_payload_format = set_rf_payload_format_esb_dpl;
-            break;
-        case NRF52_PROTOCOL_ESB:
-            set_rf_payload_format = set_rf_payload_format_esb;
+            rfp->wait_for_ack_timeout_us = RX_WAIT_FOR_ACK_TIMEOUT_US_1MBPS;
             break;
     }
 }
@@ -382,52 +354,73 @@ static void ppi_init(RFDriver *rfp) {
 static void set_parameters(RFDriver *rfp) {
     set_tx_power(rfp);
     set_bitrate(rfp);
-    set_protocol(rfp);
     set_crc(rfp);
     set_rf_payload_format(rfp, rfp->config.payload_length);
 }
 
-static void reset_fifo(void) {
-    tx_fifo.entry_point = 0;
-    tx_fifo.exit_point  = 0;
-    tx_fifo.count       = 0;
+static void reset_fifo(RFDriver *rfp) {
+    rfp->tx_fifo.wr    = 0;
+    rfp->tx_fifo.rd    = 0;
+    rfp->tx_fifo.flush = 0;
 
-    rx_fifo.entry_point = 0;
-    rx_fifo.exit_point  = 0;
-    rx_fifo.count       = 0;
+    rfp->rx_fifo.wr    = 0;
+    rfp->rx_fifo.rd    = 0;
 }
 
-static void init_fifo(void) {
-	uint8_t i;
-    reset_fifo();
+/*
+ * TX FIFO consumer side, interrupts handle thread only: the application posts
+ * requests to it instead of touching rd. The slot at rd belongs to the radio
+ * until it is removed.
+ */
+
+// Skips the payloads discarded by radio_flush_tx() and radio_pop_tx().
+static void tx_fifo_sync(RFDriver *rfp) {
+    uint32_t flush = rfp->tx_fifo.flush;
 
-    for (i = 0; i < NRF52_TX_FIFO_SIZE; i++) {
-        tx_fifo.p_payload[i] = &tx_fifo_payload[i];
+    if ((int32_t)(flush - rfp->tx_fifo.rd) > 0) {
+        rfp->tx_fifo.rd = flush;
     }
+}
 
-    for (i = 0; i < NRF52_RX_FIFO_SIZE; i++) {
-        rx_fifo.p_payload[i] = &rx_fifo_payload[i];
+static nrf52_payload_t *tx_fifo_peek(RFDriver *rfp) {
+    tx_fifo_sync(rfp);
+    if (rfp->tx_fifo.wr == rfp->tx_fifo.rd) {
+        return NULL;
     }
+    __DMB();
+    return TX_FIFO_SLOT(rfp, rfp->tx_fifo.rd);
 }
 
-static void tx_fifo_remove_last(void) {
-    if (tx_fifo.count > 0) {
-        nvicDisableVector(RADIO_IRQn);
+static void tx_fifo_remove_last(RFDriver *rfp) {
+    if (rfp->tx_fifo.wr != rfp->tx_fifo.rd) {
+        __DMB();
+        rfp->tx_fifo.rd++;
+    }
+    tx_fifo_sync(rfp);
+}
 
-        tx_fifo.count--;
-        if (++tx_fifo.exit_point >= NRF52_TX_FIFO_SIZE) {
-            tx_fifo.exit_point = 0;
-        }
+/*
+ * RX FIFO producer side, radio threads only. The radio receives straight into
+ * the slot at wr; when the FIFO is full it receives into rx_overflow and the
+ * packet is dropped.
+ */
 
-        nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+static uint32_t rx_fifo_packetptr(RFDriver *rfp) {
+    if (rfp->rx_fifo.wr - rfp->rx_fifo.rd < NRF52_RX_FIFO_SIZE) {
+        rfp->rx_payload = RX_FIFO_SLOT(rfp, rfp->rx_fifo.wr);
+    }
+    else {
+        rfp->rx_payload = &rfp->rx_overflow;
     }
+    return (uint32_t)rfp->rx_payload->header;
 }
 
-/** @brief  Function to push the content of the rx_buffer to the RX FIFO.
+/** @brief  Function to publish the received packet in the RX FIFO.
  *
- *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for receiving packets.
- *  After receiving a packet the module will call this function to copy the received data to
- *  the RX FIFO.
+ *  The module points the register NRF_RADIO->PACKETPTR to the RX FIFO slot
+ *  being filled, see rx_fifo_packetptr(). After receiving a packet the module
+ *  calls this function to complete the slot and hand it to the application,
+ *  no data is copied.
  *
  *  @param  pipe Pipe number to set for the packet.
  *  @param  pid  Packet ID.
@@ -436,37 +429,35 @@ static void tx_fifo_remove_last(void) {
  *  @retval false  Operation failed.
  */
 static bool rx_fifo_push_rfbuf(RFDriver *rfp, uint8_t pipe, uint8_t pid) {
-    if (rx_fifo.count < NRF52_RX_FIFO_SIZE) {
-        if (rfp->config.protocol == NRF52_PROTOCOL_ESB_DPL) {
-            if (rx_payload_buffer[0] > NRF52_MAX_PAYLOAD_LENGTH) {
-                return false;
-            }
-
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = rx_payload_buffer[0];
-        }
-        else if (rfp->state == NRF52_STATE_PTX_RX_ACK) {
-            // Received packet is an acknowledgment
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = 0;
-        }
-        else {
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = rfp->config.payload_length;
-        }
+    nrf52_payload_t *p = rfp->rx_payload;
 
-        memcpy(rx_fifo.p_payload[rx_fifo.entry_point]->data, &rx_payload_buffer[2],
-               rx_fifo.p_payload[rx_fifo.entry_point]->length);
+    if (p == &rfp->rx_overflow) {
+        return false;
+    }
 
-        rx_fifo.p_payload[rx_fifo.entry_point]->pipe = pipe;
-        rx_fifo.p_payload[rx_fifo.entry_point]->rssi = NRF_RADIO->RSSISAMPLE;
-        rx_fifo.p_payload[rx_fifo.entry_point]->pid = pid;
-        if (++rx_fifo.entry_point >= NRF52_RX_FIFO_SIZE) {
-            rx_fifo.entry_point = 0;
+    if (rfp->config.protocol == NRF52_PROTOCOL_ESB_DPL) {
+        if (p->header[0] > NRF52_MAX_PAYLOAD_LENGTH) {
+            return false;
         }
-        rx_fifo.count++;
 
-        return true;
+        p->length = p->header[0];
+    }
+    else if (rfp->state == NRF52_STATE_PTX_RX_ACK) {
+        // Received packet is an acknowledgment
+        p->length = 0;
     }
+    else {
+        p->length = rfp->config.payload_length;
+    }
+
+    p->pipe = pipe;
+    p->rssi = NRF_RADIO->RSSISAMPLE;
+    p->pid = pid;
 
-    return false;
+    __DMB();
+    rfp->rx_fifo.wr++;
+
+    return true;
 }
 
 static void timer_init(RFDriver *rfp) {
@@ -477,23 +468,28 @@ static void timer_init(RFDriver *rfp) {
 }
 
 static void start_tx_transaction(RFDriver *rfp) {
+    nrf52_payload_t *p;
     bool ack;
 
     rfp->tx_attempt = 1;
     rfp->tx_remaining = rfp->config.retransmit.count;
 
-    // Prepare the payload
-    p_current_payload = tx_fifo.p_payload[tx_fifo.exit_point];
+    // Prepare the payload, it is transmitted in place from its FIFO slot
+    p = tx_fifo_peek(rfp);
+    if (p == NULL) {
+        rfp->state = NRF52_STATE_IDLE;
+        return;
+    }
+    rfp->tx_payload = p;
 
     // Handling ack if noack is set to false or if selctive auto ack is turned turned off
-    ack = !p_current_payload->noack || !rfp->config.selective_auto_ack;
+    ack = !p->noack || !rfp->config.selective_auto_ack;
 
     switch (rfp->config.protocol) {
         case NRF52_PROTOCOL_ESB:
-            set_rf_payload_format(rfp, p_current_payload->length);
-            tx_payload_buffer[0] = p_current_payload->pid;
-            tx_payload_buffer[1] = 0;
-            memcpy(&tx_payload_buffer[2], p_current_payload->data, p_current_payload->length);
+            set_rf_payload_format(rfp, p->length);
+            p->header[0] = p->pid;
+            p->header[1] = 0;
 
             NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
             NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk | RADIO_INTENSET_READY_Msk;
@@ -504,10 +500,9 @@ static void start_tx_transaction(RFDriver *rfp) {
             break;
 
         case NRF52_PROTOCOL_ESB_DPL:
-            tx_payload_buffer[0] = p_current_payload->length;
-            tx_payload_buffer[1] = p_current_payload->pid << 1;
-            tx_payload_buffer[1] |= ack ? 0x00 : 0x01;
-            memcpy(&tx_payload_buffer[2], p_current_payload->data, p_current_payload->length);
+            p->header[0] = p->length;
+            p->header[1] = p->pid << 1;
+            p->header[1] |= ack ? 0x00 : 0x01;
 
             if (ack) {
                 NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
@@ -525,11 +520,11 @@ static void start_tx_transaction(RFDriver *rfp) {
             break;
     }
 
-    NRF_RADIO->TXADDRESS    = p_current_payload->pipe;
-    NRF_RADIO->RXADDRESSES  = 1 << p_current_payload->pipe;
+    NRF_RADIO->TXADDRESS    = p->pipe;
+    NRF_RADIO->RXADDRESSES  = 1 << p->pipe;
 
     NRF_RADIO->FREQUENCY    = rfp->config.address.rf_channel;
-    NRF_RADIO->PACKETPTR    = (uint32_t)tx_payload_buffer;
+    NRF_RADIO->PACKETPTR    = (uint32_t)p->header;
 
     NRF_RADIO->EVENTS_READY = 0;
     NRF_RADIO->EVENTS_DISABLED = 0;
@@ -539,16 +534,18 @@ static void start_tx_transaction(RFDriver *rfp) {
     nvicClearPending(RADIO_IRQn);
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
+    // Header written above must be visible to EasyDMA
+    __DMB();
     NRF_RADIO->TASKS_TXEN  = 1;
 }
 
 static void on_radio_disabled_tx_noack(RFDriver *rfp) {
     rfp->flags |= NRF52_INT_TX_SUCCESS_MSK;
-    tx_fifo_remove_last();
+    tx_fifo_remove_last(rfp);
 
-	chBSemSignal(&events_sem);
+	chBSemSignal(&rfp->events_sem);
 
-	if (tx_fifo.count == 0) {
+	if (tx_fifo_peek(rfp) == NULL) {
         rfp->state = NRF52_STATE_IDLE;
     }
     else {
@@ -564,7 +561,7 @@ static void on_radio_disabled_tx(RFDriver *rfp) {
     // Make sure the timer is started the next time the radio is ready,
     // and that it will disable the radio automatically if no packet is
     // received by the time defined in m_wait_for_ack_timeout_us
-    rfp->timer->CC[0]    = wait_for_ack_timeout_us + 130;
+    rfp->timer->CC[0]    = rfp->wait_for_ack_timeout_us + 130;
     rfp->timer->CC[1]    = rfp->config.retransmit.delay - 130;
     rfp->timer->TASKS_CLEAR = 1;
     rfp->timer->EVENTS_COMPARE[0] = 0;
@@ -584,7 +581,7 @@ static void on_radio_disabled_tx(RFDriver *rfp) {
         set_rf_payload_format(rfp, 0);
     }
 
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = rx_fifo_packetptr(rfp);
     rfp->state = NRF52_STATE_PTX_RX_ACK;
 }
 
@@ -603,17 +600,17 @@ static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
         rfp->flags |= NRF52_INT_TX_SUCCESS_MSK;
         rfp->tx_attempt++;// = rfp->config.retransmit.count - rfp->tx_remaining + 1;
 
-        tx_fifo_remove_last();
+        tx_fifo_remove_last(rfp);
 
-        if (rfp->config.protocol != NRF52_PROTOCOL_ESB && rx_payload_buffer[0] > 0) {
+        if (rfp->config.protocol != NRF52_PROTOCOL_ESB && rfp->rx_payload->header[0] > 0) {
             if (rx_fifo_push_rfbuf(rfp, (uint8_t)NRF_RADIO->TXADDRESS, 0)) {
                 rfp->flags |= NRF52_INT_RX_DR_MSK;
             }
         }
 
-    	chBSemSignal(&events_sem);
+    	chBSemSignal(&rfp->events_sem);
 
-        if ((tx_fifo.count == 0) || (rfp->config.tx_mode == NRF52_TXMODE_MANUAL)) {
+        if ((tx_fifo_peek(rfp) == NULL) || (rfp->config.tx_mode == NRF52_TXMODE_MANUAL)) {
             rfp->state = NRF52_STATE_IDLE;
         }
         else {
@@ -628,7 +625,7 @@ static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
             rfp->tx_attempt = rfp->config.retransmit.count + 1;
             rfp->flags |= NRF52_INT_TX_FAILED_MSK;
 
-            chBSemSignal(&events_sem);
+            chBSemSignal(&rfp->events_sem);
 
             rfp->state = NRF52_STATE_IDLE;
         }
@@ -636,8 +633,8 @@ static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
             // There are still have more retransmits left, TX mode should be
             // entered again as soon as the system timer reaches CC[1].
             NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
-            set_rf_payload_format(rfp, p_current_payload->length);
-            NRF_RADIO->PACKETPTR = (uint32_t)tx_payload_buffer;
+            set_rf_payload_format(rfp, rfp->tx_payload->length);
+            NRF_RADIO->PACKETPTR = (uint32_t)rfp->tx_payload->header;
             rfp->state = NRF52_STATE_PTX_TX_ACK;
             rfp->timer->TASKS_START = 1;
             NRF_PPI->CHENSET = (1 << NRF52_RADIO_PPI_TX_START);
@@ -650,7 +647,7 @@ static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
 static void clear_events_restart_rx(RFDriver *rfp) {
     NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON;
     set_rf_payload_format(rfp, rfp->config.payload_length);
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = rx_fifo_packetptr(rfp);
 
     NRF_RADIO->INTENCLR = RADIO_INTENCLR_DISABLED_Msk;
     NRF_RADIO->EVENTS_DISABLED = 0;
@@ -668,32 +665,35 @@ static void clear_events_restart_rx(RFDriver *rfp) {
 }
 
 static void on_radio_disabled_rx(RFDriver *rfp) {
-    bool            ack                = false;
-    bool            retransmit_payload = false;
-    bool            send_rx_event      = true;
-    pipe_info_t *   p_pipe_info;
+    bool                ack                = false;
+    bool                retransmit_payload = false;
+    bool                send_rx_event      = true;
+    nrf52_pipe_info_t * p_pipe_info;
+    nrf52_payload_t *   p_rx               = rfp->rx_payload;
+    nrf52_payload_t *   p_tx;
 
     if (NRF_RADIO->CRCSTATUS == 0) {
         clear_events_restart_rx(rfp);
         return;
     }
 
-    if(rx_fifo.count >= NRF52_RX_FIFO_SIZE) {
+    if (p_rx == &rfp->rx_overflow) {
+        // RX FIFO was full when the reception started
         clear_events_restart_rx(rfp);
         return;
     }
 
-    p_pipe_info = &rx_pipe_info[NRF_RADIO->RXMATCH];
-    if (NRF_RADIO->RXCRC           == p_pipe_info->m_crc &&
-       (rx_payload_buffer[1] >> 1) == p_pipe_info->m_pid  ) {
+    p_pipe_info = &rfp->rx_pipe_info[NRF_RADIO->RXMATCH];
+    if (NRF_RADIO->RXCRC          == p_pipe_info->m_crc &&
+       (p_rx->header[1] >> 1)     == p_pipe_info->m_pid  ) {
         retransmit_payload = true;
         send_rx_event = false;
     }
 
-    p_pipe_info->m_pid = rx_payload_buffer[1] >> 1;
+    p_pipe_info->m_pid = p_rx->header[1] >> 1;
     p_pipe_info->m_crc = NRF_RADIO->RXCRC;
 
-    if(rfp->config.selective_auto_ack == false || ((rx_payload_buffer[1] & 0x01) == 0))
+    if(rfp->config.selective_auto_ack == false || ((p_rx->header[1] & 0x01) == 0))
         ack = true;
 
     if(ack) {
@@ -702,116 +702,122 @@ static void on_radio_disabled_rx(RFDriver *rfp) {
         switch(rfp->config.protocol) {
             case NRF52_PROTOCOL_ESB_DPL:
                 {
-                    if (tx_fifo.count > 0 &&
-                        (tx_fifo.p_payload[tx_fifo.exit_point]->pipe == NRF_RADIO->RXMATCH))
-                    {
+                    p_tx = tx_fifo_peek(rfp);
+                    if (p_tx != NULL && p_tx->pipe == NRF_RADIO->RXMATCH) {
                         // Pipe stays in ACK with payload until TX fifo is empty
                         // Do not report TX success on first ack payload or retransmit
-                        if (p_pipe_info->m_ack_payload != 0 && !retransmit_payload) {
-                            if(++tx_fifo.exit_point >= NRF52_TX_FIFO_SIZE) {
-                                tx_fifo.exit_point = 0;
-                            }
-
-                            tx_fifo.count--;
+                        if (p_pipe_info->m_ack_payload != 0 && !retransmit_payload &&
+                            p_tx == rfp->tx_payload) {
+                            tx_fifo_remove_last(rfp);
 
                             // ACK payloads also require TX_DS
                             // (page 40 of the 'nRF24LE1_Product_Specification_rev1_6.pdf').
                             rfp->flags |= NRF52_INT_TX_SUCCESS_MSK;
+
+                            p_tx = tx_fifo_peek(rfp);
+                            if (p_tx != NULL && p_tx->pipe != NRF_RADIO->RXMATCH) {
+                                p_tx = NULL;
+                            }
                         }
+                    }
+                    else {
+                        p_tx = NULL;
+                    }
 
+                    if (p_tx != NULL) {
                         p_pipe_info->m_ack_payload = 1;
 
-                        p_current_payload = tx_fifo.p_payload[tx_fifo.exit_point];
-
-                        set_rf_payload_format(rfp, p_current_payload->length);
-                        tx_payload_buffer[0] = p_current_payload->length;
-                        memcpy(&tx_payload_buffer[2],
-                               p_current_payload->data,
-                               p_current_payload->length);
+                        // The ack payload is transmitted in place from its FIFO slot
+                        rfp->tx_payload = p_tx;
+                        set_rf_payload_format(rfp, p_tx->length);
+                        p_tx->header[0] = p_tx->length;
+                        p_tx->header[1] = p_rx->header[1];
+                        NRF_RADIO->PACKETPTR = (uint32_t)p_tx->header;
                     }
                     else {
                         p_pipe_info->m_ack_payload = 0;
                         set_rf_payload_format(rfp, 0);
-                        tx_payload_buffer[0] = 0;
+                        rfp->ack_header[0] = 0;
+                        rfp->ack_header[1] = p_rx->header[1];
+                        NRF_RADIO->PACKETPTR = (uint32_t)rfp->ack_header;
                     }
-
-                    tx_payload_buffer[1] = rx_payload_buffer[1];
                 }
                 break;
 
             case NRF52_PROTOCOL_ESB:
                 {
                     set_rf_payload_format(rfp, 0);
-                    tx_payload_buffer[0] = rx_payload_buffer[0];
-                    tx_payload_buffer[1] = 0;
+                    rfp->ack_header[0] = p_rx->header[0];
+                    rfp->ack_header[1] = 0;
+                    NRF_RADIO->PACKETPTR = (uint32_t)rfp->ack_header;
                 }
                 break;
         }
 
         rfp->state = NRF52_STATE_PRX_SEND_ACK;
         NRF_RADIO->TXADDRESS = NRF_RADIO->RXMATCH;
-        NRF_RADIO->PACKETPTR = (uint32_t)tx_payload_buffer;
-    }
-    else {
-        clear_events_restart_rx(rfp);
     }
 
     if (send_rx_event) {
-        // Push the new packet to the RX buffer and trigger a received event if the operation was
-        // successful.
+        // Publish the new packet in the RX FIFO and trigger a received event if the operation was
+        // successful. Done before restarting the reception, which claims the next slot.
         if (rx_fifo_push_rfbuf(rfp, NRF_RADIO->RXMATCH, p_pipe_info->m_pid)) {
             rfp->flags |= NRF52_INT_RX_DR_MSK;
-            chBSemSignal(&events_sem);
+            chBSemSignal(&rfp->events_sem);
         }
     }
+
+    if (!ack) {
+        clear_events_restart_rx(rfp);
+    }
 }
 
 static void on_radio_disabled_rx_ack(RFDriver *rfp) {
     NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_TXEN_Msk;
     set_rf_payload_format(rfp, rfp->config.payload_length);
 
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = rx_fifo_packetptr(rfp);
 
     rfp->state = NRF52_STATE_PRX;
 }
 
-nrf52_error_t radio_disable(void) {
-    RFD1.state = NRF52_STATE_IDLE;
+nrf52_error_t radio_disable(RFDriver *rfp) {
+    rfp->state = NRF52_STATE_IDLE;
 
     // Clear PPI
     NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TIMER_START) |
                        (1 << NRF52_RADIO_PPI_TIMER_STOP)  |
                        (1 << NRF52_RADIO_PPI_RX_TIMEOUT);
 
-    reset_fifo();
-
-    memset(rx_pipe_info, 0, sizeof(rx_pipe_info));
-    memset(pids, 0, sizeof(pids));
-
     // Disable the radio
     NRF_RADIO->SHORTS = RADIO_SHORTS_READY_START_Enabled << RADIO_SHORTS_READY_START_Pos |
                         RADIO_SHORTS_END_DISABLE_Enabled << RADIO_SHORTS_END_DISABLE_Pos;
 
     nvicDisableVector(RADIO_IRQn);
 
-    // Terminate interrupts handle thread
+    // Terminate interrupts handle thread, the FIFOs are reset once it is gone
     chThdTerminate(rfIntThread_p);
-    chBSemSignal(&disable_sem);
+    chBSemSignal(&rfp->disable_sem);
     chThdWait(rfIntThread_p);
 
+    reset_fifo(rfp);
+
+    memset(rfp->rx_pipe_info, 0, sizeof(rfp->rx_pipe_info));
+    memset(rfp->pids, 0, sizeof(rfp->pids));
+
     // Terminate events handle thread
     chThdTerminate(rfEvtThread_p);
-    RFD1.flags = 0;
-    chBSemSignal(&events_sem);
+    rfp->flags = 0;
+    chBSemSignal(&rfp->events_sem);
     chThdWait(rfEvtThread_p);
 
-    RFD1.state = NRF52_STATE_UNINIT;
+    rfp->state = NRF52_STATE_UNINIT;
 
     return NRF52_SUCCESS;
 }
 
 //
-nrf52_error_t radio_init(nrf52_config_t const *config) {
+nrf52_error_t radio_init(RFDriver *rfp, nrf52_config_t const *config) {
 	osalDbgAssert(config != NULL,
 		"config must be defined");
 	osalDbgAssert(&config->address != NULL,
@@ -819,147 +825,352 @@ nrf52_error_t radio_init(nrf52_config_t const *config) {
 	osalDbgAssert(NRF52_RADIO_IRQ_PRIORITY <= 7,
 		"wrong radio irq priority");
 
-    if (RFD1.state != NRF52_STATE_UNINIT) {
-    	nrf52_error_t err = radio_disable();
+    if (rfp->state != NRF52_STATE_UNINIT) {
+    	nrf52_error_t err = radio_disable(rfp);
         if (err != NRF52_SUCCESS)
             return err;
     }
 
-    RFD1.radio = NRF_RADIO;
-	RFD1.config = *config;
-    RFD1.flags    = 0;
+    rfp->radio = NRF_RADIO;
+	rfp->config = *config;
+    rfp->flags    = 0;
+    rfp->requests = 0;
 
-    init_fifo();
+    reset_fifo(rfp);
+    rfp->tx_payload = NULL;
+    rfp->rx_payload = &rfp->rx_overflow;
 
 #if NRF52_RADIO_USE_TIMER0
-    RFD1.timer = NRF_TIMER0;
+    rfp->timer = NRF_TIMER0;
 #endif
 #if NRF52_RADIO_USE_TIMER1
-    RFD1.timer = NRF_TIMER1;
+    rfp->timer = NRF_TIMER1;
 #endif
 #if NRF52_RADIO_USE_TIMER2
-    RFD1.timer = NRF_TIMER2;
+    rfp->timer = NRF_TIMER2;
 #endif
 #if NRF52_RADIO_USE_TIMER3
-    RFD1.timer = NRF_TIMER3;
+    rfp->timer = NRF_TIMER3;
 #endif
 #if NRF52_RADIO_USE_TIMER4
-    RFD1.timer = NRF_TIMER4;
+    rfp->timer = NRF_TIMER4;
 #endif
 
-    set_parameters(&RFD1);
+    set_parameters(rfp);
 
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_BASE0);
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_BASE1);
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_PREFIX);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_BASE0);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_BASE1);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_PREFIX);
 
-    ppi_init(&RFD1);
-    timer_init(&RFD1);
+    ppi_init(rfp);
+    timer_init(rfp);
 
-    chBSemObjectInit(&disable_sem, TRUE);
-    chBSemObjectInit(&events_sem, TRUE);
+    chBSemObjectInit(&rfp->disable_sem, TRUE);
+    chBSemObjectInit(&rfp->events_sem, TRUE);
 
-    chEvtObjectInit(&RFD1.eventsrc);
+    chEvtObjectInit(&rfp->eventsrc);
 
     // interrupt handle thread
     rfIntThread_p = chThdCreateStatic(waRFIntThread, sizeof(waRFIntThread),
-    		NRF52_RADIO_INTTHD_PRIORITY, rfIntThread, NULL);
+    		NRF52_RADIO_INTTHD_PRIORITY, rfIntThread, rfp);
 
     // events handle thread
     rfEvtThread_p = chThdCreateStatic(waRFEvtThread, sizeof(waRFEvtThread),
-    		NRF52_RADIO_EVTTHD_PRIORITY, rfEvtThread, NULL);
+    		NRF52_RADIO_EVTTHD_PRIORITY, rfEvtThread, rfp);
 
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
-    RFD1.state = NRF52_STATE_IDLE;
+    rfp->state = NRF52_STATE_IDLE;
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_write_payload(nrf52_payload_t const * p_payload) {
-    if (RFD1.state == NRF52_STATE_UNINIT)
-    	return NRF52_INVALID_STATE;
-    if(p_payload == NULL)
-    	return NRF52_ERROR_NULL;
-    VERIFY_PAYLOAD_LENGTH(p_payload);
-    if (tx_fifo.count >= NRF52_TX_FIFO_SIZE)
-    	return NRF52_ERROR_INVALID_LENGTH;
+static nrf52_error_t verify_payload(RFDriver *rfp, nrf52_payload_t const * p_payload) {
+    if (p_payload->length == 0 ||
+        p_payload->length > NRF52_MAX_PAYLOAD_LENGTH ||
+        (rfp->config.protocol == NRF52_PROTOCOL_ESB &&
+         p_payload->length > rfp->config.payload_length))
+    {
+        return NRF52_ERROR_INVALID_LENGTH;
+    }
+    if (p_payload->pipe >= NRF52_PIPE_COUNT)
+        return NRF52_ERROR_INVALID_PARAM;
 
-    if (RFD1.config.mode == NRF52_MODE_PTX &&
-        p_payload->noack && !RFD1.config.selective_auto_ack )
+    if (rfp->config.mode == NRF52_MODE_PTX &&
+        p_payload->noack && !rfp->config.selective_auto_ack )
     {
         return NRF52_ERROR_NOT_SUPPORTED;
     }
 
-    nvicDisableVector(RADIO_IRQn);
+    return NRF52_SUCCESS;
+}
 
-    memcpy(tx_fifo.p_payload[tx_fifo.entry_point], p_payload, sizeof(nrf52_payload_t));
+/*
+ * TX FIFO producer side, application thread. The free slots are found with
+ * the real consumer index, a flushed payload may still be in the air.
+ */
+
+// Wakes the interrupts handle thread up with a request
+static void post_request(RFDriver *rfp, uint32_t requests) {
+    chSysLock();
+    rfp->requests |= requests;
+    chBSemSignalI(&rfp->disable_sem);
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+// Payloads queued and not dropped, read only
+static bool tx_fifo_pending(RFDriver *rfp) {
+    uint32_t rd = rfp->tx_fifo.rd;
+    uint32_t flush = rfp->tx_fifo.flush;
+
+    if ((int32_t)(flush - rd) > 0)
+        rd = flush;
+    return rfp->tx_fifo.wr != rd;
+}
 
-    pids[p_payload->pipe] = (pids[p_payload->pipe] + 1) % (NRF52_PID_MAX + 1);
-    tx_fifo.p_payload[tx_fifo.entry_point]->pid = pids[p_payload->pipe];
+static nrf52_payload_t *tx_fifo_alloc(RFDriver *rfp, uint32_t offset) {
+    uint32_t wr = rfp->tx_fifo.wr + offset;
 
-    if (++tx_fifo.entry_point >= NRF52_TX_FIFO_SIZE) {
-        tx_fifo.entry_point = 0;
+    if (wr - rfp->tx_fifo.rd >= NRF52_TX_FIFO_SIZE) {
+        return NULL;
     }
+    return TX_FIFO_SLOT(rfp, wr);
+}
 
-    tx_fifo.count++;
+static void tx_fifo_commit(RFDriver *rfp, uint32_t count) {
+    uint32_t i;
 
-    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+    // PIDs are assigned in FIFO order
+    for (i = 0; i < count; i++) {
+        nrf52_payload_t *p = TX_FIFO_SLOT(rfp, rfp->tx_fifo.wr + i);
+
+        rfp->pids[p->pipe] = (rfp->pids[p->pipe] + 1) % (NRF52_PID_MAX + 1);
+        p->pid = rfp->pids[p->pipe];
+    }
+
+    __DMB();
+    rfp->tx_fifo.wr += count;
 
-    if (RFD1.config.mode == NRF52_MODE_PTX &&
-        RFD1.config.tx_mode == NRF52_TXMODE_AUTO &&
-        RFD1.state == NRF52_STATE_IDLE)
+    // The radio thread checks itself that it is idle, it may be going idle
+    // right now without having seen the new payloads
+    if (rfp->config.mode == NRF52_MODE_PTX &&
+        rfp->config.tx_mode == NRF52_TXMODE_AUTO)
     {
-        start_tx_transaction(&RFD1);
+        post_request(rfp, NRF52_REQ_START_TX);
     }
+}
+
+nrf52_error_t radio_write_payload(RFDriver *rfp, nrf52_payload_t const * p_payload) {
+    nrf52_payload_t *p;
+    nrf52_error_t err;
+
+    if (rfp->state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+    if(p_payload == NULL)
+    	return NRF52_ERROR_NULL;
+    err = verify_payload(rfp, p_payload);
+    if (err != NRF52_SUCCESS)
+        return err;
+
+    p = tx_fifo_alloc(rfp, 0);
+    if (p == NULL)
+    	return NRF52_ERROR_INVALID_LENGTH;
+
+    p->length = p_payload->length;
+    p->pipe   = p_payload->pipe;
+    p->noack  = p_payload->noack;
+    memcpy(p->data, p_payload->data, p_payload->length);
+
+    tx_fifo_commit(rfp, 1);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_read_rx_payload(nrf52_payload_t * p_payload) {
-    if (RFD1.state == NRF52_STATE_UNINIT)
+/**
+ * @brief   Queues several payloads for transmission.
+ * @details The payloads are copied to the TX FIFO and published at once, so
+ *          that the radio sees them as one burst. Stops at the first invalid
+ *          payload or when the TX FIFO is full.
+ *
+ * @return  Number of payloads queued.
+ */
+size_t radio_write_payloads(RFDriver *rfp, nrf52_payload_t const * p_payloads, size_t count) {
+    size_t n;
+
+    if (rfp->state == NRF52_STATE_UNINIT || p_payloads == NULL)
+    	return 0;
+
+    for (n = 0; n < count; n++) {
+        nrf52_payload_t const *src = &p_payloads[n];
+        nrf52_payload_t *p = tx_fifo_alloc(rfp, n);
+
+        if (p == NULL || verify_payload(rfp, src) != NRF52_SUCCESS)
+            break;
+
+        p->length = src->length;
+        p->pipe   = src->pipe;
+        p->noack  = src->noack;
+        memcpy(p->data, src->data, src->length);
+    }
+
+    if (n > 0)
+        tx_fifo_commit(rfp, n);
+
+    return n;
+}
+
+/**
+ * @brief   Gets the next free TX FIFO slot, to be filled in place.
+ * @details Fill @p length, @p pipe, @p noack and @p data, then call
+ *          radio_commit_tx_payload(). The radio transmits from the slot
+ *          itself, nothing is copied.
+ */
+nrf52_error_t radio_alloc_tx_payload(RFDriver *rfp, nrf52_payload_t ** pp_payload) {
+    if (rfp->state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+    if (pp_payload == NULL)
+    	return NRF52_ERROR_NULL;
+
+    *pp_payload = tx_fifo_alloc(rfp, 0);
+    if (*pp_payload == NULL)
+    	return NRF52_ERROR_INVALID_LENGTH;
+
+    return NRF52_SUCCESS;
+}
+
+/**
+ * @brief   Queues the slot returned by radio_alloc_tx_payload().
+ */
+nrf52_error_t radio_commit_tx_payload(RFDriver *rfp) {
+    nrf52_payload_t *p;
+    nrf52_error_t err;
+
+    if (rfp->state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+
+    p = tx_fifo_alloc(rfp, 0);
+    if (p == NULL)
+    	return NRF52_ERROR_INVALID_LENGTH;
+    err = verify_payload(rfp, p);
+    if (err != NRF52_SUCCESS)
+        return err;
+
+    tx_fifo_commit(rfp, 1);
+
+    return NRF52_SUCCESS;
+}
+
+/*
+ * RX FIFO consumer side, application thread.
+ */
+
+static void rx_fifo_copy(nrf52_payload_t * p_payload, nrf52_payload_t const * p) {
+    p_payload->length = p->length;
+    p_payload->pipe   = p->pipe;
+    p_payload->rssi   = p->rssi;
+    p_payload->pid    = p->pid;
+    memcpy(p_payload->data, p->data, p->length);
+}
+
+nrf52_error_t radio_read_rx_payload(RFDriver *rfp, nrf52_payload_t * p_payload) {
+    if (rfp->state == NRF52_STATE_UNINIT)
     	return NRF52_INVALID_STATE;
     if (p_payload == NULL)
     	return NRF52_ERROR_NULL;
 
-    if (rx_fifo.count == 0) {
+    if (rfp->rx_fifo.wr == rfp->rx_fifo.rd) {
         return NRF52_ERROR_INVALID_LENGTH;
     }
 
-    nvicDisableVector(RADIO_IRQn);
+    __DMB();
+    rx_fifo_copy(p_payload, RX_FIFO_SLOT(rfp, rfp->rx_fifo.rd));
+    __DMB();
+    rfp->rx_fifo.rd++;
+
+    return NRF52_SUCCESS;
+}
+
+/**
+ * @brief   Reads several received payloads.
+ * @details The slots are released at once after the copy.
+ *
+ * @return  Number of payloads read.
+ */
+size_t radio_read_rx_payloads(RFDriver *rfp, nrf52_payload_t * p_payloads, size_t count) {
+    uint32_t rd;
+    size_t n;
 
-    p_payload->length = rx_fifo.p_payload[rx_fifo.exit_point]->length;
-    p_payload->pipe   = rx_fifo.p_payload[rx_fifo.exit_point]->pipe;
-    p_payload->rssi   = rx_fifo.p_payload[rx_fifo.exit_point]->rssi;
-    p_payload->pid    = rx_fifo.p_payload[rx_fifo.exit_point]->pid;
-    memcpy(p_payload->data, rx_fifo.p_payload[rx_fifo.exit_point]->data, p_payload->length);
+    if (rfp->state == NRF52_STATE_UNINIT || p_payloads == NULL)
+    	return 0;
 
-    if (++rx_fifo.exit_point >= NRF52_RX_FIFO_SIZE) {
-        rx_fifo.exit_point = 0;
+    rd = rfp->rx_fifo.rd;
+    n = rfp->rx_fifo.wr - rd;
+    if (n > count)
+        n = count;
+
+    __DMB();
+    for (count = 0; count < n; count++) {
+        rx_fifo_copy(&p_payloads[count], RX_FIFO_SLOT(rfp, rd + count));
     }
+    __DMB();
+    rfp->rx_fifo.rd = rd + n;
 
-    rx_fifo.count--;
+    return n;
+}
 
-    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+/**
+ * @brief   Gets the oldest received payload, without copying it.
+ * @details The slot stays valid until radio_release_rx_payload().
+ */
+nrf52_error_t radio_fetch_rx_payload(RFDriver *rfp, nrf52_payload_t ** pp_payload) {
+    if (rfp->state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+    if (pp_payload == NULL)
+    	return NRF52_ERROR_NULL;
+
+    if (rfp->rx_fifo.wr == rfp->rx_fifo.rd) {
+        return NRF52_ERROR_INVALID_LENGTH;
+    }
+
+    __DMB();
+    *pp_payload = RX_FIFO_SLOT(rfp, rfp->rx_fifo.rd);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_start_tx(void) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+/**
+ * @brief   Gives the slot returned by radio_fetch_rx_payload() back to the radio.
+ */
+nrf52_error_t radio_release_rx_payload(RFDriver *rfp) {
+    if (rfp->state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+
+    if (rfp->rx_fifo.wr == rfp->rx_fifo.rd) {
+        return NRF52_ERROR_INVALID_LENGTH;
+    }
+
+    __DMB();
+    rfp->rx_fifo.rd++;
+
+    return NRF52_SUCCESS;
+}
+
+nrf52_error_t radio_start_tx(RFDriver *rfp) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
 
-    if (tx_fifo.count == 0) {
+    if (!tx_fifo_pending(rfp)) {
         return NRF52_ERROR_INVALID_LENGTH;
     }
 
-    start_tx_transaction(&RFD1);
+    post_request(rfp, NRF52_REQ_START_TX);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_start_rx(void) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+nrf52_error_t radio_start_rx(RFDriver *rfp) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
 
     NRF_RADIO->INTENCLR = 0xFFFFFFFF;
@@ -968,11 +1179,11 @@ nrf52_error_t radio_start_rx(void) {
 
     NRF_RADIO->SHORTS      = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_TXEN_Msk;
     NRF_RADIO->INTENSET    = RADIO_INTENSET_DISABLED_Msk;
-    RFD1.state             = NRF52_STATE_PRX;
+    rfp->state             = NRF52_STATE_PRX;
 
-    NRF_RADIO->RXADDRESSES  = RFD1.config.address.rx_pipes;
-    NRF_RADIO->FREQUENCY    = RFD1.config.address.rf_channel;
-    NRF_RADIO->PACKETPTR    = (uint32_t)rx_payload_buffer;
+    NRF_RADIO->RXADDRESSES  = rfp->config.address.rx_pipes;
+    NRF_RADIO->FREQUENCY    = rfp->config.address.rf_channel;
+    NRF_RADIO->PACKETPTR    = rx_fifo_packetptr(rfp);
 
     nvicClearPending(RADIO_IRQn);
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
@@ -989,8 +1200,8 @@ nrf52_error_t radio_start_rx(void) {
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_stop_rx(void) {
-    if (RFD1.state != NRF52_STATE_PRX) {
+nrf52_error_t radio_stop_rx(RFDriver *rfp) {
+    if (rfp->state != NRF52_STATE_PRX) {
         return NRF52_INVALID_STATE;
     }
 
@@ -1000,112 +1211,103 @@ nrf52_error_t radio_stop_rx(void) {
     (void) NRF_RADIO->EVENTS_DISABLED;
     NRF_RADIO->TASKS_DISABLE = 1;
     while (NRF_RADIO->EVENTS_DISABLED == 0);
-    RFD1.state = NRF52_STATE_IDLE;
+    rfp->state = NRF52_STATE_IDLE;
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_flush_tx(void) {
-    if (RFD1.state == NRF52_STATE_UNINIT)
+nrf52_error_t radio_flush_tx(RFDriver *rfp) {
+    if (rfp->state == NRF52_STATE_UNINIT)
     	return NRF52_INVALID_STATE;
 
-    nvicDisableVector(RADIO_IRQn);
-
-    tx_fifo.count = 0;
-    tx_fifo.entry_point = 0;
-    tx_fifo.exit_point = 0;
-
-    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+    // The radio skips the queued payloads the next time it looks at the FIFO
+    rfp->tx_fifo.flush = rfp->tx_fifo.wr;
+    post_request(rfp, NRF52_REQ_FLUSH_TX);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_pop_tx(void) {
-    if (RFD1.state == NRF52_STATE_UNINIT)
+nrf52_error_t radio_pop_tx(RFDriver *rfp) {
+    uint32_t flush;
+
+    if (rfp->state == NRF52_STATE_UNINIT)
     	return NRF52_INVALID_STATE;
-    if (tx_fifo.count == 0)
-    	return NRF52_ERROR_INVALID_LENGTH;
 
-    nvicDisableVector(RADIO_IRQn);
+    // Drops the oldest payload not yet dropped
+    flush = rfp->tx_fifo.flush;
+    if ((int32_t)(rfp->tx_fifo.rd - flush) > 0)
+        flush = rfp->tx_fifo.rd;
+    if (flush == rfp->tx_fifo.wr)
+    	return NRF52_ERROR_INVALID_LENGTH;
 
-    if (++tx_fifo.entry_point >= NRF52_TX_FIFO_SIZE) {
-        tx_fifo.entry_point = 0;
-    }
-    tx_fifo.count--;
-
-    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+    rfp->tx_fifo.flush = flush + 1;
+    post_request(rfp, NRF52_REQ_FLUSH_TX);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_flush_rx(void) {
-    if (RFD1.state == NRF52_STATE_UNINIT)
+nrf52_error_t radio_flush_rx(RFDriver *rfp) {
+    if (rfp->state == NRF52_STATE_UNINIT)
     	return NRF52_INVALID_STATE;
 
-    nvicDisableVector(RADIO_IRQn);
-
-    rx_fifo.count = 0;
-    rx_fifo.entry_point = 0;
-    rx_fifo.exit_point = 0;
+    rfp->rx_fifo.rd = rfp->rx_fifo.wr;
 
-    memset(rx_pipe_info, 0, sizeof(rx_pipe_info));
-
-    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+    memset(rfp->rx_pipe_info, 0, sizeof(rfp->rx_pipe_info));
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_set_base_address_0(uint8_t const * p_addr) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+nrf52_error_t radio_set_base_address_0(RFDriver *rfp, uint8_t const * p_addr) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
     if (p_addr == NULL)
         return NRF52_ERROR_NULL;
 
-    memcpy(RFD1.config.address.base_addr_p0, p_addr, 4);
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_BASE0);
+    memcpy(rfp->config.address.base_addr_p0, p_addr, 4);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_BASE0);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_set_base_address_1(uint8_t const * p_addr) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+nrf52_error_t radio_set_base_address_1(RFDriver *rfp, uint8_t const * p_addr) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
     if (p_addr == NULL)
         return NRF52_ERROR_NULL;
 
-    memcpy(RFD1.config.address.base_addr_p1, p_addr, 4);
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_BASE1);
+    memcpy(rfp->config.address.base_addr_p1, p_addr, 4);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_BASE1);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_set_prefixes(uint8_t const * p_prefixes, uint8_t num_pipes) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+nrf52_error_t radio_set_prefixes(RFDriver *rfp, uint8_t const * p_prefixes, uint8_t num_pipes) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
     if (p_prefixes == NULL)
         return NRF52_ERROR_NULL;
     if (num_pipes > 8)
     	return NRF52_ERROR_INVALID_PARAM;
 
-    memcpy(RFD1.config.address.pipe_prefixes, p_prefixes, num_pipes);
-    RFD1.config.address.num_pipes = num_pipes;
-    RFD1.config.address.rx_pipes = BIT_MASK_UINT_8(num_pipes);
+    memcpy(rfp->config.address.pipe_prefixes, p_prefixes, num_pipes);
+    rfp->config.address.num_pipes = num_pipes;
+    rfp->config.address.rx_pipes = BIT_MASK_UINT_8(num_pipes);
 
-    set_addresses(&RFD1, NRF52_ADDR_UPDATE_MASK_PREFIX);
+    set_addresses(rfp, NRF52_ADDR_UPDATE_MASK_PREFIX);
 
     return NRF52_SUCCESS;
 }
 
-nrf52_error_t radio_set_prefix(uint8_t pipe, uint8_t prefix) {
-    if (RFD1.state != NRF52_STATE_IDLE)
+nrf52_error_t radio_set_prefix(RFDriver *rfp, uint8_t pipe, uint8_t prefix) {
+    if (rfp->state != NRF52_STATE_IDLE)
     	return NRF52_ERROR_BUSY;
     if (pipe > 8)
     	return NRF52_ERROR_INVALID_PARAM;
 
-    RFD1.config.address.pipe_prefixes[pipe] = prefix;
+    rfp->config.address.pipe_prefixes[pipe] = prefix;
 
-    NRF_RADIO->PREFIX0 = bytewise_bit_swap(&RFD1.config.address.pipe_prefixes[0]);
-    NRF_RADIO->PREFIX1 = bytewise_bit_swap(&RFD1.config.address.pipe_prefixes[4]);
+    NRF_RADIO->PREFIX0 = bytewise_bit_swap(&rfp->config.address.pipe_prefixes[0]);
+    NRF_RADIO->PREFIX1 = bytewise_bit_swap(&rfp->config.address.pipe_prefixes[4]);
 
     return NRF52_SUCCESS;
 }
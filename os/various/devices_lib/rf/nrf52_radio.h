@@ -26,8 +26,14 @@
 
 #define NRF52_CRC_RESET_VALUE             	0xFFFF              /**< CRC reset value*/
 
-#define NRF52_TX_FIFO_SIZE                  8                   /**< The size of the transmission first in first out buffer. */
-#define NRF52_RX_FIFO_SIZE                  8                   /**< The size of the reception first in first out buffer. */
+#define NRF52_PIPE_COUNT                    9                   /**< Number of pipes, including the PRX ack pipe. */
+
+#ifndef NRF52_TX_FIFO_SIZE
+#define NRF52_TX_FIFO_SIZE                  8                   /**< The size of the transmission first in first out buffer, power of two. */
+#endif
+#ifndef NRF52_RX_FIFO_SIZE
+#define NRF52_RX_FIFO_SIZE                  8                   /**< The size of the reception first in first out buffer, power of two. */
+#endif
 
 #define NRF52_RADIO_USE_TIMER0            	FALSE               /**< TIMER0 will be used by the module. */
 #define NRF52_RADIO_USE_TIMER1            	TRUE                /**< TIMER1 will be used by the module. */
@@ -162,6 +168,8 @@ typedef struct {
 /**@brief Enhanced ShockBurst payload.
  *
  * @note The payload is used both for transmission and receive with ack and payload.
+ * @note The FIFO payloads are the radio packet buffers: NRF_RADIO->PACKETPTR points
+ *       to @p header, so the on-air fields are followed by @p data in memory.
 */
 typedef struct
 {
@@ -170,9 +178,37 @@ typedef struct
     int8_t  rssi;                                /**< RSSI for received packet. */
     uint8_t noack;                               /**< Flag indicating that this packet will not be acknowledged. */
     uint8_t pid;                                 /**< PID assigned during communication. */
+    uint8_t header[2];                           /**< On-air S0/LENGTH and S1 fields, managed by the module. */
     uint8_t data[NRF52_MAX_PAYLOAD_LENGTH];      /**< The payload data. */
 } nrf52_payload_t;
 
+/**@brief Single producer, single consumer payload FIFO.
+ *
+ * @details The indexes are free running, the slot of an index is
+ *          <tt>index & (size - 1)</tt>. Only the producer writes @p wr and
+ *          only the consumer writes @p rd, so no lock is needed between
+ *          threads and the radio.
+ */
+typedef struct {
+    nrf52_payload_t       payload[NRF52_TX_FIFO_SIZE];    /**< Payload slots. */
+    volatile uint32_t     wr;                             /**< Producer index. */
+    volatile uint32_t     rd;                             /**< Consumer index. */
+    volatile uint32_t     flush;                          /**< Index the consumer must skip to, written by the producer. */
+} nrf52_tx_fifo_t;
+
+typedef struct {
+    nrf52_payload_t       payload[NRF52_RX_FIFO_SIZE];    /**< Payload slots. */
+    volatile uint32_t     wr;                             /**< Producer index. */
+    volatile uint32_t     rd;                             /**< Consumer index. */
+} nrf52_rx_fifo_t;
+
+/**@brief Pipe info: PID, CRC and ack payload of the last received packet. */
+typedef struct {
+    uint16_t              m_crc;
+    uint8_t               m_pid;
+    uint8_t               m_ack_payload;
+} nrf52_pipe_info_t;
+
 /**@brief Retransmit attempts delay and counter. */
 typedef struct {
     uint16_t              delay;                  /**< The delay between each retransmission of unacked packets. */
@@ -234,23 +270,77 @@ typedef struct {
    * @brief Radio events source.
    */
   event_source_t eventsrc;
+  /**
+   * @brief TX FIFO, filled by the application, emptied by the radio.
+   */
+  nrf52_tx_fifo_t         tx_fifo;
+  /**
+   * @brief RX FIFO, filled by the radio, emptied by the application.
+   */
+  nrf52_rx_fifo_t         rx_fifo;
+  /**
+   * @brief Payload being transmitted.
+   */
+  nrf52_payload_t         *tx_payload;
+  /**
+   * @brief Payload being received, an RX FIFO slot or @p rx_overflow.
+   */
+  nrf52_payload_t         *rx_payload;
+  /**
+   * @brief Packet buffer used when the RX FIFO is full.
+   */
+  nrf52_payload_t         rx_overflow;
+  /**
+   * @brief On-air header of the acks without payload.
+   */
+  uint8_t                 ack_header[2];
+  /**
+   * @brief Last PID per pipe.
+   */
+  uint8_t                 pids[NRF52_PIPE_COUNT];
+  /**
+   * @brief Last received packet per pipe.
+   */
+  nrf52_pipe_info_t       rx_pipe_info[NRF52_PIPE_COUNT];
+  /**
+   * @brief Wait for ack timeout, in microseconds.
+   */
+  uint16_t                wait_for_ack_timeout_us;
+  /**
+   * @brief Requests to the interrupts handle thread, @p NRF52_REQ_xxx.
+   */
+  volatile uint32_t       requests;
+  /**
+   * @brief Interrupts handle thread semaphore, signaled with a request.
+   */
+  binary_semaphore_t      disable_sem;
+  /**
+   * @brief Events semaphore.
+   */
+  binary_semaphore_t      events_sem;
 } RFDriver;
 
 extern RFDriver RFD1;
 
-nrf52_error_t radio_init(nrf52_config_t const *config);
-nrf52_error_t radio_disable(void);
-nrf52_error_t radio_write_payload(nrf52_payload_t const * p_payload);
-nrf52_error_t radio_read_rx_payload(nrf52_payload_t * p_payload);
-nrf52_error_t radio_start_tx(void);
-nrf52_error_t radio_start_rx(void);
-nrf52_error_t radio_stop_rx(void);
-nrf52_error_t radio_flush_tx(void);
-nrf52_error_t radio_flush_rx(void);
-nrf52_error_t radio_pop_tx(void);
-nrf52_error_t radio_set_base_address_0(uint8_t const * p_addr);
-nrf52_error_t radio_set_base_address_1(uint8_t const * p_addr);
-nrf52_error_t radio_set_prefixes(uint8_t const * p_prefixes, uint8_t num_pipes);
-nrf52_error_t radio_set_prefix(uint8_t pipe, uint8_t prefix);
+nrf52_error_t radio_init(RFDriver *rfp, nrf52_config_t const *config);
+nrf52_error_t radio_disable(RFDriver *rfp);
+nrf52_error_t radio_write_payload(RFDriver *rfp, nrf52_payload_t const * p_payload);
+nrf52_error_t radio_read_rx_payload(RFDriver *rfp, nrf52_payload_t * p_payload);
+nrf52_error_t radio_start_tx(RFDriver *rfp);
+nrf52_error_t radio_start_rx(RFDriver *rfp);
+nrf52_error_t radio_stop_rx(RFDriver *rfp);
+nrf52_error_t radio_flush_tx(RFDriver *rfp);
+nrf52_error_t radio_flush_rx(RFDriver *rfp);
+nrf52_error_t radio_pop_tx(RFDriver *rfp);
+size_t radio_write_payloads(RFDriver *rfp, nrf52_payload_t const * p_payloads, size_t count);
+size_t radio_read_rx_payloads(RFDriver *rfp, nrf52_payload_t * p_payloads, size_t count);
+nrf52_error_t radio_alloc_tx_payload(RFDriver *rfp, nrf52_payload_t ** pp_payload);
+nrf52_error_t radio_commit_tx_payload(RFDriver *rfp);
+nrf52_error_t radio_fetch_rx_payload(RFDriver *rfp, nrf52_payload_t ** pp_payload);
+nrf52_error_t radio_release_rx_payload(RFDriver *rfp);
+nrf52_error_t radio_set_base_address_0(RFDriver *rfp, uint8_t const * p_addr);
+nrf52_error_t radio_set_base_address_1(RFDriver *rfp, uint8_t const * p_addr);
+nrf52_error_t radio_set_prefixes(RFDriver *rfp, uint8_t const * p_prefixes, uint8_t num_pipes);
+nrf52_error_t radio_set_prefix(RFDriver *rfp, uint8_t pipe, uint8_t prefix);
 
 #endif /* NRF52_RADIO_H_ */
@@ -261,5 +261,29 @@ HDC1000_readTemperatureHumidity(HDC1000_drv *drv,
     return _decode_measure(drv, val, temperature, humidity);
 }
 
+/* Generic measure interface, see sensor_ops_t. */
+
+static msg_t
+_ops_startMeasure(void *drv) {
+    return HDC1000_startMeasure(drv);
+}
+
+static unsigned int
+_ops_getAcquisitionTime(void *drv) {
+    return HDC1000_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_readMeasure(void *drv, float *value) {
+    return HDC1000_readMeasure(drv, &value[0], &value[1]);
+}
+
+const sensor_ops_t HDC1000_ops = {
+    _ops_startMeasure,
+    _ops_getAcquisitionTime,
+    _ops_readMeasure,
+    2
+};
+
 
 /** @} */
@@ -233,6 +233,13 @@ HDC1000_getTemperature(HDC1000_drv *drv) {
 }
 
 
+/**
+ * @brief   Generic measure interface of the driver.
+ *
+ * @details Measures are returned as temperature (°C) and humidity (%).
+ */
+extern const sensor_ops_t HDC1000_ops;
+
 #endif
 
 /**
@@ -205,3 +205,27 @@ MCP9808_readTemperature(MCP9808_drv *drv,
 
     return _decode_measure(drv, val, temperature);    
 }
+
+/* Generic measure interface, see sensor_ops_t. */
+
+static msg_t
+_ops_startMeasure(void *drv) {
+    return MCP9808_startMeasure(drv);
+}
+
+static unsigned int
+_ops_getAcquisitionTime(void *drv) {
+    return MCP9808_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_readMeasure(void *drv, float *value) {
+    return MCP9808_readMeasure(drv, &value[0]);
+}
+
+const sensor_ops_t MCP9808_ops = {
+    _ops_startMeasure,
+    _ops_getAcquisitionTime,
+    _ops_readMeasure,
+    1
+};
@@ -200,5 +200,12 @@ MCP9808_getTemperature(MCP9808_drv *drv) {
     return temperature;
 }
 
+/**
+ * @brief   Generic measure interface of the driver.
+ *
+ * @details Measures are returned as temperature (°C).
+ */
+extern const sensor_ops_t MCP9808_ops;
+
 #endif
 
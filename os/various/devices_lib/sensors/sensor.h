@@ -76,6 +76,29 @@ typedef enum __attribute__ ((__packed__)) {
     SENSOR_ERROR     = 6,            /**< Error.                          */
 } sensor_state_t;
 
+/**
+ * @brief   Maximum number of values returned by a measure.
+ */
+#define SENSOR_MAX_VALUES  2
+
+/**
+ * @brief   Generic measure interface.
+ *
+ * @details Same startMeasure()/getAcquisitionTime()/readMeasure() pattern
+ *          as above, with the driver as an opaque pointer, so that
+ *          several sensors can be driven together (see sensor_sched.h).
+ */
+typedef struct {
+    /** @brief Trigger a measure acquisition. */
+    msg_t        (*startMeasure)(void *drv);
+    /** @brief Time in milli-seconds necessary for acquiring a measure. */
+    unsigned int (*getAcquisitionTime)(void *drv);
+    /** @brief Read the measure, @p values items in @p value. */
+    msg_t        (*readMeasure)(void *drv, float *value);
+    /** @brief Number of values of a measure, @p SENSOR_MAX_VALUES max. */
+    unsigned int values;
+} sensor_ops_t;
+
 #endif
 
 
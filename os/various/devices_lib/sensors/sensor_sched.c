@@ -0,0 +1,170 @@
+/*
+    Copyright (C) 2016 Stephane D'Alu
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensor_sched.c
+ * @brief   Acquisition scheduler for sensors sharing a bus.
+ *
+ * @{
+ */
+
+#include <string.h>
+
+#include "sensor_sched.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static inline void
+_bus_acquire(SENSOR_SCHED_entry *entry) {
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    if (entry->i2c)
+	i2cAcquireBus(entry->i2c);
+#else
+    (void)entry;
+#endif
+}
+
+static inline void
+_bus_release(SENSOR_SCHED_entry *entry) {
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    if (entry->i2c)
+	i2cReleaseBus(entry->i2c);
+#else
+    (void)entry;
+#endif
+}
+
+static void
+_post(SENSOR_SCHED_drv *sched, SENSOR_SCHED_entry *entry,
+	msg_t status, const float *value) {
+    sensor_sample_t *sample = chFifoTakeObjectTimeout(sched->fifo,
+						      TIME_IMMEDIATE);
+    if (sample == NULL) {
+	sched->lost++;
+	return;
+    }
+
+    sample->id     = entry->id;
+    sample->status = status;
+    sample->time   = chVTGetSystemTimeX();
+    memset(sample->value, 0, sizeof(sample->value));
+    if (value)
+	memcpy(sample->value, value, entry->ops->values * sizeof(float));
+    chFifoSendObject(sched->fifo, sample);
+}
+
+/**
+ * @brief   Pending entry with the earliest deadline.
+ */
+static SENSOR_SCHED_entry *
+_earliest(SENSOR_SCHED_drv *sched) {
+    SENSOR_SCHED_entry *best = NULL;
+
+    for (unsigned int i = 0 ; i < sched->count ; i++) {
+	SENSOR_SCHED_entry *entry = &sched->entries[i];
+	if (entry->pending && ((best == NULL) || (entry->due < best->due)))
+	    best = entry;
+    }
+    return best;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+void
+SENSOR_SCHED_init(SENSOR_SCHED_drv *sched,
+	SENSOR_SCHED_entry *entries, unsigned int count,
+	objects_fifo_t *fifo) {
+    osalDbgCheck((sched != NULL) && (entries != NULL) && (fifo != NULL));
+
+    sched->entries  = entries;
+    sched->count    = count;
+    sched->fifo     = fifo;
+    sched->cycles   = 0;
+    sched->lost     = 0;
+    sched->duration = 0;
+
+    for (unsigned int i = 0 ; i < count ; i++) {
+	osalDbgCheck(entries[i].ops->values <= SENSOR_MAX_VALUES);
+	entries[i].pending = false;
+    }
+}
+
+msg_t
+SENSOR_SCHED_cycle(SENSOR_SCHED_drv *sched) {
+    systime_t           start  = chVTGetSystemTimeX();
+    msg_t               result = MSG_OK;
+    SENSOR_SCHED_entry *entry;
+    msg_t               msg;
+
+    /* Start all the measures, back to back */
+    for (unsigned int i = 0 ; i < sched->count ; i++) {
+	entry = &sched->entries[i];
+
+	_bus_acquire(entry);
+	msg = entry->ops->startMeasure(entry->drv);
+	_bus_release(entry);
+
+	if (msg < MSG_OK) {
+	    _post(sched, entry, msg, NULL);
+	    result = msg;
+	    continue;
+	}
+	entry->due = chTimeDiffX(start, chVTGetSystemTimeX()) +
+	    TIME_MS2I(entry->ops->getAcquisitionTime(entry->drv));
+	entry->pending = true;
+    }
+
+    /* Read them in deadline order */
+    while ((entry = _earliest(sched)) != NULL) {
+	float         value[SENSOR_MAX_VALUES];
+	sysinterval_t elapsed = chTimeDiffX(start, chVTGetSystemTimeX());
+
+	if (entry->due > elapsed)
+	    chThdSleep(entry->due - elapsed);
+
+	_bus_acquire(entry);
+	msg = entry->ops->readMeasure(entry->drv, value);
+	_bus_release(entry);
+
+	entry->pending = false;
+	if (msg < MSG_OK)
+	    result = msg;
+	_post(sched, entry, msg, (msg < MSG_OK) ? NULL : value);
+    }
+
+    sched->duration = chTimeDiffX(start, chVTGetSystemTimeX());
+    sched->cycles++;
+    return result;
+}
+
+
+/** @} */
@@ -0,0 +1,150 @@
+/*
+    Copyright (C) 2016 Stephane D'Alu
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensor_sched.h
+ * @brief   Acquisition scheduler for sensors sharing a bus.
+ *
+ * A cycle starts the measures of all the sensors back to back, then
+ * reads them in acquisition deadline order, so that the cycle lasts
+ * about the longest acquisition time instead of the sum of all of them.
+ * The bus is acquired around each transfer only, other threads can use
+ * it while the sensors are acquiring.
+ *
+ * Measures are delivered through a single objects FIFO of
+ * #sensor_sample_t, including the failed ones.
+ *
+ * @code
+ * static sensor_sample_t samples[8];
+ * static msg_t           samples_msgs[8];
+ * static objects_fifo_t  samples_fifo;
+ * static SENSOR_SCHED_entry entries[] = {
+ *   { &HDC1000_ops, &hdc1000, &I2CD1, 0 },
+ *   { &TSL2591_ops, &tsl2591, &I2CD1, 1 },
+ * };
+ * static SENSOR_SCHED_drv sched;
+ *
+ * chFifoObjectInit(&samples_fifo, sizeof(sensor_sample_t), 8, 0,
+ *                  samples, samples_msgs);
+ * SENSOR_SCHED_init(&sched, entries, 2, &samples_fifo);
+ * while(true) {
+ *   SENSOR_SCHED_cycle(&sched);
+ * }
+ * @endcode
+ *
+ * @{
+ */
+
+#ifndef _SENSOR_SCHED_H_
+#define _SENSOR_SCHED_H_
+
+#include "ch.h"
+#include "hal.h"
+#include "sensor.h"
+
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_OBJ_FIFOS != TRUE
+#error "sensor_sched requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Scheduled sensor.
+ */
+typedef struct {
+    const sensor_ops_t *ops;     /**< @brief Sensor driver interface.     */
+    void               *drv;     /**< @brief Sensor driver.               */
+    I2CDriver          *i2c;     /**< @brief Bus to acquire, or NULL.     */
+    unsigned int        id;      /**< @brief Identifier of the samples.   */
+    /* End of the configuration fields. */
+    sysinterval_t       due;     /**< @brief Deadline, from cycle start.  */
+    bool                pending; /**< @brief Measure to be read.          */
+} SENSOR_SCHED_entry;
+
+/**
+ * @brief   Measure of a sensor.
+ */
+typedef struct {
+    unsigned int id;                       /**< @brief Sensor identifier. */
+    msg_t        status;                   /**< @brief Measure status.    */
+    systime_t    time;                     /**< @brief Time of the read.  */
+    float        value[SENSOR_MAX_VALUES]; /**< @brief Measured values.   */
+} sensor_sample_t;
+
+/**
+ * @brief   Acquisition scheduler.
+ */
+typedef struct {
+    SENSOR_SCHED_entry *entries;
+    unsigned int        count;
+    objects_fifo_t     *fifo;
+    uint32_t            cycles;    /**< @brief Completed cycles.          */
+    uint32_t            lost;      /**< @brief Samples lost, FIFO full.   */
+    sysinterval_t       duration;  /**< @brief Duration of the last cycle.*/
+} SENSOR_SCHED_drv;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+/**
+ * @brief   Initialize the scheduler
+ *
+ * @note    The sensors must have been started.
+ */
+void
+SENSOR_SCHED_init(SENSOR_SCHED_drv *sched,
+	SENSOR_SCHED_entry *entries, unsigned int count,
+	objects_fifo_t *fifo);
+
+/**
+ * @brief   Acquire a measure from every sensor
+ *
+ * @details One sample is posted in the FIFO per sensor, if the FIFO is
+ *          full the sample is lost and counted.
+ *
+ * @returns
+ *   MSG_OK     all the measures succeeded
+ *   msg_t      error of the last failed measure
+ */
+msg_t
+SENSOR_SCHED_cycle(SENSOR_SCHED_drv *sched);
+
+#endif
+
+/**
+ * @}
+ */
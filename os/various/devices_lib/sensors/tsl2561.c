@@ -384,3 +384,32 @@ TSL2561_readIlluminance(TSL2561_drv *drv,
     return SENSOR_OK;
 }
 
+/* Generic measure interface, see sensor_ops_t. */
+
+static msg_t
+_ops_startMeasure(void *drv) {
+    return TSL2561_startMeasure(drv);
+}
+
+static unsigned int
+_ops_getAcquisitionTime(void *drv) {
+    return TSL2561_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_readMeasure(void *drv, float *value) {
+    unsigned int illuminance;
+    msg_t msg;
+
+    if ((msg = TSL2561_readIlluminance(drv, &illuminance)) < MSG_OK)
+	return msg;
+    value[0] = illuminance;
+    return MSG_OK;
+}
+
+const sensor_ops_t TSL2561_ops = {
+    _ops_startMeasure,
+    _ops_getAcquisitionTime,
+    _ops_readMeasure,
+    1
+};
@@ -237,5 +237,12 @@ TSL2561_getIlluminance(TSL2561_drv *drv) {
 }
 
 
+/**
+ * @brief   Generic measure interface of the driver.
+ *
+ * @details Measures are returned as illuminance (Lux).
+ */
+extern const sensor_ops_t TSL2561_ops;
+
 #endif
 
@@ -270,3 +270,32 @@ TSL2591_readIlluminance(TSL2591_drv *drv,
     return SENSOR_OK;
 }
 
+/* Generic measure interface, see sensor_ops_t. */
+
+static msg_t
+_ops_startMeasure(void *drv) {
+    return TSL2591_startMeasure(drv);
+}
+
+static unsigned int
+_ops_getAcquisitionTime(void *drv) {
+    return TSL2591_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_readMeasure(void *drv, float *value) {
+    unsigned int illuminance;
+    msg_t msg;
+
+    if ((msg = TSL2591_readIlluminance(drv, &illuminance)) < MSG_OK)
+	return msg;
+    value[0] = illuminance;
+    return MSG_OK;
+}
+
+const sensor_ops_t TSL2591_ops = {
+    _ops_startMeasure,
+    _ops_getAcquisitionTime,
+    _ops_readMeasure,
+    1
+};
@@ -234,5 +234,12 @@ TSL2591_getIlluminance(TSL2591_drv *drv) {
 }
 
 
+/**
+ * @brief   Generic measure interface of the driver.
+ *
+ * @details Measures are returned as illuminance (Lux).
+ */
+extern const sensor_ops_t TSL2591_ops;
+
 #endif
 
@@ -9,17 +9,12 @@
 #include "ffconf.h"
 #include "diskio.h"
 #include "usbh/dev/msd.h"
+#include "fatfs_diskio.h"
 
 #if HAL_USE_MMC_SPI && HAL_USE_SDC
 #error "cannot specify both MMC_SPI and SDC drivers"
 #endif
 
-// sanity check for no FAT option selected
-// why is the FAT sources being pulled into the build?
-#if !HAL_USE_MMC_SPI && !HAL_USE_SDC & !HAL_USBH_USE_MSD
-#error "MMC_SPI, SDC or USBH_MSD driver must be specified. None was."
-#endif
-
 #if !defined(FATFS_HAL_DEVICE)
 #if HAL_USE_MMC_SPI
 #define FATFS_HAL_DEVICE MMCD1
@@ -34,8 +29,6 @@ extern MMCDriver FATFS_HAL_DEVICE;
 #if HAL_USE_SDC
 extern SDCDriver FATFS_HAL_DEVICE;
 #endif
-#if HAL_USBH_USE_MSD
-#endif
 
 #if HAL_USE_RTC
 extern RTCDriver RTCD1;
@@ -43,62 +36,113 @@ extern RTCDriver RTCD1;
 
 /*-----------------------------------------------------------------------*/
 /* Correspondence between physical drive number and physical drive.      */
-#if HAL_USE_MMC_SPI
-#define MMC         0
-#endif
-
-#if HAL_USE_SDC
-#define SDC         0
-#endif
-
-#if HAL_USBH_USE_MSD
-#if defined(MMC) || defined(SDC)
+#if HAL_USE_MMC_SPI || HAL_USE_SDC
 #define MSDLUN0     1
 #else
 #define MSDLUN0     0
 #endif
-#endif
 
+/*-----------------------------------------------------------------------*/
+/* Registered volumes, NULL for the default ones.                        */
+static const fatfs_volume_t *volumes[FF_VOLUMES];
+
+/*-----------------------------------------------------------------------*/
+/* Default volumes discard calls.                                        */
+#if HAL_USE_MMC_SPI
+static bool mmc_trim(void *instance, uint32_t startblk, uint32_t endblk) {
+
+  return mmcErase((MMCDriver *)instance, startblk, endblk);
+}
+#elif HAL_USE_SDC
+static bool sdc_trim(void *instance, uint32_t startblk, uint32_t endblk) {
+
+  return sdcErase((SDCDriver *)instance, startblk, endblk);
+}
+#endif
 
 /*-----------------------------------------------------------------------*/
-/* Inidialize a Drive                                                    */
+/* Volume of a drive, registered or default.                             */
 
-DSTATUS disk_initialize (
-    BYTE pdrv         /* Physical drive number (0..) */
-)
+static bool get_volume(BYTE pdrv, fatfs_volume_t *vp)
 {
-  DSTATUS stat;
+  const fatfs_volume_t *rvp;
+
+  if (pdrv >= FF_VOLUMES)
+    return false;
+
+  rvp = volumes[pdrv];
+  if (rvp != NULL) {
+    *vp = *rvp;
+    return true;
+  }
 
-  switch (pdrv) {
 #if HAL_USE_MMC_SPI
-  case MMC:
-    stat = 0;
-    /* It is initialized externally, just reads the status.*/
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      stat |= STA_NOINIT;
-    if (mmcIsWriteProtected(&FATFS_HAL_DEVICE))
-      stat |=  STA_PROTECT;
-    return stat;
+  if (pdrv == 0) {
+    vp->blkdev       = (BaseBlockDevice *)&FATFS_HAL_DEVICE;
+    vp->trim         = mmc_trim;
+    vp->erase_blocks = 0;
+    return true;
+  }
 #elif HAL_USE_SDC
-  case SDC:
-    stat = 0;
-    /* It is initialized externally, just reads the status.*/
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      stat |= STA_NOINIT;
-    if (sdcIsWriteProtected(&FATFS_HAL_DEVICE))
-      stat |=  STA_PROTECT;
-    return stat;
+  if (pdrv == 0) {
+    vp->blkdev       = (BaseBlockDevice *)&FATFS_HAL_DEVICE;
+    vp->trim         = sdc_trim;
+    vp->erase_blocks = 256; /* 512b blocks in one erase block */
+    return true;
+  }
 #endif
 #if HAL_USBH_USE_MSD
-  case MSDLUN0:
-	stat = 0;
-	/* It is initialized externally, just reads the status.*/
-	if (blkGetDriverState(&MSBLKD[0]) != BLK_READY)
-	  stat |= STA_NOINIT;
-	return stat;
-#endif
+  if ((pdrv >= MSDLUN0) && (pdrv < MSDLUN0 + HAL_USBHMSD_MAX_LUNS)) {
+    vp->blkdev       = (BaseBlockDevice *)&MSBLKD[pdrv - MSDLUN0];
+    vp->trim         = NULL;
+    vp->erase_blocks = 0;
+    return true;
   }
-  return STA_NOINIT;
+#endif
+  return false;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Register a Volume                                                     */
+
+/**
+ * @brief   Registers the volume serving a FatFS physical drive.
+ * @note    The block device is initialized externally, it must be
+ *          connected before the drive is mounted.
+ *
+ * @param[in] pdrv      physical drive number
+ * @param[in] vp        pointer to the @p fatfs_volume_t object, @p NULL
+ *                      restores the default volume
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the volume has been registered.
+ * @retval HAL_FAILED   if the drive number is out of range.
+ *
+ * @api
+ */
+bool fatfsRegisterVolume(uint8_t pdrv, const fatfs_volume_t *vp)
+{
+  osalDbgCheck((vp == NULL) || (vp->blkdev != NULL));
+
+  if (pdrv >= FF_VOLUMES)
+    return HAL_FAILED;
+
+  osalSysLock();
+  volumes[pdrv] = vp;
+  osalSysUnlock();
+  return HAL_SUCCESS;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Inidialize a Drive                                                    */
+
+DSTATUS disk_initialize (
+    BYTE pdrv         /* Physical drive number (0..) */
+)
+{
+  /* It is initialized externally, just reads the status.*/
+  return disk_status(pdrv);
 }
 
 
@@ -110,38 +154,18 @@ DSTATUS disk_status (
     BYTE pdrv         /* Physical drive number (0..) */
 )
 {
+  fatfs_volume_t vol;
   DSTATUS stat;
 
-  switch (pdrv) {
-#if HAL_USE_MMC_SPI
-  case MMC:
-    stat = 0;
-    /* It is initialized externally, just reads the status.*/
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      stat |= STA_NOINIT;
-    if (mmcIsWriteProtected(&FATFS_HAL_DEVICE))
-      stat |= STA_PROTECT;
-    return stat;
-#elif HAL_USE_SDC
-  case SDC:
-    stat = 0;
-    /* It is initialized externally, just reads the status.*/
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      stat |= STA_NOINIT;
-    if (sdcIsWriteProtected(&FATFS_HAL_DEVICE))
-      stat |= STA_PROTECT;
-    return stat;
-#endif
-#if HAL_USBH_USE_MSD
-  case MSDLUN0:
-    stat = 0;
-    /* It is initialized externally, just reads the status.*/
-    if (blkGetDriverState(&MSBLKD[0]) != BLK_READY)
-      stat |= STA_NOINIT;
-    return stat;
-#endif
-  }
-  return STA_NOINIT;
+  if (!get_volume(pdrv, &vol))
+    return STA_NOINIT;
+
+  stat = 0;
+  if (blkGetDriverState(vol.blkdev) != BLK_READY)
+    stat |= STA_NOINIT;
+  if (blkIsWriteProtected(vol.blkdev))
+    stat |= STA_PROTECT;
+  return stat;
 }
 
 
@@ -156,41 +180,16 @@ DRESULT disk_read (
     UINT count        /* Number of sectors to read (1..255) */
 )
 {
-  switch (pdrv) {
-#if HAL_USE_MMC_SPI
-  case MMC:
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      return RES_NOTRDY;
-    if (mmcStartSequentialRead(&FATFS_HAL_DEVICE, sector))
-      return RES_ERROR;
-    while (count > 0) {
-      if (mmcSequentialRead(&FATFS_HAL_DEVICE, buff))
-        return RES_ERROR;
-      buff += MMCSD_BLOCK_SIZE;
-      count--;
-    }
-    if (mmcStopSequentialRead(&FATFS_HAL_DEVICE))
-        return RES_ERROR;
-    return RES_OK;
-#elif HAL_USE_SDC
-  case SDC:
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      return RES_NOTRDY;
-    if (sdcRead(&FATFS_HAL_DEVICE, sector, buff, count))
-      return RES_ERROR;
-    return RES_OK;
-#endif
-#if HAL_USBH_USE_MSD
-  case MSDLUN0:
-	/* It is initialized externally, just reads the status.*/
-	if (blkGetDriverState(&MSBLKD[0]) != BLK_READY)
-		return RES_NOTRDY;
-	if (usbhmsdLUNRead(&MSBLKD[0], sector, buff, count))
-		return RES_ERROR;
-	return RES_OK;
-#endif
-  }
-  return RES_PARERR;
+  fatfs_volume_t vol;
+
+  if (!get_volume(pdrv, &vol))
+    return RES_PARERR;
+  if (blkGetDriverState(vol.blkdev) != BLK_READY)
+    return RES_NOTRDY;
+  /* All the sectors in one call, the drivers do multiple block reads.*/
+  if (blkRead(vol.blkdev, sector, buff, count))
+    return RES_ERROR;
+  return RES_OK;
 }
 
 
@@ -206,57 +205,24 @@ DRESULT disk_write (
     UINT count        /* Number of sectors to write (1..255) */
 )
 {
-
-  switch (pdrv) {
-#if HAL_USE_MMC_SPI
-  case MMC:
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-        return RES_NOTRDY;
-    if (mmcIsWriteProtected(&FATFS_HAL_DEVICE))
-        return RES_WRPRT;
-    if (mmcStartSequentialWrite(&FATFS_HAL_DEVICE, sector))
-        return RES_ERROR;
-
-    while (count > 0) {
-      // invalidate cache on buffer
-      cacheBufferFlush(buff, MMCSD_BLOCK_SIZE);
-
-      if (mmcSequentialWrite(&FATFS_HAL_DEVICE, buff))
-          return RES_ERROR;
-      buff += MMCSD_BLOCK_SIZE;
-      count--;
-    }
-    if (mmcStopSequentialWrite(&FATFS_HAL_DEVICE))
-        return RES_ERROR;
-    return RES_OK;
-#elif HAL_USE_SDC
-  case SDC:
-    if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
-      return RES_NOTRDY;
-
-    // invalidate cache on buffer
-    cacheBufferFlush(buff, count * MMCSD_BLOCK_SIZE);
-
-    if (sdcWrite(&FATFS_HAL_DEVICE, sector, buff, count))
-      return RES_ERROR;
-
-    return RES_OK;
-#endif
-#if HAL_USBH_USE_MSD
-  case MSDLUN0:
-	/* It is initialized externally, just reads the status.*/
-	if (blkGetDriverState(&MSBLKD[0]) != BLK_READY)
-		return RES_NOTRDY;
+  fatfs_volume_t vol;
+  BlockDeviceInfo bdi;
+
+  if (!get_volume(pdrv, &vol))
+    return RES_PARERR;
+  if (blkGetDriverState(vol.blkdev) != BLK_READY)
+    return RES_NOTRDY;
+  if (blkIsWriteProtected(vol.blkdev))
+    return RES_WRPRT;
+  if (blkGetInfo(vol.blkdev, &bdi))
+    return RES_ERROR;
 
   // invalidate cache on buffer
-  cacheBufferFlush(buff, count * MSBLKD[0].info.blk_size);
+  cacheBufferFlush(buff, count * bdi.blk_size);
 
-	if (usbhmsdLUNWrite(&MSBLKD[0], sector, buff, count))
-		return RES_ERROR;
-	return RES_OK;
-#endif
-  }
-  return RES_PARERR;
+  if (blkWrite(vol.blkdev, sector, buff, count))
+    return RES_ERROR;
+  return RES_OK;
 }
 #endif /* _FS_READONLY */
 
@@ -271,77 +237,45 @@ DRESULT disk_ioctl (
     void *buff        /* Buffer to send/receive control data */
 )
 {
-  (void)buff;
+  fatfs_volume_t vol;
+  BlockDeviceInfo bdi;
 
-  switch (pdrv) {
-#if HAL_USE_MMC_SPI
-  case MMC:
-    switch (cmd) {
-    case CTRL_SYNC:
-        return RES_OK;
-#if FF_MAX_SS > FF_MIN_SS
-    case GET_SECTOR_SIZE:
-        *((WORD *)buff) = MMCSD_BLOCK_SIZE;
-        return RES_OK;
-#endif
-#if FF_USE_TRIM
-    case CTRL_TRIM:
-        mmcErase(&FATFS_HAL_DEVICE, *((DWORD *)buff), *((DWORD *)buff + 1));
-        return RES_OK;
-#endif
-    default:
-        return RES_PARERR;
-    }
-#elif HAL_USE_SDC
-  case SDC:
-    switch (cmd) {
-    case CTRL_SYNC:
-        return RES_OK;
-    case GET_SECTOR_COUNT:
-        *((DWORD *)buff) = mmcsdGetCardCapacity(&FATFS_HAL_DEVICE);
-        return RES_OK;
-#if FF_MAX_SS > FF_MIN_SS
-    case GET_SECTOR_SIZE:
-        *((WORD *)buff) = MMCSD_BLOCK_SIZE;
-        return RES_OK;
-#endif
-    case GET_BLOCK_SIZE:
-        *((DWORD *)buff) = 256; /* 512b blocks in one erase block */
-        return RES_OK;
-#if FF_USE_TRIM
-    case CTRL_TRIM:
-        sdcErase(&FATFS_HAL_DEVICE, *((DWORD *)buff), *((DWORD *)buff + 1));
-        return RES_OK;
-#endif
-    default:
-        return RES_PARERR;
-    }
-#endif
-#if HAL_USBH_USE_MSD
-    case MSDLUN0:
-      switch (cmd) {
-      case CTRL_SYNC:
-          return RES_OK;
-      case GET_SECTOR_COUNT:
-          *((DWORD *)buff) = MSBLKD[0].info.blk_num;
-          return RES_OK;
+  if (!get_volume(pdrv, &vol))
+    return RES_PARERR;
+
+  switch (cmd) {
+  case CTRL_SYNC:
+    if (blkSync(vol.blkdev))
+      return RES_ERROR;
+    return RES_OK;
+  case GET_SECTOR_COUNT:
+    if (blkGetInfo(vol.blkdev, &bdi))
+      return RES_ERROR;
+    *((DWORD *)buff) = bdi.blk_num;
+    return RES_OK;
 #if FF_MAX_SS > FF_MIN_SS
-      case GET_SECTOR_SIZE:
-          *((WORD *)buff) = MSBLKD[0].info.blk_size;
-          return RES_OK;
+  case GET_SECTOR_SIZE:
+    if (blkGetInfo(vol.blkdev, &bdi))
+      return RES_ERROR;
+    *((WORD *)buff) = bdi.blk_size;
+    return RES_OK;
 #endif
+  case GET_BLOCK_SIZE:
+    if (vol.erase_blocks == 0)
+      return RES_PARERR;
+    *((DWORD *)buff) = vol.erase_blocks;
+    return RES_OK;
 #if FF_USE_TRIM
-#error "unimplemented yet!"
-//    case CTRL_TRIM:
-//      ....
-//      return RES_OK;
-#endif
-      default:
-          return RES_PARERR;
-      }
+  case CTRL_TRIM:
+    if (vol.trim == NULL)
+      return RES_PARERR;
+    if (vol.trim(vol.blkdev, *((DWORD *)buff), *((DWORD *)buff + 1)))
+      return RES_ERROR;
+    return RES_OK;
 #endif
+  default:
+    return RES_PARERR;
   }
-  return RES_PARERR;
 }
 
 DWORD get_fattime(void) {
@@ -0,0 +1,108 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_diskio.h
+ * @brief   FatFS disk I/O bindings header.
+ * @details FatFS physical drives are served by @p BaseBlockDevice objects
+ *          registered at runtime, any block device can be mounted: MMC/SD
+ *          cards, USB host mass storage LUNs, RAM disks, flash translation
+ *          layers.
+ *
+ *          Drives with no registered volume fall back to the compile time
+ *          defaults:
+ *          - drive 0 is @p FATFS_HAL_DEVICE when the MMC_SPI or SDC driver
+ *            is enabled;
+ *          - the USB host mass storage LUNs follow, in order.
+ *          .
+ *
+ * @addtogroup FATFS_DISKIO
+ * @{
+ */
+
+#ifndef FATFS_DISKIO_H_
+#define FATFS_DISKIO_H_
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a block discard call.
+ * @details Tells the device that the blocks content is no longer needed,
+ *          it can erase them ahead of the next writes.
+ *
+ * @param[in] instance  pointer to the @p BaseBlockDevice object
+ * @param[in] startblk  first block
+ * @param[in] endblk    last block, included
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the blocks have been discarded.
+ * @retval HAL_FAILED   otherwise.
+ */
+typedef bool (*fatfs_trim_t)(void *instance, uint32_t startblk,
+                             uint32_t endblk);
+
+/**
+ * @brief   FatFS volume structure.
+ */
+typedef struct {
+  /**
+   * @brief   Block device serving the drive.
+   */
+  BaseBlockDevice       *blkdev;
+  /**
+   * @brief   Discard call for @p CTRL_TRIM, @p NULL if not supported.
+   */
+  fatfs_trim_t          trim;
+  /**
+   * @brief   Erase block size in blocks, zero if unknown.
+   */
+  uint32_t              erase_blocks;
+} fatfs_volume_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool fatfsRegisterVolume(uint8_t pdrv, const fatfs_volume_t *vp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FATFS_DISKIO_H_ */
+
+/** @} */
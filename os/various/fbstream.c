@@ -0,0 +1,341 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fbstream.c
+ * @brief   Frame buffer streaming code.
+ *
+ * @addtogroup FBStream
+ * @{
+ */
+
+#include "fbstream.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define CODE_LITERAL        (0x00)
+#define CODE_RUN            (0x80)
+#define CODE_COPY_UP        (0xC0)
+
+#define LITERAL_MAX         (128)
+#define RUN_MAX             (65)
+#define COPY_UP_MAX         (64)
+
+#define HASH_SEED           (0x811C9DC5u)
+#define HASH_PRIME          (0x01000193u)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static inline uint32_t unit_load(const uint8_t *p, size_t unit) {
+
+  switch (unit) {
+  case 4:
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  case 3:
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+  case 2:
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+  default:
+    return p[0];
+  }
+}
+
+static inline void put16(uint8_t *p, uint32_t value) {
+
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+}
+
+static inline void put32(uint8_t *p, uint32_t value) {
+
+  put16(p, value);
+  put16(p + 2, value >> 16);
+}
+
+/**
+ * @brief   Hashes a row of pixels.
+ * @details FNV-1a style hash, one word per step when the row is word aligned.
+ *          Only used to detect changes, not for integrity.
+ */
+static uint32_t row_hash(const uint8_t *p, size_t bytes) {
+
+  uint32_t h = HASH_SEED;
+
+  if (((uintptr_t)p & 3) == 0) {
+    const uint32_t *wp = (const uint32_t *)p;
+    size_t words = bytes >> 2;
+    while (words--) {
+      h = (h ^ *wp++) * HASH_PRIME;
+      h ^= h >> 15;
+    }
+    p = (const uint8_t *)wp;
+    bytes &= 3;
+  }
+  while (bytes--) {
+    h = (h ^ *p++) * HASH_PRIME;
+  }
+  return h;
+}
+
+static bool stream_write(fbstream_t *fsp, const uint8_t *bp, size_t n) {
+
+  if (streamWrite(fsp->config->streamp, bp, n) != n) {
+    return false;
+  }
+  fsp->bytes_sent += (uint32_t)n;
+  return true;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the frame buffer streamer object.
+ *
+ * @param[out] fsp      pointer to the @p fbstream_t object
+ * @param[in] cfgp      pointer to the @p fbstream_config_t object
+ *
+ * @init
+ */
+void fbstreamObjectInit(fbstream_t *fsp, const fbstream_config_t *cfgp) {
+
+  osalDbgCheck((fsp != NULL) && (cfgp != NULL));
+  osalDbgCheck((cfgp->streamp != NULL) && (cfgp->hashesp != NULL));
+  osalDbgCheck(cfgp->rowbufp != NULL);
+
+  fsp->config = cfgp;
+  fsp->sequence = 0;
+  fsp->width = 0;
+  fsp->height = 0;
+  fsp->fmt = 0;
+  fsp->valid = false;
+  fsp->since_key = 0;
+  fsp->rows_sent = 0;
+  fsp->bytes_sent = 0;
+}
+
+/**
+ * @brief   Forces the next capture to be a key frame.
+ * @details To be called when the host (re)connects, so that it receives a
+ *          complete frame.
+ *
+ * @param[in] fsp       pointer to the @p fbstream_t object
+ *
+ * @api
+ */
+void fbstreamInvalidate(fbstream_t *fsp) {
+
+  osalDbgCheck(fsp != NULL);
+
+  fsp->valid = false;
+}
+
+/**
+ * @brief   Encodes a row of pixels.
+ *
+ * @param[in] rowp      row to be encoded
+ * @param[in] abovep    row above, or @p NULL for the first row
+ * @param[in] units     number of pixel units in the row
+ * @param[in] unit      size of a pixel unit, 1 to 4 bytes
+ * @param[out] outp     encoded row, at most
+ *                      <tt>units * unit + 1 + units / 128</tt> bytes
+ * @return              Size of the encoded row, in bytes.
+ *
+ * @api
+ */
+size_t fbstreamEncodeRow(const uint8_t *rowp, const uint8_t *abovep,
+                         size_t units, size_t unit, uint8_t *outp) {
+
+  uint8_t *op = outp;
+  size_t i = 0, literals = 0;
+  /* A run must be shorter than its units, so that splitting a literal for
+     it never grows the row. Two 1-byte units cost as much as their run.*/
+  const size_t run_min = (unit == 1) ? 3 : 2;
+
+  osalDbgCheck((rowp != NULL) && (outp != NULL));
+  osalDbgCheck((unit >= 1) && (unit <= 4));
+
+  while (i < units) {
+    uint32_t px = unit_load(rowp + i * unit, unit);
+    size_t run = 1, up = 0;
+
+    while ((i + run < units) && (run < RUN_MAX) &&
+           (unit_load(rowp + (i + run) * unit, unit) == px)) {
+      ++run;
+    }
+    if (abovep != NULL) {
+      while ((i + up < units) && (up < COPY_UP_MAX) &&
+             (unit_load(rowp + (i + up) * unit, unit) ==
+              unit_load(abovep + (i + up) * unit, unit))) {
+        ++up;
+      }
+    }
+
+    if ((run < run_min) && (up < 2)) {
+      /* Literal unit, flushed together with the following ones.*/
+      ++i;
+      if (++literals < LITERAL_MAX) {
+        continue;
+      }
+    }
+
+    if (literals > 0) {
+      size_t n = literals * unit;
+      const uint8_t *lp = rowp + i * unit - n;
+      *op++ = (uint8_t)(CODE_LITERAL | (literals - 1));
+      while (n--) {
+        *op++ = *lp++;
+      }
+      literals = 0;
+      continue;
+    }
+
+    if ((up >= 2) && (up >= run)) {
+      *op++ = (uint8_t)(CODE_COPY_UP | (up - 1));
+      i += up;
+    }
+    else {
+      size_t n = unit;
+      *op++ = (uint8_t)(CODE_RUN | (run - 2));
+      while (n--) {
+        *op++ = (uint8_t)px;
+        px >>= 8;
+      }
+      i += run;
+    }
+  }
+
+  if (literals > 0) {
+    size_t n = literals * unit;
+    const uint8_t *lp = rowp + i * unit - n;
+    *op++ = (uint8_t)(CODE_LITERAL | (literals - 1));
+    while (n--) {
+      *op++ = *lp++;
+    }
+  }
+  return (size_t)(op - outp);
+}
+
+/**
+ * @brief   Captures a frame and streams its changes.
+ * @details Sends the frame header, the rows whose hash changed since the
+ *          previous capture, and the end record. Every row is sent if the
+ *          geometry or format changed, after @p fbstreamInvalidate(), and
+ *          every @p key_interval frames.
+ * @note    The frame should not be drawn while it is being captured, e.g.
+ *          capture the front buffer of a double or triple buffered display.
+ * @note    On a stream error the capture is aborted and the next one will
+ *          be a key frame.
+ *
+ * @param[in] fsp       pointer to the @p fbstream_t object
+ * @param[in] framep    frame to be captured
+ * @return              Number of bytes sent, zero on stream errors.
+ *
+ * @api
+ */
+size_t fbstreamCapture(fbstream_t *fsp, const fbstream_frame_t *framep) {
+
+  const fbstream_config_t *cfgp;
+  uint8_t header[FBSTREAM_HEADER_SIZE];
+  const uint8_t *rowp, *abovep = NULL;
+  uint32_t start = fsp->bytes_sent;
+  size_t bytes, unit;
+  uint16_t y, records = 0;
+  bool key, ok;
+
+  osalDbgCheck((fsp != NULL) && (framep != NULL));
+  osalDbgCheck(framep->fmt < PIXFMT_COUNT);
+
+  cfgp = fsp->config;
+  osalDbgAssert(framep->height <= cfgp->max_height, "frame too tall");
+  osalDbgAssert(FBSTREAM_ROWBUF_SIZE(framep->width, framep->fmt) <=
+                cfgp->rowbuf_size, "row buffer too small");
+
+  bytes = FBSTREAM_ROW_BYTES(framep->width, framep->fmt);
+  unit = PIXFMT_BPP(framep->fmt) >= 8 ? PIXFMT_BPP(framep->fmt) / 8 : 1;
+
+  key = !fsp->valid || (framep->width != fsp->width) ||
+        (framep->height != fsp->height) || (framep->fmt != fsp->fmt) ||
+        ((cfgp->key_interval > 0) && (fsp->since_key >= cfgp->key_interval));
+
+  header[0] = 'F';
+  header[1] = 'B';
+  header[2] = 'S';
+  header[3] = '1';
+  put32(&header[4], fsp->sequence++);
+  put16(&header[8], framep->width);
+  put16(&header[10], framep->height);
+  header[12] = framep->fmt;
+  header[13] = key ? FBSTREAM_FLAG_KEY : 0;
+  put16(&header[14], 0);
+  ok = stream_write(fsp, header, sizeof header);
+
+  /* Invalid until the end record is sent, so that a frame aborted by a
+     stream error is followed by a key frame.*/
+  fsp->valid = false;
+
+  rowp = (const uint8_t *)framep->bufferp;
+  for (y = 0; ok && (y < framep->height); ++y) {
+    uint32_t h = row_hash(rowp, bytes);
+
+    if (key || (h != cfgp->hashesp[y])) {
+      uint8_t *bp = cfgp->rowbufp;
+      size_t n = fbstreamEncodeRow(rowp, abovep, bytes / unit, unit,
+                                   bp + FBSTREAM_RECORD_SIZE);
+      put16(&bp[0], y);
+      put16(&bp[2], (uint32_t)n);
+      ok = stream_write(fsp, bp, FBSTREAM_RECORD_SIZE + n);
+      cfgp->hashesp[y] = h;
+      ++records;
+    }
+    abovep = rowp;
+    rowp += framep->pitch;
+  }
+
+  put16(&header[0], FBSTREAM_END_ROW);
+  put16(&header[2], records);
+  if (!ok || !stream_write(fsp, header, FBSTREAM_RECORD_SIZE)) {
+    return 0;
+  }
+
+  fsp->width = framep->width;
+  fsp->height = framep->height;
+  fsp->fmt = framep->fmt;
+  fsp->valid = true;
+  fsp->since_key = key ? 0 : fsp->since_key + 1;
+  fsp->rows_sent += records;
+  return (size_t)(fsp->bytes_sent - start);
+}
+
+/** @} */
@@ -0,0 +1,181 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fbstream.h
+ * @brief   Frame buffer streaming header.
+ * @details Streams snapshots of a frame buffer to a host over any
+ *          @p BaseSequentialStream (USB CDC, UART, ...). Only the rows whose
+ *          hash changed since the previous capture are sent, each one
+ *          compressed with a pixel oriented run-length codec that can also
+ *          repeat the row above. Frames are rebuilt on the host by
+ *          <tt>tools/fbstream_decode.py</tt>.
+ *
+ *          Stream format, all fields little endian:
+ *          - frame header (16 bytes): magic <tt>"FBS1"</tt>, sequence number
+ *            (32 bits), width and height (16 bits each), pixel format
+ *            (@p PIXFMT_xxx, 8 bits), flags (8 bits, @p FBSTREAM_FLAG_xxx),
+ *            reserved (16 bits);
+ *          - one record per changed row: row index and payload length
+ *            (16 bits each), followed by the compressed payload;
+ *          - end record: row index @p FBSTREAM_END_ROW, followed by the
+ *            number of row records of the frame (16 bits).
+ *
+ *          Row payloads are sequences of codes working on pixel units,
+ *          one byte per unit for 4-bit formats:
+ *          - <tt>0x00..0x7F</tt>: <tt>code + 1</tt> literal units follow;
+ *          - <tt>0x80..0xBF</tt>: one unit follows, repeated
+ *            <tt>(code & 0x3F) + 2</tt> times;
+ *          - <tt>0xC0..0xFF</tt>: <tt>(code & 0x3F) + 1</tt> units are
+ *            copied from the same position of the row above.
+ *
+ * @addtogroup FBStream
+ * @{
+ */
+
+#ifndef FBSTREAM_H_
+#define FBSTREAM_H_
+
+#include "hal.h"
+#include "hal_pixfmt.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Frame flags
+ * @{
+ */
+/** Key frame, every row is sent.*/
+#define FBSTREAM_FLAG_KEY               (1 << 0)
+/** @} */
+
+/**
+ * @brief   Row index of the end record.
+ */
+#define FBSTREAM_END_ROW                (0xFFFF)
+
+/**
+ * @brief   Size of the frame header, in bytes.
+ */
+#define FBSTREAM_HEADER_SIZE            (16)
+
+/**
+ * @brief   Size of a row record header, in bytes.
+ */
+#define FBSTREAM_RECORD_SIZE            (4)
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Frame specifications.
+ * @details Same layout as returned by @p ltdcFgGetFrame() and
+ *          @p ltdcBgGetFrame(), or describing any other frame buffer in
+ *          memory, such as the shadow buffer of an ILI9341 display.
+ */
+typedef struct fbstream_frame_t {
+  const void    *bufferp;           /**< Frame buffer address.*/
+  uint16_t      width;              /**< Width, in pixels.*/
+  uint16_t      height;             /**< Height, in pixels.*/
+  size_t        pitch;              /**< Line pitch, in bytes.*/
+  uint8_t       fmt;                /**< Pixel format, @p PIXFMT_xxx.*/
+} fbstream_frame_t;
+
+/**
+ * @brief   Frame buffer streamer configuration.
+ */
+typedef struct fbstream_config_t {
+  BaseSequentialStream  *streamp;   /**< Output stream.*/
+  uint32_t      *hashesp;           /**< Row hashes, @p max_height items.*/
+  uint16_t      max_height;         /**< Maximum frame height, in rows.*/
+  uint8_t       *rowbufp;           /**< Row encoding buffer.*/
+  size_t        rowbuf_size;        /**< Row encoding buffer size.*/
+  uint16_t      key_interval;       /**< Frames between key frames, 0: off.*/
+} fbstream_config_t;
+
+/**
+ * @brief   Frame buffer streamer object.
+ */
+typedef struct fbstream_t {
+  const fbstream_config_t *config;  /**< Current configuration.*/
+  uint32_t      sequence;           /**< Next frame sequence number.*/
+  uint16_t      width;              /**< Width of the previous capture.*/
+  uint16_t      height;             /**< Height of the previous capture.*/
+  uint8_t       fmt;                /**< Format of the previous capture.*/
+  bool          valid;              /**< Row hashes are valid.*/
+  uint16_t      since_key;          /**< Frames since the last key frame.*/
+  uint32_t      rows_sent;          /**< Total row records sent.*/
+  uint32_t      bytes_sent;         /**< Total bytes sent.*/
+} fbstream_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Row encoding buffer size.
+ * @details Worst case size of an encoded row record, for the given frame
+ *          width and pixel format. Runs and copies always take fewer bytes
+ *          than the units they replace, so the only overhead is one literal
+ *          code more than the runs and copies, plus one code each 128
+ *          literal units.
+ *
+ * @param[in] width     frame width, in pixels
+ * @param[in] fmt       pixel format, @p PIXFMT_xxx
+ */
+#define FBSTREAM_ROWBUF_SIZE(width, fmt)                                    \
+  (FBSTREAM_RECORD_SIZE + FBSTREAM_ROW_BYTES(width, fmt) + 1 +              \
+   FBSTREAM_ROW_BYTES(width, fmt) / 128)
+
+/**
+ * @brief   Size of a row of pixels, in bytes.
+ *
+ * @param[in] width     frame width, in pixels
+ * @param[in] fmt       pixel format, @p PIXFMT_xxx
+ */
+#define FBSTREAM_ROW_BYTES(width, fmt)                                      \
+  ((((size_t)(width) * PIXFMT_BPP(fmt)) + 7) / 8)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void fbstreamObjectInit(fbstream_t *fsp, const fbstream_config_t *cfgp);
+  void fbstreamInvalidate(fbstream_t *fsp);
+  size_t fbstreamEncodeRow(const uint8_t *rowp, const uint8_t *abovep,
+                           size_t units, size_t unit, uint8_t *outp);
+  size_t fbstreamCapture(fbstream_t *fsp, const fbstream_frame_t *framep);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FBSTREAM_H_ */
+
+/** @} */
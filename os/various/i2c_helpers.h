@@ -193,12 +193,12 @@ _i2c_reg(I2CHelper *i2c, uint8_t reg) {
 
 static inline msg_t
 _i2c_reg_recv8(I2CHelper *i2c, uint8_t reg, uint8_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
 _i2c_reg_recv16(I2CHelper *i2c, uint8_t reg, uint16_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -217,7 +217,7 @@ _i2c_reg_recv16_be(I2CHelper *i2c, uint8_t reg, uint16_t *val) {
 
 static inline msg_t
 _i2c_reg_recv32(I2CHelper *i2c, uint8_t reg, uint32_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -239,12 +239,12 @@ _i2c_reg_recv32_be(I2CHelper *i2c, uint8_t reg, uint32_t *val) {
 
 static inline msg_t
 _i2c_recv8(I2CHelper *i2c, uint8_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
 _i2c_recv16(I2CHelper *i2c, uint16_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -263,7 +263,7 @@ _i2c_recv16_be(I2CHelper *i2c, uint16_t *val) {
 
 static inline msg_t
 _i2c_recv32(I2CHelper *i2c, uint32_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
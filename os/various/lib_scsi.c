@@ -138,6 +138,31 @@ static bool transmit_data(SCSITarget *scsip, const uint8_t *data, uint32_t len)
   }
 }
 
+/**
+ * @brief   Receives data via transport channel.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[out] data   pointer to data buffer
+ * @param[in] len     number of bytes to be received
+ *
+ * @return            The operation status.
+ *
+ * @notapi
+ */
+static bool receive_data(SCSITarget *scsip, uint8_t *data, uint32_t len) {
+
+  const SCSITransport *trp = scsip->config->transport;
+  const uint32_t residue = len - trp->receive(trp, data, len);
+
+  if (residue > 0) {
+    scsip->residue = residue;
+    return SCSI_FAILED;
+  }
+  else {
+    return SCSI_SUCCESS;
+  }
+}
+
 /**
  * @brief   Stub for unhandled SCSI commands.
  * @details Sets error flags in sense data structure and returns error error.
@@ -339,6 +364,168 @@ static bool data_overflow(SCSITarget *scsip, const data_request_t *req) {
   }
 }
 
+/**
+ * @brief   Number of whole blocks fitting in the data buffer.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[in] bs      block size
+ *
+ * @notapi
+ */
+static uint32_t buffer_blocks(const SCSITarget *scsip, uint32_t bs) {
+
+  const uint32_t n = scsip->config->blkbuf_size / bs;
+
+  return (n > 0) ? n : 1;
+}
+
+/**
+ * @brief   Ends a failed read data phase with fill data.
+ * @details The host expects the whole data phase before the status, the
+ *          blocks not read are replaced by zeros.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[in] len     number of bytes left in the data phase
+ * @param[in] size    data buffer size
+ *
+ * @notapi
+ */
+static void pad_data(SCSITarget *scsip, uint32_t len, uint32_t size) {
+
+  const SCSITransport *trp = scsip->config->transport;
+  uint8_t *buf = scsip->config->blkbuf;
+
+  memset(buf, 0, size);
+  while (len > 0) {
+    const uint32_t n = (len < size) ? len : size;
+    if (trp->transmit(trp, buf, n) != n) {
+      break;
+    }
+    len -= n;
+  }
+}
+
+/**
+ * @brief   Ends a failed write data phase discarding the data.
+ * @details The data left must be consumed, otherwise it would be taken
+ *          as the next command blocks.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[in] len     number of bytes left in the data phase
+ * @param[in] size    data buffer size
+ *
+ * @notapi
+ */
+static void drain_data(SCSITarget *scsip, uint32_t len, uint32_t size) {
+
+  const SCSITransport *trp = scsip->config->transport;
+  uint8_t *buf = scsip->config->blkbuf;
+
+  while (len > 0) {
+    const uint32_t n = (len < size) ? len : size;
+    if (trp->receive(trp, buf, n) != n) {
+      break;
+    }
+    len -= n;
+  }
+}
+
+/**
+ * @brief   SCSI read (10) data phase.
+ * @details Memory mapped spans are transmitted in a single transfer straight
+ *          from the block device, other spans are read and transmitted in
+ *          chunks as large as the data buffer.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[in] req     pointer to the decoded data request
+ *
+ * @return            The operation status.
+ *
+ * @notapi
+ */
+static bool data_read10(SCSITarget *scsip, const data_request_t *req) {
+
+  const SCSITargetConfig *cfg = scsip->config;
+  BlockDeviceInfo bdi;
+  blkGetInfo(cfg->blkdev, &bdi);
+  const uint32_t bs = bdi.blk_size;
+  const uint32_t chunk = buffer_blocks(scsip, bs);
+  uint32_t lba = req->first_lba;
+  uint32_t left = req->blk_cnt;
+
+  if ((cfg->blkmap != NULL) && (left > 0)) {
+    const uint8_t *mem = cfg->blkmap(cfg->blkdev, lba, left);
+    if (mem != NULL) {
+      return transmit_data(scsip, mem, left * bs);
+    }
+  }
+
+  while (left > 0) {
+    const uint32_t n = (left < chunk) ? left : chunk;
+
+    if (HAL_SUCCESS != blkRead(cfg->blkdev, lba, cfg->blkbuf, n)) {
+      set_sense(scsip, SCSI_SENSE_KEY_MEDIUM_ERROR,
+                       SCSI_ASENSE_UNRECOVERED_READ_ERROR,
+                       SCSI_ASENSEQ_NO_QUALIFIER);
+      pad_data(scsip, left * bs, chunk * bs);
+      scsip->residue = left * bs;
+      return SCSI_FAILED;
+    }
+    if (SCSI_SUCCESS != transmit_data(scsip, cfg->blkbuf, n * bs)) {
+      scsip->residue += (left - n) * bs;
+      return SCSI_FAILED;
+    }
+    lba  += n;
+    left -= n;
+  }
+
+  return SCSI_SUCCESS;
+}
+
+/**
+ * @brief   SCSI write (10) data phase.
+ * @details Data is received and written in chunks as large as the data
+ *          buffer.
+ *
+ * @param[in] scsip   pointer to @p SCSITarget structure
+ * @param[in] req     pointer to the decoded data request
+ *
+ * @return            The operation status.
+ *
+ * @notapi
+ */
+static bool data_write10(SCSITarget *scsip, const data_request_t *req) {
+
+  const SCSITargetConfig *cfg = scsip->config;
+  BlockDeviceInfo bdi;
+  blkGetInfo(cfg->blkdev, &bdi);
+  const uint32_t bs = bdi.blk_size;
+  const uint32_t chunk = buffer_blocks(scsip, bs);
+  uint32_t lba = req->first_lba;
+  uint32_t left = req->blk_cnt;
+
+  while (left > 0) {
+    const uint32_t n = (left < chunk) ? left : chunk;
+
+    if (SCSI_SUCCESS != receive_data(scsip, cfg->blkbuf, n * bs)) {
+      scsip->residue += (left - n) * bs;
+      return SCSI_FAILED;
+    }
+    if (HAL_SUCCESS != blkWrite(cfg->blkdev, lba, cfg->blkbuf, n)) {
+      set_sense(scsip, SCSI_SENSE_KEY_MEDIUM_ERROR,
+                       SCSI_ASENSE_WRITE_ERROR,
+                       SCSI_ASENSEQ_NO_QUALIFIER);
+      drain_data(scsip, (left - n) * bs, chunk * bs);
+      scsip->residue = left * bs;
+      return SCSI_FAILED;
+    }
+    lba  += n;
+    left -= n;
+  }
+
+  return SCSI_SUCCESS;
+}
+
 /**
  * @brief   SCSI read/write (10) command handler.
  *
@@ -356,29 +543,12 @@ static bool data_read_write10(SCSITarget *scsip, const uint8_t *cmd) {
   if (data_overflow(scsip, &req)) {
     return SCSI_FAILED;
   }
+  else if (cmd[0] == SCSI_CMD_READ_10) {
+    return data_read10(scsip, &req);
+  }
   else {
-    const SCSITransport *tr = scsip->config->transport;
-    BaseBlockDevice *blkdev = scsip->config->blkdev;
-    BlockDeviceInfo bdi;
-    blkGetInfo(blkdev, &bdi);
-    size_t bs = bdi.blk_size;
-    uint8_t *buf = scsip->config->blkbuf;
-
-    size_t i = 0;
-    for (i=0; i<req.blk_cnt; i++) {
-      if (cmd[0] == SCSI_CMD_READ_10) {
-        // TODO: block error handling
-        blkRead(blkdev, req.first_lba + i, buf, 1);
-        tr->transmit(tr, buf, bs);
-      }
-      else {
-        // TODO: block error handling
-        tr->receive(tr, buf, bs);
-        blkWrite(blkdev, req.first_lba + i, buf, 1);
-      }
-    }
+    return data_write10(scsip, &req);
   }
-  return SCSI_SUCCESS;
 }
 
 /**
@@ -426,6 +596,8 @@ bool scsiExecCmd(SCSITarget *scsip, const uint8_t *cmd) {
 
   bool ret = SCSI_SUCCESS;
 
+  scsip->residue = 0;
+
   switch (cmd[0]) {
   case SCSI_CMD_INQUIRY:
     dbgprintf("SCSI_CMD_INQUIRY\r\n");
@@ -58,6 +58,8 @@
 #define SCSI_SENSE_KEY_MISCOMPARE               0x0E
 
 #define SCSI_ASENSE_NO_ADDITIONAL_INFORMATION   0x00
+#define SCSI_ASENSE_WRITE_ERROR                 0x0C
+#define SCSI_ASENSE_UNRECOVERED_READ_ERROR      0x11
 #define SCSI_ASENSE_LOGICAL_UNIT_NOT_READY      0x04
 #define SCSI_ASENSE_INVALID_FIELD_IN_CDB        0x24
 #define SCSI_ASENSE_NOT_READY_TO_READY_CHANGE   0x28
@@ -198,6 +200,21 @@ typedef uint32_t (*scsi_transport_transmit_t)(const SCSITransport *transport,
 typedef uint32_t (*scsi_transport_receive_t)(const SCSITransport *transport,
                                              uint8_t *data, size_t len);
 
+/**
+ * @brief   Type of a block device memory mapping call.
+ * @details Returns the address of @p n consecutive blocks when the block
+ *          device keeps them readable in memory, so that they can be
+ *          transmitted without passing through the block buffer.
+ *
+ * @param[in] instance  pointer to the @p BaseBlockDevice object
+ * @param[in] startblk  first block
+ * @param[in] n         number of blocks
+ * @return              Pointer to the blocks data or @p NULL if the span is
+ *                      not memory mapped.
+ */
+typedef const uint8_t *(*scsi_blk_map_t)(void *instance, uint32_t startblk,
+                                         uint32_t n);
+
 /**
  * @brief   SCSI transport structure.
  */
@@ -229,9 +246,21 @@ typedef struct {
    */
   BaseBlockDevice               *blkdev;
   /**
-   * @brief   Pointer to data buffer for single block.
+   * @brief   Pointer to data buffer, at least one block.
    */
   uint8_t                       *blkbuf;
+  /**
+   * @brief   Size of the data buffer in bytes.
+   * @details Reads and writes move as many whole blocks as fit in the buffer
+   *          per transfer, zero means a single block buffer.
+   */
+  size_t                        blkbuf_size;
+  /**
+   * @brief   Optional block device memory mapping call.
+   * @details When not @p NULL, reads of mapped spans are transmitted
+   *          directly from the block device memory.
+   */
+  scsi_blk_map_t                blkmap;
   /**
    * @brief   Pointer to SCSI inquiry response object.
    */
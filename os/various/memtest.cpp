@@ -16,26 +16,39 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <cstdlib>
 #include <cstring>
 
 #include "memtest.h"
 
-static unsigned int prng_seed = 42;
+/*
+ * Words moved per loop iteration, 32 bytes bursts with 32 bit words.
+ */
+#define MEMTEST_UNROLL    8
+
+static uint32_t prng_seed = 42;
 
 /*
- *
+ * Generators are plain classes, the test loops are instantiated for each
+ * of them so that get() is inlined.
  */
 template <typename T>
-class Generator {
+class GeneratorWalkingOne {
 public:
-  Generator(void) : pattern(0) {;}
-  virtual T get(void) = 0;
-  virtual testtype get_type(void) = 0;
-  virtual void init(T seed) {
+  void init(T seed) {
     pattern = seed;
   }
-protected:
+
+  T get(void) {
+    T ret = pattern;
+
+    pattern <<= 1;
+    if (0 == pattern)
+      pattern = 1;
+
+    return ret;
+  }
+
+private:
   T pattern;
 };
 
@@ -43,268 +56,524 @@ protected:
  *
  */
 template <typename T>
-class GeneratorWalkingOne : public Generator<T> {
+class GeneratorWalkingZero {
+public:
+  void init(T seed) {
+    pattern = seed;
+  }
+
   T get(void) {
-    T ret = this->pattern;
+    T ret = ~pattern;
 
-    this->pattern <<= 1;
-    if (0 == this->pattern)
-      this->pattern = 1;
+    pattern <<= 1;
+    if (0 == pattern)
+      pattern = 1;
 
     return ret;
   }
 
-  testtype get_type(void) {
-    return MEMTEST_WALKING_ONE;
-  }
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorWalkingZero : public Generator<T> {
-  T get(void) {
-    T ret = ~this->pattern;
-
-    this->pattern <<= 1;
-    if (0 == this->pattern)
-      this->pattern = 1;
-
-    return ret;
+class GeneratorOwnAddress {
+public:
+  void init(T seed) {
+    pattern = seed;
   }
 
-  testtype get_type(void) {
-    return MEMTEST_WALKING_ZERO;
+  T get(void) {
+    return pattern++;
   }
+
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorOwnAddress : public Generator<T> {
+class GeneratorMovingInv {
+public:
+  void init(T seed) {
+    pattern = seed;
+  }
+
   T get(void) {
-    T ret = this->pattern;
-    this->pattern++;
+    T ret = pattern;
+    pattern = ~pattern;
     return ret;
   }
 
-  testtype get_type(void) {
-    return MEMTEST_OWN_ADDRESS;
-  }
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorMovingInv : public Generator<T> {
+class GeneratorSolid {
+public:
+  void init(T seed) {
+    pattern = seed;
+  }
+
   T get(void) {
-    T ret = this->pattern;
-    this->pattern = ~this->pattern;
-    return ret;
+    return pattern;
   }
 
-  testtype get_type(void) {
-    if ((this->pattern == 0) || ((this->pattern & 0xFF) == 0xFF))
-      return MEMTEST_MOVING_INVERSION_ZERO;
-    else
-      return MEMTEST_MOVING_INVERSION_55AA;
+private:
+  T pattern;
+};
+
+/*
+ * Xorshift PRNG, 32 bit state for words up to 32 bits.
+ */
+template <typename T>
+class Xorshift {
+public:
+  void init(uint32_t seed) {
+    state = (0 != seed) ? seed : 2463534242U;
+  }
+
+  T next(void) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<T>(state);
   }
+
+private:
+  uint32_t state;
+};
+
+/*
+ * Xorshift PRNG, 64 bit state for 64 bit words.
+ */
+template <>
+class Xorshift<uint64_t> {
+public:
+  void init(uint32_t seed) {
+    state = 88172645463325252ULL ^ seed;
+  }
+
+  uint64_t next(void) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+private:
+  uint64_t state;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorMovingInvRand : public Generator<T> {
+class GeneratorMovingInvRand {
 public:
-  GeneratorMovingInvRand(void) : step(0), prev(0){;}
   void init(T seed) {
-    srand(seed);
-    step = 0;
+    prng.init(static_cast<uint32_t>(seed));
+    odd = false;
     prev = 0;
   }
 
   T get(void) {
     T ret;
 
-    if ((step & 1) == 0) {
-      ret  = 0;
-      ret |= rand();
-      // for uint64_t we need to call rand() twice
-      if (8 == sizeof(T)) {
-        // multiplication used instead of 32 bit shift for warning avoidance
-        ret *= 0x100000000;
-        ret |= rand();
-      }
-      prev = ret;
-    }
-    else {
+    if (!odd)
+      prev = ret = prng.next();
+    else
       ret = ~prev;
-    }
-    step++;
+    odd = !odd;
 
     return ret;
   }
 
-  testtype get_type(void) {
-    return MEMTEST_MOVING_INVERSION_RAND;
-  }
-
 private:
-  size_t step;
+  Xorshift<T> prng;
+  bool odd;
   T prev;
 };
 
+/*
+ *
+ */
+static uint32_t time_stamp(const memtest_t *testp) {
+
+  if (nullptr != testp->timecb)
+    return testp->timecb();
+  else
+    return 0;
+}
+
 /*
  *
  */
 template <typename T>
-static void memtest_sequential(memtest_t *testp, Generator<T> &generator, T seed) {
-  const size_t steps = testp->size / sizeof(T);
+static void report(memtest_t *testp, testtype type, size_t index,
+                   T got, T expect) {
+
+  if (nullptr != testp->errcb)
+    testp->errcb(testp, type, index, sizeof(T), got, expect);
+}
+
+/*
+ *
+ */
+template <typename T, typename G>
+static void fill(volatile T *mem, size_t steps, G &generator) {
   size_t i;
-  T *mem = static_cast<T *>(testp->start);
-  T got;
-  T expect;
+
+  for (i=0; i+MEMTEST_UNROLL<=steps; i+=MEMTEST_UNROLL) {
+    mem[i+0] = generator.get();
+    mem[i+1] = generator.get();
+    mem[i+2] = generator.get();
+    mem[i+3] = generator.get();
+    mem[i+4] = generator.get();
+    mem[i+5] = generator.get();
+    mem[i+6] = generator.get();
+    mem[i+7] = generator.get();
+  }
+  for (; i<steps; i++)
+    mem[i] = generator.get();
+}
+
+/*
+ * Returns the index of the first mismatch, steps if none.
+ */
+template <typename T, typename G>
+static size_t verify(volatile T *mem, size_t steps, G &generator,
+                     T *gotp, T *expectp) {
+  T got[MEMTEST_UNROLL];
+  T expect[MEMTEST_UNROLL];
+  size_t i, k, n;
+
+  for (i=0; i<steps; i+=n) {
+    n = (steps - i < MEMTEST_UNROLL) ? steps - i : MEMTEST_UNROLL;
+    if (MEMTEST_UNROLL == n) {
+      got[0] = mem[i+0];
+      got[1] = mem[i+1];
+      got[2] = mem[i+2];
+      got[3] = mem[i+3];
+      got[4] = mem[i+4];
+      got[5] = mem[i+5];
+      got[6] = mem[i+6];
+      got[7] = mem[i+7];
+      expect[0] = generator.get();
+      expect[1] = generator.get();
+      expect[2] = generator.get();
+      expect[3] = generator.get();
+      expect[4] = generator.get();
+      expect[5] = generator.get();
+      expect[6] = generator.get();
+      expect[7] = generator.get();
+      if (0 == ((got[0] ^ expect[0]) | (got[1] ^ expect[1]) |
+                (got[2] ^ expect[2]) | (got[3] ^ expect[3]) |
+                (got[4] ^ expect[4]) | (got[5] ^ expect[5]) |
+                (got[6] ^ expect[6]) | (got[7] ^ expect[7])))
+        continue;
+    }
+    else {
+      for (k=0; k<n; k++) {
+        got[k] = mem[i+k];
+        expect[k] = generator.get();
+      }
+    }
+    for (k=0; k<n; k++) {
+      if (got[k] != expect[k]) {
+        *gotp = got[k];
+        *expectp = expect[k];
+        return i + k;
+      }
+    }
+  }
+  return steps;
+}
+
+/*
+ * Fills the area and reads it back, measuring both passes.
+ */
+template <typename T, typename G>
+static bool memtest_sequential(memtest_t *testp, testtype type,
+                               G &generator, T seed) {
+  const size_t steps = testp->size / sizeof(T);
+  volatile T *mem = static_cast<volatile T *>(testp->start);
+  uint32_t start;
+  size_t index;
+  T got = 0;
+  T expect = 0;
 
   /* fill ram */
   generator.init(seed);
-  for (i=0; i<steps; i++)
-    mem[i] = generator.get();
+  start = time_stamp(testp);
+  fill(mem, steps, generator);
+  testp->stats.write_ticks += static_cast<uint32_t>(time_stamp(testp) - start);
+  testp->stats.written += steps * sizeof(T);
 
   /* read back and compare */
   generator.init(seed);
-  for (i=0; i<steps; i++) {
-    got = mem[i];
-    expect = generator.get();
-    if ((got != expect) && (nullptr != testp->errcb)) {
-      testp->errcb(testp, generator.get_type(), i, sizeof(T), got, expect);
-      return;
-    }
+  start = time_stamp(testp);
+  index = verify(mem, steps, generator, &got, &expect);
+  testp->stats.read_ticks += static_cast<uint32_t>(time_stamp(testp) - start);
+  testp->stats.read += index * sizeof(T);
+
+  if (index < steps) {
+    report(testp, type, index, got, expect);
+    return false;
   }
+  return true;
 }
 
 template <typename T>
-static void walking_one(memtest_t *testp) {
+static bool walking_one(memtest_t *testp) {
   GeneratorWalkingOne<T> generator;
-  memtest_sequential<T>(testp, generator, 1);
+  return memtest_sequential<T>(testp, MEMTEST_WALKING_ONE, generator, 1);
 }
 
 template <typename T>
-static void walking_zero(memtest_t *testp) {
+static bool walking_zero(memtest_t *testp) {
   GeneratorWalkingZero<T> generator;
-  memtest_sequential<T>(testp, generator, 1);
+  return memtest_sequential<T>(testp, MEMTEST_WALKING_ZERO, generator, 1);
 }
 
 template <typename T>
-static void own_address(memtest_t *testp) {
+static bool own_address(memtest_t *testp) {
   GeneratorOwnAddress<T> generator;
-  memtest_sequential<T>(testp, generator, 0);
+  return memtest_sequential<T>(testp, MEMTEST_OWN_ADDRESS, generator, 0);
 }
 
 template <typename T>
-static void moving_inversion_zero(memtest_t *testp) {
+static bool moving_inversion_zero(memtest_t *testp) {
   GeneratorMovingInv<T> generator;
   T seed;
   seed = 0;
-  memtest_sequential<T>(testp, generator, seed);
+  if (!memtest_sequential<T>(testp, MEMTEST_MOVING_INVERSION_ZERO,
+                             generator, seed))
+    return false;
   seed = ~seed;
-  memtest_sequential<T>(testp, generator, seed);
+  return memtest_sequential<T>(testp, MEMTEST_MOVING_INVERSION_ZERO,
+                               generator, seed);
 }
 
 template <typename T>
-static void moving_inversion_55aa(memtest_t *testp) {
+static bool moving_inversion_55aa(memtest_t *testp) {
   GeneratorMovingInv<T> generator;
   T seed;
   memset(&seed, 0x55, sizeof(seed));
-  memtest_sequential<T>(testp, generator, seed);
+  if (!memtest_sequential<T>(testp, MEMTEST_MOVING_INVERSION_55AA,
+                             generator, seed))
+    return false;
   seed = ~seed;
-  memtest_sequential<T>(testp, generator, seed);
+  return memtest_sequential<T>(testp, MEMTEST_MOVING_INVERSION_55AA,
+                               generator, seed);
 }
 
 template <typename T>
-static void moving_inversion_rand(memtest_t *testp) {
+static bool moving_inversion_rand(memtest_t *testp) {
   GeneratorMovingInvRand<T> generator;
-  T mask = -1;
   prng_seed++;
-  memtest_sequential<T>(testp, generator, prng_seed & mask);
+  return memtest_sequential<T>(testp, MEMTEST_MOVING_INVERSION_RAND,
+                               generator, static_cast<T>(prng_seed));
 }
 
 /*
- *
+ * One March element over the whole area, ascending or descending. Every
+ * cell is read expecting r and then written with w. March SS elements
+ * also read the cell twice, write r back and read it again first, to
+ * catch read and write disturb faults.
  */
-static void memtest_wrapper(memtest_t *testp,
-                            void (*p_u8) (memtest_t *testp),
-                            void (*p_u16)(memtest_t *testp),
-                            void (*p_u32)(memtest_t *testp),
-                            void (*p_u64)(memtest_t *testp)) {
+template <typename T, bool up, bool ss>
+static bool march_element(memtest_t *testp, testtype type, T r, T w) {
+  const size_t steps = testp->size / sizeof(T);
+  volatile T *mem = static_cast<volatile T *>(testp->start);
+  size_t n, i;
+  T got;
 
-  if (testp->width_mask & MEMTEST_WIDTH_8)
-    p_u8(testp);
+  for (n=0; n<steps; n++) {
+    i = up ? n : steps - 1 - n;
+    got = mem[i];
+    if (ss && (got == r)) {
+      got = mem[i];
+      if (got == r) {
+        mem[i] = r;
+        got = mem[i];
+      }
+    }
+    if (got != r) {
+      report(testp, type, i, got, r);
+      return false;
+    }
+    mem[i] = w;
+  }
+  return true;
+}
 
-  if (testp->width_mask & MEMTEST_WIDTH_16)
-    p_u16(testp);
+/*
+ * March C- {(w0); up(r0,w1); up(r1,w0); down(r0,w1); down(r1,w0); (r0)}
+ * March SS has the same structure with (r,r,w,r,w) elements.
+ */
+template <typename T, bool ss>
+static bool march(memtest_t *testp, testtype type) {
+  const size_t steps = testp->size / sizeof(T);
+  volatile T *mem = static_cast<volatile T *>(testp->start);
+  GeneratorSolid<T> solid;
+  size_t index;
+  T got = 0;
+  T expect = 0;
+  const T d0 = 0;
+  const T d1 = ~d0;
+
+  solid.init(d0);
+  fill(mem, steps, solid);
+
+  if (!march_element<T, true, ss>(testp, type, d0, d1) ||
+      !march_element<T, true, ss>(testp, type, d1, d0) ||
+      !march_element<T, false, ss>(testp, type, d0, d1) ||
+      !march_element<T, false, ss>(testp, type, d1, d0))
+    return false;
+
+  index = verify(mem, steps, solid, &got, &expect);
+  if (index < steps) {
+    report(testp, type, index, got, expect);
+    return false;
+  }
+  return true;
+}
 
-  if (testp->width_mask & MEMTEST_WIDTH_32)
-    p_u32(testp);
+template <typename T>
+static bool march_c_minus(memtest_t *testp) {
+  return march<T, false>(testp, MEMTEST_MARCH_C_MINUS);
+}
 
-  if (testp->width_mask & MEMTEST_WIDTH_64)
-    p_u64(testp);
+template <typename T>
+static bool march_ss(memtest_t *testp) {
+  return march<T, true>(testp, MEMTEST_MARCH_SS);
 }
 
 /*
  *
  */
-void memtest_run(memtest_t *testp, uint32_t testmask) {
+static bool memtest_wrapper(memtest_t *testp,
+                            bool (*p_u8) (memtest_t *testp),
+                            bool (*p_u16)(memtest_t *testp),
+                            bool (*p_u32)(memtest_t *testp),
+                            bool (*p_u64)(memtest_t *testp)) {
+
+  if ((testp->width_mask & MEMTEST_WIDTH_8) && !p_u8(testp))
+    return false;
+
+  if ((testp->width_mask & MEMTEST_WIDTH_16) && !p_u16(testp))
+    return false;
+
+  if ((testp->width_mask & MEMTEST_WIDTH_32) && !p_u32(testp))
+    return false;
+
+  if ((testp->width_mask & MEMTEST_WIDTH_64) && !p_u64(testp))
+    return false;
+
+  return true;
+}
+
+/*
+ * Runs the selected tests, stops on the first failure. Returns the type
+ * of the failed test, 0 if all of them passed.
+ */
+testtype memtest_run(memtest_t *testp, uint32_t testmask) {
+
+  memset(&testp->stats, 0, sizeof(testp->stats));
 
   if (testmask & MEMTEST_WALKING_ONE) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         walking_one<uint8_t>,
         walking_one<uint16_t>,
         walking_one<uint32_t>,
-        walking_one<uint64_t>);
+        walking_one<uint64_t>))
+      return MEMTEST_WALKING_ONE;
   }
 
   if (testmask & MEMTEST_WALKING_ZERO) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         walking_zero<uint8_t>,
         walking_zero<uint16_t>,
         walking_zero<uint32_t>,
-        walking_zero<uint64_t>);
+        walking_zero<uint64_t>))
+      return MEMTEST_WALKING_ZERO;
   }
 
   if (testmask & MEMTEST_OWN_ADDRESS) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         own_address<uint8_t>,
         own_address<uint16_t>,
         own_address<uint32_t>,
-        own_address<uint64_t>);
+        own_address<uint64_t>))
+      return MEMTEST_OWN_ADDRESS;
   }
 
   if (testmask & MEMTEST_MOVING_INVERSION_ZERO) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         moving_inversion_zero<uint8_t>,
         moving_inversion_zero<uint16_t>,
         moving_inversion_zero<uint32_t>,
-        moving_inversion_zero<uint64_t>);
+        moving_inversion_zero<uint64_t>))
+      return MEMTEST_MOVING_INVERSION_ZERO;
   }
 
   if (testmask & MEMTEST_MOVING_INVERSION_55AA) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         moving_inversion_55aa<uint8_t>,
         moving_inversion_55aa<uint16_t>,
         moving_inversion_55aa<uint32_t>,
-        moving_inversion_55aa<uint64_t>);
+        moving_inversion_55aa<uint64_t>))
+      return MEMTEST_MOVING_INVERSION_55AA;
   }
 
   if (testmask & MEMTEST_MOVING_INVERSION_RAND) {
-    memtest_wrapper(testp,
+    if (!memtest_wrapper(testp,
         moving_inversion_rand<uint8_t>,
         moving_inversion_rand<uint16_t>,
         moving_inversion_rand<uint32_t>,
-        moving_inversion_rand<uint64_t>);
+        moving_inversion_rand<uint64_t>))
+      return MEMTEST_MOVING_INVERSION_RAND;
   }
+
+  if (testmask & MEMTEST_MARCH_C_MINUS) {
+    if (!memtest_wrapper(testp,
+        march_c_minus<uint8_t>,
+        march_c_minus<uint16_t>,
+        march_c_minus<uint32_t>,
+        march_c_minus<uint64_t>))
+      return MEMTEST_MARCH_C_MINUS;
+  }
+
+  if (testmask & MEMTEST_MARCH_SS) {
+    if (!memtest_wrapper(testp,
+        march_ss<uint8_t>,
+        march_ss<uint16_t>,
+        march_ss<uint32_t>,
+        march_ss<uint64_t>))
+      return MEMTEST_MARCH_SS;
+  }
+
+  return 0;
 }
 
+/*
+ * Converts a measurement to kilobytes (1024 bytes) per second, freq is
+ * the time stamp counter frequency in Hz.
+ */
+uint32_t memtest_bandwidth(uint64_t bytes, uint64_t ticks, uint32_t freq) {
+
+  if (0 == ticks)
+    return 0;
+
+  return static_cast<uint32_t>((bytes / 1024) * freq / ticks);
+}
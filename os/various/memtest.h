@@ -26,6 +26,8 @@
 #define MEMTEST_MOVING_INVERSION_ZERO     (1 << 3)
 #define MEMTEST_MOVING_INVERSION_55AA     (1 << 4)
 #define MEMTEST_MOVING_INVERSION_RAND     (1 << 5)
+#define MEMTEST_MARCH_C_MINUS             (1 << 6)
+#define MEMTEST_MARCH_SS                  (1 << 7)
 
 /*
  * combined types for convenient
@@ -35,7 +37,9 @@
                                            MEMTEST_OWN_ADDRESS              | \
                                            MEMTEST_MOVING_INVERSION_ZERO    | \
                                            MEMTEST_MOVING_INVERSION_55AA    | \
-                                           MEMTEST_MOVING_INVERSION_RAND)
+                                           MEMTEST_MOVING_INVERSION_RAND    | \
+                                           MEMTEST_MARCH_C_MINUS            | \
+                                           MEMTEST_MARCH_SS)
 
 /*
  * Memtest data widths
@@ -54,6 +58,28 @@ typedef uint32_t testtype;
 typedef void (*memtestecb_t)(memtest_t *testp, testtype type, size_t index,
                            size_t current_width, uint32_t got, uint32_t expect);
 
+/*
+ * Time stamp call back, returns a free running counter.
+ */
+typedef uint32_t (*memtesttcb_t)(void);
+
+/*
+ * Bandwidth measurement, accumulated over the fill and read back passes
+ * of the pattern tests. Reset by memtest_run().
+ */
+typedef struct {
+  /*
+   * Bytes written and time spent writing them, in counter ticks.
+   */
+  uint64_t      written;
+  uint64_t      write_ticks;
+  /*
+   * Bytes read and time spent reading them, in counter ticks.
+   */
+  uint64_t      read;
+  uint64_t      read_ticks;
+} memtest_stats_t;
+
 /*
  *
  */
@@ -74,6 +100,14 @@ struct memtest_t {
    * Error callback pointer. Set to NULL if unused.
    */
   memtestecb_t  errcb;
+  /*
+   * Time stamp callback pointer. Set to NULL if bandwidth is not measured.
+   */
+  memtesttcb_t  timecb;
+  /*
+   * Bandwidth measurement of the last run.
+   */
+  memtest_stats_t stats;
 };
 
 /*
@@ -82,7 +116,8 @@ struct memtest_t {
 #ifdef __cplusplus
 extern "C" {
 #endif
-  void memtest_run(memtest_t *testp, uint32_t testmask);
+  testtype memtest_run(memtest_t *testp, uint32_t testmask);
+  uint32_t memtest_bandwidth(uint64_t bytes, uint64_t ticks, uint32_t freq);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,567 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nand_ecc.c
+ * @brief   NAND software ECC code.
+ *
+ * @addtogroup NAND_ECC
+ * @{
+ */
+
+#include <string.h>
+
+#include "nand_ecc.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Hamming ECC size, in bytes.
+ */
+#define HAMMING_BYTES           3U
+
+/**
+ * @brief   GF(2^13) primitive polynomial, x^13 + x^4 + x^3 + x + 1.
+ */
+#define GF_POLY                 0x201BU
+
+/**
+ * @brief   GF(2^13) multiplicative group order.
+ */
+#define GF_N                    ((1U << NAND_ECC_BCH_M) - 1U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Byte index contribution of a word to the Hamming line parity.
+ * @details Indexed by the parities of the four bytes, bits 0-1 are the XOR
+ *          of the odd parity byte offsets, bit 2 the parity of their count.
+ */
+static const uint8_t hamming_line[16] = {
+  0x0, 0x4, 0x5, 0x1, 0x6, 0x2, 0x3, 0x7,
+  0x7, 0x3, 0x2, 0x6, 0x1, 0x5, 0x4, 0x0
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint32_t load32(const uint8_t *p) {
+
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static unsigned log2u(uint32_t x) {
+  unsigned n = 0U;
+
+  while (x > 1U) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+}
+
+/**
+ * @brief   Hamming code of a step.
+ * @details The code is the XOR of the positions of the set bits, P, and of
+ *          their complements, P'. A single bit error at position k changes
+ *          P by k and P' by ~k.
+ *
+ * @param[in] data      step data
+ * @param[in] n         step size, in bytes
+ * @param[out] ecc      code, 3 bytes
+ */
+static void hamming_calc(const uint8_t *data, size_t n, uint8_t *ecc) {
+  unsigned bits = log2u((uint32_t)n * 8U);
+  uint32_t mask = (1UL << bits) - 1U;
+  uint32_t x = 0U, line = 0U, p, code;
+  unsigned col = 0U, j;
+  size_t w;
+
+  /* Per word: the XOR of the words gives the column parities, the byte
+     parities give the line parities.*/
+  for (w = 0U; w < n / 4U; w++) {
+    uint32_t v = load32(&data[w * 4U]);
+    unsigned lp;
+
+    x ^= v;
+    v ^= v >> 4;
+    v ^= v >> 2;
+    v ^= v >> 1;
+    v &= 0x01010101U;
+    lp = hamming_line[(v | (v >> 7) | (v >> 14) | (v >> 21)) & 0xFU];
+    line ^= (lp & 3U) ^ (((uint32_t)w << 2) & (0U - (uint32_t)(lp >> 2)));
+  }
+
+  x ^= x >> 16;
+  x ^= x >> 8;
+  x &= 0xFFU;
+  for (j = 0U; j < 8U; j++) {
+    if ((x & (1U << j)) != 0U) {
+      col ^= j;
+    }
+  }
+  p = (x ^ (x >> 4));
+  p ^= p >> 2;
+  p ^= p >> 1;
+
+  /* P' is P complemented when the count of set bits is odd.*/
+  code = (line << 3) | col;
+  code |= (code ^ (mask & (0U - (p & 1U)))) << bits;
+  ecc[0] = (uint8_t)code;
+  ecc[1] = (uint8_t)(code >> 8);
+  ecc[2] = (uint8_t)(code >> 16);
+}
+
+/**
+ * @brief   Corrects a step with the Hamming code.
+ *
+ * @param[in,out] data  step data
+ * @param[in] n         step size, in bytes
+ * @param[in] diff      computed code XOR stored code, 3 bytes
+ * @return              The number of corrected bits or
+ *                      @p NAND_ECC_UNCORRECTABLE.
+ */
+static int hamming_correct(uint8_t *data, size_t n, const uint8_t *diff) {
+  unsigned bits = log2u((uint32_t)n * 8U);
+  uint32_t mask = (1UL << bits) - 1U;
+  uint32_t d = (uint32_t)diff[0] | ((uint32_t)diff[1] << 8) |
+               ((uint32_t)diff[2] << 16);
+  uint32_t k = d & mask;
+
+  if (((k ^ (d >> bits)) & mask) == mask) {
+    data[k >> 3] ^= (uint8_t)(1U << (k & 7U));
+    return 1;
+  }
+  if ((d & (d - 1U)) == 0U) {
+    /* The error is in the code itself.*/
+    return 1;
+  }
+  return NAND_ECC_UNCORRECTABLE;
+}
+
+static uint32_t gf_mul(uint32_t a, uint32_t b) {
+  uint32_t r = 0U;
+
+  while (b != 0U) {
+    if ((b & 1U) != 0U) {
+      r ^= a;
+    }
+    b >>= 1;
+    a <<= 1;
+    if ((a & (1UL << NAND_ECC_BCH_M)) != 0U) {
+      a ^= GF_POLY;
+    }
+  }
+  return r;
+}
+
+static uint32_t gf_pow(uint32_t a, uint32_t e) {
+  uint32_t r = 1U;
+
+  e %= GF_N;
+  while (e != 0U) {
+    if ((e & 1U) != 0U) {
+      r = gf_mul(r, a);
+    }
+    a = gf_mul(a, a);
+    e >>= 1;
+  }
+  return r;
+}
+
+static uint32_t gf_inv(uint32_t a) {
+
+  return gf_pow(a, GF_N - 1U);
+}
+
+/**
+ * @brief   Feeds one byte to the BCH remainder register.
+ */
+static inline void bch_feed(const nand_ecc_t *ep, uint32_t *r, uint8_t b) {
+  const uint32_t *t = ep->enc[(uint8_t)((r[0] >> 24) ^ b)];
+  unsigned i;
+
+  for (i = 0U; i < ep->words - 1U; i++) {
+    r[i] = (r[i] << 8) ^ (r[i + 1U] >> 24) ^ t[i];
+  }
+  r[i] = (r[i] << 8) ^ t[i];
+}
+
+/**
+ * @brief   BCH code of a step.
+ *
+ * @param[in] ep        pointer to the @p nand_ecc_t object
+ * @param[in] data      step data, @p NAND_ECC_BCH_STEP_SIZE bytes
+ * @param[out] ecc      code, @p bytes bytes
+ */
+static void bch_calc(const nand_ecc_t *ep, const uint8_t *data, uint8_t *ecc) {
+  uint32_t r[NAND_ECC_BCH_WORDS] = {0U};
+  size_t i;
+
+  for (i = 0U; i < NAND_ECC_BCH_STEP_SIZE; i++) {
+    bch_feed(ep, r, data[i]);
+  }
+  for (i = 0U; i < ep->bytes; i++) {
+    ecc[i] = (uint8_t)(r[i / 4U] >> (24U - ((i % 4U) * 8U)));
+  }
+}
+
+/**
+ * @brief   Corrects a step with the BCH code.
+ * @details The syndromes are evaluated on the remainder difference, the
+ *          error locator is found by Berlekamp-Massey and its roots by a
+ *          Chien search using constant multiplication tables.
+ *
+ * @param[in] ep        pointer to the @p nand_ecc_t object
+ * @param[in,out] data  step data
+ * @param[in] diff      computed code XOR stored code, @p bytes bytes
+ * @return              The number of corrected bits or
+ *                      @p NAND_ECC_UNCORRECTABLE.
+ */
+static int bch_correct(const nand_ecc_t *ep, uint8_t *data,
+                       const uint8_t *diff) {
+  unsigned t = ep->config->strength;
+  unsigned deg = ep->deg;
+  uint32_t n = (NAND_ECC_BCH_STEP_SIZE * 8U) + deg;
+  uint32_t s[2U * NAND_ECC_BCH_MAX_T + 1U];
+  uint32_t lambda[NAND_ECC_BCH_MAX_T + 2U] = {1U};
+  uint32_t b[NAND_ECC_BCH_MAX_T + 2U] = {1U};
+  uint32_t tmp[NAND_ECC_BCH_MAX_T + 2U];
+  uint32_t term[NAND_ECC_BCH_MAX_T + 1U];
+  uint32_t pos[NAND_ECC_BCH_MAX_T];
+  uint32_t bd = 1U, d, coef, i;
+  unsigned l = 0U, m = 1U, j, k, roots = 0U;
+
+  /* Syndromes, S(2j) = S(j)^2.*/
+  for (j = 1U; j <= 2U * t; j++) {
+    if ((j & 1U) == 0U) {
+      s[j] = gf_mul(s[j / 2U], s[j / 2U]);
+      continue;
+    }
+    coef = gf_pow(2U, j);
+    d = 0U;
+    for (k = 0U; k < deg; k++) {
+      d = gf_mul(d, coef) ^ ((diff[k / 8U] >> (7U - (k % 8U))) & 1U);
+    }
+    s[j] = d;
+  }
+
+  /* Berlekamp-Massey.*/
+  for (j = 0U; j < 2U * t; j++) {
+    d = s[j + 1U];
+    for (k = 1U; k <= l; k++) {
+      d ^= gf_mul(lambda[k], s[j + 1U - k]);
+    }
+    if (d == 0U) {
+      m++;
+      continue;
+    }
+    coef = gf_mul(d, gf_inv(bd));
+    memcpy(tmp, lambda, sizeof tmp);
+    for (k = 0U; k + m <= t + 1U; k++) {
+      lambda[k + m] ^= gf_mul(coef, b[k]);
+    }
+    if (2U * l <= j) {
+      l = j + 1U - l;
+      memcpy(b, tmp, sizeof b);
+      bd = d;
+      m = 1U;
+    }
+    else {
+      m++;
+    }
+  }
+  if (l > t) {
+    return NAND_ECC_UNCORRECTABLE;
+  }
+
+  /* Chien search, Lambda(alpha^-i) for every bit position i.*/
+  for (k = 1U; k <= l; k++) {
+    term[k] = lambda[k];
+  }
+  for (i = 0U; (i < n) && (roots < l); i++) {
+    uint32_t sum = 1U;
+    for (k = 1U; k <= l; k++) {
+      sum ^= term[k];
+      term[k] = ep->chien_lo[k - 1U][term[k] & 0x7FU] ^
+                ep->chien_hi[k - 1U][term[k] >> 7];
+    }
+    if (sum == 0U) {
+      pos[roots++] = i;
+    }
+  }
+  if (roots != l) {
+    return NAND_ECC_UNCORRECTABLE;
+  }
+
+  /* Data bits are the highest degree terms, errors in the code itself
+     are only counted.*/
+  for (k = 0U; k < roots; k++) {
+    if (pos[k] >= deg) {
+      uint32_t bit = n - 1U - pos[k];
+      data[bit / 8U] ^= (uint8_t)(0x80U >> (bit % 8U));
+    }
+  }
+  return (int)roots;
+}
+
+/**
+ * @brief   Builds the BCH tables.
+ */
+static void bch_init(nand_ecc_t *ep) {
+  unsigned t = ep->config->strength;
+  unsigned deg = NAND_ECC_BCH_M * t;
+  uint32_t g[NAND_ECC_BCH_WORDS + 1U] = {1U};
+  unsigned gdeg = 0U, j, k, i;
+
+  ep->deg   = deg;
+  ep->words = (deg + 31U) / 32U;
+
+  /* Generator, product of the minimal polynomials of alpha^j, j odd. The
+     field order being prime, every class has NAND_ECC_BCH_M elements.*/
+  for (j = 1U; j < 2U * t; j += 2U) {
+    uint32_t mp[NAND_ECC_BCH_M + 1U] = {1U};
+    uint32_t r = gf_pow(2U, j), prod[NAND_ECC_BCH_WORDS + 1U] = {0U};
+
+    for (k = 0U; k < NAND_ECC_BCH_M; k++) {
+      for (i = k + 1U; i > 0U; i--) {
+        mp[i] = mp[i - 1U] ^ gf_mul(mp[i], r);
+      }
+      mp[0] = gf_mul(mp[0], r);
+      r = gf_mul(r, r);
+    }
+    for (k = 0U; k <= NAND_ECC_BCH_M; k++) {
+      if (mp[k] == 0U) {
+        continue;
+      }
+      for (i = 0U; i <= gdeg; i++) {
+        if ((g[i / 32U] >> (i % 32U)) & 1U) {
+          prod[(i + k) / 32U] ^= 1UL << ((i + k) % 32U);
+        }
+      }
+    }
+    gdeg += NAND_ECC_BCH_M;
+    memcpy(g, prod, sizeof g);
+  }
+
+  /* Remainder of each byte, the register is left aligned: bit 31 of the
+     first word is the coefficient of x^(deg-1).*/
+  for (i = 0U; i < 256U; i++) {
+    uint32_t r[NAND_ECC_BCH_WORDS] = {0U};
+
+    for (k = 0U; k < 8U; k++) {
+      bool fb = (((r[0] >> 31) ^ (i >> (7U - k))) & 1U) != 0U;
+      for (j = 0U; j < ep->words - 1U; j++) {
+        r[j] = (r[j] << 1) | (r[j + 1U] >> 31);
+      }
+      r[j] <<= 1;
+      if (fb) {
+        unsigned e;
+        for (e = 0U; e < deg; e++) {
+          if ((g[e / 32U] >> (e % 32U)) & 1U) {
+            unsigned p = deg - 1U - e;
+            r[p / 32U] ^= 0x80000000UL >> (p % 32U);
+          }
+        }
+      }
+    }
+    memcpy(ep->enc[i], r, sizeof r);
+  }
+
+  for (k = 1U; k <= t; k++) {
+    uint32_t c = gf_pow(2U, GF_N - k);
+    for (i = 0U; i < 128U; i++) {
+      ep->chien_lo[k - 1U][i] = (uint16_t)gf_mul(i, c);
+    }
+    for (i = 0U; i < 64U; i++) {
+      ep->chien_hi[k - 1U][i] = (uint16_t)gf_mul(i << 7, c);
+    }
+  }
+}
+
+/**
+ * @brief   Raw code of a step.
+ */
+static void step_calc(const nand_ecc_t *ep, const uint8_t *data,
+                      uint8_t *ecc) {
+
+  if (ep->config->algo == NAND_ECC_HAMMING) {
+    hamming_calc(data, ep->config->step_size, ecc);
+  }
+  else {
+    bch_calc(ep, data, ecc);
+  }
+}
+
+/**
+ * @brief   Raw code of an erased step.
+ * @details The Hamming code of all ones is zero, for BCH the bytes are fed
+ *          one by one to keep the stack small.
+ */
+static void erased_calc(const nand_ecc_t *ep, uint8_t *ecc) {
+  uint32_t r[NAND_ECC_BCH_WORDS] = {0U};
+  size_t i;
+
+  if (ep->config->algo == NAND_ECC_BCH) {
+    for (i = 0U; i < NAND_ECC_BCH_STEP_SIZE; i++) {
+      bch_feed(ep, r, 0xFFU);
+    }
+  }
+  for (i = 0U; i < ep->bytes; i++) {
+    ecc[i] = (uint8_t)(r[i / 4U] >> (24U - ((i % 4U) * 8U)));
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an ECC engine.
+ * @details Builds the encoding and decoding tables.
+ *
+ * @param[out] ep       pointer to the @p nand_ecc_t object
+ * @param[in] config    pointer to the @p nand_ecc_config_t object
+ * @return              The operation status.
+ * @retval false        if the configuration is not valid.
+ *
+ * @init
+ */
+bool nandEccInit(nand_ecc_t *ep, const nand_ecc_config_t *config) {
+  size_t i;
+
+  if (config->algo == NAND_ECC_HAMMING) {
+    if ((config->step_size != 256U) && (config->step_size != 512U)) {
+      return false;
+    }
+    ep->bytes = HAMMING_BYTES;
+  }
+  else if (config->algo == NAND_ECC_BCH) {
+    if ((config->step_size != NAND_ECC_BCH_STEP_SIZE) ||
+        (config->strength < 1U) ||
+        (config->strength > NAND_ECC_BCH_MAX_T)) {
+      return false;
+    }
+    ep->bytes = ((NAND_ECC_BCH_M * config->strength) + 7U) / 8U;
+  }
+  else {
+    return false;
+  }
+
+  ep->config = config;
+  if (config->algo == NAND_ECC_BCH) {
+    bch_init(ep);
+  }
+
+  /* Mask making the stored code of an erased step all FFh.*/
+  erased_calc(ep, ep->erased);
+  for (i = 0U; i < ep->bytes; i++) {
+    ep->erased[i] ^= 0xFFU;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Computes the ECC of a page into its spare area.
+ *
+ * @param[in] ep        pointer to the @p nand_ecc_t object
+ * @param[in] data      page data
+ * @param[in] datalen   page data size, multiple of the step size
+ * @param[out] spare    spare area, at least @p nandEccSpareSize() bytes,
+ *                      only the ECC bytes are written
+ *
+ * @api
+ */
+void nandEccCalculate(const nand_ecc_t *ep, const uint8_t *data,
+                      size_t datalen, uint8_t *spare) {
+  size_t step = ep->config->step_size;
+  uint8_t *ecc = &spare[ep->config->spare_offset];
+  size_t s, i;
+
+  for (s = 0U; s < datalen / step; s++) {
+    step_calc(ep, &data[s * step], ecc);
+    for (i = 0U; i < ep->bytes; i++) {
+      ecc[i] ^= ep->erased[i];
+    }
+    ecc += ep->bytes;
+  }
+}
+
+/**
+ * @brief   Checks and corrects a page against the ECC in its spare area.
+ * @details Steps whose ECC matches are not decoded.
+ *
+ * @param[in] ep        pointer to the @p nand_ecc_t object
+ * @param[in,out] data  page data, corrected in place
+ * @param[in] datalen   page data size, multiple of the step size
+ * @param[in] spare     spare area as read from the device
+ * @return              The highest number of bits corrected in a step.
+ * @retval NAND_ECC_UNCORRECTABLE if a step has too many errors, the other
+ *                      steps are corrected anyway.
+ *
+ * @api
+ */
+int nandEccCorrect(const nand_ecc_t *ep, uint8_t *data, size_t datalen,
+                   const uint8_t *spare) {
+  size_t step = ep->config->step_size;
+  const uint8_t *ecc = &spare[ep->config->spare_offset];
+  uint8_t diff[NAND_ECC_MAX_BYTES];
+  int ret = 0;
+  size_t s, i;
+
+  for (s = 0U; s < datalen / step; s++) {
+    uint8_t *p = &data[s * step];
+    uint8_t any = 0U;
+    int n;
+
+    step_calc(ep, p, diff);
+    for (i = 0U; i < ep->bytes; i++) {
+      diff[i] ^= ecc[i] ^ ep->erased[i];
+      any |= diff[i];
+    }
+    ecc += ep->bytes;
+    if (any == 0U) {
+      continue;
+    }
+
+    if (ep->config->algo == NAND_ECC_HAMMING) {
+      n = hamming_correct(p, step, diff);
+    }
+    else {
+      n = bch_correct(ep, p, diff);
+    }
+    if (n == NAND_ECC_UNCORRECTABLE) {
+      ret = NAND_ECC_UNCORRECTABLE;
+    }
+    else if ((ret != NAND_ECC_UNCORRECTABLE) && (n > ret)) {
+      ret = n;
+    }
+  }
+  return ret;
+}
+
+/** @} */
@@ -0,0 +1,205 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nand_ecc.h
+ * @brief   NAND software ECC header.
+ * @details Computes and checks the ECC of NAND pages, split in steps of
+ *          @p step_size bytes each protected by its own code word:
+ *          - Hamming, 3 bytes per step of 256 or 512 bytes, corrects one
+ *            bit and detects two;
+ *          - BCH over GF(2^13), 13 times @p strength bits per step of
+ *            512 bytes, corrects up to @p strength bits.
+ *          .
+ *          The ECC bytes of the steps are stored back to back in the spare
+ *          area, starting at @p spare_offset so that the bad block marker
+ *          is left alone. The ECC of an erased step is all FFh, erased
+ *          pages read as clean.
+ *
+ *          A read is checked by computing the ECC again and comparing it
+ *          with the stored one, the syndromes are only decoded for the
+ *          steps that differ.
+ * @note    This module only depends on the C library, it builds as is on
+ *          a host for testing and benchmarking.
+ *
+ * @addtogroup NAND_ECC
+ * @{
+ */
+
+#ifndef NAND_ECC_H_
+#define NAND_ECC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Returned by @p nandEccCorrect() for uncorrectable data.
+ */
+#define NAND_ECC_UNCORRECTABLE          (-1)
+
+/**
+ * @brief   BCH Galois field order.
+ */
+#define NAND_ECC_BCH_M                  13U
+
+/**
+ * @brief   BCH step size, in bytes.
+ */
+#define NAND_ECC_BCH_STEP_SIZE          512U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Highest BCH strength, in bits per step.
+ * @note    Sets the size of the @p nand_ecc_t tables, about 7 KB with
+ *          the default value.
+ */
+#if !defined(NAND_ECC_BCH_MAX_T) || defined(__DOXYGEN__)
+#define NAND_ECC_BCH_MAX_T              8
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (NAND_ECC_BCH_MAX_T < 1) || (NAND_ECC_BCH_MAX_T > 16)
+#error "invalid NAND_ECC_BCH_MAX_T value"
+#endif
+
+/**
+ * @brief   Remainder register size of the strongest BCH code, in words.
+ */
+#define NAND_ECC_BCH_WORDS                                                  \
+  (((NAND_ECC_BCH_M * NAND_ECC_BCH_MAX_T) + 31U) / 32U)
+
+/**
+ * @brief   Largest ECC size per step, in bytes.
+ */
+#define NAND_ECC_MAX_BYTES                                                  \
+  (((NAND_ECC_BCH_M * NAND_ECC_BCH_MAX_T) + 7U) / 8U)
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   ECC algorithms.
+ */
+typedef enum {
+  NAND_ECC_HAMMING = 0,             /**< 1 bit correction.                  */
+  NAND_ECC_BCH = 1                  /**< @p strength bits correction.       */
+} nand_ecc_algo_t;
+
+/**
+ * @brief   ECC configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Algorithm.
+   */
+  nand_ecc_algo_t       algo;
+  /**
+   * @brief   Correctable bits per step, BCH only.
+   */
+  uint8_t               strength;
+  /**
+   * @brief   Step size in bytes, 256 or 512 for Hamming, 512 for BCH.
+   */
+  uint16_t              step_size;
+  /**
+   * @brief   Offset of the first ECC byte in the spare area.
+   */
+  uint16_t              spare_offset;
+} nand_ecc_config_t;
+
+/**
+ * @brief   ECC engine object.
+ */
+typedef struct {
+  /**
+   * @brief   Current configuration.
+   */
+  const nand_ecc_config_t *config;
+  /**
+   * @brief   ECC size per step, in bytes.
+   */
+  size_t                bytes;
+  /**
+   * @brief   Stored ECC of an erased step is FFh, XOR mask.
+   */
+  uint8_t               erased[NAND_ECC_MAX_BYTES];
+  /**
+   * @brief   BCH remainder register size, in bits.
+   */
+  unsigned              deg;
+  /**
+   * @brief   BCH remainder register size, in words.
+   */
+  unsigned              words;
+  /**
+   * @brief   BCH remainder of each byte value, left aligned.
+   */
+  uint32_t              enc[256][NAND_ECC_BCH_WORDS];
+  /**
+   * @brief   Chien search multipliers by alpha^-k, low 7 bits.
+   */
+  uint16_t              chien_lo[NAND_ECC_BCH_MAX_T][128];
+  /**
+   * @brief   Chien search multipliers by alpha^-k, high 6 bits.
+   */
+  uint16_t              chien_hi[NAND_ECC_BCH_MAX_T][64];
+} nand_ecc_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Spare area bytes used for a page, bad block marker included.
+ *
+ * @param[in] ep        pointer to an initialized @p nand_ecc_t object
+ * @param[in] datalen   page data size, multiple of the step size
+ */
+#define nandEccSpareSize(ep, datalen)                                       \
+  ((size_t)(ep)->config->spare_offset +                                     \
+   (((datalen) / (ep)->config->step_size) * (ep)->bytes))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool nandEccInit(nand_ecc_t *ep, const nand_ecc_config_t *config);
+  void nandEccCalculate(const nand_ecc_t *ep, const uint8_t *data,
+                        size_t datalen, uint8_t *spare);
+  int nandEccCorrect(const nand_ecc_t *ep, uint8_t *data, size_t datalen,
+                     const uint8_t *spare);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NAND_ECC_H_ */
+
+/** @} */
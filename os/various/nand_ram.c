@@ -0,0 +1,360 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nand_ram.c
+ * @brief   RAM backed NAND flash model code.
+ *
+ * @addtogroup NAND_RAM
+ * @{
+ */
+
+#include <string.h>
+
+#include "nand_ram.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define CMD_READ0               0x00U
+#define CMD_RNDOUT              0x05U
+#define CMD_PAGEPROG            0x10U
+#define CMD_CACHEPROG           0x15U
+#define CMD_READ0_CONFIRM       0x30U
+#define CMD_READ_CACHE          0x31U
+#define CMD_READ_CACHE_END      0x3FU
+#define CMD_ERASE               0x60U
+#define CMD_STATUS              0x70U
+#define CMD_WRITE               0x80U
+#define CMD_READID              0x90U
+#define CMD_ERASE_CONFIRM       0xD0U
+#define CMD_RNDOUT_START        0xE0U
+#define CMD_RESET               0xFFU
+
+#define STATUS_FAIL             0x01U
+#define STATUS_FAILC            0x02U
+#define STATUS_ARDY             0x20U
+#define STATUS_RDY              0x40U
+#define STATUS_WP               0x80U
+
+/**
+ * @brief   Status of an idle device, not write protected.
+ */
+#define STATUS_IDLE             (STATUS_WP | STATUS_RDY | STATUS_ARDY)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Decodes little endian address cycles.
+ */
+static uint32_t decode(const uint8_t *addr, size_t n) {
+  uint32_t v = 0U;
+
+  while (n-- > 0U) {
+    v = (v << 8) | addr[n];
+  }
+  return v;
+}
+
+/**
+ * @brief   Row of the received address, @p false if out of the array.
+ */
+static bool decode_row(nand_ram_t *nrp, size_t first, uint32_t *rowp) {
+  const nand_ram_config_t *cfgp = nrp->config;
+
+  if (nrp->addrcnt < first + cfgp->rowcycles) {
+    return false;
+  }
+  *rowp = decode(&nrp->addr[first], cfgp->rowcycles);
+  return *rowp < cfgp->blocks * cfgp->pages_per_block;
+}
+
+static uint8_t *row_ptr(nand_ram_t *nrp, uint32_t row) {
+
+  return &nrp->array[(size_t)row * nrp->config->page_size];
+}
+
+/**
+ * @brief   Loads a page from the array to the data register.
+ */
+static void load(nand_ram_t *nrp, uint32_t row) {
+
+  memcpy(nrp->data_reg, row_ptr(nrp, row), nrp->config->page_size);
+  nrp->row = row;
+  nrp->counters.reads++;
+}
+
+/**
+ * @brief   Programs the cache register to the array.
+ * @return              The status @p FAIL bit.
+ */
+static uint8_t program(nand_ram_t *nrp) {
+  const nand_ram_config_t *cfgp = nrp->config;
+  uint8_t *p;
+  uint32_t row, i;
+
+  if (!decode_row(nrp, cfgp->colcycles, &row) ||
+      (row / cfgp->pages_per_block == nrp->fail_block)) {
+    return STATUS_FAIL;
+  }
+  p = row_ptr(nrp, row);
+  for (i = 0U; i < cfgp->page_size; i++) {
+    p[i] &= nrp->cache_reg[i];
+  }
+  nrp->counters.programs++;
+  return 0U;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a NAND model, the array is fully erased.
+ *
+ * @param[out] nrp      pointer to the @p nand_ram_t object
+ * @param[in] config    pointer to the @p nand_ram_config_t object
+ * @param[in] array     array buffer, @p NAND_RAM_ARRAY_SIZE() bytes
+ * @param[in] regs      registers buffer, @p NAND_RAM_REGS_SIZE() bytes
+ * @return              The operation status.
+ * @retval false        if the configuration is not valid.
+ *
+ * @init
+ */
+bool nandRamInit(nand_ram_t *nrp, const nand_ram_config_t *config,
+                 uint8_t *array, uint8_t *regs) {
+
+  if ((config->blocks == 0U) || (config->pages_per_block == 0U) ||
+      (config->page_size == 0U) || (config->rowcycles == 0U) ||
+      (config->rowcycles > 4U) ||
+      (config->colcycles + config->rowcycles > NAND_RAM_MAX_ADDR_CYCLES)) {
+    return false;
+  }
+
+  nrp->config     = config;
+  nrp->array      = array;
+  nrp->data_reg   = regs;
+  nrp->cache_reg  = &regs[config->page_size];
+  nrp->cmd        = CMD_RESET;
+  nrp->addrcnt    = 0U;
+  nrp->col        = 0U;
+  nrp->row        = 0U;
+  nrp->status     = STATUS_IDLE;
+  nrp->cache_prog = false;
+  nrp->fail_block = NAND_RAM_NO_FAIL;
+  memset(&nrp->counters, 0, sizeof nrp->counters);
+  memset(array, 0xFF, NAND_RAM_ARRAY_SIZE(config));
+  memset(regs, 0xFF, NAND_RAM_REGS_SIZE(config));
+
+  return true;
+}
+
+/**
+ * @brief   Command cycle.
+ * @note    The model is never busy, the status is always ready.
+ *
+ * @param[in] nrp       pointer to the @p nand_ram_t object
+ * @param[in] cmd       command byte
+ *
+ * @api
+ */
+void nandRamWriteCmd(nand_ram_t *nrp, uint8_t cmd) {
+  const nand_ram_config_t *cfgp = nrp->config;
+  uint32_t row;
+  uint8_t fail;
+
+  switch (cmd) {
+  case CMD_READ0:
+  case CMD_RNDOUT:
+  case CMD_ERASE:
+  case CMD_READID:
+    nrp->addrcnt = 0U;
+    break;
+
+  case CMD_WRITE:
+    /* The cache register is cleared, the bytes not written are left
+       unprogrammed.*/
+    nrp->addrcnt = 0U;
+    memset(nrp->cache_reg, 0xFF, cfgp->page_size);
+    break;
+
+  case CMD_READ0_CONFIRM:
+    if (decode_row(nrp, cfgp->colcycles, &row)) {
+      load(nrp, row);
+      memcpy(nrp->cache_reg, nrp->data_reg, cfgp->page_size);
+      nrp->status = STATUS_IDLE;
+    }
+    else {
+      nrp->status = STATUS_IDLE | STATUS_FAIL;
+    }
+    break;
+
+  case CMD_READ_CACHE:
+  case CMD_READ_CACHE_END:
+    /* The data register moves to the cache register, with 31h the next
+       page is loaded meanwhile.*/
+    memcpy(nrp->cache_reg, nrp->data_reg, cfgp->page_size);
+    nrp->col = 0U;
+    nrp->counters.cache_reads++;
+    if ((cmd == CMD_READ_CACHE) &&
+        (nrp->row + 1U < cfgp->blocks * cfgp->pages_per_block)) {
+      load(nrp, nrp->row + 1U);
+    }
+    break;
+
+  case CMD_RNDOUT_START:
+    break;
+
+  case CMD_PAGEPROG:
+  case CMD_CACHEPROG:
+    /* Within a cache sequence FAILC reports the previous page.*/
+    fail = 0U;
+    if (nrp->cache_prog && ((nrp->status & STATUS_FAIL) != 0U)) {
+      fail = STATUS_FAILC;
+    }
+    nrp->status = STATUS_IDLE | fail | program(nrp);
+    nrp->cache_prog = cmd == CMD_CACHEPROG;
+    if (nrp->cache_prog) {
+      nrp->counters.cache_programs++;
+    }
+    break;
+
+  case CMD_ERASE_CONFIRM:
+    if (decode_row(nrp, 0U, &row) &&
+        (row / cfgp->pages_per_block != nrp->fail_block)) {
+      row -= row % cfgp->pages_per_block;
+      memset(row_ptr(nrp, row), 0xFF,
+             (size_t)cfgp->pages_per_block * cfgp->page_size);
+      nrp->counters.erases++;
+      nrp->status = STATUS_IDLE;
+    }
+    else {
+      nrp->status = STATUS_IDLE | STATUS_FAIL;
+    }
+    break;
+
+  case CMD_STATUS:
+    break;
+
+  case CMD_RESET:
+    nrp->status = STATUS_IDLE;
+    nrp->cache_prog = false;
+    break;
+
+  default:
+    return;
+  }
+
+  nrp->cmd = cmd;
+}
+
+/**
+ * @brief   Address cycle.
+ *
+ * @param[in] nrp       pointer to the @p nand_ram_t object
+ * @param[in] addr      address byte
+ *
+ * @api
+ */
+void nandRamWriteAddr(nand_ram_t *nrp, uint8_t addr) {
+  size_t colcycles = nrp->config->colcycles;
+
+  if (nrp->addrcnt >= NAND_RAM_MAX_ADDR_CYCLES) {
+    return;
+  }
+  nrp->addr[nrp->addrcnt++] = addr;
+
+  /* The column pointer is set as soon as the column cycles are in.*/
+  if ((nrp->addrcnt == colcycles) &&
+      ((nrp->cmd == CMD_READ0) || (nrp->cmd == CMD_RNDOUT) ||
+       (nrp->cmd == CMD_WRITE))) {
+    nrp->col = decode(nrp->addr, colcycles);
+  }
+  if (nrp->cmd == CMD_READID) {
+    nrp->col = 0U;
+  }
+}
+
+/**
+ * @brief   Data input cycle.
+ * @note    Bytes past the end of the page are ignored.
+ *
+ * @param[in] nrp       pointer to the @p nand_ram_t object
+ * @param[in] data      data byte
+ *
+ * @api
+ */
+void nandRamWriteData(nand_ram_t *nrp, uint8_t data) {
+
+  if ((nrp->cmd == CMD_WRITE) && (nrp->col < nrp->config->page_size)) {
+    nrp->cache_reg[nrp->col++] = data;
+    nrp->counters.bytes_in++;
+  }
+}
+
+/**
+ * @brief   Data output cycle.
+ * @details Returns the status after 70h, the ID after 90h and the cache
+ *          register otherwise.
+ *
+ * @param[in] nrp       pointer to the @p nand_ram_t object
+ * @return              The data byte, FFh past the end of the page.
+ *
+ * @api
+ */
+uint8_t nandRamReadData(nand_ram_t *nrp) {
+
+  if (nrp->cmd == CMD_STATUS) {
+    return nrp->status;
+  }
+  if (nrp->cmd == CMD_READID) {
+    return nrp->col < sizeof nrp->config->id ?
+           nrp->config->id[nrp->col++] : 0U;
+  }
+  if (nrp->col >= nrp->config->page_size) {
+    return 0xFFU;
+  }
+  nrp->counters.bytes_out++;
+  return nrp->cache_reg[nrp->col++];
+}
+
+/**
+ * @brief   Direct access to a page of the array, for checks.
+ *
+ * @param[in] nrp       pointer to the @p nand_ram_t object
+ * @param[in] block     block number
+ * @param[in] page      page number in the block
+ * @return              Pointer to the page, @p page_size bytes.
+ *
+ * @api
+ */
+uint8_t *nandRamPage(nand_ram_t *nrp, uint32_t block, uint32_t page) {
+
+  return row_ptr(nrp, block * nrp->config->pages_per_block + page);
+}
+
+/** @} */
@@ -0,0 +1,233 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nand_ram.h
+ * @brief   RAM backed NAND flash model header.
+ * @details Models an 8 bits ONFI-like NAND device at the command, address
+ *          and data cycle level, the same cycles a NAND low level driver
+ *          puts on the bus:
+ *          - page read (00h-30h), cache read (31h, 3Fh) and random data
+ *            output (05h-E0h);
+ *          - page program (80h-10h), cache program (80h-15h);
+ *          - block erase (60h-D0h), status (70h), ID (90h) and reset (FFh).
+ *          .
+ *          The array is erased to FFh and programming clears bits only, as
+ *          on a real device. Operations are counted, so that a driver can be
+ *          checked for the number of array accesses it causes.
+ * @note    This module only depends on the C library, it builds as is on
+ *          a host for testing.
+ *
+ * @addtogroup NAND_RAM
+ * @{
+ */
+
+#ifndef NAND_RAM_H_
+#define NAND_RAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of address cycles.
+ */
+#define NAND_RAM_MAX_ADDR_CYCLES        8U
+
+/**
+ * @brief   No failure injected.
+ */
+#define NAND_RAM_NO_FAIL                0xFFFFFFFFU
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   NAND model configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Number of blocks.
+   */
+  uint32_t              blocks;
+  /**
+   * @brief   Number of pages per block.
+   */
+  uint32_t              pages_per_block;
+  /**
+   * @brief   Page size including the spare area, in bytes.
+   */
+  uint32_t              page_size;
+  /**
+   * @brief   Number of column address cycles.
+   */
+  uint8_t               colcycles;
+  /**
+   * @brief   Number of row address cycles.
+   */
+  uint8_t               rowcycles;
+  /**
+   * @brief   Bytes returned by the read ID command.
+   */
+  uint8_t               id[5];
+} nand_ram_config_t;
+
+/**
+ * @brief   NAND model operation counters.
+ */
+typedef struct {
+  /**
+   * @brief   Pages loaded from the array.
+   */
+  uint32_t              reads;
+  /**
+   * @brief   Cache read commands.
+   */
+  uint32_t              cache_reads;
+  /**
+   * @brief   Pages programmed to the array.
+   */
+  uint32_t              programs;
+  /**
+   * @brief   Cache program commands.
+   */
+  uint32_t              cache_programs;
+  /**
+   * @brief   Blocks erased.
+   */
+  uint32_t              erases;
+  /**
+   * @brief   Data cycles out of the device.
+   */
+  uint32_t              bytes_out;
+  /**
+   * @brief   Data cycles into the device.
+   */
+  uint32_t              bytes_in;
+} nand_ram_counters_t;
+
+/**
+ * @brief   NAND model object.
+ */
+typedef struct {
+  /**
+   * @brief   Current configuration.
+   */
+  const nand_ram_config_t *config;
+  /**
+   * @brief   Memory array, @p blocks times @p pages_per_block pages.
+   */
+  uint8_t               *array;
+  /**
+   * @brief   Data register, between the array and the cache register.
+   */
+  uint8_t               *data_reg;
+  /**
+   * @brief   Cache register, the one seen on the bus.
+   */
+  uint8_t               *cache_reg;
+  /**
+   * @brief   Last command.
+   */
+  uint8_t               cmd;
+  /**
+   * @brief   Address cycles received after the last command.
+   */
+  uint8_t               addr[NAND_RAM_MAX_ADDR_CYCLES];
+  /**
+   * @brief   Number of address cycles received.
+   */
+  size_t                addrcnt;
+  /**
+   * @brief   Bus column pointer.
+   */
+  uint32_t              col;
+  /**
+   * @brief   Row held by the data register.
+   */
+  uint32_t              row;
+  /**
+   * @brief   Status register.
+   */
+  uint8_t               status;
+  /**
+   * @brief   Cache program sequence in progress.
+   */
+  bool                  cache_prog;
+  /**
+   * @brief   Block whose program and erase operations fail, for tests.
+   */
+  uint32_t              fail_block;
+  /**
+   * @brief   Operation counters.
+   */
+  nand_ram_counters_t   counters;
+} nand_ram_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the memory array, in bytes.
+ *
+ * @param[in] cfgp      pointer to a @p nand_ram_config_t structure
+ */
+#define NAND_RAM_ARRAY_SIZE(cfgp)                                           \
+  ((size_t)(cfgp)->blocks * (size_t)(cfgp)->pages_per_block *               \
+   (size_t)(cfgp)->page_size)
+
+/**
+ * @brief   Size of the registers buffer, in bytes.
+ *
+ * @param[in] cfgp      pointer to a @p nand_ram_config_t structure
+ */
+#define NAND_RAM_REGS_SIZE(cfgp)        (2U * (size_t)(cfgp)->page_size)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool nandRamInit(nand_ram_t *nrp, const nand_ram_config_t *config,
+                   uint8_t *array, uint8_t *regs);
+  void nandRamWriteCmd(nand_ram_t *nrp, uint8_t cmd);
+  void nandRamWriteAddr(nand_ram_t *nrp, uint8_t addr);
+  void nandRamWriteData(nand_ram_t *nrp, uint8_t data);
+  uint8_t nandRamReadData(nand_ram_t *nrp);
+  uint8_t *nandRamPage(nand_ram_t *nrp, uint32_t block, uint32_t page);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NAND_RAM_H_ */
+
+/** @} */
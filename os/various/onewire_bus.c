@@ -0,0 +1,515 @@
+/*
+    ChibiOS/RT - Copyright (C) 2014 Uladzimir Pylinsky aka barthess
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    onewire_bus.c
+ * @brief   1-wire multi-device bus manager code.
+ *
+ * @addtogroup onewire_bus
+ * @{
+ */
+
+#include <string.h>
+
+#include "onewire_bus.h"
+
+#if (HAL_USE_ONEWIRE == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Polling period of the end of conversion.
+ */
+#define ONEWIRE_BUS_POLL_PERIOD         OSAL_MS2I(10)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Finds the slot of a ROM, or a slot for a new ROM.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @param[in] rom       ROM code
+ * @param[in] add       if @p true unknown ROMs get a free slot, reusing the
+ *                      ones of devices gone missing when the table is full
+ * @return              Pointer to the slot, @p NULL if not found or full.
+ */
+static onewire_bus_device_t *find_slot(onewireBus *busp, const uint8_t *rom,
+                                       bool add) {
+  const onewireBusConfig *cfg = busp->config;
+  onewire_bus_device_t *freep = NULL, *stalep = NULL;
+  size_t i;
+
+  for (i = 0; i < cfg->max_devices; i++) {
+    onewire_bus_device_t *devp = &cfg->devices[i];
+
+    if (0 == (devp->flags & ONEWIRE_BUS_USED)) {
+      if (NULL == freep)
+        freep = devp;
+    }
+    else if (0 == memcmp(devp->rom, rom, 8)) {
+      return devp;
+    }
+    else if ((0 == (devp->flags & ONEWIRE_BUS_PRESENT)) && (NULL == stalep)) {
+      stalep = devp;
+    }
+  }
+
+  if (!add)
+    return NULL;
+  if (NULL == freep)
+    freep = stalep;
+  if (NULL != freep) {
+    memcpy(freep->rom, rom, 8);
+    freep->flags = ONEWIRE_BUS_USED;
+    freep->errors = 0;
+  }
+  return freep;
+}
+
+/**
+ * @brief   Counts the devices having the specified flag set.
+ */
+static size_t count_flag(onewireBus *busp, uint8_t flag) {
+  const onewireBusConfig *cfg = busp->config;
+  size_t i, n = 0;
+
+  for (i = 0; i < cfg->max_devices; i++) {
+    if (cfg->devices[i].flags & flag)
+      n++;
+  }
+  return n;
+}
+
+/**
+ * @brief   Marks a device found without a full search as present.
+ * @details Skip ROM is no longer safe, the bus holds more devices than the
+ *          last search found.
+ */
+static void revalidate(onewireBus *busp, onewire_bus_device_t *devp) {
+
+  devp->flags |= ONEWIRE_BUS_PRESENT;
+  devp->errors = 0;
+  busp->single = false;
+}
+
+/**
+ * @brief   Reads the scratchpad of a device and checks its CRC.
+ * @details The device found by a search that found nothing else is
+ *          addressed with Skip ROM, saving the 64 timeslots of its ROM
+ *          code. A cached device that is not known to be alone on the bus
+ *          may share it with devices not in the cache, it is always
+ *          addressed with Match ROM.
+ */
+static bool read_scratchpad(onewireBus *busp, onewire_bus_device_t *devp) {
+  onewireDriver *owp = busp->config->owp;
+  uint8_t *sp = devp->scratchpad;
+  uint8_t tx[10];
+  size_t n;
+
+  if (busp->single && (devp->flags & ONEWIRE_BUS_PRESENT)) {
+    tx[0] = ONEWIRE_CMD_SKIP_ROM;
+    n = 1;
+  }
+  else {
+    tx[0] = ONEWIRE_CMD_MATCH_ROM;
+    memcpy(&tx[1], devp->rom, 8);
+    n = 9;
+  }
+  tx[n++] = ONEWIRE_CMD_READ_SCRATCHPAD;
+
+  if (false == onewireReset(owp))
+    return false;
+  onewireWrite(owp, tx, n, 0);
+  onewireRead(owp, sp, ONEWIRE_BUS_SCRATCHPAD_SIZE);
+
+  /* A bus stuck low reads as zeros, which pass the CRC check.*/
+  if ((0 == sp[0]) &&
+      (0 == memcmp(sp, sp + 1, ONEWIRE_BUS_SCRATCHPAD_SIZE - 1)))
+    return false;
+  return sp[ONEWIRE_BUS_SCRATCHPAD_SIZE - 1] ==
+         onewireCRC(sp, ONEWIRE_BUS_SCRATCHPAD_SIZE - 1);
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the @p onewireBus object.
+ * @details All the device slots are cleared, the bus is scanned on the
+ *          first poll.
+ *
+ * @param[out] busp     pointer to the @p onewireBus object
+ * @param[in] config    pointer to the @p onewireBusConfig object
+ *
+ * @init
+ */
+void onewireBusObjectInit(onewireBus *busp, const onewireBusConfig *config) {
+
+  osalDbgCheck((NULL != busp) && (NULL != config));
+  osalDbgCheck((NULL != config->owp) && (NULL != config->devices) &&
+               (NULL != config->searchbuf));
+  osalDbgCheck((config->max_devices > 0) && (config->max_devices <= 256));
+
+  busp->config = config;
+  busp->present = 0;
+  busp->overdrive = false;
+  busp->single = false;
+  busp->rescan = true;
+  busp->polls = 0;
+  memset(config->devices, 0,
+         config->max_devices * sizeof(onewire_bus_device_t));
+}
+
+/**
+ * @brief   Scans the bus and updates the device cache.
+ * @details Known devices keep their slot, new devices get a free slot and
+ *          the slots of missing devices are reused only when the table is
+ *          full.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @return              Number of present devices.
+ *
+ * @api
+ */
+size_t onewireBusScan(onewireBus *busp) {
+  const onewireBusConfig *cfg;
+  size_t i, n;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+  n = onewireSearchRom(cfg->owp, cfg->searchbuf, cfg->max_devices);
+  busp->single = (1U == n);
+  if (n > cfg->max_devices)
+    n = cfg->max_devices;
+
+  for (i = 0; i < cfg->max_devices; i++)
+    cfg->devices[i].flags &= ~ONEWIRE_BUS_PRESENT;
+
+  for (i = 0; i < n; i++) {
+    onewire_bus_device_t *devp = find_slot(busp, &cfg->searchbuf[8 * i],
+                                           true);
+    if (NULL != devp) {
+      devp->flags |= ONEWIRE_BUS_PRESENT;
+      devp->errors = 0;
+    }
+  }
+
+  busp->present = count_flag(busp, ONEWIRE_BUS_PRESENT);
+  busp->rescan = false;
+  busp->polls = 0;
+  return busp->present;
+}
+
+/**
+ * @brief   Performs an alarm search.
+ * @details Sets @p ONEWIRE_BUS_ALARM on the devices answering to the
+ *          conditional search, and clears it on the other ones. Devices
+ *          answering are present: unknown ones are added to the cache and
+ *          missing ones are marked present again, without a full search.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @return              Number of devices in alarm.
+ *
+ * @api
+ */
+size_t onewireBusAlarmScan(onewireBus *busp) {
+  const onewireBusConfig *cfg;
+  size_t i, n;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+  n = onewireSearchAlarm(cfg->owp, cfg->searchbuf, cfg->max_devices);
+  if (n > cfg->max_devices)
+    n = cfg->max_devices;
+
+  for (i = 0; i < cfg->max_devices; i++)
+    cfg->devices[i].flags &= ~ONEWIRE_BUS_ALARM;
+
+  for (i = 0; i < n; i++) {
+    onewire_bus_device_t *devp = find_slot(busp, &cfg->searchbuf[8 * i],
+                                           true);
+    if (NULL != devp) {
+      if (0 == (devp->flags & ONEWIRE_BUS_PRESENT))
+        revalidate(busp, devp);
+      devp->flags |= ONEWIRE_BUS_ALARM;
+    }
+  }
+
+  busp->present = count_flag(busp, ONEWIRE_BUS_PRESENT);
+  return n;
+}
+
+/**
+ * @brief   Switches the bus to overdrive or back to standard speed.
+ * @details Overdrive is entered with an Overdrive Skip ROM, then the bus is
+ *          searched again at overdrive speed: if any present device does not
+ *          answer, it does not support overdrive and the whole bus goes
+ *          back to standard speed.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @param[in] enable    @p true for overdrive, @p false for standard speed
+ * @return              Overdrive state after the call.
+ *
+ * @api
+ */
+bool onewireBusSetOverdrive(onewireBus *busp, bool enable) {
+  const onewireBusConfig *cfg;
+  uint8_t cmd = ONEWIRE_CMD_OVERDRIVE_SKIP_ROM;
+  size_t i, n;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+
+  /* A standard speed reset takes every device back to standard speed.*/
+  onewireSetOverdrive(cfg->owp, false);
+  busp->overdrive = false;
+  if (false == onewireReset(cfg->owp))
+    return false;
+  if (!enable || (0 == busp->present))
+    return false;
+
+  onewireWrite(cfg->owp, &cmd, 1, 0);
+  if (false == onewireSetOverdrive(cfg->owp, true)) {
+    (void)onewireReset(cfg->owp);
+    return false;
+  }
+
+  n = onewireSearchRom(cfg->owp, cfg->searchbuf, cfg->max_devices);
+  if (n == busp->present) {
+    for (i = 0; i < n; i++) {
+      onewire_bus_device_t *devp = find_slot(busp, &cfg->searchbuf[8 * i],
+                                             false);
+      if ((NULL == devp) || (0 == (devp->flags & ONEWIRE_BUS_PRESENT)))
+        break;
+    }
+    if (i == n) {
+      busp->overdrive = true;
+      return true;
+    }
+  }
+
+  onewireSetOverdrive(cfg->owp, false);
+  (void)onewireReset(cfg->owp);
+  return false;
+}
+
+/**
+ * @brief   Starts a temperature conversion on all the devices at once.
+ * @details Returns when the conversion is over: after @p convert_time with
+ *          parasite power, or as soon as every device releases the bus
+ *          otherwise.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @return              Conversion result.
+ * @retval true         Conversion done.
+ * @retval false        No presence pulse or conversion timed out.
+ *
+ * @api
+ */
+bool onewireBusConvert(onewireBus *busp) {
+  const onewireBusConfig *cfg;
+  uint8_t buf[2];
+  systime_t waited;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+  buf[0] = ONEWIRE_CMD_SKIP_ROM;
+  buf[1] = ONEWIRE_CMD_CONVERT_TEMP;
+
+  if (false == onewireReset(cfg->owp))
+    return false;
+
+  if (cfg->parasite) {
+#if ONEWIRE_USE_STRONG_PULLUP
+    onewireWrite(cfg->owp, buf, 2, cfg->convert_time);
+#else
+    onewireWrite(cfg->owp, buf, 2, 0);
+    osalThreadSleep(cfg->convert_time);
+#endif
+    return true;
+  }
+
+  /* Devices answer read slots with zeros until their conversion is over.*/
+  onewireWrite(cfg->owp, buf, 2, 0);
+  for (waited = 0; waited < cfg->convert_time;
+       waited += ONEWIRE_BUS_POLL_PERIOD) {
+    osalThreadSleep(ONEWIRE_BUS_POLL_PERIOD);
+    onewireRead(cfg->owp, buf, 1);
+    if (0xFF == buf[0])
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief   Reads the scratchpad of every cached device.
+ * @details Devices failing @p max_errors consecutive reads are marked as
+ *          missing. Missing devices are read too, at standard speed only,
+ *          and are marked present again as soon as a read succeeds.
+ * @note    In overdrive a missing device may have been reset to standard
+ *          speed, e.g. by a brown-out, and cannot answer: a full search at
+ *          standard speed is requested instead.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @return              Number of scratchpads read successfully.
+ *
+ * @api
+ */
+size_t onewireBusReadAll(onewireBus *busp) {
+  const onewireBusConfig *cfg;
+  size_t i, n = 0;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+  for (i = 0; i < cfg->max_devices; i++) {
+    onewire_bus_device_t *devp = &cfg->devices[i];
+
+    if (0 == (devp->flags & ONEWIRE_BUS_USED))
+      continue;
+
+    if (0 == (devp->flags & ONEWIRE_BUS_PRESENT)) {
+      if (busp->overdrive || !read_scratchpad(busp, devp))
+        continue;
+      revalidate(busp, devp);
+      devp->flags |= ONEWIRE_BUS_VALID;
+      n++;
+    }
+    else if (read_scratchpad(busp, devp)) {
+      devp->flags |= ONEWIRE_BUS_VALID;
+      devp->errors = 0;
+      n++;
+    }
+    else {
+      devp->flags &= ~ONEWIRE_BUS_VALID;
+      if (++devp->errors >= cfg->max_errors) {
+        devp->flags &= ~ONEWIRE_BUS_PRESENT;
+        if (busp->overdrive)
+          busp->rescan = true;
+      }
+    }
+  }
+
+  busp->present = count_flag(busp, ONEWIRE_BUS_PRESENT);
+  return n;
+}
+
+/**
+ * @brief   Polls the whole bus.
+ * @details Searches the bus if needed or every @p scan_interval polls,
+ *          keeping overdrive if it was active, then converts and reads all
+ *          the cached devices.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ * @return              Number of scratchpads read successfully.
+ *
+ * @api
+ */
+size_t onewireBusPoll(onewireBus *busp) {
+  const onewireBusConfig *cfg;
+
+  osalDbgCheck(NULL != busp);
+
+  cfg = busp->config;
+  if (busp->rescan ||
+      ((cfg->scan_interval > 0U) && (busp->polls >= cfg->scan_interval))) {
+    bool overdrive = busp->overdrive;
+
+    /* Devices may have been reset to standard speed, e.g. by a brown-out,
+       scan at standard speed.*/
+    onewireBusSetOverdrive(busp, false);
+    onewireBusScan(busp);
+    if (overdrive)
+      onewireBusSetOverdrive(busp, true);
+  }
+
+  busp->polls++;
+
+  if (0 == count_flag(busp, ONEWIRE_BUS_USED))
+    return 0;
+
+  if (false == onewireBusConvert(busp)) {
+    busp->rescan = true;
+    return 0;
+  }
+  return onewireBusReadAll(busp);
+}
+
+/**
+ * @brief   Decodes the temperature of a DS18x20 scratchpad.
+ *
+ * @param[in] devp          pointer to the @p onewire_bus_device_t object
+ * @param[out] millicelsius temperature, in thousandths of degree Celsius
+ * @return                  Decoding result.
+ * @retval true             Temperature decoded.
+ * @retval false            No valid scratchpad or unknown family.
+ *
+ * @api
+ */
+bool onewireBusGetTemperature(const onewire_bus_device_t *devp,
+                              int32_t *millicelsius) {
+  const uint8_t *sp;
+  int32_t raw;
+
+  osalDbgCheck((NULL != devp) && (NULL != millicelsius));
+
+  if (0 == (devp->flags & ONEWIRE_BUS_VALID))
+    return false;
+
+  sp = devp->scratchpad;
+  raw = (int16_t)((sp[1] << 8) | sp[0]);
+
+  switch (devp->rom[0]) {
+  case ONEWIRE_FAMILY_DS18B20:
+  case ONEWIRE_FAMILY_DS1822:
+    /* Undefined low bits at resolutions below 12 bits.*/
+    raw &= ~((1 << (3 - ((sp[4] >> 5) & 3))) - 1);
+    *millicelsius = (raw * 1000) / 16;
+    return true;
+
+  case ONEWIRE_FAMILY_DS18S20:
+    /* Extended resolution from the count remain register.*/
+    if (0 == sp[7])
+      return false;
+    *millicelsius = ((raw >> 1) * 1000) - 250 +
+                    (((int32_t)sp[7] - sp[6]) * 1000) / sp[7];
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+#endif /* HAL_USE_ONEWIRE */
+
+/** @} */
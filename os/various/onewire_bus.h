@@ -0,0 +1,235 @@
+/*
+    ChibiOS/RT - Copyright (C) 2014 Uladzimir Pylinsky aka barthess
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    onewire_bus.h
+ * @brief   1-wire multi-device bus manager header.
+ * @details Keeps a cache of the devices discovered on a 1-wire bus, with
+ *          stable slot indexes, and polls them with as few timeslots as
+ *          possible:
+ *          - one Skip ROM conversion for all the devices at once;
+ *          - one Match ROM + Read Scratchpad write and one scratchpad read
+ *            per device, or Skip ROM when the last search found a single
+ *            device on the bus;
+ *          - scratchpads checked with @p onewireCRC();
+ *          - overdrive timing when every device on the bus supports it.
+ *
+ *          The cache is revalidated incrementally, without searching the
+ *          whole bus:
+ *          - devices failing repeatedly are marked as missing, and tried
+ *            again with a single Match ROM read on each poll, so a device
+ *            coming back keeps its slot without a search;
+ *          - unknown devices answering an alarm search are added from the
+ *            search result.
+ *
+ *          A full search, costing about 200 timeslots per device, is only
+ *          done on the first poll, after a conversion got no presence pulse,
+ *          when a device is lost in overdrive, and every @p scan_interval
+ *          polls.
+ * @note    A device attached to the bus that never raises an alarm is only
+ *          discovered by a full search: with @p scan_interval set to zero,
+ *          the application must call @p onewireBusScan() to find it.
+ *
+ * @addtogroup onewire_bus
+ * @{
+ */
+
+#ifndef ONEWIRE_BUS_H_
+#define ONEWIRE_BUS_H_
+
+#include "hal.h"
+
+#if (HAL_USE_ONEWIRE == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Device flags
+ * @{
+ */
+/** Slot holds a known ROM.*/
+#define ONEWIRE_BUS_USED                0x01U
+/** Device answered the last scan or read.*/
+#define ONEWIRE_BUS_PRESENT             0x02U
+/** Scratchpad passed the CRC check.*/
+#define ONEWIRE_BUS_VALID               0x04U
+/** Device answered the last alarm search.*/
+#define ONEWIRE_BUS_ALARM               0x08U
+/** @} */
+
+/**
+ * @brief   Scratchpad size of DS18x20 and similar devices, in bytes.
+ */
+#define ONEWIRE_BUS_SCRATCHPAD_SIZE     9U
+
+/**
+ * @name    Family codes
+ * @{
+ */
+#define ONEWIRE_FAMILY_DS18S20          0x10U
+#define ONEWIRE_FAMILY_DS1822           0x22U
+#define ONEWIRE_FAMILY_DS18B20          0x28U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !ONEWIRE_USE_SEARCH_ROM
+#error "1-wire bus manager requires ONEWIRE_USE_SEARCH_ROM"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Cached device.
+ */
+typedef struct {
+  /**
+   * @brief   ROM code, family code first.
+   */
+  uint8_t               rom[8];
+  /**
+   * @brief   Last scratchpad read.
+   */
+  uint8_t               scratchpad[ONEWIRE_BUS_SCRATCHPAD_SIZE];
+  /**
+   * @brief   Device flags, @p ONEWIRE_BUS_xxx.
+   */
+  uint8_t               flags;
+  /**
+   * @brief   Consecutive failed reads.
+   */
+  uint8_t               errors;
+} onewire_bus_device_t;
+
+/**
+ * @brief   Bus manager configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the underlying 1-wire driver, already started.
+   */
+  onewireDriver         *owp;
+  /**
+   * @brief   Device slots.
+   */
+  onewire_bus_device_t  *devices;
+  /**
+   * @brief   Number of device slots.
+   */
+  size_t                max_devices;
+  /**
+   * @brief   Search result buffer, 8 bytes per device slot.
+   */
+  uint8_t               *searchbuf;
+  /**
+   * @brief   Conversion time.
+   * @details With parasite power, the strong pull up time. Otherwise, the
+   *          maximum time to wait for the devices to signal the end of the
+   *          conversion.
+   */
+  systime_t             convert_time;
+  /**
+   * @brief   Bool flag. If @p true devices are parasite powered.
+   */
+  bool                  parasite;
+  /**
+   * @brief   Consecutive failed reads before a device is considered gone.
+   */
+  uint8_t               max_errors;
+  /**
+   * @brief   Full search period, in polls, zero for never.
+   */
+  uint16_t              scan_interval;
+} onewireBusConfig;
+
+/**
+ * @brief   Bus manager object.
+ */
+typedef struct {
+  /**
+   * @brief   Current configuration.
+   */
+  const onewireBusConfig  *config;
+  /**
+   * @brief   Number of present devices.
+   */
+  size_t                present;
+  /**
+   * @brief   Bool flag. If @p true devices are in overdrive.
+   */
+  bool                  overdrive;
+  /**
+   * @brief   Bool flag. If @p true the last search found exactly one
+   *          device and no other device showed up since, so Skip ROM
+   *          addresses that device only.
+   */
+  bool                  single;
+  /**
+   * @brief   Bool flag. If @p true a full search is needed.
+   */
+  bool                  rescan;
+  /**
+   * @brief   Polls since the last full search.
+   */
+  uint16_t              polls;
+} onewireBus;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Bool flag. If @p true the bus needs a full search.
+ *
+ * @param[in] busp      pointer to the @p onewireBus object
+ */
+#define onewireBusNeedsScan(busp) ((busp)->rescan)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void onewireBusObjectInit(onewireBus *busp, const onewireBusConfig *config);
+  size_t onewireBusScan(onewireBus *busp);
+  size_t onewireBusAlarmScan(onewireBus *busp);
+  bool onewireBusSetOverdrive(onewireBus *busp, bool enable);
+  bool onewireBusConvert(onewireBus *busp);
+  size_t onewireBusReadAll(onewireBus *busp);
+  size_t onewireBusPoll(onewireBus *busp);
+  bool onewireBusGetTemperature(const onewire_bus_device_t *devp,
+                                int32_t *millicelsius);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_ONEWIRE */
+
+#endif /* ONEWIRE_BUS_H_ */
+
+/** @} */
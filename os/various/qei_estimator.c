@@ -0,0 +1,262 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Martino Migliavacca
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    qei_estimator.c
+ * @brief   QEI velocity and acceleration estimator code.
+ *
+ * @addtogroup qei_estimator
+ * @{
+ */
+
+#include "qei_estimator.h"
+
+#if (HAL_USE_QEI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static int32_t sat32(int64_t x) {
+
+  if (x > INT32_MAX) {
+    return INT32_MAX;
+  }
+  if (x < INT32_MIN) {
+    return INT32_MIN;
+  }
+  return (int32_t)x;
+}
+
+/**
+ * @brief   Computes <tt>x * mul / div</tt> without intermediate overflows.
+ * @details Rounds toward zero, saturates on overflow.
+ */
+static int64_t muldiv(int64_t x, uint32_t mul, uint32_t div) {
+  bool neg = x < 0;
+  uint64_t ux = neg ? (uint64_t)0 - (uint64_t)x : (uint64_t)x;
+  uint64_t q = ux / div, r = ux % div;
+  int64_t res;
+
+  if (q > ((uint64_t)INT64_MAX / 2U) / mul) {
+    res = INT64_MAX / 2;
+  }
+  else {
+    res = (int64_t)((q * mul) + ((r * mul) / div));
+  }
+  return neg ? -res : res;
+}
+
+/**
+ * @brief   Velocity of @p counts over @p ticks, with fractional bits.
+ */
+static int32_t rate(const qeiEstimator *esp, int32_t counts, uint32_t ticks) {
+
+  return sat32(muldiv((int64_t)counts << QEI_EST_VELOCITY_SHIFT,
+                      esp->config->frequency, ticks));
+}
+
+/**
+ * @brief   Measures the velocity of the last sampling interval.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ * @param[in] sp        pointer to the sample
+ * @param[in] delta     counts since the previous sample
+ * @param[in] dt        ticks since the previous sample
+ * @return              The measured velocity.
+ */
+static int32_t measure(qeiEstimator *esp, const qei_est_sample_t *sp,
+                       int32_t delta, uint32_t dt) {
+  const qeiEstimatorConfig *cfgp = esp->config;
+  uint32_t since, ticks;
+  int32_t bound;
+
+  if (delta != 0) {
+    int8_t dir = delta > 0 ? 1 : -1;
+
+    /* Whole edge periods at low speed, the sampling interval otherwise.*/
+    ticks = dt;
+    if ((dir == esp->direction) &&
+        ((uint32_t)(delta * dir) < cfgp->mt_max_counts)) {
+      uint32_t dte = sp->edge_time - esp->last_edge;
+      if (dte != 0U) {
+        ticks = dte;
+      }
+    }
+    esp->direction = dir;
+    esp->last_edge = sp->edge_time;
+    return rate(esp, delta, ticks);
+  }
+
+  /* No edges, the speed is at most one count over the time elapsed since
+     the last edge.*/
+  since = sp->time - esp->last_edge;
+  if (since >= cfgp->timeout) {
+    return 0;
+  }
+  if (since == 0U) {
+    return esp->measured;
+  }
+  bound = rate(esp, 1, since);
+  if (esp->measured > bound) {
+    return bound;
+  }
+  if (esp->measured < -bound) {
+    return -bound;
+  }
+  return esp->measured;
+}
+
+/**
+ * @brief   Feeds one sample to the estimator.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ * @param[in] sp        pointer to the sample
+ */
+static void update(qeiEstimator *esp, const qei_est_sample_t *sp) {
+  const qeiEstimatorConfig *cfgp = esp->config;
+  uint32_t dt;
+  int32_t delta;
+  int64_t predicted, residual;
+
+  if (!esp->primed) {
+    esp->last_count = sp->count;
+    esp->last_time  = sp->time;
+    esp->last_edge  = sp->edge_time;
+    esp->primed     = true;
+    return;
+  }
+
+  dt = sp->time - esp->last_time;
+  if (dt == 0U) {
+    return;
+  }
+  delta = (qeidelta_t)(qeicnt_t)(sp->count - esp->last_count);
+  esp->position  += delta;
+  esp->last_count = sp->count;
+  esp->last_time  = sp->time;
+  esp->measured   = measure(esp, sp, delta, dt);
+
+  /* Too long since the previous sample, the tracker restarts from the
+     measure.*/
+  if (dt > cfgp->timeout) {
+    esp->velocity     = esp->measured;
+    esp->acceleration = 0;
+    return;
+  }
+
+  /* Alpha-beta tracker, the measured state is the velocity.*/
+  predicted = (int64_t)esp->velocity +
+              muldiv((int64_t)esp->acceleration * dt,
+                     1UL << QEI_EST_VELOCITY_SHIFT, cfgp->frequency);
+  residual = (int64_t)esp->measured - predicted;
+  esp->velocity = sat32(predicted +
+                        (((int64_t)cfgp->alpha * residual) >>
+                         QEI_EST_GAIN_SHIFT));
+  esp->acceleration = sat32((int64_t)esp->acceleration +
+                            (muldiv(((int64_t)cfgp->beta * residual) >>
+                                    QEI_EST_GAIN_SHIFT,
+                                    cfgp->frequency, dt) >>
+                             QEI_EST_VELOCITY_SHIFT));
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an estimator object.
+ *
+ * @param[out] esp      pointer to the @p qeiEstimator object
+ * @param[in] config    pointer to the @p qeiEstimatorConfig object
+ *
+ * @init
+ */
+void qeiEstimatorObjectInit(qeiEstimator *esp,
+                            const qeiEstimatorConfig *config) {
+
+  osalDbgCheck((esp != NULL) && (config != NULL));
+  osalDbgCheck((config->frequency > 0U) && (config->timeout > 0U));
+  osalDbgCheck((config->alpha <= QEI_EST_GAIN_ONE) &&
+               (config->beta <= QEI_EST_GAIN_ONE));
+
+  esp->config = config;
+  qeiEstimatorReset(esp);
+}
+
+/**
+ * @brief   Restarts the estimation.
+ * @details The next sample only sets the starting point, the position is
+ *          reset to zero.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ *
+ * @api
+ */
+void qeiEstimatorReset(qeiEstimator *esp) {
+
+  osalDbgCheck(esp != NULL);
+
+  esp->position     = 0;
+  esp->velocity     = 0;
+  esp->acceleration = 0;
+  esp->measured     = 0;
+  esp->last_count   = 0;
+  esp->last_time    = 0U;
+  esp->last_edge    = 0U;
+  esp->direction    = 0;
+  esp->primed       = false;
+}
+
+/**
+ * @brief   Updates the estimation.
+ * @details Meant to be called once per control cycle with the samples
+ *          taken since the previous call, e.g. collected at a higher rate
+ *          by an interrupt handler.
+ * @note    Samples must be in time order. Samples with the same time as
+ *          the previous one are ignored.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ * @param[in] sp        pointer to the samples
+ * @param[in] n         number of samples
+ *
+ * @api
+ */
+void qeiEstimatorUpdate(qeiEstimator *esp, const qei_est_sample_t *sp,
+                        size_t n) {
+
+  osalDbgCheck((esp != NULL) && ((n == 0U) || (sp != NULL)));
+
+  while (n-- > 0U) {
+    update(esp, sp++);
+  }
+}
+
+#endif /* HAL_USE_QEI == TRUE */
+
+/** @} */
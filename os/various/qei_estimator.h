@@ -0,0 +1,225 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Martino Migliavacca
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    qei_estimator.h
+ * @brief   QEI velocity and acceleration estimator header.
+ * @details Turns the QEI counter, sampled together with the time of the
+ *          last counted edge, into speed and acceleration:
+ *          - at low speed the speed is measured over whole edge periods
+ *            (M/T method), and bounded by the time elapsed since the last
+ *            edge when the encoder stops. Edge periods spanning a direction
+ *            reversal are not used, e.g. an encoder vibrating on an edge;
+ *          - at high speed, or without edge timestamps, the speed is the
+ *            count difference over the sampling interval;
+ *          - the measured speed is smoothed by a fixed point alpha-beta
+ *            tracker, which also estimates the acceleration.
+ *          .
+ *          Edge timestamps are not provided by the QEI drivers, they can
+ *          come from an input capture on one of the encoder channels. Any
+ *          free running 32 bit time base can be used, e.g. a timer or the
+ *          cycle counter.
+ *
+ * @addtogroup qei_estimator
+ * @{
+ */
+
+#ifndef QEI_ESTIMATOR_H_
+#define QEI_ESTIMATOR_H_
+
+#include "hal.h"
+
+#if (HAL_USE_QEI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Fractional bits of the velocity, in counts per second.
+ */
+#define QEI_EST_VELOCITY_SHIFT          8U
+
+/**
+ * @brief   Fractional bits of the tracker gains.
+ */
+#define QEI_EST_GAIN_SHIFT              16U
+
+/**
+ * @brief   Gain of 1.0.
+ */
+#define QEI_EST_GAIN_ONE                (1UL << QEI_EST_GAIN_SHIFT)
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Encoder sample.
+ */
+typedef struct {
+  /**
+   * @brief   Counter value, as returned by @p qeiGetCountI().
+   */
+  qeicnt_t              count;
+  /**
+   * @brief   Sampling time, in time base ticks.
+   */
+  uint32_t              time;
+  /**
+   * @brief   Time of the last counted edge, in time base ticks.
+   * @note    Set it to @p time when edge timestamps are not available.
+   */
+  uint32_t              edge_time;
+} qei_est_sample_t;
+
+/**
+ * @brief   Estimator configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Time base frequency, in Hz.
+   */
+  uint32_t              frequency;
+  /**
+   * @brief   Velocity gain of the tracker, 1.0 is @p QEI_EST_GAIN_ONE.
+   * @details The tracked state is the velocity, this gain corrects the
+   *          predicted velocity with the measured one.
+   */
+  uint32_t              alpha;
+  /**
+   * @brief   Acceleration gain of the tracker, 1.0 is @p QEI_EST_GAIN_ONE.
+   * @note    <tt>beta = alpha * alpha / (2 - alpha)</tt> gives a critically
+   *          damped tracker.
+   */
+  uint32_t              beta;
+  /**
+   * @brief   Time without edges after which the encoder is stopped, in
+   *          time base ticks.
+   * @note    Sampling intervals longer than this restart the tracker.
+   */
+  uint32_t              timeout;
+  /**
+   * @brief   Counts per sample from which the edge timestamps are ignored.
+   * @details Above it the count difference over the sampling interval is
+   *          accurate enough, and the edge capture may be overrun.
+   */
+  uint32_t              mt_max_counts;
+} qeiEstimatorConfig;
+
+/**
+ * @brief   Estimator object.
+ */
+typedef struct {
+  /**
+   * @brief   Current configuration.
+   */
+  const qeiEstimatorConfig *config;
+  /**
+   * @brief   Position, in counts, not wrapping with the counter.
+   */
+  int32_t               position;
+  /**
+   * @brief   Estimated velocity, in counts per second.
+   * @note    With @p QEI_EST_VELOCITY_SHIFT fractional bits.
+   */
+  int32_t               velocity;
+  /**
+   * @brief   Estimated acceleration, in counts per second squared.
+   */
+  int32_t               acceleration;
+  /**
+   * @brief   Last measured velocity.
+   * @note    With @p QEI_EST_VELOCITY_SHIFT fractional bits.
+   */
+  int32_t               measured;
+  /**
+   * @brief   Previous counter value.
+   */
+  qeicnt_t              last_count;
+  /**
+   * @brief   Previous sampling time.
+   */
+  uint32_t              last_time;
+  /**
+   * @brief   Time of the last counted edge.
+   */
+  uint32_t              last_edge;
+  /**
+   * @brief   Direction of the last counted edges, 1 or -1, 0 if unknown.
+   */
+  int8_t                direction;
+  /**
+   * @brief   Bool flag. If @p true a first sample has been fed.
+   */
+  bool                  primed;
+} qeiEstimator;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Estimated velocity, in counts per second.
+ * @note    With @p QEI_EST_VELOCITY_SHIFT fractional bits.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ */
+#define qeiEstimatorGetVelocity(esp) ((esp)->velocity)
+
+/**
+ * @brief   Estimated acceleration, in counts per second squared.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ */
+#define qeiEstimatorGetAcceleration(esp) ((esp)->acceleration)
+
+/**
+ * @brief   Position, in counts.
+ *
+ * @param[in] esp       pointer to the @p qeiEstimator object
+ */
+#define qeiEstimatorGetPosition(esp) ((esp)->position)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void qeiEstimatorObjectInit(qeiEstimator *esp,
+                              const qeiEstimatorConfig *config);
+  void qeiEstimatorReset(qeiEstimator *esp);
+  void qeiEstimatorUpdate(qeiEstimator *esp, const qei_est_sample_t *sp,
+                          size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_QEI */
+
+#endif /* QEI_ESTIMATOR_H_ */
+
+/** @} */
@@ -198,6 +198,32 @@ void ramdiskStart(RamDisk *rdp, uint8_t *storage, uint32_t blksize,
   osalSysUnlock();
 }
 
+/**
+ * @brief   Maps a span of blocks to the RAM disk storage.
+ * @details Matches the SCSI target @p scsi_blk_map_t call, so that reads
+ *          are transmitted straight from the storage array.
+ *
+ * @param[in] instance  pointer to @p RamDisk object
+ * @param[in] startblk  first block
+ * @param[in] n         number of blocks
+ * @return              Pointer to the first block in the storage array or
+ *                      @p NULL if the disk is not ready or the span
+ *                      overflows it.
+ *
+ * @api
+ */
+const uint8_t *ramdiskMap(void *instance, uint32_t startblk, uint32_t n) {
+
+  RamDisk *rd = instance;
+
+  if ((BLK_READY != rd->state) || overflow(rd, startblk, n)) {
+    return NULL;
+  }
+  else {
+    return &rd->storage[startblk * rd->blk_size];
+  }
+}
+
 /**
  * @brief   Stops RAM disk.
  *
@@ -77,6 +77,7 @@ extern "C" {
   void ramdiskStart(RamDisk *rdp, uint8_t *storage, uint32_t blksize,
                     uint32_t blknum, bool readonly);
   void ramdiskStop(RamDisk *rdp);
+  const uint8_t *ramdiskMap(void *instance, uint32_t startblk, uint32_t n);
 #ifdef __cplusplus
 }
 #endif
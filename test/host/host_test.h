@@ -0,0 +1,92 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    host_test.h
+ * @brief   Checks and timing helpers of the host tests.
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief   Number of failed checks.
+ */
+static unsigned test_failures;
+
+/**
+ * @brief   Checks a condition, reports it and goes on if false.
+ */
+#define CHECK(c) do {                                                       \
+  if (!(c)) {                                                               \
+    printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #c);            \
+    test_failures++;                                                        \
+  }                                                                         \
+} while (0)
+
+/**
+ * @brief   Checks a condition, reports it with a formatted message.
+ */
+#define CHECKF(c, ...) do {                                                 \
+  if (!(c)) {                                                               \
+    printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #c);            \
+    printf(__VA_ARGS__);                                                    \
+    printf("\n");                                                           \
+    test_failures++;                                                        \
+  }                                                                         \
+} while (0)
+
+/**
+ * @brief   Ends a test program, the exit status is the check result.
+ */
+#define TEST_END() do {                                                     \
+  printf("%s: %u failed checks\n", __FILE__, test_failures);                \
+  return test_failures == 0U ? EXIT_SUCCESS : EXIT_FAILURE;                 \
+} while (0)
+
+/**
+ * @brief   Keeps the compiler from optimizing away a benchmark result.
+ */
+#define BENCH_KEEP(p)   __asm__ volatile ("" : : "r"(p) : "memory")
+
+/**
+ * @brief   Monotonic time, in seconds.
+ */
+static inline double bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief   Deterministic pseudo random numbers for test data.
+ */
+static inline unsigned test_rand(void) {
+  static unsigned long long x = 0x9E3779B97F4A7C15ULL;
+
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return (unsigned)(x >> 32);
+}
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,117 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stubs/ch.h
+ * @brief   Minimal RT definitions for the host tests.
+ * @details Threads are run to completion by the test: a thread runs until
+ *          it waits for events that are not pending, then the waiting
+ *          function returns to the test, which restarts the thread function
+ *          when new events are signaled. This is enough for event driven
+ *          threads that keep their state outside of the stack.
+ *          System time is virtual, one tick per millisecond, and only
+ *          advances when the test says so.
+ */
+
+#ifndef CH_H_
+#define CH_H_
+
+#include "hal.h"
+
+typedef uint32_t eventmask_t;
+typedef uint32_t eventflags_t;
+typedef uint32_t tprio_t;
+typedef void (*tfunc_t)(void *p);
+
+#define CH_CFG_USE_OBJ_FIFOS    TRUE
+#define CH_CFG_ST_FREQUENCY     1000U
+
+#define NORMALPRIO              128U
+#define ALL_EVENTS              ((eventmask_t)-1)
+#define EVENT_MASK(eid)         ((eventmask_t)1 << (eventmask_t)(eid))
+
+#define THD_WORKING_AREA(s, n)  uint8_t s[n]
+#define THD_FUNCTION(tname, arg) void tname(void *arg)
+
+typedef struct {
+  tfunc_t               func;
+  void                  *arg;
+  eventmask_t           epending;
+  bool                  terminate;
+  bool                  done;
+} thread_t;
+
+typedef struct {
+  int32_t               cnt;
+} semaphore_t;
+
+typedef struct {
+  eventflags_t          flags;
+} event_source_t;
+
+typedef struct {
+  size_t                objsize;
+  size_t                objn;
+  uint8_t               *objbuf;
+  msg_t                 *msgbuf;
+  uint32_t              taken;
+  size_t                rd;
+  size_t                cnt;
+} objects_fifo_t;
+
+#define TIME_MS2I(ms)           ((sysinterval_t)(ms))
+#define chTimeDiffX(start, end) ((sysinterval_t)((systime_t)((end) - (start))))
+
+#define chDbgAssert(c, r)       osalDbgAssert(c, r)
+
+#define chSysLock()
+#define chSysUnlock()
+#define chSysLockFromISR()
+#define chSysUnlockFromISR()
+#define chSchRescheduleS()
+#define chRegSetThreadName(name) ((void)(name))
+#define chThdSleepMilliseconds(ms) ((void)(ms))
+
+#define chSemObjectInit(sp, n)  ((sp)->cnt = (int32_t)(n))
+#define chSemReset(sp, n)       ((sp)->cnt = (int32_t)(n))
+#define chSemSignalI(sp)        ((sp)->cnt++)
+
+#define chEvtObjectInit(esp)    ((esp)->flags = 0U)
+#define chEvtBroadcastFlags(esp, fl) ((esp)->flags |= (fl))
+#define chEvtSignal(tp, m)      ((tp)->epending |= (m))
+#define chEvtSignalI(tp, m)     ((tp)->epending |= (m))
+
+#define chThdTerminate(tp)      ((tp)->terminate = true)
+
+/* Implemented by the test.*/
+thread_t *chThdCreateStatic(void *wsp, size_t size, tprio_t prio,
+                            tfunc_t pf, void *arg);
+bool chThdShouldTerminateX(void);
+void chThdExit(msg_t msg);
+msg_t chThdWait(thread_t *tp);
+eventmask_t chEvtWaitAny(eventmask_t events);
+msg_t chSemWaitTimeout(semaphore_t *sp, sysinterval_t timeout);
+systime_t chVTGetSystemTimeX(void);
+void chThdSleep(sysinterval_t time);
+void chFifoObjectInit(objects_fifo_t *ofp, size_t objsize, size_t objn,
+                      unsigned objalign, void *objbuf, msg_t *msgbuf);
+void *chFifoTakeObjectTimeout(objects_fifo_t *ofp, sysinterval_t timeout);
+void chFifoReturnObject(objects_fifo_t *ofp, void *objp);
+void chFifoSendObject(objects_fifo_t *ofp, void *objp);
+msg_t chFifoReceiveObjectTimeout(objects_fifo_t *ofp, void **objpp,
+                                 sysinterval_t timeout);
+
+#endif /* CH_H_ */
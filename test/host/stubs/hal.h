@@ -0,0 +1,254 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stubs/hal.h
+ * @brief   Minimal HAL and OSAL definitions for the host tests.
+ * @details Only what the portable modules under test use, the debug
+ *          checks abort the test program.
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(FALSE)
+#define FALSE                   0
+#endif
+#if !defined(TRUE)
+#define TRUE                    1
+#endif
+
+#define HAL_SUCCESS             false
+#define HAL_FAILED              true
+
+typedef int32_t msg_t;
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+
+#define MSG_OK                  (msg_t)0
+#define MSG_TIMEOUT             (msg_t)-1
+#define MSG_RESET               (msg_t)-2
+
+#define TIME_INFINITE           ((sysinterval_t)-1)
+#define TIME_IMMEDIATE          ((sysinterval_t)0)
+#define OSAL_MS2I(ms)           ((sysinterval_t)(ms))
+
+#define osalDbgCheck(c) do {                                                \
+  if (!(c)) {                                                               \
+    fprintf(stderr, "%s:%d: osalDbgCheck(%s)\n", __FILE__, __LINE__, #c);   \
+    abort();                                                                \
+  }                                                                         \
+} while (0)
+
+#define osalDbgAssert(c, r) do {                                            \
+  if (!(c)) {                                                               \
+    fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, r);                  \
+    abort();                                                                \
+  }                                                                         \
+} while (0)
+
+#define osalSysLock()
+#define osalSysUnlock()
+#define osalSysLockFromISR()
+#define osalSysUnlockFromISR()
+
+#define PACKED_VAR              __attribute__((packed))
+
+/*===========================================================================*/
+/* Streams.                                                                  */
+/*===========================================================================*/
+
+struct BaseSequentialStreamVMT {
+  size_t (*write)(void *ip, const uint8_t *bp, size_t n);
+  size_t (*read)(void *ip, uint8_t *bp, size_t n);
+};
+
+typedef struct {
+  const struct BaseSequentialStreamVMT *vmt;
+} BaseSequentialStream;
+
+#define streamWrite(ip, bp, n)  ((ip)->vmt->write(ip, bp, n))
+#define streamRead(ip, bp, n)   ((ip)->vmt->read(ip, bp, n))
+
+/*===========================================================================*/
+/* PAL.                                                                      */
+/*===========================================================================*/
+
+#if (defined(HAL_USE_ONEWIRE) && (HAL_USE_ONEWIRE == TRUE)) ||               \
+    (defined(HAL_USE_SPI) && (HAL_USE_SPI == TRUE))
+
+#define HAL_USE_PAL             TRUE
+
+typedef uint32_t ioportid_t;
+typedef uint32_t ioportmask_t;
+typedef uint32_t iomode_t;
+typedef uint32_t ioline_t;
+
+#define PAL_LOW                 0U
+#define PAL_HIGH                1U
+
+#endif /* HAL_USE_PAL */
+
+/*===========================================================================*/
+/* 1-wire driver, UART backend.                                              */
+/*===========================================================================*/
+
+#if defined(HAL_USE_ONEWIRE) && (HAL_USE_ONEWIRE == TRUE)
+
+#define HAL_USE_UART            TRUE
+
+typedef void *thread_reference_t;
+
+#define palReadPad(port, pad)   ((void)(port), (void)(pad), PAL_HIGH)
+#define palSetPadMode(port, pad, mode)                                        ((void)(port), (void)(pad), (void)(mode))
+
+typedef struct UARTDriver UARTDriver;
+typedef void (*uartcb_t)(UARTDriver *uartp);
+
+typedef struct {
+  uartcb_t              txend1_cb;
+  uartcb_t              txend2_cb;
+  uartcb_t              rxend_cb;
+  uint32_t              speed;
+} UARTConfig;
+
+typedef enum {
+  UART_UNINIT = 0,
+  UART_STOP = 1,
+  UART_READY = 2
+} uartstate_t;
+
+struct UARTDriver {
+  uartstate_t           state;
+  const UARTConfig      *config;
+};
+
+#define osalSysHalt(reason)     abort()
+#define osalThreadSleep(time)   ((void)(time))
+#define osalThreadSleepMicroseconds(usecs) ((void)(usecs))
+#define osalThreadResumeI(trp, msg) ((void)(trp), (void)(msg))
+
+/* Implemented by the test, the bus model runs while the driver waits.*/
+void uartStart(UARTDriver *uartp, const UARTConfig *config);
+void uartStop(UARTDriver *uartp);
+void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf);
+void uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf);
+msg_t osalThreadSuspendS(thread_reference_t *trp);
+
+#include "hal_onewire.h"
+
+#endif /* HAL_USE_ONEWIRE */
+
+/*===========================================================================*/
+/* SPI driver and PAL pad events.                                            */
+/*===========================================================================*/
+
+#if defined(HAL_USE_SPI) && (HAL_USE_SPI == TRUE)
+
+#define PAL_USE_CALLBACKS       TRUE
+#define PAL_EVENT_MODE_FALLING_EDGE 2U
+
+typedef void (*palcallback_t)(void *arg);
+
+typedef struct {
+  uint32_t              cr1;
+} SPIConfig;
+
+typedef struct {
+  uint32_t              id;
+  const SPIConfig       *config;
+} SPIDriver;
+
+/* Implemented by the test, the SPI devices are modeled behind these.*/
+void palSetPad(ioportid_t port, uint32_t pad);
+void palClearPad(ioportid_t port, uint32_t pad);
+uint32_t palReadPad(ioportid_t port, uint32_t pad);
+void palSetPadCallback(ioportid_t port, uint32_t pad, palcallback_t cb,
+                       void *arg);
+void palEnablePadEvent(ioportid_t port, uint32_t pad, uint32_t mode);
+void palDisablePadEvent(ioportid_t port, uint32_t pad);
+void spiStart(SPIDriver *spip, const SPIConfig *config);
+void spiStop(SPIDriver *spip);
+void spiSelect(SPIDriver *spip);
+void spiUnselect(SPIDriver *spip);
+void spiExchange(SPIDriver *spip, size_t n, const void *txbuf, void *rxbuf);
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
+void spiReceive(SPIDriver *spip, size_t n, void *rxbuf);
+
+#endif /* HAL_USE_SPI */
+
+/*===========================================================================*/
+/* I2C driver.                                                               */
+/*===========================================================================*/
+
+#if defined(HAL_USE_I2C) && (HAL_USE_I2C == TRUE)
+
+#define I2C_USE_MUTUAL_EXCLUSION TRUE
+
+typedef uint16_t i2caddr_t;
+
+typedef struct {
+  uint32_t              id;
+} I2CDriver;
+
+/* Implemented by the test, the I2C devices are modeled behind these.*/
+msg_t i2cMasterTransmitTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                               const uint8_t *txbuf, size_t txbytes,
+                               uint8_t *rxbuf, size_t rxbytes,
+                               sysinterval_t timeout);
+msg_t i2cMasterReceiveTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                              uint8_t *rxbuf, size_t rxbytes,
+                              sysinterval_t timeout);
+void i2cAcquireBus(I2CDriver *i2cp);
+void i2cReleaseBus(I2CDriver *i2cp);
+void osalThreadSleepMilliseconds(uint32_t msecs);
+
+#endif /* HAL_USE_I2C */
+
+/*===========================================================================*/
+/* TIVA uDMA helpers.                                                        */
+/*===========================================================================*/
+
+#if defined(TIVA_UDMA_REQUIRED)
+
+#include "inc/hw_udma.h"
+#include "inc/hw_sysctl.h"
+
+/* Registers are read and written through the test.*/
+volatile uint32_t *test_hwreg(uint32_t addr);
+#define HWREG(x)                (*test_hwreg(x))
+
+#define OSAL_IRQ_HANDLER(id)    void id(void)
+#define OSAL_IRQ_PROLOGUE()
+#define OSAL_IRQ_EPILOGUE()
+#define nvicEnableVector(n, prio) ((void)(n), (void)(prio))
+
+#define TIVA_UDMA_SW_HANDLER    VectorF8
+#define TIVA_UDMA_SW_NUMBER     46
+#define TIVA_UDMA_ERR_HANDLER   VectorFC
+#define TIVA_UDMA_ERR_NUMBER    47
+
+#include "tiva_udma.h"
+
+#endif /* TIVA_UDMA_REQUIRED */
+
+#endif /* HAL_H_ */
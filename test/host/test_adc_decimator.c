@@ -0,0 +1,249 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_adc_decimator.c
+ * @brief   ADC decimator test and benchmark.
+ * @details Checks the decimator bit for bit against a direct form reference,
+ *          cascaded moving sums followed by a plain FIR, over random
+ *          configurations, block sizes and state buffer sizes. Then
+ *          measures the input rate of a four channels interleaved buffer.
+ */
+
+#include "adc_decimator.h"
+#include "host_test.h"
+
+#define CHANNELS        4U
+#define SAMPLES         6000U
+#define MAX_TAPS        48U
+#define BENCH_SAMPLES   (32U * 1024U * 1024U)
+
+static uint32_t in32[SAMPLES * CHANNELS];
+static uint16_t in16[SAMPLES * CHANNELS];
+static int16_t out[SAMPLES + 1U], ref[SAMPLES + 1U];
+static int16_t coeffs[MAX_TAPS];
+static int16_t state[MAX_TAPS + 200U];
+
+static int16_t sat16(int64_t x) {
+
+  return x > INT16_MAX ? INT16_MAX : x < INT16_MIN ? INT16_MIN : (int16_t)x;
+}
+
+static unsigned ceil_log2(uint32_t x) {
+  unsigned bits = 0;
+
+  while ((1UL << bits) < x) {
+    bits++;
+  }
+  return bits;
+}
+
+/* Reference decimator on one channel, in 64 bits.*/
+static size_t reference(const decimator_config_t *cfgp, const uint32_t *in,
+                        size_t stride, size_t n, int16_t *y) {
+  static int64_t s[SAMPLES], t[SAMPLES];
+  static int16_t c[SAMPLES];
+  int64_t mid = 1LL << (cfgp->resolution - 1U);
+  unsigned growth = cfgp->cic_order * ceil_log2(cfgp->cic_ratio);
+  int shift = (int)(cfgp->resolution + growth) - 16;
+  size_t i, k, nc = 0, ny = 0;
+  unsigned stage;
+
+  /* CIC, each stage is a moving sum over the ratio.*/
+  for (i = 0; i < n; i++) {
+    s[i] = (int64_t)in[i * stride] - mid;
+  }
+  for (stage = 0; stage < cfgp->cic_order; stage++) {
+    for (i = 0; i < n; i++) {
+      t[i] = 0;
+      for (k = 0; (k < cfgp->cic_ratio) && (k <= i); k++) {
+        t[i] += s[i - k];
+      }
+    }
+    memcpy(s, t, n * sizeof s[0]);
+  }
+  for (i = cfgp->cic_ratio - 1U; i < n; i += cfgp->cic_ratio) {
+    if (shift > 0) {
+      c[nc++] = sat16((s[i] + (1LL << (shift - 1))) >> shift);
+    }
+    else {
+      c[nc++] = sat16(s[i] * (1LL << -shift));
+    }
+  }
+
+  if (cfgp->fir_taps == 0U) {
+    memcpy(y, c, nc * sizeof c[0]);
+    return nc;
+  }
+
+  /* FIR, zero history.*/
+  for (i = cfgp->fir_ratio - 1U; i < nc; i += cfgp->fir_ratio) {
+    int64_t acc = 0;
+    for (k = 0; (k < cfgp->fir_taps) && (k <= i); k++) {
+      acc += (int64_t)cfgp->fir_coeffs[k] * c[i - k];
+    }
+    y[ny++] = sat16((acc + (1LL << 14)) >> 15);
+  }
+  return ny;
+}
+
+static void random_config(decimator_config_t *cfgp) {
+
+  cfgp->resolution = (test_rand() & 1U) ? 12U : 16U;
+  do {
+    cfgp->cic_order = test_rand() % (DECIMATOR_CIC_MAX_ORDER + 1U);
+    cfgp->cic_ratio = cfgp->cic_order == 0U ? 1U : 1U + test_rand() % 32U;
+  } while (cfgp->resolution +
+           cfgp->cic_order * ceil_log2(cfgp->cic_ratio) > 32U);
+  cfgp->fir_taps = (test_rand() % 3U) == 0U ? 0U : 1U + test_rand() % MAX_TAPS;
+  cfgp->fir_ratio = cfgp->fir_taps == 0U ? 1U : 1U + test_rand() % 8U;
+  cfgp->fir_coeffs = coeffs;
+}
+
+static void test_reference(void) {
+  unsigned run;
+
+  for (run = 0; run < 200; run++) {
+    decimator_config_t cfg;
+    decimator_t dec;
+    size_t state_size, i, n, done, nout, nref;
+    unsigned ch = test_rand() % CHANNELS;
+    bool wide = (test_rand() & 1U) != 0U;
+
+    random_config(&cfg);
+    for (i = 0; i < MAX_TAPS; i++) {
+      coeffs[i] = (int16_t)((int)(test_rand() % 16384U) - 8192);
+    }
+    for (i = 0; i < SAMPLES * CHANNELS; i++) {
+      in32[i] = test_rand() >> (32U - cfg.resolution);
+      in16[i] = (uint16_t)in32[i];
+    }
+    /* Long runs of full scale codes now and then, for the saturation.*/
+    if ((run % 4U) == 0U) {
+      for (i = 0; i < SAMPLES * CHANNELS / 2U; i++) {
+        in32[i] = (1UL << cfg.resolution) - 1U;
+        in16[i] = (uint16_t)in32[i];
+      }
+    }
+    state_size = DECIMATOR_STATE_MIN(cfg.fir_taps) + test_rand() % 200U;
+
+    CHECK(decimatorInit(&dec, &cfg, cfg.fir_taps > 0U ? state : NULL,
+                        state_size));
+    nout = 0;
+    for (done = 0; done < SAMPLES; done += n) {
+      n = 1U + test_rand() % 700U;
+      if (n > SAMPLES - done) {
+        n = SAMPLES - done;
+      }
+      nout += wide ?
+        decimatorProcessU32(&dec, &in32[done * CHANNELS + ch], CHANNELS, n,
+                            &out[nout]) :
+        decimatorProcessU16(&dec, &in16[done * CHANNELS + ch], CHANNELS, n,
+                            &out[nout]);
+      CHECK(nout <= SAMPLES / decimatorRatio(&cfg));
+    }
+
+    nref = reference(&cfg, &in32[ch], CHANNELS, SAMPLES, ref);
+    CHECKF((nout == nref) && (memcmp(out, ref, nout * sizeof out[0]) == 0),
+           "res %u cic %u/%u fir %u/%u state %zu: %zu vs %zu outputs",
+           cfg.resolution, cfg.cic_order, cfg.cic_ratio, cfg.fir_taps,
+           cfg.fir_ratio, state_size, nout, nref);
+  }
+}
+
+static void test_config(void) {
+  decimator_config_t cfg = {12, 4, 16, 1, 0, NULL};
+  decimator_t dec;
+  size_t i, n;
+
+  /* Full scale input gives full scale output once settled.*/
+  CHECK(decimatorInit(&dec, &cfg, NULL, 0));
+  for (i = 0; i < 256; i++) {
+    in16[i] = 4095U;
+  }
+  n = decimatorProcessU16(&dec, in16, 1, 256, out);
+  CHECK(n == 16U);
+  CHECKF(out[n - 1U] == 32752, "%d", out[n - 1U]);
+  decimatorReset(&dec);
+  CHECK(decimatorProcessU16(&dec, in16, 1, 15, out) == 0U);
+
+  /* Invalid configurations.*/
+  cfg.resolution = 16;
+  cfg.cic_order = 5;
+  cfg.cic_ratio = 32;
+  CHECK(!decimatorInit(&dec, &cfg, NULL, 0));
+  cfg.cic_order = 4;
+  cfg.cic_ratio = 16;
+  CHECK(decimatorInit(&dec, &cfg, NULL, 0));
+  cfg.cic_order = 0;
+  CHECK(!decimatorInit(&dec, &cfg, NULL, 0));
+  cfg.cic_order = 1;
+  cfg.fir_ratio = 2;
+  CHECK(!decimatorInit(&dec, &cfg, NULL, 0));
+  cfg.fir_taps = 8;
+  cfg.fir_coeffs = coeffs;
+  CHECK(!decimatorInit(&dec, &cfg, state, DECIMATOR_STATE_MIN(8) - 1U));
+  CHECK(!decimatorInit(&dec, &cfg, NULL, DECIMATOR_STATE_MIN(8)));
+  CHECK(decimatorInit(&dec, &cfg, state, DECIMATOR_STATE_MIN(8)));
+  cfg.resolution = 0;
+  CHECK(!decimatorInit(&dec, &cfg, state, DECIMATOR_STATE_MIN(8)));
+}
+
+static void bench(unsigned order, unsigned ratio, unsigned taps,
+                  unsigned fir_ratio, size_t state_size) {
+  static uint16_t buf[1024U * CHANNELS];
+  decimator_config_t cfg = {12, (uint8_t)order, (uint16_t)ratio,
+                            (uint16_t)fir_ratio, (uint16_t)taps, coeffs};
+  decimator_t dec[CHANNELS];
+  size_t i, runs = BENCH_SAMPLES / (sizeof buf / sizeof buf[0]);
+  unsigned ch;
+  double t0;
+
+  for (i = 0; i < sizeof buf / sizeof buf[0]; i++) {
+    buf[i] = (uint16_t)(test_rand() & 0xFFFU);
+  }
+  for (ch = 0; ch < CHANNELS; ch++) {
+    CHECK(decimatorInit(&dec[ch], &cfg, &state[0], state_size));
+  }
+
+  t0 = bench_now();
+  for (i = 0; i < runs; i++) {
+    for (ch = 0; ch < CHANNELS; ch++) {
+      /* The channels share the state buffer, only the speed matters.*/
+      BENCH_KEEP(decimatorProcessU16(&dec[ch], &buf[ch], CHANNELS,
+                                     sizeof buf / sizeof buf[0] / CHANNELS,
+                                     out));
+    }
+  }
+  printf("CIC %u/%-2u FIR %2u/%u state %3zu: %6.1f Msamples/s in\n",
+         order, ratio, taps, fir_ratio, state_size,
+         (double)runs * (sizeof buf / sizeof buf[0]) /
+         (bench_now() - t0) / 1e6);
+}
+
+int main(void) {
+
+  test_config();
+  test_reference();
+
+  bench(4, 16, 0, 1, 0);
+  bench(4, 16, 32, 4, DECIMATOR_STATE_MIN(32));
+  bench(4, 16, 32, 4, 96);
+  bench(4, 16, 32, 4, MAX_TAPS + 200U);
+  bench(2, 4, 48, 2, MAX_TAPS + 200U);
+
+  TEST_END();
+}
@@ -0,0 +1,246 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_csprng.c
+ * @brief   ChaCha20 DRBG and health tests test and benchmark.
+ * @details Checks the block function against the RFC 7539 vectors, the
+ *          generator behaviour (seeding, key erasure, wiping of the
+ *          returned bytes) and the output statistics. Then checks that the
+ *          health tests pass a good source and catch a stuck and a biased
+ *          one, and measures the generator throughput.
+ */
+
+#include <math.h>
+
+#include "csprng.h"
+#include "host_test.h"
+
+#define STAT_SIZE       (16U * 1024U * 1024U)
+#define BENCH_SIZE      (64U * 1024U * 1024U)
+
+static uint8_t big[STAT_SIZE];
+static csprng_t rng;
+
+static void test_vectors(void) {
+  /* RFC 7539, 2.3.2.*/
+  static const uint32_t key[8] = {
+    0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+    0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c
+  };
+  static const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+  static const uint32_t expect[16] = {
+    0xe4e7f110, 0x15593bd1, 0x1fdd0f50, 0xc47120a3,
+    0xc7f4d1c7, 0x0368c033, 0x9aaa2204, 0x4e6cd4c3,
+    0x466482d2, 0x09aa9f07, 0x05d7c214, 0xa2028bd9,
+    0xd19c12b5, 0xb94e16de, 0xe883d0cb, 0x4e3c50a2
+  };
+  /* RFC 7539, A.1 test vector #1, all zero key and nonce.*/
+  static const uint32_t zero[8];
+  static const uint32_t expect0[16] = {
+    0xade0b876, 0x903df1a0, 0xe56a5d40, 0x28bd8653,
+    0xb819d2bd, 0x1aed8da0, 0xccef36a8, 0xc70d778b,
+    0x7c5941da, 0x8d485751, 0x3fe02477, 0x374ad8b8,
+    0xf4b8436a, 0x1ca11815, 0x69b687c3, 0x8665eeb2
+  };
+  uint32_t out[16];
+
+  csprngChaChaBlock(key, 1, nonce, out);
+  CHECK(memcmp(out, expect, sizeof out) == 0);
+  csprngChaChaBlock(zero, 0, zero, out);
+  CHECK(memcmp(out, expect0, sizeof out) == 0);
+}
+
+static void test_generator(void) {
+  static const uint8_t seed[] = "host test seed";
+  uint8_t a[1000], b[1000], longseed[100];
+  uint32_t key[CSPRNG_KEY_SIZE / 4U];
+  size_t i, done, n;
+
+  /* Same seed, same output, whatever the sizes of the buffered requests.*/
+  csprngInit(&rng, seed, sizeof seed);
+  for (done = 0; done < 100; done += n) {
+    n = done + 7U > 100U ? 100U - done : 7U;
+    csprngGenerate(&rng, &a[done], n);
+  }
+  csprngInit(&rng, seed, sizeof seed);
+  for (done = 0; done < 100; done += n) {
+    n = 1U + test_rand() % 10U;
+    n = n > 100U - done ? 100U - done : n;
+    csprngGenerate(&rng, &b[done], n);
+  }
+  CHECK(memcmp(a, b, 100) == 0);
+
+  /* A different seed or a reseed changes the output.*/
+  csprngInit(&rng, seed, sizeof seed - 1U);
+  csprngGenerate(&rng, b, 100);
+  CHECK(memcmp(a, b, 100) != 0);
+  csprngInit(&rng, seed, sizeof seed);
+  csprngReseed(&rng, NULL, 0);
+  csprngGenerate(&rng, b, 100);
+  CHECK(memcmp(a, b, 100) != 0);
+
+  /* Every byte of a long seed counts.*/
+  memset(longseed, 0x11, sizeof longseed);
+  csprngInit(&rng, longseed, sizeof longseed);
+  csprngGenerate(&rng, a, 64);
+  longseed[sizeof longseed - 1U] ^= 1U;
+  csprngInit(&rng, longseed, sizeof longseed);
+  csprngGenerate(&rng, b, 64);
+  CHECK(memcmp(a, b, 64) != 0);
+
+  /* Returned bytes are wiped, the key is replaced on each refill.*/
+  csprngInit(&rng, seed, sizeof seed);
+  memcpy(key, rng.key, sizeof key);
+  csprngGenerate(&rng, a, 40);
+  CHECK(memcmp(key, rng.key, sizeof key) != 0);
+  CHECK(rng.avail == CSPRNG_BUFFER_SIZE - CSPRNG_KEY_SIZE - 40U);
+  for (i = 0; i < CSPRNG_BUFFER_SIZE - rng.avail; i++) {
+    CHECK(rng.buf[i] == 0U);
+  }
+
+  /* Large requests, the rest of the buffer then whole blocks straight to
+     the caller buffer. No block is repeated.*/
+  n = sizeof b - rng.avail;
+  csprngGenerate(&rng, b, sizeof b);
+  CHECK(rng.avail ==
+        CSPRNG_BUFFER_SIZE - CSPRNG_KEY_SIZE - n % CSPRNG_BLOCK_SIZE);
+  for (i = 0; i + 64U + 8U <= sizeof b; i += 8U) {
+    CHECK(memcmp(&b[i], &b[i + 64U], 8) != 0);
+  }
+}
+
+static void test_statistics(void) {
+  static const uint8_t seed[] = "statistics";
+  uint64_t count[256] = {0}, ones = 0;
+  double chi = 0.0, e = STAT_SIZE / 256.0;
+  double sx = 0.0, sxx = 0.0, sxy = 0.0, corr;
+  size_t i;
+
+  csprngInit(&rng, seed, sizeof seed);
+  for (i = 0; i < STAT_SIZE; i += 4096U) {
+    csprngGenerate(&rng, &big[i], 1U + (i / 4096U) % 4096U);
+  }
+  csprngGenerate(&rng, big, STAT_SIZE);
+
+  for (i = 0; i < STAT_SIZE; i++) {
+    double x = big[i], y = big[(i + 1U) % STAT_SIZE];
+
+    count[big[i]]++;
+    ones += (uint64_t)__builtin_popcount(big[i]);
+    sx += x;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  for (i = 0; i < 256; i++) {
+    chi += ((double)count[i] - e) * ((double)count[i] - e) / e;
+  }
+  corr = (STAT_SIZE * sxy - sx * sx) / (STAT_SIZE * sxx - sx * sx);
+
+  printf("%u MB: chi-square %.1f (255 dof), ones %.6f, "
+         "serial correlation %.6f\n", STAT_SIZE >> 20, chi,
+         (double)ones / (8.0 * STAT_SIZE), corr);
+  /* About four standard deviations.*/
+  CHECKF((chi > 165.0) && (chi < 345.0), "%.1f", chi);
+  CHECK(fabs((double)ones / (8.0 * STAT_SIZE) - 0.5) < 0.0002);
+  CHECK(fabs(corr) < 0.001);
+}
+
+static void test_health(void) {
+  csprng_health_t h;
+  uint8_t buf[1024];
+  unsigned entropy, i, n;
+  bool ok;
+
+  /* A good source passes, whatever the assumed entropy.*/
+  for (entropy = 1; entropy <= 8; entropy++) {
+    csprngHealthInit(&h, entropy);
+    ok = true;
+    for (n = 0; ok && (n < 4000U); n++) {
+      csprngGenerate(&rng, buf, sizeof buf);
+      ok = csprngHealthTest(&h, buf, sizeof buf);
+    }
+    CHECKF(ok, "entropy %u, failed after %u samples", entropy,
+           (unsigned)h.samples);
+  }
+
+  /* A stuck source is caught within the repetition count cutoff.*/
+  memset(buf, 0xA5, sizeof buf);
+  for (entropy = 1; entropy <= 8; entropy++) {
+    csprngHealthInit(&h, entropy);
+    CHECK(!csprngHealthTest(&h, buf, sizeof buf));
+    CHECKF(h.samples + 1U == h.rct_cutoff, "entropy %u, %u samples",
+           entropy, (unsigned)h.samples);
+  }
+
+  /* Half of the samples stuck at zero, about 1 bit of min-entropy: passes
+     when assumed, caught by the proportion test when 8 bits are.*/
+  csprngHealthInit(&h, 1);
+  ok = true;
+  for (n = 0; ok && (n < 1000U); n++) {
+    for (i = 0; i < sizeof buf; i++) {
+      buf[i] = (test_rand() & 1U) ? 0U : (uint8_t)(1U + test_rand() % 255U);
+    }
+    ok = csprngHealthTest(&h, buf, sizeof buf);
+  }
+  CHECK(ok);
+  csprngHealthInit(&h, 8);
+  CHECK(!csprngHealthTest(&h, buf, sizeof buf));
+  printf("biased source caught after %u samples\n", (unsigned)h.samples);
+
+  /* After a failure the object is initialized again.*/
+  csprngHealthInit(&h, 8);
+  csprngGenerate(&rng, buf, sizeof buf);
+  CHECK(csprngHealthTest(&h, buf, sizeof buf));
+}
+
+static void bench(size_t request) {
+  size_t i, runs = BENCH_SIZE / request;
+  double t0;
+
+  t0 = bench_now();
+  for (i = 0; i < runs; i++) {
+    csprngGenerate(&rng, big, request);
+    BENCH_KEEP(big);
+  }
+  printf("%5zu bytes requests: %6.1f MB/s\n", request,
+         (double)BENCH_SIZE / (bench_now() - t0) / 1e6);
+}
+
+int main(void) {
+  uint8_t seed[64];
+  unsigned i;
+  double t0;
+
+  memset(seed, 0x5A, sizeof seed);
+  test_vectors();
+  test_generator();
+  test_statistics();
+  test_health();
+
+  bench(16);
+  bench(64);
+  bench(4096);
+
+  t0 = bench_now();
+  for (i = 0; i < 100000U; i++) {
+    seed[0] = (uint8_t)i;
+    csprngReseed(&rng, seed, sizeof seed);
+  }
+  printf("64 bytes reseed: %.2f us\n", (bench_now() - t0) * 1e6 / 100000.0);
+
+  TEST_END();
+}
@@ -0,0 +1,234 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_fbstream.c
+ * @brief   Frame buffer streaming codec test.
+ * @details Checks that encoded rows decode back and never exceed
+ *          @p FBSTREAM_ROWBUF_SIZE, with the known worst case patterns,
+ *          every short row over a small alphabet and random rows, then
+ *          decodes a captured stream.
+ */
+
+#include "hal.h"
+#include "fbstream.h"
+#include "host_test.h"
+
+#define MAX_WIDTH       1024U
+
+static const uint8_t unit_fmt[5] = {
+  0, PIXFMT_L8, PIXFMT_RGB565, PIXFMT_RGB888, PIXFMT_ARGB8888
+};
+
+/* Encoded payload bound for a row, without the record header.*/
+static size_t bound(size_t units, size_t unit) {
+
+  return FBSTREAM_ROWBUF_SIZE(units, unit_fmt[unit]) - FBSTREAM_RECORD_SIZE;
+}
+
+/* Decodes a row payload, returns false on malformed payloads.*/
+static bool decode_row(const uint8_t *ip, size_t n, const uint8_t *abovep,
+                       size_t bytes, size_t unit, uint8_t *rowp) {
+  size_t i = 0, o = 0;
+
+  while (i < n) {
+    uint8_t code = ip[i++];
+    size_t count;
+
+    if (code < 0x80) {
+      count = ((size_t)code + 1) * unit;
+      if ((i + count > n) || (o + count > bytes)) {
+        return false;
+      }
+      memcpy(&rowp[o], &ip[i], count);
+      i += count;
+    }
+    else if (code < 0xC0) {
+      size_t k, reps = (size_t)(code & 0x3F) + 2;
+      count = reps * unit;
+      if ((i + unit > n) || (o + count > bytes)) {
+        return false;
+      }
+      for (k = 0; k < reps; k++) {
+        memcpy(&rowp[o + k * unit], &ip[i], unit);
+      }
+      i += unit;
+    }
+    else {
+      count = ((size_t)(code & 0x3F) + 1) * unit;
+      if ((abovep == NULL) || (o + count > bytes)) {
+        return false;
+      }
+      memcpy(&rowp[o], &abovep[o], count);
+    }
+    o += count;
+  }
+  return o == bytes;
+}
+
+static uint8_t out[MAX_WIDTH * 8], dec[MAX_WIDTH * 4];
+static size_t worst_excess[5];
+
+/* Encodes, checks the bound and the round trip.*/
+static bool check_row(const uint8_t *rowp, const uint8_t *abovep,
+                      size_t units, size_t unit) {
+  size_t n = fbstreamEncodeRow(rowp, abovep, units, unit, out);
+  bool ok = (n <= bound(units, unit)) &&
+            decode_row(out, n, abovep, units * unit, unit, dec) &&
+            (memcmp(dec, rowp, units * unit) == 0);
+
+  if (n > units * unit + worst_excess[unit]) {
+    worst_excess[unit] = n - units * unit;
+  }
+  CHECKF(ok, "%zu units of %zu bytes: %zu encoded, bound %zu",
+         units, unit, n, bound(units, unit));
+  return ok;
+}
+
+/* Fills a row with units from a small alphabet.*/
+static void random_row(uint8_t *rowp, size_t units, size_t unit,
+                       unsigned alphabet) {
+  size_t i;
+
+  for (i = 0; i < units * unit; i += unit) {
+    unsigned v = test_rand() % alphabet;
+    memset(&rowp[i], (int)v, unit);
+  }
+}
+
+static size_t mem_write(void *ip, const uint8_t *bp, size_t n);
+static const struct BaseSequentialStreamVMT mem_vmt = {mem_write, NULL};
+static BaseSequentialStream mem_stream = {&mem_vmt};
+static uint8_t captured[1 << 20];
+static size_t captured_len;
+
+static size_t mem_write(void *ip, const uint8_t *bp, size_t n) {
+
+  (void)ip;
+  memcpy(&captured[captured_len], bp, n);
+  captured_len += n;
+  return n;
+}
+
+static unsigned get16(const uint8_t *p) {
+
+  return (unsigned)p[0] | ((unsigned)p[1] << 8);
+}
+
+/* Applies a captured frame to a frame buffer, returns the row records.*/
+static int decode_frame(uint8_t *fbp, unsigned width, unsigned height,
+                        size_t bytes, size_t unit) {
+  const uint8_t *p = captured;
+  int records = 0;
+
+  if ((memcmp(p, "FBS1", 4) != 0) || (get16(&p[8]) != width) ||
+      (get16(&p[10]) != height)) {
+    return -1;
+  }
+  p += FBSTREAM_HEADER_SIZE;
+  while (get16(p) != FBSTREAM_END_ROW) {
+    unsigned y = get16(p), n = get16(&p[2]);
+    if (!decode_row(&p[4], n, y > 0 ? &fbp[(y - 1) * bytes] : NULL,
+                    bytes, unit, &fbp[y * bytes])) {
+      return -1;
+    }
+    p += FBSTREAM_RECORD_SIZE + n;
+    records++;
+  }
+  return get16(&p[2]) == (unsigned)records ? records : -1;
+}
+
+int main(void) {
+  static uint8_t row[MAX_WIDTH * 4], above[MAX_WIDTH * 4];
+  size_t unit, units, i;
+  unsigned k;
+
+  /* Literal unit followed by a 2 unit run, the former worst case of the
+     1-byte units.*/
+  for (i = 0; i < 300; i++) {
+    row[i] = (i % 3 == 0) ? (uint8_t)(i + 100) : (uint8_t)i / 3;
+  }
+  check_row(row, NULL, 300, 1);
+
+  /* Same pattern with 2-unit copies from the row above.*/
+  for (i = 0; i < 300; i++) {
+    above[i] = (i % 3 == 0) ? (uint8_t)~row[i] : row[i];
+  }
+  check_row(row, above, 300, 1);
+
+  /* Every row up to 12 units over 3 values, against a fixed row above.*/
+  for (units = 1; units <= 12; units++) {
+    unsigned long code, count = 1;
+    for (i = 0; i < units; i++) {
+      count *= 3;
+      above[i] = (uint8_t)(i % 3);
+    }
+    for (code = 0; code < count; code++) {
+      unsigned long c = code;
+      for (i = 0; i < units; i++) {
+        row[i] = (uint8_t)(c % 3);
+        c /= 3;
+      }
+      if (!check_row(row, NULL, units, 1) ||
+          !check_row(row, above, units, 1)) {
+        break;
+      }
+    }
+  }
+
+  /* Random rows, every unit size, short runs are the likely worst cases.*/
+  for (unit = 1; unit <= 4; unit++) {
+    for (k = 0; k < 20000; k++) {
+      unsigned alphabet = 2 + test_rand() % 4;
+      units = 1 + test_rand() % MAX_WIDTH;
+      random_row(row, units, unit, alphabet);
+      random_row(above, units, unit, alphabet);
+      if (!check_row(row, (k & 1) ? above : NULL, units, unit)) {
+        break;
+      }
+    }
+    printf("unit %zu: worst row excess %zu bytes\n", unit, worst_excess[unit]);
+  }
+
+  /* Captures decode to the frame, unchanged rows are skipped.*/
+  {
+    enum {W = 200, H = 48};
+    static uint8_t fb[W * H * 2], host[W * H * 2];
+    static uint32_t hashes[H];
+    static uint8_t rowbuf[FBSTREAM_ROWBUF_SIZE(W, PIXFMT_RGB565)];
+    const fbstream_config_t cfg = {
+      .streamp = &mem_stream, .hashesp = hashes, .max_height = H,
+      .rowbufp = rowbuf, .rowbuf_size = sizeof rowbuf, .key_interval = 0
+    };
+    const fbstream_frame_t frame = {fb, W, H, W * 2, PIXFMT_RGB565};
+    fbstream_t fs;
+
+    random_row(fb, W * H, 2, 3);
+    fbstreamObjectInit(&fs, &cfg);
+    captured_len = 0;
+    CHECK(fbstreamCapture(&fs, &frame) == captured_len);
+    CHECK(decode_frame(host, W, H, W * 2, 2) == H);
+    CHECK(memcmp(host, fb, sizeof fb) == 0);
+
+    fb[7 * W * 2 + 11] ^= 0x55;
+    captured_len = 0;
+    CHECK(fbstreamCapture(&fs, &frame) == captured_len);
+    CHECK(decode_frame(host, W, H, W * 2, 2) == 1);
+    CHECK(memcmp(host, fb, sizeof fb) == 0);
+  }
+
+  TEST_END();
+}
@@ -0,0 +1,267 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_nand_ecc.c
+ * @brief   NAND software ECC test and benchmark.
+ * @details Checks the Hamming and BCH codes on random pages with random bit
+ *          errors in both the data and the ECC bytes, up to the strength
+ *          of the code, and the detection of the errors beyond it. Then
+ *          measures the encoding, the check of a clean page and the
+ *          correction of a step with the most errors.
+ */
+
+#include "nand_ecc.h"
+#include "host_test.h"
+
+#define PAGE_SIZE       2048U
+#define SPARE_SIZE      128U
+#define SPARE_OFFSET    2U
+#define RUNS            300U
+#define BENCH_PAGES     2000U
+
+static uint8_t data[PAGE_SIZE], orig[PAGE_SIZE];
+static uint8_t spare[SPARE_SIZE], orig_spare[SPARE_SIZE];
+static nand_ecc_t ecc;
+
+static void fill(uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    *p++ = (uint8_t)test_rand();
+  }
+}
+
+/* Flips n distinct random bits of a step, data and ECC together. The
+   padding bits are not part of the code word, the Hamming code is right
+   aligned in its bytes, the BCH code left aligned.*/
+static void flip(const nand_ecc_t *ep, size_t s, unsigned n) {
+  size_t step = ep->config->step_size;
+  bool bch = ep->config->algo == NAND_ECC_BCH;
+  uint32_t bits = (uint32_t)step * 8U +
+                  (bch ? ep->deg : (step == 256U ? 22U : 24U));
+  uint32_t used[2U * NAND_ECC_BCH_MAX_T + 2U];
+  unsigned i, j;
+
+  for (i = 0; i < n; i++) {
+    uint32_t b;
+    bool again;
+
+    do {
+      b = test_rand() % bits;
+      again = false;
+      for (j = 0; j < i; j++) {
+        again |= used[j] == b;
+      }
+    } while (again);
+    used[i] = b;
+
+    if (b < step * 8U) {
+      data[s * step + b / 8U] ^= (uint8_t)(1U << (b % 8U));
+    }
+    else {
+      b -= step * 8U;
+      spare[SPARE_OFFSET + s * ep->bytes + b / 8U] ^=
+        (uint8_t)(bch ? 0x80U >> (b % 8U) : 1U << (b % 8U));
+    }
+  }
+}
+
+static void new_page(const nand_ecc_t *ep) {
+
+  fill(orig, PAGE_SIZE);
+  memcpy(data, orig, PAGE_SIZE);
+  memset(spare, 0xFF, SPARE_SIZE);
+  nandEccCalculate(ep, data, PAGE_SIZE, spare);
+  memcpy(orig_spare, spare, SPARE_SIZE);
+}
+
+static void test_init(void) {
+  nand_ecc_config_t cfg = {NAND_ECC_HAMMING, 0, 256, SPARE_OFFSET};
+
+  CHECK(nandEccInit(&ecc, &cfg));
+  CHECK(ecc.bytes == 3U);
+  CHECK(nandEccSpareSize(&ecc, PAGE_SIZE) == SPARE_OFFSET + 8U * 3U);
+  cfg.step_size = 1024;
+  CHECK(!nandEccInit(&ecc, &cfg));
+
+  cfg.algo = NAND_ECC_BCH;
+  cfg.step_size = 512;
+  CHECK(!nandEccInit(&ecc, &cfg));
+  cfg.strength = NAND_ECC_BCH_MAX_T + 1U;
+  CHECK(!nandEccInit(&ecc, &cfg));
+  cfg.strength = 8;
+  CHECK(nandEccInit(&ecc, &cfg));
+  CHECK(ecc.bytes == 13U);
+  cfg.step_size = 256;
+  CHECK(!nandEccInit(&ecc, &cfg));
+}
+
+/* Erased pages read as clean, the spare bytes out of the ECC are left
+   alone.*/
+static void test_erased(const nand_ecc_t *ep) {
+  size_t i, end = nandEccSpareSize(ep, PAGE_SIZE);
+
+  memset(data, 0xFF, PAGE_SIZE);
+  memset(spare, 0xFF, SPARE_SIZE);
+  CHECK(nandEccCorrect(ep, data, PAGE_SIZE, spare) == 0);
+
+  memset(spare, 0x5A, SPARE_SIZE);
+  nandEccCalculate(ep, data, PAGE_SIZE, spare);
+  for (i = 0; i < SPARE_SIZE; i++) {
+    if ((i < SPARE_OFFSET) || (i >= end)) {
+      CHECK(spare[i] == 0x5AU);
+    }
+    else {
+      CHECK(spare[i] == 0xFFU);
+    }
+  }
+}
+
+static void test_hamming(uint16_t step_size) {
+  nand_ecc_config_t cfg = {NAND_ECC_HAMMING, 0, step_size, SPARE_OFFSET};
+  unsigned run;
+
+  CHECK(nandEccInit(&ecc, &cfg));
+  test_erased(&ecc);
+
+  for (run = 0; run < RUNS; run++) {
+    size_t steps = PAGE_SIZE / step_size, s;
+    int ret;
+
+    /* Clean.*/
+    new_page(&ecc);
+    CHECK(nandEccCorrect(&ecc, data, PAGE_SIZE, spare) == 0);
+    CHECK(memcmp(data, orig, PAGE_SIZE) == 0);
+
+    /* One bit per step, data or ECC.*/
+    for (s = 0; s < steps; s++) {
+      flip(&ecc, s, 1);
+    }
+    ret = nandEccCorrect(&ecc, data, PAGE_SIZE, spare);
+    CHECKF((ret == 1) && (memcmp(data, orig, PAGE_SIZE) == 0),
+           "Hamming/%u run %u: %d", step_size, run, ret);
+
+    /* Two bits in a step are detected.*/
+    memcpy(spare, orig_spare, SPARE_SIZE);
+    s = test_rand() % steps;
+    flip(&ecc, s, 2);
+    ret = nandEccCorrect(&ecc, data, PAGE_SIZE, spare);
+    CHECKF(ret == NAND_ECC_UNCORRECTABLE, "Hamming/%u run %u: %d",
+           step_size, run, ret);
+  }
+}
+
+static void test_bch(uint8_t t) {
+  nand_ecc_config_t cfg = {NAND_ECC_BCH, t, 512, SPARE_OFFSET};
+  unsigned run, detected = 0;
+
+  CHECK(nandEccInit(&ecc, &cfg));
+  test_erased(&ecc);
+
+  for (run = 0; run < RUNS; run++) {
+    size_t steps = PAGE_SIZE / 512U, s;
+    unsigned most = 0, n;
+    int ret;
+
+    /* Clean.*/
+    new_page(&ecc);
+    CHECK(nandEccCorrect(&ecc, data, PAGE_SIZE, spare) == 0);
+    CHECK(memcmp(data, orig, PAGE_SIZE) == 0);
+
+    /* Up to t bits per step, data or ECC, always t in one of them.*/
+    for (s = 0; s < steps; s++) {
+      n = s == run % steps ? t : test_rand() % (t + 1U);
+      flip(&ecc, s, n);
+      most = n > most ? n : most;
+    }
+    ret = nandEccCorrect(&ecc, data, PAGE_SIZE, spare);
+    CHECKF((ret == (int)most) && (memcmp(data, orig, PAGE_SIZE) == 0),
+           "BCH t=%u run %u: %d", t, run, ret);
+
+    /* Beyond the strength a miscorrection is possible, it is rare for
+       the stronger codes.*/
+    memcpy(data, orig, PAGE_SIZE);
+    memcpy(spare, orig_spare, SPARE_SIZE);
+    flip(&ecc, test_rand() % steps, t + 1U);
+    if (nandEccCorrect(&ecc, data, PAGE_SIZE, spare) ==
+        NAND_ECC_UNCORRECTABLE) {
+      detected++;
+    }
+  }
+  printf("BCH t=%u: %5.1f%% of %u bit errors detected\n",
+         t, 100.0 * detected / RUNS, t + 1U);
+  if (t >= 4U) {
+    CHECKF(detected >= RUNS * 9U / 10U, "BCH t=%u: %u", t, detected);
+  }
+}
+
+static void bench(nand_ecc_algo_t algo, uint8_t t, uint16_t step_size) {
+  nand_ecc_config_t cfg = {algo, t, step_size, SPARE_OFFSET};
+  double t0, enc, chk, fix;
+  unsigned i, n = algo == NAND_ECC_HAMMING ? 1U : t;
+
+  CHECK(nandEccInit(&ecc, &cfg));
+  new_page(&ecc);
+
+  t0 = bench_now();
+  for (i = 0; i < BENCH_PAGES; i++) {
+    nandEccCalculate(&ecc, data, PAGE_SIZE, spare);
+    BENCH_KEEP(spare);
+  }
+  enc = bench_now() - t0;
+
+  t0 = bench_now();
+  for (i = 0; i < BENCH_PAGES; i++) {
+    BENCH_KEEP(nandEccCorrect(&ecc, data, PAGE_SIZE, spare));
+  }
+  chk = bench_now() - t0;
+
+  /* One step with the most errors, the other steps clean.*/
+  fix = 0.0;
+  for (i = 0; i < BENCH_PAGES / 10U; i++) {
+    flip(&ecc, 0, n);
+    t0 = bench_now();
+    CHECK(nandEccCorrect(&ecc, data, PAGE_SIZE, spare) == (int)n);
+    fix += bench_now() - t0;
+    memcpy(spare, orig_spare, SPARE_SIZE);
+  }
+  CHECK(memcmp(data, orig, PAGE_SIZE) == 0);
+
+  printf("%-7s t=%u/%u: %6.2f us/KB encode, %6.2f us/KB check, "
+         "%7.1f us per page with %u errors\n",
+         algo == NAND_ECC_HAMMING ? "Hamming" : "BCH", n, step_size,
+         enc * 1e6 / BENCH_PAGES / (PAGE_SIZE / 1024U),
+         chk * 1e6 / BENCH_PAGES / (PAGE_SIZE / 1024U),
+         fix * 1e6 / (BENCH_PAGES / 10U), n);
+}
+
+int main(void) {
+  uint8_t t;
+
+  test_init();
+  test_hamming(256);
+  test_hamming(512);
+  for (t = 1; t <= NAND_ECC_BCH_MAX_T; t++) {
+    test_bch(t);
+  }
+
+  bench(NAND_ECC_HAMMING, 0, 256);
+  bench(NAND_ECC_HAMMING, 0, 512);
+  bench(NAND_ECC_BCH, 4, 512);
+  bench(NAND_ECC_BCH, 8, 512);
+
+  TEST_END();
+}
@@ -0,0 +1,327 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_nand_ram.c
+ * @brief   RAM backed NAND model test.
+ * @details Drives the model with the command sequences of the FSMCv1 NAND
+ *          driver: single pages, multi-page reads with and without cache
+ *          read, multi-page writes with and without cache program, erase
+ *          and failure injection. Then checks the array content and the
+ *          operation counters against what the sequences must cause.
+ */
+
+#include "nand_ram.h"
+#include "host_test.h"
+
+#define BLOCKS          16U
+#define PAGES           8U
+#define PAGE_SIZE       528U
+#define COLCYCLES       2U
+#define ROWCYCLES       3U
+
+static const nand_ram_config_t config = {
+  BLOCKS, PAGES, PAGE_SIZE, COLCYCLES, ROWCYCLES,
+  {0xEC, 0xF1, 0x00, 0x95, 0x40}
+};
+
+static uint8_t array[BLOCKS * PAGES * PAGE_SIZE];
+static uint8_t regs[2U * PAGE_SIZE];
+static uint8_t wbuf[PAGES * PAGE_SIZE], rbuf[PAGES * PAGE_SIZE];
+static nand_ram_t nand;
+
+static void send_addr(uint32_t block, uint32_t page, uint32_t col,
+                      bool with_col) {
+  uint32_t row = block * PAGES + page;
+  unsigned i;
+
+  if (with_col) {
+    for (i = 0; i < COLCYCLES; i++) {
+      nandRamWriteAddr(&nand, (uint8_t)(col >> (8U * i)));
+    }
+  }
+  for (i = 0; i < ROWCYCLES; i++) {
+    nandRamWriteAddr(&nand, (uint8_t)(row >> (8U * i)));
+  }
+}
+
+static uint8_t status(void) {
+
+  nandRamWriteCmd(&nand, 0x70);
+  return nandRamReadData(&nand);
+}
+
+static void read_out(uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    *p++ = nandRamReadData(&nand);
+  }
+}
+
+static void write_in(const uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    nandRamWriteData(&nand, *p++);
+  }
+}
+
+/* Multi-page read as the driver does it, 00h-30h per page or 00h-30h then
+   31h per page and 3Fh for the last one.*/
+static void read_pages(uint32_t block, uint32_t page, uint32_t npages,
+                       bool cache) {
+  uint32_t i;
+
+  nandRamWriteCmd(&nand, 0x00);
+  send_addr(block, page, 0, true);
+  nandRamWriteCmd(&nand, 0x30);
+  for (i = 0; i < npages; i++) {
+    if (cache) {
+      nandRamWriteCmd(&nand, i + 1U < npages ? 0x31 : 0x3F);
+    }
+    else if (i > 0U) {
+      nandRamWriteCmd(&nand, 0x00);
+      send_addr(block, page + i, 0, true);
+      nandRamWriteCmd(&nand, 0x30);
+    }
+    read_out(&rbuf[i * PAGE_SIZE], PAGE_SIZE);
+  }
+}
+
+/* Multi-page write as the driver does it, 80h-15h per page and 80h-10h for
+   the last one with cache program. Returns the status the driver returns,
+   FAIL and FAILC of the intermediate pages are accumulated.*/
+static uint8_t write_pages(uint32_t block, uint32_t page, uint32_t npages,
+                           bool cache) {
+  uint8_t acc = 0U, st;
+  uint32_t i;
+
+  for (i = 0; i < npages; i++) {
+    nandRamWriteCmd(&nand, 0x80);
+    send_addr(block, page + i, 0, true);
+    write_in(&wbuf[i * PAGE_SIZE], PAGE_SIZE);
+    nandRamWriteCmd(&nand, cache && (i + 1U < npages) ? 0x15 : 0x10);
+    st = status();
+    if (i + 1U < npages) {
+      acc |= st & 0x03U;
+    }
+  }
+  return acc != 0U ? st | 0x01U : st;
+}
+
+static uint8_t erase(uint32_t block) {
+
+  nandRamWriteCmd(&nand, 0x60);
+  send_addr(block, 0, 0, false);
+  nandRamWriteCmd(&nand, 0xD0);
+  return status();
+}
+
+static void fill(uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    *p++ = (uint8_t)test_rand();
+  }
+}
+
+static void test_init(void) {
+  nand_ram_config_t cfg = config;
+  uint8_t id[5];
+
+  CHECK(nandRamInit(&nand, &cfg, array, regs));
+  cfg.rowcycles = 0U;
+  CHECK(!nandRamInit(&nand, &cfg, array, regs));
+  cfg.rowcycles = 5U;
+  CHECK(!nandRamInit(&nand, &cfg, array, regs));
+  cfg.rowcycles = 4U;
+  cfg.colcycles = 5U;
+  CHECK(!nandRamInit(&nand, &cfg, array, regs));
+  cfg = config;
+  cfg.blocks = 0U;
+  CHECK(!nandRamInit(&nand, &cfg, array, regs));
+
+  CHECK(nandRamInit(&nand, &config, array, regs));
+  CHECK(status() == 0xE0U);
+  nandRamWriteCmd(&nand, 0x90);
+  nandRamWriteAddr(&nand, 0x00);
+  read_out(id, sizeof id);
+  CHECK(memcmp(id, config.id, sizeof id) == 0);
+  CHECK(nandRamReadData(&nand) == 0x00U);
+}
+
+static void test_single_page(void) {
+  uint8_t *p;
+  size_t i;
+
+  CHECK(nandRamInit(&nand, &config, array, regs));
+
+  /* Fresh array reads as erased.*/
+  read_pages(3, 5, 1, false);
+  for (i = 0; i < PAGE_SIZE; i++) {
+    CHECK(rbuf[i] == 0xFFU);
+  }
+
+  /* Program, read back.*/
+  fill(wbuf, PAGE_SIZE);
+  CHECK(write_pages(3, 5, 1, false) == 0xE0U);
+  CHECK(memcmp(nandRamPage(&nand, 3, 5), wbuf, PAGE_SIZE) == 0);
+  read_pages(3, 5, 1, false);
+  CHECK(memcmp(rbuf, wbuf, PAGE_SIZE) == 0);
+  CHECK(nandRamReadData(&nand) == 0xFFU);
+
+  /* Programming again only clears bits.*/
+  memset(&wbuf[PAGE_SIZE], 0x0F, PAGE_SIZE);
+  p = nandRamPage(&nand, 3, 5);
+  nandRamWriteCmd(&nand, 0x80);
+  send_addr(3, 5, 0, true);
+  write_in(&wbuf[PAGE_SIZE], PAGE_SIZE);
+  nandRamWriteCmd(&nand, 0x10);
+  for (i = 0; i < PAGE_SIZE; i++) {
+    CHECK(p[i] == (wbuf[i] & 0x0FU));
+  }
+
+  /* Partial program of the spare area leaves the data bytes alone.*/
+  nandRamWriteCmd(&nand, 0x80);
+  send_addr(4, 0, 512, true);
+  write_in(wbuf, 16);
+  nandRamWriteCmd(&nand, 0x10);
+  p = nandRamPage(&nand, 4, 0);
+  for (i = 0; i < 512; i++) {
+    CHECK(p[i] == 0xFFU);
+  }
+  CHECK(memcmp(&p[512], wbuf, 16) == 0);
+
+  /* Random data output.*/
+  read_pages(4, 0, 1, false);
+  nandRamWriteCmd(&nand, 0x05);
+  nandRamWriteAddr(&nand, 0x00);
+  nandRamWriteAddr(&nand, 0x02);
+  nandRamWriteCmd(&nand, 0xE0);
+  read_out(rbuf, 16);
+  CHECK(memcmp(rbuf, wbuf, 16) == 0);
+
+  /* Bytes past the end of the page are dropped.*/
+  nandRamWriteCmd(&nand, 0x80);
+  send_addr(4, 1, PAGE_SIZE - 1U, true);
+  write_in(wbuf, 4);
+  nandRamWriteCmd(&nand, 0x10);
+  CHECK(nandRamPage(&nand, 4, 1)[PAGE_SIZE - 1U] == wbuf[0]);
+  CHECK(nand.counters.bytes_in == PAGE_SIZE * 2U + 16U + 1U);
+  CHECK(nand.counters.bytes_out == PAGE_SIZE * 3U + 16U);
+
+  /* Erase.*/
+  CHECK(erase(3) == 0xE0U);
+  p = nandRamPage(&nand, 3, 0);
+  for (i = 0; i < PAGES * PAGE_SIZE; i++) {
+    CHECK(p[i] == 0xFFU);
+  }
+  CHECK(nandRamPage(&nand, 4, 0)[512] == wbuf[0]);
+  CHECK(nand.counters.erases == 1U);
+
+  /* Out of the array.*/
+  nandRamWriteCmd(&nand, 0x00);
+  send_addr(BLOCKS, 0, 0, true);
+  nandRamWriteCmd(&nand, 0x30);
+  CHECK((status() & 0x01U) != 0U);
+  CHECK((erase(BLOCKS) & 0x01U) != 0U);
+  nandRamWriteCmd(&nand, 0xFF);
+  CHECK(status() == 0xE0U);
+}
+
+static void test_multi_page(void) {
+  uint32_t n;
+
+  for (n = 1; n <= PAGES; n++) {
+    unsigned mode;
+
+    for (mode = 0; mode < 4U; mode++) {
+      bool cache_prog = (mode & 1U) != 0U;
+      bool cache_read = (mode & 2U) != 0U;
+      uint32_t first = PAGES - n;
+
+      CHECK(nandRamInit(&nand, &config, array, regs));
+      fill(wbuf, n * PAGE_SIZE);
+      memset(rbuf, 0, sizeof rbuf);
+
+      CHECK(write_pages(7, first, n, cache_prog) == 0xE0U);
+      CHECK(nand.counters.programs == n);
+      CHECK(nand.counters.cache_programs == (cache_prog ? n - 1U : 0U));
+      CHECK(memcmp(nandRamPage(&nand, 7, first), wbuf, n * PAGE_SIZE) == 0);
+
+      read_pages(7, first, n, cache_read);
+      CHECKF(memcmp(rbuf, wbuf, n * PAGE_SIZE) == 0, "%u pages, mode %u",
+             (unsigned)n, mode);
+      /* One array load per page, with 3Fh closing a cache read no page is
+         loaded ahead for nothing.*/
+      CHECKF(nand.counters.reads == n, "%u pages, mode %u: %u loads",
+             (unsigned)n, mode, (unsigned)nand.counters.reads);
+      CHECK(nand.counters.cache_reads == (cache_read ? n : 0U));
+      CHECK(nand.counters.bytes_out == n * PAGE_SIZE);
+      CHECK(nand.counters.bytes_in == n * PAGE_SIZE);
+
+      /* The neighbouring pages are untouched.*/
+      if (first > 0U) {
+        CHECK(nandRamPage(&nand, 7, first - 1U)[0] == 0xFFU);
+      }
+      CHECK(nandRamPage(&nand, 8, 0)[0] == 0xFFU);
+    }
+  }
+}
+
+static void test_failures_injected(void) {
+  uint8_t st;
+
+  CHECK(nandRamInit(&nand, &config, array, regs));
+  fill(wbuf, sizeof wbuf);
+  nand.fail_block = 5U;
+
+  CHECK((erase(5) & 0x01U) != 0U);
+  CHECK(erase(6) == 0xE0U);
+  CHECK(nand.counters.erases == 1U);
+
+  /* Single page.*/
+  CHECK(write_pages(5, 0, 1, false) == 0xE1U);
+  CHECK(nandRamPage(&nand, 5, 0)[0] == 0xFFU);
+  CHECK(nand.counters.programs == 0U);
+
+  /* A cache program reports the failure of the previous page with FAILC.*/
+  nandRamWriteCmd(&nand, 0x80);
+  send_addr(5, 1, 0, true);
+  write_in(wbuf, PAGE_SIZE);
+  nandRamWriteCmd(&nand, 0x15);
+  CHECK((status() & 0x03U) == 0x01U);
+  nandRamWriteCmd(&nand, 0x80);
+  send_addr(5, 2, 0, true);
+  write_in(wbuf, PAGE_SIZE);
+  nandRamWriteCmd(&nand, 0x10);
+  CHECK((status() & 0x03U) == 0x03U);
+
+  /* Multi-page, the driver reports an intermediate failure.*/
+  st = write_pages(5, 3, 3, true);
+  CHECK((st & 0x01U) != 0U);
+  nand.fail_block = NAND_RAM_NO_FAIL;
+  CHECK(write_pages(5, 3, 3, true) == 0xE0U);
+  CHECK(memcmp(nandRamPage(&nand, 5, 3), wbuf, 3U * PAGE_SIZE) == 0);
+}
+
+int main(void) {
+
+  test_init();
+  test_single_page();
+  test_multi_page();
+  test_failures_injected();
+
+  TEST_END();
+}
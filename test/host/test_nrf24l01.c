@@ -0,0 +1,661 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_nrf24l01.c
+ * @brief   nRF24L01 driver tests and benchmark.
+ * @details Two drivers, a PTX and a PRX, talk to two chip models over a
+ *          mock SPI. The models keep the three levels TX and RX FIFOs, the
+ *          STATUS flags and the IRQ line, packets go from a PTX chip to a
+ *          PRX chip as soon as CE is high. Without dynamic payloads a packet
+ *          is received only if its length matches RX_PW_P0, as on air where
+ *          a wrong length fails the CRC.
+ */
+
+#include <setjmp.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "nrf24l01.h"
+
+#include "host_test.h"
+
+/*===========================================================================*/
+/* Chip model.                                                               */
+/*===========================================================================*/
+
+#define PAD_CE                  0U
+#define PAD_IRQ                 1U
+#define FIFO_DEPTH              3U
+#define STATUS_FLAGS            (NRF24L01_DI_STATUS_RX_DR |                 \
+                                 NRF24L01_DI_STATUS_TX_DS |                 \
+                                 NRF24L01_DI_STATUS_MAX_RT)
+
+typedef struct {
+  uint8_t               pipe;
+  uint8_t               len;
+  uint8_t               data[NRF24L01_MAX_PL_LENGHT];
+} payload_t;
+
+typedef struct {
+  SPIDriver             spi;
+  bool                  selected;
+  bool                  ce;
+  uint8_t               regs[0x20];
+  payload_t             txf[FIFO_DEPTH];
+  unsigned              tx_n;
+  payload_t             rxf[FIFO_DEPTH];
+  unsigned              rx_n;
+  palcallback_t         irq_cb;
+  void                  *irq_arg;
+  bool                  irq_enabled;
+  bool                  irq_asserted;
+  unsigned              transfers;
+} chip_t;
+
+static chip_t chips[2];
+
+static void fifo_push(payload_t *fifo, unsigned *n, uint8_t pipe,
+                      const uint8_t *data, size_t len) {
+
+  if (*n < FIFO_DEPTH) {
+    fifo[*n].pipe = pipe;
+    fifo[*n].len = (uint8_t)len;
+    memcpy(fifo[*n].data, data, len);
+    (*n)++;
+  }
+}
+
+static void fifo_remove(payload_t *fifo, unsigned *n, unsigned i) {
+
+  memmove(&fifo[i], &fifo[i + 1U], (*n - i - 1U) * sizeof fifo[0]);
+  (*n)--;
+}
+
+static uint8_t chip_status(const chip_t *c) {
+  uint8_t status = c->regs[NRF24L01_AD_STATUS] & STATUS_FLAGS;
+
+  status |= c->rx_n > 0U ? (uint8_t)(c->rxf[0].pipe << 1) : 0x0EU;
+  if (c->tx_n == FIFO_DEPTH) {
+    status |= NRF24L01_DI_STATUS_TX_FULL;
+  }
+  return status;
+}
+
+static uint8_t chip_read_reg(const chip_t *c, uint8_t reg) {
+  uint8_t value;
+
+  switch (reg) {
+  case NRF24L01_AD_STATUS:
+    return chip_status(c);
+  case NRF24L01_AD_FIFO_STATUS:
+    value = 0;
+    if (c->tx_n == 0U) {
+      value |= NRF24L01_DI_FIFO_STATUS_TX_EMPTY;
+    }
+    if (c->tx_n == FIFO_DEPTH) {
+      value |= NRF24L01_DI_FIFO_STATUS_TX_FULL;
+    }
+    if (c->rx_n == 0U) {
+      value |= NRF24L01_DI_FIFO_STATUS_RX_EMPTY;
+    }
+    if (c->rx_n == FIFO_DEPTH) {
+      value |= NRF24L01_DI_FIFO_STATUS_RX_FULL;
+    }
+    return value;
+  default:
+    return c->regs[reg];
+  }
+}
+
+static bool chip_dpl(const chip_t *c) {
+
+  return ((c->regs[NRF24L01_AD_FEATURE] & NRF24L01_DI_FEATURE_EN_DPL) != 0U) &&
+         ((c->regs[NRF24L01_AD_DYNPD] & NRF24L01_DI_DYNPD_DPL_P0) != 0U);
+}
+
+static bool chip_is(const chip_t *c, bool prx) {
+  uint8_t config = c->regs[NRF24L01_AD_CONFIG];
+
+  return c->ce && ((config & NRF24L01_DI_CONFIG_PWR_UP) != 0U) &&
+         (((config & NRF24L01_DI_CONFIG_PRIM_RX) != 0U) == prx);
+}
+
+/**
+ * @brief   Updates the IRQ line, a falling edge calls the pad callback.
+ */
+static void chip_irq_update(chip_t *c) {
+  uint8_t flags = c->regs[NRF24L01_AD_STATUS] &
+                  (uint8_t)~c->regs[NRF24L01_AD_CONFIG] & STATUS_FLAGS;
+  bool asserted = flags != 0U;
+
+  if (asserted && !c->irq_asserted && c->irq_enabled && (c->irq_cb != NULL)) {
+    c->irq_asserted = true;
+    c->irq_cb(c->irq_arg);
+  }
+  c->irq_asserted = asserted;
+}
+
+static void chip_xfer(chip_t *c, size_t n, const uint8_t *tx, uint8_t *rx) {
+  uint8_t cmd = tx[0], reg = tx[0] & 0x1FU;
+  size_t i;
+
+  memset(rx, 0, n);
+  rx[0] = chip_status(c);
+  c->transfers++;
+
+  if (cmd < NRF24L01_CMD_WRITE) {
+    for (i = 1; i < n; i++) {
+      rx[i] = chip_read_reg(c, reg);
+    }
+  }
+  else if (cmd < 0x40U) {
+    if (reg == NRF24L01_AD_STATUS) {
+      c->regs[reg] &= (uint8_t)~(tx[1] & STATUS_FLAGS);
+    }
+    else if (n == 2U) {
+      c->regs[reg] = tx[1];
+    }
+  }
+  else if ((cmd & 0xF8U) == NRF24L01_CMD_W_ACK_PAYLOAD) {
+    fifo_push(c->txf, &c->tx_n, cmd & 7U, &tx[1], n - 1U);
+  }
+  else {
+    switch (cmd) {
+    case NRF24L01_CMD_R_RX_PAYLOAD:
+      if (c->rx_n > 0U) {
+        size_t len = c->rxf[0].len < n - 1U ? c->rxf[0].len : n - 1U;
+        memcpy(&rx[1], c->rxf[0].data, len);
+        fifo_remove(c->rxf, &c->rx_n, 0);
+      }
+      break;
+    case NRF24L01_CMD_R_RX_PL_WID:
+      rx[1] = c->rx_n > 0U ? c->rxf[0].len : 0U;
+      break;
+    case NRF24L01_CMD_W_TX_PAYLOAD:
+    case NRF24L01_CMD_W_TX_PAYLOAD_NOACK:
+      fifo_push(c->txf, &c->tx_n, 0, &tx[1], n - 1U);
+      break;
+    case NRF24L01_CMD_FLUSH_TX:
+      c->tx_n = 0;
+      break;
+    case NRF24L01_CMD_FLUSH_RX:
+      c->rx_n = 0;
+      break;
+    default:
+      break;
+    }
+  }
+  chip_irq_update(c);
+}
+
+/**
+ * @brief   Sends the head payload of a PTX chip, if any.
+ * @details The PTX chip stops on MAX_RT until the flag is cleared.
+ */
+static bool air_step(chip_t *c, chip_t *r) {
+  const payload_t *p;
+  bool ok;
+
+  if (!chip_is(c, false) || (c->tx_n == 0U) ||
+      ((c->regs[NRF24L01_AD_STATUS] & NRF24L01_DI_STATUS_MAX_RT) != 0U)) {
+    return false;
+  }
+
+  p = &c->txf[0];
+  ok = chip_is(r, true) && (r->rx_n < FIFO_DEPTH) &&
+       (chip_dpl(r) ? chip_dpl(c) :
+                      p->len == r->regs[NRF24L01_AD_RX_PW_P0]);
+  if (ok) {
+    unsigned i;
+
+    fifo_push(r->rxf, &r->rx_n, 0, p->data, p->len);
+    r->regs[NRF24L01_AD_STATUS] |= NRF24L01_DI_STATUS_RX_DR;
+    for (i = 0; i < r->tx_n; i++) {
+      if (r->txf[i].pipe == 0U) {
+        fifo_push(c->rxf, &c->rx_n, 0, r->txf[i].data, r->txf[i].len);
+        c->regs[NRF24L01_AD_STATUS] |= NRF24L01_DI_STATUS_RX_DR;
+        r->regs[NRF24L01_AD_STATUS] |= NRF24L01_DI_STATUS_TX_DS;
+        fifo_remove(r->txf, &r->tx_n, i);
+        break;
+      }
+    }
+    fifo_remove(c->txf, &c->tx_n, 0);
+    c->regs[NRF24L01_AD_STATUS] |= NRF24L01_DI_STATUS_TX_DS;
+  }
+  else {
+    c->regs[NRF24L01_AD_STATUS] |= NRF24L01_DI_STATUS_MAX_RT;
+  }
+  chip_irq_update(c);
+  chip_irq_update(r);
+  return true;
+}
+
+/*===========================================================================*/
+/* SPI and PAL.                                                              */
+/*===========================================================================*/
+
+void palSetPad(ioportid_t port, uint32_t pad) {
+
+  if (pad == PAD_CE) {
+    chips[port].ce = true;
+  }
+}
+
+void palClearPad(ioportid_t port, uint32_t pad) {
+
+  if (pad == PAD_CE) {
+    chips[port].ce = false;
+  }
+}
+
+uint32_t palReadPad(ioportid_t port, uint32_t pad) {
+
+  CHECK(pad == PAD_IRQ);
+  return chips[port].irq_asserted ? PAL_LOW : PAL_HIGH;
+}
+
+void palSetPadCallback(ioportid_t port, uint32_t pad, palcallback_t cb,
+                       void *arg) {
+
+  CHECK(pad == PAD_IRQ);
+  chips[port].irq_cb = cb;
+  chips[port].irq_arg = arg;
+}
+
+void palEnablePadEvent(ioportid_t port, uint32_t pad, uint32_t mode) {
+
+  CHECK((pad == PAD_IRQ) && (mode == PAL_EVENT_MODE_FALLING_EDGE));
+  chips[port].irq_enabled = true;
+}
+
+void palDisablePadEvent(ioportid_t port, uint32_t pad) {
+
+  CHECK(pad == PAD_IRQ);
+  chips[port].irq_enabled = false;
+}
+
+void spiStart(SPIDriver *spip, const SPIConfig *config) {
+
+  spip->config = config;
+}
+
+void spiStop(SPIDriver *spip) {
+
+  spip->config = NULL;
+}
+
+void spiSelect(SPIDriver *spip) {
+
+  CHECK(!chips[spip->id].selected);
+  chips[spip->id].selected = true;
+}
+
+void spiUnselect(SPIDriver *spip) {
+
+  chips[spip->id].selected = false;
+}
+
+void spiExchange(SPIDriver *spip, size_t n, const void *txbuf, void *rxbuf) {
+
+  CHECK(chips[spip->id].selected && (spip->config != NULL));
+  chip_xfer(&chips[spip->id], n, txbuf, rxbuf);
+}
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf) {
+  uint8_t rxbuf[NRF24L01_MAX_PL_LENGHT + 1];
+
+  spiExchange(spip, n, txbuf, rxbuf);
+}
+
+void spiReceive(SPIDriver *spip, size_t n, void *rxbuf) {
+  uint8_t txbuf[NRF24L01_MAX_PL_LENGHT + 1];
+
+  memset(txbuf, NRF24L01_CMD_NOP, n);
+  spiExchange(spip, n, txbuf, rxbuf);
+}
+
+/*===========================================================================*/
+/* Threads.                                                                  */
+/*===========================================================================*/
+
+static thread_t threads[2];
+static unsigned nthreads;
+static thread_t *current;
+static jmp_buf thread_wait;
+
+thread_t *chThdCreateStatic(void *wsp, size_t size, tprio_t prio,
+                            tfunc_t pf, void *arg) {
+  thread_t *tp = &threads[nthreads++];
+
+  (void)wsp;
+  (void)size;
+  (void)prio;
+  memset(tp, 0, sizeof *tp);
+  tp->func = pf;
+  tp->arg = arg;
+  return tp;
+}
+
+bool chThdShouldTerminateX(void) {
+
+  return current->terminate;
+}
+
+void chThdExit(msg_t msg) {
+
+  (void)msg;
+  current->done = true;
+  longjmp(thread_wait, 1);
+}
+
+eventmask_t chEvtWaitAny(eventmask_t events) {
+  eventmask_t m = current->epending & events;
+
+  if (m == 0U) {
+    longjmp(thread_wait, 1);
+  }
+  current->epending &= ~m;
+  return m;
+}
+
+/**
+ * @brief   Runs a thread until it waits, if it has pending events.
+ */
+static bool thread_run(thread_t *tp) {
+
+  if (tp->done || (tp->epending == 0U)) {
+    return false;
+  }
+  current = tp;
+  if (setjmp(thread_wait) == 0) {
+    tp->func(tp->arg);
+  }
+  current = NULL;
+  return true;
+}
+
+/**
+ * @brief   Runs threads and air until nothing happens.
+ */
+static void sched_run(void) {
+  unsigned guard = 0;
+  bool busy;
+
+  do {
+    unsigned i;
+
+    busy = air_step(&chips[0], &chips[1]) | air_step(&chips[1], &chips[0]);
+    for (i = 0; i < nthreads; i++) {
+      busy |= thread_run(&threads[i]);
+    }
+  } while (busy && (++guard < 10000U));
+  CHECK(guard < 10000U);
+}
+
+msg_t chThdWait(thread_t *tp) {
+
+  while (!tp->done && thread_run(tp)) {
+  }
+  CHECK(tp->done);
+  return MSG_OK;
+}
+
+msg_t chSemWaitTimeout(semaphore_t *sp, sysinterval_t timeout) {
+
+  if ((sp->cnt <= 0) && (timeout != TIME_IMMEDIATE)) {
+    sched_run();
+  }
+  if (sp->cnt <= 0) {
+    return MSG_TIMEOUT;
+  }
+  sp->cnt--;
+  return MSG_OK;
+}
+
+/*===========================================================================*/
+/* Tests.                                                                    */
+/*===========================================================================*/
+
+static const SPIConfig spicfg = {0};
+static NRF24L01_Config config[2];
+static NRF24L01Driver ptx, prx;
+
+static void setup(bool dpl, bool ack_pay, bool start_prx) {
+  unsigned i;
+
+  memset(chips, 0, sizeof chips);
+  nthreads = 0;
+  for (i = 0; i < 2U; i++) {
+    chips[i].spi.id = i;
+    memset(&config[i], 0, sizeof config[i]);
+    config[i].ceport = i;
+    config[i].cepad = PAD_CE;
+    config[i].irqport = i;
+    config[i].irqpad = PAD_IRQ;
+    config[i].spip = &chips[i].spi;
+    config[i].spicfg = &spicfg;
+    config[i].auto_retr_count = NRF24L01_ARC_15_times;
+    config[i].auto_retr_delay = NRF24L01_ARD_500us;
+    config[i].address_width = NRF24L01_AW_5_bytes;
+    config[i].channel_freq = 76;
+    config[i].data_rate = NRF24L01_ADR_2Mbps;
+    config[i].out_pwr = NRF24L01_PWR_0dBm;
+    config[i].lna = NRF24L01_LNA_enabled;
+    config[i].en_dpl = dpl ? NRF24L01_DPL_enabled : NRF24L01_DPL_disabled;
+    config[i].en_ack_pay = ack_pay ? NRF24L01_ACK_PAY_enabled :
+                                     NRF24L01_ACK_PAY_disabled;
+    config[i].en_dyn_ack = NRF24L01_DYN_ACK_disabled;
+  }
+
+  nrf24l01ObjectInit(&ptx);
+  nrf24l01ObjectInit(&prx);
+  nrf24l01Start(&ptx, &config[0]);
+  if (start_prx) {
+    nrf24l01Start(&prx, &config[1]);
+    nrf24l01SetMode(&prx, NRF24L01_MODE_PRX);
+  }
+  sched_run();
+}
+
+static void teardown(void) {
+
+  nrf24l01Stop(&ptx);
+  nrf24l01Stop(&prx);
+}
+
+static msg_t send(NRF24L01Driver *devp, uint8_t len, uint8_t seed,
+                  sysinterval_t timeout) {
+  NRF24L01_packet_t pkt;
+  uint8_t i;
+
+  pkt.pipe = 0;
+  pkt.length = len;
+  pkt.noack = false;
+  for (i = 0; i < len; i++) {
+    pkt.data[i] = (uint8_t)(seed + i);
+  }
+  return nrf24l01Send(devp, &pkt, timeout);
+}
+
+static bool check_data(const NRF24L01_packet_t *pkt, uint8_t len,
+                       uint8_t seed) {
+  uint8_t i;
+
+  for (i = 0; i < pkt->length; i++) {
+    if (pkt->data[i] != (i < len ? (uint8_t)(seed + i) : 0U)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief   Fixed length payloads, shorter packets are padded.
+ */
+static void test_fixed_length(void) {
+  static const uint8_t lengths[] = {1, 5, 31, 32};
+  NRF24L01_packet_t pkt;
+  unsigned i;
+
+  setup(false, false, true);
+  for (i = 0; i < sizeof lengths; i++) {
+    CHECK(send(&ptx, lengths[i], (uint8_t)(i * 16U), TIME_IMMEDIATE) == MSG_OK);
+  }
+  sched_run();
+
+  CHECK(ptx.tx_done == sizeof lengths);
+  CHECK(ptx.tx_failed == 0U);
+  CHECK((ptx.event.flags & NRF24L01_EVT_TX_DONE) != 0U);
+  CHECK((prx.event.flags & NRF24L01_EVT_RX) != 0U);
+  for (i = 0; i < sizeof lengths; i++) {
+    CHECK(nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_OK);
+    CHECK(pkt.length == NRF24L01_MAX_PL_LENGHT);
+    CHECKF(check_data(&pkt, lengths[i], (uint8_t)(i * 16U)),
+           "packet %u", i);
+  }
+  CHECK(nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_TIMEOUT);
+  teardown();
+}
+
+/**
+ * @brief   Dynamic payloads, with ACK payloads back to the PTX.
+ */
+static void test_dynamic_length(void) {
+  NRF24L01_packet_t pkt;
+  uint8_t len;
+
+  setup(true, true, true);
+  CHECK(send(&prx, 3, 0xA0, TIME_IMMEDIATE) == MSG_OK);
+  sched_run();
+  CHECK(chips[1].tx_n == 1U);
+
+  for (len = 1; len <= NRF24L01_MAX_PL_LENGHT; len++) {
+    CHECK(send(&ptx, len, len, TIME_INFINITE) == MSG_OK);
+    sched_run();
+    CHECK(nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_OK);
+    CHECKF((pkt.length == len) && check_data(&pkt, len, len),
+           "length %u", len);
+  }
+  CHECK(ptx.tx_done == NRF24L01_MAX_PL_LENGHT);
+  CHECK(prx.tx_done == 1U);
+  CHECK(nrf24l01Receive(&ptx, &pkt, TIME_IMMEDIATE) == MSG_OK);
+  CHECK((pkt.length == 3U) && check_data(&pkt, 3, 0xA0));
+  teardown();
+}
+
+/**
+ * @brief   No receiver, the packet fails and the following ones are sent.
+ */
+static void test_max_rt(void) {
+  NRF24L01_packet_t pkt;
+
+  setup(false, false, false);
+  CHECK(send(&ptx, 8, 0, TIME_IMMEDIATE) == MSG_OK);
+  CHECK(send(&ptx, 8, 1, TIME_IMMEDIATE) == MSG_OK);
+  sched_run();
+  CHECK(ptx.tx_failed == 2U);
+  CHECK(ptx.tx_done == 0U);
+  CHECK((ptx.event.flags & NRF24L01_EVT_TX_FAILED) != 0U);
+  CHECK(ptx.tx_count == 0U);
+  CHECK(!chips[0].ce);
+
+  /* A receiver shows up.*/
+  nrf24l01Start(&prx, &config[1]);
+  nrf24l01SetMode(&prx, NRF24L01_MODE_PRX);
+  CHECK(send(&ptx, 8, 2, TIME_IMMEDIATE) == MSG_OK);
+  sched_run();
+  CHECK(ptx.tx_done == 1U);
+  CHECK(nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_OK);
+  CHECK(check_data(&pkt, 8, 2));
+  teardown();
+}
+
+/**
+ * @brief   Full TX queue, then delivery in queue order.
+ */
+static void test_queue(void) {
+  NRF24L01_packet_t pkt;
+  unsigned i;
+
+  setup(true, false, true);
+  /* The driver thread does not run until sched_run().*/
+  for (i = 0; i < NRF24L01_TX_QUEUE_SIZE; i++) {
+    CHECK(send(&ptx, 4, (uint8_t)i, TIME_IMMEDIATE) == MSG_OK);
+  }
+  CHECK(send(&ptx, 4, 0xFF, TIME_IMMEDIATE) == MSG_TIMEOUT);
+  sched_run();
+  CHECK(ptx.tx_done == NRF24L01_TX_QUEUE_SIZE);
+  for (i = 0; i < NRF24L01_TX_QUEUE_SIZE; i++) {
+    CHECK(nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_OK);
+    CHECKF((pkt.length == 4U) && check_data(&pkt, 4, (uint8_t)i),
+           "packet %u", i);
+  }
+  teardown();
+  CHECK(threads[0].done && threads[1].done);
+  CHECK(ptx.state == NRF24L01_STOP);
+}
+
+/**
+ * @brief   SPI transfers per packet, both sides, dynamic payloads.
+ */
+static void bench_stream(void) {
+  const unsigned packets = 100000, batch = NRF24L01_TX_QUEUE_SIZE / 2;
+  NRF24L01_packet_t pkt;
+  unsigned i, j, received = 0, ptx_xfers, prx_xfers;
+  double t;
+
+  setup(true, false, true);
+  ptx_xfers = chips[0].transfers;
+  prx_xfers = chips[1].transfers;
+  t = bench_now();
+  for (i = 0; i < packets; i += batch) {
+    for (j = 0; j < batch; j++) {
+      (void)send(&ptx, NRF24L01_MAX_PL_LENGHT, (uint8_t)(i + j),
+                 TIME_INFINITE);
+    }
+    sched_run();
+    while (nrf24l01Receive(&prx, &pkt, TIME_IMMEDIATE) == MSG_OK) {
+      received++;
+    }
+  }
+  t = bench_now() - t;
+  ptx_xfers = chips[0].transfers - ptx_xfers;
+  prx_xfers = chips[1].transfers - prx_xfers;
+
+  CHECK(received == packets);
+  CHECK(ptx.tx_failed == 0U);
+  printf("stream, %u packets: PTX %.2f, PRX %.2f SPI transfers/packet, "
+         "%.0f ns/packet host time\n", packets,
+         (double)ptx_xfers / packets, (double)prx_xfers / packets,
+         t * 1e9 / packets);
+  /* Load, STATUS write, plus one FIFO_STATUS check per two packets at
+     most; PL_WID, payload read, STATUS write and the empty PL_WID probe.*/
+  CHECK(ptx_xfers <= packets * 3U);
+  CHECK(prx_xfers <= packets * 4U);
+  teardown();
+}
+
+int main(void) {
+
+  test_fixed_length();
+  test_dynamic_length();
+  test_max_rt();
+  test_queue();
+  bench_stream();
+
+  TEST_END();
+}
@@ -0,0 +1,545 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_onewire_bus.c
+ * @brief   1-wire bus manager test.
+ * @details Runs the bus manager over the UART backend of the 1-wire driver,
+ *          the UART being a model of a bus with DS18B20 devices that can be
+ *          attached, detached or put in alarm. Checks the slot cache, the
+ *          incremental revalidation without full searches and that Skip ROM
+ *          is only used on a bus known to hold a single device, then prints
+ *          the timeslots of a poll.
+ */
+
+#include "hal.h"
+#include "onewire_bus.h"
+#include "host_test.h"
+
+#define SIM_DEVICES     6U
+#define BUS_SLOTS       8U
+
+/*===========================================================================*/
+/* Bus model.                                                                */
+/*===========================================================================*/
+
+typedef struct {
+  uint8_t       rom[8];
+  uint8_t       scratchpad[ONEWIRE_BUS_SCRATCHPAD_SIZE];
+  bool          online;
+  bool          alarm;
+  bool          od_capable;
+  bool          od;
+  bool          active;
+} sim_device_t;
+
+typedef enum {
+  SIM_ROM_CMD, SIM_SEARCH, SIM_MATCH, SIM_FUNC_CMD, SIM_READ, SIM_IDLE
+} sim_state_t;
+
+static sim_device_t sim_devs[SIM_DEVICES];
+
+static struct {
+  sim_state_t   state;
+  unsigned      bit;
+  unsigned      phase;
+  uint8_t       cmd;
+  bool          skip;
+  uint8_t       *rxbuf;
+  size_t        n;
+  /* Counters.*/
+  unsigned long slots;
+  unsigned      searches;           /* Search passes, one per device.*/
+  unsigned      alarm_searches;
+  unsigned      skip_reads;
+  unsigned      match_reads;
+} sim;
+
+static UARTDriver UARTD;
+
+static unsigned rom_bit(const uint8_t *p, unsigned bit) {
+
+  return (p[bit / 8U] >> (bit % 8U)) & 1U;
+}
+
+static void sim_rom_cmd(uint8_t cmd) {
+  unsigned d;
+
+  sim.bit = 0;
+  sim.phase = 0;
+  sim.cmd = 0;
+  sim.skip = false;
+  switch (cmd) {
+  case ONEWIRE_CMD_ALARM_SEARCH:
+    sim.alarm_searches++;
+    for (d = 0; d < SIM_DEVICES; d++)
+      sim_devs[d].active &= sim_devs[d].alarm;
+    sim.state = SIM_SEARCH;
+    break;
+  case ONEWIRE_CMD_SEARCH_ROM:
+    sim.searches++;
+    sim.state = SIM_SEARCH;
+    break;
+  case ONEWIRE_CMD_MATCH_ROM:
+    sim.state = SIM_MATCH;
+    break;
+  case ONEWIRE_CMD_OVERDRIVE_SKIP_ROM:
+    for (d = 0; d < SIM_DEVICES; d++) {
+      sim_devs[d].od = sim_devs[d].active && sim_devs[d].od_capable;
+      sim_devs[d].active = sim_devs[d].od;
+    }
+    /* Falls through.*/
+  case ONEWIRE_CMD_SKIP_ROM:
+    sim.skip = true;
+    sim.state = SIM_FUNC_CMD;
+    break;
+  default:
+    sim.state = SIM_IDLE;
+    break;
+  }
+}
+
+/* One timeslot, returns the echo of the UART character.*/
+static uint8_t sim_slot(uint32_t speed, uint8_t tx) {
+  bool od = (1000000U == speed);
+  bool mw = (0xFFU == tx), line = mw, presence = false;
+  unsigned d;
+
+  sim.slots++;
+
+  /* Reset pulses, a standard one takes every device to standard speed.*/
+  if ((9600U == speed) || ((115200U == speed) && (0xE0U == tx))) {
+    od = (9600U != speed);
+    for (d = 0; d < SIM_DEVICES; d++) {
+      sim_device_t *dp = &sim_devs[d];
+      if (!od)
+        dp->od = false;
+      dp->active = dp->online && (dp->od == od);
+      presence |= dp->active;
+    }
+    sim.state = SIM_ROM_CMD;
+    sim.bit = 0;
+    sim.cmd = 0;
+    return presence ? (uint8_t)(tx & 0xC0U) : tx;
+  }
+
+  for (d = 0; d < SIM_DEVICES; d++) {
+    sim_device_t *dp = &sim_devs[d];
+    bool on = dp->active && dp->online && (dp->od == od);
+
+    switch (sim.state) {
+    case SIM_SEARCH:
+      if (on && (sim.phase < 2U) &&
+          ((rom_bit(dp->rom, sim.bit) ^ sim.phase) == 0U))
+        line = false;
+      if ((2U == sim.phase) && (rom_bit(dp->rom, sim.bit) != mw))
+        dp->active = false;
+      break;
+    case SIM_MATCH:
+      if (rom_bit(dp->rom, sim.bit) != mw)
+        dp->active = false;
+      break;
+    case SIM_READ:
+      if (on && (sim.bit < 8U * ONEWIRE_BUS_SCRATCHPAD_SIZE) &&
+          (0U == rom_bit(dp->scratchpad, sim.bit)))
+        line = false;
+      break;
+    default:
+      break;
+    }
+  }
+
+  switch (sim.state) {
+  case SIM_ROM_CMD:
+    sim.cmd |= (uint8_t)(mw << sim.bit);
+    if (8U == ++sim.bit)
+      sim_rom_cmd(sim.cmd);
+    break;
+  case SIM_SEARCH:
+    if (3U == ++sim.phase) {
+      sim.phase = 0;
+      if (64U == ++sim.bit)
+        sim.state = SIM_IDLE;
+    }
+    break;
+  case SIM_MATCH:
+    if (64U == ++sim.bit) {
+      sim.bit = 0;
+      sim.state = SIM_FUNC_CMD;
+    }
+    break;
+  case SIM_FUNC_CMD:
+    sim.cmd |= (uint8_t)(mw << sim.bit);
+    if (8U == ++sim.bit) {
+      sim.bit = 0;
+      if (ONEWIRE_CMD_READ_SCRATCHPAD == sim.cmd) {
+        if (sim.skip)
+          sim.skip_reads++;
+        else
+          sim.match_reads++;
+        sim.state = SIM_READ;
+      }
+      else {
+        /* Conversions are over at once, read slots stay high.*/
+        sim.state = SIM_IDLE;
+      }
+    }
+    break;
+  case SIM_READ:
+    sim.bit++;
+    break;
+  default:
+    break;
+  }
+  return line ? 0xFFU : 0xFEU;
+}
+
+void uartStart(UARTDriver *uartp, const UARTConfig *config) {
+
+  uartp->config = config;
+  uartp->state = UART_READY;
+}
+
+void uartStop(UARTDriver *uartp) {
+
+  uartp->state = UART_STOP;
+}
+
+void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf) {
+
+  (void)uartp;
+  sim.rxbuf = rxbuf;
+  sim.n = n;
+}
+
+void uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf) {
+
+  /* Same buffer as the receive one, the echo replaces it.*/
+  (void)uartp;
+  (void)n;
+  (void)txbuf;
+}
+
+msg_t osalThreadSuspendS(thread_reference_t *trp) {
+  size_t i;
+
+  (void)trp;
+  for (i = 0; i < sim.n; i++)
+    sim.rxbuf[i] = sim_slot(UARTD.config->speed, sim.rxbuf[i]);
+  UARTD.config->rxend_cb(&UARTD);
+  return MSG_OK;
+}
+
+/* Device d at (d * 10 - 20) + d / 16 degrees.*/
+static void sim_init(void) {
+  unsigned d, i;
+
+  memset(&sim, 0, sizeof sim);
+  memset(sim_devs, 0, sizeof sim_devs);
+  for (d = 0; d < SIM_DEVICES; d++) {
+    sim_device_t *dp = &sim_devs[d];
+    int16_t raw = (int16_t)(((int)d * 10 - 20) * 16 + (int)d);
+
+    dp->rom[0] = ONEWIRE_FAMILY_DS18B20;
+    for (i = 1; i < 7; i++)
+      dp->rom[i] = (uint8_t)test_rand();
+    dp->rom[7] = onewireCRC(dp->rom, 7);
+    dp->scratchpad[0] = (uint8_t)raw;
+    dp->scratchpad[1] = (uint8_t)((uint16_t)raw >> 8);
+    dp->scratchpad[4] = 0x7F;
+    dp->scratchpad[8] = onewireCRC(dp->scratchpad, 8);
+  }
+}
+
+static int32_t sim_millicelsius(unsigned d) {
+
+  return (((int32_t)d * 10 - 20) * 16 + (int32_t)d) * 1000 / 16;
+}
+
+/*===========================================================================*/
+/* Test.                                                                     */
+/*===========================================================================*/
+
+static onewireDriver OWD;
+static onewire_bus_device_t devices[BUS_SLOTS];
+static uint8_t searchbuf[8 * BUS_SLOTS];
+static const UARTConfig uartcfg = {NULL, NULL, NULL, 0};
+static const onewireConfig owcfg = {
+  .uartd            = &UARTD,
+  .uartcfg          = &uartcfg,
+  .port             = 0,
+  .pad              = 0,
+  .pad_mode_active  = 0
+};
+
+static onewireBusConfig buscfg = {
+  .owp              = &OWD,
+  .devices          = devices,
+  .max_devices      = BUS_SLOTS,
+  .searchbuf        = searchbuf,
+  .convert_time     = 100,
+  .parasite         = false,
+  .max_errors       = 2,
+  .scan_interval    = 0
+};
+
+static onewireBus bus;
+
+/* Slot of a simulated device, -1 if not cached.*/
+static int slot_of(unsigned d) {
+  unsigned i;
+
+  for (i = 0; i < BUS_SLOTS; i++) {
+    if ((devices[i].flags & ONEWIRE_BUS_USED) &&
+        (0 == memcmp(devices[i].rom, sim_devs[d].rom, 8)))
+      return (int)i;
+  }
+  return -1;
+}
+
+/* Checks the cached reading of a simulated device.*/
+static bool check_device(unsigned d) {
+  int32_t mc;
+  int s = slot_of(d);
+
+  return (s >= 0) && (devices[s].flags & ONEWIRE_BUS_PRESENT) &&
+         onewireBusGetTemperature(&devices[s], &mc) &&
+         (mc == sim_millicelsius(d));
+}
+
+static void bus_start(uint16_t scan_interval) {
+
+  buscfg.scan_interval = scan_interval;
+  onewireBusObjectInit(&bus, &buscfg);
+}
+
+static void test_cache(void) {
+  unsigned d, searches;
+  int slot1;
+
+  sim_init();
+  for (d = 0; d < 3; d++)
+    sim_devs[d].online = true;
+  bus_start(0);
+
+  /* First poll, one full search.*/
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(3 == sim.searches);
+  searches = sim.searches;
+  CHECK(3 == bus.present);
+  CHECK(0 == sim.skip_reads);
+  for (d = 0; d < 3; d++)
+    CHECKF(check_device(d), "device %u", d);
+  slot1 = slot_of(1);
+
+  /* Following polls, no search.*/
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(searches == sim.searches);
+
+  /* A device gone is dropped after max_errors polls, without a search.*/
+  sim_devs[1].online = false;
+  CHECK(2 == onewireBusPoll(&bus));
+  CHECK(3 == bus.present);
+  CHECK(2 == onewireBusPoll(&bus));
+  CHECK(2 == bus.present);
+  CHECK(!onewireBusNeedsScan(&bus));
+  CHECK(2 == onewireBusPoll(&bus));
+  CHECK(searches == sim.searches);
+  CHECK(check_device(0) && check_device(2));
+
+  /* Back again, revalidated in its slot with a Match ROM read.*/
+  sim_devs[1].online = true;
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(3 == bus.present);
+  CHECK(slot1 == slot_of(1));
+  CHECK(check_device(1));
+  CHECK(searches == sim.searches);
+
+  /* An unknown device in alarm is added by the alarm search.*/
+  sim_devs[3].online = true;
+  sim_devs[3].alarm = true;
+  sim_devs[0].alarm = true;
+  CHECK(2 == onewireBusAlarmScan(&bus));
+  CHECK(searches == sim.searches);
+  CHECK(2 == sim.alarm_searches);
+  CHECK(4 == bus.present);
+  CHECK((slot_of(3) >= 0) &&
+        (devices[slot_of(3)].flags & ONEWIRE_BUS_ALARM));
+  CHECK(devices[slot_of(0)].flags & ONEWIRE_BUS_ALARM);
+  CHECK(0 == (devices[slot_of(1)].flags & ONEWIRE_BUS_ALARM));
+  CHECK(4 == onewireBusPoll(&bus));
+  CHECK(check_device(3));
+  CHECK(searches == sim.searches);
+
+  /* A device that never raises an alarm is found by a full search.*/
+  sim_devs[4].online = true;
+  CHECK(4 == onewireBusPoll(&bus));
+  CHECK(slot_of(4) < 0);
+  CHECK(5 == onewireBusScan(&bus));
+  CHECK(5 == onewireBusPoll(&bus));
+  CHECK(check_device(4));
+  for (d = 0; d < 5; d++)
+    CHECKF(check_device(d), "device %u", d);
+  CHECK(0 == sim.skip_reads);
+}
+
+static void test_skip_rom(void) {
+  unsigned d;
+
+  /* A search finding a single device enables Skip ROM.*/
+  sim_init();
+  sim_devs[0].online = true;
+  bus_start(0);
+  CHECK(1 == onewireBusPoll(&bus));
+  CHECK(bus.single);
+  CHECK(1 == sim.skip_reads);
+  CHECK(0 == sim.match_reads);
+  CHECK(check_device(0));
+
+  /* One device left in the cache but another one, not cached, on the bus:
+     Skip ROM would read both at once.*/
+  sim_init();
+  sim_devs[0].online = true;
+  sim_devs[1].online = true;
+  bus_start(0);
+  CHECK(2 == onewireBusPoll(&bus));
+  sim_devs[1].online = false;
+  for (d = 0; d < 3; d++)
+    (void)onewireBusPoll(&bus);
+  CHECK(1 == bus.present);
+  sim_devs[2].online = true;
+  for (d = 0; d < 3; d++)
+    CHECK(1 == onewireBusPoll(&bus));
+  CHECK(!bus.single);
+  CHECK(0 == sim.skip_reads);
+  CHECK(check_device(0));
+
+  /* The single device found coming back with a second one.*/
+  sim_init();
+  sim_devs[0].online = true;
+  sim_devs[1].alarm = true;
+  bus_start(0);
+  CHECK(1 == onewireBusPoll(&bus));
+  CHECK(bus.single);
+  sim_devs[1].online = true;
+  CHECK(1 == onewireBusAlarmScan(&bus));
+  CHECK(!bus.single);
+  sim.skip_reads = 0;
+  CHECK(2 == onewireBusPoll(&bus));
+  CHECK(0 == sim.skip_reads);
+  CHECK(check_device(0) && check_device(1));
+}
+
+static void test_scan_interval(void) {
+  unsigned i;
+
+  sim_init();
+  sim_devs[0].online = true;
+  sim_devs[1].online = true;
+  bus_start(3);
+  CHECK(2 == onewireBusPoll(&bus));
+  CHECK(2 == sim.searches);
+  sim_devs[2].online = true;
+  for (i = 0; i < 2; i++)
+    (void)onewireBusPoll(&bus);
+  CHECK(2 == sim.searches);
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(5 == sim.searches);
+  CHECK(check_device(2));
+}
+
+static void test_overdrive(void) {
+  unsigned d;
+
+  sim_init();
+  for (d = 0; d < 3; d++) {
+    sim_devs[d].online = true;
+    sim_devs[d].od_capable = (d != 1);
+  }
+  bus_start(0);
+  CHECK(3 == onewireBusPoll(&bus));
+
+  /* Refused while a device does not support it.*/
+  CHECK(!onewireBusSetOverdrive(&bus, true));
+  CHECK(3 == onewireBusPoll(&bus));
+
+  sim_devs[1].od_capable = true;
+  CHECK(onewireBusSetOverdrive(&bus, true));
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(bus.overdrive);
+  for (d = 0; d < 3; d++)
+    CHECKF(sim_devs[d].od && check_device(d), "device %u", d);
+
+  /* A device lost in overdrive requests a search at standard speed.*/
+  sim_devs[2].online = false;
+  (void)onewireBusPoll(&bus);
+  (void)onewireBusPoll(&bus);
+  CHECK(onewireBusNeedsScan(&bus));
+  sim_devs[2].online = true;
+  sim_devs[2].od = false;
+  CHECK(3 == onewireBusPoll(&bus));
+  CHECK(bus.overdrive);
+  CHECK(sim_devs[2].od && check_device(2));
+}
+
+static void bench_poll(void) {
+  unsigned long slots;
+  unsigned d;
+
+  sim_init();
+  for (d = 0; d < SIM_DEVICES; d++)
+    sim_devs[d].online = true;
+  bus_start(0);
+
+  sim.slots = 0;
+  CHECK(SIM_DEVICES == onewireBusPoll(&bus));
+  printf("first poll, %u devices:          %6lu timeslots\n",
+         SIM_DEVICES, sim.slots);
+  slots = sim.slots;
+
+  sim.slots = 0;
+  CHECK(SIM_DEVICES == onewireBusPoll(&bus));
+  printf("cached poll:                      %6lu timeslots\n", sim.slots);
+  CHECK(sim.slots < slots);
+
+  sim_devs[2].online = false;
+  (void)onewireBusPoll(&bus);
+  (void)onewireBusPoll(&bus);
+  sim_devs[2].online = true;
+  sim.slots = 0;
+  CHECK(SIM_DEVICES == onewireBusPoll(&bus));
+  printf("poll revalidating a device:       %6lu timeslots\n", sim.slots);
+  CHECK(sim.slots < slots);
+
+  sim.slots = 0;
+  (void)onewireBusScan(&bus);
+  printf("full search:                      %6lu timeslots\n", sim.slots);
+}
+
+int main(void) {
+
+  UARTD.state = UART_STOP;
+  onewireObjectInit(&OWD);
+  onewireStart(&OWD, &owcfg);
+
+  test_cache();
+  test_skip_rom();
+  test_scan_interval();
+  test_overdrive();
+  bench_poll();
+
+  TEST_END();
+}
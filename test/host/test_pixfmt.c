@@ -0,0 +1,134 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_pixfmt.c
+ * @brief   Pixel format library test and benchmark.
+ * @details Checks every span kernel against per-pixel conversions through
+ *          ARGB-8888, then measures the span kernels and the per-pixel
+ *          switch based conversion in pixels per second.
+ */
+
+#include "hal.h"
+#include "hal_pixfmt.h"
+#include "host_test.h"
+
+#define SPAN            4096U
+#define BENCH_PIXELS    (16U * 1024U * 1024U)
+
+static const char *const names[PIXFMT_COUNT] = {
+  "ARGB8888", "RGB888", "RGB565", "ARGB1555", "ARGB4444",
+  "L8", "AL44", "AL88", "L4", "A8", "A4"
+};
+
+static uint8_t src[SPAN * 4U], dst[SPAN * 4U], ref[SPAN * 4U];
+
+static uint32_t load(const void *p, size_t i, unsigned fmt) {
+
+  switch (PIXFMT_BPP(fmt)) {
+  case 32: return pixfmt_load_32(p, i);
+  case 24: return pixfmt_load_24(p, i);
+  case 16: return pixfmt_load_16(p, i);
+  case 8:  return pixfmt_load_8(p, i);
+  default: return pixfmt_load_4(p, i);
+  }
+}
+
+static void store(void *p, size_t i, unsigned fmt, uint32_t raw) {
+
+  switch (PIXFMT_BPP(fmt)) {
+  case 32: pixfmt_store_32(p, i, raw); break;
+  case 24: pixfmt_store_24(p, i, raw); break;
+  case 16: pixfmt_store_16(p, i, raw); break;
+  case 8:  pixfmt_store_8(p, i, raw);  break;
+  default: pixfmt_store_4(p, i, raw);  break;
+  }
+}
+
+/* Reference conversion, dispatched on the formats for each pixel.*/
+static void convert_per_pixel(const void *s, unsigned sf,
+                              void *d, unsigned df, size_t n) {
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    uint32_t raw = load(s, i, sf);
+    if (sf != df) {
+      raw = pixfmtFromARGB8888(pixfmtToARGB8888(raw, sf), df);
+    }
+    store(d, i, df, raw);
+  }
+}
+
+static double mpx_per_s(void (*fn)(const void *, unsigned, void *, unsigned,
+                                   size_t),
+                        unsigned sf, unsigned df) {
+  unsigned k, runs = BENCH_PIXELS / SPAN;
+  double t0 = bench_now();
+
+  for (k = 0; k < runs; k++) {
+    fn(src, sf, dst, df, SPAN);
+    BENCH_KEEP(dst);
+  }
+  return (double)runs * SPAN / (bench_now() - t0) / 1e6;
+}
+
+int main(void) {
+  unsigned sf, df;
+  size_t i;
+
+  for (i = 0; i < sizeof src; i++) {
+    src[i] = (uint8_t)test_rand();
+  }
+
+  /* Every kernel matches the per-pixel conversion.*/
+  for (sf = 0; sf < PIXFMT_COUNT; sf++) {
+    for (df = 0; df < PIXFMT_COUNT; df++) {
+      memset(dst, 0, sizeof dst);
+      memset(ref, 0, sizeof ref);
+      pixfmtConvertSpan(src, sf, dst, df, SPAN);
+      convert_per_pixel(src, sf, ref, df, SPAN);
+      CHECKF(memcmp(dst, ref, sizeof dst) == 0, "%s to %s",
+             names[sf], names[df]);
+    }
+  }
+
+  /* Odd 4-bit spans leave the high nibble of the last byte alone.*/
+  memset(dst, 0xA0, sizeof dst);
+  pixfmtConvertSpan(src, PIXFMT_A4, dst, PIXFMT_A4, 3);
+  CHECK((dst[1] & 0xF0) == 0xA0);
+
+  /* Bits per pixel.*/
+  CHECK(PIXFMT_BPP(PIXFMT_ARGB8888) == 32);
+  CHECK(PIXFMT_BPP(PIXFMT_RGB888) == 24);
+  CHECK(PIXFMT_BPP(PIXFMT_AL88) == 16);
+  CHECK(PIXFMT_BPP(PIXFMT_L8) == 8);
+  CHECK(PIXFMT_BPP(PIXFMT_A4) == 4);
+
+  printf("%-18s %13s %13s %6s\n", "conversion", "span", "per-pixel", "ratio");
+  for (sf = 0; sf < PIXFMT_COUNT; sf++) {
+    static const unsigned targets[] = {PIXFMT_ARGB8888, PIXFMT_RGB565};
+    for (i = 0; i < sizeof targets / sizeof targets[0]; i++) {
+      double a, b;
+      df = targets[i];
+      a = mpx_per_s(pixfmtConvertSpan, sf, df);
+      b = mpx_per_s(convert_per_pixel, sf, df);
+      printf("%8s>%-9s %7.1f Mpx/s %6.1f Mpx/s %5.1fx\n",
+             names[sf], names[df], a, b, a / b);
+    }
+  }
+
+  TEST_END();
+}
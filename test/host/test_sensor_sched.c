@@ -0,0 +1,444 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_sensor_sched.c
+ * @brief   Sensor acquisition scheduler tests.
+ * @details The HDC1000, MCP9808 and TSL2561 drivers run on a mock I2C bus
+ *          with a model of each chip. The HDC1000 model NACKs the result
+ *          read until its conversion is done, as the real chip does. Time
+ *          is virtual and only advances while the scheduler sleeps, I2C
+ *          transfers take no time. Register reads must have the register
+ *          size.
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "sensor_sched.h"
+#include "hdc1000.h"
+#include "mcp9808.h"
+#include "tsl2561.h"
+
+#include "host_test.h"
+
+/*===========================================================================*/
+/* Time and objects FIFOs.                                                   */
+/*===========================================================================*/
+
+static systime_t now;
+static bool bus_owned;
+static unsigned sleeps;
+
+systime_t chVTGetSystemTimeX(void) {
+
+  return now;
+}
+
+void chThdSleep(sysinterval_t time) {
+
+  CHECK(!bus_owned);
+  sleeps++;
+  now += time;
+}
+
+void osalThreadSleepMilliseconds(uint32_t msecs) {
+
+  now += msecs;
+}
+
+void chFifoObjectInit(objects_fifo_t *ofp, size_t objsize, size_t objn,
+                      unsigned objalign, void *objbuf, msg_t *msgbuf) {
+
+  (void)objalign;
+  CHECK(objn <= 32U);
+  ofp->objsize = objsize;
+  ofp->objn = objn;
+  ofp->objbuf = objbuf;
+  ofp->msgbuf = msgbuf;
+  ofp->taken = 0;
+  ofp->rd = 0;
+  ofp->cnt = 0;
+}
+
+void *chFifoTakeObjectTimeout(objects_fifo_t *ofp, sysinterval_t timeout) {
+  size_t i;
+
+  CHECK(timeout == TIME_IMMEDIATE);
+  for (i = 0; i < ofp->objn; i++) {
+    if ((ofp->taken & (1U << i)) == 0U) {
+      ofp->taken |= 1U << i;
+      return ofp->objbuf + i * ofp->objsize;
+    }
+  }
+  return NULL;
+}
+
+void chFifoReturnObject(objects_fifo_t *ofp, void *objp) {
+  size_t i = (size_t)((uint8_t *)objp - ofp->objbuf) / ofp->objsize;
+
+  ofp->taken &= ~(1U << i);
+}
+
+void chFifoSendObject(objects_fifo_t *ofp, void *objp) {
+  size_t i = (size_t)((uint8_t *)objp - ofp->objbuf) / ofp->objsize;
+
+  ofp->msgbuf[(ofp->rd + ofp->cnt) % ofp->objn] = (msg_t)i;
+  ofp->cnt++;
+}
+
+msg_t chFifoReceiveObjectTimeout(objects_fifo_t *ofp, void **objpp,
+                                 sysinterval_t timeout) {
+
+  (void)timeout;
+  if (ofp->cnt == 0U) {
+    return MSG_TIMEOUT;
+  }
+  *objpp = ofp->objbuf + (size_t)ofp->msgbuf[ofp->rd] * ofp->objsize;
+  ofp->rd = (ofp->rd + 1U) % ofp->objn;
+  ofp->cnt--;
+  return MSG_OK;
+}
+
+/*===========================================================================*/
+/* I2C bus and chip models.                                                  */
+/*===========================================================================*/
+
+#define HDC1000_CONVERSION      13U     /* 12.85 ms, both channels.*/
+#define HDC1000_TEMP_RAW        0x6666U
+#define HDC1000_HUMID_RAW       0x8000U
+#define MCP9808_TEMP_RAW        0x0191U /* 25.0625 C at 1/16 C.*/
+#define TSL2561_CH0             1000U
+#define TSL2561_CH1             200U
+
+typedef struct chip chip_t;
+
+struct chip {
+  i2caddr_t             addr;
+  msg_t                 (*xfer)(chip_t *cp, const uint8_t *txbuf,
+                                size_t txbytes, uint8_t *rxbuf,
+                                size_t rxbytes);
+  uint8_t               ptr;
+  bool                  converting;
+  systime_t             ready;
+  unsigned              transfers;
+};
+
+static void put16_be(uint8_t *rxbuf, size_t rxbytes, uint16_t value) {
+
+  /* Registers are 16 bits wide, reading more would auto-increment.*/
+  CHECKF(rxbytes == 2U, "%u bytes register read", (unsigned)rxbytes);
+  if (rxbytes >= 2U) {
+    rxbuf[0] = (uint8_t)(value >> 8);
+    rxbuf[1] = (uint8_t)value;
+  }
+}
+
+static void put16_le(uint8_t *rxbuf, size_t rxbytes, uint16_t value) {
+
+  /* Registers are 16 bits wide, reading more would auto-increment.*/
+  CHECKF(rxbytes == 2U, "%u bytes register read", (unsigned)rxbytes);
+  if (rxbytes >= 2U) {
+    rxbuf[0] = (uint8_t)value;
+    rxbuf[1] = (uint8_t)(value >> 8);
+  }
+}
+
+static msg_t hdc1000_xfer(chip_t *cp, const uint8_t *txbuf, size_t txbytes,
+                          uint8_t *rxbuf, size_t rxbytes) {
+
+  if (txbytes > 0U) {
+    cp->ptr = txbuf[0];
+    if ((cp->ptr == 0x00U) && (txbytes == 1U) && (rxbytes == 0U)) {
+      cp->converting = true;
+      cp->ready = now + HDC1000_CONVERSION;
+    }
+    if (rxbytes > 0U) {
+      put16_be(rxbuf, rxbytes, cp->ptr == 0xFEU ? 0x5449U :
+                               cp->ptr == 0xFFU ? 0x1000U : 0U);
+    }
+    return MSG_OK;
+  }
+  /* Result read, NACK until the conversion is done.*/
+  if (!cp->converting || (now < cp->ready) || (rxbytes != 4U)) {
+    return MSG_RESET;
+  }
+  cp->converting = false;
+  put16_be(&rxbuf[0], 2, HDC1000_TEMP_RAW);
+  put16_be(&rxbuf[2], 2, HDC1000_HUMID_RAW);
+  return MSG_OK;
+}
+
+static msg_t mcp9808_xfer(chip_t *cp, const uint8_t *txbuf, size_t txbytes,
+                          uint8_t *rxbuf, size_t rxbytes) {
+
+  if (txbytes > 0U) {
+    cp->ptr = txbuf[0];
+  }
+  if (rxbytes > 0U) {
+    put16_be(rxbuf, rxbytes, cp->ptr == 0x05U ? MCP9808_TEMP_RAW :
+                             cp->ptr == 0x06U ? 0x0054U :
+                             cp->ptr == 0x07U ? 0x0400U : 0U);
+  }
+  return MSG_OK;
+}
+
+static msg_t tsl2561_xfer(chip_t *cp, const uint8_t *txbuf, size_t txbytes,
+                          uint8_t *rxbuf, size_t rxbytes) {
+
+  if (txbytes > 0U) {
+    cp->ptr = txbuf[0] & 0x0FU;
+  }
+  if (rxbytes > 0U) {
+    switch (cp->ptr) {
+    case 0x0A:
+      CHECK(rxbytes == 1U);
+      rxbuf[0] = 0x50U;                 /* TSL2561 T/FN/CL, rev 0.*/
+      break;
+    case 0x0C:
+      put16_le(rxbuf, rxbytes, TSL2561_CH0);
+      break;
+    case 0x0E:
+      put16_le(rxbuf, rxbytes, TSL2561_CH1);
+      break;
+    default:
+      memset(rxbuf, 0, rxbytes);
+      break;
+    }
+  }
+  return MSG_OK;
+}
+
+static chip_t chips[] = {
+  {HDC1000_I2CADDR_DEFAULT, hdc1000_xfer, 0, false, 0, 0},
+  {MCP9808_I2CADDR_DEFAULT, mcp9808_xfer, 0, false, 0, 0},
+  {TSL2561_I2CADDR_FLOAT,   tsl2561_xfer, 0, false, 0, 0},
+};
+
+static I2CDriver I2CD1 = {1};
+
+msg_t i2cMasterTransmitTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                               const uint8_t *txbuf, size_t txbytes,
+                               uint8_t *rxbuf, size_t rxbytes,
+                               sysinterval_t timeout) {
+  size_t i;
+
+  (void)timeout;
+  CHECK(i2cp == &I2CD1);
+  CHECK(bus_owned);
+  for (i = 0; i < sizeof chips / sizeof chips[0]; i++) {
+    if (chips[i].addr == addr) {
+      chips[i].transfers++;
+      return chips[i].xfer(&chips[i], txbuf, txbytes, rxbuf, rxbytes);
+    }
+  }
+  return MSG_RESET;
+}
+
+msg_t i2cMasterReceiveTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                              uint8_t *rxbuf, size_t rxbytes,
+                              sysinterval_t timeout) {
+
+  return i2cMasterTransmitTimeout(i2cp, addr, NULL, 0, rxbuf, rxbytes,
+                                  timeout);
+}
+
+void i2cAcquireBus(I2CDriver *i2cp) {
+
+  CHECK(!bus_owned && (i2cp == &I2CD1));
+  bus_owned = true;
+}
+
+void i2cReleaseBus(I2CDriver *i2cp) {
+
+  CHECK(bus_owned && (i2cp == &I2CD1));
+  bus_owned = false;
+}
+
+/*===========================================================================*/
+/* Tests.                                                                    */
+/*===========================================================================*/
+
+static HDC1000_config hdc1000cfg = {{&I2CD1, HDC1000_I2CADDR_DEFAULT}};
+static MCP9808_config mcp9808cfg = {{&I2CD1, MCP9808_I2CADDR_DEFAULT}};
+static MCP9808_config missingcfg = {{&I2CD1, 0x1F}};
+static TSL2561_config tsl2561cfg = {{&I2CD1, TSL2561_I2CADDR_FLOAT}};
+static HDC1000_drv hdc1000;
+static MCP9808_drv mcp9808, missing;
+static TSL2561_drv tsl2561;
+
+static sensor_sample_t samples[8];
+static msg_t samples_msgs[8];
+static objects_fifo_t samples_fifo;
+
+static void setup(size_t fifo_size) {
+  size_t i;
+
+  now = 0;
+  sleeps = 0;
+  for (i = 0; i < sizeof chips / sizeof chips[0]; i++) {
+    chips[i].converting = false;
+    chips[i].transfers = 0;
+  }
+  chFifoObjectInit(&samples_fifo, sizeof(sensor_sample_t), fifo_size, 0,
+                   samples, samples_msgs);
+
+  i2cAcquireBus(&I2CD1);
+  HDC1000_init(&hdc1000, &hdc1000cfg);
+  CHECK(HDC1000_check(&hdc1000) == MSG_OK);
+  CHECK(HDC1000_start(&hdc1000) == MSG_OK);
+  MCP9808_init(&mcp9808, &mcp9808cfg);
+  CHECK(MCP9808_check(&mcp9808) == MSG_OK);
+  CHECK(MCP9808_start(&mcp9808) == MSG_OK);
+  MCP9808_init(&missing, &missingcfg);
+  TSL2561_init(&tsl2561, &tsl2561cfg);
+  CHECK(tsl2561.id.partno == 5U);
+  CHECK(TSL2561_start(&tsl2561) == MSG_OK);
+  i2cReleaseBus(&I2CD1);
+}
+
+static sensor_sample_t *receive(void) {
+  void *objp;
+
+  if (chFifoReceiveObjectTimeout(&samples_fifo, &objp,
+                                 TIME_IMMEDIATE) != MSG_OK) {
+    return NULL;
+  }
+  chFifoReturnObject(&samples_fifo, objp);
+  return objp;
+}
+
+static bool near(float a, float b) {
+
+  return (a - b < 0.01F) && (b - a < 0.01F);
+}
+
+/**
+ * @brief   Cycle as long as the slowest sensor, reads in deadline order.
+ */
+static void test_cycle(void) {
+  SENSOR_SCHED_entry entries[] = {
+    {&TSL2561_ops, &tsl2561, &I2CD1, 0, 0, false},
+    {&MCP9808_ops, &mcp9808, &I2CD1, 1, 0, false},
+    {&HDC1000_ops, &hdc1000, &I2CD1, 2, 0, false},
+  };
+  static const unsigned order[] = {2, 1, 0};
+  const unsigned longest = TSL2561_getAcquisitionTime(&tsl2561);
+  unsigned i, sum = 0;
+  SENSOR_SCHED_drv sched;
+  sensor_sample_t *sp;
+  int cycle;
+
+  setup(8);
+  SENSOR_SCHED_init(&sched, entries, 3, &samples_fifo);
+  for (i = 0; i < 3U; i++) {
+    sum += entries[i].ops->getAcquisitionTime(entries[i].drv);
+  }
+
+  for (cycle = 0; cycle < 3; cycle++) {
+    systime_t start = now;
+
+    CHECK(SENSOR_SCHED_cycle(&sched) == MSG_OK);
+    CHECKF(sched.duration == longest, "%u ms, longest %u ms",
+           (unsigned)sched.duration, longest);
+    CHECK(sleeps == 3U * (unsigned)(cycle + 1));
+    for (i = 0; i < 3U; i++) {
+      sp = receive();
+      CHECK(sp != NULL);
+      if (sp == NULL) {
+        break;
+      }
+      CHECKF(sp->id == order[i], "sample %u from sensor %u", i, sp->id);
+      CHECK(sp->status == MSG_OK);
+      CHECK(sp->time - start ==
+            entries[sp->id].ops->getAcquisitionTime(entries[sp->id].drv));
+      switch (sp->id) {
+      case 0:
+        CHECK(sp->value[0] > 0.0F);
+        break;
+      case 1:
+        CHECK(near(sp->value[0], 25.0625F));
+        break;
+      case 2:
+        CHECK(near(sp->value[0], HDC1000_TEMP_RAW / 65536.0F * 165.0F - 40.0F));
+        CHECK(near(sp->value[1], HDC1000_HUMID_RAW / 65535.0F * 100.0F));
+        break;
+      }
+    }
+    CHECK(receive() == NULL);
+  }
+  CHECK(sched.cycles == 3U);
+  CHECK(sched.lost == 0U);
+  printf("cycle %u ms, %u ms one sensor after the other\n",
+         (unsigned)sched.duration, sum);
+}
+
+/**
+ * @brief   A failed sensor is reported, the others are still read.
+ */
+static void test_errors(void) {
+  SENSOR_SCHED_entry entries[] = {
+    {&MCP9808_ops, &missing, &I2CD1, 0, 0, false},
+    {&HDC1000_ops, &hdc1000, &I2CD1, 1, 0, false},
+    {&MCP9808_ops, &mcp9808, &I2CD1, 2, 0, false},
+  };
+  SENSOR_SCHED_drv sched;
+  sensor_sample_t *sp;
+  unsigned n = 0;
+
+  setup(8);
+  SENSOR_SCHED_init(&sched, entries, 3, &samples_fifo);
+  CHECK(SENSOR_SCHED_cycle(&sched) == MSG_RESET);
+  while ((sp = receive()) != NULL) {
+    CHECKF(sp->status == (sp->id == 0U ? MSG_RESET : MSG_OK),
+           "sensor %u status %d", sp->id, (int)sp->status);
+    n++;
+  }
+  CHECK(n == 3U);
+
+  /* Samples are lost, not waited for, when the FIFO is full.*/
+  setup(2);
+  SENSOR_SCHED_init(&sched, entries, 3, &samples_fifo);
+  (void)SENSOR_SCHED_cycle(&sched);
+  CHECK(sched.lost == 1U);
+  CHECK((receive() != NULL) && (receive() != NULL) && (receive() == NULL));
+}
+
+/**
+ * @brief   The HDC1000 model refuses early reads.
+ */
+static void test_model(void) {
+  float t, h;
+
+  setup(8);
+  i2cAcquireBus(&I2CD1);
+  CHECK(HDC1000_startMeasure(&hdc1000) == MSG_OK);
+  now += HDC1000_CONVERSION - 1U;
+  CHECK(HDC1000_readMeasure(&hdc1000, &t, &h) == MSG_RESET);
+  hdc1000.state = SENSOR_STARTED;
+  CHECK(HDC1000_startMeasure(&hdc1000) == MSG_OK);
+  now += HDC1000_CONVERSION;
+  CHECK(HDC1000_readMeasure(&hdc1000, &t, &h) == MSG_OK);
+  i2cReleaseBus(&I2CD1);
+}
+
+int main(void) {
+
+  test_model();
+  test_cycle();
+  test_errors();
+
+  TEST_END();
+}
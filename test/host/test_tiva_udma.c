@@ -0,0 +1,345 @@
+/*
+    ChibiOS - Copyright (C) 2006..2016 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_tiva_udma.c
+ * @brief   TIVA uDMA control table helpers test.
+ * @details Checks the structures built by the helpers, then runs them on a
+ *          model of the controller: scatter-gather copies longer than a
+ *          single structure and a continuous ping-pong capture, including
+ *          the channel stop when both halves complete before being served.
+ * @note    The model moves items between host addresses, the control
+ *          structures hold host pointers.
+ */
+
+#include "hal.h"
+#include "host_test.h"
+
+#define CH              14U
+#define REGS_BASE       0x400FE000U
+#define REGS_SIZE       0x2000U
+
+/*===========================================================================*/
+/* Registers and controller model.                                           */
+/*===========================================================================*/
+
+static uint32_t regs[REGS_SIZE / 4U];
+
+volatile uint32_t *test_hwreg(uint32_t addr) {
+
+  if ((addr < REGS_BASE) || (addr >= REGS_BASE + REGS_SIZE)) {
+    fprintf(stderr, "register 0x%08X out of the model\n", (unsigned)addr);
+    abort();
+  }
+  return &regs[(addr - REGS_BASE) / 4U];
+}
+
+/* Channel state not held by the control table.*/
+static bool use_alt;
+static unsigned completions;
+
+static bool ch_enabled(void) {
+
+  return (HWREG(UDMA_ENASET) & (1U << CH)) != 0U;
+}
+
+static void ch_stop(void) {
+
+  HWREG(UDMA_ENASET) &= ~(1U << CH);
+  completions++;
+}
+
+static uint32_t xfermode(const tiva_udma_table_entry_t *ep) {
+
+  return ep->chctl & UDMA_CHCTL_XFERMODE_M;
+}
+
+static size_t xfersize(const tiva_udma_table_entry_t *ep) {
+
+  return ((ep->chctl & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1U;
+}
+
+/* Address of an item, the end pointers stay and the size counts down.*/
+static volatile uint8_t *itemp(volatile void *endp, uint32_t inc,
+                               size_t left) {
+
+  if (inc == 3U) {
+    return endp;
+  }
+  return (volatile uint8_t *)endp - ((left - 1U) << inc);
+}
+
+/* Moves the next item of a structure, returns true when it completed.*/
+static bool move_item(tiva_udma_table_entry_t *ep) {
+  uint32_t ctl = ep->chctl;
+  size_t left = xfersize(ep);
+  unsigned size = 1U << ((ctl & UDMA_CHCTL_SRCSIZE_M) >> 24);
+  volatile uint8_t *s = itemp(ep->srcendp, (ctl & UDMA_CHCTL_SRCINC_M) >> 26,
+                              left);
+  volatile uint8_t *d = itemp(ep->dstendp, (ctl & UDMA_CHCTL_DSTINC_M) >> 30,
+                              left);
+  unsigned i;
+
+  for (i = 0; i < size; i++) {
+    d[i] = s[i];
+  }
+  if (left == 1U) {
+    ep->chctl = ctl & ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+    return true;
+  }
+  ep->chctl = (ctl & ~UDMA_CHCTL_XFERSIZE_M) | UDMA_CHCTL_XFERSIZE(left - 1U);
+  return false;
+}
+
+/* Copies the next task of a scatter-gather list in the alternate structure,
+   four words per task as the controller does.*/
+static void copy_task(tiva_udma_table_entry_t *pri,
+                      tiva_udma_table_entry_t *alt) {
+  size_t left = xfersize(pri) / 4U;
+  const tiva_udma_table_entry_t *last = (const tiva_udma_table_entry_t *)
+      ((volatile uint8_t *)pri->srcendp -
+       offsetof(tiva_udma_table_entry_t, unused));
+  const tiva_udma_table_entry_t *task = last - (left - 1U);
+
+  CHECK(pri->dstendp == &alt->unused);
+  alt->srcendp = task->srcendp;
+  alt->dstendp = task->dstendp;
+  alt->chctl   = task->chctl;
+  alt->unused  = task->unused;
+  if (left == 1U) {
+    pri->chctl &= ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+  }
+  else {
+    pri->chctl = (pri->chctl & ~UDMA_CHCTL_XFERSIZE_M) |
+                 UDMA_CHCTL_XFERSIZE((left - 1U) * 4U);
+  }
+}
+
+/* Runs the channel for at most n items, a stopped channel moves nothing.*/
+static size_t udma_run(size_t n) {
+  size_t moved = 0;
+
+  if ((HWREG(UDMA_ALTCLR) & (1U << CH)) != 0U) {
+    HWREG(UDMA_ALTCLR) = 0;
+    use_alt = false;
+  }
+
+  while ((moved < n) && ch_enabled()) {
+    tiva_udma_table_entry_t *pri = &udmaControlTable.primary[CH];
+    tiva_udma_table_entry_t *alt = &udmaControlTable.alternate[CH];
+    tiva_udma_table_entry_t *ep = use_alt ? alt : pri;
+    uint32_t mode = xfermode(ep);
+
+    if (mode == UDMA_CHCTL_XFERMODE_STOP) {
+      ch_stop();
+      break;
+    }
+    if ((mode == UDMA_CHCTL_XFERMODE_MEM_SG) ||
+        (mode == UDMA_CHCTL_XFERMODE_PER_SG)) {
+      CHECK(!use_alt);
+      copy_task(pri, alt);
+      use_alt = true;
+      continue;
+    }
+
+    moved++;
+    if (!move_item(ep)) {
+      continue;
+    }
+    switch (mode) {
+    case UDMA_CHCTL_XFERMODE_PINGPONG:
+      /* Each half interrupts, the other half goes on if armed.*/
+      completions++;
+      use_alt = !use_alt;
+      break;
+    case UDMA_CHCTL_XFERMODE_MEM_SGA:
+    case UDMA_CHCTL_XFERMODE_PER_SGA:
+      use_alt = false;
+      break;
+    default:
+      ch_stop();
+      break;
+    }
+  }
+
+  return moved;
+}
+
+static void ch_start(void) {
+
+  completions = 0;
+  dmaChannelPrimary(CH);
+  dmaChannelEnable(CH);
+}
+
+/*===========================================================================*/
+/* Tests.                                                                    */
+/*===========================================================================*/
+
+static void test_entry(void) {
+  static uint32_t words[1024];
+  static uint8_t port;
+  tiva_udma_table_entry_t e;
+
+  udmaEntrySetup(&e, words, &port,
+                 UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_SRCINC_32 |
+                 UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_DSTINC_NONE |
+                 UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_BASIC, 10);
+  CHECK(e.srcendp == &words[9]);
+  CHECK(e.dstendp == &port);
+  CHECK(xfersize(&e) == 10U);
+  CHECK(xfermode(&e) == UDMA_CHCTL_XFERMODE_BASIC);
+  CHECK(udmaEntryRemaining(&e) == 10U);
+
+  /* Single item and longest structure.*/
+  udmaEntrySetup(&e, &port, words, UDMA_CHCTL_SRCINC_NONE |
+                 UDMA_CHCTL_DSTINC_8 | UDMA_CHCTL_XFERMODE_BASIC, 1);
+  CHECK(e.srcendp == &port);
+  CHECK(e.dstendp == words);
+  CHECK(udmaEntryRemaining(&e) == 1U);
+  udmaEntrySetup(&e, words, words, UDMA_CHCTL_SRCINC_16 |
+                 UDMA_CHCTL_DSTINC_16 | UDMA_CHCTL_XFERMODE_AUTO,
+                 UDMA_MAX_TRANSFER);
+  CHECK(e.srcendp == (uint8_t *)words + 2U * (UDMA_MAX_TRANSFER - 1U));
+  CHECK(udmaEntryRemaining(&e) == UDMA_MAX_TRANSFER);
+
+  /* A completed structure has nothing left.*/
+  e.chctl &= ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+  CHECK(udmaEntryRemaining(&e) == 0U);
+}
+
+static void test_task_list(void) {
+  static uint8_t src[2500], dst[2600];
+  static tiva_udma_table_entry_t tasks[4] __attribute__((aligned(4)));
+  uint32_t ctl = UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_SRCINC_8 |
+                 UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_DSTINC_8 |
+                 UDMA_CHCTL_ARBSIZE_8;
+  size_t i, n;
+
+  /* Split in tasks of at most 1024 items, chained end to start.*/
+  n = udmaTaskListSetup(tasks, 4, src, dst, ctl, sizeof src, false);
+  CHECK(n == 3U);
+  CHECK(udmaEntryRemaining(&tasks[0]) == 1024U);
+  CHECK(udmaEntryRemaining(&tasks[1]) == 1024U);
+  CHECK(udmaEntryRemaining(&tasks[2]) == 452U);
+  CHECK(xfermode(&tasks[0]) == UDMA_CHCTL_XFERMODE_MEM_SGA);
+  CHECK(xfermode(&tasks[1]) == UDMA_CHCTL_XFERMODE_MEM_SGA);
+  CHECK(xfermode(&tasks[2]) == UDMA_CHCTL_XFERMODE_AUTO);
+  CHECK(tasks[0].srcendp == &src[1023]);
+  CHECK(tasks[1].dstendp == &dst[2047]);
+  CHECK(tasks[2].srcendp == &src[2499]);
+  for (i = 0; i < n; i++) {
+    CHECK((tasks[i].chctl & UDMA_CHCTL_ARBSIZE_M) == UDMA_CHCTL_ARBSIZE_8);
+  }
+
+  /* Peripheral lists end in basic mode, an exact multiple is not split
+     further.*/
+  n = udmaTaskListSetup(tasks, 4, src, dst, ctl, 2048, true);
+  CHECK(n == 2U);
+  CHECK(xfermode(&tasks[0]) == UDMA_CHCTL_XFERMODE_PER_SGA);
+  CHECK(xfermode(&tasks[1]) == UDMA_CHCTL_XFERMODE_BASIC);
+
+  /* Too long for the list.*/
+  CHECK(udmaTaskListSetup(tasks, 2, src, dst, ctl, 2049, false) == 0U);
+
+  /* The primary structure copies four words per task.*/
+  n = udmaTaskListSetup(tasks, 4, src, dst, ctl, sizeof src, false);
+  udmaScatterGatherSetup(CH, tasks, n, false);
+  CHECK(udmaControlTable.primary[CH].srcendp == &tasks[2].unused);
+  CHECK(udmaControlTable.primary[CH].dstendp ==
+        &udmaControlTable.alternate[CH].unused);
+  CHECK(xfersize(&udmaControlTable.primary[CH]) == 12U);
+  CHECK(xfermode(&udmaControlTable.primary[CH]) ==
+        UDMA_CHCTL_XFERMODE_MEM_SG);
+
+  /* Run by the controller, one completion for the whole list.*/
+  for (i = 0; i < sizeof src; i++) {
+    src[i] = (uint8_t)test_rand();
+  }
+  memset(dst, 0x5A, sizeof dst);
+  ch_start();
+  CHECK(udma_run(SIZE_MAX) == sizeof src);
+  CHECK(!ch_enabled());
+  CHECK(completions == 1U);
+  CHECK(memcmp(dst, src, sizeof src) == 0);
+  CHECK(dst[sizeof src] == 0x5A);
+}
+
+static void test_ping_pong(void) {
+  static uint32_t fifo, ring[16];
+  uint32_t ctl = UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_SRCINC_NONE |
+                 UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_DSTINC_32 |
+                 UDMA_CHCTL_ARBSIZE_1;
+  uint32_t sample = 0, done;
+  unsigned round, i;
+
+  udmaPingPongSetup(CH, &fifo, &ring[0], &fifo, &ring[8], ctl, 8);
+  CHECK(xfermode(&udmaControlTable.primary[CH]) ==
+        UDMA_CHCTL_XFERMODE_PINGPONG);
+  CHECK(xfermode(&udmaControlTable.alternate[CH]) ==
+        UDMA_CHCTL_XFERMODE_PINGPONG);
+  CHECK(udmaPingPongServe(CH) == 0U);
+
+  /* Each completed half is served before the other one completes, the
+     transfer never stops.*/
+  ch_start();
+  for (round = 0; round < 4; round++) {
+    for (i = 0; i < 8; i++) {
+      fifo = sample++;
+      CHECK(udma_run(1) == 1U);
+    }
+    done = udmaPingPongServe(CH);
+    CHECKF(done == ((round & 1U) ? UDMA_PINGPONG_ALTERNATE :
+                                   UDMA_PINGPONG_PRIMARY),
+           "round %u done %u", round, (unsigned)done);
+    CHECK(ring[(round & 1U) * 8U] == sample - 8U);
+    CHECK(ring[(round & 1U) * 8U + 7U] == sample - 1U);
+  }
+  CHECK(ch_enabled());
+  CHECK(completions == 4U);
+
+  /* Both halves completed before being served, the controller finds the
+     primary structure stopped and the channel stops.*/
+  for (i = 0; i < 16; i++) {
+    fifo = sample++;
+    udma_run(1);
+  }
+  fifo = sample;
+  CHECK(udma_run(1) == 0U);
+  CHECK(!ch_enabled());
+  done = udmaPingPongServe(CH);
+  CHECK(done == (UDMA_PINGPONG_PRIMARY | UDMA_PINGPONG_ALTERNATE));
+
+  /* Re-armed but still stopped until re-enabled from the primary half.*/
+  CHECK(udma_run(1) == 0U);
+  dmaChannelPrimary(CH);
+  dmaChannelEnable(CH);
+  for (i = 0; i < 8; i++) {
+    fifo = sample++;
+    CHECK(udma_run(1) == 1U);
+  }
+  CHECK(ring[0] == sample - 8U);
+  CHECK(udmaPingPongServe(CH) == UDMA_PINGPONG_PRIMARY);
+}
+
+int main(void) {
+
+  test_entry();
+  test_task_list();
+  test_ping_pong();
+
+  TEST_END();
+}
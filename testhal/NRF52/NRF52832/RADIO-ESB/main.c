@@ -71,16 +71,16 @@ static THD_FUNCTION(RadioThread, arg) {
     	chEvtWaitAny(EVENT_MASK(0));
     	eventflags_t flags = chEvtGetAndClearFlags(&el);
     	if (flags & NRF52_EVENT_TX_SUCCESS) {
-        	radio_start_rx();
+        	radio_start_rx(&RFD1);
     		good_pkt++;
     	}
     	if (flags & NRF52_EVENT_TX_FAILED) {
-        	radio_start_rx();
+        	radio_start_rx(&RFD1);
     		fail_pkt++;
     	}
     	if (flags & NRF52_EVENT_RX_RECEIVED) {
     		memset(rx_payload.data, 0, 32);
-    		radio_read_rx_payload(&rx_payload);
+    		radio_read_rx_payload(&RFD1, &rx_payload);
     	}
     }
 }
@@ -97,10 +97,10 @@ int main(void) {
     chThdCreateStatic(waLEDThread, sizeof(waLEDThread), NORMALPRIO, LEDThread, NULL);
     chThdCreateStatic(waRadioThread, sizeof(waRadioThread), NORMALPRIO, RadioThread, NULL);
 
-    radio_init(&radiocfg);
-    radio_flush_tx();
-    radio_flush_rx();
-    radio_start_rx();
+    radio_init(&RFD1, &radiocfg);
+    radio_flush_tx(&RFD1);
+    radio_flush_rx(&RFD1);
+    radio_start_rx(&RFD1);
 
     cnt = good_pkt = fail_pkt = 0;
 
@@ -108,9 +108,9 @@ int main(void) {
     	memset(tx_payload.data, 0, 32);
     	sprintf((char*)tx_payload.data, "counter value=%d" , cnt++);
     	tx_payload.length = strlen((char *)tx_payload.data);
-    	radio_stop_rx();
-        radio_write_payload(&tx_payload);
-    	radio_start_tx();
+    	radio_stop_rx(&RFD1);
+        radio_write_payload(&RFD1, &tx_payload);
+    	radio_start_tx(&RFD1);
     	chprintf((BaseSequentialStream *)&SD1, "packets: good=%d, fail=%d, sent=%s\r\n", good_pkt, fail_pkt, tx_payload.data);
     	chThdSleepMilliseconds(500);
     	if (strlen((char*) rx_payload.data)) {
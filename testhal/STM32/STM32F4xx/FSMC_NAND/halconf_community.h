@@ -120,6 +120,28 @@
 #define NAND_USE_MUTUAL_EXCLUSION   TRUE
 #endif
 
+/**
+ * @brief   Enables the bad block table persistence.
+ * @note    The last @p NAND_BBT_BLOCKS blocks are reserved for the table.
+ */
+#if !defined(NAND_USE_BBT) || defined(__DOXYGEN__)
+#define NAND_USE_BBT                FALSE
+#endif
+
+/**
+ * @brief   Number of blocks reserved for the bad block table.
+ */
+#if !defined(NAND_BBT_BLOCKS) || defined(__DOXYGEN__)
+#define NAND_BBT_BLOCKS             4
+#endif
+
+/**
+ * @brief   Enables the @p nandReadPageEcc() and @p nandWritePageEcc() APIs.
+ */
+#if !defined(NAND_USE_SOFT_ECC) || defined(__DOXYGEN__)
+#define NAND_USE_SOFT_ECC           FALSE
+#endif
+
 /*===========================================================================*/
 /* 1-wire driver related settings.                                           */
 /*===========================================================================*/
@@ -43,6 +43,7 @@
 
 static void mem_error_cb(memtest_t *memp, testtype type, size_t index,
                          size_t width, uint32_t got, uint32_t expect);
+static uint32_t mem_time_cb(void);
 
 /*
  ******************************************************************************
@@ -70,12 +71,21 @@ static const SRAMConfig sram_cfg = {
  *
  */
 static memtest_t memtest_struct = {
-    SRAM_START,
-    SRAM_SIZE,
-    MEMTEST_WIDTH_32,
-    mem_error_cb
+    .start      = SRAM_START,
+    .size       = SRAM_SIZE,
+    .width_mask = MEMTEST_WIDTH_32,
+    .errcb      = mem_error_cb,
+    .timecb     = mem_time_cb
 };
 
+/*
+ * Failed test of the last pass and bandwidth of the pattern tests in KB/s,
+ * to be inspected with the debugger.
+ */
+static testtype memtest_failed;
+static uint32_t memtest_write_bw;
+static uint32_t memtest_read_bw;
+
 /*
  *
  */
@@ -129,14 +139,34 @@ static void mem_error_cb(memtest_t *memp, testtype type, size_t index,
 }
 
 /*
- *
+ * Cycle counter, runs at the core clock.
+ */
+static uint32_t mem_time_cb(void) {
+
+  return chSysGetRealtimeCounterX();
+}
+
+/*
+ * MEMTEST_RUN_ALL includes the March tests, a pass takes several times
+ * longer than with the pattern tests only.
  */
 static void memtest(void) {
 
   red_led_off();
 
   while (true) {
-    memtest_run(&memtest_struct, MEMTEST_RUN_ALL);
+    memtest_failed = memtest_run(&memtest_struct, MEMTEST_RUN_ALL);
+    if (0 != memtest_failed) {
+      green_led_off();
+      red_led_on();
+      osalSysHalt("Memory broken");
+    }
+    memtest_write_bw = memtest_bandwidth(memtest_struct.stats.written,
+                                         memtest_struct.stats.write_ticks,
+                                         STM32_HCLK);
+    memtest_read_bw  = memtest_bandwidth(memtest_struct.stats.read,
+                                         memtest_struct.stats.read_ticks,
+                                         STM32_HCLK);
     green_led_toggle();
   }
 
@@ -102,6 +102,7 @@ int main(void) {
    * start mass storage
    */
   msdObjectInit(&USBMSD1);
+  msdSetBlockMap(&USBMSD1, ramdiskMap);
   msdStart(&USBMSD1, &USBD1, (BaseBlockDevice *)&ramdisk, blkbuf, NULL, NULL);
 
   /*
@@ -0,0 +1,276 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+
+"""
+Packs glyphs and sprites into compact DMA2D atlases.
+
+Fonts are rendered into alpha-only atlases (A4/A8), colored at drawing time.
+Sprites are packed together and quantized to one shared palette (L4/L8).
+The output is a C source/header pair for hal_stm32_dma2d_atlas.h.
+
+Examples:
+  dma2d_atlas.py font -f DejaVuSans.ttf -s 16 -b 4 -n font16 -o gfx/
+  dma2d_atlas.py sprites -b 8 -n icons -o gfx/ icons/*.png
+"""
+
+from argparse import ArgumentParser
+from os.path import basename, splitext, join
+import re
+
+from PIL import Image, ImageDraw, ImageFont
+
+
+FORMATS = {('font', 4): 'DMA2D_FMT_A4',
+           ('font', 8): 'DMA2D_FMT_A8',
+           ('sprites', 4): 'DMA2D_FMT_L4',
+           ('sprites', 8): 'DMA2D_FMT_L8'}
+
+NO_ENTRY = 0xFFFF
+
+
+def c_name(name):
+    return re.sub(r'[^0-9A-Za-z_]', '_', name)
+
+
+def pack(sizes, width, align):
+    """Shelf packing, tallest entries first. Returns positions and size."""
+    order = sorted(range(len(sizes)), key=lambda i: -sizes[i][1])
+    positions = [None] * len(sizes)
+    x = y = shelf = used = 0
+    for i in order:
+        w, h = sizes[i]
+        w = (w + align - 1) // align * align
+        if w > width:
+            raise ValueError('entry %d is wider than the atlas' % i)
+        if x + w > width:
+            x = 0
+            y += shelf
+            shelf = 0
+        positions[i] = (x, y)
+        x += w
+        shelf = max(shelf, h)
+        used = max(used, x)
+    return positions, (max(used, align), max(y + shelf, 1))
+
+
+def render_font(path, size, first, last):
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    entries = []
+    for code in range(first, last + 1):
+        ch = chr(code)
+        left, top, right, bottom = font.getbbox(ch, anchor='la')
+        advance = int(round(font.getlength(ch)))
+        w, h = right - left, bottom - top
+        if w <= 0 or h <= 0:
+            entries.append((None, 0, 0, advance, repr(ch)))
+            continue
+        img = Image.new('L', (w, h), 0)
+        ImageDraw.Draw(img).text((-left, -top), ch, font=font, fill=255,
+                                 anchor='la')
+        entries.append((img, left, top, advance, repr(ch)))
+    return entries, ascent + descent
+
+
+def load_sprites(paths):
+    entries = []
+    for path in paths:
+        img = Image.open(path).convert('RGBA')
+        entries.append((img, 0, 0, img.width, splitext(basename(path))[0]))
+    return entries
+
+
+def check_ranges(entries, bpp, line_height):
+    """Rejects values that do not fit the dma2d_atlas_entry_t fields."""
+    if len(entries) >= NO_ENTRY:
+        raise ValueError('too many entries (%d)' % len(entries))
+    if not 0 <= line_height <= 255:
+        raise ValueError('line height %d out of range 0..255' % line_height)
+    for img, xoff, yoff, advance, label in entries:
+        w, h = (img.width, img.height) if img else (0, 0)
+        if bpp == 4:
+            w = (w + 1) & ~1
+        if w > 255 or h > 255:
+            raise ValueError('%s: %dx%d is larger than 255x255 pixels' %
+                             (label, w, h))
+        if not (-128 <= xoff <= 127 and -128 <= yoff <= 127):
+            raise ValueError('%s: offset (%d, %d) out of range -128..127' %
+                             (label, xoff, yoff))
+        if not 0 <= advance <= 255:
+            raise ValueError('%s: advance %d out of range 0..255' %
+                             (label, advance))
+
+
+def build_atlas(kind, entries, width, bpp):
+    align = 2 if bpp == 4 else 1
+    sizes = [(e[0].width, e[0].height) if e[0] else (0, 0) for e in entries]
+    positions, size = pack(sizes, width, align)
+    if size[1] > 0xFFFF:
+        raise ValueError('atlas height %d out of range, use a wider atlas' %
+                         size[1])
+    mode = 'L' if kind == 'font' else 'RGBA'
+    atlas = Image.new(mode, size, 0)
+    for (img, _, _, _, _), pos in zip(entries, positions):
+        if img:
+            atlas.paste(img, pos)
+
+    palette = None
+    if kind == 'font':
+        values = list(bytearray(atlas.tobytes()))
+        if bpp == 4:
+            values = [(v * 15 + 127) // 255 for v in values]
+    else:
+        indexed = atlas.quantize(colors=1 << bpp,
+                                 method=Image.Quantize.FASTOCTREE)
+        values = list(bytearray(indexed.tobytes()))
+        rgb = indexed.getpalette()
+        used = max(values) + 1
+        # Recover the alpha of each palette entry from the source pixels.
+        alpha = [0] * used
+        count = [0] * used
+        for v, a in zip(values, bytearray(atlas.getchannel('A').tobytes())):
+            alpha[v] += a
+            count[v] += 1
+        palette = []
+        for i in range(used):
+            a = alpha[i] // count[i] if count[i] else 0
+            r, g, b = rgb[3 * i:3 * i + 3]
+            palette.append((a << 24) | (r << 16) | (g << 8) | b)
+
+    if bpp == 4:
+        # DMA2D 4-bit formats: first pixel in the low nibble.
+        data = [values[i] | (values[i + 1] << 4)
+                for i in range(0, len(values), 2)]
+    else:
+        data = values
+    return atlas.size, positions, data, palette
+
+
+def write_sources(outdir, name, kind, bpp, size, entries, positions, data,
+                  palette, first, line_height):
+    fmt = FORMATS[(kind, bpp)]
+    cname = c_name(name)
+    lines = ['/* Generated by tools/dma2d_atlas.py, do not edit. */',
+             '',
+             '#include "hal.h"',
+             '#include "%s.h"' % name,
+             '',
+             'static const uint8_t %s_pixels[%d] = {' % (cname, len(data))]
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ', '.join('0x%02X' % b for b in data[i:i + 16]) +
+                     ',')
+    lines.append('};')
+    lines.append('')
+    if palette is not None:
+        lines.append('static const uint32_t %s_clut[%d] = {' %
+                     (cname, len(palette)))
+        for i in range(0, len(palette), 6):
+            lines.append('  ' + ', '.join('0x%08X' % c
+                                           for c in palette[i:i + 6]) + ',')
+        lines.append('};')
+        lines.append('')
+        lines.append('static const dma2d_palcfg_t %s_palette = {' % cname)
+        lines.append('  %s_clut, %d, DMA2D_FMT_ARGB8888' %
+                     (cname, len(palette)))
+        lines.append('};')
+        lines.append('')
+    lines.append('static const dma2d_atlas_entry_t %s_entries[%d] = {' %
+                 (cname, len(entries)))
+    for (img, xoff, yoff, advance, label), (x, y) in zip(entries, positions):
+        w, h = (img.width, img.height) if img else (0, 0)
+        if bpp == 4:
+            w = (w + 1) & ~1
+        label = label.replace('*/', '* /')
+        lines.append('  {%4d, %4d, %3d, %3d, %4d, %4d, %3d}, /* %s */' %
+                     (x, y, w, h, xoff, yoff, advance, label))
+    lines.append('};')
+    lines.append('')
+    fallback = NO_ENTRY
+    if kind == 'font' and first <= ord('?') < first + len(entries):
+        fallback = ord('?') - first
+    lines.append('const dma2d_atlas_t %s = {' % cname)
+    lines.append('  %s_pixels,' % cname)
+    lines.append('  %d, %d,' % size)
+    lines.append('  %s,' % fmt)
+    lines.append('  %s,' % ('&%s_palette' % cname if palette else 'NULL'))
+    lines.append('  %s_entries,' % cname)
+    lines.append('  %d, %d, 0x%04X,' % (len(entries), first, fallback))
+    lines.append('  %d' % line_height)
+    lines.append('};')
+    with open(join(outdir, name + '.c'), 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+    guard = cname.upper() + '_H'
+    lines = ['/* Generated by tools/dma2d_atlas.py, do not edit. */',
+             '',
+             '#ifndef %s' % guard,
+             '#define %s' % guard,
+             '',
+             '#include "hal_stm32_dma2d_atlas.h"',
+             '']
+    if kind == 'sprites':
+        for i, e in enumerate(entries):
+            lines.append('#define %s_%s %d' % (cname.upper(),
+                                               c_name(e[4]).upper(), i))
+        lines.append('')
+    lines.append('extern const dma2d_atlas_t %s;' % cname)
+    lines.append('')
+    lines.append('#endif /* %s */' % guard)
+    with open(join(outdir, name + '.h'), 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+parser = ArgumentParser(description='Pack glyphs and sprites into DMA2D '
+                                    'A4/A8/L4/L8 atlases.')
+parser.add_argument('kind', choices=['font', 'sprites'],
+                    help='font: alpha-only glyph atlas, '
+                         'sprites: palettized sprite atlas.')
+parser.add_argument('images', nargs='*', help='Sprite images (sprites only).')
+parser.add_argument('-f', '--font', help='TrueType font file (font only).')
+parser.add_argument('-s', '--size', type=int, default=16,
+                    help='Font size, in pixels.')
+parser.add_argument('-r', '--range', default='32-126',
+                    help='Character code range, e.g. 32-126.')
+parser.add_argument('-b', '--bpp', type=int, choices=[4, 8], default=4,
+                    help='Bits per pixel of the atlas.')
+parser.add_argument('-w', '--width', type=int, default=256,
+                    help='Atlas width, in pixels.')
+parser.add_argument('-n', '--name', required=True,
+                    help='Name of the atlas object and of the output files.')
+parser.add_argument('-o', '--output', default='.', help='Output directory.')
+
+
+if __name__ == '__main__':
+    args = parser.parse_intermixed_args()
+
+    if args.bpp == 4 and args.width % 2:
+        parser.error('4-bit atlases need an even width')
+    if not 0 < args.width <= 0xFFFF:
+        parser.error('the atlas width must be 1..65535')
+
+    first = 0
+    line_height = 0
+    if args.kind == 'font':
+        if not args.font:
+            parser.error('font atlases need a --font file')
+        first, last = (int(v, 0) for v in args.range.split('-'))
+        entries, line_height = render_font(args.font, args.size, first, last)
+    else:
+        if not args.images:
+            parser.error('sprite atlases need at least one image')
+        entries = load_sprites(args.images)
+
+    try:
+        check_ranges(entries, args.bpp, line_height)
+        size, positions, data, palette = build_atlas(args.kind, entries,
+                                                     args.width, args.bpp)
+    except ValueError as e:
+        parser.error(str(e))
+    write_sources(args.output, args.name, args.kind, args.bpp, size, entries,
+                  positions, data, palette, first, line_height)
+
+    argb = 4 * sum(e[0].width * e[0].height for e in entries if e[0])
+    packed = len(data) + 4 * len(palette or [])
+    print('%s: %dx%d atlas, %d entries, %d bytes (%.1fx smaller than '
+          'ARGB8888)' % (args.name, size[0], size[1], len(entries), packed,
+                         float(argb) / max(packed, 1)))
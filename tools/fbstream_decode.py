@@ -0,0 +1,228 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+
+"""
+Rebuilds the frames streamed by os/various/fbstream.c.
+
+The input is a serial port (needs pyserial) or a file holding a captured
+stream. Frames are saved as PNG images (needs Pillow) or as raw frame
+buffer dumps, in their original pixel format.
+
+Examples:
+  fbstream_decode.py -p /dev/ttyACM0 -o frames/
+  fbstream_decode.py -i capture.bin -o frames/ --raw
+"""
+
+from argparse import ArgumentParser
+from os.path import join
+import struct
+import sys
+
+
+MAGIC = b'FBS1'
+FLAG_KEY = 0x01
+END_ROW = 0xFFFF
+
+# Bits per pixel and name of the PIXFMT_xxx formats, see hal_pixfmt.h.
+FORMATS = [(32, 'ARGB8888'), (24, 'RGB888'), (16, 'RGB565'),
+           (16, 'ARGB1555'), (16, 'ARGB4444'), (8, 'L8'), (8, 'AL44'),
+           (16, 'AL88'), (4, 'L4'), (8, 'A8'), (4, 'A4')]
+
+
+class StreamError(Exception):
+    pass
+
+
+def decode_row(data, above, units, unit):
+    """Decodes one row payload, returns the row bytes."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code < 0x80:
+            n = (code + 1) * unit
+            out += data[i:i + n]
+            i += n
+        elif code < 0xC0:
+            out += data[i:i + unit] * ((code & 0x3F) + 2)
+            i += unit
+        else:
+            if above is None:
+                raise StreamError('copy from above in the first row')
+            start = len(out)
+            out += above[start:start + ((code & 0x3F) + 1) * unit]
+    if len(out) != units * unit:
+        raise StreamError('row size mismatch')
+    return out
+
+
+def to_rgba(fmt, width, height, rows):
+    """Converts the frame to RGBA bytes."""
+    bpp = FORMATS[fmt][0]
+    out = bytearray()
+    for row in rows:
+        if bpp == 4:
+            values = []
+            for b in row:
+                values += [b & 0x0F, b >> 4]
+            values = values[:width]
+        else:
+            step = bpp // 8
+            values = [int.from_bytes(row[x:x + step], 'little')
+                      for x in range(0, width * step, step)]
+        for v in values:
+            out += bytes(convert(fmt, v))
+    return out
+
+
+def convert(fmt, v):
+    """Converts one raw pixel to (r, g, b, a)."""
+    name = FORMATS[fmt][1]
+    if name in ('ARGB8888', 'RGB888'):
+        a = v >> 24 if name == 'ARGB8888' else 255
+        return (v >> 16) & 0xFF, (v >> 8) & 0xFF, v & 0xFF, a
+    if name == 'RGB565':
+        r, g, b = (v >> 11) & 0x1F, (v >> 5) & 0x3F, v & 0x1F
+        return r * 255 // 31, g * 255 // 63, b * 255 // 31, 255
+    if name == 'ARGB1555':
+        r, g, b = (v >> 10) & 0x1F, (v >> 5) & 0x1F, v & 0x1F
+        return r * 255 // 31, g * 255 // 31, b * 255 // 31, 255 * (v >> 15)
+    if name == 'ARGB4444':
+        return tuple(((v >> s) & 0x0F) * 17 for s in (8, 4, 0, 12))
+    if name in ('L8', 'L4'):
+        # Palette indexes, shown as gray levels.
+        l = v if name == 'L8' else v * 17
+        return l, l, l, 255
+    if name == 'AL44':
+        l = (v & 0x0F) * 17
+        return l, l, l, (v >> 4) * 17
+    if name == 'AL88':
+        return v & 0xFF, v & 0xFF, v & 0xFF, v >> 8
+    a = v if name == 'A8' else v * 17
+    return 255, 255, 255, a
+
+
+class Decoder(object):
+
+    def __init__(self, read):
+        self.read_exact = read
+        self.rows = None
+        self.geometry = None
+        self.sequence = None
+
+    def sync(self):
+        """Skips bytes until the frame magic."""
+        window = b''
+        while window != MAGIC:
+            window = (window + self.read_exact(1))[-4:]
+
+    def frame(self):
+        """Decodes the next frame, returns (sequence, key, changed rows)."""
+        self.sync()
+        seq, width, height, fmt, flags, _ = struct.unpack(
+            '<IHHBBH', self.read_exact(12))
+        if fmt >= len(FORMATS):
+            raise StreamError('bad pixel format %d' % fmt)
+        key = bool(flags & FLAG_KEY)
+        geometry = (width, height, fmt)
+        if key:
+            self.rows = [None] * height
+            self.geometry = geometry
+        elif (geometry != self.geometry or self.sequence is None or
+              seq != (self.sequence + 1) & 0xFFFFFFFF):
+            # Lost frames or never synchronized: wait for a key frame.
+            self.rows = None
+        bpp = FORMATS[fmt][0]
+        unit = bpp // 8 if bpp >= 8 else 1
+        units = (width * bpp + 7) // 8 // unit
+        changed = 0
+        while True:
+            row, length = struct.unpack('<HH', self.read_exact(4))
+            if row == END_ROW:
+                if length != changed:
+                    raise StreamError('frame %d: %d rows expected, %d read' %
+                                      (seq, length, changed))
+                break
+            if row >= height:
+                raise StreamError('frame %d: bad row %d' % (seq, row))
+            payload = self.read_exact(length)
+            changed += 1
+            if self.rows is not None:
+                above = self.rows[row - 1] if row > 0 else None
+                self.rows[row] = decode_row(payload, above, units, unit)
+        self.sequence = seq
+        return seq, key, changed
+
+    def complete(self):
+        return self.rows is not None and None not in self.rows
+
+
+def open_input(args):
+    if args.port:
+        import serial
+        port = serial.Serial(args.port, args.baud, timeout=None)
+        return port.read
+    f = open(args.input, 'rb') if args.input != '-' else sys.stdin.buffer
+    return f.read
+
+
+def make_reader(read):
+    def read_exact(n):
+        data = b''
+        while len(data) < n:
+            chunk = read(n - len(data))
+            if not chunk:
+                raise EOFError
+            data += chunk
+        return data
+    return read_exact
+
+
+def save(args, dec, seq):
+    width, height, fmt = dec.geometry
+    name = join(args.output, '%s%06d' % (args.prefix, seq))
+    if args.raw:
+        with open(name + '.raw', 'wb') as f:
+            for row in dec.rows:
+                f.write(row)
+        return
+    from PIL import Image
+    rgba = to_rgba(fmt, width, height, dec.rows)
+    Image.frombytes('RGBA', (width, height), bytes(rgba)).save(name + '.png')
+
+
+parser = ArgumentParser(description='Rebuild frames streamed by fbstream.')
+source = parser.add_mutually_exclusive_group(required=True)
+source.add_argument('-p', '--port', help='Serial port, e.g. /dev/ttyACM0.')
+source.add_argument('-i', '--input', help='Captured stream file, - for stdin.')
+parser.add_argument('-b', '--baud', type=int, default=115200,
+                    help='Serial baud rate (ignored by USB CDC).')
+parser.add_argument('-o', '--output', default='.', help='Output directory.')
+parser.add_argument('--prefix', default='frame', help='Output file prefix.')
+parser.add_argument('--raw', action='store_true',
+                    help='Save raw frame buffer dumps instead of PNG images.')
+parser.add_argument('-n', '--count', type=int, default=0,
+                    help='Stop after this many frames, 0: never.')
+
+
+if __name__ == '__main__':
+    args = parser.parse_args()
+    dec = Decoder(make_reader(open_input(args)))
+    frames = 0
+    try:
+        while not args.count or frames < args.count:
+            seq, key, changed = dec.frame()
+            if not dec.complete():
+                print('frame %d: waiting for a key frame' % seq)
+                continue
+            if not changed and not key:
+                continue
+            save(args, dec, seq)
+            frames += 1
+            print('frame %d: %s, %d rows' % (seq, 'key' if key else 'delta',
+                                             changed))
+    except EOFError:
+        pass
+    except KeyboardInterrupt:
+        pass